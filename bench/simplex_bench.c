@@ -0,0 +1,730 @@
+/**
+ * @file simplex_bench.c
+ * @brief Benchmark suite for every noise kernel, array API and the image pipeline
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @details Each case runs over a matrix of sizes, octave counts, thread counts
+ *          and SIMD levels. A measurement warms up, calibrates how many calls
+ *          make one repetition last at least --min-time, then times each
+ *          repetition with a monotonic clock. Results are reported as median
+ *          and best ns/sample, samples/s and output bytes/s, as a text table,
+ *          JSON or CSV, so runs from two releases can be diffed directly.
+ *
+ *          Point functions are scalar and single-threaded, so they run once
+ *          per size and octave count; the array and image cases run for
+ *          every thread count and SIMD level.
+ *
+ * @author Adrian Paredez
+ * @version 2.0.0
+ * @date 9/5/2025
+ */
+
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <simplex_image.h>
+#include <simplex_noise.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#ifndef SIMPLEX_VERSION_STRING
+#define SIMPLEX_VERSION_STRING "unknown"
+#endif
+
+enum { BENCH_MAX_LIST = 16, BENCH_VOLUME_DEPTH = 4, BENCH_UNROLLED_OCTAVES = 8, BENCH_SEED = 1337 };
+
+#define BENCH_PERSISTENCE 0.5
+#define BENCH_LACUNARITY 2.0
+#define BENCH_OFFSET 1.0
+#define BENCH_WARP_STRENGTH 0.5
+#define BENCH_COORD_RANGE 200.0
+#define BENCH_GRID_STEP 0.013
+#define BENCH_IMAGE_FILE "simplex_bench_image.raw"
+
+/* ===== MONOTONIC CLOCK ===== */
+
+static double now_seconds(void) {
+#if defined(_WIN32)
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+#endif
+}
+
+/* ===== CASES ===== */
+
+typedef enum { CASE_POINT = 0, CASE_BULK, CASE_IMAGE } case_kind_t;
+
+// Inputs and scratch buffers shared by every case of one size
+typedef struct {
+    int size; /* Samples per side of the 2D grid */
+    int octaves;
+    size_t count; /* size * size */
+    double* xs;
+    double* ys;
+    double* zs;
+    double* ws;
+    void* output;           /* Room for count * BENCH_VOLUME_DEPTH doubles */
+    simplex_arena_t* arena; /* Image buffers kept between runs */
+} bench_input_t;
+
+typedef struct {
+    const char* name;
+    case_kind_t kind;
+    int uses_octaves;
+    int depth;              /* Samples per grid point: the volume depth or array count, else 1 */
+    size_t bytes_per_sample; /* Output bytes written per sample */
+    int (*run)(const bench_input_t* in);
+} bench_case_t;
+
+static double* out_f64(const bench_input_t* in) {
+    return (double*)in->output;
+}
+
+static int run_noise_1d(const bench_input_t* in) {
+    for (size_t i = 0; i < in->count; i++) {
+        out_f64(in)[i] = simplex_noise_1d(in->xs[i]);
+    }
+    return 0;
+}
+
+static int run_noise_2d(const bench_input_t* in) {
+    for (size_t i = 0; i < in->count; i++) {
+        out_f64(in)[i] = simplex_noise_2d(in->xs[i], in->ys[i]);
+    }
+    return 0;
+}
+
+static int run_noise_3d(const bench_input_t* in) {
+    for (size_t i = 0; i < in->count; i++) {
+        out_f64(in)[i] = simplex_noise_3d(in->xs[i], in->ys[i], in->zs[i]);
+    }
+    return 0;
+}
+
+static int run_noise_4d(const bench_input_t* in) {
+    for (size_t i = 0; i < in->count; i++) {
+        out_f64(in)[i] = simplex_noise_4d(in->xs[i], in->ys[i], in->zs[i], in->ws[i]);
+    }
+    return 0;
+}
+
+static int run_ridged_2d(const bench_input_t* in) {
+    for (size_t i = 0; i < in->count; i++) {
+        out_f64(in)[i] = simplex_ridged_2d(in->xs[i], in->ys[i]);
+    }
+    return 0;
+}
+
+static int run_billowy_2d(const bench_input_t* in) {
+    for (size_t i = 0; i < in->count; i++) {
+        out_f64(in)[i] = simplex_billowy_2d(in->xs[i], in->ys[i]);
+    }
+    return 0;
+}
+
+static int run_fbm_2d(const bench_input_t* in) {
+    for (size_t i = 0; i < in->count; i++) {
+        out_f64(in)[i] = simplex_fbm_2d(in->xs[i], in->ys[i], in->octaves, BENCH_PERSISTENCE,
+                                        BENCH_LACUNARITY);
+    }
+    return 0;
+}
+
+static int run_domain_warp_2d(const bench_input_t* in) {
+    for (size_t i = 0; i < in->count; i++) {
+        out_f64(in)[i] = simplex_domain_warp_2d(in->xs[i], in->ys[i], BENCH_WARP_STRENGTH);
+    }
+    return 0;
+}
+
+// One level of plain-noise warp fields over fBm with the case's octaves
+static simplex_warp_config_t bench_warp(void) {
+    simplex_warp_config_t warp = simplex_get_default_warp_config();
+    warp.strength = BENCH_WARP_STRENGTH;
+    return warp;
+}
+
+static int run_domain_warp_fbm_2d(const bench_input_t* in) {
+    simplex_warp_config_t warp = bench_warp();
+    for (size_t i = 0; i < in->count; i++) {
+        out_f64(in)[i] = simplex_domain_warp_fbm_2d(in->xs[i], in->ys[i], in->octaves,
+                                                    BENCH_PERSISTENCE, BENCH_LACUNARITY, &warp);
+    }
+    return 0;
+}
+
+static int run_noise_array_2d(const bench_input_t* in) {
+    return simplex_noise_array_2d(0.0, 0.0, in->size, in->size, BENCH_GRID_STEP, out_f64(in));
+}
+
+static int run_noise_array_3d(const bench_input_t* in) {
+    return simplex_noise_array_3d(0.0, 0.0, 0.0, in->size, in->size, BENCH_VOLUME_DEPTH,
+                                  BENCH_GRID_STEP, out_f64(in));
+}
+
+static int run_noise_array_2d_f32(const bench_input_t* in) {
+    return simplex_noise_array_2d_f32(0.0, 0.0, in->size, in->size, BENCH_GRID_STEP,
+                                      (float*)in->output);
+}
+
+static int run_fbm_array_2d(const bench_input_t* in) {
+    return simplex_fbm_array_2d(0.0, 0.0, in->size, in->size, BENCH_GRID_STEP, in->octaves,
+                                BENCH_PERSISTENCE, BENCH_LACUNARITY, out_f64(in));
+}
+
+// fBm grids at every octave count with a fixed-octave tile kernel, 1 through 8
+static int run_fbm_array_2d_unrolled(const bench_input_t* in) {
+    for (int octaves = 1; octaves <= BENCH_UNROLLED_OCTAVES; octaves++) {
+        if (simplex_fbm_array_2d(0.0, 0.0, in->size, in->size, BENCH_GRID_STEP, octaves,
+                                 BENCH_PERSISTENCE, BENCH_LACUNARITY, out_f64(in)) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int run_fbm_array_3d(const bench_input_t* in) {
+    return simplex_fbm_array_3d(0.0, 0.0, 0.0, in->size, in->size, BENCH_VOLUME_DEPTH,
+                                BENCH_GRID_STEP, in->octaves, BENCH_PERSISTENCE,
+                                BENCH_LACUNARITY, out_f64(in));
+}
+
+static int run_fractal_array_2d_u16(const bench_input_t* in) {
+    return simplex_fractal_array_2d_u16(0.0, 0.0, in->size, in->size, BENCH_GRID_STEP,
+                                        in->octaves, BENCH_PERSISTENCE, BENCH_LACUNARITY,
+                                        (uint16_t*)in->output);
+}
+
+static int run_hybrid_array_2d(const bench_input_t* in) {
+    return simplex_hybrid_multifractal_array_2d(0.0, 0.0, in->size, in->size, BENCH_GRID_STEP,
+                                                in->octaves, BENCH_PERSISTENCE, BENCH_LACUNARITY,
+                                                BENCH_OFFSET, out_f64(in));
+}
+
+static int run_domain_warp_array_2d(const bench_input_t* in) {
+    simplex_warp_config_t warp = bench_warp();
+    return simplex_domain_warp_array_2d(0.0, 0.0, in->size, in->size, BENCH_GRID_STEP,
+                                        in->octaves, BENCH_PERSISTENCE, BENCH_LACUNARITY, &warp,
+                                        out_f64(in));
+}
+
+static int run_ridged_array_2d(const bench_input_t* in) {
+    return simplex_ridged_array_2d(0.0, 0.0, in->size, in->size, BENCH_GRID_STEP, out_f64(in));
+}
+
+static int run_billowy_array_2d(const bench_input_t* in) {
+    return simplex_billowy_array_2d(0.0, 0.0, in->size, in->size, BENCH_GRID_STEP, out_f64(in));
+}
+
+static int run_noise_2d_points(const bench_input_t* in) {
+    return simplex_noise_2d_points(in->xs, in->ys, in->count, out_f64(in));
+}
+
+static int run_fbm_2d_points(const bench_input_t* in) {
+    return simplex_fbm_2d_points(in->xs, in->ys, in->count, in->octaves, BENCH_PERSISTENCE,
+                                 BENCH_LACUNARITY, out_f64(in));
+}
+
+static int render_image_2d(const bench_input_t* in, simplex_arena_t* arena) {
+    simplex_image_config_t config = simplex_get_default_image_config();
+    simplex_set_image_size(&config, in->size, in->size);
+    simplex_set_image_filename(&config, BENCH_IMAGE_FILE);
+    config.format = SIMPLEX_IMAGE_RAW;
+    simplex_set_color_mode(&config, SIMPLEX_COLOR_GRAYSCALE);
+    simplex_set_noise_params(&config, BENCH_GRID_STEP, in->octaves, BENCH_PERSISTENCE,
+                             BENCH_LACUNARITY);
+    config.seed = BENCH_SEED;
+    config.arena = arena;
+    return simplex_generate_2d_image(&config);
+}
+
+static int run_image_2d(const bench_input_t* in) {
+    return render_image_2d(in, NULL);
+}
+
+static int run_image_2d_arena(const bench_input_t* in) {
+    return render_image_2d(in, in->arena);
+}
+
+static const bench_case_t bench_cases[] = {
+    {"noise_1d", CASE_POINT, 0, 1, sizeof(double), run_noise_1d},
+    {"noise_2d", CASE_POINT, 0, 1, sizeof(double), run_noise_2d},
+    {"noise_3d", CASE_POINT, 0, 1, sizeof(double), run_noise_3d},
+    {"noise_4d", CASE_POINT, 0, 1, sizeof(double), run_noise_4d},
+    {"ridged_2d", CASE_POINT, 0, 1, sizeof(double), run_ridged_2d},
+    {"billowy_2d", CASE_POINT, 0, 1, sizeof(double), run_billowy_2d},
+    {"fbm_2d", CASE_POINT, 1, 1, sizeof(double), run_fbm_2d},
+    {"domain_warp_2d", CASE_POINT, 0, 1, sizeof(double), run_domain_warp_2d},
+    {"domain_warp_fbm_2d", CASE_POINT, 1, 1, sizeof(double), run_domain_warp_fbm_2d},
+    {"noise_array_2d", CASE_BULK, 0, 1, sizeof(double), run_noise_array_2d},
+    {"noise_array_3d", CASE_BULK, 0, BENCH_VOLUME_DEPTH, sizeof(double), run_noise_array_3d},
+    {"noise_array_2d_f32", CASE_BULK, 0, 1, sizeof(float), run_noise_array_2d_f32},
+    {"fbm_array_2d", CASE_BULK, 1, 1, sizeof(double), run_fbm_array_2d},
+    {"fbm_array_2d_unrolled", CASE_BULK, 0, BENCH_UNROLLED_OCTAVES, sizeof(double),
+     run_fbm_array_2d_unrolled},
+    {"fbm_array_3d", CASE_BULK, 1, BENCH_VOLUME_DEPTH, sizeof(double), run_fbm_array_3d},
+    {"fractal_array_2d_u16", CASE_BULK, 1, 1, sizeof(uint16_t), run_fractal_array_2d_u16},
+    {"hybrid_multifractal_array_2d", CASE_BULK, 1, 1, sizeof(double), run_hybrid_array_2d},
+    {"domain_warp_array_2d", CASE_BULK, 1, 1, sizeof(double), run_domain_warp_array_2d},
+    {"ridged_array_2d", CASE_BULK, 0, 1, sizeof(double), run_ridged_array_2d},
+    {"billowy_array_2d", CASE_BULK, 0, 1, sizeof(double), run_billowy_array_2d},
+    {"noise_2d_points", CASE_BULK, 0, 1, sizeof(double), run_noise_2d_points},
+    {"fbm_2d_points", CASE_BULK, 1, 1, sizeof(double), run_fbm_2d_points},
+    {"image_2d_gray_raw", CASE_IMAGE, 1, 1, 1, run_image_2d},
+    {"image_2d_gray_raw_arena", CASE_IMAGE, 1, 1, 1, run_image_2d_arena},
+};
+
+enum { BENCH_CASE_COUNT = sizeof(bench_cases) / sizeof(bench_cases[0]) };
+
+/* ===== OPTIONS ===== */
+
+typedef enum { FORMAT_TEXT = 0, FORMAT_JSON, FORMAT_CSV } output_format_t;
+
+typedef struct {
+    output_format_t format;
+    const char* output_path;
+    const char* filter;
+    int warmup;
+    int repetitions;
+    double min_time;
+    int sizes[BENCH_MAX_LIST];
+    int size_count;
+    int octaves[BENCH_MAX_LIST];
+    int octave_count;
+    int threads[BENCH_MAX_LIST];
+    int thread_count;
+    simplex_simd_level_t simd[SIMPLEX_SIMD_COUNT];
+    int simd_count; /* 0 selects every level available on this machine */
+} bench_options_t;
+
+static void print_usage(const char* program) {
+    printf("Usage: %s [options]\n\n", program);
+    printf("  --format text|json|csv  Output format (default text)\n");
+    printf("  --output FILE           Write results to FILE instead of stdout\n");
+    printf("  --filter TEXT           Only run cases whose name contains TEXT\n");
+    printf("  --sizes LIST            Grid sides, e.g. 64,256,1024 (samples = side^2)\n");
+    printf("  --octaves LIST          Octave counts for fractal cases, e.g. 1,4,8\n");
+    printf("  --threads LIST          Thread counts for array and image cases\n");
+    printf("  --simd LIST             SIMD levels: scalar,sse4.1,avx2,avx512,neon,all\n");
+    printf("  --warmup N              Untimed calls before measuring (default 1)\n");
+    printf("  --repetitions N         Timed repetitions per measurement (default 5)\n");
+    printf("  --min-time SECONDS      Shortest repetition; calls are batched to reach it\n");
+    printf("  --quick                 Smallest matrix, one repetition (smoke test)\n");
+    printf("  --list                  List case names and exit\n");
+}
+
+// Parse a comma-separated list of positive integers; returns the count, or -1
+static int parse_int_list(const char* text, int* values) {
+    int count = 0;
+    const char* p = text;
+    while (*p) {
+        char* end = NULL;
+        long value = strtol(p, &end, 10);
+        if (end == p || value <= 0 || value > INT32_MAX || count == BENCH_MAX_LIST ||
+            (*end != ',' && *end != '\0')) {
+            return -1;
+        }
+        values[count++] = (int)value;
+        p = *end == ',' ? end + 1 : end;
+    }
+    return count > 0 ? count : -1;
+}
+
+static int parse_simd_list(const char* text, simplex_simd_level_t* levels) {
+    char buffer[128];
+    if (strlen(text) >= sizeof(buffer)) {
+        return -1;
+    }
+    strcpy(buffer, text);
+    int count = 0;
+    for (char* name = strtok(buffer, ","); name; name = strtok(NULL, ",")) {
+        if (strcmp(name, "all") == 0) {
+            return 0;
+        }
+        int found = -1;
+        for (int level = 0; level < SIMPLEX_SIMD_COUNT; level++) {
+            if (strcmp(name, simplex_get_simd_level_name((simplex_simd_level_t)level)) == 0) {
+                found = level;
+            }
+        }
+        if (found < 0 || count == SIMPLEX_SIMD_COUNT) {
+            return -1;
+        }
+        levels[count++] = (simplex_simd_level_t)found;
+    }
+    return count > 0 ? count : -1;
+}
+
+static void set_defaults(bench_options_t* options, int quick) {
+    static const int default_sizes[] = {64, 256, 1024};
+    static const int default_octaves[] = {1, 4, 8};
+    static const int default_threads[] = {1, 4};
+
+    options->warmup = quick ? 0 : 1;
+    options->repetitions = quick ? 1 : 5;
+    options->min_time = quick ? 0.0 : 0.05;
+    if (quick) {
+        options->sizes[0] = 32;
+        options->size_count = 1;
+        options->octaves[0] = 4;
+        options->octave_count = 1;
+        options->threads[0] = 1;
+        options->thread_count = 1;
+        return;
+    }
+    options->size_count = (int)(sizeof(default_sizes) / sizeof(default_sizes[0]));
+    memcpy(options->sizes, default_sizes, sizeof(default_sizes));
+    options->octave_count = (int)(sizeof(default_octaves) / sizeof(default_octaves[0]));
+    memcpy(options->octaves, default_octaves, sizeof(default_octaves));
+    options->thread_count = (int)(sizeof(default_threads) / sizeof(default_threads[0]));
+    memcpy(options->threads, default_threads, sizeof(default_threads));
+}
+
+static int parse_options(int argc, char** argv, bench_options_t* options) {
+    memset(options, 0, sizeof(*options));
+    int quick = 0;
+    for (int i = 1; i < argc; i++) {
+        quick |= strcmp(argv[i], "--quick") == 0;
+    }
+    set_defaults(options, quick);
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        int ok = 1;
+        if (strcmp(arg, "--quick") == 0) {
+            continue;
+        }
+        if (strcmp(arg, "--list") == 0) {
+            for (int c = 0; c < BENCH_CASE_COUNT; c++) {
+                printf("%s\n", bench_cases[c].name);
+            }
+            exit(0);
+        }
+        if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0) {
+            print_usage(argv[0]);
+            exit(0);
+        }
+        if (!value) {
+            fprintf(stderr, "Unknown option or missing value: %s\n", arg);
+            return -1;
+        }
+        i++;
+        if (strcmp(arg, "--format") == 0) {
+            if (strcmp(value, "text") == 0) {
+                options->format = FORMAT_TEXT;
+            } else if (strcmp(value, "json") == 0) {
+                options->format = FORMAT_JSON;
+            } else if (strcmp(value, "csv") == 0) {
+                options->format = FORMAT_CSV;
+            } else {
+                ok = 0;
+            }
+        } else if (strcmp(arg, "--output") == 0) {
+            options->output_path = value;
+        } else if (strcmp(arg, "--filter") == 0) {
+            options->filter = value;
+        } else if (strcmp(arg, "--sizes") == 0) {
+            ok = (options->size_count = parse_int_list(value, options->sizes)) > 0;
+        } else if (strcmp(arg, "--octaves") == 0) {
+            ok = (options->octave_count = parse_int_list(value, options->octaves)) > 0;
+        } else if (strcmp(arg, "--threads") == 0) {
+            ok = (options->thread_count = parse_int_list(value, options->threads)) > 0;
+        } else if (strcmp(arg, "--simd") == 0) {
+            ok = (options->simd_count = parse_simd_list(value, options->simd)) >= 0;
+        } else if (strcmp(arg, "--warmup") == 0) {
+            options->warmup = atoi(value);
+            ok = options->warmup >= 0;
+        } else if (strcmp(arg, "--repetitions") == 0) {
+            options->repetitions = atoi(value);
+            ok = options->repetitions > 0;
+        } else if (strcmp(arg, "--min-time") == 0) {
+            options->min_time = atof(value);
+            ok = options->min_time >= 0.0;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", arg);
+            return -1;
+        }
+        if (!ok) {
+            fprintf(stderr, "Invalid value for %s: %s\n", arg, value);
+            return -1;
+        }
+    }
+
+    // Keep only the SIMD levels this build and CPU can run
+    int every_level = options->simd_count == 0;
+    if (every_level) {
+        for (int level = 0; level < SIMPLEX_SIMD_COUNT; level++) {
+            options->simd[options->simd_count++] = (simplex_simd_level_t)level;
+        }
+    }
+    int available = 0;
+    for (int i = 0; i < options->simd_count; i++) {
+        if (simplex_set_simd_level(options->simd[i]) == 0) {
+            options->simd[available++] = options->simd[i];
+        } else if (!every_level) {
+            fprintf(stderr, "Skipping unavailable SIMD level %s\n",
+                    simplex_get_simd_level_name(options->simd[i]));
+        }
+    }
+    options->simd_count = available;
+    return available > 0 ? 0 : -1;
+}
+
+/* ===== MEASUREMENT ===== */
+
+typedef struct {
+    const bench_case_t* bench;
+    const char* simd;
+    int threads;
+    int size;
+    int octaves; /* 0 when the case takes none */
+    size_t samples; /* Per call */
+    long iterations; /* Calls per repetition */
+    int repetitions;
+    double median_ns;
+    double min_ns;
+} bench_result_t;
+
+static int compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Time one case; per-sample times of each repetition end up in result
+static int measure(const bench_case_t* bench, const bench_input_t* in,
+                   const bench_options_t* options, bench_result_t* result) {
+    for (int i = 0; i < options->warmup; i++) {
+        if (bench->run(in) != 0) {
+            return -1;
+        }
+    }
+
+    // Batch enough calls that one repetition lasts at least min_time
+    long iterations = 1;
+    for (;;) {
+        double start = now_seconds();
+        for (long i = 0; i < iterations; i++) {
+            if (bench->run(in) != 0) {
+                return -1;
+            }
+        }
+        double elapsed = now_seconds() - start;
+        if (elapsed >= options->min_time || iterations >= (1L << 30)) {
+            break;
+        }
+        double scale = elapsed > 0.0 ? (options->min_time / elapsed) * 1.2 : 10.0;
+        iterations = (long)((double)iterations * (scale < 10.0 ? (scale > 2.0 ? scale : 2.0)
+                                                               : 10.0));
+    }
+
+    double* times = malloc((size_t)options->repetitions * sizeof(double));
+    if (!times) {
+        return -1;
+    }
+    double per_call = (double)result->samples * (double)iterations;
+    for (int r = 0; r < options->repetitions; r++) {
+        double start = now_seconds();
+        for (long i = 0; i < iterations; i++) {
+            if (bench->run(in) != 0) {
+                free(times);
+                return -1;
+            }
+        }
+        times[r] = (now_seconds() - start) * 1e9 / per_call;
+    }
+    qsort(times, (size_t)options->repetitions, sizeof(double), compare_doubles);
+    int mid = options->repetitions / 2;
+    result->median_ns = options->repetitions % 2 ? times[mid] : (times[mid - 1] + times[mid]) / 2;
+    result->min_ns = times[0];
+    result->iterations = iterations;
+    result->repetitions = options->repetitions;
+    free(times);
+    return 0;
+}
+
+/* ===== REPORTING ===== */
+
+static double samples_per_sec(const bench_result_t* r) {
+    return r->median_ns > 0.0 ? 1e9 / r->median_ns : 0.0;
+}
+
+static void report_header(FILE* out, output_format_t format) {
+    if (format == FORMAT_JSON) {
+        fprintf(out, "{\n  \"library_version\": \"%s\",\n", SIMPLEX_VERSION_STRING);
+        fprintf(out, "  \"clock\": \"monotonic\",\n  \"results\": [");
+    } else if (format == FORMAT_CSV) {
+        fprintf(out, "name,simd,threads,size,octaves,samples,iterations,repetitions,"
+                     "ns_per_sample,ns_per_sample_min,samples_per_sec,bytes_per_sec\n");
+    } else {
+        fprintf(out, "%-30s %-7s %7s %6s %7s %12s %12s %14s %14s\n", "case", "simd", "threads",
+                "size", "octaves", "ns/sample", "best ns", "samples/s", "bytes/s");
+    }
+}
+
+static void report_result(FILE* out, output_format_t format, const bench_result_t* r,
+                          int first) {
+    double rate = samples_per_sec(r);
+    double bytes = rate * (double)r->bench->bytes_per_sample;
+    if (format == FORMAT_JSON) {
+        fprintf(out,
+                "%s\n    {\"name\": \"%s\", \"simd\": \"%s\", \"threads\": %d, \"size\": %d, "
+                "\"octaves\": %d, \"samples\": %zu, \"iterations\": %ld, \"repetitions\": %d, "
+                "\"ns_per_sample\": %.4f, \"ns_per_sample_min\": %.4f, "
+                "\"samples_per_sec\": %.1f, \"bytes_per_sec\": %.1f}",
+                first ? "" : ",", r->bench->name, r->simd, r->threads, r->size, r->octaves,
+                r->samples, r->iterations, r->repetitions, r->median_ns, r->min_ns, rate, bytes);
+    } else if (format == FORMAT_CSV) {
+        fprintf(out, "%s,%s,%d,%d,%d,%zu,%ld,%d,%.4f,%.4f,%.1f,%.1f\n", r->bench->name, r->simd,
+                r->threads, r->size, r->octaves, r->samples, r->iterations, r->repetitions,
+                r->median_ns, r->min_ns, rate, bytes);
+    } else {
+        fprintf(out, "%-30s %-7s %7d %6d %7d %12.3f %12.3f %14.4g %14.4g\n", r->bench->name,
+                r->simd, r->threads, r->size, r->octaves, r->median_ns, r->min_ns, rate, bytes);
+    }
+    fflush(out);
+}
+
+static void report_footer(FILE* out, output_format_t format) {
+    if (format == FORMAT_JSON) {
+        fprintf(out, "\n  ]\n}\n");
+    }
+}
+
+/* ===== DRIVER ===== */
+
+static void free_input(bench_input_t* in) {
+    free(in->xs);
+    free(in->ys);
+    free(in->zs);
+    free(in->ws);
+    free(in->output);
+    simplex_arena_destroy(in->arena);
+}
+
+// Scattered coordinates for the point cases, the same for every run
+static int make_input(int size, bench_input_t* in) {
+    memset(in, 0, sizeof(*in));
+    in->size = size;
+    in->count = (size_t)size * (size_t)size;
+    in->xs = malloc(in->count * sizeof(double));
+    in->ys = malloc(in->count * sizeof(double));
+    in->zs = malloc(in->count * sizeof(double));
+    in->ws = malloc(in->count * sizeof(double));
+    in->output = malloc(in->count * BENCH_VOLUME_DEPTH * sizeof(double));
+    in->arena = simplex_arena_create(SIMPLEX_ARENA_HUGE_PAGES);
+    if (!in->xs || !in->ys || !in->zs || !in->ws || !in->output || !in->arena) {
+        free_input(in);
+        return -1;
+    }
+    uint64_t state = BENCH_SEED;
+    double* axes[4] = {in->xs, in->ys, in->zs, in->ws};
+    for (int axis = 0; axis < 4; axis++) {
+        for (size_t i = 0; i < in->count; i++) {
+            state = (state * 6364136223846793005ULL) + 1442695040888963407ULL;
+            double unit = (double)(state >> 11) / (double)(1ULL << 53);
+            axes[axis][i] = (unit - 0.5) * BENCH_COORD_RANGE;
+        }
+    }
+    return 0;
+}
+
+static int configure(int threads, simplex_simd_level_t level) {
+    simplex_config_t config = simplex_get_default_config();
+    config.seed = BENCH_SEED;
+    config.enable_simd = 1;
+    config.max_threads = threads;
+    if (simplex_noise_init_advanced(&config) != 0) {
+        return -1;
+    }
+    return simplex_set_simd_level(level);
+}
+
+int main(int argc, char** argv) {
+    bench_options_t options;
+    if (parse_options(argc, argv, &options) != 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    FILE* out = options.output_path ? fopen(options.output_path, "w") : stdout;
+    if (!out) {
+        fprintf(stderr, "Cannot open %s\n", options.output_path);
+        return 1;
+    }
+
+    report_header(out, options.format);
+    int first = 1;
+    int status = 0;
+    for (int s = 0; s < options.size_count && status == 0; s++) {
+        bench_input_t in;
+        if (make_input(options.sizes[s], &in) != 0) {
+            fprintf(stderr, "Out of memory for size %d\n", options.sizes[s]);
+            status = 1;
+            break;
+        }
+        for (int c = 0; c < BENCH_CASE_COUNT && status == 0; c++) {
+            const bench_case_t* bench = &bench_cases[c];
+            if (options.filter && !strstr(bench->name, options.filter)) {
+                continue;
+            }
+            int point = bench->kind == CASE_POINT;
+            int octave_runs = bench->uses_octaves ? options.octave_count : 1;
+            int thread_runs = point ? 1 : options.thread_count;
+            int simd_runs = point ? 1 : options.simd_count;
+
+            for (int o = 0; o < octave_runs && status == 0; o++) {
+                for (int t = 0; t < thread_runs && status == 0; t++) {
+                    for (int v = 0; v < simd_runs && status == 0; v++) {
+                        // Point functions never use the pool or the SIMD kernels
+                        simplex_simd_level_t level = point ? SIMPLEX_SIMD_SCALAR : options.simd[v];
+                        int threads = point ? 1 : options.threads[t];
+                        in.octaves = bench->uses_octaves ? options.octaves[o] : 1;
+
+                        bench_result_t result = {.bench = bench,
+                                                 .simd = simplex_get_simd_level_name(level),
+                                                 .threads = threads,
+                                                 .size = in.size,
+                                                 .octaves = bench->uses_octaves ? in.octaves : 0,
+                                                 .samples = in.count * (size_t)bench->depth};
+                        if (configure(threads, level) != 0 ||
+                            measure(bench, &in, &options, &result) != 0) {
+                            fprintf(stderr, "Case %s failed\n", bench->name);
+                            status = 1;
+                            break;
+                        }
+                        report_result(out, options.format, &result, first);
+                        first = 0;
+                    }
+                }
+            }
+        }
+        free_input(&in);
+    }
+    report_footer(out, options.format);
+
+    if (out != stdout) {
+        fclose(out);
+    }
+    remove(BENCH_IMAGE_FILE);
+    simplex_cleanup();
+    return status;
+}
@@ -17,6 +17,7 @@
 #ifndef SIMPLEX_IMAGE_H
 #define SIMPLEX_IMAGE_H
 
+#include "simplex_noise.h"
 #include <stddef.h>
 #include <stdint.h>
 
@@ -33,7 +34,7 @@ static const size_t SIMPLEX_MAX_FILENAME_LEN = 256;
  * @brief Supported image formats
  */
 typedef enum {
-    SIMPLEX_IMAGE_PNG = 0, /**< PNG format (requires libpng) */
+    SIMPLEX_IMAGE_PNG = 0, /**< PNG format (deflate-compressed when built with zlib) */
     SIMPLEX_IMAGE_PPM,     /**< PPM format (portable pixmap) */
     SIMPLEX_IMAGE_PGM,     /**< PGM format (portable graymap) */
     SIMPLEX_IMAGE_RAW,     /**< Raw binary data */
@@ -49,9 +50,33 @@ typedef enum {
     SIMPLEX_COLOR_RGBA,          /**< RGBA color (4 channels) */
     SIMPLEX_COLOR_HEIGHTMAP,     /**< Heightmap visualization */
     SIMPLEX_COLOR_TERRAIN,       /**< Terrain-like colors */
+    SIMPLEX_COLOR_GRAYSCALE16,   /**< 16-bit grayscale, e.g. heightmaps (big-endian samples) */
     SIMPLEX_COLOR_COUNT
 } simplex_color_mode_t;
 
+/**
+ * @brief Row filters for PNG output (the PNG filter types, plus per-row selection)
+ */
+typedef enum {
+    SIMPLEX_PNG_FILTER_NONE = 0, /**< Raw bytes */
+    SIMPLEX_PNG_FILTER_SUB,      /**< Difference to the left pixel */
+    SIMPLEX_PNG_FILTER_UP,       /**< Difference to the pixel above; the default, best on 8-bit */
+    SIMPLEX_PNG_FILTER_AVERAGE,  /**< Difference to the mean of left and above */
+    SIMPLEX_PNG_FILTER_PAETH,    /**< Paeth predictor; usually best on 16-bit heightmaps */
+    SIMPLEX_PNG_FILTER_ADAPTIVE, /**< Per row, the filter with the smallest output */
+    SIMPLEX_PNG_FILTER_COUNT
+} simplex_png_filter_t;
+
+/**
+ * @brief Normalization modes for simplex_image_config_t::auto_normalize
+ */
+typedef enum {
+    SIMPLEX_NORMALIZE_NONE = 0,  /**< Use noise values as generated */
+    SIMPLEX_NORMALIZE_EXACT = 1, /**< Map the image's own min/max to 0-1 */
+    SIMPLEX_NORMALIZE_BOUNDED,   /**< Map [min_value, max_value] to 0-1 in one pass, clamping */
+    SIMPLEX_NORMALIZE_COUNT
+} simplex_normalize_mode_t;
+
 /**
  * @brief Image generation configuration
  */
@@ -67,15 +92,40 @@ typedef struct {
     int octaves;                     /**< Number of octaves for fractal noise */
     double persistence;              /**< Persistence for fractal noise */
     double lacunarity;               /**< Lacunarity for fractal noise */
-    double min_value;                /**< Minimum noise value for normalization */
-    double max_value;                /**< Maximum noise value for normalization */
-    int auto_normalize;              /**< Auto-normalize noise values to 0-1 */
+    double min_value;                /**< Lower bound for SIMPLEX_NORMALIZE_BOUNDED */
+    double max_value;                /**< Upper bound for SIMPLEX_NORMALIZE_BOUNDED */
+    int auto_normalize;              /**< simplex_normalize_mode_t; any other non-zero is EXACT */
     uint32_t seed;                   /**< Random seed for noise generation */
     char filename[256];              /**< Output filename */
+    int png_compression;             /**< PNG deflate level, 0 (store) to 9 */
+    simplex_png_filter_t png_filter; /**< PNG row filter */
+    simplex_arena_t* arena;          /**< Buffers reused across calls, NULL to allocate per call */
 } simplex_image_config_t;
 
 /* ===== CORE IMAGE FUNCTIONS ===== */
 
+/*
+ * Noise is generated in small tiles that are normalized and colorized straight
+ * into a band of pixel rows, which is then written out, so a band never
+ * exceeds memory_limit_mb of the noise configuration
+ * (simplex_noise_init_advanced()); only the seed is taken from the image
+ * configuration. SIMPLEX_NORMALIZE_EXACT first needs the image's min/max: its
+ * samples are kept for the colorizing pass when the whole image's samples and
+ * pixels fit in memory_limit_mb, and generated twice otherwise.
+ * SIMPLEX_NORMALIZE_BOUNDED and SIMPLEX_NORMALIZE_NONE always take one pass.
+ * The defaults min_value = -1 and max_value = 1 bound plain noise and fBm of
+ * any octave count, since the octave amplitudes are divided by their sum.
+ *
+ * PPM stores grayscale as P5 and colors as P6, PGM accepts grayscale only,
+ * and RAW writes the pixel bytes without a header. SIMPLEX_COLOR_GRAYSCALE16
+ * writes two big-endian bytes per pixel (maxval 65535 in PPM/PGM) and maps
+ * normalized images onto the full 0-65535 range.
+ *
+ * PNG output is filtered with png_filter and deflated at png_compression, in
+ * row groups compressed in parallel on up to max_threads threads. Builds
+ * without zlib write valid but uncompressed PNGs.
+ */
+
 /**
  * @brief Generate a 2D noise image
  * @param config Image generation configuration
@@ -100,11 +150,28 @@ int simplex_generate_fractal_image(const simplex_image_config_t* config);
 
 /**
  * @brief Generate a heightmap image
+ *
+ * Colors the heights with SIMPLEX_COLOR_HEIGHTMAP, unless the configuration
+ * asks for SIMPLEX_COLOR_GRAYSCALE16 height samples (e.g. for a 16-bit PNG).
+ *
  * @param config Image generation configuration
  * @return 0 on success, -1 on error
  */
 int simplex_generate_heightmap(const simplex_image_config_t* config);
 
+/**
+ * @brief Generate a tangent-space normal map of the noise height field
+ *
+ * Normals come from the analytic noise gradient, one evaluation per pixel.
+ * The height field is the image's fBm (or plain noise for one octave);
+ * RGB = (normal + 1) / 2 with x right, y down the image and z out of it.
+ *
+ * @param config Image generation configuration (color_mode is ignored; PPM or RAW)
+ * @param strength Height, in pixels, of one unit of noise
+ * @return 0 on success, -1 on error
+ */
+int simplex_generate_normal_map(const simplex_image_config_t* config, double strength);
+
 /**
  * @brief Generate a texture image
  * @param config Image generation configuration
@@ -112,6 +179,313 @@ int simplex_generate_heightmap(const simplex_image_config_t* config);
  */
 int simplex_generate_texture(const simplex_image_config_t* config);
 
+/* ===== IN-MEMORY GENERATION ===== */
+
+/*
+ * The same images as simplex_generate_2d_image() and
+ * simplex_generate_3d_image(), byte for byte, without touching the file
+ * system; config->filename is ignored. Buffer variants colorize straight into
+ * the caller's memory, so only the samples and row ranges of exact
+ * normalization count against memory_limit_mb. Stream variants hand the
+ * header and then each band of pixel rows to a callback as soon as it is
+ * ready, from the calling thread.
+ */
+
+/**
+ * @brief Receives the next bytes of an encoded image
+ * @param user_data Pointer passed to the render call
+ * @param data Bytes to consume; only valid during the call
+ * @param size Number of bytes
+ * @return 0 to continue, non-zero to stop rendering with an error
+ */
+typedef int (*simplex_image_write_fn)(void* user_data, const void* data, size_t size);
+
+/**
+ * @brief Size of an encoded image, header included
+ *
+ * Exact for PPM, PGM and RAW; for PNG an upper bound, since the compressed
+ * size is only known once the image is rendered.
+ *
+ * @param config Image generation configuration
+ * @return Size in bytes, 0 if the configuration is invalid
+ */
+size_t simplex_image_encoded_size(const simplex_image_config_t* config);
+
+/**
+ * @brief Render a 2D noise image into a caller buffer
+ * @param config Image generation configuration
+ * @param buffer Destination, at least simplex_image_encoded_size() bytes
+ * @param capacity Size of buffer in bytes
+ * @param size Set to the bytes written, or when the buffer is too small to the size needed
+ *             (may be NULL)
+ * @return 0 on success, -1 on error or if the image does not fit
+ */
+int simplex_render_to_buffer(const simplex_image_config_t* config, void* buffer, size_t capacity,
+                             size_t* size);
+
+/**
+ * @brief Render a 2D noise image as one float sample per pixel
+ *
+ * Samples are row-major and normalized as the image would be (0 to 1 unless
+ * auto_normalize is SIMPLEX_NORMALIZE_NONE), with no header and no colors;
+ * format and color_mode are ignored.
+ *
+ * @param config Image generation configuration
+ * @param heights Destination, width * height floats
+ * @param count Number of floats heights holds
+ * @return 0 on success, -1 on error or if count is below width * height
+ */
+int simplex_render_heights_f32(const simplex_image_config_t* config, float* heights,
+                               size_t count);
+
+/**
+ * @brief Render a heightmap (see simplex_generate_heightmap()) into a caller buffer
+ * @param config Image generation configuration
+ * @param buffer Destination, at least simplex_image_encoded_size() bytes of the heightmap
+ * @param capacity Size of buffer in bytes
+ * @param size Set to the bytes written, or when the buffer is too small to the size needed
+ *             (may be NULL)
+ * @return 0 on success, -1 on error or if the image does not fit
+ */
+int simplex_render_heightmap_to_buffer(const simplex_image_config_t* config, void* buffer,
+                                       size_t capacity, size_t* size);
+
+/**
+ * @brief Render a terrain texture (see simplex_generate_texture()) into a caller buffer
+ * @param config Image generation configuration
+ * @param buffer Destination, at least simplex_image_encoded_size() bytes of the texture
+ * @param capacity Size of buffer in bytes
+ * @param size Set to the bytes written, or when the buffer is too small to the size needed
+ *             (may be NULL)
+ * @return 0 on success, -1 on error or if the image does not fit
+ */
+int simplex_render_texture_to_buffer(const simplex_image_config_t* config, void* buffer,
+                                     size_t capacity, size_t* size);
+
+/**
+ * @brief Render a 3D noise slice into a caller buffer
+ * @param config Image generation configuration
+ * @param z_slice Z coordinate for the slice
+ * @param buffer Destination, at least simplex_image_encoded_size() bytes
+ * @param capacity Size of buffer in bytes
+ * @param size Set to the bytes written, or when the buffer is too small to the size needed
+ *             (may be NULL)
+ * @return 0 on success, -1 on error or if the image does not fit
+ */
+int simplex_render_3d_to_buffer(const simplex_image_config_t* config, double z_slice,
+                                void* buffer, size_t capacity, size_t* size);
+
+/**
+ * @brief Render a 2D noise image through a write callback
+ * @param config Image generation configuration
+ * @param write Callback receiving the encoded bytes in order
+ * @param user_data Passed to every write call
+ * @return 0 on success, -1 on error or if write returned non-zero
+ */
+int simplex_render_to_stream(const simplex_image_config_t* config, simplex_image_write_fn write,
+                             void* user_data);
+
+/**
+ * @brief Render a 3D noise slice through a write callback
+ * @param config Image generation configuration
+ * @param z_slice Z coordinate for the slice
+ * @param write Callback receiving the encoded bytes in order
+ * @param user_data Passed to every write call
+ * @return 0 on success, -1 on error or if write returned non-zero
+ */
+int simplex_render_3d_to_stream(const simplex_image_config_t* config, double z_slice,
+                                simplex_image_write_fn write, void* user_data);
+
+/*
+ * Domain-warped images: simplex_domain_warp_fbm_2d() at every pixel, with the
+ * base fBm taken from config->octaves, persistence and lacunarity (octaves 1
+ * gives warped plain noise). Warp strength and offsets are in noise
+ * coordinates, after config->scale. Each tile's warp field is generated with
+ * the array kernels before the base noise is sampled at the warped points. A
+ * NULL warp uses simplex_get_default_warp_config().
+ */
+
+/**
+ * @brief Generate a domain-warped noise image
+ * @param config Image generation configuration
+ * @param warp Warp fields (may be NULL)
+ * @return 0 on success, -1 on error
+ */
+int simplex_generate_warped_image(const simplex_image_config_t* config,
+                                  const simplex_warp_config_t* warp);
+
+/**
+ * @brief Render a domain-warped noise image into a caller buffer
+ * @param config Image generation configuration
+ * @param warp Warp fields (may be NULL)
+ * @param buffer Destination, at least simplex_image_encoded_size() bytes
+ * @param capacity Size of buffer in bytes
+ * @param size Set to the bytes written, or when the buffer is too small to the size needed
+ *             (may be NULL)
+ * @return 0 on success, -1 on error or if the image does not fit
+ */
+int simplex_render_warped_to_buffer(const simplex_image_config_t* config,
+                                    const simplex_warp_config_t* warp, void* buffer,
+                                    size_t capacity, size_t* size);
+
+/**
+ * @brief Render a domain-warped noise image through a write callback
+ * @param config Image generation configuration
+ * @param warp Warp fields (may be NULL)
+ * @param write Callback receiving the encoded bytes in order
+ * @param user_data Passed to every write call
+ * @return 0 on success, -1 on error or if write returned non-zero
+ */
+int simplex_render_warped_to_stream(const simplex_image_config_t* config,
+                                    const simplex_warp_config_t* warp,
+                                    simplex_image_write_fn write, void* user_data);
+
+/* ===== TILED RENDERING ===== */
+
+/*
+ * One tile of a large image, for splitting a render across processes or
+ * nodes. config->width and config->height are the size of the full image; a
+ * tile renders only its own pixels, so its cost and memory do not depend on
+ * the size of the full image. Tile pixels are the full image's pixels: tiles
+ * whose left edge is a multiple of SIMPLEX_IMAGE_TILE_ALIGN match byte for
+ * byte, others to within sample rounding.
+ *
+ * Normalization must be the same for every tile, so SIMPLEX_NORMALIZE_EXACT is
+ * rejected. Use SIMPLEX_NORMALIZE_BOUNDED with an analytic bound (the default
+ * [-1, 1] bounds plain noise and fBm) or with a range measured once by
+ * simplex_measure_image_range() and shared with every node, or
+ * SIMPLEX_NORMALIZE_NONE.
+ *
+ * A tile is encoded as its rows of pixel bytes, and tile (0, 0) starts with
+ * the header of the full image (PPM/PGM; RAW has none), so full-width tiles
+ * concatenated in row order are the full image. Other tile grids are
+ * assembled by simplex_assemble_image_tiles(), which only copies bytes. PNG
+ * is not available for tiles, since its checksums span the whole image.
+ */
+
+/** Tile left edges on a multiple of this reproduce the full image byte for byte */
+enum { SIMPLEX_IMAGE_TILE_ALIGN = 512 };
+
+/**
+ * @brief A tile in a grid of equally sized tiles covering the full image
+ */
+typedef struct {
+    int tile_width;  /**< Tile width in pixels; the rightmost tiles are clipped to the image */
+    int tile_height; /**< Tile height in pixels; the bottom tiles are clipped to the image */
+    int column;      /**< Tile column, 0 at the left */
+    int row;         /**< Tile row, 0 at the top */
+} simplex_image_tile_t;
+
+/**
+ * @brief Bytes of an encoded tile
+ * @param config Configuration of the full image
+ * @param tile Tile to encode
+ * @return Encoded size in bytes, 0 if the request is invalid
+ */
+size_t simplex_image_tile_encoded_size(const simplex_image_config_t* config,
+                                       const simplex_image_tile_t* tile);
+
+/**
+ * @brief Render one tile of an image to config->filename
+ * @param config Configuration of the full image
+ * @param tile Tile to render
+ * @return 0 on success, -1 on error
+ */
+int simplex_generate_image_tile(const simplex_image_config_t* config,
+                                const simplex_image_tile_t* tile);
+
+/**
+ * @brief Render one tile of an image into a caller buffer
+ * @param config Configuration of the full image
+ * @param tile Tile to render
+ * @param buffer Destination, at least simplex_image_tile_encoded_size() bytes
+ * @param capacity Size of buffer in bytes
+ * @param size Set to the bytes written, or when the buffer is too small to the size needed
+ *             (may be NULL)
+ * @return 0 on success, -1 on error or if the tile does not fit
+ */
+int simplex_render_tile_to_buffer(const simplex_image_config_t* config,
+                                  const simplex_image_tile_t* tile, void* buffer,
+                                  size_t capacity, size_t* size);
+
+/**
+ * @brief Render one tile of an image through a write callback
+ * @param config Configuration of the full image
+ * @param tile Tile to render
+ * @param write Callback receiving the encoded bytes in order
+ * @param user_data Passed to every write call
+ * @return 0 on success, -1 on error or if write returned non-zero
+ */
+int simplex_render_tile_to_stream(const simplex_image_config_t* config,
+                                  const simplex_image_tile_t* tile,
+                                  simplex_image_write_fn write, void* user_data);
+
+/**
+ * @brief Join tile files into the full image at config->filename
+ * @param config Configuration of the full image
+ * @param tile_width Tile width the tiles were rendered with
+ * @param tile_height Tile height the tiles were rendered with
+ * @param tile_files One file per tile in row order: (0, 0), (1, 0), ... (columns - 1, rows - 1)
+ * @return 0 on success, -1 on error or if a tile file is missing or the wrong size
+ */
+int simplex_assemble_image_tiles(const simplex_image_config_t* config, int tile_width,
+                                 int tile_height, const char* const* tile_files);
+
+/**
+ * @brief Measure the noise range of the full image
+ *
+ * Generates the whole image once, in bands within memory_limit_mb, without
+ * writing it. The range can then be shared with the tile renders as
+ * min_value and max_value with SIMPLEX_NORMALIZE_BOUNDED.
+ *
+ * @param config Configuration of the full image
+ * @param min_value Set to the smallest sample
+ * @param max_value Set to the largest sample
+ * @return 0 on success, -1 on error
+ */
+int simplex_measure_image_range(const simplex_image_config_t* config, double* min_value,
+                                double* max_value);
+
+/* ===== ASYNCHRONOUS IMAGES ===== */
+
+/*
+ * Image jobs for the job queue of simplex_noise.h (simplex_submit_array_2d()).
+ * The configuration is copied at submission. A job renders the same bytes as
+ * simplex_generate_2d_image() or simplex_render_to_buffer(), but on a context
+ * of its own for config->seed, so unlike the blocking calls it leaves the
+ * default context's seed alone and image jobs may run side by side. A
+ * configuration's arena must not be shared by jobs that can run at once.
+ */
+
+/**
+ * @brief Queue a 2D image written to config->filename
+ * @param config Image generation configuration
+ * @param priority Job priority
+ * @param callback Called once the job is done, failed or cancelled (may be NULL)
+ * @param user_data Passed to the callback
+ * @param job Receives a handle to release with simplex_job_release() (NULL for none)
+ * @return 0 on success, -1 on invalid configuration or if the job could not be queued
+ */
+int simplex_submit_image(const simplex_image_config_t* config, simplex_job_priority_t priority,
+                         simplex_job_callback_t callback, void* user_data, simplex_job_t** job);
+
+/**
+ * @brief Queue a 2D image encoded into a caller buffer
+ * @param config Image generation configuration
+ * @param buffer Destination, at least simplex_image_encoded_size() bytes
+ * @param capacity Size of buffer in bytes
+ * @param size Set to the bytes written once the job is done (may be NULL)
+ * @param priority Job priority
+ * @param callback Called once the job is done, failed or cancelled (may be NULL)
+ * @param user_data Passed to the callback
+ * @param job Receives a handle to release with simplex_job_release() (NULL for none)
+ * @return 0 on success, -1 on invalid parameters or if the job could not be queued
+ */
+int simplex_submit_image_to_buffer(const simplex_image_config_t* config, void* buffer,
+                                   size_t capacity, size_t* size, simplex_job_priority_t priority,
+                                   simplex_job_callback_t callback, void* user_data,
+                                   simplex_job_t** job);
+
 /* ===== CONFIGURATION FUNCTIONS ===== */
 
 /**
@@ -202,6 +576,11 @@ void simplex_noise_to_terrain(double noise_value, uint8_t* r, uint8_t* g, uint8_
 
 /**
  * @brief Generate multiple images with different parameters
+ *
+ * Writes simplex_series_<i>.ppm for each image. Images are rendered in
+ * parallel and written while later ones are generated; see
+ * simplex_generate_animation() for scheduling and memory use.
+ *
  * @param base_config Base configuration
  * @param count Number of images to generate
  * @param scale_variations Array of scale variations
@@ -213,6 +592,14 @@ int simplex_generate_image_series(const simplex_image_config_t* base_config, int
 
 /**
  * @brief Generate animation frames
+ *
+ * Writes <output_dir>/frame_<nnnn>.ppm, each a 3D slice at time frame *
+ * time_step. Up to max_threads frames of the noise configuration are generated
+ * at once on the thread pool while the previous ones are written, within
+ * memory_limit_mb; frames are byte-identical to single 3D images. Each seed's
+ * permutation table is built once per call and the default context is not
+ * reseeded.
+ *
  * @param config Base configuration
  * @param frame_count Number of frames
  * @param time_step Time step between frames
@@ -222,6 +609,139 @@ int simplex_generate_image_series(const simplex_image_config_t* base_config, int
 int simplex_generate_animation(const simplex_image_config_t* config, int frame_count,
                                double time_step, const char* output_dir);
 
+/* ===== VOLUME GENERATION ===== */
+
+/*
+ * A volume file is a SIMPLEX_VOLUME_HEADER_SIZE-byte header followed by
+ * width * height * depth samples, x fastest, then y, then z, with no padding.
+ * Header fields and samples are little-endian; on little-endian hosts the
+ * header is simplex_volume_header_t byte for byte and the samples are plain
+ * float, uint8_t or uint16_t arrays.
+ *
+ * simplex_generate_volume() sizes the file up front and fills it through a
+ * memory mapping, slab of z slices by slab: each slab spans at most
+ * memory_limit_mb of the noise configuration (at least one slice) and its
+ * rows are generated in parallel on up to max_threads threads, so volumes far
+ * larger than memory never need a double per voxel. The header is written
+ * last, so an interrupted file is rejected by simplex_volume_open(). Sample
+ * (x, y, z) is the noise at ((offset_x + x) * scale, (offset_y + y) * scale,
+ * (offset_z + z) * scale), fractal noise when octaves > 1, from a context
+ * seeded with the volume's seed; the default context is not reseeded.
+ */
+
+enum {
+    SIMPLEX_VOLUME_HEADER_SIZE = 64, /**< Bytes before the first sample */
+    SIMPLEX_VOLUME_VERSION = 1       /**< Layout version written to the header */
+};
+
+/**
+ * @brief Sample formats of a volume file
+ */
+typedef enum {
+    SIMPLEX_VOLUME_FLOAT32 = 0, /**< IEEE single precision, noise values as generated */
+    SIMPLEX_VOLUME_UINT8,       /**< [min_value, max_value] mapped to 0-255, clamped */
+    SIMPLEX_VOLUME_UINT16,      /**< [min_value, max_value] mapped to 0-65535, clamped */
+    SIMPLEX_VOLUME_COUNT
+} simplex_volume_format_t;
+
+/**
+ * @brief Volume generation configuration
+ */
+typedef struct {
+    int width;                      /**< Samples along x */
+    int height;                     /**< Samples along y */
+    int depth;                      /**< Samples along z */
+    simplex_volume_format_t format; /**< Sample format */
+    double scale;                   /**< Noise scale factor */
+    double offset_x;                /**< X offset for noise sampling */
+    double offset_y;                /**< Y offset for noise sampling */
+    double offset_z;                /**< Z offset for noise sampling */
+    int octaves;                    /**< Number of octaves for fractal noise */
+    double persistence;             /**< Persistence for fractal noise */
+    double lacunarity;              /**< Lacunarity for fractal noise */
+    double min_value;               /**< Noise value stored as 0 in integer formats */
+    double max_value;               /**< Noise value stored as the format maximum */
+    uint32_t seed;                  /**< Random seed for noise generation */
+    char filename[256];             /**< Output filename */
+} simplex_volume_config_t;
+
+/**
+ * @brief Volume file header, as stored at the start of the file
+ */
+typedef struct {
+    char magic[8];        /**< "SXVOLUME" */
+    uint32_t version;     /**< SIMPLEX_VOLUME_VERSION */
+    uint32_t header_size; /**< Offset of the first sample */
+    uint32_t width;       /**< Samples along x */
+    uint32_t height;      /**< Samples along y */
+    uint32_t depth;       /**< Samples along z */
+    uint32_t format;      /**< simplex_volume_format_t */
+    uint32_t sample_size; /**< Bytes per sample */
+    uint32_t seed;        /**< Seed the volume was generated with */
+    double min_value;     /**< Value of sample 0 in integer formats */
+    double max_value;     /**< Value of the largest sample in integer formats */
+    double scale;         /**< Noise scale factor */
+} simplex_volume_header_t;
+
+/**
+ * @brief A volume file mapped read-only by simplex_volume_open()
+ */
+typedef struct {
+    simplex_volume_header_t header; /**< Decoded header */
+    const void* data;               /**< First sample, inside the mapping */
+    size_t size;                    /**< Bytes of sample data */
+    void* mapping;                  /**< Start of the mapping (internal) */
+    size_t mapping_size;            /**< Length of the mapping (internal) */
+} simplex_volume_t;
+
+/**
+ * @brief Get default volume configuration
+ * @return 256^3 float32 fBm volume writing simplex_volume.raw
+ */
+simplex_volume_config_t simplex_get_default_volume_config(void);
+
+/**
+ * @brief Size of a volume file, header included
+ * @param config Volume generation configuration
+ * @return Size in bytes, 0 if the configuration is invalid
+ */
+uint64_t simplex_volume_file_size(const simplex_volume_config_t* config);
+
+/**
+ * @brief Generate a 3D noise volume into config->filename
+ * @param config Volume generation configuration
+ * @return 0 on success, -1 on error
+ */
+int simplex_generate_volume(const simplex_volume_config_t* config);
+
+/**
+ * @brief Map a volume file for reading without copying it
+ * @param filename Volume file written by simplex_generate_volume()
+ * @param volume Filled with the header and a pointer to the samples
+ * @return 0 on success, -1 if the file cannot be mapped or is not a complete volume
+ */
+int simplex_volume_open(const char* filename, simplex_volume_t* volume);
+
+/**
+ * @brief Unmap a volume opened with simplex_volume_open()
+ * @param volume Volume to close; safe to call on a zeroed or closed volume
+ */
+void simplex_volume_close(simplex_volume_t* volume);
+
+/**
+ * @brief Read one sample as a noise value
+ *
+ * Integer samples are mapped back onto [min_value, max_value]. Coordinates
+ * outside the volume are clamped to its edge.
+ *
+ * @param volume Open volume
+ * @param x X index
+ * @param y Y index
+ * @param z Z index
+ * @return Sample value, 0 if volume is NULL or not open
+ */
+double simplex_volume_sample(const simplex_volume_t* volume, int x, int y, int z);
+
 #ifdef __cplusplus
 }
 #endif
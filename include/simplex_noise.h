@@ -24,6 +24,13 @@
 /* ===== CONSTANTS ===== */
 static const size_t SIMPLEX_MAX_ERROR_COUNT = 10;
 
+/* Maximum absolute difference between the SIMD and scalar noise paths */
+static const double SIMPLEX_SIMD_TOLERANCE = 1e-12;
+
+/* Maximum absolute difference between single- and double-precision noise for
+ * coordinates of magnitude up to 1000 */
+static const double SIMPLEX_F32_TOLERANCE = 1e-3;
+
 /* PRNG Algorithm Types */
 typedef enum {
     SIMPLEX_PRG_LINEAR_CONGRUENTIAL = 0,
@@ -62,6 +69,16 @@ typedef enum {
     SIMPLEX_PRECISION_COUNT
 } simplex_precision_t;
 
+/* SIMD Instruction Set Levels */
+typedef enum {
+    SIMPLEX_SIMD_SCALAR = 0,
+    SIMPLEX_SIMD_SSE41,
+    SIMPLEX_SIMD_AVX2,
+    SIMPLEX_SIMD_AVX512,
+    SIMPLEX_SIMD_NEON,
+    SIMPLEX_SIMD_COUNT
+} simplex_simd_level_t;
+
 /* Configuration Structure */
 typedef struct {
     simplex_prng_type_t prng_type;
@@ -93,6 +110,7 @@ typedef struct {
     int max_threads;
     int chunk_size;
     double memory_limit_mb;
+    int enable_gpu; /* Offload large arrays to an OpenCL device when one is present */
 } simplex_config_t;
 
 /* Configuration File Types */
@@ -119,14 +137,55 @@ typedef struct {
 
 /* Performance Statistics */
 typedef struct {
-    double generation_time;
+    double generation_time; /* Seconds spent in profiled calls */
     size_t memory_used;
-    size_t cache_hits;
-    size_t cache_misses;
-    size_t function_calls;
-    double average_execution_time;
+    size_t cache_hits;      /* Tile cache lookups served from the cache */
+    size_t cache_misses;    /* Tile cache lookups that generated the tile */
+    size_t cache_evictions; /* Tiles dropped to stay within cache_size_mb */
+    size_t function_calls;  /* Profiled calls over every API family */
+    double average_execution_time; /* Microseconds per profiled call */
 } simplex_perf_stats_t;
 
+/*
+ * Profiled API families. Each public call is attributed to one family; calls
+ * made from inside another library call (e.g. the noise evaluations of an fBm
+ * call, or the arrays behind a tile) count only toward the outermost call.
+ */
+typedef enum {
+    SIMPLEX_PROFILE_NOISE_1D = 0,
+    SIMPLEX_PROFILE_NOISE_2D,
+    SIMPLEX_PROFILE_NOISE_3D,
+    SIMPLEX_PROFILE_NOISE_4D,
+    SIMPLEX_PROFILE_NOISE_FLOAT,         /* simplex_noise_2df / 3df / 4df */
+    SIMPLEX_PROFILE_RIDGED,              /* simplex_ridged_1d / 2d / 3d */
+    SIMPLEX_PROFILE_BILLOWY,             /* simplex_billowy_1d / 2d / 3d */
+    SIMPLEX_PROFILE_FBM,                 /* simplex_fbm_* and simplex_fractal_* points */
+    SIMPLEX_PROFILE_HYBRID_MULTIFRACTAL, /* simplex_hybrid_multifractal_2d */
+    SIMPLEX_PROFILE_DOMAIN_WARP,         /* simplex_domain_warp_2d */
+    SIMPLEX_PROFILE_NOISE_ARRAY,         /* simplex_noise_array_* */
+    SIMPLEX_PROFILE_FRACTAL_ARRAY,       /* fBm, fractal, hybrid, ridged and billowy arrays */
+    SIMPLEX_PROFILE_POINTS,              /* simplex_*_points */
+    SIMPLEX_PROFILE_TILE_ACQUIRE,        /* simplex_tile_acquire */
+    SIMPLEX_PROFILE_IMAGE,               /* simplex_generate_*_image and friends */
+    SIMPLEX_PROFILE_VOLUME,              /* simplex_generate_volume */
+    SIMPLEX_PROFILE_API_COUNT
+} simplex_profile_api_t;
+
+/* Latency buckets: bucket i counts calls taking [2^i, 2^(i+1)) ns, the last one open-ended */
+enum { SIMPLEX_PROFILE_HISTOGRAM_BUCKETS = 32 };
+
+/* Profile of one API family */
+typedef struct {
+    size_t calls;
+    size_t samples;      /* Noise values produced (pixels for images) */
+    double total_time;   /* Seconds spent in the calls */
+    double average_time; /* Seconds per call */
+    size_t histogram[SIMPLEX_PROFILE_HISTOGRAM_BUCKETS];
+} simplex_profile_entry_t;
+
+/* Noise Context (opaque) */
+typedef struct simplex_context simplex_context_t;
+
 /* ===== ADVANCED INITIALIZATION & CONFIGURATION ===== */
 
 /**
@@ -171,11 +230,71 @@ int simplex_set_interpolation(simplex_interp_type_t interp_type);
 
 /**
  * Enable or disable SIMD optimizations
+ *
+ * When enabled and the library was built with SIMPLEX_ENABLE_SIMD, the bulk
+ * array functions evaluate several points per call with vectorized kernels,
+ * using the widest instruction set the running CPU supports.
+ * Results match the scalar functions to within SIMPLEX_SIMD_TOLERANCE.
+ * Builds or CPUs without SIMD support silently keep using the scalar path.
+ *
  * @param enable 1 to enable, 0 to disable
  * @return 0 on success, negative error code on failure
  */
 int simplex_set_simd(int enable);
 
+/**
+ * Force a specific SIMD instruction set for the bulk array functions
+ *
+ * Mainly useful for testing and benchmarking each code path on one machine.
+ * SIMPLEX_SIMD_SCALAR is always available; other levels require both
+ * SIMPLEX_ENABLE_SIMD at build time and CPU support at run time.
+ *
+ * @param level Instruction set to use
+ * @return 0 on success, -1 if the level is not available
+ */
+int simplex_set_simd_level(simplex_simd_level_t level);
+
+/**
+ * Get the SIMD instruction set currently used by the bulk array functions
+ * @return Active SIMD level
+ */
+simplex_simd_level_t simplex_get_simd_level(void);
+
+/**
+ * Get the name of a SIMD instruction set, e.g. "avx2"
+ * @param level SIMD level
+ * @return Static name string, or "unknown" for an invalid level
+ */
+const char* simplex_get_simd_level_name(simplex_simd_level_t level);
+
+/**
+ * Enable or disable offloading large grid arrays to an OpenCL device
+ *
+ * Needs a build with SIMPLEX_ENABLE_OPENCL and a device with double
+ * precision (GPUs preferred). The seeded permutation table is uploaded to the
+ * device once per seed. Double-precision grid arrays of at least 65536
+ * samples - noise, fBm/fractal, hybrid multifractal, ridged and billowy, 2D
+ * and 3D, and the image generators drawing from them - are then computed on
+ * the device and streamed back in slabs bounded by memory_limit_mb. Everything
+ * else stays on the CPU, as does any job the device fails. Contexts enable
+ * this with the config's enable_gpu.
+ *
+ * Experimental and untested on real hardware: the device kernels repeat the
+ * scalar CPU arithmetic and are meant to match it within
+ * SIMPLEX_SIMD_TOLERANCE, but no OpenCL device has run them yet. Without one,
+ * test_gpu only checks the CPU fallback.
+ *
+ * @param enable 1 to enable, 0 to disable
+ * @return 0 on success, -1 if enabling found no usable device (offload stays off)
+ */
+int simplex_set_gpu(int enable);
+
+/**
+ * Get the name of the device the default context offloads to
+ * @return Device name, or NULL when arrays are generated on the CPU
+ */
+const char* simplex_get_gpu_name(void);
+
 /**
  * Enable or disable caching
  * @param enable 1 to enable, 0 to disable
@@ -185,11 +304,29 @@ int simplex_set_caching(int enable);
 
 /**
  * Enable or disable performance profiling
+ *
+ * Profiling records per-API call counts, sample counts, time and a latency
+ * histogram (see simplex_get_profile()). It is only available when the
+ * library is built with SIMPLEX_ENABLE_PROFILING; otherwise the hooks are
+ * compiled out and every counter stays 0.
+ *
  * @param enable 1 to enable, 0 to disable
  * @return 0 on success, negative error code on failure
  */
 int simplex_set_profiling(int enable);
 
+/**
+ * Set the number of threads the default context's arrays and images use
+ *
+ * Image generation keeps the setting when it reseeds the context;
+ * simplex_noise_init() restores the single-threaded default. Results are
+ * identical for any thread count.
+ *
+ * @param max_threads Threads, 1 to 64
+ * @return 0 on success, -1 if max_threads is out of range
+ */
+int simplex_set_max_threads(int max_threads);
+
 /* ===== CONFIGURATION MANAGEMENT ===== */
 
 /**
@@ -310,6 +447,95 @@ int simplex_print_config(const simplex_config_t* config, int format);
  */
 int simplex_create_example_config(const char* filename, simplex_config_type_t config_type);
 
+/* ===== BINARY CONFIGURATION ===== */
+
+/*
+ * SIMPLEX_CONFIG_BINARY files are versioned blobs laid out to be memory
+ * mapped: a header, the simplex_config_t as the library stores it, and
+ * optionally the permutation and gradient-index tables of a list of seeds,
+ * precomputed with the blob's PRNG. A process opening a blob maps it instead
+ * of parsing text, and contexts for the stored seeds copy their tables from
+ * the mapping instead of shuffling. Blobs hold native byte order and struct
+ * layout: they are for machines running the same build, and opening one
+ * written by a different layout or version fails.
+ */
+
+/* Mapped Binary Configuration (opaque) */
+typedef struct simplex_config_blob simplex_config_blob_t;
+
+enum { SIMPLEX_CONFIG_BLOB_VERSION = 1 };
+
+/**
+ * Save a configuration as a binary blob with precomputed seed tables
+ *
+ * simplex_save_config() with SIMPLEX_CONFIG_BINARY writes the same format
+ * without tables.
+ *
+ * @param filename Path to output file
+ * @param config Configuration to save
+ * @param seeds Seeds to precompute tables for (non-zero; duplicates are stored once)
+ * @param seed_count Number of seeds (0 for none)
+ * @return 0 on success, -1 on invalid arguments, allocation or write failure
+ */
+int simplex_save_config_binary(const char* filename, const simplex_config_t* config,
+                               const uint32_t* seeds, int seed_count);
+
+/**
+ * Map a binary configuration blob read-only
+ * @param filename Path to a file written by simplex_save_config_binary()
+ * @return Blob, or NULL if the file is missing, truncated, or of another version or layout
+ */
+simplex_config_blob_t* simplex_config_blob_open(const char* filename);
+
+/**
+ * Unmap a blob; contexts created from it stay valid
+ * @param blob Blob (NULL is ignored)
+ */
+void simplex_config_blob_close(simplex_config_blob_t* blob);
+
+/**
+ * Get the configuration stored in a blob
+ * @param blob Blob
+ * @return Configuration inside the mapping, valid until simplex_config_blob_close()
+ */
+const simplex_config_t* simplex_config_blob_config(const simplex_config_blob_t* blob);
+
+/**
+ * Get the number of seeds with precomputed tables
+ * @param blob Blob
+ * @return Seed count (0 for NULL)
+ */
+int simplex_config_blob_seed_count(const simplex_config_blob_t* blob);
+
+/**
+ * Get a seed with precomputed tables
+ * @param blob Blob
+ * @param index Index in [0, simplex_config_blob_seed_count()), seeds ascend
+ * @return Seed, or 0 for an invalid index
+ */
+uint32_t simplex_config_blob_seed(const simplex_config_blob_t* blob, int index);
+
+/**
+ * Create a context with a blob's configuration and the given seed
+ *
+ * The permutation comes from the blob when the seed is stored there and is
+ * shuffled otherwise; either way the context matches simplex_context_create()
+ * on the same configuration and seed.
+ *
+ * @param blob Blob
+ * @param seed Seed (0 for the blob configuration's seed)
+ * @return New context, or NULL on invalid arguments or allocation failure
+ */
+simplex_context_t* simplex_context_create_blob(const simplex_config_blob_t* blob, uint32_t seed);
+
+/**
+ * Initialize the default context from a blob, as simplex_context_create_blob()
+ * @param blob Blob
+ * @param seed Seed (0 for the blob configuration's seed)
+ * @return 0 on success, -1 on invalid arguments
+ */
+int simplex_noise_init_blob(const simplex_config_blob_t* blob, uint32_t seed);
+
 /* ===== CORE NOISE FUNCTIONS ===== */
 
 /**
@@ -346,6 +572,68 @@ double simplex_noise_3d(double x, double y, double z);
  */
 double simplex_noise_4d(double x, double y, double z, double w);
 
+/*
+ * Single-precision versions of the core functions. They evaluate the same
+ * algorithm entirely in float, so results differ from the double versions by
+ * up to SIMPLEX_F32_TOLERANCE; they are identical on every SIMD level.
+ */
+
+/**
+ * Generate 2D simplex noise in single precision
+ * @param x Input x coordinate
+ * @param y Input y coordinate
+ * @return Noise value in range [-1, 1]
+ */
+float simplex_noise_2df(float x, float y);
+
+/**
+ * Generate 3D simplex noise in single precision
+ * @param x Input x coordinate
+ * @param y Input y coordinate
+ * @param z Input z coordinate
+ * @return Noise value in range [-1, 1]
+ */
+float simplex_noise_3df(float x, float y, float z);
+
+/**
+ * Generate 4D simplex noise in single precision
+ * @param x Input x coordinate
+ * @param y Input y coordinate
+ * @param z Input z coordinate
+ * @param w Input w coordinate
+ * @return Noise value in range [-1, 1]
+ */
+float simplex_noise_4df(float x, float y, float z, float w);
+
+/*
+ * Seeded noise: the seed is an argument rather than context state. Each
+ * simplex corner takes its gradient from an integer hash of the corner's
+ * lattice point and the seed instead of the permutation table, so changing
+ * seeds costs nothing, the lattice does not repeat every 256 units, and the
+ * values differ from simplex_noise_2d()/3d() for any seed. Results do not
+ * depend on the context's seed, PRNG or precision and are identical on every
+ * SIMD level. See simplex_noise_layers_2d() for many seeds at once.
+ */
+
+/**
+ * Generate 2D seeded simplex noise
+ * @param x Input x coordinate
+ * @param y Input y coordinate
+ * @param seed Lattice hash seed
+ * @return Noise value in range [-1, 1]
+ */
+double simplex_noise_2d_seeded(double x, double y, uint32_t seed);
+
+/**
+ * Generate 3D seeded simplex noise
+ * @param x Input x coordinate
+ * @param y Input y coordinate
+ * @param z Input z coordinate
+ * @param seed Lattice hash seed
+ * @return Noise value in range [-1, 1]
+ */
+double simplex_noise_3d_seeded(double x, double y, double z, uint32_t seed);
+
 /* ===== ADVANCED NOISE VARIANTS ===== */
 
 /**
@@ -442,6 +730,54 @@ double simplex_hybrid_multifractal_2d(double x, double y, int octaves, double pe
  */
 double simplex_domain_warp_2d(double x, double y, double warp_strength);
 
+/*
+ * Multi-level fBm domain warping. Level l displaces the sample point p by
+ * strength times two fBm warp fields (the x and y displacements), sampled at
+ * the point displaced by level l - 1 plus the level's offsets; the result is
+ * the base fBm at the point displaced by the last level:
+ *
+ *   q = p; for each level: q = p + strength * (fbm(q + ox), fbm(q + oy))
+ *   result = fbm_base(q)
+ *
+ * With simplex_get_default_warp_config() (one level, one warp octave and
+ * offsets (0, 0) and (100, 100)) and one base octave this is
+ * simplex_domain_warp_2d() with warp_strength = strength.
+ */
+
+/* Most warp levels of a simplex_warp_config_t */
+enum { SIMPLEX_WARP_MAX_LEVELS = 2 };
+
+/* Warp fields of simplex_domain_warp_fbm_2d() and the warped arrays and images */
+typedef struct {
+    int levels;         /* Warp levels, 1 to SIMPLEX_WARP_MAX_LEVELS */
+    double strength;    /* Displacement per unit of warp field */
+    int octaves;        /* fBm octaves of each warp field (1 gives plain noise) */
+    double persistence; /* Amplitude multiplier per warp octave */
+    double lacunarity;  /* Frequency multiplier per warp octave */
+    /* Per level: where the x field (offsets[l][0], [1]) and the y field
+     * (offsets[l][2], [3]) are sampled relative to the warped point */
+    double offsets[SIMPLEX_WARP_MAX_LEVELS][4];
+} simplex_warp_config_t;
+
+/**
+ * Get the default warp: one level of plain-noise fields, strength 1
+ * @return Default warp configuration
+ */
+simplex_warp_config_t simplex_get_default_warp_config(void);
+
+/**
+ * Generate fBm-warped fBm noise (2D)
+ * @param x Input x coordinate
+ * @param y Input y coordinate
+ * @param octaves Octaves of the base fBm (1 gives plain noise)
+ * @param persistence Amplitude multiplier per base octave
+ * @param lacunarity Frequency multiplier per base octave
+ * @param warp Warp fields (NULL for simplex_get_default_warp_config())
+ * @return Warped noise value, 0 for an invalid configuration
+ */
+double simplex_domain_warp_fbm_2d(double x, double y, int octaves, double persistence,
+                                  double lacunarity, const simplex_warp_config_t* warp);
+
 /* ===== FRACTAL NOISE FUNCTIONS ===== */
 
 /**
@@ -468,6 +804,96 @@ double simplex_fractal_2d(double x, double y, int octaves, double persistence, d
 double simplex_fractal_3d(double x, double y, double z, int octaves, double persistence,
                           double lacunarity);
 
+/* ===== ANALYTIC DERIVATIVES ===== */
+
+/*
+ * Noise value and its exact gradient from one pass over the simplex corners,
+ * replacing finite differences. Values are identical to the plain functions.
+ * Gradients are with respect to the input coordinates.
+ */
+
+/**
+ * Generate 2D simplex noise and its gradient
+ * @param x Input x coordinate
+ * @param y Input y coordinate
+ * @param gradient Receives d/dx and d/dy (2 elements, may be NULL)
+ * @return Noise value, same as simplex_noise_2d()
+ */
+double simplex_noise_2d_deriv(double x, double y, double* gradient);
+
+/**
+ * Generate 3D simplex noise and its gradient
+ * @param x Input x coordinate
+ * @param y Input y coordinate
+ * @param z Input z coordinate
+ * @param gradient Receives d/dx, d/dy and d/dz (3 elements, may be NULL)
+ * @return Noise value, same as simplex_noise_3d()
+ */
+double simplex_noise_3d_deriv(double x, double y, double z, double* gradient);
+
+/**
+ * Generate 2D fractional Brownian motion and its gradient
+ * @param x Input x coordinate
+ * @param y Input y coordinate
+ * @param octaves Number of octaves
+ * @param persistence Amplitude multiplier per octave
+ * @param lacunarity Frequency multiplier per octave
+ * @param gradient Receives d/dx and d/dy (2 elements, may be NULL)
+ * @return fBm value, same as simplex_fbm_2d()
+ */
+double simplex_fbm_2d_deriv(double x, double y, int octaves, double persistence,
+                            double lacunarity, double* gradient);
+
+/**
+ * Generate a 2D grid of noise values and gradients
+ * @param x_start Starting x coordinate
+ * @param y_start Starting y coordinate
+ * @param width Array width
+ * @param height Array height
+ * @param step Step size between samples
+ * @param output Values (width * height elements, may be NULL)
+ * @param gradient Gradients, (d/dx, d/dy) per sample (2 * width * height elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_noise_array_2d_deriv(double x_start, double y_start, int width, int height,
+                                 double step, double* output, double* gradient);
+
+/**
+ * Generate a 3D grid of noise values and gradients
+ * @param x_start Starting x coordinate
+ * @param y_start Starting y coordinate
+ * @param z_start Starting z coordinate
+ * @param width Array width
+ * @param height Array height
+ * @param depth Array depth
+ * @param step Step size between samples
+ * @param output Values (width * height * depth elements, may be NULL)
+ * @param gradient Gradients, (d/dx, d/dy, d/dz) per sample (3 * width * height * depth
+ *        elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_noise_array_3d_deriv(double x_start, double y_start, double z_start, int width,
+                                 int height, int depth, double step, double* output,
+                                 double* gradient);
+
+/**
+ * Generate a 2D grid of fBm values and gradients
+ * @param x_start Starting x coordinate
+ * @param y_start Starting y coordinate
+ * @param width Array width
+ * @param height Array height
+ * @param step Step size between samples
+ * @param octaves Number of octaves
+ * @param persistence Amplitude multiplier per octave
+ * @param lacunarity Frequency multiplier per octave
+ * @param output Values (width * height elements, may be NULL)
+ * @param gradient Gradients, (d/dx, d/dy) per sample (2 * width * height elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_fbm_array_2d_deriv(double x_start, double y_start, int width, int height,
+                               double step, int octaves, double persistence, double lacunarity,
+                               double* output, double* gradient);
+
 /* ===== PERFORMANCE & UTILITY FUNCTIONS ===== */
 
 /**
@@ -484,22 +910,58 @@ void simplex_reset_performance_stats(void);
 
 /**
  * Get function call count
- * @return Number of function calls made
+ * @return Number of profiled calls made over every API family
  */
 size_t simplex_get_function_call_count(void);
 
 /**
- * Get cache hit count
+ * Get the profile of one API family
+ *
+ * Every thread records into its own counters; this merges them, so reading
+ * while other threads make calls is safe. Counters accumulate from context
+ * creation (re-initializing keeps them) until the performance stats are reset.
+ *
+ * @param api API family
+ * @param entry Profile to fill (zeroed when profiling is unavailable)
+ * @return 0 on success, -1 for an invalid argument or a build without
+ *         SIMPLEX_ENABLE_PROFILING
+ */
+int simplex_get_profile(simplex_profile_api_t api, simplex_profile_entry_t* entry);
+
+/**
+ * Get the name of an API family, e.g. "noise_2d"
+ * @param api API family
+ * @return Static name string, or "unknown" for an invalid value
+ */
+const char* simplex_get_profile_api_name(simplex_profile_api_t api);
+
+/**
+ * Get tile cache hit count
  * @return Number of cache hits
  */
 int simplex_get_cache_hits(void);
 
 /**
- * Get cache miss count
+ * Get tile cache miss count
  * @return Number of cache misses
  */
 int simplex_get_cache_misses(void);
 
+/*
+ * The array functions below split their rows (z-slices times rows in 3D)
+ * across an internal thread pool using up to config.max_threads threads, in
+ * tasks of roughly config.chunk_size samples; idle threads steal rows from
+ * busy ones. Results do not depend on the thread count. A call made while
+ * the pool is busy (from inside another array call or a second thread) runs
+ * on the calling thread alone.
+ *
+ * Sample (i, j, k) of a grid array is the point function at
+ * (x_start + i * step, y_start + j * step, z_start + k * step) - exactly in
+ * double precision without SIMD, within SIMPLEX_SIMD_TOLERANCE with it - at
+ * any distance from the origin. For chunks of a large world, whose starts
+ * lose fraction bits as doubles, see simplex_noise_array_2d_origin().
+ */
+
 /**
  * Generate noise array (2D) - optimized for bulk generation
  * @param x_start Starting x coordinate
@@ -528,9 +990,1040 @@ int simplex_noise_array_2d(double x_start, double y_start, int width, int height
 int simplex_noise_array_3d(double x_start, double y_start, double z_start, int width, int height,
                            int depth, double step, double* output);
 
+/*
+ * Chunk-origin arrays. Far from the origin a double start coordinate keeps
+ * few fraction bits, so chunks whose starts were rounded apart do not line
+ * up exactly. These variants take each axis as an integer lattice origin plus
+ * a double local offset: sample i lies at origin + offset + i * step. Each
+ * local coordinate is split into an integer cell and its exact fraction, and
+ * the lattice skew is applied to the two parts apart, so precision does not
+ * depend on the origin.
+ *
+ * A sample depends only on its cell and fraction: chunks agree bit-for-bit
+ * wherever their local coordinates represent the same world point exactly,
+ * e.g. with a power-of-two step and chunk spans that are whole lattice
+ * units. Compared with the point functions near the origin, samples agree
+ * within SIMPLEX_SIMD_TOLERANCE, except 3D samples within rounding of a
+ * simplex face, where the two may fall into neighbouring simplices (the 0.6
+ * radius of 3D noise steps there). Origins must lie within +/-2^50 and local
+ * coordinates within +/-2^31. Samples are always computed in double precision
+ * on the CPU with the scalar kernels, split across threads like the other
+ * arrays.
+ */
+
 /**
- * Cleanup and free resources
+ * Generate noise array (2D) from an integer chunk origin
+ * @param origin_x Integer x lattice coordinate of the chunk
+ * @param origin_y Integer y lattice coordinate of the chunk
+ * @param x_offset Local x coordinate of the first sample
+ * @param y_offset Local y coordinate of the first sample
+ * @param width Width of the array
+ * @param height Height of the array
+ * @param step Step size between samples
+ * @param output Array to store results (must be width*height elements)
+ * @return 0 on success, negative error code on failure
  */
-void simplex_cleanup(void);
+int simplex_noise_array_2d_origin(int64_t origin_x, int64_t origin_y, double x_offset,
+                                  double y_offset, int width, int height, double step,
+                                  double* output);
+
+/**
+ * Generate noise array (3D) from an integer chunk origin
+ * @param origin_x Integer x lattice coordinate of the chunk
+ * @param origin_y Integer y lattice coordinate of the chunk
+ * @param origin_z Integer z lattice coordinate of the chunk
+ * @param x_offset Local x coordinate of the first sample
+ * @param y_offset Local y coordinate of the first sample
+ * @param z_offset Local z coordinate of the first sample
+ * @param width Width of the array
+ * @param height Height of the array
+ * @param depth Depth of the array
+ * @param step Step size between samples
+ * @param output Array to store results (must be width*height*depth elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_noise_array_3d_origin(int64_t origin_x, int64_t origin_y, int64_t origin_z,
+                                  double x_offset, double y_offset, double z_offset, int width,
+                                  int height, int depth, double step, double* output);
+
+/**
+ * Generate fBm noise array (2D) - same values as simplex_fbm_2d() per sample
+ * @param x_start Starting x coordinate
+ * @param y_start Starting y coordinate
+ * @param width Width of the array
+ * @param height Height of the array
+ * @param step Step size between samples
+ * @param octaves Number of octaves
+ * @param persistence Amplitude multiplier per octave
+ * @param lacunarity Frequency multiplier per octave
+ * @param output Array to store results (must be width*height elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_fbm_array_2d(double x_start, double y_start, int width, int height, double step,
+                         int octaves, double persistence, double lacunarity, double* output);
+
+/**
+ * Generate fBm noise array (3D) - same values as simplex_fbm_3d() per sample
+ * @param x_start Starting x coordinate
+ * @param y_start Starting y coordinate
+ * @param z_start Starting z coordinate
+ * @param width Width of the array
+ * @param height Height of the array
+ * @param depth Depth of the array
+ * @param step Step size between samples
+ * @param octaves Number of octaves
+ * @param persistence Amplitude multiplier per octave
+ * @param lacunarity Frequency multiplier per octave
+ * @param output Array to store results (must be width*height*depth elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_fbm_array_3d(double x_start, double y_start, double z_start, int width, int height,
+                         int depth, double step, int octaves, double persistence,
+                         double lacunarity, double* output);
+
+/*
+ * The fractal array functions below evaluate one octave over a whole tile of
+ * samples before moving on to the next, so each octave runs as a single
+ * vectorized sweep. Every sample equals the matching per-point function.
+ */
+
+/**
+ * Generate fractal noise array (2D) - same values as simplex_fractal_2d()
+ * @param x_start Starting x coordinate
+ * @param y_start Starting y coordinate
+ * @param width Width of the array
+ * @param height Height of the array
+ * @param step Step size between samples
+ * @param octaves Number of octaves
+ * @param persistence Amplitude multiplier per octave
+ * @param lacunarity Frequency multiplier per octave
+ * @param output Array to store results (must be width*height elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_fractal_array_2d(double x_start, double y_start, int width, int height, double step,
+                             int octaves, double persistence, double lacunarity, double* output);
+
+/**
+ * Generate fractal noise array (3D) - same values as simplex_fractal_3d()
+ * @param x_start Starting x coordinate
+ * @param y_start Starting y coordinate
+ * @param z_start Starting z coordinate
+ * @param width Width of the array
+ * @param height Height of the array
+ * @param depth Depth of the array
+ * @param step Step size between samples
+ * @param octaves Number of octaves
+ * @param persistence Amplitude multiplier per octave
+ * @param lacunarity Frequency multiplier per octave
+ * @param output Array to store results (must be width*height*depth elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_fractal_array_3d(double x_start, double y_start, double z_start, int width, int height,
+                             int depth, double step, int octaves, double persistence,
+                             double lacunarity, double* output);
+
+/**
+ * Generate hybrid multi-fractal array (2D) - same values as
+ * simplex_hybrid_multifractal_2d()
+ * @param x_start Starting x coordinate
+ * @param y_start Starting y coordinate
+ * @param width Width of the array
+ * @param height Height of the array
+ * @param step Step size between samples
+ * @param octaves Number of octaves
+ * @param persistence Amplitude multiplier per octave
+ * @param lacunarity Frequency multiplier per octave
+ * @param offset Offset added to each octave
+ * @param output Array to store results (must be width*height elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_hybrid_multifractal_array_2d(double x_start, double y_start, int width, int height,
+                                         double step, int octaves, double persistence,
+                                         double lacunarity, double offset, double* output);
+
+/**
+ * Generate ridged noise array (2D) - same values as simplex_ridged_2d()
+ * @param x_start Starting x coordinate
+ * @param y_start Starting y coordinate
+ * @param width Width of the array
+ * @param height Height of the array
+ * @param step Step size between samples
+ * @param output Array to store results (must be width*height elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_ridged_array_2d(double x_start, double y_start, int width, int height, double step,
+                            double* output);
+
+/**
+ * Generate ridged noise array (3D) - same values as simplex_ridged_3d()
+ * @param x_start Starting x coordinate
+ * @param y_start Starting y coordinate
+ * @param z_start Starting z coordinate
+ * @param width Width of the array
+ * @param height Height of the array
+ * @param depth Depth of the array
+ * @param step Step size between samples
+ * @param output Array to store results (must be width*height*depth elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_ridged_array_3d(double x_start, double y_start, double z_start, int width, int height,
+                            int depth, double step, double* output);
+
+/**
+ * Generate billowy noise array (2D) - same values as simplex_billowy_2d()
+ * @param x_start Starting x coordinate
+ * @param y_start Starting y coordinate
+ * @param width Width of the array
+ * @param height Height of the array
+ * @param step Step size between samples
+ * @param output Array to store results (must be width*height elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_billowy_array_2d(double x_start, double y_start, int width, int height, double step,
+                             double* output);
+
+/**
+ * Generate billowy noise array (3D) - same values as simplex_billowy_3d()
+ * @param x_start Starting x coordinate
+ * @param y_start Starting y coordinate
+ * @param z_start Starting z coordinate
+ * @param width Width of the array
+ * @param height Height of the array
+ * @param depth Depth of the array
+ * @param step Step size between samples
+ * @param output Array to store results (must be width*height*depth elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_billowy_array_3d(double x_start, double y_start, double z_start, int width,
+                             int height, int depth, double step, double* output);
+
+/*
+ * Reduced-size outputs. Each array function above evaluates in single
+ * precision, using the float32 kernels with twice the SIMD lanes, when the
+ * configuration's precision is SIMPLEX_PRECISION_SINGLE, and in double
+ * precision otherwise. The _f32 and _u16 variants below follow the same rule
+ * but store float samples, or uint16 samples with [-1, 1] mapped linearly
+ * onto [0, 65535] (values outside that range are clamped), e.g. for R16
+ * heightmaps.
+ */
+
+/**
+ * Generate noise array (2D) as floats
+ * @param x_start Starting x coordinate
+ * @param y_start Starting y coordinate
+ * @param width Width of the array
+ * @param height Height of the array
+ * @param step Step size between samples
+ * @param output Array to store results (must be width*height elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_noise_array_2d_f32(double x_start, double y_start, int width, int height,
+                               double step, float* output);
+
+/**
+ * Generate noise array (2D) as uint16
+ * @param x_start Starting x coordinate
+ * @param y_start Starting y coordinate
+ * @param width Width of the array
+ * @param height Height of the array
+ * @param step Step size between samples
+ * @param output Array to store results (must be width*height elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_noise_array_2d_u16(double x_start, double y_start, int width, int height,
+                               double step, uint16_t* output);
+
+/**
+ * Generate noise array (3D) as floats
+ * @param x_start Starting x coordinate
+ * @param y_start Starting y coordinate
+ * @param z_start Starting z coordinate
+ * @param width Width of the array
+ * @param height Height of the array
+ * @param depth Depth of the array
+ * @param step Step size between samples
+ * @param output Array to store results (must be width*height*depth elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_noise_array_3d_f32(double x_start, double y_start, double z_start, int width,
+                               int height, int depth, double step, float* output);
+
+/**
+ * Generate fractal noise array (2D) as floats
+ * @param x_start Starting x coordinate
+ * @param y_start Starting y coordinate
+ * @param width Width of the array
+ * @param height Height of the array
+ * @param step Step size between samples
+ * @param octaves Number of octaves
+ * @param persistence Amplitude multiplier per octave
+ * @param lacunarity Frequency multiplier per octave
+ * @param output Array to store results (must be width*height elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_fractal_array_2d_f32(double x_start, double y_start, int width, int height,
+                                 double step, int octaves, double persistence, double lacunarity,
+                                 float* output);
+
+/**
+ * Generate fractal noise array (2D) as uint16
+ * @param x_start Starting x coordinate
+ * @param y_start Starting y coordinate
+ * @param width Width of the array
+ * @param height Height of the array
+ * @param step Step size between samples
+ * @param octaves Number of octaves
+ * @param persistence Amplitude multiplier per octave
+ * @param lacunarity Frequency multiplier per octave
+ * @param output Array to store results (must be width*height elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_fractal_array_2d_u16(double x_start, double y_start, int width, int height,
+                                 double step, int octaves, double persistence, double lacunarity,
+                                 uint16_t* output);
+
+/*
+ * Scattered points. Each function below evaluates output[i] at (xs[i], ys[i],
+ * ...) for i in [0, count), reading the coordinate arrays in place and giving
+ * the same values as the matching point function. Points are spread over the
+ * thread pool like array rows and are always evaluated in double precision.
+ * A count of 0 succeeds without touching any buffer.
+ */
+
+/**
+ * Evaluate 2D noise at scattered points
+ * @param xs X coordinates (count elements)
+ * @param ys Y coordinates (count elements)
+ * @param count Number of points
+ * @param output Array to store results (must be count elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_noise_2d_points(const double* xs, const double* ys, size_t count, double* output);
+
+/**
+ * Evaluate 3D noise at scattered points
+ * @param xs X coordinates (count elements)
+ * @param ys Y coordinates (count elements)
+ * @param zs Z coordinates (count elements)
+ * @param count Number of points
+ * @param output Array to store results (must be count elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_noise_3d_points(const double* xs, const double* ys, const double* zs, size_t count,
+                            double* output);
+
+/**
+ * Evaluate 4D noise at scattered points
+ * @param xs X coordinates (count elements)
+ * @param ys Y coordinates (count elements)
+ * @param zs Z coordinates (count elements)
+ * @param ws W coordinates (count elements)
+ * @param count Number of points
+ * @param output Array to store results (must be count elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_noise_4d_points(const double* xs, const double* ys, const double* zs,
+                            const double* ws, size_t count, double* output);
+
+/*
+ * Other point layouts. The _aos functions read interleaved points: point i
+ * has its coordinates at points[i * stride .. i * stride + dims - 1], so
+ * stride == dims for packed (x, y[, z[, w]]) tuples and larger to skip other
+ * fields of a vertex or particle record. The _f32 functions take float
+ * coordinates and store float results; noise is still evaluated in double
+ * precision, so results are the double ones rounded to float.
+ */
+
+/**
+ * Evaluate 2D noise at interleaved points
+ * @param points Interleaved coordinates, (count - 1) * stride + 2 elements
+ * @param stride Elements between consecutive points (at least 2)
+ * @param count Number of points
+ * @param output Array to store results (must be count elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_noise_2d_points_aos(const double* points, size_t stride, size_t count,
+                                double* output);
+
+/**
+ * Evaluate 3D noise at interleaved points
+ * @param points Interleaved coordinates, (count - 1) * stride + 3 elements
+ * @param stride Elements between consecutive points (at least 3)
+ * @param count Number of points
+ * @param output Array to store results (must be count elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_noise_3d_points_aos(const double* points, size_t stride, size_t count,
+                                double* output);
+
+/**
+ * Evaluate 4D noise at interleaved points
+ * @param points Interleaved coordinates, (count - 1) * stride + 4 elements
+ * @param stride Elements between consecutive points (at least 4)
+ * @param count Number of points
+ * @param output Array to store results (must be count elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_noise_4d_points_aos(const double* points, size_t stride, size_t count,
+                                double* output);
+
+/**
+ * Evaluate 2D noise at scattered float points
+ * @param xs X coordinates (count elements)
+ * @param ys Y coordinates (count elements)
+ * @param count Number of points
+ * @param output Array to store results (must be count elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_noise_2d_points_f32(const float* xs, const float* ys, size_t count, float* output);
+
+/**
+ * Evaluate 3D noise at scattered float points
+ * @param xs X coordinates (count elements)
+ * @param ys Y coordinates (count elements)
+ * @param zs Z coordinates (count elements)
+ * @param count Number of points
+ * @param output Array to store results (must be count elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_noise_3d_points_f32(const float* xs, const float* ys, const float* zs, size_t count,
+                                float* output);
+
+/**
+ * Evaluate 4D noise at scattered float points
+ * @param xs X coordinates (count elements)
+ * @param ys Y coordinates (count elements)
+ * @param zs Z coordinates (count elements)
+ * @param ws W coordinates (count elements)
+ * @param count Number of points
+ * @param output Array to store results (must be count elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_noise_4d_points_f32(const float* xs, const float* ys, const float* zs,
+                                const float* ws, size_t count, float* output);
+
+/**
+ * Evaluate 2D noise at interleaved float points
+ * @param points Interleaved coordinates, (count - 1) * stride + 2 elements
+ * @param stride Elements between consecutive points (at least 2)
+ * @param count Number of points
+ * @param output Array to store results (must be count elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_noise_2d_points_aos_f32(const float* points, size_t stride, size_t count,
+                                    float* output);
+
+/**
+ * Evaluate 3D noise at interleaved float points
+ * @param points Interleaved coordinates, (count - 1) * stride + 3 elements
+ * @param stride Elements between consecutive points (at least 3)
+ * @param count Number of points
+ * @param output Array to store results (must be count elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_noise_3d_points_aos_f32(const float* points, size_t stride, size_t count,
+                                    float* output);
+
+/**
+ * Evaluate 4D noise at interleaved float points
+ * @param points Interleaved coordinates, (count - 1) * stride + 4 elements
+ * @param stride Elements between consecutive points (at least 4)
+ * @param count Number of points
+ * @param output Array to store results (must be count elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_noise_4d_points_aos_f32(const float* points, size_t stride, size_t count,
+                                    float* output);
+
+/**
+ * Evaluate fBm noise (2D) at scattered points - same values as simplex_fbm_2d()
+ * @param xs X coordinates (count elements)
+ * @param ys Y coordinates (count elements)
+ * @param count Number of points
+ * @param octaves Number of octaves
+ * @param persistence Amplitude multiplier per octave
+ * @param lacunarity Frequency multiplier per octave
+ * @param output Array to store results (must be count elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_fbm_2d_points(const double* xs, const double* ys, size_t count, int octaves,
+                          double persistence, double lacunarity, double* output);
+
+/**
+ * Evaluate fBm noise (3D) at scattered points - same values as simplex_fbm_3d()
+ * @param xs X coordinates (count elements)
+ * @param ys Y coordinates (count elements)
+ * @param zs Z coordinates (count elements)
+ * @param count Number of points
+ * @param octaves Number of octaves
+ * @param persistence Amplitude multiplier per octave
+ * @param lacunarity Frequency multiplier per octave
+ * @param output Array to store results (must be count elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_fbm_3d_points(const double* xs, const double* ys, const double* zs, size_t count,
+                          int octaves, double persistence, double lacunarity, double* output);
+
+/**
+ * Evaluate ridged noise (2D) at scattered points - same values as simplex_ridged_2d()
+ * @param xs X coordinates (count elements)
+ * @param ys Y coordinates (count elements)
+ * @param count Number of points
+ * @param output Array to store results (must be count elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_ridged_2d_points(const double* xs, const double* ys, size_t count, double* output);
+
+/**
+ * Evaluate billowy noise (2D) at scattered points - same values as simplex_billowy_2d()
+ * @param xs X coordinates (count elements)
+ * @param ys Y coordinates (count elements)
+ * @param count Number of points
+ * @param output Array to store results (must be count elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_billowy_2d_points(const double* xs, const double* ys, size_t count, double* output);
+
+/*
+ * LOD pyramids hold fBm of one region at `levels` resolutions in one buffer,
+ * level 0 (full resolution) first and each level row-major right after the
+ * previous one. Level l has ceil(width / 2^l) x ceil(height / 2^l) samples,
+ * sample (i, j) at (x_start + i * step * 2^l, y_start + j * step * 2^l), so
+ * every coarse sample sits on a sample of each finer level.
+ *
+ * Level l keeps octave k while lacunarity^k * step * 2^l <= 0.5, i.e. while
+ * the octave gets at least two samples per noise unit; octave 0 is always
+ * kept. Every level is divided by the amplitude sum of all `octaves`, so
+ * coarse levels are the band-limited version of the finer ones. Levels are
+ * generated coarsest first, and samples that coincide with the next coarser
+ * level start from its octave sum and only add the octaves it dropped; with
+ * every octave kept, level 0 equals simplex_fbm_array_2d() exactly. Noise is
+ * always computed in double precision.
+ */
+
+/**
+ * Locate a level of an LOD pyramid in its buffer
+ * @param width Width of level 0
+ * @param height Height of level 0
+ * @param level Level to locate; `levels` gives the size of a whole pyramid
+ * @param level_width Set to the level's width, 0 if the arguments are invalid (may be NULL)
+ * @param level_height Set to the level's height, 0 if the arguments are invalid (may be NULL)
+ * @return Offset of the level's first sample, in samples
+ */
+size_t simplex_pyramid_level(int width, int height, int level, int* level_width,
+                             int* level_height);
+
+/**
+ * Generate an fBm LOD pyramid (2D)
+ * @param x_start Starting x coordinate
+ * @param y_start Starting y coordinate
+ * @param width Width of level 0
+ * @param height Height of level 0
+ * @param step Step size between level 0 samples
+ * @param levels Number of levels, 1 to 32
+ * @param octaves Number of octaves at full resolution
+ * @param persistence Amplitude multiplier per octave
+ * @param lacunarity Frequency multiplier per octave
+ * @param output Array to store results (must be simplex_pyramid_level(width, height, levels,
+ *               NULL, NULL) elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_fbm_pyramid_2d(double x_start, double y_start, int width, int height, double step,
+                           int levels, int octaves, double persistence, double lacunarity,
+                           double* output);
+
+/*
+ * Seeded layers: one grid evaluated for several seeds in a single pass. The
+ * skew and corner selection of each sample are shared by every layer, which
+ * then only adds its corner hashes and gradients. Layer l holds
+ * simplex_noise_2d_seeded()/3d_seeded() under seeds[l], exactly, and starts
+ * width * height (* depth) samples after layer l - 1.
+ */
+
+/**
+ * Generate seeded 2D noise layers
+ * @param x_start Starting x coordinate
+ * @param y_start Starting y coordinate
+ * @param width Width of the grid
+ * @param height Height of the grid
+ * @param step Step size between samples
+ * @param seeds Seed of each layer
+ * @param layers Number of layers
+ * @param output Array to store results (must be width * height * layers elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_noise_layers_2d(double x_start, double y_start, int width, int height, double step,
+                            const uint32_t* seeds, int layers, double* output);
+
+/**
+ * Generate seeded 3D noise layers
+ * @param x_start Starting x coordinate
+ * @param y_start Starting y coordinate
+ * @param z_start Starting z coordinate
+ * @param width Width of the grid
+ * @param height Height of the grid
+ * @param depth Depth of the grid
+ * @param step Step size between samples
+ * @param seeds Seed of each layer
+ * @param layers Number of layers
+ * @param output Array to store results (must be width * height * depth * layers elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_noise_layers_3d(double x_start, double y_start, double z_start, int width,
+                            int height, int depth, double step, const uint32_t* seeds,
+                            int layers, double* output);
+
+/*
+ * Warped arrays: simplex_domain_warp_fbm_2d() over a grid. Each tile of
+ * samples is evaluated level by level: the warp fields of the whole tile first
+ * (octave by octave through the vectorized point kernels), then the base fBm
+ * at the tile's warped coordinates in one more batched pass. Samples are
+ * always computed in double precision and match the point function within
+ * SIMPLEX_SIMD_TOLERANCE (exactly without SIMD).
+ */
+
+/**
+ * Generate fBm-warped fBm noise array (2D)
+ * @param x_start Starting x coordinate
+ * @param y_start Starting y coordinate
+ * @param width Width of the array
+ * @param height Height of the array
+ * @param step Step size between samples
+ * @param octaves Octaves of the base fBm (1 gives plain noise)
+ * @param persistence Amplitude multiplier per base octave
+ * @param lacunarity Frequency multiplier per base octave
+ * @param warp Warp fields (NULL for simplex_get_default_warp_config())
+ * @param output Array to store results (must be width*height elements)
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_domain_warp_array_2d(double x_start, double y_start, int width, int height,
+                                 double step, int octaves, double persistence, double lacunarity,
+                                 const simplex_warp_config_t* warp, double* output);
+
+/* ===== TILE CACHE ===== */
+
+/*
+ * Fractal noise tiles shared through a per-context LRU cache. Repeated
+ * requests for the same tile return the same read-only buffer instead of
+ * generating it again. The cache holds at most config.cache_size_mb of tile
+ * data and evicts the least recently used tiles beyond that; with
+ * enable_caching off (or a tile larger than the whole budget) tiles are
+ * generated on every request. Hits, misses and evictions are reported in
+ * simplex_perf_stats_t. Acquiring and releasing tiles is thread-safe.
+ */
+
+/* One tile of fBm noise */
+typedef struct {
+    int tile_x;         /* Tile column; the tile starts at x = tile_x * tile_size */
+    int tile_y;         /* Tile row; the tile starts at y = tile_y * tile_size */
+    int resolution;     /* Samples per tile side */
+    double tile_size;   /* World units covered by one tile side */
+    int octaves;        /* Number of octaves (1 gives plain noise) */
+    double persistence; /* Amplitude multiplier per octave */
+    double lacunarity;  /* Frequency multiplier per octave */
+} simplex_tile_request_t;
+
+/**
+ * Get a tile from the cache, generating it on a miss
+ *
+ * Sample (i, j) of the row-major resolution*resolution buffer is the value of
+ * simplex_fractal_array_2d() at (tile_x * tile_size + i * tile_size /
+ * resolution, tile_y * tile_size + j * tile_size / resolution), so adjacent
+ * tiles line up. The buffer stays valid until simplex_tile_release(), even if
+ * the tile is evicted in the meantime.
+ *
+ * @param request Tile to fetch
+ * @return Read-only tile samples, or NULL on invalid request or memory failure
+ */
+const double* simplex_tile_acquire(const simplex_tile_request_t* request);
+
+/**
+ * Release a tile returned by simplex_tile_acquire(); call once per acquire.
+ * Every tile must be released before its context is destroyed or cleaned up.
+ * @param tile Tile samples (NULL is ignored)
+ */
+void simplex_tile_release(const double* tile);
+
+/* ===== BUFFER ARENAS ===== */
+
+/*
+ * A caller-owned workspace that keeps one block of memory alive across calls.
+ * Image generation takes its band, frame and row buffers from the arena set in
+ * simplex_image_config_t.arena instead of allocating them per call, and
+ * simplex_arena_buffer() hands callers of the array functions output storage
+ * from the same block. The block grows only when a request needs more than its
+ * capacity, so a loop of same-sized renders allocates once. Every buffer starts
+ * on a SIMPLEX_ARENA_ALIGNMENT boundary. An arena is used by one call at a
+ * time: threads rendering concurrently each need their own.
+ */
+
+/* Buffer Arena (opaque) */
+typedef struct simplex_arena simplex_arena_t;
+
+enum { SIMPLEX_ARENA_ALIGNMENT = 64 };
+
+/* Arena creation flags */
+typedef enum {
+    SIMPLEX_ARENA_DEFAULT = 0,
+    SIMPLEX_ARENA_HUGE_PAGES = 1 /* Back blocks of 2 MB or more with huge pages where available */
+} simplex_arena_flags_t;
+
+/**
+ * Create an empty arena; no memory is reserved until the first request
+ * @param flags SIMPLEX_ARENA_DEFAULT or SIMPLEX_ARENA_HUGE_PAGES
+ * @return New arena, or NULL on invalid flags or allocation failure
+ */
+simplex_arena_t* simplex_arena_create(int flags);
+
+/**
+ * Destroy an arena and its block
+ * @param arena Arena to destroy (NULL is ignored)
+ */
+void simplex_arena_destroy(simplex_arena_t* arena);
+
+/**
+ * Get an aligned buffer of at least size bytes from the arena's block
+ *
+ * The buffer is the start of the block, so it stays valid, and keeps its
+ * contents, until the next simplex_arena_buffer() or image call with this
+ * arena, simplex_arena_release() or simplex_arena_destroy(). A request
+ * within the capacity returns the same pointer as the previous one.
+ *
+ * @param arena Arena
+ * @param size Bytes needed
+ * @return Buffer, or NULL on a zero size or allocation failure
+ */
+void* simplex_arena_buffer(simplex_arena_t* arena, size_t size);
+
+/**
+ * Get the size of an arena's block
+ * @param arena Arena
+ * @return Bytes currently reserved (0 for NULL or an empty arena)
+ */
+size_t simplex_arena_capacity(const simplex_arena_t* arena);
+
+/**
+ * Free an arena's block, keeping the arena for later use
+ * @param arena Arena (NULL is ignored)
+ */
+void simplex_arena_release(simplex_arena_t* arena);
+
+/* ===== ASYNCHRONOUS JOBS ===== */
+
+/*
+ * Array and image requests can be queued instead of run on the calling
+ * thread. Jobs are taken by two runner threads, started on the first
+ * submission, which call the blocking functions and so spread each job over
+ * the thread pool (max_threads) like any other caller; results are identical
+ * to the blocking calls. Higher priorities start first, in submission order
+ * within a priority. One runner only takes SIMPLEX_JOB_INTERACTIVE jobs, so
+ * an interactive job never waits for a background job to finish; while
+ * another job holds the thread pool it runs on its runner alone.
+ *
+ * The callback, if any, runs on the thread that completes the job: a runner,
+ * or the thread cancelling it. It must not wait for jobs, and must not call
+ * simplex_cleanup(), which cancels every queued job and waits for running
+ * ones. Inputs are copied at submission; outputs, and contexts passed in,
+ * must stay valid until the job has finished.
+ */
+
+/* Job handle (opaque) */
+typedef struct simplex_job simplex_job_t;
+
+/* Job priorities */
+typedef enum {
+    SIMPLEX_JOB_BACKGROUND = 0, /* Bakes and prefetching */
+    SIMPLEX_JOB_NORMAL,
+    SIMPLEX_JOB_INTERACTIVE, /* Latency-sensitive requests, with a runner of their own */
+    SIMPLEX_JOB_PRIORITY_COUNT
+} simplex_job_priority_t;
+
+/* Job states */
+typedef enum {
+    SIMPLEX_JOB_QUEUED = 0,
+    SIMPLEX_JOB_RUNNING,
+    SIMPLEX_JOB_DONE,
+    SIMPLEX_JOB_FAILED, /* The blocking call reported an error */
+    SIMPLEX_JOB_CANCELLED
+} simplex_job_status_t;
+
+/* Completion callback: status is SIMPLEX_JOB_DONE, _FAILED or _CANCELLED */
+typedef void (*simplex_job_callback_t)(simplex_job_t* job, simplex_job_status_t status,
+                                       void* user_data);
+
+/* A 2D grid request, as for simplex_noise_array_2d() and simplex_fbm_array_2d() */
+typedef struct {
+    double x_start;     /* Starting x coordinate */
+    double y_start;     /* Starting y coordinate */
+    int width;          /* Samples per row */
+    int height;         /* Rows */
+    double step;        /* Step size between samples */
+    int octaves;        /* 1 for plain noise, more for fBm */
+    double persistence; /* Amplitude multiplier per octave (fBm only) */
+    double lacunarity;  /* Frequency multiplier per octave (fBm only) */
+} simplex_array_params_t;
+
+/**
+ * Queue a 2D noise or fBm array
+ * @param ctx Context to generate with (NULL for the default context)
+ * @param params Grid to generate
+ * @param output Array of width*height elements, written by the job
+ * @param priority Job priority
+ * @param callback Called once the job is done, failed or cancelled (may be NULL)
+ * @param user_data Passed to the callback
+ * @param job Receives a handle to release with simplex_job_release() (NULL for none)
+ * @return 0 on success, -1 on invalid parameters or if the job could not be queued
+ */
+int simplex_submit_array_2d(const simplex_context_t* ctx, const simplex_array_params_t* params,
+                            double* output, simplex_job_priority_t priority,
+                            simplex_job_callback_t callback, void* user_data,
+                            simplex_job_t** job);
+
+/**
+ * Cancel a job that has not started; its callback is called with
+ * SIMPLEX_JOB_CANCELLED before this returns
+ * @param job Job
+ * @return 0 if the job was cancelled, -1 if it has already started or finished
+ */
+int simplex_job_cancel(simplex_job_t* job);
+
+/**
+ * Get a job's current state
+ * @param job Job
+ * @return Job state (SIMPLEX_JOB_FAILED for NULL)
+ */
+simplex_job_status_t simplex_job_status(simplex_job_t* job);
+
+/**
+ * Wait until a job has finished or been cancelled, and its callback has returned
+ * @param job Job
+ * @return SIMPLEX_JOB_DONE, SIMPLEX_JOB_FAILED (also for NULL) or SIMPLEX_JOB_CANCELLED
+ */
+simplex_job_status_t simplex_job_wait(simplex_job_t* job);
+
+/**
+ * Wait for a batch of jobs
+ * @param jobs Jobs to wait for
+ * @param count Number of jobs
+ * @return 0 if every job is done, -1 if any failed or was cancelled
+ */
+int simplex_job_wait_all(simplex_job_t* const* jobs, int count);
+
+/**
+ * Release a job handle; a job still queued or running goes on regardless
+ * @param job Job (NULL is ignored)
+ */
+void simplex_job_release(simplex_job_t* job);
+
+/**
+ * Cleanup and free resources
+ */
+void simplex_cleanup(void);
+
+/* ===== NOISE CONTEXTS ===== */
+
+/*
+ * A context owns its own permutation table, PRNG state, configuration and
+ * statistics. Every function above has a _ctx variant taking a context as its
+ * first argument; the plain functions run on a built-in default context, and
+ * passing NULL to a _ctx function selects that default context as well.
+ *
+ * Evaluating noise only reads the context, so threads may share one context
+ * or each use their own (e.g. one per seed) without any locking.
+ */
+
+/**
+ * Create an independent noise context
+ * @param config Configuration to use (NULL for simplex_get_default_config();
+ *               a seed of 0 picks a time-based seed)
+ * @return New context, or NULL on allocation failure
+ */
+simplex_context_t* simplex_context_create(const simplex_config_t* config);
+
+/**
+ * Destroy a context created with simplex_context_create()
+ * @param ctx Context to destroy (NULL is ignored)
+ */
+void simplex_context_destroy(simplex_context_t* ctx);
+
+/**
+ * Get a context's active configuration, including the resolved seed
+ * @param ctx Context (NULL for the default context)
+ * @param config Pointer to configuration structure to fill
+ * @return 0 on success, negative error code on failure
+ */
+int simplex_context_get_config(const simplex_context_t* ctx, simplex_config_t* config);
+
+/**
+ * Get the name of the device a context offloads grid arrays to
+ * @param ctx Context (NULL for the default context)
+ * @return Device name, or NULL when the context's arrays are generated on the CPU
+ */
+const char* simplex_get_gpu_name_ctx(const simplex_context_t* ctx);
+
+double simplex_noise_1d_ctx(const simplex_context_t* ctx, double x);
+double simplex_noise_2d_ctx(const simplex_context_t* ctx, double x, double y);
+double simplex_noise_3d_ctx(const simplex_context_t* ctx, double x, double y, double z);
+double simplex_noise_4d_ctx(const simplex_context_t* ctx, double x, double y, double z, double w);
+float simplex_noise_2df_ctx(const simplex_context_t* ctx, float x, float y);
+float simplex_noise_3df_ctx(const simplex_context_t* ctx, float x, float y, float z);
+float simplex_noise_4df_ctx(const simplex_context_t* ctx, float x, float y, float z, float w);
+double simplex_noise_2d_seeded_ctx(const simplex_context_t* ctx, double x, double y,
+                                   uint32_t seed);
+double simplex_noise_3d_seeded_ctx(const simplex_context_t* ctx, double x, double y, double z,
+                                   uint32_t seed);
+
+double simplex_ridged_1d_ctx(const simplex_context_t* ctx, double x);
+double simplex_ridged_2d_ctx(const simplex_context_t* ctx, double x, double y);
+double simplex_ridged_3d_ctx(const simplex_context_t* ctx, double x, double y, double z);
+double simplex_billowy_1d_ctx(const simplex_context_t* ctx, double x);
+double simplex_billowy_2d_ctx(const simplex_context_t* ctx, double x, double y);
+double simplex_billowy_3d_ctx(const simplex_context_t* ctx, double x, double y, double z);
+
+double simplex_fbm_2d_ctx(const simplex_context_t* ctx, double x, double y, int octaves,
+                          double persistence, double lacunarity);
+double simplex_fbm_3d_ctx(const simplex_context_t* ctx, double x, double y, double z, int octaves,
+                          double persistence, double lacunarity);
+double simplex_hybrid_multifractal_2d_ctx(const simplex_context_t* ctx, double x, double y,
+                                          int octaves, double persistence, double lacunarity,
+                                          double offset);
+double simplex_domain_warp_2d_ctx(const simplex_context_t* ctx, double x, double y,
+                                  double warp_strength);
+double simplex_domain_warp_fbm_2d_ctx(const simplex_context_t* ctx, double x, double y,
+                                      int octaves, double persistence, double lacunarity,
+                                      const simplex_warp_config_t* warp);
+double simplex_fractal_2d_ctx(const simplex_context_t* ctx, double x, double y, int octaves,
+                              double persistence, double lacunarity);
+double simplex_fractal_3d_ctx(const simplex_context_t* ctx, double x, double y, double z,
+                              int octaves, double persistence, double lacunarity);
+double simplex_noise_2d_deriv_ctx(const simplex_context_t* ctx, double x, double y,
+                                  double* gradient);
+double simplex_noise_3d_deriv_ctx(const simplex_context_t* ctx, double x, double y, double z,
+                                  double* gradient);
+double simplex_fbm_2d_deriv_ctx(const simplex_context_t* ctx, double x, double y, int octaves,
+                                double persistence, double lacunarity, double* gradient);
+
+int simplex_noise_array_2d_deriv_ctx(const simplex_context_t* ctx, double x_start,
+                                     double y_start, int width, int height, double step,
+                                     double* output, double* gradient);
+int simplex_noise_array_3d_deriv_ctx(const simplex_context_t* ctx, double x_start,
+                                     double y_start, double z_start, int width, int height,
+                                     int depth, double step, double* output, double* gradient);
+int simplex_fbm_array_2d_deriv_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                                   int width, int height, double step, int octaves,
+                                   double persistence, double lacunarity, double* output,
+                                   double* gradient);
+int simplex_noise_array_2d_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                               int width, int height, double step, double* output);
+int simplex_noise_array_3d_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                               double z_start, int width, int height, int depth, double step,
+                               double* output);
+int simplex_noise_array_2d_origin_ctx(const simplex_context_t* ctx, int64_t origin_x,
+                                      int64_t origin_y, double x_offset, double y_offset,
+                                      int width, int height, double step, double* output);
+int simplex_noise_array_3d_origin_ctx(const simplex_context_t* ctx, int64_t origin_x,
+                                      int64_t origin_y, int64_t origin_z, double x_offset,
+                                      double y_offset, double z_offset, int width, int height,
+                                      int depth, double step, double* output);
+int simplex_fbm_array_2d_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                             int width, int height, double step, int octaves, double persistence,
+                             double lacunarity, double* output);
+int simplex_fbm_array_3d_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                             double z_start, int width, int height, int depth, double step,
+                             int octaves, double persistence, double lacunarity, double* output);
+int simplex_fractal_array_2d_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                                 int width, int height, double step, int octaves,
+                                 double persistence, double lacunarity, double* output);
+int simplex_fractal_array_3d_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                                 double z_start, int width, int height, int depth, double step,
+                                 int octaves, double persistence, double lacunarity,
+                                 double* output);
+int simplex_hybrid_multifractal_array_2d_ctx(const simplex_context_t* ctx, double x_start,
+                                             double y_start, int width, int height, double step,
+                                             int octaves, double persistence, double lacunarity,
+                                             double offset, double* output);
+int simplex_ridged_array_2d_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                                int width, int height, double step, double* output);
+int simplex_ridged_array_3d_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                                double z_start, int width, int height, int depth, double step,
+                                double* output);
+int simplex_billowy_array_2d_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                                 int width, int height, double step, double* output);
+int simplex_billowy_array_3d_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                                 double z_start, int width, int height, int depth, double step,
+                                 double* output);
+
+int simplex_noise_array_2d_f32_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                                   int width, int height, double step, float* output);
+int simplex_noise_array_2d_u16_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                                   int width, int height, double step, uint16_t* output);
+int simplex_noise_array_3d_f32_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                                   double z_start, int width, int height, int depth, double step,
+                                   float* output);
+int simplex_fractal_array_2d_f32_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                                     int width, int height, double step, int octaves,
+                                     double persistence, double lacunarity, float* output);
+int simplex_fractal_array_2d_u16_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                                     int width, int height, double step, int octaves,
+                                     double persistence, double lacunarity, uint16_t* output);
+
+int simplex_noise_2d_points_ctx(const simplex_context_t* ctx, const double* xs, const double* ys,
+                                size_t count, double* output);
+int simplex_noise_3d_points_ctx(const simplex_context_t* ctx, const double* xs, const double* ys,
+                                const double* zs, size_t count, double* output);
+int simplex_noise_4d_points_ctx(const simplex_context_t* ctx, const double* xs, const double* ys,
+                                const double* zs, const double* ws, size_t count,
+                                double* output);
+int simplex_noise_2d_points_aos_ctx(const simplex_context_t* ctx, const double* points,
+                                    size_t stride, size_t count, double* output);
+int simplex_noise_3d_points_aos_ctx(const simplex_context_t* ctx, const double* points,
+                                    size_t stride, size_t count, double* output);
+int simplex_noise_4d_points_aos_ctx(const simplex_context_t* ctx, const double* points,
+                                    size_t stride, size_t count, double* output);
+int simplex_noise_2d_points_f32_ctx(const simplex_context_t* ctx, const float* xs,
+                                    const float* ys, size_t count, float* output);
+int simplex_noise_3d_points_f32_ctx(const simplex_context_t* ctx, const float* xs,
+                                    const float* ys, const float* zs, size_t count,
+                                    float* output);
+int simplex_noise_4d_points_f32_ctx(const simplex_context_t* ctx, const float* xs,
+                                    const float* ys, const float* zs, const float* ws,
+                                    size_t count, float* output);
+int simplex_noise_2d_points_aos_f32_ctx(const simplex_context_t* ctx, const float* points,
+                                        size_t stride, size_t count, float* output);
+int simplex_noise_3d_points_aos_f32_ctx(const simplex_context_t* ctx, const float* points,
+                                        size_t stride, size_t count, float* output);
+int simplex_noise_4d_points_aos_f32_ctx(const simplex_context_t* ctx, const float* points,
+                                        size_t stride, size_t count, float* output);
+int simplex_fbm_2d_points_ctx(const simplex_context_t* ctx, const double* xs, const double* ys,
+                              size_t count, int octaves, double persistence, double lacunarity,
+                              double* output);
+int simplex_fbm_3d_points_ctx(const simplex_context_t* ctx, const double* xs, const double* ys,
+                              const double* zs, size_t count, int octaves, double persistence,
+                              double lacunarity, double* output);
+int simplex_ridged_2d_points_ctx(const simplex_context_t* ctx, const double* xs,
+                                 const double* ys, size_t count, double* output);
+int simplex_billowy_2d_points_ctx(const simplex_context_t* ctx, const double* xs,
+                                  const double* ys, size_t count, double* output);
+int simplex_fbm_pyramid_2d_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                               int width, int height, double step, int levels, int octaves,
+                               double persistence, double lacunarity, double* output);
+int simplex_noise_layers_2d_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                                int width, int height, double step, const uint32_t* seeds,
+                                int layers, double* output);
+int simplex_noise_layers_3d_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                                double z_start, int width, int height, int depth, double step,
+                                const uint32_t* seeds, int layers, double* output);
+int simplex_domain_warp_array_2d_ctx(const simplex_context_t* ctx, double x_start,
+                                     double y_start, int width, int height, double step,
+                                     int octaves, double persistence, double lacunarity,
+                                     const simplex_warp_config_t* warp, double* output);
+
+const double* simplex_tile_acquire_ctx(const simplex_context_t* ctx,
+                                      const simplex_tile_request_t* request);
+
+int simplex_get_performance_stats_ctx(const simplex_context_t* ctx, simplex_perf_stats_t* stats);
+int simplex_get_profile_ctx(const simplex_context_t* ctx, simplex_profile_api_t api,
+                            simplex_profile_entry_t* entry);
+void simplex_reset_performance_stats_ctx(simplex_context_t* ctx);
 
 #endif  // SIMPLEX_NOISE_H
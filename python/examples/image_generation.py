@@ -10,18 +10,28 @@ import matplotlib.pyplot as plt
 from simplex_noise import SimplexNoise
 
 
+def fractal_grid(
+    noise: SimplexNoise,
+    width: int,
+    height: int,
+    extent: float,
+    octaves: int,
+    persistence: float,
+    lacunarity: float,
+) -> np.ndarray:
+    """Fractal noise over [0, extent] on both axes, rendered in place by C."""
+    grid = np.empty((height, width), dtype=np.float32)
+    step = extent / (width - 1)
+    return noise.fbm_grid_into(grid, 0.0, 0.0, step, octaves, persistence, lacunarity)
+
+
 def generate_texture(width: int, height: int, seed: int = 42) -> np.ndarray:
     """Generate a procedural texture using simplex noise."""
     noise = SimplexNoise(seed)
 
-    # Create coordinate grids
-    x = np.linspace(0, 10, width)
-    y = np.linspace(0, 10, height)
-    X, Y = np.meshgrid(x, y)
-
     # Generate multiple noise layers
-    base = noise.fractal_2d(X, Y, octaves=4, persistence=0.5, lacunarity=2.0)
-    detail = noise.fractal_2d(X * 2, Y * 2, octaves=2, persistence=0.3, lacunarity=2.5)
+    base = fractal_grid(noise, width, height, 10, 4, 0.5, 2.0)
+    detail = fractal_grid(noise, width, height, 20, 2, 0.3, 2.5)
 
     # Combine layers
     texture = base + 0.3 * detail
@@ -36,12 +46,8 @@ def generate_clouds(width: int, height: int, seed: int = 42) -> np.ndarray:
     """Generate cloud-like patterns using simplex noise."""
     noise = SimplexNoise(seed)
 
-    x = np.linspace(0, 5, width)
-    y = np.linspace(0, 5, height)
-    X, Y = np.meshgrid(x, y)
-
     # Generate cloud noise
-    clouds = noise.fractal_2d(X, Y, octaves=6, persistence=0.4, lacunarity=2.0)
+    clouds = fractal_grid(noise, width, height, 5, 6, 0.4, 2.0)
 
     # Apply cloud-like transformation
     clouds = np.abs(clouds)
@@ -57,12 +63,8 @@ def generate_marble(width: int, height: int, seed: int = 42) -> np.ndarray:
     """Generate marble-like patterns using simplex noise."""
     noise = SimplexNoise(seed)
 
-    x = np.linspace(0, 8, width)
-    y = np.linspace(0, 8, height)
-    X, Y = np.meshgrid(x, y)
-
     # Generate marble pattern
-    marble = noise.fractal_2d(X, Y, octaves=4, persistence=0.5, lacunarity=2.0)
+    marble = fractal_grid(noise, width, height, 8, 4, 0.5, 2.0)
 
     # Apply marble transformation
     marble = np.sin(marble * 10) * 0.5 + 0.5
@@ -74,12 +76,10 @@ def generate_wood(width: int, height: int, seed: int = 42) -> np.ndarray:
     """Generate wood-like patterns using simplex noise."""
     noise = SimplexNoise(seed)
 
-    x = np.linspace(0, 6, width)
-    y = np.linspace(0, 6, height)
-    X, Y = np.meshgrid(x, y)
+    Y = np.linspace(0, 6, height)[:, np.newaxis]
 
     # Generate wood pattern
-    wood = noise.fractal_2d(X, Y, octaves=3, persistence=0.4, lacunarity=2.0)
+    wood = fractal_grid(noise, width, height, 6, 3, 0.4, 2.0)
 
     # Apply wood transformation
     wood = np.sin(wood * 8 + Y * 2) * 0.5 + 0.5
@@ -91,12 +91,10 @@ def generate_fire(width: int, height: int, seed: int = 42) -> np.ndarray:
     """Generate fire-like patterns using simplex noise."""
     noise = SimplexNoise(seed)
 
-    x = np.linspace(0, 4, width)
-    y = np.linspace(0, 4, height)
-    X, Y = np.meshgrid(x, y)
+    Y = np.linspace(0, 4, height)[:, np.newaxis]
 
     # Generate fire pattern
-    fire = noise.fractal_2d(X, Y, octaves=5, persistence=0.6, lacunarity=2.0)
+    fire = fractal_grid(noise, width, height, 4, 5, 0.6, 2.0)
 
     # Apply fire transformation
     fire = np.abs(fire)
@@ -206,6 +204,16 @@ def main():
     plt.savefig("colored_textures.png", dpi=150, bbox_inches="tight")
     print("Colored textures saved as 'colored_textures.png'")
 
+    # Finished images straight from the C renderer, one call each
+    print("\nRendering images in place...")
+    noise = SimplexNoise(seed=42)
+    for color_mode in ("grayscale", "rgb", "heightmap", "terrain"):
+        channels = 1 if color_mode == "grayscale" else 3
+        image = np.empty((height, width, channels), dtype=np.uint8)
+        noise.image_into(image, color_mode=color_mode, scale=0.02, octaves=5)
+        plt.imsave(f"rendered_{color_mode}.png", image.squeeze())
+        print(f"Rendered image saved as 'rendered_{color_mode}.png'")
+
     print("\n=== Image Generation Complete ===")
 
 
@@ -14,22 +14,21 @@ def generate_heightmap(width: int, height: int, seed: int = 42) -> np.ndarray:
     """Generate a terrain heightmap using multiple noise layers."""
     noise = SimplexNoise(seed)
 
-    # Create coordinate grids
-    x = np.linspace(0, 20, width)
-    y = np.linspace(0, 20, height)
-    X, Y = np.meshgrid(x, y)
+    # Each layer is rendered into its array by one C call over [0, 20]
+    step = 20 / (width - 1)
+    base_terrain = np.empty((height, width), dtype=np.float32)
+    mountains = np.empty_like(base_terrain)
+    hills = np.empty_like(base_terrain)
 
     # Base terrain (large scale features)
-    base_terrain = noise.fractal_2d(X, Y, octaves=6, persistence=0.5, lacunarity=2.0)
+    noise.fbm_grid_into(base_terrain, 0.0, 0.0, step, 6, 0.5, 2.0)
 
     # Mountain ranges (medium scale)
-    mountains = noise.fractal_2d(
-        X * 2, Y * 2, octaves=4, persistence=0.3, lacunarity=2.5
-    )
+    noise.fbm_grid_into(mountains, 0.0, 0.0, step * 2, 4, 0.3, 2.5)
     mountains = np.abs(mountains)  # Make them positive
 
     # Hills and valleys (small scale)
-    hills = noise.fractal_2d(X * 4, Y * 4, octaves=3, persistence=0.2, lacunarity=2.0)
+    noise.fbm_grid_into(hills, 0.0, 0.0, step * 4, 3, 0.2, 2.0)
 
     # Combine layers
     terrain = base_terrain + 0.3 * mountains + 0.1 * hills
@@ -42,27 +41,19 @@ def generate_heightmap(width: int, height: int, seed: int = 42) -> np.ndarray:
 
 def generate_terrain_colors(heightmap: np.ndarray) -> np.ndarray:
     """Generate terrain colors based on height."""
-    height, width = heightmap.shape
-    colors = np.zeros((height, width, 3), dtype=np.uint8)
-
-    for i in range(height):
-        for j in range(width):
-            h = heightmap[i, j]
-
-            if h < 0.2:  # Water
-                colors[i, j] = [0, 0, 128 + int(h * 127)]
-            elif h < 0.3:  # Sand
-                colors[i, j] = [194, 178, 128]
-            elif h < 0.5:  # Grass
-                colors[i, j] = [0, 128 + int(h * 127), 0]
-            elif h < 0.7:  # Forest
-                colors[i, j] = [0, 64 + int(h * 64), 0]
-            elif h < 0.9:  # Rock
-                colors[i, j] = [128, 128, 128]
-            else:  # Snow
-                colors[i, j] = [255, 255, 255]
-
-    return colors
+    h = heightmap
+    zero = np.zeros_like(h)
+    # Water, sand, grass, forest, rock; snow above
+    bands = [h < 0.2, h < 0.3, h < 0.5, h < 0.7, h < 0.9]
+    grass = 128 + (h * 127).astype(np.int32)
+    forest = 64 + (h * 64).astype(np.int32)
+    water = 128 + (h * 127).astype(np.int32)
+    channels = [
+        np.select(bands, [zero, zero + 194, zero, zero, zero + 128], 255),
+        np.select(bands, [zero, zero + 178, grass, forest, zero + 128], 255),
+        np.select(bands, [water, zero + 128, zero, zero, zero + 128], 255),
+    ]
+    return np.stack(channels, axis=-1).astype(np.uint8)
 
 
 def main():
@@ -159,6 +150,18 @@ def main():
     plt.savefig("terrain_types.png", dpi=150, bbox_inches="tight")
     print("Terrain types saved as 'terrain_types.png'")
 
+    # Library presets rendered straight into arrays: 16-bit heights and colors
+    print("\n--- In-Place Heightmap and Texture ---")
+    noise = SimplexNoise(seed=42)
+    heights16 = np.empty((height, width), dtype=np.uint16)
+    noise.heightmap_into(heights16, scale=0.005)
+    texture = np.empty((height, width, 3), dtype=np.uint8)
+    noise.texture_into(texture, scale=0.005)
+    print(f"16-bit heights: {heights16.min()} to {heights16.max()}")
+    plt.imsave("terrain_heights16.png", heights16, cmap="gray")
+    plt.imsave("terrain_texture.png", texture)
+    print("Saved 'terrain_heights16.png' and 'terrain_texture.png'")
+
     print("\n=== Terrain Generation Complete ===")
 
 
@@ -12,6 +12,7 @@ License: MIT
 
 import ctypes
 import os
+import sys
 import numpy as np
 from typing import Union, Optional
 
@@ -24,6 +25,47 @@ except ImportError:
     PIL_AVAILABLE = False
 
 
+# Largest thread count the C library accepts
+MAX_THREADS = 64
+
+# Image color modes: (simplex_color_mode_t, channels per pixel)
+_COLOR_MODES = {
+    "grayscale": (0, 1),
+    "rgb": (1, 3),
+    "heightmap": (3, 3),
+    "terrain": (4, 3),
+}
+_COLOR_GRAYSCALE16 = 5
+_IMAGE_RAW = 3
+_NORMALIZE_MODES = {"none": 0, "exact": 1, "bounded": 2}
+
+
+class _ImageConfig(ctypes.Structure):
+    """Mirror of simplex_image_config_t (simplex_image.h), field for field."""
+
+    _fields_ = [
+        ("width", ctypes.c_int),
+        ("height", ctypes.c_int),
+        ("format", ctypes.c_int),
+        ("color_mode", ctypes.c_int),
+        ("scale", ctypes.c_double),
+        ("offset_x", ctypes.c_double),
+        ("offset_y", ctypes.c_double),
+        ("offset_z", ctypes.c_double),
+        ("octaves", ctypes.c_int),
+        ("persistence", ctypes.c_double),
+        ("lacunarity", ctypes.c_double),
+        ("min_value", ctypes.c_double),
+        ("max_value", ctypes.c_double),
+        ("auto_normalize", ctypes.c_int),
+        ("seed", ctypes.c_uint32),
+        ("filename", ctypes.c_char * 256),
+        ("png_compression", ctypes.c_int),
+        ("png_filter", ctypes.c_int),
+        ("arena", ctypes.c_void_p),
+    ]
+
+
 class SimplexNoise:
     """
     Python wrapper for the Pure C Simplex Noise library.
@@ -32,17 +74,29 @@ class SimplexNoise:
     and easy-to-use Python API.
     """
 
-    def __init__(self, seed: int = 0, library_path: Optional[str] = None):
+    def __init__(
+        self,
+        seed: int = 0,
+        library_path: Optional[str] = None,
+        threads: Optional[int] = None,
+    ):
         """
         Initialize the Simplex Noise generator.
 
         Args:
             seed: Random seed for noise generation
             library_path: Path to the compiled C library (auto-detected if None)
+            threads: Threads the C library uses for grids and images
+                     (all CPUs if None, at most MAX_THREADS)
         """
         self._lib = self._load_library(library_path)
         self._setup_function_signatures()
         self._seed = seed
+        if threads is None:
+            threads = min(os.cpu_count() or 1, MAX_THREADS)
+        if not 1 <= threads <= MAX_THREADS:
+            raise ValueError(f"threads must be between 1 and {MAX_THREADS}")
+        self._threads = threads
         self._initialized = False
 
         # Initialize with seed
@@ -157,6 +211,78 @@ class SimplexNoise:
         ]
         self._lib.simplex_fbm_2d.restype = ctypes.c_double
 
+        # Bulk functions. NumPy buffers are passed by pointer without copying;
+        # ctypes.CDLL releases the GIL for the duration of each call.
+        points = np.ctypeslib.ndpointer(dtype=np.float64, flags="C_CONTIGUOUS")
+        size = ctypes.c_size_t
+        fractal_params = [ctypes.c_int, ctypes.c_double, ctypes.c_double]
+        bulk_signatures = {
+            "simplex_noise_2d_points": [points, points, size, points],
+            "simplex_noise_3d_points": [points, points, points, size, points],
+            "simplex_noise_4d_points": [points, points, points, points, size, points],
+            "simplex_fbm_2d_points": [points, points, size] + fractal_params + [points],
+            "simplex_fbm_3d_points": [points, points, points, size]
+            + fractal_params
+            + [points],
+            "simplex_ridged_2d_points": [points, points, size, points],
+            "simplex_billowy_2d_points": [points, points, size, points],
+            "simplex_noise_array_2d": [
+                ctypes.c_double,
+                ctypes.c_double,
+                ctypes.c_int,
+                ctypes.c_int,
+                ctypes.c_double,
+                points,
+            ],
+            "simplex_fractal_array_2d": [
+                ctypes.c_double,
+                ctypes.c_double,
+                ctypes.c_int,
+                ctypes.c_int,
+                ctypes.c_double,
+            ]
+            + fractal_params
+            + [points],
+        }
+        for name, argtypes in bulk_signatures.items():
+            function = getattr(self._lib, name)
+            function.argtypes = argtypes
+            function.restype = ctypes.c_int
+
+        # In-place rendering. Destination arrays are validated by the caller and
+        # passed by address, so any dtype the C function writes can be filled.
+        self._lib.simplex_set_max_threads.argtypes = [ctypes.c_int]
+        self._lib.simplex_set_max_threads.restype = ctypes.c_int
+
+        self._lib.simplex_get_default_image_config.argtypes = []
+        self._lib.simplex_get_default_image_config.restype = _ImageConfig
+
+        config = ctypes.POINTER(_ImageConfig)
+        address = ctypes.c_void_p
+        encoded = [config, address, size, ctypes.c_void_p]
+        render_signatures = {
+            "simplex_render_to_buffer": encoded,
+            "simplex_render_heightmap_to_buffer": encoded,
+            "simplex_render_texture_to_buffer": encoded,
+            "simplex_render_heights_f32": [config, address, size],
+        }
+        grid = [
+            ctypes.c_double,
+            ctypes.c_double,
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.c_double,
+        ]
+        for name in (
+            "simplex_fractal_array_2d_f32",
+            "simplex_fractal_array_2d_u16",
+        ):
+            render_signatures[name] = grid + fractal_params + [address]
+        for name, argtypes in render_signatures.items():
+            function = getattr(self._lib, name)
+            function.argtypes = argtypes
+            function.restype = ctypes.c_int
+
         # Configuration functions (these don't exist in the current C library)
         # self._lib.simplex_config_set_seed.argtypes = [ctypes.c_uint]
         # self._lib.simplex_config_set_seed.restype = None
@@ -167,6 +293,8 @@ class SimplexNoise:
     def init(self, seed: int) -> None:
         """Initialize the noise generator with a new seed."""
         self._lib.simplex_noise_init(ctypes.c_uint(seed))
+        # Initialization restores the single-threaded default configuration
+        self._lib.simplex_set_max_threads(self._threads)
         self._seed = seed
         self._initialized = True
 
@@ -180,6 +308,18 @@ class SimplexNoise:
         """Set a new seed and reinitialize."""
         self.init(value)
 
+    @property
+    def threads(self) -> int:
+        """Get the number of threads grids and images are generated with."""
+        return self._threads
+
+    @threads.setter
+    def threads(self, value: int) -> None:
+        """Set the number of threads grids and images are generated with."""
+        if self._lib.simplex_set_max_threads(value) != 0:
+            raise ValueError(f"threads must be between 1 and {MAX_THREADS}")
+        self._threads = value
+
     def noise_2d(
         self, x: Union[float, np.ndarray], y: Union[float, np.ndarray]
     ) -> Union[float, np.ndarray]:
@@ -372,65 +512,41 @@ class SimplexNoise:
         )
 
     # Array processing methods
+    @staticmethod
+    def _coordinates(names: str, *arrays) -> list:
+        """Convert coordinates to float64 arrays of one shape, copying only if needed."""
+        arrays = [np.asarray(a, dtype=np.float64) for a in arrays]
+        if any(a.shape != arrays[0].shape for a in arrays[1:]):
+            raise ValueError(f"{names} arrays must have the same shape")
+        return arrays
+
+    @staticmethod
+    def _call_points(function, coordinates: list, *params) -> np.ndarray:
+        """Evaluate every point in one C call and return an array of their shape."""
+        result = np.empty(coordinates[0].shape, dtype=np.float64)
+        flat = [np.ascontiguousarray(c).reshape(-1) for c in coordinates]
+        if function(*flat, flat[0].size, *params, result.reshape(-1)) != 0:
+            raise RuntimeError(f"{function.__name__} failed")
+        return result
+
     def _noise_2d_array(self, x: np.ndarray, y: np.ndarray) -> np.ndarray:
         """Process 2D noise for arrays."""
-        x = np.asarray(x, dtype=np.float64)
-        y = np.asarray(y, dtype=np.float64)
-
-        if x.shape != y.shape:
-            raise ValueError("x and y arrays must have the same shape")
-
-        result = np.zeros_like(x)
-        for i in range(x.size):
-            result.flat[i] = self._lib.simplex_noise_2d(
-                ctypes.c_double(x.flat[i]), ctypes.c_double(y.flat[i])
-            )
-
-        return result
+        coordinates = self._coordinates("x and y", x, y)
+        return self._call_points(self._lib.simplex_noise_2d_points, coordinates)
 
     def _noise_3d_array(
         self, x: np.ndarray, y: np.ndarray, z: np.ndarray
     ) -> np.ndarray:
         """Process 3D noise for arrays."""
-        x = np.asarray(x, dtype=np.float64)
-        y = np.asarray(y, dtype=np.float64)
-        z = np.asarray(z, dtype=np.float64)
-
-        if not (x.shape == y.shape == z.shape):
-            raise ValueError("x, y, and z arrays must have the same shape")
-
-        result = np.zeros_like(x)
-        for i in range(x.size):
-            result.flat[i] = self._lib.simplex_noise_3d(
-                ctypes.c_double(x.flat[i]),
-                ctypes.c_double(y.flat[i]),
-                ctypes.c_double(z.flat[i]),
-            )
-
-        return result
+        coordinates = self._coordinates("x, y, and z", x, y, z)
+        return self._call_points(self._lib.simplex_noise_3d_points, coordinates)
 
     def _noise_4d_array(
         self, x: np.ndarray, y: np.ndarray, z: np.ndarray, w: np.ndarray
     ) -> np.ndarray:
         """Process 4D noise for arrays."""
-        x = np.asarray(x, dtype=np.float64)
-        y = np.asarray(y, dtype=np.float64)
-        z = np.asarray(z, dtype=np.float64)
-        w = np.asarray(w, dtype=np.float64)
-
-        if not (x.shape == y.shape == z.shape == w.shape):
-            raise ValueError("x, y, z, and w arrays must have the same shape")
-
-        result = np.zeros_like(x)
-        for i in range(x.size):
-            result.flat[i] = self._lib.simplex_noise_4d(
-                ctypes.c_double(x.flat[i]),
-                ctypes.c_double(y.flat[i]),
-                ctypes.c_double(z.flat[i]),
-                ctypes.c_double(w.flat[i]),
-            )
-
-        return result
+        coordinates = self._coordinates("x, y, z, and w", x, y, z, w)
+        return self._call_points(self._lib.simplex_noise_4d_points, coordinates)
 
     def _fractal_2d_array(
         self,
@@ -440,24 +556,8 @@ class SimplexNoise:
         persistence: float,
         lacunarity: float,
     ) -> np.ndarray:
-        """Process 2D fractal noise for arrays."""
-        x = np.asarray(x, dtype=np.float64)
-        y = np.asarray(y, dtype=np.float64)
-
-        if x.shape != y.shape:
-            raise ValueError("x and y arrays must have the same shape")
-
-        result = np.zeros_like(x)
-        for i in range(x.size):
-            result.flat[i] = self._lib.simplex_fractal_2d(
-                ctypes.c_double(x.flat[i]),
-                ctypes.c_double(y.flat[i]),
-                ctypes.c_int(octaves),
-                ctypes.c_double(persistence),
-                ctypes.c_double(lacunarity),
-            )
-
-        return result
+        """Process 2D fractal noise for arrays (same values as fbm)."""
+        return self._fbm_2d_array(x, y, octaves, persistence, lacunarity)
 
     def _fractal_3d_array(
         self,
@@ -468,66 +568,29 @@ class SimplexNoise:
         persistence: float,
         lacunarity: float,
     ) -> np.ndarray:
-        """Process 3D fractal noise for arrays."""
-        x = np.asarray(x, dtype=np.float64)
-        y = np.asarray(y, dtype=np.float64)
-        z = np.asarray(z, dtype=np.float64)
-
-        if not (x.shape == y.shape == z.shape):
-            raise ValueError("x, y, and z arrays must have the same shape")
-
-        result = np.zeros_like(x)
-        for i in range(x.size):
-            result.flat[i] = self._lib.simplex_fractal_3d(
-                ctypes.c_double(x.flat[i]),
-                ctypes.c_double(y.flat[i]),
-                ctypes.c_double(z.flat[i]),
-                ctypes.c_int(octaves),
-                ctypes.c_double(persistence),
-                ctypes.c_double(lacunarity),
-            )
-
-        return result
+        """Process 3D fractal noise for arrays (same values as fbm)."""
+        coordinates = self._coordinates("x, y, and z", x, y, z)
+        return self._call_points(
+            self._lib.simplex_fbm_3d_points,
+            coordinates,
+            octaves,
+            persistence,
+            lacunarity,
+        )
 
     def _ridged_2d_array(
         self, x: np.ndarray, y: np.ndarray, offset: float
     ) -> np.ndarray:
-        """Process 2D ridged noise for arrays."""
-        x = np.asarray(x, dtype=np.float64)
-        y = np.asarray(y, dtype=np.float64)
-
-        if x.shape != y.shape:
-            raise ValueError("x and y arrays must have the same shape")
-
-        result = np.zeros_like(x)
-        for i in range(x.size):
-            result.flat[i] = self._lib.simplex_ridged_2d(
-                ctypes.c_double(x.flat[i]),
-                ctypes.c_double(y.flat[i]),
-                ctypes.c_double(offset),
-            )
-
-        return result
+        """Process 2D ridged noise for arrays (offset is unused by the C library)."""
+        coordinates = self._coordinates("x and y", x, y)
+        return self._call_points(self._lib.simplex_ridged_2d_points, coordinates)
 
     def _billowy_2d_array(
         self, x: np.ndarray, y: np.ndarray, offset: float
     ) -> np.ndarray:
-        """Process 2D billowy noise for arrays."""
-        x = np.asarray(x, dtype=np.float64)
-        y = np.asarray(y, dtype=np.float64)
-
-        if x.shape != y.shape:
-            raise ValueError("x and y arrays must have the same shape")
-
-        result = np.zeros_like(x)
-        for i in range(x.size):
-            result.flat[i] = self._lib.simplex_billowy_2d(
-                ctypes.c_double(x.flat[i]),
-                ctypes.c_double(y.flat[i]),
-                ctypes.c_double(offset),
-            )
-
-        return result
+        """Process 2D billowy noise for arrays (offset is unused by the C library)."""
+        coordinates = self._coordinates("x and y", x, y)
+        return self._call_points(self._lib.simplex_billowy_2d_points, coordinates)
 
     def _fbm_2d_array(
         self,
@@ -538,24 +601,322 @@ class SimplexNoise:
         lacunarity: float,
     ) -> np.ndarray:
         """Process 2D FBM noise for arrays."""
-        x = np.asarray(x, dtype=np.float64)
-        y = np.asarray(y, dtype=np.float64)
-
-        if x.shape != y.shape:
-            raise ValueError("x and y arrays must have the same shape")
-
-        result = np.zeros_like(x)
-        for i in range(x.size):
-            result.flat[i] = self._lib.simplex_fbm_2d(
-                ctypes.c_double(x.flat[i]),
-                ctypes.c_double(y.flat[i]),
-                ctypes.c_int(octaves),
-                ctypes.c_double(persistence),
-                ctypes.c_double(lacunarity),
-            )
+        coordinates = self._coordinates("x and y", x, y)
+        return self._call_points(
+            self._lib.simplex_fbm_2d_points,
+            coordinates,
+            octaves,
+            persistence,
+            lacunarity,
+        )
+
+    # Regular grids
+    def noise_2d_grid(
+        self,
+        x_start: float,
+        y_start: float,
+        width: int,
+        height: int,
+        step: float,
+    ) -> np.ndarray:
+        """
+        Generate 2D noise on a regular grid in one C call.
 
+        Sample [j, i] is noise_2d(x_start + i * step, y_start + j * step).
+
+        Returns:
+            Array of shape (height, width)
+        """
+        if not self._initialized:
+            raise RuntimeError("Noise generator not initialized. Call init() first.")
+
+        result = np.empty((height, width), dtype=np.float64)
+        if result.size and self._lib.simplex_noise_array_2d(
+            x_start, y_start, width, height, step, result
+        ):
+            raise RuntimeError("simplex_noise_array_2d failed")
         return result
 
+    def fractal_2d_grid(
+        self,
+        x_start: float,
+        y_start: float,
+        width: int,
+        height: int,
+        step: float,
+        octaves: int = 4,
+        persistence: float = 0.5,
+        lacunarity: float = 2.0,
+    ) -> np.ndarray:
+        """
+        Generate 2D fractal noise on a regular grid in one C call.
+
+        Sample [j, i] is fractal_2d(x_start + i * step, y_start + j * step, ...).
+
+        Returns:
+            Array of shape (height, width)
+        """
+        if not self._initialized:
+            raise RuntimeError("Noise generator not initialized. Call init() first.")
+
+        result = np.empty((height, width), dtype=np.float64)
+        if result.size and self._lib.simplex_fractal_array_2d(
+            x_start,
+            y_start,
+            width,
+            height,
+            step,
+            octaves,
+            persistence,
+            lacunarity,
+            result,
+        ):
+            raise RuntimeError("simplex_fractal_array_2d failed")
+        return result
+
+    def _linspace_grid(
+        self,
+        width: int,
+        height: int,
+        extent: float,
+        octaves: int,
+        persistence: float,
+        lacunarity: float,
+    ) -> np.ndarray:
+        """Noise over meshgrid(linspace(0, extent, width), linspace(0, extent, height))."""
+        if width == height and width > 1:
+            # Equal spacing on both axes: a regular grid, no coordinate arrays at all
+            step = extent / (width - 1)
+            if octaves > 1:
+                return self.fractal_2d_grid(
+                    0.0, 0.0, width, height, step, octaves, persistence, lacunarity
+                )
+            return self.noise_2d_grid(0.0, 0.0, width, height, step)
+
+        X, Y = np.meshgrid(
+            np.linspace(0, extent, width), np.linspace(0, extent, height)
+        )
+        if octaves > 1:
+            return self.fractal_2d(X, Y, octaves, persistence, lacunarity)
+        return self.noise_2d(X, Y)
+
+    # In-place generation into preallocated arrays
+    @staticmethod
+    def _destination(out: np.ndarray, dtypes: tuple) -> None:
+        """Check that out can be written in place by the C library."""
+        if not isinstance(out, np.ndarray):
+            raise TypeError("out must be a NumPy array")
+        if out.dtype not in dtypes:
+            names = ", ".join(np.dtype(d).name for d in dtypes)
+            raise TypeError(f"out must have dtype {names}, not {out.dtype}")
+        if not out.flags.c_contiguous or not out.flags.writeable:
+            raise ValueError("out must be C-contiguous and writeable")
+        if out.ndim not in (2, 3) or out.size == 0:
+            raise ValueError(
+                "out must have shape (height, width) or (height, width, channels)"
+            )
+
+    def _image_config(
+        self,
+        out: np.ndarray,
+        scale: float,
+        offset: tuple,
+        octaves: int,
+        persistence: float,
+        lacunarity: float,
+        normalize: str,
+    ) -> _ImageConfig:
+        """Image configuration rendering out with this generator's seed."""
+        if normalize not in _NORMALIZE_MODES:
+            raise ValueError(f"Unknown normalize mode: {normalize}")
+        config = self._lib.simplex_get_default_image_config()
+        config.height, config.width = out.shape[:2]
+        config.format = _IMAGE_RAW
+        config.scale = scale
+        config.offset_x, config.offset_y = offset
+        config.octaves = octaves
+        config.persistence = persistence
+        config.lacunarity = lacunarity
+        config.auto_normalize = _NORMALIZE_MODES[normalize]
+        config.seed = self._seed
+        return config
+
+    def _render_into(
+        self, render, out: np.ndarray, color_mode: str, config: _ImageConfig
+    ) -> np.ndarray:
+        """Render the image config describes directly into out's memory."""
+        if out.dtype == np.float32:
+            if out.ndim != 2:
+                raise ValueError("float32 out must have shape (height, width)")
+            if self._lib.simplex_render_heights_f32(
+                ctypes.byref(config), out.ctypes.data, out.size
+            ):
+                raise RuntimeError("simplex_render_heights_f32 failed")
+            return out
+
+        if out.dtype == np.uint16:
+            if out.ndim != 2:
+                raise ValueError("uint16 out must have shape (height, width)")
+            config.color_mode = _COLOR_GRAYSCALE16
+        else:
+            if color_mode not in _COLOR_MODES:
+                raise ValueError(f"Unknown color_mode: {color_mode}")
+            config.color_mode, channels = _COLOR_MODES[color_mode]
+            if (out.shape[2] if out.ndim == 3 else 1) != channels:
+                raise ValueError(f"{color_mode} images need {channels} channel(s)")
+
+        if render(ctypes.byref(config), out.ctypes.data, out.nbytes, None):
+            raise RuntimeError(f"{render.__name__} failed")
+        if out.dtype == np.uint16 and sys.byteorder == "little":
+            # 16-bit samples are written big-endian, as PNG and PGM store them
+            out.byteswap(inplace=True)
+        return out
+
+    def image_into(
+        self,
+        out: np.ndarray,
+        color_mode: str = "grayscale",
+        scale: float = 0.01,
+        offset: tuple = (0.0, 0.0),
+        octaves: int = 4,
+        persistence: float = 0.5,
+        lacunarity: float = 2.0,
+        normalize: str = "exact",
+    ) -> np.ndarray:
+        """
+        Render a 2D noise image into a preallocated array, without copies.
+
+        The whole image is generated in one multithreaded C call that runs
+        without the GIL. Pixel [j, i] samples the noise at
+        ((offset[0] + i) * scale, (offset[1] + j) * scale).
+
+        Args:
+            out: Destination array:
+                 float32 (height, width) receives the normalized samples,
+                 uint16 (height, width) 16-bit grayscale,
+                 uint8 (height, width) or (height, width, 1) grayscale, and
+                 uint8 (height, width, 3) for the "rgb", "heightmap" and
+                 "terrain" color modes
+            color_mode: "grayscale", "rgb", "heightmap", or "terrain" (uint8 only)
+            scale: Noise units per pixel
+            offset: Pixel (x, y) of the image's top-left corner
+            octaves: Number of octaves for fractal noise
+            persistence: Amplitude persistence
+            lacunarity: Frequency lacunarity
+            normalize: "exact" maps the image's own range onto 0-1, "bounded"
+                       maps [-1, 1], and "none" uses the noise values as generated
+
+        Returns:
+            out
+        """
+        self._destination(out, (np.float32, np.uint16, np.uint8))
+        config = self._image_config(
+            out, scale, offset, octaves, persistence, lacunarity, normalize
+        )
+        return self._render_into(
+            self._lib.simplex_render_to_buffer, out, color_mode, config
+        )
+
+    def heightmap_into(
+        self,
+        out: np.ndarray,
+        scale: float = 0.01,
+        offset: tuple = (0.0, 0.0),
+        octaves: int = 6,
+        persistence: float = 0.5,
+        lacunarity: float = 2.0,
+        normalize: str = "exact",
+    ) -> np.ndarray:
+        """
+        Render a heightmap into a preallocated array, as simplex_generate_heightmap().
+
+        out is float32 or uint16 (height, width) for raw heights, or uint8
+        (height, width, 3) for heightmap colors. See image_into() for the rest.
+
+        Returns:
+            out
+        """
+        self._destination(out, (np.float32, np.uint16, np.uint8))
+        config = self._image_config(
+            out, scale, offset, octaves, persistence, lacunarity, normalize
+        )
+        return self._render_into(
+            self._lib.simplex_render_heightmap_to_buffer, out, "heightmap", config
+        )
+
+    def texture_into(
+        self,
+        out: np.ndarray,
+        scale: float = 0.01,
+        offset: tuple = (0.0, 0.0),
+        octaves: int = 3,
+        persistence: float = 0.5,
+        lacunarity: float = 2.0,
+        normalize: str = "exact",
+    ) -> np.ndarray:
+        """
+        Render a terrain texture into a uint8 (height, width, 3) array,
+        as simplex_generate_texture(). See image_into() for the parameters.
+
+        Returns:
+            out
+        """
+        self._destination(out, (np.uint8,))
+        config = self._image_config(
+            out, scale, offset, octaves, persistence, lacunarity, normalize
+        )
+        return self._render_into(
+            self._lib.simplex_render_texture_to_buffer, out, "terrain", config
+        )
+
+    def fbm_grid_into(
+        self,
+        out: np.ndarray,
+        x_start: float,
+        y_start: float,
+        step: float,
+        octaves: int = 4,
+        persistence: float = 0.5,
+        lacunarity: float = 2.0,
+    ) -> np.ndarray:
+        """
+        Generate 2D fractal noise on a regular grid into a preallocated array.
+
+        Sample [j, i] is fractal_2d(x_start + i * step, y_start + j * step, ...),
+        as in fractal_2d_grid(). float64 and float32 arrays receive the noise
+        values; uint16 arrays receive them mapped from [-1, 1] onto 0-65535.
+
+        Args:
+            out: float64, float32, or uint16 array of shape (height, width)
+
+        Returns:
+            out
+        """
+        self._destination(out, (np.float64, np.float32, np.uint16))
+        if out.ndim != 2:
+            raise ValueError("out must have shape (height, width)")
+        functions = {
+            np.dtype(np.float64): self._lib.simplex_fractal_array_2d,
+            np.dtype(np.float32): self._lib.simplex_fractal_array_2d_f32,
+            np.dtype(np.uint16): self._lib.simplex_fractal_array_2d_u16,
+        }
+        function = functions[out.dtype]
+        height, width = out.shape
+        target = out if out.dtype == np.float64 else out.ctypes.data
+        if function(
+            x_start,
+            y_start,
+            width,
+            height,
+            step,
+            octaves,
+            persistence,
+            lacunarity,
+            target,
+        ):
+            raise RuntimeError(f"{function.__name__} failed")
+        return out
+
     # Image generation
     def generate_image(
         self,
@@ -585,14 +946,9 @@ class SimplexNoise:
             )
 
         # Generate noise data
-        x = np.linspace(0, 10, width)
-        y = np.linspace(0, 10, height)
-        X, Y = np.meshgrid(x, y)
-
-        if octaves > 1:
-            noise_data = self.fractal_2d(X, Y, octaves, persistence, lacunarity)
-        else:
-            noise_data = self.noise_2d(X, Y)
+        noise_data = self._linspace_grid(
+            width, height, 10.0, octaves, persistence, lacunarity
+        )
 
         # Normalize to [0, 1]
         noise_data = (noise_data + 1.0) / 2.0
@@ -609,19 +965,16 @@ class SimplexNoise:
         elif color_mode == "heightmap":
             # Create heightmap with terrain-like colors
             image_data = (noise_data * 255).astype(np.uint8)
-            # Simple terrain coloring
-            terrain_colors = np.zeros((height, width, 3), dtype=np.uint8)
-            for i in range(height):
-                for j in range(width):
-                    height_val = image_data[i, j]
-                    if height_val < 85:  # Water
-                        terrain_colors[i, j] = [0, 0, 128 + height_val]
-                    elif height_val < 128:  # Sand
-                        terrain_colors[i, j] = [194, 178, 128]
-                    elif height_val < 170:  # Grass
-                        terrain_colors[i, j] = [0, 128 + height_val // 2, 0]
-                    else:  # Mountain
-                        terrain_colors[i, j] = [height_val, height_val, height_val]
+            # Simple terrain coloring, one band per height range
+            h = image_data.astype(np.int32)
+            zero = np.zeros_like(h)
+            bands = [h < 85, h < 128, h < 170]  # Water, sand, grass; else mountain
+            channels = [
+                np.select(bands, [zero, zero + 194, zero], h),
+                np.select(bands, [zero, zero + 178, 128 + h // 2], h),
+                np.select(bands, [128 + h, zero + 128, zero], h),
+            ]
+            terrain_colors = np.stack(channels, axis=-1).astype(np.uint8)
             image = Image.fromarray(terrain_colors, mode="RGB")
         else:
             raise ValueError(f"Unknown color_mode: {color_mode}")
@@ -663,10 +1016,7 @@ def generate_terrain(
 ) -> np.ndarray:
     """Generate a terrain heightmap."""
     noise = SimplexNoise(seed)
-    x = np.linspace(0, 10, width)
-    y = np.linspace(0, 10, height)
-    X, Y = np.meshgrid(x, y)
-    return noise.fractal_2d(X, Y, octaves, persistence, lacunarity)
+    return noise._linspace_grid(width, height, 10.0, octaves, persistence, lacunarity)
 
 
 # Version info
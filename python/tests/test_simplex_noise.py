@@ -170,6 +170,51 @@ class TestSimplexNoise(unittest.TestCase):
         with self.assertRaises(ValueError):
             self.noise.noise_2d(x, y)
 
+    def test_array_matches_scalar(self):
+        """Test that array calls give the same values as scalar calls."""
+        x = np.linspace(-5.0, 5.0, 37).reshape(37, 1) * np.ones((1, 3))
+        y = np.linspace(3.0, -2.0, 111).reshape(37, 3)
+
+        arrays = {
+            "noise_2d": self.noise.noise_2d(x, y),
+            "fractal_2d": self.noise.fractal_2d(x, y, 5, 0.5, 2.0),
+            "ridged_2d": self.noise.ridged_2d(x, y),
+            "billowy_2d": self.noise.billowy_2d(x, y),
+        }
+        for index in np.ndindex(x.shape):
+            px, py = float(x[index]), float(y[index])
+            self.assertEqual(arrays["noise_2d"][index], self.noise.noise_2d(px, py))
+            self.assertEqual(
+                arrays["fractal_2d"][index], self.noise.fractal_2d(px, py, 5, 0.5, 2.0)
+            )
+            self.assertEqual(arrays["ridged_2d"][index], self.noise.ridged_2d(px, py))
+            self.assertEqual(arrays["billowy_2d"][index], self.noise.billowy_2d(px, py))
+
+        # Non-contiguous and non-float64 inputs are converted
+        self.assertTrue(
+            np.array_equal(self.noise.noise_2d(x.T, y.T), arrays["noise_2d"].T)
+        )
+        xi = np.arange(10, dtype=np.int32)
+        self.assertTrue(
+            np.array_equal(
+                self.noise.noise_3d(xi, xi, xi),
+                self.noise.noise_3d(xi.astype(np.float64), xi * 1.0, xi * 1.0),
+            )
+        )
+
+    def test_grid_matches_points(self):
+        """Test that grid functions match noise at the grid coordinates."""
+        step = 0.37
+        grid = self.noise.fractal_2d_grid(-1.0, 2.0, 20, 7, step, octaves=3)
+        self.assertEqual(grid.shape, (7, 20))
+        X, Y = np.meshgrid(-1.0 + np.arange(20) * step, 2.0 + np.arange(7) * step)
+        self.assertTrue(np.array_equal(grid, self.noise.fractal_2d(X, Y, octaves=3)))
+
+        grid = self.noise.noise_2d_grid(0.5, 0.5, 9, 4, step)
+        X, Y = np.meshgrid(0.5 + np.arange(9) * step, 0.5 + np.arange(4) * step)
+        # Plain-noise grids use the row kernels, which agree to within 1e-12
+        self.assertTrue(np.allclose(grid, self.noise.noise_2d(X, Y), rtol=0.0, atol=1e-12))
+
     def test_uninitialized_error(self):
         """Test that uninitialized noise generator raises error."""
         noise = SimplexNoise(seed=42)
@@ -272,6 +317,114 @@ class TestImageGeneration(unittest.TestCase):
                 os.unlink(filename)
 
 
+class TestInPlaceRendering(unittest.TestCase):
+    """Test cases for rendering into preallocated arrays."""
+
+    def setUp(self):
+        """Set up test fixtures."""
+        self.noise = SimplexNoise(seed=42, threads=4)
+
+    def test_image_into_dtypes(self):
+        """Test that every destination dtype is filled in place."""
+        heights = np.empty((48, 64), dtype=np.float32)
+        result = self.noise.image_into(heights, scale=0.02)
+        self.assertIs(result, heights)
+        self.assertAlmostEqual(float(heights.min()), 0.0)
+        self.assertAlmostEqual(float(heights.max()), 1.0)
+
+        # 16-bit samples are the float heights rounded, in native byte order
+        samples = np.empty((48, 64), dtype=np.uint16)
+        self.noise.image_into(samples, scale=0.02)
+        expected = np.round(heights.astype(np.float64) * 65535)
+        self.assertLessEqual(np.max(np.abs(samples - expected)), 1)
+
+        gray = np.empty((48, 64), dtype=np.uint8)
+        self.noise.image_into(gray, scale=0.02)
+        gray_channel = np.empty((48, 64, 1), dtype=np.uint8)
+        self.noise.image_into(gray_channel, scale=0.02)
+        np.testing.assert_array_equal(gray, gray_channel[:, :, 0])
+
+    def test_image_into_color_modes(self):
+        """Test the color modes and their channel counts."""
+        for color_mode in ["rgb", "heightmap", "terrain"]:
+            image = np.zeros((32, 32, 3), dtype=np.uint8)
+            self.noise.image_into(image, color_mode=color_mode, scale=0.05)
+            self.assertGreater(int(image.max()), 0)
+        with self.assertRaises(ValueError):
+            self.noise.image_into(np.empty((32, 32), np.uint8), color_mode="rgb")
+        with self.assertRaises(ValueError):
+            self.noise.image_into(np.empty((32, 32, 3), np.uint8), color_mode="invalid")
+
+    def test_heightmap_and_texture_into(self):
+        """Test the heightmap and texture presets."""
+        heights = np.empty((40, 40), dtype=np.float32)
+        self.noise.heightmap_into(heights, scale=0.03)
+        expected = np.empty_like(heights)
+        self.noise.image_into(expected, scale=0.03, octaves=6)
+        np.testing.assert_array_equal(heights, expected)
+
+        colors = np.empty((40, 40, 3), dtype=np.uint8)
+        self.noise.heightmap_into(colors, scale=0.03)
+        expected_colors = np.empty_like(colors)
+        self.noise.image_into(
+            expected_colors, color_mode="heightmap", scale=0.03, octaves=6
+        )
+        np.testing.assert_array_equal(colors, expected_colors)
+
+        texture = np.empty((40, 40, 3), dtype=np.uint8)
+        self.noise.texture_into(texture, scale=0.03)
+        self.noise.image_into(
+            expected_colors, color_mode="terrain", scale=0.03, octaves=3
+        )
+        np.testing.assert_array_equal(texture, expected_colors)
+
+    def test_fbm_grid_into(self):
+        """Test that grids of every dtype match fractal_2d_grid."""
+        expected = self.noise.fractal_2d_grid(0.5, -1.0, 50, 30, 0.05, 5)
+        grid = np.empty((30, 50), dtype=np.float64)
+        self.noise.fbm_grid_into(grid, 0.5, -1.0, 0.05, 5)
+        np.testing.assert_array_equal(grid, expected)
+
+        grid32 = np.empty((30, 50), dtype=np.float32)
+        self.noise.fbm_grid_into(grid32, 0.5, -1.0, 0.05, 5)
+        np.testing.assert_allclose(grid32, expected, atol=1e-6)
+
+        grid16 = np.empty((30, 50), dtype=np.uint16)
+        self.noise.fbm_grid_into(grid16, 0.5, -1.0, 0.05, 5)
+        mapped = np.clip((expected + 1.0) * 0.5, 0.0, 1.0) * 65535
+        self.assertLessEqual(np.max(np.abs(grid16 - mapped)), 1)
+
+    def test_threads_do_not_change_results(self):
+        """Test that the thread count leaves the output unchanged."""
+        threaded = np.empty((64, 64), dtype=np.float32)
+        self.noise.image_into(threaded, scale=0.02)
+        self.noise.threads = 1
+        single = np.empty_like(threaded)
+        self.noise.image_into(single, scale=0.02)
+        np.testing.assert_array_equal(threaded, single)
+        with self.assertRaises(ValueError):
+            self.noise.threads = 0
+        with self.assertRaises(ValueError):
+            SimplexNoise(seed=42, threads=65)
+
+    def test_invalid_destinations(self):
+        """Test that arrays the C library cannot fill are rejected."""
+        with self.assertRaises(TypeError):
+            self.noise.image_into(np.empty((8, 8), dtype=np.int32))
+        with self.assertRaises(TypeError):
+            self.noise.image_into([[0.0] * 8] * 8)
+        with self.assertRaises(ValueError):
+            self.noise.image_into(np.empty((8, 16), dtype=np.float32)[:, ::2])
+        read_only = np.empty((8, 8), dtype=np.float32)
+        read_only.flags.writeable = False
+        with self.assertRaises(ValueError):
+            self.noise.image_into(read_only)
+        with self.assertRaises(ValueError):
+            self.noise.image_into(np.empty((8, 8), np.float32), normalize="invalid")
+        with self.assertRaises(TypeError):
+            self.noise.texture_into(np.empty((8, 8, 3), dtype=np.float32))
+
+
 class TestPerformance(unittest.TestCase):
     """Test cases for performance characteristics."""
 
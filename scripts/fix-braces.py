@@ -37,7 +37,7 @@ if __name__ == "__main__":
         "src/simplex_image.c",
         "tests/test_basic.c",
         "tests/test_config.c",
-        "tests/test_performance.c",
+        "bench/simplex_bench.c",
         "examples/example_2d.c",
         "examples/example_3d.c",
         "examples/example_config.c",
@@ -20,9 +20,9 @@ fi
 mkdir -p build
 
 echo "📝 Running clang-format..."
-clang-format -i src/*.c include/*.h examples/*.c tests/*.c
+clang-format -i src/*.c include/*.h examples/*.c tests/*.c bench/*.c
 
 echo "🔍 Running clang-tidy..."
-clang-tidy src/*.c include/*.h examples/*.c tests/*.c -- -Iinclude -std=c99
+clang-tidy src/*.c include/*.h examples/*.c tests/*.c bench/*.c -- -Iinclude -std=c99
 
 echo "✅ Code formatting and analysis complete!"
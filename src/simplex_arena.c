@@ -0,0 +1,234 @@
+/**
+ * @file simplex_arena.c
+ * @brief Caller-owned, grow-only buffer arenas
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @details An arena owns one block and lays every request out from its start,
+ *          so nothing is ever freed between calls: the block is replaced only
+ *          when a request outgrows it. Plain blocks come from the aligned
+ *          allocator. With SIMPLEX_ARENA_HUGE_PAGES, blocks of a huge page or
+ *          more are mapped instead: Linux tries reserved huge pages first and
+ *          falls back to a huge-page-aligned mapping marked for transparent
+ *          huge pages, Windows tries large pages, which need the lock-pages
+ *          privilege, before ordinary pages.
+ *
+ * @author Adrian Paredez
+ * @version 2.0.0
+ * @date 9/5/2025
+ */
+
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 200112L
+/* MAP_ANONYMOUS, MAP_HUGETLB and MADV_HUGEPAGE are extensions to POSIX */
+#define _DEFAULT_SOURCE
+#define _DARWIN_C_SOURCE
+#endif
+
+#include "../include/simplex_noise.h"
+#include "simplex_internal.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#define ARENA_HUGE_PAGE_BYTES ((size_t)2 * 1024 * 1024)
+
+struct simplex_arena {
+    int flags;
+    void* block;
+    size_t capacity;
+    int mapped; /* Block came from the page mapper rather than the aligned allocator */
+};
+
+/* ===== BLOCKS ===== */
+
+// size rounded up to a power-of-two alignment, 0 if that overflows
+static size_t round_up(size_t size, size_t alignment) {
+    if (size > SIZE_MAX - (alignment - 1)) {
+        return 0;
+    }
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+#if defined(_WIN32)
+
+// Committed pages for *size bytes; *size is raised to the pages taken
+static void* map_pages(size_t* size) {
+    SIZE_T large = GetLargePageMinimum();
+    size_t rounded = large > 0 ? round_up(*size, large) : 0;
+    void* block = rounded ? VirtualAlloc(NULL, rounded, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES,
+                                         PAGE_READWRITE)
+                          : NULL;
+    if (block) {
+        *size = rounded;
+        return block;
+    }
+    return VirtualAlloc(NULL, *size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+}
+
+static void unmap_pages(void* block, size_t size) {
+    (void)size;
+    VirtualFree(block, 0, MEM_RELEASE);
+}
+
+static void* aligned_block(size_t size) {
+    return _aligned_malloc(size, SIMPLEX_ARENA_ALIGNMENT);
+}
+
+static void free_aligned_block(void* block) {
+    _aligned_free(block);
+}
+
+#else
+
+// Huge-page-aligned anonymous pages for *size bytes; *size is raised to the pages taken
+static void* map_pages(size_t* size) {
+    size_t rounded = round_up(*size, ARENA_HUGE_PAGE_BYTES);
+    if (rounded == 0 || rounded > SIZE_MAX - ARENA_HUGE_PAGE_BYTES) {
+        return NULL;
+    }
+#if defined(MAP_HUGETLB)
+    void* huge = mmap(NULL, rounded, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (huge != MAP_FAILED) {
+        *size = rounded;
+        return huge;
+    }
+#endif
+    // Map a huge page more than needed and trim both ends to a huge page boundary
+    size_t mapped = rounded + ARENA_HUGE_PAGE_BYTES;
+    void* region = mmap(NULL, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED) {
+        return NULL;
+    }
+    uintptr_t start = (uintptr_t)region;
+    uintptr_t aligned =
+        (start + ARENA_HUGE_PAGE_BYTES - 1) & ~(uintptr_t)(ARENA_HUGE_PAGE_BYTES - 1);
+    size_t head = (size_t)(aligned - start);
+    if (head > 0) {
+        munmap(region, head);
+    }
+    if (mapped - head > rounded) {
+        munmap((void*)(aligned + rounded), mapped - head - rounded);
+    }
+#if defined(MADV_HUGEPAGE)
+    madvise((void*)aligned, rounded, MADV_HUGEPAGE);
+#endif
+    *size = rounded;
+    return (void*)aligned;
+}
+
+static void unmap_pages(void* block, size_t size) {
+    munmap(block, size);
+}
+
+static void* aligned_block(size_t size) {
+    void* block = NULL;
+    return posix_memalign(&block, SIMPLEX_ARENA_ALIGNMENT, size) == 0 ? block : NULL;
+}
+
+static void free_aligned_block(void* block) {
+    free(block);
+}
+
+#endif
+
+static void release_block(simplex_arena_t* arena) {
+    if (arena->mapped) {
+        unmap_pages(arena->block, arena->capacity);
+    } else {
+        free_aligned_block(arena->block);
+    }
+    arena->block = NULL;
+    arena->capacity = 0;
+    arena->mapped = 0;
+}
+
+// Replace the block with one of at least size bytes; the old contents are dropped
+static int grow_block(simplex_arena_t* arena, size_t size) {
+    // Free first, so the old and new blocks are never held at once
+    release_block(arena);
+    size_t capacity = size;
+    if ((arena->flags & SIMPLEX_ARENA_HUGE_PAGES) && size >= ARENA_HUGE_PAGE_BYTES) {
+        arena->block = map_pages(&capacity);
+        arena->mapped = arena->block != NULL;
+    }
+    if (!arena->block) {
+        capacity = size;
+        arena->block = aligned_block(capacity);
+    }
+    if (!arena->block) {
+        return -1;
+    }
+    arena->capacity = capacity;
+    return 0;
+}
+
+/* ===== LAYOUT ===== */
+
+int simplex_arena_carve(simplex_arena_t* arena, const size_t* sizes, void** buffers, int count) {
+    size_t total = 0;
+    for (int i = 0; i < count; i++) {
+        size_t padded = round_up(sizes[i], SIMPLEX_ARENA_ALIGNMENT);
+        if ((sizes[i] > 0 && padded == 0) || total > SIZE_MAX - padded) {
+            return -1;
+        }
+        total += padded;
+    }
+    if (total > arena->capacity && grow_block(arena, total) != 0) {
+        return -1;
+    }
+    unsigned char* next = arena->block;
+    for (int i = 0; i < count; i++) {
+        buffers[i] = sizes[i] > 0 ? next : NULL;
+        next += round_up(sizes[i], SIMPLEX_ARENA_ALIGNMENT);
+    }
+    return 0;
+}
+
+/* ===== PUBLIC API ===== */
+
+simplex_arena_t* simplex_arena_create(int flags) {
+    if ((flags & ~SIMPLEX_ARENA_HUGE_PAGES) != 0) {
+        return NULL;
+    }
+    simplex_arena_t* arena = calloc(1, sizeof(*arena));
+    if (arena) {
+        arena->flags = flags;
+    }
+    return arena;
+}
+
+void simplex_arena_destroy(simplex_arena_t* arena) {
+    if (!arena) {
+        return;
+    }
+    release_block(arena);
+    free(arena);
+}
+
+void* simplex_arena_buffer(simplex_arena_t* arena, size_t size) {
+    void* buffer = NULL;
+    if (!arena || size == 0 || simplex_arena_carve(arena, &size, &buffer, 1) != 0) {
+        return NULL;
+    }
+    return buffer;
+}
+
+size_t simplex_arena_capacity(const simplex_arena_t* arena) {
+    return arena ? arena->capacity : 0;
+}
+
+void simplex_arena_release(simplex_arena_t* arena) {
+    if (arena) {
+        release_block(arena);
+    }
+}
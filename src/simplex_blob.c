@@ -0,0 +1,346 @@
+/**
+ * @file simplex_blob.c
+ * @brief Memory-mapped binary configuration blobs with precomputed seed tables
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @details A blob is a 64-byte header followed by sections at 64-byte aligned
+ *          offsets: the raw simplex_config_t, the stored seeds in ascending
+ *          order, and one simplex_perm_tables_t per seed, each padded to a
+ *          cache line. Opening maps the file read-only and checks the header
+ *          against this build's layout once; the seed tables are then found
+ *          by binary search and copied straight into new contexts. Nothing in
+ *          the mapping is written, so any number of processes share its pages.
+ *
+ * @author Adrian Paredez
+ * @version 2.0.0
+ * @date 9/5/2025
+ */
+
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "../include/simplex_noise.h"
+#include "simplex_internal.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define BLOB_MAGIC "SPXNOISE"
+#define BLOB_BYTE_ORDER 0x01020304U
+
+enum {
+    BLOB_MAGIC_SIZE = 8,
+    BLOB_ALIGNMENT = 64,
+    /* Seed tables start on cache lines */
+    BLOB_TABLE_STRIDE =
+        (sizeof(simplex_perm_tables_t) + BLOB_ALIGNMENT - 1) / BLOB_ALIGNMENT * BLOB_ALIGNMENT
+};
+
+typedef struct {
+    char magic[BLOB_MAGIC_SIZE];
+    uint32_t version;
+    uint32_t byte_order;    /* BLOB_BYTE_ORDER as written by the saving machine */
+    uint32_t header_size;   /* sizeof(blob_header_t) */
+    uint32_t config_size;   /* sizeof(simplex_config_t) */
+    uint32_t table_stride;  /* Bytes from one seed's tables to the next */
+    uint32_t seed_count;
+    uint64_t config_offset;
+    uint64_t seeds_offset;  /* seed_count uint32_t, strictly ascending */
+    uint64_t tables_offset; /* seed_count tables, in seed order */
+    uint64_t file_size;
+} blob_header_t;
+
+struct simplex_config_blob {
+    const unsigned char* base; /* Start of the mapping */
+    size_t size;
+    const simplex_config_t* config;
+    const uint32_t* seeds;
+    const unsigned char* tables;
+    int seed_count;
+};
+
+/* ===== LAYOUT ===== */
+
+static uint64_t align_offset(uint64_t offset) {
+    return (offset + BLOB_ALIGNMENT - 1) & ~(uint64_t)(BLOB_ALIGNMENT - 1);
+}
+
+// Header for a blob of `seed_count` seeds, with every offset filled in
+static blob_header_t blob_layout(uint32_t seed_count) {
+    blob_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, BLOB_MAGIC, BLOB_MAGIC_SIZE);
+    header.version = SIMPLEX_CONFIG_BLOB_VERSION;
+    header.byte_order = BLOB_BYTE_ORDER;
+    header.header_size = sizeof(blob_header_t);
+    header.config_size = sizeof(simplex_config_t);
+    header.table_stride = BLOB_TABLE_STRIDE;
+    header.seed_count = seed_count;
+    header.config_offset = align_offset(sizeof(blob_header_t));
+    header.seeds_offset = align_offset(header.config_offset + sizeof(simplex_config_t));
+    header.tables_offset = align_offset(header.seeds_offset + (uint64_t)seed_count * 4);
+    header.file_size = header.tables_offset + (uint64_t)seed_count * BLOB_TABLE_STRIDE;
+    return header;
+}
+
+// Whether a mapped header describes a blob this build can read in `size` bytes
+static int header_valid(const blob_header_t* header, size_t size) {
+    if (memcmp(header->magic, BLOB_MAGIC, BLOB_MAGIC_SIZE) != 0 ||
+        header->version != SIMPLEX_CONFIG_BLOB_VERSION || header->byte_order != BLOB_BYTE_ORDER ||
+        header->header_size != sizeof(blob_header_t) ||
+        header->config_size != sizeof(simplex_config_t) ||
+        header->table_stride != BLOB_TABLE_STRIDE || header->seed_count > INT32_MAX) {
+        return 0;
+    }
+    // The layout is fixed by the seed count, so any other offsets mean a damaged file
+    blob_header_t expected = blob_layout(header->seed_count);
+    return header->config_offset == expected.config_offset &&
+           header->seeds_offset == expected.seeds_offset &&
+           header->tables_offset == expected.tables_offset &&
+           header->file_size == expected.file_size && expected.file_size == (uint64_t)size;
+}
+
+static int compare_seeds(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+/* ===== SAVING ===== */
+
+int simplex_save_config_binary(const char* filename, const simplex_config_t* config,
+                               const uint32_t* seeds, int seed_count) {
+    if (!filename || !config || seed_count < 0 || (seed_count > 0 && !seeds)) {
+        return -1;
+    }
+    // Sorted, duplicate-free copy of the seeds
+    uint32_t* sorted = malloc((seed_count > 0 ? (size_t)seed_count : 1) * sizeof(uint32_t));
+    if (!sorted) {
+        return -1;
+    }
+    int unique = 0;
+    if (seed_count > 0) {
+        memcpy(sorted, seeds, (size_t)seed_count * sizeof(uint32_t));
+        qsort(sorted, (size_t)seed_count, sizeof(uint32_t), compare_seeds);
+        if (sorted[0] == 0) {
+            free(sorted);
+            return -1;
+        }
+        for (int i = 0; i < seed_count; i++) {
+            if (unique == 0 || sorted[i] != sorted[unique - 1]) {
+                sorted[unique++] = sorted[i];
+            }
+        }
+    }
+
+    blob_header_t header = blob_layout((uint32_t)unique);
+    if (header.file_size > SIZE_MAX) {
+        free(sorted);
+        return -1;
+    }
+    unsigned char* image = calloc(1, (size_t)header.file_size);
+    if (!image) {
+        free(sorted);
+        return -1;
+    }
+    memcpy(image, &header, sizeof(header));
+    memcpy(image + header.config_offset, config, sizeof(*config));
+    memcpy(image + header.seeds_offset, sorted, (size_t)unique * sizeof(uint32_t));
+    for (int i = 0; i < unique; i++) {
+        simplex_perm_tables_t tables;
+        simplex_perm_tables_build(config->prng_type, sorted[i], &tables);
+        memcpy(image + header.tables_offset + (size_t)i * BLOB_TABLE_STRIDE, &tables,
+               sizeof(tables));
+    }
+    free(sorted);
+
+    FILE* file = fopen(filename, "wb");
+    int result = -1;
+    if (file) {
+        size_t written = fwrite(image, 1, (size_t)header.file_size, file);
+        result = fclose(file) == 0 && written == (size_t)header.file_size ? 0 : -1;
+    }
+    free(image);
+    return result;
+}
+
+/* ===== MAPPING ===== */
+
+#if defined(_WIN32)
+
+// Read-only view of a whole file, NULL on failure or an empty file
+static const unsigned char* map_file(const char* filename, size_t* size) {
+    HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return NULL;
+    }
+    LARGE_INTEGER length;
+    const unsigned char* view = NULL;
+    if (GetFileSizeEx(file, &length) && length.QuadPart > 0 &&
+        (unsigned long long)length.QuadPart <= SIZE_MAX) {
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping) {
+            // The view keeps the mapping alive once both handles are closed
+            view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+        }
+        *size = (size_t)length.QuadPart;
+    }
+    CloseHandle(file);
+    return view;
+}
+
+static void unmap_file(const unsigned char* base, size_t size) {
+    (void)size;
+    UnmapViewOfFile(base);
+}
+
+#else
+
+// Read-only mapping of a whole file, NULL on failure or an empty file
+static const unsigned char* map_file(const char* filename, size_t* size) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+    struct stat info;
+    void* base = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size > 0 && (unsigned long long)info.st_size <= SIZE_MAX) {
+        *size = (size_t)info.st_size;
+        base = mmap(NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    return base == MAP_FAILED ? NULL : base;
+}
+
+static void unmap_file(const unsigned char* base, size_t size) {
+    munmap((void*)base, size);
+}
+
+#endif
+
+simplex_config_blob_t* simplex_config_blob_open(const char* filename) {
+    if (!filename) {
+        return NULL;
+    }
+    size_t size = 0;
+    const unsigned char* base = map_file(filename, &size);
+    if (!base) {
+        return NULL;
+    }
+    const blob_header_t* header = (const blob_header_t*)base;
+    simplex_config_blob_t* blob = NULL;
+    if (size >= sizeof(blob_header_t) && header_valid(header, size)) {
+        blob = calloc(1, sizeof(*blob));
+    }
+    if (!blob) {
+        unmap_file(base, size);
+        return NULL;
+    }
+    blob->base = base;
+    blob->size = size;
+    blob->config = (const simplex_config_t*)(base + header->config_offset);
+    blob->seeds = (const uint32_t*)(base + header->seeds_offset);
+    blob->tables = base + header->tables_offset;
+    blob->seed_count = (int)header->seed_count;
+
+    // Strings must end inside their arrays, and the seed search needs ascending seeds
+    const simplex_config_t* config = blob->config;
+    int valid = memchr(config->config_file, '\0', sizeof(config->config_file)) &&
+                memchr(config->output_file, '\0', sizeof(config->output_file));
+    for (int i = 0; valid && i < blob->seed_count; i++) {
+        valid = blob->seeds[i] != 0 && (i == 0 || blob->seeds[i] > blob->seeds[i - 1]);
+    }
+    if (!valid) {
+        simplex_config_blob_close(blob);
+        return NULL;
+    }
+    return blob;
+}
+
+void simplex_config_blob_close(simplex_config_blob_t* blob) {
+    if (blob) {
+        unmap_file(blob->base, blob->size);
+        free(blob);
+    }
+}
+
+const simplex_config_t* simplex_config_blob_config(const simplex_config_blob_t* blob) {
+    return blob ? blob->config : NULL;
+}
+
+int simplex_config_blob_seed_count(const simplex_config_blob_t* blob) {
+    return blob ? blob->seed_count : 0;
+}
+
+uint32_t simplex_config_blob_seed(const simplex_config_blob_t* blob, int index) {
+    if (!blob || index < 0 || index >= blob->seed_count) {
+        return 0;
+    }
+    return blob->seeds[index];
+}
+
+/* ===== CONTEXTS ===== */
+
+/* Stored tables for `seed`, NULL when the seed has none. Gradient indices are
+ * checked before use, as a damaged one would read past the gradient table;
+ * damaged tables are treated as missing and the context shuffles instead. */
+static const simplex_perm_tables_t* find_tables(const simplex_config_blob_t* blob,
+                                                uint32_t seed) {
+    const uint32_t* found =
+        bsearch(&seed, blob->seeds, (size_t)blob->seed_count, sizeof(uint32_t), compare_seeds);
+    if (!found) {
+        return NULL;
+    }
+    const simplex_perm_tables_t* tables =
+        (const simplex_perm_tables_t*)(blob->tables + (size_t)(found - blob->seeds) *
+                                                          BLOB_TABLE_STRIDE);
+    for (int i = 0; i < SIMPLEX_PERM_DOUBLE_SIZE; i++) {
+        if (tables->mod12[i] >= SIMPLEX_3D_GRAD_COUNT) {
+            return NULL;
+        }
+    }
+    return tables;
+}
+
+// The blob's configuration with `seed`, and the tables to start it with
+static const simplex_perm_tables_t* blob_seed(const simplex_config_blob_t* blob, uint32_t seed,
+                                              simplex_config_t* config) {
+    *config = *blob->config;
+    if (seed != 0) {
+        config->seed = seed;
+    }
+    return config->seed != 0 ? find_tables(blob, config->seed) : NULL;
+}
+
+simplex_context_t* simplex_context_create_blob(const simplex_config_blob_t* blob, uint32_t seed) {
+    if (!blob) {
+        return NULL;
+    }
+    simplex_config_t config;
+    const simplex_perm_tables_t* tables = blob_seed(blob, seed, &config);
+    return simplex_context_create_tables(&config, tables);
+}
+
+int simplex_noise_init_blob(const simplex_config_blob_t* blob, uint32_t seed) {
+    if (!blob) {
+        return -1;
+    }
+    simplex_config_t config;
+    const simplex_perm_tables_t* tables = blob_seed(blob, seed, &config);
+    return simplex_noise_init_tables(&config, tables);
+}
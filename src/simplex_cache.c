@@ -0,0 +1,332 @@
+/**
+ * @file simplex_cache.c
+ * @brief LRU cache of shared, read-only fractal noise tiles
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @details Each context owns one cache. Tiles live in a chained hash table
+ *          keyed by their request and on a doubly linked LRU list; the least
+ *          recently used tiles are dropped whenever the cached bytes exceed
+ *          the budget. A tile's header and samples share one allocation, so
+ *          the sample pointer handed to callers leads back to its entry.
+ *          Entries are reference counted: a tile evicted while still held is
+ *          only unlinked, and freed by its last simplex_tile_release(). One
+ *          mutex guards the table, the list, the counters and every entry's
+ *          reference count; tiles are generated outside of it.
+ *
+ * @author Adrian Paredez
+ * @version 2.0.0
+ * @date 9/5/2025
+ */
+
+#include "simplex_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+enum { TILE_CACHE_INITIAL_BUCKETS = 64 };
+
+#define FNV_OFFSET_BASIS 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+typedef struct tile_entry {
+    struct tile_entry* bucket_next;
+    struct tile_entry* lru_prev; /* More recently used */
+    struct tile_entry* lru_next; /* Less recently used */
+    simplex_tile_cache_t* cache; /* Cache guarding refs, NULL if the context has none */
+    simplex_tile_request_t key;
+    uint64_t hash;
+    size_t bytes; /* Header plus samples */
+    int refs;
+    int cached; /* Still reachable from the hash table */
+    double data[];
+} tile_entry_t;
+
+struct simplex_tile_cache {
+    simplex_lock_t* lock;
+    tile_entry_t** buckets;
+    size_t bucket_count; /* Power of two */
+    size_t entry_count;
+    tile_entry_t* lru_head; /* Most recently used */
+    tile_entry_t* lru_tail; /* Next to evict */
+    size_t bytes;
+    size_t budget;
+
+    size_t hits;
+    size_t misses;
+    size_t evictions;
+};
+
+/* ===== KEYS ===== */
+
+static uint64_t hash_bytes(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* bytes = data;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+// Field by field, so struct padding never reaches the hash
+static uint64_t request_hash(const simplex_tile_request_t* r) {
+    uint64_t hash = FNV_OFFSET_BASIS;
+    hash = hash_bytes(hash, &r->tile_x, sizeof(r->tile_x));
+    hash = hash_bytes(hash, &r->tile_y, sizeof(r->tile_y));
+    hash = hash_bytes(hash, &r->resolution, sizeof(r->resolution));
+    hash = hash_bytes(hash, &r->tile_size, sizeof(r->tile_size));
+    hash = hash_bytes(hash, &r->octaves, sizeof(r->octaves));
+    hash = hash_bytes(hash, &r->persistence, sizeof(r->persistence));
+    return hash_bytes(hash, &r->lacunarity, sizeof(r->lacunarity));
+}
+
+static int request_equal(const simplex_tile_request_t* a, const simplex_tile_request_t* b) {
+    return a->tile_x == b->tile_x && a->tile_y == b->tile_y && a->resolution == b->resolution &&
+           a->tile_size == b->tile_size && a->octaves == b->octaves &&
+           a->persistence == b->persistence && a->lacunarity == b->lacunarity;
+}
+
+/* ===== TABLE AND LRU LIST (cache lock held) ===== */
+
+static tile_entry_t* table_find(const simplex_tile_cache_t* cache,
+                                const simplex_tile_request_t* key, uint64_t hash) {
+    tile_entry_t* entry = cache->buckets[hash & (cache->bucket_count - 1)];
+    while (entry && (entry->hash != hash || !request_equal(&entry->key, key))) {
+        entry = entry->bucket_next;
+    }
+    return entry;
+}
+
+// Double the bucket array once the load factor passes 1; on failure keep the old one
+static void table_grow(simplex_tile_cache_t* cache) {
+    size_t count = cache->bucket_count * 2;
+    tile_entry_t** buckets = calloc(count, sizeof(*buckets));
+    if (!buckets) {
+        return;
+    }
+    for (size_t i = 0; i < cache->bucket_count; i++) {
+        tile_entry_t* entry = cache->buckets[i];
+        while (entry) {
+            tile_entry_t* next = entry->bucket_next;
+            tile_entry_t** bucket = &buckets[entry->hash & (count - 1)];
+            entry->bucket_next = *bucket;
+            *bucket = entry;
+            entry = next;
+        }
+    }
+    free(cache->buckets);
+    cache->buckets = buckets;
+    cache->bucket_count = count;
+}
+
+static void lru_unlink(simplex_tile_cache_t* cache, tile_entry_t* entry) {
+    if (entry->lru_prev) {
+        entry->lru_prev->lru_next = entry->lru_next;
+    } else {
+        cache->lru_head = entry->lru_next;
+    }
+    if (entry->lru_next) {
+        entry->lru_next->lru_prev = entry->lru_prev;
+    } else {
+        cache->lru_tail = entry->lru_prev;
+    }
+    entry->lru_prev = NULL;
+    entry->lru_next = NULL;
+}
+
+static void lru_push_front(simplex_tile_cache_t* cache, tile_entry_t* entry) {
+    entry->lru_prev = NULL;
+    entry->lru_next = cache->lru_head;
+    if (cache->lru_head) {
+        cache->lru_head->lru_prev = entry;
+    } else {
+        cache->lru_tail = entry;
+    }
+    cache->lru_head = entry;
+}
+
+static void cache_insert(simplex_tile_cache_t* cache, tile_entry_t* entry) {
+    if (cache->entry_count >= cache->bucket_count) {
+        table_grow(cache);
+    }
+    tile_entry_t** bucket = &cache->buckets[entry->hash & (cache->bucket_count - 1)];
+    entry->bucket_next = *bucket;
+    *bucket = entry;
+    lru_push_front(cache, entry);
+    entry->cached = 1;
+    cache->entry_count++;
+    cache->bytes += entry->bytes;
+}
+
+// Unlink an entry from the table and list; it is freed now unless still held
+static void cache_drop(simplex_tile_cache_t* cache, tile_entry_t* entry) {
+    tile_entry_t** link = &cache->buckets[entry->hash & (cache->bucket_count - 1)];
+    while (*link != entry) {
+        link = &(*link)->bucket_next;
+    }
+    *link = entry->bucket_next;
+    lru_unlink(cache, entry);
+    entry->cached = 0;
+    cache->entry_count--;
+    cache->bytes -= entry->bytes;
+    if (entry->refs == 0) {
+        free(entry);
+    }
+}
+
+static void cache_trim(simplex_tile_cache_t* cache) {
+    while (cache->bytes > cache->budget && cache->lru_tail) {
+        cache_drop(cache, cache->lru_tail);
+        cache->evictions++;
+    }
+}
+
+/* ===== LIFETIME ===== */
+
+simplex_tile_cache_t* simplex_tile_cache_create(size_t budget_bytes) {
+    simplex_tile_cache_t* cache = calloc(1, sizeof(*cache));
+    if (!cache) {
+        return NULL;
+    }
+    cache->lock = simplex_lock_create();
+    cache->buckets = calloc(TILE_CACHE_INITIAL_BUCKETS, sizeof(*cache->buckets));
+    if (!cache->lock || !cache->buckets) {
+        simplex_lock_destroy(cache->lock);
+        free(cache->buckets);
+        free(cache);
+        return NULL;
+    }
+    cache->bucket_count = TILE_CACHE_INITIAL_BUCKETS;
+    cache->budget = budget_bytes;
+    return cache;
+}
+
+void simplex_tile_cache_reset(simplex_tile_cache_t* cache, size_t budget_bytes) {
+    simplex_lock_acquire(cache->lock);
+    while (cache->lru_head) {
+        cache_drop(cache, cache->lru_head);
+    }
+    cache->budget = budget_bytes;
+    simplex_lock_release(cache->lock);
+}
+
+void simplex_tile_cache_destroy(simplex_tile_cache_t* cache) {
+    if (!cache) {
+        return;
+    }
+    simplex_tile_cache_reset(cache, 0);
+    simplex_lock_destroy(cache->lock);
+    free(cache->buckets);
+    free(cache);
+}
+
+/* ===== STATISTICS ===== */
+
+void simplex_tile_cache_get_stats(simplex_tile_cache_t* cache, simplex_perf_stats_t* stats) {
+    simplex_lock_acquire(cache->lock);
+    stats->cache_hits = cache->hits;
+    stats->cache_misses = cache->misses;
+    stats->cache_evictions = cache->evictions;
+    simplex_lock_release(cache->lock);
+}
+
+void simplex_tile_cache_reset_stats(simplex_tile_cache_t* cache) {
+    simplex_lock_acquire(cache->lock);
+    cache->hits = 0;
+    cache->misses = 0;
+    cache->evictions = 0;
+    simplex_lock_release(cache->lock);
+}
+
+/* ===== TILES ===== */
+
+const double* simplex_tile_cache_acquire(simplex_tile_cache_t* cache, const simplex_context_t* ctx,
+                                         const simplex_tile_request_t* request) {
+    if (!request || request->resolution <= 0 || request->octaves <= 0 ||
+        !(request->tile_size > 0.0)) {
+        return NULL;
+    }
+    size_t samples = (size_t)request->resolution;
+    if (samples > (SIZE_MAX - sizeof(tile_entry_t)) / sizeof(double) / samples) {
+        return NULL;
+    }
+    samples *= (size_t)request->resolution;
+    uint64_t hash = request_hash(request);
+
+    if (cache) {
+        simplex_lock_acquire(cache->lock);
+        tile_entry_t* hit = table_find(cache, request, hash);
+        if (hit) {
+            hit->refs++;
+            lru_unlink(cache, hit);
+            lru_push_front(cache, hit);
+            cache->hits++;
+        } else {
+            cache->misses++;
+        }
+        simplex_lock_release(cache->lock);
+        if (hit) {
+            return hit->data;
+        }
+    }
+
+    tile_entry_t* entry = malloc(sizeof(*entry) + (samples * sizeof(double)));
+    if (!entry) {
+        return NULL;
+    }
+    memset(entry, 0, sizeof(*entry));
+    entry->cache = cache;
+    entry->key = *request;
+    entry->hash = hash;
+    entry->bytes = sizeof(*entry) + (samples * sizeof(double));
+    entry->refs = 1;
+
+    double step = request->tile_size / request->resolution;
+    if (simplex_fractal_array_2d_ctx(ctx, request->tile_x * request->tile_size,
+                                     request->tile_y * request->tile_size, request->resolution,
+                                     request->resolution, step, request->octaves,
+                                     request->persistence, request->lacunarity,
+                                     entry->data) != 0) {
+        free(entry);
+        return NULL;
+    }
+    if (!cache) {
+        return entry->data;
+    }
+
+    simplex_lock_acquire(cache->lock);
+    if (ctx->cache_enabled && entry->bytes <= cache->budget) {
+        // Another thread may have generated the same tile meanwhile; share its copy
+        tile_entry_t* existing = table_find(cache, request, hash);
+        if (existing) {
+            existing->refs++;
+            lru_unlink(cache, existing);
+            lru_push_front(cache, existing);
+            simplex_lock_release(cache->lock);
+            free(entry);
+            return existing->data;
+        }
+        cache_insert(cache, entry);
+        cache_trim(cache);
+    }
+    simplex_lock_release(cache->lock);
+    return entry->data;
+}
+
+void simplex_tile_release(const double* tile) {
+    if (!tile) {
+        return;
+    }
+    char* samples = (char*)(uintptr_t)tile;
+    tile_entry_t* entry = (tile_entry_t*)(void*)(samples - offsetof(tile_entry_t, data));
+    simplex_tile_cache_t* cache = entry->cache;
+    if (!cache) {
+        free(entry);
+        return;
+    }
+    simplex_lock_acquire(cache->lock);
+    int unreferenced = --entry->refs == 0 && !entry->cached;
+    simplex_lock_release(cache->lock);
+    if (unreferenced) {
+        free(entry);
+    }
+}
@@ -0,0 +1,357 @@
+/**
+ * @file simplex_deriv.c
+ * @brief Simplex noise with analytic gradients, for normals and flow fields
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @details Each corner contributes t^4 * (g . d) with t = threshold - |d|^2,
+ *          so its gradient is t^4 * g - 8 * t^3 * (g . d) * d. The value and
+ *          the gradient come out of the same pass over the simplex corners;
+ *          the value follows the exact arithmetic of simplex_noise_2d() and
+ *          simplex_noise_3d(), so the two always agree bit for bit. The
+ *          array forms run rows on the thread pool like the other bulk
+ *          functions. Derivatives are always evaluated in double precision.
+ *
+ * @author Adrian Paredez
+ * @version 2.0.0
+ * @date 9/5/2025
+ */
+
+#include "simplex_internal.h"
+#include <limits.h>
+#include <math.h>
+#include <stddef.h>
+
+enum { DERIV_DEFAULT_CHUNK_SIZE = 1024 };
+
+static int deriv_floor(double x) {
+    return x > 0 ? (int)x : (int)x - 1;
+}
+
+/* ===== CORNER KERNELS ===== */
+
+// One 2D corner: adds its gradient to d and returns its contribution
+static double corner_2d(const double g[2], double x, double y, double d[2]) {
+    double t = SIMPLEX_2D_THRESHOLD - (x * x) - (y * y);
+    if (t < 0) {
+        return 0.0;
+    }
+    double t2 = t * t;
+    double t4 = t2 * t2;
+    double dot = (g[0] * x) + (g[1] * y);
+    double falloff = 8.0 * t2 * t * dot;
+    d[0] += (t4 * g[0]) - (falloff * x);
+    d[1] += (t4 * g[1]) - (falloff * y);
+    return t4 * dot;
+}
+
+// One 3D corner: adds its gradient to d and returns its contribution
+static double corner_3d(const double g[3], double x, double y, double z, double d[3]) {
+    double t = SIMPLEX_3D_THRESHOLD - (x * x) - (y * y) - (z * z);
+    if (t < 0) {
+        return 0.0;
+    }
+    double t2 = t * t;
+    double t4 = t2 * t2;
+    double dot = (g[0] * x) + (g[1] * y) + (g[2] * z);
+    double falloff = 8.0 * t2 * t * dot;
+    d[0] += (t4 * g[0]) - (falloff * x);
+    d[1] += (t4 * g[1]) - (falloff * y);
+    d[2] += (t4 * g[2]) - (falloff * z);
+    return t4 * dot;
+}
+
+static double noise_2d_deriv(const simplex_perm_tables_t* tables, double x, double y,
+                             double gradient[2]) {
+    const uint8_t* perm = tables->perm;
+    const double F2 = 0.5 * (sqrt(3.0) - 1.0);
+    const double G2 = (3.0 - sqrt(3.0)) / 6.0;
+
+    double s = (x + y) * F2;
+    int i = deriv_floor(x + s);
+    int j = deriv_floor(y + s);
+    double t = (i + j) * G2;
+    double x0 = x - (i - t);
+    double y0 = y - (j - t);
+    int i1 = x0 > y0 ? 1 : 0;
+    int j1 = 1 - i1;
+
+    int ii = i & 0xff;
+    int jj = j & 0xff;
+    int gi0 = perm[ii + perm[jj]] % SIMPLEX_2D_GRAD_COUNT;
+    int gi1 = perm[ii + i1 + perm[jj + j1]] % SIMPLEX_2D_GRAD_COUNT;
+    int gi2 = perm[ii + 1 + perm[jj + 1]] % SIMPLEX_2D_GRAD_COUNT;
+
+    double d[2] = {0.0, 0.0};
+    double n0 = corner_2d(simplex_grad2[gi0], x0, y0, d);
+    double n1 = corner_2d(simplex_grad2[gi1], x0 - i1 + G2, y0 - j1 + G2, d);
+    double n2 = corner_2d(simplex_grad2[gi2], x0 - 1.0 + (2.0 * G2), y0 - 1.0 + (2.0 * G2), d);
+    gradient[0] = SIMPLEX_2D_SCALE * d[0];
+    gradient[1] = SIMPLEX_2D_SCALE * d[1];
+    return SIMPLEX_2D_SCALE * (n0 + n1 + n2);
+}
+
+static double noise_3d_deriv(const simplex_perm_tables_t* tables, double x, double y, double z,
+                             double gradient[3]) {
+    const uint8_t* perm = tables->perm;
+    const uint8_t* mod12 = tables->mod12;
+    const double F3 = 1.0 / 3.0;
+    const double G3 = 1.0 / 6.0;
+
+    double s = (x + y + z) * F3;
+    int i = deriv_floor(x + s);
+    int j = deriv_floor(y + s);
+    int k = deriv_floor(z + s);
+    double t = (i + j + k) * G3;
+    double x0 = x - (i - t);
+    double y0 = y - (j - t);
+    double z0 = z - (k - t);
+
+    // Second and third corners of the simplex, as in simplex_noise_3d()
+    int i1 = 0;
+    int j1 = 0;
+    int k1 = 0;
+    int i2 = 0;
+    int j2 = 0;
+    int k2 = 0;
+    if (x0 >= y0) {
+        if (y0 >= z0) {
+            i1 = i2 = j2 = 1;
+        } else if (x0 >= z0) {
+            i1 = i2 = k2 = 1;
+        } else {
+            k1 = i2 = k2 = 1;
+        }
+    } else {
+        if (y0 < z0) {
+            k1 = j2 = k2 = 1;
+        } else if (x0 < z0) {
+            j1 = j2 = k2 = 1;
+        } else {
+            j1 = i2 = j2 = 1;
+        }
+    }
+
+    int ii = i & 0xff;
+    int jj = j & 0xff;
+    int kk = k & 0xff;
+    int gi0 = mod12[ii + perm[jj + perm[kk]]];
+    int gi1 = mod12[ii + i1 + perm[jj + j1 + perm[kk + k1]]];
+    int gi2 = mod12[ii + i2 + perm[jj + j2 + perm[kk + k2]]];
+    int gi3 = mod12[ii + 1 + perm[jj + 1 + perm[kk + 1]]];
+
+    double d[3] = {0.0, 0.0, 0.0};
+    double n0 = corner_3d(simplex_grad3[gi0], x0, y0, z0, d);
+    double n1 = corner_3d(simplex_grad3[gi1], x0 - i1 + G3, y0 - j1 + G3, z0 - k1 + G3, d);
+    double n2 = corner_3d(simplex_grad3[gi2], x0 - i2 + (2.0 * G3), y0 - j2 + (2.0 * G3),
+                          z0 - k2 + (2.0 * G3), d);
+    double n3 = corner_3d(simplex_grad3[gi3], x0 - 1.0 + (3.0 * G3), y0 - 1.0 + (3.0 * G3),
+                          z0 - 1.0 + (3.0 * G3), d);
+    gradient[0] = SIMPLEX_3D_SCALE * d[0];
+    gradient[1] = SIMPLEX_3D_SCALE * d[1];
+    gradient[2] = SIMPLEX_3D_SCALE * d[2];
+    return SIMPLEX_3D_SCALE * (n0 + n1 + n2 + n3);
+}
+
+// fBm and its gradient; the value matches simplex_fbm_2d()
+static double fbm_2d_deriv(const simplex_perm_tables_t* tables, double x, double y, int octaves,
+                           double persistence, double lacunarity, double gradient[2]) {
+    double value = 0.0;
+    double amplitude = 1.0;
+    double frequency = 1.0;
+    double maxValue = 0.0;
+    double dx = 0.0;
+    double dy = 0.0;
+
+    for (int i = 0; i < octaves; i++) {
+        double d[2];
+        value += noise_2d_deriv(tables, x * frequency, y * frequency, d) * amplitude;
+        dx += d[0] * amplitude * frequency;
+        dy += d[1] * amplitude * frequency;
+        maxValue += amplitude;
+        amplitude *= persistence;
+        frequency *= lacunarity;
+    }
+
+    gradient[0] = dx / maxValue;
+    gradient[1] = dy / maxValue;
+    return value / maxValue;
+}
+
+/* ===== POINT FUNCTIONS ===== */
+
+double simplex_noise_2d_deriv(double x, double y, double* gradient) {
+    return simplex_noise_2d_deriv_ctx(NULL, x, y, gradient);
+}
+
+double simplex_noise_2d_deriv_ctx(const simplex_context_t* ctx, double x, double y,
+                                  double* gradient) {
+    ctx = simplex_context_resolve(ctx);
+    SIMPLEX_PROFILE_BEGIN(ctx);
+    double d[2];
+    double result = noise_2d_deriv(&ctx->tables, x, y, d);
+    if (gradient) {
+        gradient[0] = d[0];
+        gradient[1] = d[1];
+    }
+    SIMPLEX_PROFILE_END(ctx, SIMPLEX_PROFILE_NOISE_2D, 1);
+    return result;
+}
+
+double simplex_noise_3d_deriv(double x, double y, double z, double* gradient) {
+    return simplex_noise_3d_deriv_ctx(NULL, x, y, z, gradient);
+}
+
+double simplex_noise_3d_deriv_ctx(const simplex_context_t* ctx, double x, double y, double z,
+                                  double* gradient) {
+    ctx = simplex_context_resolve(ctx);
+    SIMPLEX_PROFILE_BEGIN(ctx);
+    double d[3];
+    double result = noise_3d_deriv(&ctx->tables, x, y, z, d);
+    if (gradient) {
+        gradient[0] = d[0];
+        gradient[1] = d[1];
+        gradient[2] = d[2];
+    }
+    SIMPLEX_PROFILE_END(ctx, SIMPLEX_PROFILE_NOISE_3D, 1);
+    return result;
+}
+
+double simplex_fbm_2d_deriv(double x, double y, int octaves, double persistence,
+                            double lacunarity, double* gradient) {
+    return simplex_fbm_2d_deriv_ctx(NULL, x, y, octaves, persistence, lacunarity, gradient);
+}
+
+double simplex_fbm_2d_deriv_ctx(const simplex_context_t* ctx, double x, double y, int octaves,
+                                double persistence, double lacunarity, double* gradient) {
+    ctx = simplex_context_resolve(ctx);
+    SIMPLEX_PROFILE_BEGIN(ctx);
+    double d[2];
+    double result = fbm_2d_deriv(&ctx->tables, x, y, octaves, persistence, lacunarity, d);
+    if (gradient) {
+        gradient[0] = d[0];
+        gradient[1] = d[1];
+    }
+    SIMPLEX_PROFILE_END(ctx, SIMPLEX_PROFILE_FBM, 1);
+    return result;
+}
+
+/* ===== ARRAYS ===== */
+
+// One derivative array request; octaves == 0 means plain noise
+typedef struct {
+    const simplex_context_t* ctx;
+    int dims;
+    int octaves;
+    double persistence;
+    double lacunarity;
+    double x_start;
+    double y_start;
+    double z_start;
+    double step;
+    int width;
+    int height;
+    double* output;   /* Values, may be NULL */
+    double* gradient; /* dims interleaved components per sample */
+} deriv_job_t;
+
+// Rows [begin, end); rows of a 3D job are numbered z * height + y
+static void deriv_rows(void* arg, int begin, int end) {
+    const deriv_job_t* job = arg;
+    const simplex_perm_tables_t* tables = &job->ctx->tables;
+
+    for (int r = begin; r < end; r++) {
+        double y = job->y_start + ((r % job->height) * job->step);
+        double z = job->z_start + ((r / job->height) * job->step);
+        size_t index = (size_t)r * job->width;
+        double* gradient = job->gradient + (index * job->dims);
+        for (int c = 0; c < job->width; c++, gradient += job->dims) {
+            double x = job->x_start + (c * job->step);
+            double value;
+            if (job->dims == 3) {
+                value = noise_3d_deriv(tables, x, y, z, gradient);
+            } else if (job->octaves > 0) {
+                value = fbm_2d_deriv(tables, x, y, job->octaves, job->persistence,
+                                     job->lacunarity, gradient);
+            } else {
+                value = noise_2d_deriv(tables, x, y, gradient);
+            }
+            if (job->output) {
+                job->output[index + c] = value;
+            }
+        }
+    }
+}
+
+static int run_deriv(deriv_job_t* job, int depth) {
+    if (!job->gradient || job->width <= 0 || job->height <= 0 || depth <= 0 ||
+        job->height > INT_MAX / depth) {
+        return -1;
+    }
+    job->ctx = simplex_context_resolve(job->ctx);
+    const simplex_config_t* config = &job->ctx->config;
+    int chunk_size = config->chunk_size > 0 ? config->chunk_size : DERIV_DEFAULT_CHUNK_SIZE;
+    int rows_per_task = chunk_size / job->width;
+
+    SIMPLEX_PROFILE_BEGIN(job->ctx);
+    simplex_parallel_for(job->height * depth, rows_per_task < 1 ? 1 : rows_per_task,
+                         config->max_threads, deriv_rows, job);
+    SIMPLEX_PROFILE_END(job->ctx,
+                        job->octaves > 0 ? SIMPLEX_PROFILE_FRACTAL_ARRAY
+                                         : SIMPLEX_PROFILE_NOISE_ARRAY,
+                        (size_t)job->width * (size_t)job->height * (size_t)depth);
+    return 0;
+}
+
+int simplex_noise_array_2d_deriv(double x_start, double y_start, int width, int height,
+                                 double step, double* output, double* gradient) {
+    return simplex_noise_array_2d_deriv_ctx(NULL, x_start, y_start, width, height, step, output,
+                                            gradient);
+}
+
+int simplex_noise_array_2d_deriv_ctx(const simplex_context_t* ctx, double x_start,
+                                     double y_start, int width, int height, double step,
+                                     double* output, double* gradient) {
+    deriv_job_t job = {.ctx = ctx, .dims = 2, .x_start = x_start, .y_start = y_start,
+                       .step = step, .width = width, .height = height, .output = output,
+                       .gradient = gradient};
+    return run_deriv(&job, 1);
+}
+
+int simplex_noise_array_3d_deriv(double x_start, double y_start, double z_start, int width,
+                                 int height, int depth, double step, double* output,
+                                 double* gradient) {
+    return simplex_noise_array_3d_deriv_ctx(NULL, x_start, y_start, z_start, width, height,
+                                            depth, step, output, gradient);
+}
+
+int simplex_noise_array_3d_deriv_ctx(const simplex_context_t* ctx, double x_start,
+                                     double y_start, double z_start, int width, int height,
+                                     int depth, double step, double* output, double* gradient) {
+    deriv_job_t job = {.ctx = ctx, .dims = 3, .x_start = x_start, .y_start = y_start,
+                       .z_start = z_start, .step = step, .width = width, .height = height,
+                       .output = output, .gradient = gradient};
+    return run_deriv(&job, depth);
+}
+
+int simplex_fbm_array_2d_deriv(double x_start, double y_start, int width, int height,
+                               double step, int octaves, double persistence, double lacunarity,
+                               double* output, double* gradient) {
+    return simplex_fbm_array_2d_deriv_ctx(NULL, x_start, y_start, width, height, step, octaves,
+                                          persistence, lacunarity, output, gradient);
+}
+
+int simplex_fbm_array_2d_deriv_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                                   int width, int height, double step, int octaves,
+                                   double persistence, double lacunarity, double* output,
+                                   double* gradient) {
+    if (octaves <= 0) {
+        return -1;
+    }
+    deriv_job_t job = {.ctx = ctx, .dims = 2, .octaves = octaves, .persistence = persistence,
+                       .lacunarity = lacunarity, .x_start = x_start, .y_start = y_start,
+                       .step = step, .width = width, .height = height, .output = output,
+                       .gradient = gradient};
+    return run_deriv(&job, 1);
+}
@@ -15,6 +15,7 @@
 
 #include "../include/simplex_image.h"
 #include "../include/simplex_noise.h"
+#include "simplex_internal.h"
 #include <math.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -53,36 +54,111 @@
 
 /* ===== INTERNAL FUNCTIONS ===== */
 
-// PPM file writing functions
-static int write_ppm_header(FILE* file, int width, int height, int max_color) {
-    return fprintf(file, "P6\n%d %d\n%d\n", width, height, max_color);
+// Destination of encoded image bytes: a file, a caller callback or a caller buffer
+typedef struct {
+    FILE* file;
+    simplex_image_write_fn write;
+    void* user_data;
+    uint8_t* buffer;
+    size_t capacity;
+    size_t size;                /* Bytes written so far */
+    simplex_png_encoder_t* png; /* Encoder between begin_image() and end_image() of a PNG */
+    int heights;                /* Buffer takes float samples instead of colorized pixels */
+} image_sink_t;
+
+enum { IMAGE_HEADER_MAX = 64, MAX_COLOR_VALUE_16 = 65535 };
+
+static int sink_write(image_sink_t* sink, const void* data, size_t size) {
+    if (sink->file) {
+        return fwrite(data, 1, size, sink->file) == size ? 0 : -1;
+    }
+    if (sink->write) {
+        return sink->write(sink->user_data, data, size) == 0 ? 0 : -1;
+    }
+    if (size > sink->capacity - sink->size) {
+        return -1;
+    }
+    memcpy(sink->buffer + sink->size, data, size);
+    sink->size += size;
+    return 0;
+}
+
+// sink_write() for the PNG encoder's callback
+static int sink_write_encoded(void* sink, const void* data, size_t size) {
+    return sink_write(sink, data, size);
+}
+
+// Claim `size` bytes of a buffer sink to render into in place; NULL for other sinks
+static uint8_t* sink_reserve(image_sink_t* sink, size_t size) {
+    if (!sink->buffer || sink->png || size > sink->capacity - sink->size) {
+        return NULL;
+    }
+    uint8_t* data = sink->buffer + sink->size;
+    sink->size += size;
+    return data;
+}
+
+static int is_grayscale(simplex_color_mode_t color_mode) {
+    return color_mode == SIMPLEX_COLOR_GRAYSCALE || color_mode == SIMPLEX_COLOR_GRAYSCALE16;
 }
 
-static int write_pgm_header(FILE* file, int width, int height, int max_color) {
-    return fprintf(file, "P5\n%d %d\n%d\n", width, height, max_color);
+// Bytes written per pixel for a color mode
+static int color_mode_channels(simplex_color_mode_t color_mode) {
+    if (color_mode == SIMPLEX_COLOR_GRAYSCALE16) {
+        return 2;
+    }
+    return color_mode == SIMPLEX_COLOR_GRAYSCALE ? 1 : 3;
 }
 
-static int write_ppm_pixels(FILE* file, const uint8_t* pixels, int width, int height,
-                            int channels) {
-    size_t pixel_count = (size_t)width * height * channels;
-    return fwrite(pixels, 1, pixel_count, file) == pixel_count ? 0 : -1;
+// PPM/PGM header text; returns its length, 0 for RAW and PNG, which have no text header
+static size_t format_image_header(char* header, simplex_image_format_t format, int width,
+                                  int height, simplex_color_mode_t color_mode) {
+    if (format == SIMPLEX_IMAGE_RAW || format == SIMPLEX_IMAGE_PNG) {
+        return 0;
+    }
+    int max_color = color_mode == SIMPLEX_COLOR_GRAYSCALE16 ? MAX_COLOR_VALUE_16 : MAX_COLOR_VALUE;
+    int length = snprintf(header, IMAGE_HEADER_MAX, "P%c\n%d %d\n%d\n",
+                          is_grayscale(color_mode) ? '5' : '6', width, height, max_color);
+    return length > 0 ? (size_t)length : 0;
 }
 
-static int write_pgm_pixels(FILE* file, const uint8_t* pixels, int width, int height) {
-    size_t pixel_count = (size_t)width * height;
-    return fwrite(pixels, 1, pixel_count, file) == pixel_count ? 0 : -1;
+// Start an image: its text header, or for PNG the encoder, which writes its own
+static int begin_image(image_sink_t* sink, const simplex_image_config_t* config,
+                       simplex_color_mode_t color_mode, int max_threads) {
+    if (config->format == SIMPLEX_IMAGE_PNG) {
+        simplex_png_params_t params = {.width = config->width,
+                                       .height = config->height,
+                                       .channels = is_grayscale(color_mode) ? 1 : 3,
+                                       .bit_depth = color_mode == SIMPLEX_COLOR_GRAYSCALE16 ? 16
+                                                                                            : 8,
+                                       .level = config->png_compression,
+                                       .filter = config->png_filter,
+                                       .max_threads = max_threads,
+                                       .write = sink_write_encoded,
+                                       .user_data = sink};
+        sink->png = simplex_png_begin(&params);
+        return sink->png ? 0 : -1;
+    }
+    char header[IMAGE_HEADER_MAX];
+    size_t length =
+        format_image_header(header, config->format, config->width, config->height, color_mode);
+    // RAW images have no header; write callbacks never see an empty call
+    return length > 0 ? sink_write(sink, header, length) : 0;
 }
 
-// PNG file writing (simple implementation without libpng dependency)
-static int write_png_simple(FILE* file, const uint8_t* pixels, int width, int height,
-                            int channels) {
-    // For now, we'll write as PPM since we don't have libpng
-    // In a full implementation, you'd use libpng here
-    fprintf(stderr, "PNG support requires libpng. Writing as PPM instead.\n");
-    return write_ppm_header(file, width, height, MAX_COLOR_VALUE) > 0 &&
-                   write_ppm_pixels(file, pixels, width, height, channels) == 0
-               ? 0
-               : -1;
+// Append `rows` rows of `row_bytes` pixel bytes each
+static int write_pixels(image_sink_t* sink, const uint8_t* pixels, int rows, size_t row_bytes) {
+    if (sink->png) {
+        return simplex_png_write_rows(sink->png, pixels, rows);
+    }
+    return sink_write(sink, pixels, (size_t)rows * row_bytes);
+}
+
+// Finish the image; must follow every successful begin_image()
+static int end_image(image_sink_t* sink) {
+    int result = sink->png ? simplex_png_end(sink->png) : 0;
+    sink->png = NULL;
+    return result;
 }
 
 // Color conversion functions
@@ -159,102 +235,903 @@ static void noise_to_terrain(double noise, uint8_t* r, uint8_t* g, uint8_t* b) {
     }
 }
 
-// Generate noise data for image
-static int generate_noise_data(double* data, int width, int height,
-                               const simplex_image_config_t* config, double z_offset) {
-    (void)z_offset;  // Suppress unused parameter warning - used in 3D image generation
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            double noise_x = (x + config->offset_x) * config->scale;
-            double noise_y = (y + config->offset_y) * config->scale;
+/* ===== FUSED PIXEL PIPELINE ===== */
+
+/*
+ * Rows are cut into tiles of IMAGE_TILE_SAMPLES samples. Each tile is
+ * generated into a stack buffer and immediately normalized and colorized into
+ * the band's pixels, so samples never make a round trip through memory. The
+ * color mode picks one tile writer per image. Only exact normalization needs
+ * the image's range first: it is measured from retained samples when they fit
+ * in memory_limit_mb, and by generating every tile twice otherwise.
+ */
 
-            double noise_value = NAN;
+enum { IMAGE_TILE_SAMPLES = 512, IMAGE_DEFAULT_CHUNK_SIZE = 1024 };
+
+// Mapping of samples onto 0-1 applied while colorizing
+typedef struct {
+    int enabled; /* 0 passes samples through unchanged */
+    int clamp;   /* Clamp mapped values to [0, 1] */
+    double min_val;
+    double range;
+} pixel_norm_t;
+
+typedef void (*tile_writer_fn)(const double* samples, int count, const pixel_norm_t* norm,
+                               uint8_t* pixels);
+
+// What an image's samples are drawn from
+typedef struct {
+    int dims; /* 2 for the plane, 3 for a z slice */
+    double z_start;
+    const simplex_warp_config_t* warp; /* Warp of a warped 2D image, NULL if none */
+    /* Full image pixel of pixel (0, 0) of a tile, 0 for whole images */
+    int x0;
+    int y0;
+} image_source_t;
+
+// One band of image rows handed to the thread pool
+typedef struct {
+    const simplex_image_config_t* config;
+    const simplex_context_t* ctx; /* Seeded context the noise is drawn from */
+    const image_source_t* source;
+    int y0;             /* Image row of band row 0 */
+    double* samples;    /* Band samples kept between passes, NULL to generate per tile */
+    int kept;           /* samples hold the whole image from the measuring pass */
+    int bulk;           /* Generate each band with one array call (offloaded contexts) */
+    uint8_t* pixels;    /* Band pixels, NULL on a measuring pass */
+    double* row_min;    /* Per band row range, filled by measuring passes */
+    double* row_max;
+    tile_writer_fn write_tile;
+    pixel_norm_t norm;
+    int channels;
+} image_band_t;
+
+static void set_pixel_norm(pixel_norm_t* norm, double min_val, double max_val, int clamp) {
+    norm->min_val = min_val;
+    norm->range = max_val - min_val;
+    norm->enabled = norm->range > 0;
+    norm->clamp = clamp;
+}
+
+static double normalize_sample(double value, const pixel_norm_t* norm) {
+    if (!norm->enabled) {
+        return value;
+    }
+    value = (value - norm->min_val) / norm->range;
+    if (norm->clamp) {
+        value = value < 0.0 ? 0.0 : (value > 1.0 ? 1.0 : value);
+    }
+    return value;
+}
+
+static void pixel_grayscale(double noise, uint8_t* pixel) {
+    noise_to_grayscale(noise, pixel);
+}
+
+static void pixel_rgb(double noise, uint8_t* pixel) {
+    noise_to_rgb(noise, &pixel[0], &pixel[1], &pixel[2]);
+}
+
+static void pixel_heightmap(double noise, uint8_t* pixel) {
+    noise_to_heightmap(noise, &pixel[0], &pixel[1], &pixel[2]);
+}
 
-            if (config->octaves > 1) {
-                // Fractal noise
-                noise_value = simplex_fractal_2d(noise_x, noise_y, config->octaves,
-                                                 config->persistence, config->lacunarity);
+static void pixel_terrain(double noise, uint8_t* pixel) {
+    noise_to_terrain(noise, &pixel[0], &pixel[1], &pixel[2]);
+}
+
+// Tile writers specialized per color mode, so nothing is dispatched per pixel
+#define DEFINE_TILE_WRITER(name, channels, convert)                                     \
+    static void name(const double* samples, int count, const pixel_norm_t* norm,       \
+                     uint8_t* pixels) {                                                \
+        for (int i = 0; i < count; i++) {                                              \
+            convert(normalize_sample(samples[i], norm), &pixels[(size_t)i * (channels)]); \
+        }                                                                              \
+    }
+
+DEFINE_TILE_WRITER(write_tile_grayscale, 1, pixel_grayscale)
+DEFINE_TILE_WRITER(write_tile_rgb, 3, pixel_rgb)
+DEFINE_TILE_WRITER(write_tile_heightmap, 3, pixel_heightmap)
+DEFINE_TILE_WRITER(write_tile_terrain, 3, pixel_terrain)
+
+// 16-bit samples: a normalized image spans 0-65535, raw noise maps -1..1 onto it
+static void write_tile_grayscale16(const double* samples, int count, const pixel_norm_t* norm,
+                                   uint8_t* pixels) {
+    for (int i = 0; i < count; i++) {
+        double value = normalize_sample(samples[i], norm);
+        value = norm->enabled ? value : (value + 1.0) * NORMALIZATION_FACTOR;
+        value = value < 0.0 ? 0.0 : (value > 1.0 ? 1.0 : value);
+        uint16_t sample = (uint16_t)((value * MAX_COLOR_VALUE_16) + 0.5);
+        pixels[2 * i] = (uint8_t)(sample >> 8);
+        pixels[(2 * i) + 1] = (uint8_t)sample;
+    }
+}
+
+// Normalized samples as native floats: 0-1 for normalized images, raw noise otherwise
+static void write_tile_heights(const double* samples, int count, const pixel_norm_t* norm,
+                               uint8_t* pixels) {
+    for (int i = 0; i < count; i++) {
+        float height = (float)normalize_sample(samples[i], norm);
+        memcpy(&pixels[(size_t)i * sizeof(float)], &height, sizeof(height));
+    }
+}
+
+static const tile_writer_fn tile_writers[SIMPLEX_COLOR_COUNT] = {
+    write_tile_grayscale,  /* SIMPLEX_COLOR_GRAYSCALE */
+    write_tile_rgb,        /* SIMPLEX_COLOR_RGB */
+    write_tile_rgb,        /* SIMPLEX_COLOR_RGBA */
+    write_tile_heightmap,  /* SIMPLEX_COLOR_HEIGHTMAP */
+    write_tile_terrain,    /* SIMPLEX_COLOR_TERRAIN */
+    write_tile_grayscale16 /* SIMPLEX_COLOR_GRAYSCALE16 */
+};
+
+// Widen [min_val, max_val] to cover data
+static void update_range(const double* data, size_t count, double* min_val, double* max_val) {
+    for (size_t i = 0; i < count; i++) {
+        if (data[i] < *min_val) {
+            *min_val = data[i];
+        }
+        if (data[i] > *max_val) {
+            *max_val = data[i];
+        }
+    }
+}
+
+// Noise for `count` samples of full image row y, starting at full image column x0
+static void generate_tile(double* samples, const image_band_t* band, int x0, int y, int count) {
+    const simplex_image_config_t* config = band->config;
+    const image_source_t* source = band->source;
+    double x_start = (config->offset_x * config->scale) + (x0 * config->scale);
+    double y_start = (config->offset_y * config->scale) + (y * config->scale);
+
+    // image_channels() validated the arguments, so the array calls cannot fail
+    if (source->dims == 3) {
+        // 3D noise slice
+        simplex_noise_array_3d_ctx(band->ctx, x_start, y_start, source->z_start, count, 1, 1,
+                                   config->scale, samples);
+    } else if (source->warp) {
+        // Warp fields of the whole tile, then the base fBm at the warped points
+        simplex_domain_warp_array_2d_ctx(band->ctx, x_start, y_start, count, 1, config->scale,
+                                         config->octaves, config->persistence,
+                                         config->lacunarity, source->warp, samples);
+    } else if (config->octaves > 1) {
+        // Fractal noise, one octave over a whole tile at a time
+        simplex_fractal_array_2d_ctx(band->ctx, x_start, y_start, count, 1, config->scale,
+                                     config->octaves, config->persistence, config->lacunarity,
+                                     samples);
+    } else {
+        // Simple 2D noise
+        simplex_noise_array_2d_ctx(band->ctx, x_start, y_start, count, 1, config->scale,
+                                   samples);
+    }
+}
+
+/* Band rows [begin, end): generate and measure, generate and colorize, or
+ * colorize kept samples. Tiles are cut at multiples of IMAGE_TILE_SAMPLES of
+ * the full image, so an image tile starting on one makes the same array calls
+ * as the whole image. */
+static void render_band_rows(void* arg, int begin, int end) {
+    const image_band_t* band = arg;
+    int width = band->config->width;
+    int first = band->source->x0;
+    int generate = !band->kept && !band->bulk;
+    double scratch[IMAGE_TILE_SAMPLES];
+
+    for (int y = begin; y < end; y++) {
+        double min_val = INFINITY;
+        double max_val = -INFINITY;
+        for (int x0 = first; x0 < first + width;) {
+            int next = ((x0 / IMAGE_TILE_SAMPLES) + 1) * IMAGE_TILE_SAMPLES;
+            int count = (next < first + width ? next : first + width) - x0;
+            size_t index = ((size_t)y * width) + (x0 - first);
+            double* tile = band->samples ? band->samples + index : scratch;
+            if (generate) {
+                generate_tile(tile, band, x0, band->source->y0 + band->y0 + y, count);
+            }
+            if (band->pixels) {
+                band->write_tile(tile, count, &band->norm, band->pixels + (index * band->channels));
             } else {
-                // Simple 2D noise
-                noise_value = simplex_noise_2d(noise_x, noise_y);
+                update_range(tile, (size_t)count, &min_val, &max_val);
             }
+            x0 += count;
+        }
+        if (!band->pixels) {
+            band->row_min[y] = min_val;
+            band->row_max[y] = max_val;
+        }
+    }
+}
 
-            data[(y * width) + x] = noise_value;
+// Noise for band rows [0, rows) in one array call, large enough for the context to offload
+static void generate_band(const image_band_t* band, int rows) {
+    const simplex_image_config_t* config = band->config;
+    const image_source_t* source = band->source;
+    double x_start = (config->offset_x * config->scale) + (source->x0 * config->scale);
+    double y_start =
+        (config->offset_y * config->scale) + ((source->y0 + band->y0) * config->scale);
+
+    if (source->dims == 3) {
+        simplex_noise_array_3d_ctx(band->ctx, x_start, y_start, source->z_start, config->width,
+                                   rows, 1, config->scale, band->samples);
+    } else if (source->warp) {
+        simplex_domain_warp_array_2d_ctx(band->ctx, x_start, y_start, config->width, rows,
+                                         config->scale, config->octaves, config->persistence,
+                                         config->lacunarity, source->warp, band->samples);
+    } else if (config->octaves > 1) {
+        simplex_fractal_array_2d_ctx(band->ctx, x_start, y_start, config->width, rows,
+                                     config->scale, config->octaves, config->persistence,
+                                     config->lacunarity, band->samples);
+    } else {
+        simplex_noise_array_2d_ctx(band->ctx, x_start, y_start, config->width, rows,
+                                   config->scale, band->samples);
+    }
+}
+
+// Run `rows` rows of a band with the noise configuration's max_threads and chunk_size
+static void run_band(image_band_t* band, int rows, const simplex_config_t* noise_config) {
+    if (band->bulk && !band->kept) {
+        generate_band(band, rows);
+    }
+    int chunk_size =
+        noise_config->chunk_size > 0 ? noise_config->chunk_size : IMAGE_DEFAULT_CHUNK_SIZE;
+    int rows_per_task = chunk_size / band->config->width;
+    if (rows_per_task < 1) {
+        rows_per_task = 1;
+    }
+    simplex_parallel_for(rows, rows_per_task, noise_config->max_threads, render_band_rows, band);
+}
+
+// Range of the whole image, measured `rows` rows at a time
+static void measure_range(image_band_t* band, const simplex_config_t* noise_config, int rows,
+                          double* min_val, double* max_val) {
+    int height = band->config->height;
+    uint8_t* pixels = band->pixels;
+    *min_val = INFINITY;
+    *max_val = -INFINITY;
+    band->pixels = NULL;
+    for (int y = 0; y < height; y += rows) {
+        int count = rows < height - y ? rows : height - y;
+        band->y0 = y;
+        run_band(band, count, noise_config);
+        for (int r = 0; r < count; r++) {
+            *min_val = band->row_min[r] < *min_val ? band->row_min[r] : *min_val;
+            *max_val = band->row_max[r] > *max_val ? band->row_max[r] : *max_val;
         }
     }
+    band->pixels = pixels;
+}
+
+// Set the band's normalization, measuring the image `rows` rows at a time if it is exact
+static void measure_image(image_band_t* band, const simplex_config_t* noise_config, int rows) {
+    const simplex_image_config_t* config = band->config;
+
+    set_pixel_norm(&band->norm, 0.0, 0.0, 0);
+    band->kept = 0;
+    if (config->auto_normalize == SIMPLEX_NORMALIZE_BOUNDED) {
+        set_pixel_norm(&band->norm, config->min_value, config->max_value, 1);
+    } else if (config->auto_normalize != SIMPLEX_NORMALIZE_NONE) {
+        // Exact normalization measures the whole image before the first pixel
+        double min_val;
+        double max_val;
+        measure_range(band, noise_config, rows, &min_val, &max_val);
+        band->kept = band->samples && rows >= config->height;
+        set_pixel_norm(&band->norm, min_val, max_val, 0);
+    }
+}
+
+// Normalize, colorize and write the image `rows` rows at a time
+static int stream_image(image_sink_t* sink, image_band_t* band,
+                        const simplex_config_t* noise_config, int rows) {
+    const simplex_image_config_t* config = band->config;
+    int width = config->width;
+    int height = config->height;
+    uint8_t* staging = band->pixels;
+
+    measure_image(band, noise_config, rows);
+    if (begin_image(sink, config, config->color_mode, noise_config->max_threads) != 0) {
+        return -1;
+    }
+    int result = 0;
+    for (int y = 0; result == 0 && y < height; y += rows) {
+        int count = rows < height - y ? rows : height - y;
+        size_t bytes = (size_t)count * width * band->channels;
+        // Buffer sinks are colorized in place, other sinks get a staged copy
+        uint8_t* direct = sink_reserve(sink, bytes);
+        band->pixels = direct ? direct : staging;
+        if (!band->pixels) {
+            result = -1;
+            break;
+        }
+        band->y0 = y;
+        run_band(band, count, noise_config);
+        if (!direct && write_pixels(sink, staging, count, bytes / count) != 0) {
+            result = -1;
+        }
+    }
+    band->pixels = staging;
+    if (end_image(sink) != 0) {
+        result = -1;
+    }
+    return result;
+}
+
+// Reseed, keeping the caller's other noise settings (SIMD, threads, memory limit)
+static int reseed_noise(const simplex_image_config_t* config, simplex_config_t* noise_config) {
+    simplex_context_get_config(NULL, noise_config);
+    noise_config->seed = config->seed;
+    return simplex_noise_init_advanced(noise_config);
+}
+
+// Channels per pixel of a valid image request, -1 if the request is invalid
+static int image_channels(const simplex_image_config_t* config) {
+    if (!config || config->width <= 0 || config->height <= 0 ||
+        (unsigned int)config->format >= SIMPLEX_IMAGE_COUNT ||
+        (unsigned int)config->color_mode >= SIMPLEX_COLOR_COUNT) {
+        return -1;
+    }
+    if (config->format == SIMPLEX_IMAGE_PGM && !is_grayscale(config->color_mode)) {
+        return -1;
+    }
+    return color_mode_channels(config->color_mode);
+}
 
+// Exact normalization needs a measuring pass over the whole image
+static int exact_normalize(const simplex_image_config_t* config) {
+    return config->auto_normalize != SIMPLEX_NORMALIZE_NONE &&
+           config->auto_normalize != SIMPLEX_NORMALIZE_BOUNDED;
+}
+
+/* Work buffers come from the configuration's arena when it has one, laid out
+ * in its block and kept there for the next call, and from malloc otherwise */
+
+#define BUFFER_COUNT(sizes) ((int)(sizeof(sizes) / sizeof((sizes)[0])))
+
+// Buffers of sizes[i] bytes, NULL for a size of 0; -1 if any allocation fails
+static int alloc_buffers(simplex_arena_t* arena, const size_t* sizes, void** buffers, int count) {
+    if (arena) {
+        return simplex_arena_carve(arena, sizes, buffers, count);
+    }
+    int allocated = 1;
+    for (int i = 0; i < count; i++) {
+        buffers[i] = sizes[i] > 0 ? malloc(sizes[i]) : NULL;
+        allocated &= sizes[i] == 0 || buffers[i] != NULL;
+    }
+    if (!allocated) {
+        for (int i = 0; i < count; i++) {
+            free(buffers[i]);
+        }
+        return -1;
+    }
     return 0;
 }
 
-// Normalize data to 0-1 range
-static void normalize_noise_data(double* data, int count, int auto_normalize) {
-    if (!auto_normalize) {
-        return;
+// Free buffers from alloc_buffers(); arena buffers stay in their arena
+static void free_buffers(simplex_arena_t* arena, void** buffers, int count) {
+    for (int i = 0; !arena && i < count; i++) {
+        free(buffers[i]);
     }
-    double min_val = data[0];
-    double max_val = data[0];
+}
+
+// Render one image from ctx into a sink, in bands bounded by memory_limit_mb
+static int render_to_sink(const simplex_image_config_t* config, const image_source_t* source,
+                          const simplex_context_t* ctx, const simplex_config_t* noise_config,
+                          image_sink_t* sink) {
+    int channels = sink->heights ? (int)sizeof(float) : color_mode_channels(config->color_mode);
+
+    /* Bytes per row: pixels unless they go straight into a caller buffer, PNG's
+     * filtered and compressed copies, the row's range for exact normalization,
+     * and its samples if they are kept between the measuring and colorizing pass
+     * or, for offloaded contexts, generated a band at a time */
+    int exact = exact_normalize(config);
+    int png = config->format == SIMPLEX_IMAGE_PNG;
+    int staged = sink->buffer == NULL || png;
+    int bulk = ctx->gpu != NULL;
+    double limit = noise_config->memory_limit_mb * 1024.0 * 1024.0;
+    double sample_row = (double)config->width * sizeof(double);
+    double pixel_row = (staged ? (double)config->width * channels : 0.0) +
+                       (png ? 2.0 * (((double)config->width * channels) + 1) : 0.0) +
+                       (exact ? 2 * sizeof(double) : 0) + (bulk ? sample_row : 0.0);
+    int retain = exact && limit >= config->height * (pixel_row + (bulk ? 0.0 : sample_row));
+    double fit = pixel_row > 0 ? floor(limit / pixel_row) : config->height;
+    int rows = retain || fit >= config->height ? config->height : (fit >= 1.0 ? (int)fit : 1);
+
+    image_band_t band = {.config = config,
+                         .ctx = ctx,
+                         .source = source,
+                         .bulk = bulk,
+                         .write_tile = sink->heights ? write_tile_heights
+                                                     : tile_writers[config->color_mode],
+                         .channels = channels};
+    size_t band_samples = (size_t)rows * config->width;
+    size_t sizes[] = {staged ? band_samples * channels : 0,
+                      retain || bulk ? band_samples * sizeof(double) : 0,
+                      exact ? rows * sizeof(double) : 0, exact ? rows * sizeof(double) : 0};
+    void* buffers[BUFFER_COUNT(sizes)];
+    if (alloc_buffers(config->arena, sizes, buffers, BUFFER_COUNT(sizes)) != 0) {
+        return -1;
+    }
+    band.pixels = buffers[0];
+    band.samples = buffers[1];
+    band.row_min = buffers[2];
+    band.row_max = buffers[3];
+
+    int result = stream_image(sink, &band, noise_config, rows);
+    free_buffers(config->arena, buffers, BUFFER_COUNT(buffers));
+    return result;
+}
 
-    // Find min/max
-    for (int i = 1; i < count; i++) {
-        if (data[i] < min_val) {
-        min_val = data[i];
+// Render one image from ctx into its file
+static int write_image_file(const simplex_image_config_t* config, const image_source_t* source,
+                            const simplex_context_t* ctx, const simplex_config_t* noise_config) {
+    image_sink_t sink = {.file = fopen(config->filename, "wb")};
+    if (!sink.file) {
+        return -1;
     }
-        if (data[i] > max_val) {
-        max_val = data[i];
+    int result = render_to_sink(config, source, ctx, noise_config, &sink);
+    if (fclose(sink.file) != 0) {
+        result = -1;
     }
+    return result;
+}
+
+// Whether a warped image's warp and base octaves can be evaluated
+static int warp_valid(const simplex_image_config_t* config, const simplex_warp_config_t* warp) {
+    return config->octaves > 0 && warp->levels >= 1 && warp->levels <= SIMPLEX_WARP_MAX_LEVELS &&
+           warp->octaves > 0;
+}
+
+/* Shared body of the image, slice, warped image and tile generators; a NULL
+ * sink writes config->filename */
+static int render_image(const simplex_image_config_t* config, const image_source_t* source,
+                        image_sink_t* sink) {
+    simplex_config_t noise_config;
+    if (image_channels(config) < 0 || (source->warp && !warp_valid(config, source->warp)) ||
+        reseed_noise(config, &noise_config) != 0) {
+        return -1;
     }
+    const simplex_context_t* ctx = simplex_context_resolve(NULL);
+    SIMPLEX_PROFILE_BEGIN(ctx);
+    int result = sink ? render_to_sink(config, source, ctx, &noise_config, sink)
+                      : write_image_file(config, source, ctx, &noise_config);
+    SIMPLEX_PROFILE_END(ctx, SIMPLEX_PROFILE_IMAGE,
+                        result == 0 ? (size_t)config->width * (size_t)config->height : 0);
+    return result;
+}
 
-    // Normalize to 0-1
-    double range = max_val - min_val;
-    if (range > 0) {
-        for (int i = 0; i < count; i++) {
-            data[i] = (data[i] - min_val) / range;
+int simplex_image_render_detached(const simplex_image_config_t* config, void* buffer,
+                                  size_t capacity, size_t* size) {
+    simplex_config_t noise_config;
+    if (image_channels(config) < 0 || simplex_context_get_config(NULL, &noise_config) != 0) {
+        return -1;
+    }
+    size_t required = simplex_image_encoded_size(config);
+    if (buffer && capacity < required) {
+        return -1;
+    }
+    noise_config.seed = config->seed;
+    simplex_context_t* ctx = simplex_context_create(&noise_config);
+    if (!ctx) {
+        return -1;
+    }
+    image_source_t source = {.dims = 2};
+    image_sink_t sink = {.buffer = buffer, .capacity = capacity};
+    const simplex_context_t* profiled = simplex_context_resolve(NULL);
+    SIMPLEX_PROFILE_BEGIN(profiled);
+    int result = buffer ? render_to_sink(config, &source, ctx, &noise_config, &sink)
+                        : write_image_file(config, &source, ctx, &noise_config);
+    SIMPLEX_PROFILE_END(profiled, SIMPLEX_PROFILE_IMAGE,
+                        result == 0 ? (size_t)config->width * (size_t)config->height : 0);
+    simplex_context_destroy(ctx);
+    if (result == 0 && buffer && size) {
+        *size = sink.size;
+    }
+    return result;
+}
+
+// Tangent-space normals of `count` slopes, scaled to height units per pixel
+static void write_normals(const double* gradient, size_t count, double slope_scale,
+                          uint8_t* pixels) {
+    for (size_t i = 0; i < count; i++) {
+        double nx = -gradient[2 * i] * slope_scale;
+        double ny = -gradient[(2 * i) + 1] * slope_scale;
+        double inverse_length = 1.0 / sqrt((nx * nx) + (ny * ny) + 1.0);
+        pixels[3 * i] = (uint8_t)(((nx * inverse_length) + 1.0) * PIXEL_SCALE_FACTOR);
+        pixels[(3 * i) + 1] = (uint8_t)(((ny * inverse_length) + 1.0) * PIXEL_SCALE_FACTOR);
+        pixels[(3 * i) + 2] = (uint8_t)((inverse_length + 1.0) * PIXEL_SCALE_FACTOR);
+    }
+}
+
+// Normal map body; rows are streamed in bands bounded by memory_limit_mb
+static int render_normal_map(const simplex_image_config_t* config, double strength,
+                             const simplex_config_t* noise_config) {
+    int width = config->width;
+    int height = config->height;
+    double row_bytes = (double)width * (3 + (2 * sizeof(double)));
+    double fit = floor(noise_config->memory_limit_mb * 1024.0 * 1024.0 / row_bytes);
+    int rows = fit >= height ? height : (fit >= 1.0 ? (int)fit : 1);
+    size_t band_samples = (size_t)rows * width;
+    size_t sizes[] = {band_samples * 2 * sizeof(double), band_samples * 3};
+    void* buffers[BUFFER_COUNT(sizes)];
+    if (alloc_buffers(config->arena, sizes, buffers, BUFFER_COUNT(sizes)) != 0) {
+        return -1;
+    }
+    double* gradient = buffers[0];
+    uint8_t* pixels = buffers[1];
+    image_sink_t sink = {.file = fopen(config->filename, "wb")};
+
+    int result =
+        sink.file ? begin_image(&sink, config, SIMPLEX_COLOR_RGB, noise_config->max_threads) : -1;
+    double x_start = config->offset_x * config->scale;
+    for (int y = 0; result == 0 && y < height; y += rows) {
+        int count = rows < height - y ? rows : height - y;
+        size_t samples = (size_t)count * width;
+        double y_start = (config->offset_y * config->scale) + (y * config->scale);
+        if (config->octaves > 1) {
+            result = simplex_fbm_array_2d_deriv(x_start, y_start, width, count, config->scale,
+                                                config->octaves, config->persistence,
+                                                config->lacunarity, NULL, gradient);
+        } else {
+            result = simplex_noise_array_2d_deriv(x_start, y_start, width, count,
+                                                  config->scale, NULL, gradient);
+        }
+        if (result == 0) {
+            write_normals(gradient, samples, strength * config->scale, pixels);
+            result = write_pixels(&sink, pixels, count, (size_t)width * 3);
         }
     }
+    if (end_image(&sink) != 0) {
+        result = -1;
+    }
+    if (sink.file && fclose(sink.file) != 0) {
+        result = -1;
+    }
+    free_buffers(config->arena, buffers, BUFFER_COUNT(buffers));
+    return result;
 }
 
-// Convert noise data to pixels
-static int convert_to_pixels(const double* noise_data, uint8_t* pixels, int width, int height,
-                             simplex_color_mode_t color_mode) {
-    int channels =
-        (color_mode == SIMPLEX_COLOR_GRAYSCALE || color_mode == SIMPLEX_COLOR_HEIGHTMAP) ? 1 : 3;
+/* ===== TILED RENDERING ===== */
+
+/* A tile is rendered as an image of its own size, drawn from the full image's
+ * pixels through image_source_t's origin, and encoded as RAW rows. */
+
+// Configuration and source of a tile of the full image, -1 if the request is invalid
+static int tile_config(const simplex_image_config_t* config, const simplex_image_tile_t* tile,
+                       simplex_image_config_t* part, image_source_t* source) {
+    if (image_channels(config) < 0 || !tile || config->format == SIMPLEX_IMAGE_PNG ||
+        exact_normalize(config) || tile->tile_width <= 0 || tile->tile_height <= 0 ||
+        tile->column < 0 || tile->row < 0 ||
+        tile->column > (config->width - 1) / tile->tile_width ||
+        tile->row > (config->height - 1) / tile->tile_height) {
+        return -1;
+    }
+    *source = (image_source_t){.dims = 2,
+                               .x0 = tile->column * tile->tile_width,
+                               .y0 = tile->row * tile->tile_height};
+    *part = *config;
+    part->width = config->width - source->x0 < tile->tile_width ? config->width - source->x0
+                                                                : tile->tile_width;
+    part->height = config->height - source->y0 < tile->tile_height ? config->height - source->y0
+                                                                   : tile->tile_height;
+    part->format = SIMPLEX_IMAGE_RAW;
+    return 0;
+}
 
+// Header of the full image that starts tile (0, 0); returns its length, 0 for other tiles
+static size_t tile_header(char* header, const simplex_image_config_t* config,
+                          const image_source_t* source) {
+    if (source->x0 != 0 || source->y0 != 0) {
+        return 0;
+    }
+    return format_image_header(header, config->format, config->width, config->height,
+                               config->color_mode);
+}
+
+// Render a tile into a sink
+static int render_tile(const simplex_image_config_t* config, const simplex_image_tile_t* tile,
+                       image_sink_t* sink) {
+    simplex_image_config_t part;
+    image_source_t source;
+    if (tile_config(config, tile, &part, &source) != 0) {
+        return -1;
+    }
+    char header[IMAGE_HEADER_MAX];
+    if (sink_write(sink, header, tile_header(header, config, &source)) != 0) {
+        return -1;
+    }
+    return render_image(&part, &source, sink);
+}
+
+// Close the tile files of one tile row
+static int close_tiles(FILE** tiles, int columns) {
+    int result = 0;
+    for (int c = 0; c < columns; c++) {
+        if (tiles[c] && fclose(tiles[c]) != 0) {
+            result = -1;
+        }
+        tiles[c] = NULL;
+    }
+    return result;
+}
+
+/* Copy one row of tiles into the full image, an image row at a time; every
+ * tile file must hold exactly the bytes its tile encodes to */
+static int assemble_tile_row(FILE* out, FILE** tiles, const simplex_image_config_t* config,
+                             int tile_width, int height, uint8_t* row) {
+    int channels = color_mode_channels(config->color_mode);
+    int columns = ((config->width - 1) / tile_width) + 1;
+    size_t row_bytes = (size_t)config->width * channels;
     for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            double noise = noise_data[y * width + x];
-            int pixel_index = (y * width + x) * channels;
-
-            switch (color_mode) {
-            case SIMPLEX_COLOR_GRAYSCALE:
-                noise_to_grayscale(noise, &pixels[pixel_index]);
-                break;
-
-            case SIMPLEX_COLOR_RGB:
-            case SIMPLEX_COLOR_RGBA:
-                noise_to_rgb(noise, &pixels[pixel_index], &pixels[pixel_index + 1],
-                             &pixels[pixel_index + 2]);
-                break;
-
-            case SIMPLEX_COLOR_HEIGHTMAP:
-                noise_to_heightmap(noise, &pixels[pixel_index], &pixels[pixel_index + 1],
-                                   &pixels[pixel_index + 2]);
-                break;
-
-            case SIMPLEX_COLOR_TERRAIN:
-                noise_to_terrain(noise, &pixels[pixel_index], &pixels[pixel_index + 1],
-                                 &pixels[pixel_index + 2]);
-                break;
-
-            default:
-                noise_to_grayscale(noise, &pixels[pixel_index]);
-                break;
+        for (int c = 0; c < columns; c++) {
+            int x0 = c * tile_width;
+            int width = config->width - x0 < tile_width ? config->width - x0 : tile_width;
+            size_t bytes = (size_t)width * channels;
+            if (fread(row + ((size_t)x0 * channels), 1, bytes, tiles[c]) != bytes) {
+                return -1;
             }
         }
+        if (fwrite(row, 1, row_bytes, out) != row_bytes) {
+            return -1;
+        }
+    }
+    for (int c = 0; c < columns; c++) {
+        if (fgetc(tiles[c]) != EOF) {
+            return -1;
+        }
     }
-
     return 0;
 }
 
+/* ===== BATCH PIPELINE ===== */
+
+/*
+ * Series and animations render whole frames in waves: each pool task of a wave
+ * renders one frame into a slot of one slot set, while one more task writes the
+ * frames the previous wave left in the other set, so encoding and file I/O
+ * overlap generation. The slots are allocated once and reused by every wave.
+ * Frames with the same seed share one context, so each permutation table is
+ * built once per batch and the default context is left alone. When fewer than
+ * two frames fit in memory_limit_mb per slot set, or max_threads is 1, frames
+ * are streamed one at a time instead.
+ */
+
+// One frame of a batch
+typedef struct {
+    simplex_image_config_t config; /* Frame settings, including its file name */
+    double z_start;
+    const simplex_context_t* ctx; /* Shared by every frame with the frame's seed */
+} batch_frame_t;
+
+// Context built for one seed of a batch
+typedef struct {
+    uint32_t seed;
+    simplex_context_t* ctx;
+} batch_seed_t;
+
+// Whole-frame buffers, reused by every wave
+typedef struct {
+    uint8_t* pixels;
+    double* samples; /* Kept between passes, NULL to generate twice */
+    double* row_min;
+    double* row_max;
+    int frame; /* Frame waiting to be written, -1 if none */
+} frame_slot_t;
+
+// One wave of the pipeline handed to the thread pool
+typedef struct {
+    const batch_frame_t* frames;
+    const simplex_config_t* noise_config;
+    int dims;
+    frame_slot_t* rendering; /* Slots this wave fills */
+    frame_slot_t* writing;   /* Slots the previous wave filled */
+    int slots;
+    int first;  /* First frame rendered by this wave */
+    int failed; /* Set by the writing task on I/O errors */
+} frame_wave_t;
+
+// Render a whole frame into a slot; its rows run inline on the calling task
+static void render_frame(const frame_wave_t* wave, int frame, frame_slot_t* slot) {
+    const batch_frame_t* job = &wave->frames[frame];
+    image_source_t source = {.dims = wave->dims, .z_start = job->z_start};
+    image_band_t band = {.config = &job->config,
+                         .ctx = job->ctx,
+                         .source = &source,
+                         .samples = slot->samples,
+                         .pixels = slot->pixels,
+                         .row_min = slot->row_min,
+                         .row_max = slot->row_max,
+                         .write_tile = tile_writers[job->config.color_mode],
+                         .channels = color_mode_channels(job->config.color_mode)};
+    measure_image(&band, wave->noise_config, job->config.height);
+    band.y0 = 0;
+    run_band(&band, job->config.height, wave->noise_config);
+    slot->frame = frame;
+}
+
+// Write a rendered frame's header and pixels to its file
+static int write_frame(const batch_frame_t* job, const frame_slot_t* slot) {
+    const simplex_image_config_t* config = &job->config;
+    size_t row_bytes = (size_t)config->width * color_mode_channels(config->color_mode);
+    image_sink_t sink = {.file = fopen(config->filename, "wb")};
+    if (!sink.file) {
+        return -1;
+    }
+    // The writer runs inside a wave, so a PNG is compressed on this thread
+    int result = begin_image(&sink, config, config->color_mode, 1);
+    if (result == 0) {
+        result = write_pixels(&sink, slot->pixels, config->height, row_bytes);
+    }
+    if (end_image(&sink) != 0) {
+        result = -1;
+    }
+    if (fclose(sink.file) != 0) {
+        result = -1;
+    }
+    return result;
+}
+
+// Item 0 writes the previous wave's frames; item i renders frame first + i - 1
+static void run_wave_items(void* arg, int begin, int end) {
+    frame_wave_t* wave = arg;
+    for (int item = begin; item < end; item++) {
+        if (item > 0) {
+            render_frame(wave, wave->first + item - 1, &wave->rendering[item - 1]);
+            continue;
+        }
+        for (int s = 0; s < wave->slots; s++) {
+            frame_slot_t* slot = &wave->writing[s];
+            if (slot->frame >= 0 && write_frame(&wave->frames[slot->frame], slot) != 0) {
+                wave->failed = 1;
+            }
+            slot->frame = -1;
+        }
+    }
+}
+
+// Slot 0 holds the start of each shared buffer
+static void free_slots(frame_slot_t* slots, simplex_arena_t* arena) {
+    void* buffers[] = {slots[0].pixels, slots[0].samples, slots[0].row_min, slots[0].row_max};
+    free_buffers(arena, buffers, BUFFER_COUNT(buffers));
+    free(slots);
+}
+
+// Slot i's share of a buffer split into strides, NULL if the buffer is unused
+static void* slot_share(void* buffer, size_t stride, int i) {
+    return buffer ? (unsigned char*)buffer + (stride * i) : NULL;
+}
+
+/* `count` empty slots sized for frames like config, NULL if out of memory. The
+ * slots split one buffer of each kind, every share starting aligned. */
+static frame_slot_t* alloc_slots(int count, const simplex_image_config_t* config, int retain) {
+    frame_slot_t* slots = calloc((size_t)count, sizeof(*slots));
+    if (!slots) {
+        return NULL;
+    }
+    size_t samples = (size_t)config->width * config->height;
+    size_t range = exact_normalize(config) ? config->height * sizeof(double) : 0;
+    size_t strides[] = {samples * color_mode_channels(config->color_mode),
+                        retain ? samples * sizeof(double) : 0, range, range};
+    size_t sizes[BUFFER_COUNT(strides)];
+    void* buffers[BUFFER_COUNT(strides)];
+    for (int k = 0; k < BUFFER_COUNT(strides); k++) {
+        strides[k] = (strides[k] + SIMPLEX_ARENA_ALIGNMENT - 1) &
+                     ~(size_t)(SIMPLEX_ARENA_ALIGNMENT - 1);
+        sizes[k] = strides[k] * count;
+    }
+    if (alloc_buffers(config->arena, sizes, buffers, BUFFER_COUNT(sizes)) != 0) {
+        free(slots);
+        return NULL;
+    }
+    for (int i = 0; i < count; i++) {
+        slots[i].frame = -1;
+        slots[i].pixels = slot_share(buffers[0], strides[0], i);
+        slots[i].samples = slot_share(buffers[1], strides[1], i);
+        slots[i].row_min = slot_share(buffers[2], strides[2], i);
+        slots[i].row_max = slot_share(buffers[3], strides[3], i);
+    }
+    return slots;
+}
+
+// Render and write every frame; all frames share the size and color mode of the first
+static int render_frames(const batch_frame_t* frames, int count, int dims,
+                         const simplex_config_t* noise_config) {
+    const simplex_image_config_t* config = &frames[0].config;
+    double pixel_bytes = (double)config->width * config->height *
+                         color_mode_channels(config->color_mode);
+    double range_bytes = exact_normalize(config) ? config->height * 2.0 * sizeof(double) : 0.0;
+    double sample_bytes = (double)config->width * config->height * sizeof(double);
+    double limit = noise_config->memory_limit_mb * 1024.0 * 1024.0;
+    double fit = floor(limit / (2.0 * (pixel_bytes + range_bytes)));
+    int slots = noise_config->max_threads < count ? noise_config->max_threads : count;
+    slots = fit < slots ? (int)fit : slots;
+
+    if (slots < 2) {
+        for (int i = 0; i < count; i++) {
+            image_source_t source = {.dims = dims, .z_start = frames[i].z_start};
+            if (write_image_file(&frames[i].config, &source, frames[i].ctx, noise_config) != 0) {
+                return -1;
+            }
+        }
+        return 0;
+    }
+
+    int retain = exact_normalize(config) &&
+                 limit >= 2.0 * slots * (pixel_bytes + range_bytes + sample_bytes);
+    frame_slot_t* buffers = alloc_slots(2 * slots, config, retain);
+    if (!buffers) {
+        return -1;
+    }
+    frame_wave_t wave = {.frames = frames,
+                         .noise_config = noise_config,
+                         .dims = dims,
+                         .rendering = buffers,
+                         .writing = buffers + slots,
+                         .slots = slots};
+    // The wave after the last frame only writes
+    for (int first = 0; !wave.failed; first += slots) {
+        int rendered = first < count ? (count - first < slots ? count - first : slots) : 0;
+        wave.first = first;
+        simplex_parallel_for(rendered + 1, 1, noise_config->max_threads, run_wave_items, &wave);
+        frame_slot_t* filled = wave.rendering;
+        wave.rendering = wave.writing;
+        wave.writing = filled;
+        if (rendered == 0) {
+            break;
+        }
+    }
+    free_slots(buffers, config->arena);
+    return wave.failed ? -1 : 0;
+}
+
+// Validate and seed a batch, then render it as one profiled image call
+static int run_batch(batch_frame_t* frames, int count, int dims) {
+    simplex_config_t noise_config;
+    if (count <= 0) {
+        return -1;
+    }
+    for (int i = 0; i < count; i++) {
+        if (image_channels(&frames[i].config) < 0) {
+            return -1;
+        }
+    }
+    if (simplex_context_get_config(NULL, &noise_config) != 0) {
+        return -1;
+    }
+
+    batch_seed_t* seeds = calloc((size_t)count, sizeof(*seeds));
+    int seed_count = 0;
+    int result = seeds ? 0 : -1;
+    for (int i = 0; result == 0 && i < count; i++) {
+        int s = 0;
+        while (s < seed_count && seeds[s].seed != frames[i].config.seed) {
+            s++;
+        }
+        if (s == seed_count) {
+            simplex_config_t seed_config = noise_config;
+            seed_config.seed = frames[i].config.seed;
+            seeds[s].seed = seed_config.seed;
+            seeds[s].ctx = simplex_context_create(&seed_config);
+            result = seeds[s].ctx ? 0 : -1;
+            seed_count++;
+        }
+        frames[i].ctx = seeds[s].ctx;
+    }
+
+    const simplex_context_t* ctx = simplex_context_resolve(NULL);
+    SIMPLEX_PROFILE_BEGIN(ctx);
+    if (result == 0) {
+        result = render_frames(frames, count, dims, &noise_config);
+    }
+    SIMPLEX_PROFILE_END(ctx, SIMPLEX_PROFILE_IMAGE,
+                        result == 0 ? (size_t)count * frames[0].config.width *
+                                          (size_t)frames[0].config.height
+                                    : 0);
+    for (int s = 0; s < seed_count; s++) {
+        simplex_context_destroy(seeds[s].ctx);
+    }
+    free(seeds);
+    return result;
+}
+
 /* ===== PUBLIC FUNCTIONS ===== */
 
 simplex_image_config_t simplex_get_default_image_config(void) {
@@ -275,6 +1152,8 @@ simplex_image_config_t simplex_get_default_image_config(void) {
     config.auto_normalize = 1;
     config.seed = 12345;
     strcpy(config.filename, "simplex_noise.ppm");
+    config.png_compression = 6;
+    config.png_filter = SIMPLEX_PNG_FILTER_UP;
     return config;
 }
 
@@ -337,147 +1216,271 @@ void simplex_noise_to_terrain(double noise_value, uint8_t* r, uint8_t* g, uint8_
 }
 
 int simplex_generate_2d_image(const simplex_image_config_t* config) {
+    image_source_t source = {.dims = 2};
+    return render_image(config, &source, NULL);
+}
+
+int simplex_generate_3d_image(const simplex_image_config_t* config, double z_slice) {
     if (!config) {
         return -1;
     }
-    // Initialize noise
-    simplex_noise_init(config->seed);
+    image_source_t source = {.dims = 3, .z_start = (z_slice + config->offset_z) * config->scale};
+    return render_image(config, &source, NULL);
+}
 
-    // Allocate memory
-    double* noise_data = malloc(config->width * config->height * sizeof(double));
-    if (!noise_data) {
-        return -1;
+size_t simplex_image_encoded_size(const simplex_image_config_t* config) {
+    int channels = image_channels(config);
+    if (channels < 0) {
+        return 0;
     }
-    // Generate noise
-    if (generate_noise_data(noise_data, config->width, config->height, config, 0.0) != 0) {
-        free(noise_data);
-        return -1;
+    if (config->format == SIMPLEX_IMAGE_PNG) {
+        return simplex_png_bound(config->width, config->height, channels);
     }
+    char header[IMAGE_HEADER_MAX];
+    return format_image_header(header, config->format, config->width, config->height,
+                               config->color_mode) +
+           ((size_t)config->width * (size_t)config->height * (size_t)channels);
+}
 
-    // Normalize if requested
-    if (config->auto_normalize) {
-        normalize_noise_data(noise_data, config->width * config->height, 1);
+// Render into a caller buffer; *size gets the size needed (a bound for PNG) or written
+static int render_buffer(const simplex_image_config_t* config, const image_source_t* source,
+                         void* buffer, size_t capacity, size_t* size) {
+    size_t required = simplex_image_encoded_size(config);
+    if (size) {
+        *size = required;
     }
-
-    // Convert to pixels
-    int channels = (config->color_mode == SIMPLEX_COLOR_GRAYSCALE) ? 1 : 3;
-    uint8_t* pixels = malloc(config->width * config->height * channels);
-    if (!pixels) {
-        free(noise_data);
+    if (required == 0 || !buffer || capacity < required) {
         return -1;
     }
+    image_sink_t sink = {.buffer = buffer, .capacity = capacity};
+    int result = render_image(config, source, &sink);
+    if (result == 0 && size) {
+        *size = sink.size;
+    }
+    return result;
+}
 
-    convert_to_pixels(noise_data, pixels, config->width, config->height, config->color_mode);
+int simplex_render_to_buffer(const simplex_image_config_t* config, void* buffer, size_t capacity,
+                             size_t* size) {
+    image_source_t source = {.dims = 2};
+    return render_buffer(config, &source, buffer, capacity, size);
+}
 
-    // Write file
-    FILE* file = fopen(config->filename, "wb");
-    if (!file) {
-        free(noise_data);
-        free(pixels);
+int simplex_render_heights_f32(const simplex_image_config_t* config, float* heights,
+                               size_t count) {
+    if (!config || !heights) {
         return -1;
     }
+    // Headerless, so the samples start the buffer; the colors are never written
+    simplex_image_config_t samples_config = *config;
+    samples_config.format = SIMPLEX_IMAGE_RAW;
+    samples_config.color_mode = SIMPLEX_COLOR_GRAYSCALE;
+    if (image_channels(&samples_config) < 0 ||
+        count < (size_t)config->width * (size_t)config->height) {
+        return -1;
+    }
+    image_source_t source = {.dims = 2};
+    image_sink_t sink = {.buffer = (uint8_t*)heights,
+                         .capacity = (size_t)config->width * config->height * sizeof(float),
+                         .heights = 1};
+    return render_image(&samples_config, &source, &sink);
+}
 
-    int result = 0;
-    switch (config->format) {
-    case SIMPLEX_IMAGE_PPM:
-        if (channels == 1) {
-            result = write_pgm_header(file, config->width, config->height, 255) > 0 &&
-                             write_pgm_pixels(file, pixels, config->width, config->height) == 0
-                         ? 0
-                         : -1;
-        } else {
-            result =
-                write_ppm_header(file, config->width, config->height, 255) > 0 &&
-                        write_ppm_pixels(file, pixels, config->width, config->height, channels) == 0
-                    ? 0
-                    : -1;
-        }
-        break;
+int simplex_render_3d_to_buffer(const simplex_image_config_t* config, double z_slice,
+                                void* buffer, size_t capacity, size_t* size) {
+    image_source_t source = {.dims = 3,
+                             .z_start = config ? (z_slice + config->offset_z) * config->scale
+                                               : 0.0};
+    return render_buffer(config, &source, buffer, capacity, size);
+}
 
-    case SIMPLEX_IMAGE_PNG:
-        result = write_png_simple(file, pixels, config->width, config->height, channels);
-        break;
+int simplex_render_to_stream(const simplex_image_config_t* config, simplex_image_write_fn write,
+                             void* user_data) {
+    if (!write) {
+        return -1;
+    }
+    image_source_t source = {.dims = 2};
+    image_sink_t sink = {.write = write, .user_data = user_data};
+    return render_image(config, &source, &sink);
+}
 
-    default:
-        result = -1;
-        break;
+int simplex_render_3d_to_stream(const simplex_image_config_t* config, double z_slice,
+                                simplex_image_write_fn write, void* user_data) {
+    if (!config || !write) {
+        return -1;
     }
+    image_source_t source = {.dims = 3, .z_start = (z_slice + config->offset_z) * config->scale};
+    image_sink_t sink = {.write = write, .user_data = user_data};
+    return render_image(config, &source, &sink);
+}
 
-    fclose(file);
-    free(noise_data);
-    free(pixels);
+int simplex_generate_warped_image(const simplex_image_config_t* config,
+                                  const simplex_warp_config_t* warp) {
+    simplex_warp_config_t defaults = simplex_get_default_warp_config();
+    image_source_t source = {.dims = 2, .warp = warp ? warp : &defaults};
+    return render_image(config, &source, NULL);
+}
 
-    return result;
+int simplex_render_warped_to_buffer(const simplex_image_config_t* config,
+                                    const simplex_warp_config_t* warp, void* buffer,
+                                    size_t capacity, size_t* size) {
+    simplex_warp_config_t defaults = simplex_get_default_warp_config();
+    image_source_t source = {.dims = 2, .warp = warp ? warp : &defaults};
+    return render_buffer(config, &source, buffer, capacity, size);
 }
 
-int simplex_generate_3d_image(const simplex_image_config_t* config, double z_slice) {
-    if (!config) {
+int simplex_render_warped_to_stream(const simplex_image_config_t* config,
+                                    const simplex_warp_config_t* warp,
+                                    simplex_image_write_fn write, void* user_data) {
+    if (!write) {
         return -1;
     }
-    // Initialize noise
-    simplex_noise_init(config->seed);
+    simplex_warp_config_t defaults = simplex_get_default_warp_config();
+    image_source_t source = {.dims = 2, .warp = warp ? warp : &defaults};
+    image_sink_t sink = {.write = write, .user_data = user_data};
+    return render_image(config, &source, &sink);
+}
 
-    // Allocate memory
-    double* noise_data = malloc(config->width * config->height * sizeof(double));
-    if (!noise_data) {
-        return -1;
+size_t simplex_image_tile_encoded_size(const simplex_image_config_t* config,
+                                       const simplex_image_tile_t* tile) {
+    simplex_image_config_t part;
+    image_source_t source;
+    if (tile_config(config, tile, &part, &source) != 0) {
+        return 0;
     }
-    // Generate 3D noise slice
-    for (int y = 0; y < config->height; y++) {
-        for (int x = 0; x < config->width; x++) {
-            double noise_x = (x + config->offset_x) * config->scale;
-            double noise_y = (y + config->offset_y) * config->scale;
-            double noise_z = (z_slice + config->offset_z) * config->scale;
+    char header[IMAGE_HEADER_MAX];
+    return tile_header(header, config, &source) +
+           ((size_t)part.width * (size_t)part.height * color_mode_channels(config->color_mode));
+}
 
-            double noise_value = simplex_noise_3d(noise_x, noise_y, noise_z);
-            noise_data[y * config->width + x] = noise_value;
-        }
+int simplex_generate_image_tile(const simplex_image_config_t* config,
+                                const simplex_image_tile_t* tile) {
+    // Validate before the file is created
+    if (simplex_image_tile_encoded_size(config, tile) == 0) {
+        return -1;
     }
-
-    // Normalize if requested
-    if (config->auto_normalize) {
-        normalize_noise_data(noise_data, config->width * config->height, 1);
+    image_sink_t sink = {.file = fopen(config->filename, "wb")};
+    if (!sink.file) {
+        return -1;
+    }
+    int result = render_tile(config, tile, &sink);
+    if (fclose(sink.file) != 0) {
+        result = -1;
     }
+    return result;
+}
 
-    // Convert to pixels
-    int channels = (config->color_mode == SIMPLEX_COLOR_GRAYSCALE) ? 1 : 3;
-    uint8_t* pixels = malloc(config->width * config->height * channels);
-    if (!pixels) {
-        free(noise_data);
+int simplex_render_tile_to_buffer(const simplex_image_config_t* config,
+                                  const simplex_image_tile_t* tile, void* buffer,
+                                  size_t capacity, size_t* size) {
+    size_t required = simplex_image_tile_encoded_size(config, tile);
+    if (size) {
+        *size = required;
+    }
+    if (required == 0 || !buffer || capacity < required) {
         return -1;
     }
+    image_sink_t sink = {.buffer = buffer, .capacity = capacity};
+    int result = render_tile(config, tile, &sink);
+    if (result == 0 && size) {
+        *size = sink.size;
+    }
+    return result;
+}
 
-    convert_to_pixels(noise_data, pixels, config->width, config->height, config->color_mode);
-
-    // Write file
-    FILE* file = fopen(config->filename, "wb");
-    if (!file) {
-        free(noise_data);
-        free(pixels);
+int simplex_render_tile_to_stream(const simplex_image_config_t* config,
+                                  const simplex_image_tile_t* tile,
+                                  simplex_image_write_fn write, void* user_data) {
+    if (!write) {
         return -1;
     }
+    image_sink_t sink = {.write = write, .user_data = user_data};
+    return render_tile(config, tile, &sink);
+}
 
-    int result = 0;
-    if (channels == 1) {
-        result = write_pgm_header(file, config->width, config->height, 255) > 0 &&
-                         write_pgm_pixels(file, pixels, config->width, config->height) == 0
-                     ? 0
-                     : -1;
-    } else {
-        result =
-            write_ppm_header(file, config->width, config->height, 255) > 0 &&
-                    write_ppm_pixels(file, pixels, config->width, config->height, channels) == 0
-                ? 0
-                : -1;
+int simplex_assemble_image_tiles(const simplex_image_config_t* config, int tile_width,
+                                 int tile_height, const char* const* tile_files) {
+    if (image_channels(config) < 0 || !tile_files || tile_width <= 0 || tile_height <= 0 ||
+        config->format == SIMPLEX_IMAGE_PNG) {
+        return -1;
+    }
+    int columns = ((config->width - 1) / tile_width) + 1;
+    int rows = ((config->height - 1) / tile_height) + 1;
+    char header[IMAGE_HEADER_MAX];
+    char tile_header_bytes[IMAGE_HEADER_MAX];
+    size_t header_length = format_image_header(header, config->format, config->width,
+                                               config->height, config->color_mode);
+    FILE** tiles = calloc((size_t)columns, sizeof(FILE*));
+    size_t sizes[] = {(size_t)config->width * color_mode_channels(config->color_mode)};
+    void* buffers[BUFFER_COUNT(sizes)] = {NULL};
+    int allocated = tiles && alloc_buffers(config->arena, sizes, buffers, BUFFER_COUNT(sizes)) == 0;
+    uint8_t* row = buffers[0];
+    FILE* out = allocated ? fopen(config->filename, "wb") : NULL;
+    int result = out && fwrite(header, 1, header_length, out) == header_length ? 0 : -1;
+
+    for (int r = 0; result == 0 && r < rows; r++) {
+        for (int c = 0; result == 0 && c < columns; c++) {
+            tiles[c] = fopen(tile_files[((size_t)r * columns) + c], "rb");
+            result = tiles[c] ? 0 : -1;
+        }
+        // Tile (0, 0) starts with the header already written
+        if (result == 0 && r == 0 &&
+            (fread(tile_header_bytes, 1, header_length, tiles[0]) != header_length ||
+             memcmp(tile_header_bytes, header, header_length) != 0)) {
+            result = -1;
+        }
+        int height = config->height - (r * tile_height) < tile_height
+                         ? config->height - (r * tile_height)
+                         : tile_height;
+        if (result == 0) {
+            result = assemble_tile_row(out, tiles, config, tile_width, height, row);
+        }
+        if (close_tiles(tiles, columns) != 0) {
+            result = -1;
+        }
+    }
+    if (out && fclose(out) != 0) {
+        result = -1;
+    }
+    free(tiles);
+    if (allocated) {
+        free_buffers(config->arena, buffers, BUFFER_COUNT(buffers));
     }
-
-    fclose(file);
-    free(noise_data);
-    free(pixels);
-
     return result;
 }
 
+int simplex_measure_image_range(const simplex_image_config_t* config, double* min_value,
+                                double* max_value) {
+    simplex_config_t noise_config;
+    if (!min_value || !max_value || image_channels(config) < 0 ||
+        reseed_noise(config, &noise_config) != 0) {
+        return -1;
+    }
+    const simplex_context_t* ctx = simplex_context_resolve(NULL);
+    image_source_t source = {.dims = 2};
+    image_band_t band = {.config = config, .ctx = ctx, .source = &source, .bulk = ctx->gpu != NULL};
+
+    // Each band row needs its range, and on offloaded contexts its samples
+    double row_bytes = (2.0 * sizeof(double)) +
+                       (band.bulk ? (double)config->width * sizeof(double) : 0.0);
+    double fit = floor(noise_config.memory_limit_mb * 1024.0 * 1024.0 / row_bytes);
+    int rows = fit >= config->height ? config->height : (fit >= 1.0 ? (int)fit : 1);
+    size_t sizes[] = {band.bulk ? (size_t)rows * config->width * sizeof(double) : 0,
+                      rows * sizeof(double), rows * sizeof(double)};
+    void* buffers[BUFFER_COUNT(sizes)];
+    if (alloc_buffers(config->arena, sizes, buffers, BUFFER_COUNT(sizes)) != 0) {
+        return -1;
+    }
+    band.samples = buffers[0];
+    band.row_min = buffers[1];
+    band.row_max = buffers[2];
+    SIMPLEX_PROFILE_BEGIN(ctx);
+    measure_range(&band, &noise_config, rows, min_value, max_value);
+    SIMPLEX_PROFILE_END(ctx, SIMPLEX_PROFILE_IMAGE, (size_t)config->width * (size_t)config->height);
+    free_buffers(config->arena, buffers, BUFFER_COUNT(buffers));
+    return 0;
+}
+
 int simplex_generate_fractal_image(const simplex_image_config_t* config) {
     if (!config) {
         return -1;
@@ -489,15 +1492,29 @@ int simplex_generate_fractal_image(const simplex_image_config_t* config) {
     return simplex_generate_2d_image(&fractal_config);
 }
 
+// The 2D image a heightmap of `config` is: heightmap colors, unless 16-bit samples were asked for
+static simplex_image_config_t heightmap_preset(const simplex_image_config_t* config) {
+    simplex_image_config_t heightmap_config = *config;
+    if (heightmap_config.color_mode != SIMPLEX_COLOR_GRAYSCALE16) {
+        heightmap_config.color_mode = SIMPLEX_COLOR_HEIGHTMAP;
+    }
+    heightmap_config.octaves = (heightmap_config.octaves > 1) ? heightmap_config.octaves : 6;
+    return heightmap_config;
+}
+
+// The 2D image a texture of `config` is
+static simplex_image_config_t texture_preset(const simplex_image_config_t* config) {
+    simplex_image_config_t texture_config = *config;
+    texture_config.color_mode = SIMPLEX_COLOR_TERRAIN;
+    texture_config.octaves = (texture_config.octaves > 1) ? texture_config.octaves : 3;
+    return texture_config;
+}
+
 int simplex_generate_heightmap(const simplex_image_config_t* config) {
     if (!config) {
         return -1;
     }
-    // Force heightmap mode
-    simplex_image_config_t heightmap_config = *config;
-    heightmap_config.color_mode = SIMPLEX_COLOR_HEIGHTMAP;
-    heightmap_config.octaves = (heightmap_config.octaves > 1) ? heightmap_config.octaves : 6;
-
+    simplex_image_config_t heightmap_config = heightmap_preset(config);
     return simplex_generate_2d_image(&heightmap_config);
 }
 
@@ -505,41 +1522,75 @@ int simplex_generate_texture(const simplex_image_config_t* config) {
     if (!config) {
         return -1;
     }
-    // Force texture mode
-    simplex_image_config_t texture_config = *config;
-    texture_config.color_mode = SIMPLEX_COLOR_TERRAIN;
-    texture_config.octaves = (texture_config.octaves > 1) ? texture_config.octaves : 3;
-
+    simplex_image_config_t texture_config = texture_preset(config);
     return simplex_generate_2d_image(&texture_config);
 }
 
+int simplex_render_heightmap_to_buffer(const simplex_image_config_t* config, void* buffer,
+                                       size_t capacity, size_t* size) {
+    if (!config) {
+        return -1;
+    }
+    simplex_image_config_t heightmap_config = heightmap_preset(config);
+    return simplex_render_to_buffer(&heightmap_config, buffer, capacity, size);
+}
+
+int simplex_render_texture_to_buffer(const simplex_image_config_t* config, void* buffer,
+                                     size_t capacity, size_t* size) {
+    if (!config) {
+        return -1;
+    }
+    simplex_image_config_t texture_config = texture_preset(config);
+    return simplex_render_to_buffer(&texture_config, buffer, capacity, size);
+}
+
+int simplex_generate_normal_map(const simplex_image_config_t* config, double strength) {
+    if (!config || config->width <= 0 || config->height <= 0 ||
+        (unsigned int)config->format >= SIMPLEX_IMAGE_COUNT ||
+        config->format == SIMPLEX_IMAGE_PGM) {
+        return -1;
+    }
+    simplex_config_t noise_config;
+    if (reseed_noise(config, &noise_config) != 0) {
+        return -1;
+    }
+    const simplex_context_t* ctx = simplex_context_resolve(NULL);
+    SIMPLEX_PROFILE_BEGIN(ctx);
+    int result = render_normal_map(config, strength, &noise_config);
+    SIMPLEX_PROFILE_END(ctx, SIMPLEX_PROFILE_IMAGE,
+                        result == 0 ? (size_t)config->width * (size_t)config->height : 0);
+    return result;
+}
+
 int simplex_generate_image_series(const simplex_image_config_t* base_config, int count,
                                   const double* scale_variations, const uint32_t* seed_variations) {
     if (!base_config || count <= 0) {
         return -1;
     }
+    batch_frame_t* frames = malloc((size_t)count * sizeof(*frames));
+    if (!frames) {
+        return -1;
+    }
     for (int i = 0; i < count; i++) {
-        simplex_image_config_t config = *base_config;
+        simplex_image_config_t* config = &frames[i].config;
+        *config = *base_config;
 
         // Modify filename to include index
-        char filename[256];
-        snprintf(filename, sizeof(filename), "simplex_series_%d.ppm", i);
-        simplex_set_image_filename(&config, filename);
+        snprintf(config->filename, sizeof(config->filename), "simplex_series_%d.ppm", i);
 
         // Apply variations
         if (scale_variations) {
-            config.scale = scale_variations[i];
+            config->scale = scale_variations[i];
         }
         if (seed_variations) {
-            config.seed = seed_variations[i];
-        }
-
-        if (simplex_generate_2d_image(&config) != 0) {
-            return -1;
+            config->seed = seed_variations[i];
         }
+        frames[i].z_start = 0.0;
     }
 
-    return 0;
+    int result = run_batch(frames, count, 2);
+    free(frames);
+    return result;
 }
 
 int simplex_generate_animation(const simplex_image_config_t* config, int frame_count,
@@ -547,21 +1598,24 @@ int simplex_generate_animation(const simplex_image_config_t* config, int frame_c
     if (!config || frame_count <= 0 || !output_dir) {
         return -1;
     }
+    batch_frame_t* frames = malloc((size_t)frame_count * sizeof(*frames));
+    if (!frames) {
+        return -1;
+    }
     for (int frame = 0; frame < frame_count; frame++) {
-        simplex_image_config_t frame_config = *config;
+        simplex_image_config_t* frame_config = &frames[frame].config;
+        *frame_config = *config;
 
         // Modify filename for frame
-        char filename[256];
-        snprintf(filename, sizeof(filename), "%s/frame_%04d.ppm", output_dir, frame);
-        simplex_set_image_filename(&frame_config, filename);
+        snprintf(frame_config->filename, sizeof(frame_config->filename), "%s/frame_%04d.ppm",
+                 output_dir, frame);
 
-        // Add time offset
-        frame_config.offset_z = frame * time_step;
-
-        if (simplex_generate_3d_image(&frame_config, frame * time_step) != 0) {
-            return -1;
-        }
+        // Add time offset, used as both offset_z and z slice as in simplex_generate_3d_image()
+        frame_config->offset_z = frame * time_step;
+        frames[frame].z_start = ((frame * time_step) + frame_config->offset_z) * config->scale;
     }
 
-    return 0;
+    int result = run_batch(frames, frame_count, 3);
+    free(frames);
+    return result;
 }
@@ -0,0 +1,496 @@
+/**
+ * @file simplex_internal.h
+ * @brief Private declarations shared between the simplex noise translation units
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @details Not installed. Holds the gradient tables, kernel constants and the
+ *          vectorized kernel tables so the scalar code in simplex_noise.c and the
+ *          per-ISA SIMD kernels (simplex_simd_*.c) stay numerically in lock-step.
+ *
+ * @author Adrian Paredez
+ * @version 2.0.0
+ * @date 9/5/2025
+ */
+
+#ifndef SIMPLEX_INTERNAL_H
+#define SIMPLEX_INTERNAL_H
+
+#include "../include/simplex_image.h"
+#include "../include/simplex_noise.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/* ===== KERNEL CONSTANTS ===== */
+#define SIMPLEX_2D_SCALE 70.0
+#define SIMPLEX_3D_SCALE 32.0
+#define SIMPLEX_4D_SCALE 27.0
+enum { SIMPLEX_2D_GRAD_COUNT = 8, SIMPLEX_3D_GRAD_COUNT = 12, SIMPLEX_4D_GRAD_COUNT = 32 };
+#define SIMPLEX_2D_THRESHOLD 0.5
+#define SIMPLEX_3D_THRESHOLD 0.6
+#define SIMPLEX_4D_THRESHOLD 0.6
+enum { SIMPLEX_PERM_SIZE = 256, SIMPLEX_PERM_DOUBLE_SIZE = 512, SIMPLEX_GATHER_PAD = 4 };
+/* Multipliers of the seeded kernels' lattice hash, all below 2^31 */
+enum {
+    SIMPLEX_HASH_X = 0x1B873593,
+    SIMPLEX_HASH_Y = 0x5BD1E995,
+    SIMPLEX_HASH_Z = 0x27D4EB2F,
+    SIMPLEX_HASH_MIX_A = 0x7FEB352D,
+    SIMPLEX_HASH_MIX_B = 0x2C1B3C6D
+};
+
+/* ===== PERMUTATION TABLES ===== */
+
+/**
+ * Per-seed lattice hash tables, about 1 KB. perm is the shuffled 0..255
+ * duplicated for wrapping; mod12 is perm % 12, the 3D gradient index, so a 3D
+ * hash ends in a lookup instead of a division. The 2D and 4D gradient counts
+ * are powers of two and are masked. The SIMD back-ends fetch entries with
+ * 32-bit gathers, which read up to three bytes past the one wanted; gather_pad
+ * keeps those reads inside the struct.
+ */
+typedef struct {
+    uint8_t perm[SIMPLEX_PERM_DOUBLE_SIZE];
+    uint8_t mod12[SIMPLEX_PERM_DOUBLE_SIZE];
+    uint8_t gather_pad[SIMPLEX_GATHER_PAD];
+} simplex_perm_tables_t;
+
+/* The tables a context with this PRNG and (non-zero) seed would shuffle */
+void simplex_perm_tables_build(simplex_prng_type_t prng_type, uint32_t seed,
+                               simplex_perm_tables_t* tables);
+
+/**
+ * simplex_context_create() and simplex_noise_init_advanced(), but copying
+ * `tables`, built for config->prng_type and config->seed, instead of
+ * shuffling; NULL tables shuffle as usual
+ */
+simplex_context_t* simplex_context_create_tables(const simplex_config_t* config,
+                                                 const simplex_perm_tables_t* tables);
+int simplex_noise_init_tables(const simplex_config_t* config, const simplex_perm_tables_t* tables);
+
+/* ===== GRADIENT TABLES ===== */
+extern const double simplex_grad2[SIMPLEX_2D_GRAD_COUNT][2];
+extern const double simplex_grad3[SIMPLEX_3D_GRAD_COUNT][3];
+extern const double simplex_grad4[SIMPLEX_4D_GRAD_COUNT][4];
+/* Single-precision copies for the float32 kernels (gathers need matching width) */
+extern const float simplex_grad2f[SIMPLEX_2D_GRAD_COUNT][2];
+extern const float simplex_grad3f[SIMPLEX_3D_GRAD_COUNT][3];
+extern const float simplex_grad4f[SIMPLEX_4D_GRAD_COUNT][4];
+
+/* ===== VECTORIZED KERNELS ===== */
+
+/**
+ * Batch kernels for one instruction set. Every entry produces the same values
+ * as the scalar simplex_noise_* functions for the same permutation tables, to
+ * within SIMPLEX_SIMD_TOLERANCE.
+ */
+typedef struct {
+    simplex_simd_level_t level;
+    const char* name; /* Instruction set name, e.g. "avx2" */
+    int lanes;        /* Doubles processed per vector */
+
+    /* Scattered points (structure-of-arrays input) */
+    void (*noise_2d)(const simplex_perm_tables_t* tables, const double* x, const double* y,
+                     size_t count, double* output);
+    void (*noise_3d)(const simplex_perm_tables_t* tables, const double* x, const double* y,
+                     const double* z, size_t count, double* output);
+    void (*noise_4d)(const simplex_perm_tables_t* tables, const double* x, const double* y,
+                     const double* z, const double* w, size_t count, double* output);
+
+    /* One grid row: x = x_start + i * step for i in [0, count) */
+    void (*row_2d)(const simplex_perm_tables_t* tables, double x_start, double y, double step,
+                   int count, double* output);
+    void (*row_3d)(const simplex_perm_tables_t* tables, double x_start, double y, double z,
+                   double step, int count, double* output);
+
+    /* Seeded noise over one grid row for each of `layers` seeds, with gradients
+     * hashed from the lattice point and seed instead of looked up. Sample i of
+     * layer l goes to output[l * stride + i]. */
+    void (*layers_2d)(const uint32_t* seeds, int layers, double x_start, double y, double step,
+                      int count, size_t stride, double* output);
+    void (*layers_3d)(const uint32_t* seeds, int layers, double x_start, double y, double z,
+                      double step, int count, size_t stride, double* output);
+} simplex_kernels_t;
+
+/* One table per compiled instruction set (see simplex_simd_kernels.h) */
+extern const simplex_kernels_t simplex_kernels_scalar;
+#if defined(SIMPLEX_HAVE_SSE41)
+extern const simplex_kernels_t simplex_kernels_sse41;
+#endif
+#if defined(SIMPLEX_HAVE_AVX2)
+extern const simplex_kernels_t simplex_kernels_avx2;
+#endif
+#if defined(SIMPLEX_HAVE_AVX512)
+extern const simplex_kernels_t simplex_kernels_avx512;
+#endif
+#if defined(SIMPLEX_HAVE_NEON)
+extern const simplex_kernels_t simplex_kernels_neon;
+#endif
+
+/**
+ * Float32 batch kernels for one instruction set: the same algorithm as
+ * simplex_kernels_t evaluated in single precision, with twice the lanes.
+ * Every level produces identical results for the same inputs.
+ */
+typedef struct {
+    simplex_simd_level_t level;
+    const char* name;
+    int lanes; /* Floats processed per vector */
+
+    void (*noise_2d)(const simplex_perm_tables_t* tables, const float* x, const float* y,
+                     size_t count, float* output);
+    void (*noise_3d)(const simplex_perm_tables_t* tables, const float* x, const float* y,
+                     const float* z, size_t count, float* output);
+    void (*noise_4d)(const simplex_perm_tables_t* tables, const float* x, const float* y,
+                     const float* z, const float* w, size_t count, float* output);
+
+    void (*row_2d)(const simplex_perm_tables_t* tables, float x_start, float y, float step,
+                   int count, float* output);
+    void (*row_3d)(const simplex_perm_tables_t* tables, float x_start, float y, float z,
+                   float step, int count, float* output);
+} simplex_kernels_f32_t;
+
+/* The scalar float32 table (simplex_simd_f32.c) is always built */
+extern const simplex_kernels_f32_t simplex_kernels_f32_scalar;
+#if defined(SIMPLEX_HAVE_SSE41)
+extern const simplex_kernels_f32_t simplex_kernels_f32_sse41;
+#endif
+#if defined(SIMPLEX_HAVE_AVX2)
+extern const simplex_kernels_f32_t simplex_kernels_f32_avx2;
+#endif
+#if defined(SIMPLEX_HAVE_AVX512)
+extern const simplex_kernels_f32_t simplex_kernels_f32_avx512;
+#endif
+#if defined(SIMPLEX_HAVE_NEON)
+extern const simplex_kernels_f32_t simplex_kernels_f32_neon;
+#endif
+
+/**
+ * Detect the best instruction set supported by both this build and the CPU
+ * @return Highest usable SIMD level (SIMPLEX_SIMD_SCALAR when none)
+ */
+simplex_simd_level_t simplex_simd_detect(void);
+
+/**
+ * Get the kernel table for an instruction set
+ * @param level Requested SIMD level
+ * @return Kernel table, or NULL if the level is not compiled in or the CPU lacks it
+ */
+const simplex_kernels_t* simplex_simd_kernels(simplex_simd_level_t level);
+
+/**
+ * Get the float32 kernel table for an instruction set
+ * @param level Requested SIMD level
+ * @return Kernel table, or NULL if the level is not compiled in or the CPU lacks it
+ */
+const simplex_kernels_f32_t* simplex_simd_kernels_f32(simplex_simd_level_t level);
+
+/* ===== PARALLEL EXECUTION (simplex_thread.c) ===== */
+enum { SIMPLEX_MAX_THREADS = 64 };
+
+/* Loop body: process items [begin, end) */
+typedef void (*simplex_range_fn)(void* arg, int begin, int end);
+
+/**
+ * Run fn over [0, count) on the built-in thread pool, in chunks of `grain`
+ * items and with at most max_threads threads (the caller included). Runs
+ * inline when one thread suffices or the pool is already busy, e.g. when
+ * called from inside another parallel loop or from two threads at once.
+ */
+void simplex_parallel_for(int count, int grain, int max_threads, simplex_range_fn fn, void* arg);
+
+/**
+ * Stop and join the pool's worker threads; the next parallel loop restarts them
+ */
+void simplex_thread_pool_shutdown(void);
+
+/* Lifecycle of a background task */
+typedef enum {
+    SIMPLEX_TASK_QUEUED = 0,
+    SIMPLEX_TASK_RUNNING,
+    SIMPLEX_TASK_FINISHED,
+    SIMPLEX_TASK_CANCELLED
+} simplex_task_state_t;
+
+/**
+ * Work queued for the runner threads, embedded in the submitter's own struct.
+ * run() does the work when cancelled is 0, and only reports the cancellation
+ * otherwise; its return value is kept as the task's result. destroy() frees
+ * the task once its last reference is dropped.
+ */
+typedef struct simplex_task {
+    struct simplex_task* next;
+    int (*run)(struct simplex_task* task, int cancelled);
+    void (*destroy)(struct simplex_task* task);
+    int priority; /* simplex_job_priority_t; higher runs first, FIFO within one */
+    int refs;     /* One for the queue plus one per holder, set before submitting */
+    simplex_task_state_t state;
+    int result;
+} simplex_task_t;
+
+/**
+ * Queue a task; the runner threads start on the first submission. A task
+ * of the top priority never waits behind lower-priority ones.
+ * @return 0 on success, -1 if no runner could be started or runners are shutting down
+ */
+int simplex_task_submit(simplex_task_t* task);
+
+/* Cancel a task that has not started: run(task, 1) is called on this thread. -1 if too late */
+int simplex_task_cancel(simplex_task_t* task);
+
+/* Current state, and the result once finished */
+simplex_task_state_t simplex_task_state(simplex_task_t* task, int* result);
+
+/* Block until the task has finished or been cancelled */
+simplex_task_state_t simplex_task_wait(simplex_task_t* task, int* result);
+
+/* Drop one reference */
+void simplex_task_release(simplex_task_t* task);
+
+/* Cancel every queued task, let running ones finish and join the runners */
+void simplex_task_runners_shutdown(void);
+
+/* Plain mutex for state shared between threads outside the pool */
+typedef struct simplex_lock simplex_lock_t;
+simplex_lock_t* simplex_lock_create(void);
+void simplex_lock_destroy(simplex_lock_t* lock);
+void simplex_lock_acquire(simplex_lock_t* lock);
+void simplex_lock_release(simplex_lock_t* lock);
+
+/* ===== TILE CACHE (simplex_cache.c) ===== */
+typedef struct simplex_tile_cache simplex_tile_cache_t;
+
+/**
+ * Create an empty tile cache
+ * @param budget_bytes Most bytes of tile data kept cached (0 keeps nothing)
+ * @return New cache, or NULL on allocation failure
+ */
+simplex_tile_cache_t* simplex_tile_cache_create(size_t budget_bytes);
+
+/**
+ * Drop every cached tile and set a new budget. Tiles still held by callers
+ * stay valid until released.
+ */
+void simplex_tile_cache_reset(simplex_tile_cache_t* cache, size_t budget_bytes);
+
+/* Free the cache; every acquired tile must have been released */
+void simplex_tile_cache_destroy(simplex_tile_cache_t* cache);
+
+/* Copy the hit/miss/eviction counters into stats */
+void simplex_tile_cache_get_stats(simplex_tile_cache_t* cache, simplex_perf_stats_t* stats);
+void simplex_tile_cache_reset_stats(simplex_tile_cache_t* cache);
+
+/**
+ * Look a tile up, generating it with ctx on a miss. A NULL cache or a
+ * context with caching disabled still hands out a tile that
+ * simplex_tile_release() frees.
+ * @return Held tile samples, or NULL on invalid request or allocation failure
+ */
+const double* simplex_tile_cache_acquire(simplex_tile_cache_t* cache, const simplex_context_t* ctx,
+                                         const simplex_tile_request_t* request);
+
+/* ===== BUFFER ARENAS (simplex_arena.c) ===== */
+
+/**
+ * Lay count buffers of sizes[i] bytes out back to back in the arena's block,
+ * growing it if they do not fit. Each buffer starts on a
+ * SIMPLEX_ARENA_ALIGNMENT boundary and a size of 0 gives NULL; buffers handed
+ * out by earlier calls are invalidated.
+ * @return 0 on success, -1 on allocation failure
+ */
+int simplex_arena_carve(simplex_arena_t* arena, const size_t* sizes, void** buffers, int count);
+
+/* ===== DETACHED IMAGES (simplex_image.c) ===== */
+
+/**
+ * Render a 2D image as simplex_generate_2d_image() (buffer NULL) or
+ * simplex_render_to_buffer() does, but on a context of its own seeded from
+ * config->seed, so the default context is left untouched and renders may
+ * run concurrently.
+ * @return 0 on success, -1 on error
+ */
+int simplex_image_render_detached(const simplex_image_config_t* config, void* buffer,
+                                  size_t capacity, size_t* size);
+
+/* ===== PROFILING (simplex_profile.c) ===== */
+typedef struct simplex_profiler simplex_profiler_t;
+
+/* Counters for one context; NULL when profiling is compiled out or on allocation failure */
+simplex_profiler_t* simplex_profiler_create(void);
+void simplex_profiler_destroy(simplex_profiler_t* profiler);
+void simplex_profiler_reset(simplex_profiler_t* profiler);
+
+/* Merge every thread's counters for one API; a NULL profiler reads as zero */
+void simplex_profiler_read(const simplex_profiler_t* profiler, simplex_profile_api_t api,
+                           simplex_profile_entry_t* entry);
+
+#if defined(SIMPLEX_ENABLE_PROFILING)
+#if defined(_MSC_VER)
+#define SIMPLEX_THREAD_LOCAL __declspec(thread)
+#else
+#define SIMPLEX_THREAD_LOCAL __thread
+#endif
+
+/**
+ * Start timing a public call. Returns 0, and records nothing, when the
+ * calling thread is already inside a profiled call or is a pool worker, so
+ * only the outermost API call of a nest is counted.
+ */
+uint64_t simplex_profile_begin(void);
+
+/* Finish a call started by a non-zero simplex_profile_begin() */
+void simplex_profile_end(simplex_profiler_t* profiler, simplex_profile_api_t api, uint64_t start,
+                         size_t samples);
+
+/* Mark the calling thread as internal to the library (pool workers) */
+void simplex_profile_mark_worker(void);
+
+/* Bracket a public entry point; both compile to nothing without SIMPLEX_ENABLE_PROFILING */
+#define SIMPLEX_PROFILE_BEGIN(ctx)                                                              \
+    uint64_t simplex_profile_start = (ctx)->profiling_enabled ? simplex_profile_begin() : 0
+#define SIMPLEX_PROFILE_END(ctx, api, samples)                                                  \
+    do {                                                                                        \
+        if (simplex_profile_start) {                                                            \
+            simplex_profile_end((ctx)->profiler, (api), simplex_profile_start, (samples));      \
+        }                                                                                       \
+    } while (0)
+#else
+#define SIMPLEX_PROFILE_BEGIN(ctx) ((void)(ctx))
+#define SIMPLEX_PROFILE_END(ctx, api, samples) ((void)(ctx))
+#endif
+
+/**
+ * Resolve NULL to the default context, initializing it on first use
+ * (for translation units other than simplex_noise.c)
+ */
+const simplex_context_t* simplex_context_resolve(const simplex_context_t* ctx);
+
+/* ===== GPU OFFLOAD (simplex_opencl.c) ===== */
+typedef struct simplex_gpu simplex_gpu_t;
+
+/* What a grid sample is; the values mirror the CPU array kinds */
+typedef enum {
+    SIMPLEX_GPU_NOISE = 0,
+    SIMPLEX_GPU_FBM,
+    SIMPLEX_GPU_HYBRID_MULTIFRACTAL,
+    SIMPLEX_GPU_RIDGED,
+    SIMPLEX_GPU_BILLOWY
+} simplex_gpu_kind_t;
+
+/* A grid job: sample (x, y, z) at start + index * step, rows numbered z * height + y */
+typedef struct {
+    simplex_gpu_kind_t kind;
+    int dims; /* 2 or 3 */
+    double x_start;
+    double y_start;
+    double z_start;
+    double step;
+    int width;
+    int height;
+    int depth;
+    int octaves;
+    double persistence;
+    double lacunarity;
+    double offset;
+    double memory_limit_mb; /* Bounds the device buffers a job streams through */
+} simplex_gpu_grid_t;
+
+/**
+ * Open the first OpenCL device with double precision, preferring GPUs, and
+ * build the kernels
+ * @return Device state, or NULL when OpenCL is not compiled in or no device works
+ */
+simplex_gpu_t* simplex_gpu_create(void);
+void simplex_gpu_destroy(simplex_gpu_t* gpu);
+
+/* Device name for display */
+const char* simplex_gpu_name(const simplex_gpu_t* gpu);
+
+/**
+ * Upload a context's permutation table; every later job samples with it
+ * @return 0 on success, -1 if the device rejected the upload
+ */
+int simplex_gpu_set_perm(simplex_gpu_t* gpu, const uint8_t* perm);
+
+/**
+ * Generate a grid into host memory. Rows are computed in slabs that cycle
+ * through two device buffers, each slab read back while the next one runs.
+ * @return 0 on success, -1 on any device error (output is then unspecified)
+ */
+int simplex_gpu_generate(simplex_gpu_t* gpu, const simplex_gpu_grid_t* grid, double* output);
+
+/* ===== PNG ENCODING (simplex_png.c) ===== */
+typedef struct simplex_png_encoder simplex_png_encoder_t;
+
+typedef struct {
+    int width;
+    int height;
+    int channels;  /* 1 for grayscale, 3 for RGB */
+    int bit_depth; /* 8, or 16 for grayscale */
+    int level;     /* Deflate level 0-9 */
+    simplex_png_filter_t filter;
+    int max_threads; /* Threads compressing the rows of one batch */
+    int (*write)(void* user_data, const void* data, size_t size);
+    void* user_data;
+} simplex_png_params_t;
+
+/**
+ * Start a PNG: writes the signature and header through params->write
+ * @return Encoder, or NULL on invalid parameters, allocation or write failure
+ */
+simplex_png_encoder_t* simplex_png_begin(const simplex_png_params_t* params);
+
+/**
+ * Filter, compress and write the next `count` rows (row-parallel for large batches)
+ * @return 0 on success, -1 on error (the encoder then only accepts simplex_png_end())
+ */
+int simplex_png_write_rows(simplex_png_encoder_t* png, const uint8_t* rows, int count);
+
+/**
+ * Finish the PNG and free the encoder
+ * @return 0 if every row was written and the trailer went out, -1 otherwise
+ */
+int simplex_png_end(simplex_png_encoder_t* png);
+
+/* Upper bound on the encoded size of a PNG with the given geometry */
+size_t simplex_png_bound(int width, int height, int bytes_per_pixel);
+
+/* ===== NOISE CONTEXT ===== */
+enum { SIMPLEX_MT_STATE_SIZE = 624 };
+
+/* State for every PRNG algorithm; only the configured one is advanced */
+typedef struct {
+    uint32_t lcg_state;
+    uint32_t mersenne_state[SIMPLEX_MT_STATE_SIZE];
+    int mersenne_index;
+    uint64_t xorshift_state[4];
+    uint64_t pcg_state;
+    uint64_t pcg_inc;
+} simplex_prng_state_t;
+
+/**
+ * Everything a noise evaluation depends on. The global API runs on a single
+ * default instance; simplex_context_create() hands out independent ones.
+ */
+struct simplex_context {
+    simplex_perm_tables_t tables; /* Seeded lattice hash tables */
+    simplex_config_t config;
+    simplex_prng_state_t prng;
+
+    const simplex_kernels_t* kernels; /* Bulk kernels, NULL for the per-point loops */
+    const simplex_kernels_f32_t* kernels_f32; /* Float32 kernels, never NULL once initialized */
+    int simd_level_override;          /* Forced simplex_simd_level_t, -1 for automatic */
+
+    simplex_profiler_t* profiler; /* Per-API counters, kept across re-initialization */
+    int profiling_enabled;
+
+    simplex_tile_cache_t* tile_cache; /* Shared tiles, NULL if it could not be allocated */
+    int cache_enabled;
+
+    simplex_gpu_t* gpu; /* Offload device, NULL when enable_gpu is off or no device works */
+
+    int initialized;
+};
+
+#endif /* SIMPLEX_INTERNAL_H */
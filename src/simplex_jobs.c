@@ -0,0 +1,222 @@
+/**
+ * @file simplex_jobs.c
+ * @brief Asynchronous array and image jobs with completion callbacks
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @details A job is a background task (simplex_thread.c) carrying a copy of
+ *          its request. The runner threads queue, prioritize, cancel and
+ *          reference-count tasks; this file only validates requests, runs
+ *          them through the blocking functions and maps task states to job
+ *          states. The queue holds one reference to a job until it has
+ *          finished and the caller's handle holds the other.
+ *
+ * @author Adrian Paredez
+ * @version 2.0.0
+ * @date 9/5/2025
+ */
+
+#include "../include/simplex_image.h"
+#include "../include/simplex_noise.h"
+#include "simplex_internal.h"
+#include <stdlib.h>
+
+typedef enum { JOB_ARRAY_2D = 0, JOB_IMAGE } job_kind_t;
+
+struct simplex_job {
+    simplex_task_t task; /* First, so the runners' task leads back to its job */
+    job_kind_t kind;
+    simplex_job_callback_t callback;
+    void* user_data;
+
+    /* JOB_ARRAY_2D */
+    const simplex_context_t* ctx;
+    simplex_array_params_t array;
+    double* output;
+
+    /* JOB_IMAGE; a NULL buffer writes image.filename */
+    simplex_image_config_t image;
+    void* buffer;
+    size_t capacity;
+    size_t* size;
+};
+
+/* ===== EXECUTION ===== */
+
+static int run_array(const simplex_job_t* job) {
+    const simplex_array_params_t* p = &job->array;
+    if (p->octaves == 1) {
+        return simplex_noise_array_2d_ctx(job->ctx, p->x_start, p->y_start, p->width, p->height,
+                                          p->step, job->output);
+    }
+    return simplex_fbm_array_2d_ctx(job->ctx, p->x_start, p->y_start, p->width, p->height,
+                                    p->step, p->octaves, p->persistence, p->lacunarity,
+                                    job->output);
+}
+
+// Task body: run the request unless cancelled, then report to the callback
+static int run_job(simplex_task_t* task, int cancelled) {
+    simplex_job_t* job = (simplex_job_t*)task;
+    int result = -1;
+    if (!cancelled) {
+        result = job->kind == JOB_ARRAY_2D
+                     ? run_array(job)
+                     : simplex_image_render_detached(&job->image, job->buffer, job->capacity,
+                                                     job->size);
+    }
+    if (job->callback) {
+        simplex_job_status_t status = cancelled     ? SIMPLEX_JOB_CANCELLED
+                                      : result == 0 ? SIMPLEX_JOB_DONE
+                                                    : SIMPLEX_JOB_FAILED;
+        job->callback(job, status, job->user_data);
+    }
+    return result;
+}
+
+static void destroy_job(simplex_task_t* task) {
+    free(task);
+}
+
+static simplex_job_status_t job_status(simplex_task_state_t state, int result) {
+    switch (state) {
+    case SIMPLEX_TASK_QUEUED:
+        return SIMPLEX_JOB_QUEUED;
+    case SIMPLEX_TASK_RUNNING:
+        return SIMPLEX_JOB_RUNNING;
+    case SIMPLEX_TASK_CANCELLED:
+        return SIMPLEX_JOB_CANCELLED;
+    default:
+        return result == 0 ? SIMPLEX_JOB_DONE : SIMPLEX_JOB_FAILED;
+    }
+}
+
+/* ===== SUBMISSION ===== */
+
+// A new job of `kind`, NULL on an invalid priority or allocation failure
+static simplex_job_t* create_job(job_kind_t kind, simplex_job_priority_t priority,
+                                 simplex_job_callback_t callback, void* user_data) {
+    if ((unsigned int)priority >= SIMPLEX_JOB_PRIORITY_COUNT) {
+        return NULL;
+    }
+    simplex_job_t* job = calloc(1, sizeof(*job));
+    if (job) {
+        job->task.run = run_job;
+        job->task.destroy = destroy_job;
+        job->task.priority = priority;
+        job->kind = kind;
+        job->callback = callback;
+        job->user_data = user_data;
+    }
+    return job;
+}
+
+/* Queue a job, handing the caller a reference through `handle` when asked for.
+ * The handle is set first, as the callback may run before submission returns. */
+static int submit_job(simplex_job_t* job, simplex_job_t** handle) {
+    job->task.refs = handle ? 2 : 1;
+    if (handle) {
+        *handle = job;
+    }
+    if (simplex_task_submit(&job->task) != 0) {
+        if (handle) {
+            *handle = NULL;
+        }
+        free(job);
+        return -1;
+    }
+    return 0;
+}
+
+int simplex_submit_array_2d(const simplex_context_t* ctx, const simplex_array_params_t* params,
+                            double* output, simplex_job_priority_t priority,
+                            simplex_job_callback_t callback, void* user_data,
+                            simplex_job_t** job) {
+    if (!params || !output || params->width <= 0 || params->height <= 0 ||
+        params->octaves <= 0) {
+        return -1;
+    }
+    simplex_job_t* created = create_job(JOB_ARRAY_2D, priority, callback, user_data);
+    if (!created) {
+        return -1;
+    }
+    created->ctx = ctx;
+    created->array = *params;
+    created->output = output;
+    return submit_job(created, job);
+}
+
+int simplex_submit_image(const simplex_image_config_t* config, simplex_job_priority_t priority,
+                         simplex_job_callback_t callback, void* user_data, simplex_job_t** job) {
+    if (simplex_image_encoded_size(config) == 0) {
+        return -1;
+    }
+    simplex_job_t* created = create_job(JOB_IMAGE, priority, callback, user_data);
+    if (!created) {
+        return -1;
+    }
+    created->image = *config;
+    return submit_job(created, job);
+}
+
+int simplex_submit_image_to_buffer(const simplex_image_config_t* config, void* buffer,
+                                   size_t capacity, size_t* size, simplex_job_priority_t priority,
+                                   simplex_job_callback_t callback, void* user_data,
+                                   simplex_job_t** job) {
+    size_t required = simplex_image_encoded_size(config);
+    if (required == 0 || !buffer || capacity < required) {
+        return -1;
+    }
+    simplex_job_t* created = create_job(JOB_IMAGE, priority, callback, user_data);
+    if (!created) {
+        return -1;
+    }
+    created->image = *config;
+    created->buffer = buffer;
+    created->capacity = capacity;
+    created->size = size;
+    return submit_job(created, job);
+}
+
+/* ===== HANDLES ===== */
+
+int simplex_job_cancel(simplex_job_t* job) {
+    return job ? simplex_task_cancel(&job->task) : -1;
+}
+
+simplex_job_status_t simplex_job_status(simplex_job_t* job) {
+    if (!job) {
+        return SIMPLEX_JOB_FAILED;
+    }
+    int result = 0;
+    simplex_task_state_t state = simplex_task_state(&job->task, &result);
+    return job_status(state, result);
+}
+
+simplex_job_status_t simplex_job_wait(simplex_job_t* job) {
+    if (!job) {
+        return SIMPLEX_JOB_FAILED;
+    }
+    int result = 0;
+    simplex_task_state_t state = simplex_task_wait(&job->task, &result);
+    return job_status(state, result);
+}
+
+int simplex_job_wait_all(simplex_job_t* const* jobs, int count) {
+    if (!jobs || count < 0) {
+        return -1;
+    }
+    int result = 0;
+    for (int i = 0; i < count; i++) {
+        if (!jobs[i] || simplex_job_wait(jobs[i]) != SIMPLEX_JOB_DONE) {
+            result = -1;
+        }
+    }
+    return result;
+}
+
+void simplex_job_release(simplex_job_t* job) {
+    if (job) {
+        simplex_task_release(&job->task);
+    }
+}
@@ -16,6 +16,7 @@
  */
 
 #include "../include/simplex_noise.h"
+#include "simplex_internal.h"
 #include <ctype.h>
 #include <limits.h>
 #include <math.h>
@@ -27,12 +28,10 @@
 
 /* ===== CONSTANTS ===== */
 enum {
-    CACHE_HASH_MULTIPLIER = 1000,
-    PERMUTATION_SIZE = 256,
-    PERMUTATION_DOUBLE_SIZE = 512,
+    PERMUTATION_SIZE = SIMPLEX_PERM_SIZE,
     LCG_MULTIPLIER = 1103515245,
     LCG_INCREMENT = 12345,
-    MERSENNE_STATE_SIZE = 624,
+    MERSENNE_STATE_SIZE = SIMPLEX_MT_STATE_SIZE,
     MERSENNE_MULTIPLIER = 1812433253,
     MERSENNE_SHIFT_BITS = 30,
     MERSENNE_MASK = 0xFFFFFFFFU,
@@ -46,23 +45,22 @@ enum {
     MERSENNE_TEMPER_SHIFT4 = 18
 };
 
-#define CACHE_EPSILON 1e-9
-#define SIMPLEX_2D_SCALE 70.0
-#define SIMPLEX_3D_SCALE 32.0
-#define SIMPLEX_4D_SCALE 27.0
-enum { SIMPLEX_2D_GRAD_COUNT = 8, SIMPLEX_3D_GRAD_COUNT = 12, SIMPLEX_4D_GRAD_COUNT = 32 };
-#define SIMPLEX_2D_THRESHOLD 0.5
-#define SIMPLEX_3D_THRESHOLD 0.6
-#define SIMPLEX_4D_THRESHOLD 0.6
 enum {
     DOMAIN_WARP_OFFSET = 100,
     MAX_OCTAVES = 16,
-    MAX_THREADS = 64,
+    MAX_THREADS = SIMPLEX_MAX_THREADS,
     DEFAULT_CHUNK_SIZE = 1024,
     MAX_ERROR_COUNT = 10,
     MAX_ERROR_LENGTH = 256
 };
 
+/* Skew and unskew factors of the simplex grids; the 2D ones are
+ * 0.5 * (sqrt(3) - 1) and (3 - sqrt(3)) / 6 rounded to double */
+#define SKEW_2D 0.3660254037844386
+#define UNSKEW_2D 0.21132486540518713
+#define SKEW_3D (1.0 / 3.0)
+#define UNSKEW_3D (1.0 / 6.0)
+
 #define MAX_LACUNARITY 4.0
 #define MAX_CACHE_SIZE_MB 1024.0
 #define DEFAULT_MEMORY_LIMIT_MB 256.0
@@ -70,177 +68,158 @@ enum {
 
 /* ===== GLOBAL STATE MANAGEMENT ===== */
 
-// Global permutation table
-static int
-    perm[PERMUTATION_DOUBLE_SIZE];  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
-static int initialized = 0;         // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
-
-// Advanced configuration
-static simplex_config_t
-    global_config;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
-static simplex_perf_stats_t
-    perf_stats;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
-
-// PRNG state for different algorithms
-static struct {
-    uint32_t lcg_state;
-    uint32_t mersenne_state[MERSENNE_STATE_SIZE];
-    int mersenne_index;
-    uint64_t xorshift_state[4];
-    uint64_t pcg_state;
-    uint64_t pcg_inc;
-} prng_state;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
-
-// Caching system
-enum { CACHE_SIZE = 1024 };
-static struct {
-    double x, y, z, w;
-    double result;
-    int valid;
-} noise_cache[CACHE_SIZE];     // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
-static int cache_enabled = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
-static int cache_hits = 0;     // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
-static int cache_misses = 0;   // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
-
-// Performance tracking
-static int profiling_enabled = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
-static size_t function_call_count =
-    0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+// Default context behind the global (non-_ctx) API
+static simplex_context_t default_context = {
+    .simd_level_override = -1};  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
 // Gradients for 2D noise
-static const double grad2[8][2] = {{1, 1}, {-1, 1}, {1, -1}, {-1, -1},
-                                   {1, 0}, {-1, 0}, {0, 1},  {0, -1}};
+const double simplex_grad2[SIMPLEX_2D_GRAD_COUNT][2] = {{1, 1}, {-1, 1}, {1, -1}, {-1, -1},
+                                                        {1, 0}, {-1, 0}, {0, 1},  {0, -1}};
 
 // Gradients for 3D noise
-static const double grad3[12][3] = {{1, 1, 0}, {-1, 1, 0}, {1, -1, 0}, {-1, -1, 0},
-                                    {1, 0, 1}, {-1, 0, 1}, {1, 0, -1}, {-1, 0, -1},
-                                    {0, 1, 1}, {0, -1, 1}, {0, 1, -1}, {0, -1, -1}};
+const double simplex_grad3[SIMPLEX_3D_GRAD_COUNT][3] = {
+    {1, 1, 0}, {-1, 1, 0}, {1, -1, 0}, {-1, -1, 0}, {1, 0, 1},  {-1, 0, 1},
+    {1, 0, -1}, {-1, 0, -1}, {0, 1, 1}, {0, -1, 1}, {0, 1, -1}, {0, -1, -1}};
 
 // Gradients for 4D noise
-static const double grad4[32][4] = {{0, 1, 1, 1},  {0, 1, 1, -1},  {0, 1, -1, 1},  {0, 1, -1, -1},
-                                    {0, -1, 1, 1}, {0, -1, 1, -1}, {0, -1, -1, 1}, {0, -1, -1, -1},
-                                    {1, 0, 1, 1},  {1, 0, 1, -1},  {1, 0, -1, 1},  {1, 0, -1, -1},
-                                    {-1, 0, 1, 1}, {-1, 0, 1, -1}, {-1, 0, -1, 1}, {-1, 0, -1, -1},
-                                    {1, 1, 0, 1},  {1, 1, 0, -1},  {1, -1, 0, 1},  {1, -1, 0, -1},
-                                    {-1, 1, 0, 1}, {-1, 1, 0, -1}, {-1, -1, 0, 1}, {-1, -1, 0, -1},
-                                    {1, 1, 1, 0},  {1, 1, -1, 0},  {1, -1, 1, 0},  {1, -1, -1, 0},
-                                    {-1, 1, 1, 0}, {-1, 1, -1, 0}, {-1, -1, 1, 0}, {-1, -1, -1, 0}};
+const double simplex_grad4[SIMPLEX_4D_GRAD_COUNT][4] = {
+    {0, 1, 1, 1},  {0, 1, 1, -1},  {0, 1, -1, 1},  {0, 1, -1, -1}, {0, -1, 1, 1}, {0, -1, 1, -1},
+    {0, -1, -1, 1}, {0, -1, -1, -1}, {1, 0, 1, 1},  {1, 0, 1, -1},  {1, 0, -1, 1}, {1, 0, -1, -1},
+    {-1, 0, 1, 1}, {-1, 0, 1, -1}, {-1, 0, -1, 1}, {-1, 0, -1, -1}, {1, 1, 0, 1}, {1, 1, 0, -1},
+    {1, -1, 0, 1}, {1, -1, 0, -1}, {-1, 1, 0, 1}, {-1, 1, 0, -1}, {-1, -1, 0, 1}, {-1, -1, 0, -1},
+    {1, 1, 1, 0},  {1, 1, -1, 0},  {1, -1, 1, 0},  {1, -1, -1, 0}, {-1, 1, 1, 0}, {-1, 1, -1, 0},
+    {-1, -1, 1, 0}, {-1, -1, -1, 0}};
+
+const float simplex_grad2f[SIMPLEX_2D_GRAD_COUNT][2] = {{1, 1}, {-1, 1}, {1, -1}, {-1, -1},
+                                                        {1, 0}, {-1, 0}, {0, 1},  {0, -1}};
+
+const float simplex_grad3f[SIMPLEX_3D_GRAD_COUNT][3] = {
+    {1, 1, 0}, {-1, 1, 0}, {1, -1, 0}, {-1, -1, 0}, {1, 0, 1},  {-1, 0, 1},
+    {1, 0, -1}, {-1, 0, -1}, {0, 1, 1}, {0, -1, 1}, {0, 1, -1}, {0, -1, -1}};
+
+const float simplex_grad4f[SIMPLEX_4D_GRAD_COUNT][4] = {
+    {0, 1, 1, 1},  {0, 1, 1, -1},  {0, 1, -1, 1},  {0, 1, -1, -1}, {0, -1, 1, 1}, {0, -1, 1, -1},
+    {0, -1, -1, 1}, {0, -1, -1, -1}, {1, 0, 1, 1},  {1, 0, 1, -1},  {1, 0, -1, 1}, {1, 0, -1, -1},
+    {-1, 0, 1, 1}, {-1, 0, 1, -1}, {-1, 0, -1, 1}, {-1, 0, -1, -1}, {1, 1, 0, 1}, {1, 1, 0, -1},
+    {1, -1, 0, 1}, {1, -1, 0, -1}, {-1, 1, 0, 1}, {-1, 1, 0, -1}, {-1, -1, 0, 1}, {-1, -1, 0, -1},
+    {1, 1, 1, 0},  {1, 1, -1, 0},  {1, -1, 1, 0},  {1, -1, -1, 0}, {-1, 1, 1, 0}, {-1, 1, -1, 0},
+    {-1, -1, 1, 0}, {-1, -1, -1, 0}};
 
 /* ===== ADVANCED PRNG IMPLEMENTATIONS ===== */
 
 // Linear Congruential Generator
-static uint32_t lcg_next(void) {
-    prng_state.lcg_state = prng_state.lcg_state * LCG_MULTIPLIER + LCG_INCREMENT;
-    return prng_state.lcg_state;
+static uint32_t lcg_next(simplex_prng_state_t* state) {
+    state->lcg_state = state->lcg_state * LCG_MULTIPLIER + LCG_INCREMENT;
+    return state->lcg_state;
 }
 
 // Mersenne Twister implementation
-static void mersenne_init(uint32_t seed) {
-    prng_state.mersenne_state[0] = seed;
+static void mersenne_init(simplex_prng_state_t* state, uint32_t seed) {
+    state->mersenne_state[0] = seed;
     for (int i = 1; i < MERSENNE_STATE_SIZE; i++) {
-        prng_state.mersenne_state[i] =
-            (MERSENNE_MULTIPLIER * (prng_state.mersenne_state[i - 1] ^
-                                    (prng_state.mersenne_state[i - 1] >> MERSENNE_SHIFT_BITS)) +
+        state->mersenne_state[i] =
+            (MERSENNE_MULTIPLIER * (state->mersenne_state[i - 1] ^
+                                    (state->mersenne_state[i - 1] >> MERSENNE_SHIFT_BITS)) +
              i) &
             MERSENNE_MASK;
     }
-    prng_state.mersenne_index = 0;
+    state->mersenne_index = 0;
 }
 
-static void mersenne_generate(void) {
+static void mersenne_generate(simplex_prng_state_t* state) {
     for (int i = 0; i < MERSENNE_STATE_SIZE; i++) {
-        uint32_t y = (prng_state.mersenne_state[i] & MERSENNE_MSB_MASK) +
-                     (prng_state.mersenne_state[(i + 1) % MERSENNE_STATE_SIZE] & MERSENNE_LSB_MASK);
-        prng_state.mersenne_state[i] =
-            prng_state.mersenne_state[(i + MERSENNE_OFFSET) % MERSENNE_STATE_SIZE] ^ (y >> 1);
+        uint32_t y = (state->mersenne_state[i] & MERSENNE_MSB_MASK) +
+                     (state->mersenne_state[(i + 1) % MERSENNE_STATE_SIZE] & MERSENNE_LSB_MASK);
+        state->mersenne_state[i] =
+            state->mersenne_state[(i + MERSENNE_OFFSET) % MERSENNE_STATE_SIZE] ^ (y >> 1);
         if (y % 2) {
-            prng_state.mersenne_state[i] ^= MERSENNE_XOR_MASK;
+            state->mersenne_state[i] ^= MERSENNE_XOR_MASK;
         }
     }
 }
 
-static uint32_t mersenne_next(void) {
-    if (prng_state.mersenne_index == 0) {
-        mersenne_generate();
+static uint32_t mersenne_next(simplex_prng_state_t* state) {
+    if (state->mersenne_index == 0) {
+        mersenne_generate(state);
     }
-    uint32_t y = prng_state.mersenne_state[prng_state.mersenne_index];
+    uint32_t y = state->mersenne_state[state->mersenne_index];
     y ^= (y >> MERSENNE_TEMPER_SHIFT1);
     y ^= (y << MERSENNE_TEMPER_SHIFT2) & 0x9D2C5680;
     y ^= (y << MERSENNE_TEMPER_SHIFT3) & 0xEFC60000;
     y ^= (y >> MERSENNE_TEMPER_SHIFT4);
-    prng_state.mersenne_index = (prng_state.mersenne_index + 1) % 624;
+    state->mersenne_index = (state->mersenne_index + 1) % 624;
     return y;
 }
 
 // Xorshift implementation
-static void xorshift_init(uint64_t seed) {
-    prng_state.xorshift_state[0] = seed;
-    prng_state.xorshift_state[1] = seed ^ 0x123456789ABCDEF0;
-    prng_state.xorshift_state[2] = seed ^ 0xFEDCBA9876543210;
-    prng_state.xorshift_state[3] = seed ^ 0x13579BDF2468ACE0;
-}
-
-static uint64_t xorshift_next(void) {
-    uint64_t t = prng_state.xorshift_state[0];
-    uint64_t s = prng_state.xorshift_state[3];
-    prng_state.xorshift_state[0] = prng_state.xorshift_state[1];
-    prng_state.xorshift_state[1] = prng_state.xorshift_state[2];
-    prng_state.xorshift_state[2] = s;
+static void xorshift_init(simplex_prng_state_t* state, uint64_t seed) {
+    state->xorshift_state[0] = seed;
+    state->xorshift_state[1] = seed ^ 0x123456789ABCDEF0;
+    state->xorshift_state[2] = seed ^ 0xFEDCBA9876543210;
+    state->xorshift_state[3] = seed ^ 0x13579BDF2468ACE0;
+}
+
+static uint64_t xorshift_next(simplex_prng_state_t* state) {
+    uint64_t t = state->xorshift_state[0];
+    uint64_t s = state->xorshift_state[3];
+    state->xorshift_state[0] = state->xorshift_state[1];
+    state->xorshift_state[1] = state->xorshift_state[2];
+    state->xorshift_state[2] = s;
     t ^= t << 11;
     t ^= t >> 8;
-    prng_state.xorshift_state[3] = t ^ s ^ (s >> 19);
-    return prng_state.xorshift_state[3];
+    state->xorshift_state[3] = t ^ s ^ (s >> 19);
+    return state->xorshift_state[3];
 }
 
 // PCG implementation
-static uint32_t pcg_next(void) {
-    uint64_t oldstate = prng_state.pcg_state;
-    prng_state.pcg_state = oldstate * 6364136223846793005ULL + prng_state.pcg_inc;
+static uint32_t pcg_next(simplex_prng_state_t* state) {
+    uint64_t oldstate = state->pcg_state;
+    state->pcg_state = oldstate * 6364136223846793005ULL + state->pcg_inc;
     uint32_t xorshifted = ((oldstate >> 18) ^ oldstate) >> 27;
     uint32_t rot = oldstate >> 59;
     return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
 }
 
-static void pcg_init(uint64_t seed) {
-    prng_state.pcg_state = 0;
-    prng_state.pcg_inc = (seed << 1) | 1;
-    pcg_next();
-    prng_state.pcg_state += seed;
-    pcg_next();
+static void pcg_init(simplex_prng_state_t* state, uint64_t seed) {
+    state->pcg_state = 0;
+    state->pcg_inc = (seed << 1) | 1;
+    pcg_next(state);
+    state->pcg_state += seed;
+    pcg_next(state);
 }
 
 // Unified PRNG interface
-static uint32_t prng_next(void) {
-    switch (global_config.prng_type) {
+static uint32_t prng_next(simplex_prng_state_t* state, simplex_prng_type_t type) {
+    switch (type) {
     case SIMPLEX_PRG_LINEAR_CONGRUENTIAL:
-        return lcg_next();
+        return lcg_next(state);
     case SIMPLEX_PRG_MERSENNE_TWISTER:
-        return mersenne_next();
+        return mersenne_next(state);
     case SIMPLEX_PRG_XORSHIFT:
-        return (uint32_t)xorshift_next();
+        return (uint32_t)xorshift_next(state);
     case SIMPLEX_PRG_PCG:
-        return pcg_next();
+        return pcg_next(state);
     default:
-        return lcg_next();
+        return lcg_next(state);
     }
 }
 
-static void prng_init(uint32_t seed) {
-    switch (global_config.prng_type) {
+static void prng_init(simplex_prng_state_t* state, simplex_prng_type_t type, uint32_t seed) {
+    switch (type) {
     case SIMPLEX_PRG_LINEAR_CONGRUENTIAL:
-        prng_state.lcg_state = seed;
+        state->lcg_state = seed;
         break;
     case SIMPLEX_PRG_MERSENNE_TWISTER:
-        mersenne_init(seed);
+        mersenne_init(state, seed);
         break;
     case SIMPLEX_PRG_XORSHIFT:
-        xorshift_init(seed);
+        xorshift_init(state, seed);
         break;
     case SIMPLEX_PRG_PCG:
-        pcg_init(seed);
+        pcg_init(state, seed);
         break;
     default:
-        prng_state.lcg_state = seed;
+        state->lcg_state = seed;
         break;
     }
 }
@@ -274,64 +253,160 @@ simplex_config_t simplex_get_default_config(void) {
                                .cache_size_mb = 16.0,
                                .max_threads = 1,
                                .chunk_size = 1024,
-                               .memory_limit_mb = 256.0};
+                               .memory_limit_mb = 256.0,
+                               .enable_gpu = 0};
     return config;
 }
 
-int simplex_noise_init_advanced(const simplex_config_t* config) {
-    if (!config) {
-        return -1;
+// Pick the bulk kernels for a context's enable_simd / forced level
+static void context_select_kernels(simplex_context_t* ctx) {
+    if (!ctx->config.enable_simd) {
+        ctx->kernels = NULL;
+        ctx->kernels_f32 = &simplex_kernels_f32_scalar;
+        return;
+    }
+    simplex_simd_level_t level = ctx->simd_level_override >= 0
+                                     ? (simplex_simd_level_t)ctx->simd_level_override
+                                     : simplex_simd_detect();
+    if (ctx->simd_level_override >= 0) {
+        ctx->kernels = simplex_simd_kernels(level);
+    } else {
+        ctx->kernels = level == SIMPLEX_SIMD_SCALAR ? NULL : simplex_simd_kernels(level);
+    }
+    ctx->kernels_f32 = simplex_simd_kernels_f32(level);
+    if (!ctx->kernels_f32) {
+        ctx->kernels_f32 = &simplex_kernels_f32_scalar;
     }
-    global_config = *config;
+}
 
-    // Initialize PRNG
-    if (global_config.seed == 0) {
-        global_config.seed = (uint32_t)time(NULL);
+// Open or close the context's offload device for enable_gpu, uploading the current permutation
+static void context_select_gpu(simplex_context_t* ctx) {
+    if (ctx->config.enable_gpu && !ctx->gpu) {
+        ctx->gpu = simplex_gpu_create();
+    } else if (!ctx->config.enable_gpu && ctx->gpu) {
+        simplex_gpu_destroy(ctx->gpu);
+        ctx->gpu = NULL;
     }
-    prng_init(global_config.seed);
+    if (ctx->gpu && simplex_gpu_set_perm(ctx->gpu, ctx->tables.perm) != 0) {
+        simplex_gpu_destroy(ctx->gpu);
+        ctx->gpu = NULL;
+    }
+}
+
+// Tile cache budget for cache_size_mb
+static size_t cache_budget_bytes(const simplex_config_t* config) {
+    return (size_t)(config->cache_size_mb * 1024.0 * 1024.0);
+}
 
-    // Initialize permutation table
+// Shuffle a seed's permutation with `state`, leaving the PRNG where the shuffle ends
+static void build_tables(simplex_prng_state_t* state, simplex_prng_type_t type,
+                         simplex_perm_tables_t* tables) {
+    uint8_t* perm = tables->perm;
     for (int i = 0; i < PERMUTATION_SIZE; i++) {
-        perm[i] = i;
+        perm[i] = (uint8_t)i;
     }
 
     // Shuffle using selected PRNG
     for (int i = PERMUTATION_SIZE - 1; i > 0; i--) {
-        uint32_t j = prng_next() % (i + 1);
-        int temp = perm[i];
+        uint32_t j = prng_next(state, type) % (i + 1);
+        uint8_t temp = perm[i];
         perm[i] = perm[j];
         perm[j] = temp;
     }
 
-    // Duplicate for wrapping
+    // Duplicate for wrapping, and precompute the 3D gradient index of every entry
     for (int i = 0; i < PERMUTATION_SIZE; i++) {
         perm[PERMUTATION_SIZE + i] = perm[i];
     }
+    for (int i = 0; i < SIMPLEX_PERM_DOUBLE_SIZE; i++) {
+        tables->mod12[i] = (uint8_t)(perm[i] % SIMPLEX_3D_GRAD_COUNT);
+    }
+    memset(tables->gather_pad, 0, sizeof(tables->gather_pad));
+}
 
-    // Initialize performance stats
-    memset(&perf_stats, 0, sizeof(perf_stats));
-    function_call_count = 0;
+void simplex_perm_tables_build(simplex_prng_type_t prng_type, uint32_t seed,
+                               simplex_perm_tables_t* tables) {
+    simplex_prng_state_t state;
+    prng_init(&state, prng_type, seed);
+    build_tables(&state, prng_type, tables);
+}
 
-    // Initialize cache
-    if (global_config.enable_caching) {
-        cache_enabled = 1;
-        for (int i = 0; i < CACHE_SIZE; i++) {
-            noise_cache[i].valid = 0;
-        }
+/* Initialize `ctx` for `config`, taking the permutation from `tables` when
+ * given (precomputed for the config's PRNG and seed) instead of shuffling */
+static int context_init_tables(simplex_context_t* ctx, const simplex_config_t* config,
+                               const simplex_perm_tables_t* tables) {
+    if (!config) {
+        return -1;
+    }
+    ctx->config = *config;
+
+    // Initialize PRNG
+    if (ctx->config.seed == 0) {
+        ctx->config.seed = (uint32_t)time(NULL);
+    }
+    prng_init(&ctx->prng, ctx->config.prng_type, ctx->config.seed);
+    if (tables) {
+        ctx->tables = *tables;
+    } else {
+        build_tables(&ctx->prng, ctx->config.prng_type, &ctx->tables);
+    }
+
+    // Profiles outlive re-initialization; they are only cleared by a stats reset
+    if (!ctx->profiler) {
+        ctx->profiler = simplex_profiler_create();
+    }
+
+    // Tiles generated under the previous seed or settings are stale
+    ctx->cache_enabled = ctx->config.enable_caching ? 1 : 0;
+    if (ctx->tile_cache) {
+        simplex_tile_cache_reset(ctx->tile_cache, cache_budget_bytes(&ctx->config));
+        simplex_tile_cache_reset_stats(ctx->tile_cache);
+    } else {
+        ctx->tile_cache = simplex_tile_cache_create(cache_budget_bytes(&ctx->config));
     }
 
-    profiling_enabled = global_config.enable_profiling;
-    initialized = 1;
+    ctx->profiling_enabled = ctx->config.enable_profiling;
+    context_select_kernels(ctx);
+    context_select_gpu(ctx);
+    ctx->initialized = 1;
 
     return 0;
 }
 
+static int context_init(simplex_context_t* ctx, const simplex_config_t* config) {
+    return context_init_tables(ctx, config, NULL);
+}
+
+// Resolve NULL to the default context, initializing it on first use
+static const simplex_context_t* context_or_default(const simplex_context_t* ctx) {
+    if (ctx) {
+        return ctx;
+    }
+    if (!default_context.initialized) {
+        simplex_noise_init(0);
+    }
+    return &default_context;
+}
+
+const simplex_context_t* simplex_context_resolve(const simplex_context_t* ctx) {
+    return context_or_default(ctx);
+}
+
+int simplex_noise_init_advanced(const simplex_config_t* config) {
+    return context_init(&default_context, config);
+}
+
+int simplex_noise_init_tables(const simplex_config_t* config,
+                              const simplex_perm_tables_t* tables) {
+    return context_init_tables(&default_context, config, tables);
+}
+
 int simplex_set_prng(simplex_prng_type_t prng_type) {
     if (prng_type >= SIMPLEX_PRG_COUNT) {
         return -1;
     }
-    global_config.prng_type = prng_type;
-    prng_init(global_config.seed);
+    default_context.config.prng_type = prng_type;
+    prng_init(&default_context.prng, prng_type, default_context.config.seed);
     return 0;
 }
 
@@ -339,7 +414,7 @@ int simplex_set_noise_variant(simplex_noise_variant_t variant) {
     if (variant >= SIMPLEX_NOISE_COUNT) {
         return -1;
     }
-    global_config.noise_variant = variant;
+    default_context.config.noise_variant = variant;
     return 0;
 }
 
@@ -347,24 +422,119 @@ int simplex_set_interpolation(simplex_interp_type_t interp_type) {
     if (interp_type >= SIMPLEX_INTERP_COUNT) {
         return -1;
     }
-    global_config.interp_type = interp_type;
+    default_context.config.interp_type = interp_type;
     return 0;
 }
 
 int simplex_set_simd(int enable) {
-    global_config.enable_simd = enable ? 1 : 0;
+    default_context.config.enable_simd = enable ? 1 : 0;
+    default_context.simd_level_override = -1;
+    context_select_kernels(&default_context);
     return 0;
 }
 
+int simplex_set_simd_level(simplex_simd_level_t level) {
+    if (!simplex_simd_kernels(level)) {
+        return -1;
+    }
+    default_context.config.enable_simd = 1;
+    default_context.simd_level_override = (int)level;
+    context_select_kernels(&default_context);
+    return 0;
+}
+
+simplex_simd_level_t simplex_get_simd_level(void) {
+    const simplex_kernels_t* kernels = default_context.kernels;
+    return kernels ? kernels->level : SIMPLEX_SIMD_SCALAR;
+}
+
+const char* simplex_get_simd_level_name(simplex_simd_level_t level) {
+    static const char* const names[SIMPLEX_SIMD_COUNT] = {"scalar", "sse4.1", "avx2", "avx512",
+                                                          "neon"};
+    if ((int)level < 0 || level >= SIMPLEX_SIMD_COUNT) {
+        return "unknown";
+    }
+    return names[level];
+}
+
+int simplex_set_gpu(int enable) {
+    default_context.config.enable_gpu = enable ? 1 : 0;
+    context_select_gpu(&default_context);
+    if (enable && !default_context.gpu) {
+        default_context.config.enable_gpu = 0;
+        return -1;
+    }
+    return 0;
+}
+
+const char* simplex_get_gpu_name(void) {
+    return simplex_gpu_name(default_context.gpu);
+}
+
+const char* simplex_get_gpu_name_ctx(const simplex_context_t* ctx) {
+    return simplex_gpu_name(context_or_default(ctx)->gpu);
+}
+
 int simplex_set_caching(int enable) {
-    global_config.enable_caching = enable ? 1 : 0;
-    cache_enabled = enable ? 1 : 0;
+    default_context.config.enable_caching = enable ? 1 : 0;
+    default_context.cache_enabled = enable ? 1 : 0;
+    if (!enable && default_context.tile_cache) {
+        simplex_tile_cache_reset(default_context.tile_cache,
+                                 cache_budget_bytes(&default_context.config));
+    }
     return 0;
 }
 
 int simplex_set_profiling(int enable) {
-    global_config.enable_profiling = enable ? 1 : 0;
-    profiling_enabled = enable ? 1 : 0;
+    default_context.config.enable_profiling = enable ? 1 : 0;
+    default_context.profiling_enabled = enable ? 1 : 0;
+    return 0;
+}
+
+int simplex_set_max_threads(int max_threads) {
+    if (max_threads < 1 || max_threads > MAX_THREADS) {
+        return -1;
+    }
+    default_context.config.max_threads = max_threads;
+    return 0;
+}
+
+/* ===== NOISE CONTEXTS ===== */
+
+simplex_context_t* simplex_context_create(const simplex_config_t* config) {
+    simplex_config_t defaults = simplex_get_default_config();
+    return simplex_context_create_tables(config ? config : &defaults, NULL);
+}
+
+simplex_context_t* simplex_context_create_tables(const simplex_config_t* config,
+                                                 const simplex_perm_tables_t* tables) {
+    simplex_context_t* ctx = calloc(1, sizeof(*ctx));
+    if (!ctx) {
+        return NULL;
+    }
+    ctx->simd_level_override = -1;
+
+    if (context_init_tables(ctx, config, tables) != 0) {
+        free(ctx);
+        return NULL;
+    }
+    return ctx;
+}
+
+void simplex_context_destroy(simplex_context_t* ctx) {
+    if (ctx) {
+        simplex_tile_cache_destroy(ctx->tile_cache);
+        simplex_profiler_destroy(ctx->profiler);
+        simplex_gpu_destroy(ctx->gpu);
+    }
+    free(ctx);
+}
+
+int simplex_context_get_config(const simplex_context_t* ctx, simplex_config_t* config) {
+    if (!config) {
+        return -1;
+    }
+    *config = context_or_default(ctx)->config;
     return 0;
 }
 
@@ -446,6 +616,8 @@ static int load_ini_config(const char* filename, simplex_config_t* config) {
                 config->seed = (uint32_t)atoll(value);
             } else if (strcmp(key, "enable_simd") == 0) {
                 config->enable_simd = atoi(value);
+            } else if (strcmp(key, "enable_gpu") == 0) {
+                config->enable_gpu = atoi(value);
             } else if (strcmp(key, "enable_caching") == 0) {
                 config->enable_caching = atoi(value);
             } else if (strcmp(key, "enable_profiling") == 0) {
@@ -512,6 +684,7 @@ static int save_ini_config(const char* filename, const simplex_config_t* config)
 
     fprintf(file, "\n[performance]\n");
     fprintf(file, "enable_simd=%d\n", config->enable_simd);
+    fprintf(file, "enable_gpu=%d\n", config->enable_gpu);
     fprintf(file, "enable_caching=%d\n", config->enable_caching);
     fprintf(file, "enable_profiling=%d\n", config->enable_profiling);
     fprintf(file, "cache_size_mb=%.2f\n", config->cache_size_mb);
@@ -576,6 +749,8 @@ static int load_json_config(const char* filename, simplex_config_t* config) {
             sscanf(line, "\"seed\" : %u", &config->seed);
         } else if (strstr(line, "\"enable_simd\"") && strchr(line, ':')) {
             sscanf(line, "\"enable_simd\" : %d", &config->enable_simd);
+        } else if (strstr(line, "\"enable_gpu\"") && strchr(line, ':')) {
+            sscanf(line, "\"enable_gpu\" : %d", &config->enable_gpu);
         } else if (strstr(line, "\"enable_caching\"") && strchr(line, ':')) {
             sscanf(line, "\"enable_caching\" : %d", &config->enable_caching);
         } else if (strstr(line, "\"enable_profiling\"") && strchr(line, ':')) {
@@ -638,6 +813,7 @@ static int save_json_config(const char* filename, const simplex_config_t* config
     fprintf(file, "    },\n");
     fprintf(file, "    \"performance\": {\n");
     fprintf(file, "      \"enable_simd\": %d,\n", config->enable_simd);
+    fprintf(file, "      \"enable_gpu\": %d,\n", config->enable_gpu);
     fprintf(file, "      \"enable_caching\": %d,\n", config->enable_caching);
     fprintf(file, "      \"enable_profiling\": %d,\n", config->enable_profiling);
     fprintf(file, "      \"cache_size_mb\": %.2f,\n", config->cache_size_mb);
@@ -669,6 +845,17 @@ static int save_json_config(const char* filename, const simplex_config_t* config
     return 0;
 }
 
+// Load the configuration from a binary blob, ignoring any seed tables
+static int load_binary_config(const char* filename, simplex_config_t* config) {
+    simplex_config_blob_t* blob = simplex_config_blob_open(filename);
+    if (!blob) {
+        return -1;
+    }
+    *config = *simplex_config_blob_config(blob);
+    simplex_config_blob_close(blob);
+    return 0;
+}
+
 // Public configuration management functions
 int simplex_load_config(const char* filename, simplex_config_type_t config_type,
                         simplex_config_t* config) {
@@ -687,8 +874,7 @@ int simplex_load_config(const char* filename, simplex_config_type_t config_type,
         // YAML support would go here
         return -1;  // Not implemented yet
     case SIMPLEX_CONFIG_BINARY:
-        // Binary support would go here
-        return -1;  // Not implemented yet
+        return load_binary_config(filename, config);
     default:
         return -1;
     }
@@ -708,8 +894,7 @@ int simplex_save_config(const char* filename, simplex_config_type_t config_type,
         // YAML support would go here
         return -1;  // Not implemented yet
     case SIMPLEX_CONFIG_BINARY:
-        // Binary support would go here
-        return -1;  // Not implemented yet
+        return simplex_save_config_binary(filename, config, NULL, 0);
     default:
         return -1;
     }
@@ -823,6 +1008,9 @@ int simplex_merge_config(const simplex_config_t* base, const simplex_config_t* o
     if (override->enable_simd != 0) {
         result->enable_simd = override->enable_simd;
     }
+    if (override->enable_gpu != 0) {
+        result->enable_gpu = override->enable_gpu;
+    }
     if (override->enable_caching != 1) {
         result->enable_caching = override->enable_caching;
     }
@@ -905,6 +1093,8 @@ int simplex_get_config_string(const simplex_config_t* config, const char* key, c
         snprintf(value, max_len, "%u", config->seed);
     } else if (strcmp(key, "enable_simd") == 0) {
         snprintf(value, max_len, "%d", config->enable_simd);
+    } else if (strcmp(key, "enable_gpu") == 0) {
+        snprintf(value, max_len, "%d", config->enable_gpu);
     } else if (strcmp(key, "enable_caching") == 0) {
         snprintf(value, max_len, "%d", config->enable_caching);
     } else if (strcmp(key, "enable_profiling") == 0) {
@@ -966,6 +1156,8 @@ int simplex_set_config_string(simplex_config_t* config, const char* key, const c
         config->seed = (uint32_t)atoll(value);
     } else if (strcmp(key, "enable_simd") == 0) {
         config->enable_simd = atoi(value);
+    } else if (strcmp(key, "enable_gpu") == 0) {
+        config->enable_gpu = atoi(value);
     } else if (strcmp(key, "enable_caching") == 0) {
         config->enable_caching = atoi(value);
     } else if (strcmp(key, "enable_profiling") == 0) {
@@ -1083,6 +1275,8 @@ int simplex_get_config_int(const simplex_config_t* config, const char* key, int*
         *value = (int)config->seed;
     } else if (strcmp(key, "enable_simd") == 0) {
         *value = config->enable_simd;
+    } else if (strcmp(key, "enable_gpu") == 0) {
+        *value = config->enable_gpu;
     } else if (strcmp(key, "enable_caching") == 0) {
         *value = config->enable_caching;
     } else if (strcmp(key, "enable_profiling") == 0) {
@@ -1124,6 +1318,8 @@ int simplex_set_config_int(simplex_config_t* config, const char* key, int value)
         config->seed = (uint32_t)value;
     } else if (strcmp(key, "enable_simd") == 0) {
         config->enable_simd = value;
+    } else if (strcmp(key, "enable_gpu") == 0) {
+        config->enable_gpu = value;
     } else if (strcmp(key, "enable_caching") == 0) {
         config->enable_caching = value;
     } else if (strcmp(key, "enable_profiling") == 0) {
@@ -1173,6 +1369,7 @@ int simplex_print_config(const simplex_config_t* config, int format) {
         printf("  Seed: %u\n", config->seed);
         printf("\nPerformance Settings:\n");
         printf("  SIMD Enabled: %d\n", config->enable_simd);
+        printf("  GPU Enabled: %d\n", config->enable_gpu);
         printf("  Caching Enabled: %d\n", config->enable_caching);
         printf("  Profiling Enabled: %d\n", config->enable_profiling);
         printf("  Cache Size: %.2f MB\n", config->cache_size_mb);
@@ -1206,6 +1403,7 @@ int simplex_print_config(const simplex_config_t* config, int format) {
         printf("    },\n");
         printf("    \"performance\": {\n");
         printf("      \"enable_simd\": %d,\n", config->enable_simd);
+        printf("      \"enable_gpu\": %d,\n", config->enable_gpu);
         printf("      \"enable_caching\": %d,\n", config->enable_caching);
         printf("      \"enable_profiling\": %d,\n", config->enable_profiling);
         printf("      \"cache_size_mb\": %.2f,\n", config->cache_size_mb);
@@ -1248,79 +1446,99 @@ int simplex_create_example_config(const char* filename, simplex_config_type_t co
 /* ===== PERFORMANCE TRACKING ===== */
 
 int simplex_get_performance_stats(simplex_perf_stats_t* stats) {
+    return simplex_get_performance_stats_ctx(&default_context, stats);
+}
+
+int simplex_get_performance_stats_ctx(const simplex_context_t* ctx, simplex_perf_stats_t* stats) {
     if (!stats) {
         return -1;
     }
-    *stats = perf_stats;
+    ctx = ctx ? ctx : &default_context;
+    memset(stats, 0, sizeof(*stats));
+    for (int api = 0; api < SIMPLEX_PROFILE_API_COUNT; api++) {
+        simplex_profile_entry_t entry;
+        simplex_profiler_read(ctx->profiler, (simplex_profile_api_t)api, &entry);
+        stats->function_calls += entry.calls;
+        stats->generation_time += entry.total_time;
+    }
+    if (stats->function_calls > 0) {
+        stats->average_execution_time =
+            stats->generation_time * 1e6 / (double)stats->function_calls;
+    }
+    if (ctx->tile_cache) {
+        simplex_tile_cache_get_stats(ctx->tile_cache, stats);
+    }
     return 0;
 }
 
 void simplex_reset_performance_stats(void) {
-    memset(&perf_stats, 0, sizeof(perf_stats));
-    function_call_count = 0;
-    cache_hits = 0;
-    cache_misses = 0;
+    simplex_reset_performance_stats_ctx(&default_context);
 }
 
-size_t simplex_get_function_call_count(void) {
-    return function_call_count;
+void simplex_reset_performance_stats_ctx(simplex_context_t* ctx) {
+    if (!ctx) {
+        ctx = &default_context;
+    }
+    simplex_profiler_reset(ctx->profiler);
+    if (ctx->tile_cache) {
+        simplex_tile_cache_reset_stats(ctx->tile_cache);
+    }
 }
 
-int simplex_get_cache_hits(void) {
-    return cache_hits;
+size_t simplex_get_function_call_count(void) {
+    simplex_perf_stats_t stats;
+    simplex_get_performance_stats(&stats);
+    return stats.function_calls;
 }
 
-int simplex_get_cache_misses(void) {
-    return cache_misses;
+int simplex_get_profile(simplex_profile_api_t api, simplex_profile_entry_t* entry) {
+    return simplex_get_profile_ctx(&default_context, api, entry);
 }
 
-/* ===== CACHING SYSTEM ===== */
-/* Note: These functions are part of the advanced API and are intentionally
- * unused in the current implementation. They provide caching capabilities
- * for future performance optimizations. */
+int simplex_get_profile_ctx(const simplex_context_t* ctx, simplex_profile_api_t api,
+                            simplex_profile_entry_t* entry) {
+    if (!entry) {
+        return -1;
+    }
+    memset(entry, 0, sizeof(*entry));
+    if ((int)api < 0 || api >= SIMPLEX_PROFILE_API_COUNT) {
+        return -1;
+    }
+    ctx = ctx ? ctx : &default_context;
+    simplex_profiler_read(ctx->profiler, api, entry);
+#if defined(SIMPLEX_ENABLE_PROFILING)
+    return 0;
+#else
+    return -1;
+#endif
+}
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wunused-function"
+int simplex_get_cache_hits(void) {
+    simplex_perf_stats_t stats;
+    simplex_get_performance_stats(&stats);
+    return (int)stats.cache_hits;
+}
 
-static double cache_lookup(double x, double y, double z, double w) {
-    if (!cache_enabled) {
-        return 0.0;
-    }
+int simplex_get_cache_misses(void) {
+    simplex_perf_stats_t stats;
+    simplex_get_performance_stats(&stats);
+    return (int)stats.cache_misses;
+}
 
-    int hash = ((int)(x * CACHE_HASH_MULTIPLIER) ^ (int)(y * CACHE_HASH_MULTIPLIER) ^
-                (int)(z * CACHE_HASH_MULTIPLIER) ^ (int)(w * CACHE_HASH_MULTIPLIER)) %
-               CACHE_SIZE;
-    if (hash < 0) {
-        hash = -hash;
-    }
-    if (noise_cache[hash].valid && fabs(noise_cache[hash].x - x) < CACHE_EPSILON &&
-        fabs(noise_cache[hash].y - y) < CACHE_EPSILON &&
-        fabs(noise_cache[hash].z - z) < CACHE_EPSILON &&
-        fabs(noise_cache[hash].w - w) < CACHE_EPSILON) {
-        cache_hits++;
-        return noise_cache[hash].result;
-    }
+/* ===== TILE CACHE ===== */
 
-    cache_misses++;
-    return 0.0;
+const double* simplex_tile_acquire(const simplex_tile_request_t* request) {
+    return simplex_tile_acquire_ctx(NULL, request);
 }
 
-static void cache_store(double x, double y, double z, double w, double result) {
-    if (!cache_enabled) {
-        return;
-    }
-    int hash = ((int)(x * CACHE_HASH_MULTIPLIER) ^ (int)(y * CACHE_HASH_MULTIPLIER) ^
-                (int)(z * CACHE_HASH_MULTIPLIER) ^ (int)(w * CACHE_HASH_MULTIPLIER)) %
-               CACHE_SIZE;
-    if (hash < 0) {
-        hash = -hash;
-    }
-    noise_cache[hash].x = x;
-    noise_cache[hash].y = y;
-    noise_cache[hash].z = z;
-    noise_cache[hash].w = w;
-    noise_cache[hash].result = result;
-    noise_cache[hash].valid = 1;
+const double* simplex_tile_acquire_ctx(const simplex_context_t* ctx,
+                                       const simplex_tile_request_t* request) {
+    ctx = context_or_default(ctx);
+    SIMPLEX_PROFILE_BEGIN(ctx);
+    const double* tile = simplex_tile_cache_acquire(ctx->tile_cache, ctx, request);
+    SIMPLEX_PROFILE_END(ctx, SIMPLEX_PROFILE_TILE_ACQUIRE,
+                        tile ? (size_t)request->resolution * (size_t)request->resolution : 0);
+    return tile;
 }
 
 /* ===== ADVANCED INTERPOLATION ===== */
@@ -1328,6 +1546,9 @@ static void cache_store(double x, double y, double z, double w, double result) {
  * unused in the current implementation. They provide advanced interpolation
  * capabilities for future enhancements. */
 
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+
 static double interpolate(double t, simplex_interp_type_t type) {
     switch (type) {
     case SIMPLEX_INTERP_LINEAR:
@@ -1360,10 +1581,25 @@ static int fast_floor(double x) {
     return x > 0 ? (int)x : (int)x - 1;
 }
 
+// Base kernels and row walkers, defined with simplex_noise_2d_ctx() and simplex_noise_3d_ctx()
+static inline double noise_2d_kernel(const simplex_perm_tables_t* tables, double x, double y);
+static inline double noise_3d_kernel(const simplex_perm_tables_t* tables, double x, double y,
+                                      double z);
+static void noise_row_2d(const simplex_perm_tables_t* tables, double x_start, double y,
+                         double step, int count, double* output);
+static void noise_row_3d(const simplex_perm_tables_t* tables, double x_start, double y,
+                         double z, double step, int count, double* output);
+static inline int64_t split_local(int64_t origin, double local, double* fraction);
+static void origin_row_2d(const simplex_perm_tables_t* tables, int64_t origin_x, double x_offset,
+                          int64_t iy, double fy, double step, int count, double* output);
+static void origin_row_3d(const simplex_perm_tables_t* tables, int64_t origin_x, double x_offset,
+                          int64_t iy, double fy, int64_t iz, double fz, double step, int count,
+                          double* output);
+
 /* Note: This function is part of the advanced API and is intentionally
  * unused in the current implementation. It provides advanced permutation
  * initialization for future enhancements. */
-static void init_permutation(unsigned int seed) {
+static void init_permutation(int* perm, unsigned int seed) {
     if (seed == 0) {
         seed = (unsigned int)time(NULL);
     }
@@ -1399,304 +1635,1910 @@ void simplex_noise_init(unsigned int seed) {
 
 // Ridged noise implementation
 double simplex_ridged_1d(double x) {
-    double noise = simplex_noise_1d(x);
-    return 1.0 - fabs(noise);
+    return simplex_ridged_1d_ctx(NULL, x);
+}
+
+double simplex_ridged_1d_ctx(const simplex_context_t* ctx, double x) {
+    ctx = context_or_default(ctx);
+    SIMPLEX_PROFILE_BEGIN(ctx);
+    double noise = simplex_noise_1d_ctx(ctx, x);
+    double result = 1.0 - fabs(noise);
+    SIMPLEX_PROFILE_END(ctx, SIMPLEX_PROFILE_RIDGED, 1);
+    return result;
 }
 
 double simplex_ridged_2d(double x, double y) {
-    double noise = simplex_noise_2d(x, y);
-    return 1.0 - fabs(noise);
+    return simplex_ridged_2d_ctx(NULL, x, y);
+}
+
+double simplex_ridged_2d_ctx(const simplex_context_t* ctx, double x, double y) {
+    ctx = context_or_default(ctx);
+    SIMPLEX_PROFILE_BEGIN(ctx);
+    double noise = simplex_noise_2d_ctx(ctx, x, y);
+    double result = 1.0 - fabs(noise);
+    SIMPLEX_PROFILE_END(ctx, SIMPLEX_PROFILE_RIDGED, 1);
+    return result;
 }
 
 double simplex_ridged_3d(double x, double y, double z) {
-    double noise = simplex_noise_3d(x, y, z);
-    return 1.0 - fabs(noise);
+    return simplex_ridged_3d_ctx(NULL, x, y, z);
+}
+
+double simplex_ridged_3d_ctx(const simplex_context_t* ctx, double x, double y, double z) {
+    ctx = context_or_default(ctx);
+    SIMPLEX_PROFILE_BEGIN(ctx);
+    double noise = simplex_noise_3d_ctx(ctx, x, y, z);
+    double result = 1.0 - fabs(noise);
+    SIMPLEX_PROFILE_END(ctx, SIMPLEX_PROFILE_RIDGED, 1);
+    return result;
 }
 
 // Billowy noise implementation
 double simplex_billowy_1d(double x) {
-    double noise = simplex_noise_1d(x);
-    return fabs(noise);
+    return simplex_billowy_1d_ctx(NULL, x);
+}
+
+double simplex_billowy_1d_ctx(const simplex_context_t* ctx, double x) {
+    ctx = context_or_default(ctx);
+    SIMPLEX_PROFILE_BEGIN(ctx);
+    double noise = simplex_noise_1d_ctx(ctx, x);
+    double result = fabs(noise);
+    SIMPLEX_PROFILE_END(ctx, SIMPLEX_PROFILE_BILLOWY, 1);
+    return result;
 }
 
 double simplex_billowy_2d(double x, double y) {
-    double noise = simplex_noise_2d(x, y);
-    return fabs(noise);
+    return simplex_billowy_2d_ctx(NULL, x, y);
+}
+
+double simplex_billowy_2d_ctx(const simplex_context_t* ctx, double x, double y) {
+    ctx = context_or_default(ctx);
+    SIMPLEX_PROFILE_BEGIN(ctx);
+    double noise = simplex_noise_2d_ctx(ctx, x, y);
+    double result = fabs(noise);
+    SIMPLEX_PROFILE_END(ctx, SIMPLEX_PROFILE_BILLOWY, 1);
+    return result;
 }
 
 double simplex_billowy_3d(double x, double y, double z) {
-    double noise = simplex_noise_3d(x, y, z);
-    return fabs(noise);
+    return simplex_billowy_3d_ctx(NULL, x, y, z);
+}
+
+double simplex_billowy_3d_ctx(const simplex_context_t* ctx, double x, double y, double z) {
+    ctx = context_or_default(ctx);
+    SIMPLEX_PROFILE_BEGIN(ctx);
+    double noise = simplex_noise_3d_ctx(ctx, x, y, z);
+    double result = fabs(noise);
+    SIMPLEX_PROFILE_END(ctx, SIMPLEX_PROFILE_BILLOWY, 1);
+    return result;
 }
 
 // Fractional Brownian Motion (fBm)
 double simplex_fbm_2d(double x, double y, int octaves, double persistence, double lacunarity) {
+    return simplex_fbm_2d_ctx(NULL, x, y, octaves, persistence, lacunarity);
+}
+
+double simplex_fbm_2d_ctx(const simplex_context_t* ctx, double x, double y, int octaves,
+                          double persistence, double lacunarity) {
+    ctx = context_or_default(ctx);
+    SIMPLEX_PROFILE_BEGIN(ctx);
     double value = 0.0;
     double amplitude = 1.0;
     double frequency = 1.0;
     double maxValue = 0.0;
 
     for (int i = 0; i < octaves; i++) {
-        value += simplex_noise_2d(x * frequency, y * frequency) * amplitude;
+        value += noise_2d_kernel(&ctx->tables, x * frequency, y * frequency) * amplitude;
         maxValue += amplitude;
         amplitude *= persistence;
         frequency *= lacunarity;
     }
 
-    return value / maxValue;
+    double result = value / maxValue;
+    SIMPLEX_PROFILE_END(ctx, SIMPLEX_PROFILE_FBM, 1);
+    return result;
 }
 
 double simplex_fbm_3d(double x, double y, double z, int octaves, double persistence,
                       double lacunarity) {
+    return simplex_fbm_3d_ctx(NULL, x, y, z, octaves, persistence, lacunarity);
+}
+
+double simplex_fbm_3d_ctx(const simplex_context_t* ctx, double x, double y, double z, int octaves,
+                          double persistence, double lacunarity) {
+    ctx = context_or_default(ctx);
+    SIMPLEX_PROFILE_BEGIN(ctx);
     double value = 0.0;
     double amplitude = 1.0;
     double frequency = 1.0;
     double maxValue = 0.0;
 
     for (int i = 0; i < octaves; i++) {
-        value += simplex_noise_3d(x * frequency, y * frequency, z * frequency) * amplitude;
+        value +=
+            noise_3d_kernel(&ctx->tables, x * frequency, y * frequency, z * frequency) * amplitude;
         maxValue += amplitude;
         amplitude *= persistence;
         frequency *= lacunarity;
     }
 
-    return value / maxValue;
+    double result = value / maxValue;
+    SIMPLEX_PROFILE_END(ctx, SIMPLEX_PROFILE_FBM, 1);
+    return result;
 }
 
 // Hybrid Multi-Fractal
 double simplex_hybrid_multifractal_2d(double x, double y, int octaves, double persistence,
                                       double lacunarity, double offset) {
+    return simplex_hybrid_multifractal_2d_ctx(NULL, x, y, octaves, persistence, lacunarity,
+                                              offset);
+}
+
+double simplex_hybrid_multifractal_2d_ctx(const simplex_context_t* ctx, double x, double y,
+                                          int octaves, double persistence, double lacunarity,
+                                          double offset) {
+    ctx = context_or_default(ctx);
+    SIMPLEX_PROFILE_BEGIN(ctx);
     double value = 1.0;
     double amplitude = 1.0;
     double frequency = 1.0;
 
     for (int i = 0; i < octaves; i++) {
-        double noise = simplex_noise_2d(x * frequency, y * frequency);
+        double noise = noise_2d_kernel(&ctx->tables, x * frequency, y * frequency);
         value *= (offset + fabs(noise)) * amplitude;
         amplitude *= persistence;
         frequency *= lacunarity;
     }
 
+    SIMPLEX_PROFILE_END(ctx, SIMPLEX_PROFILE_HYBRID_MULTIFRACTAL, 1);
     return value;
 }
 
 // Domain Warping
 double simplex_domain_warp_2d(double x, double y, double warp_strength) {
-    double warp_x = x + (simplex_noise_2d(x, y) * warp_strength);
-    double warp_y =
-        y + (simplex_noise_2d(x + DOMAIN_WARP_OFFSET, y + DOMAIN_WARP_OFFSET) * warp_strength);
-    return simplex_noise_2d(warp_x, warp_y);
+    return simplex_domain_warp_2d_ctx(NULL, x, y, warp_strength);
 }
 
-/* ===== PERFORMANCE & UTILITY FUNCTIONS ===== */
+double simplex_domain_warp_2d_ctx(const simplex_context_t* ctx, double x, double y,
+                                  double warp_strength) {
+    ctx = context_or_default(ctx);
+    SIMPLEX_PROFILE_BEGIN(ctx);
+    double warp_x = x + (simplex_noise_2d_ctx(ctx, x, y) * warp_strength);
+    double warp_y = y + (simplex_noise_2d_ctx(ctx, x + DOMAIN_WARP_OFFSET, y + DOMAIN_WARP_OFFSET) *
+                         warp_strength);
+    double result = simplex_noise_2d_ctx(ctx, warp_x, warp_y);
+    SIMPLEX_PROFILE_END(ctx, SIMPLEX_PROFILE_DOMAIN_WARP, 1);
+    return result;
+}
 
-int simplex_noise_array_2d(double x_start, double y_start, int width, int height, double step,
-                           double* output) {
-    if (!output || width <= 0 || height <= 0) {
-        return -1;
-    }
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            double noise_x = x_start + (x * step);
-            double noise_y = y_start + (y * step);
-            output[(y * width) + x] = simplex_noise_2d(noise_x, noise_y);
-        }
+simplex_warp_config_t simplex_get_default_warp_config(void) {
+    simplex_warp_config_t warp = {.levels = 1,
+                                  .strength = 1.0,
+                                  .octaves = 1,
+                                  .persistence = 0.5,
+                                  .lacunarity = 2.0,
+                                  .offsets = {{0.0, 0.0, DOMAIN_WARP_OFFSET, DOMAIN_WARP_OFFSET},
+                                              {1.7, 9.2, 8.3, 2.8}}};
+    return warp;
+}
+
+// Whether a warp and base octave count describe a warp that can be evaluated
+static int warp_config_valid(const simplex_warp_config_t* warp, int octaves) {
+    return octaves > 0 && warp->levels >= 1 && warp->levels <= SIMPLEX_WARP_MAX_LEVELS &&
+           warp->octaves > 0;
+}
+
+// simplex_fbm_2d_ctx() without the profiling, for the warp fields
+static double warp_fbm_2d(const simplex_context_t* ctx, double x, double y, int octaves,
+                          double persistence, double lacunarity) {
+    double value = 0.0;
+    double amplitude = 1.0;
+    double frequency = 1.0;
+    double max_value = 0.0;
+    for (int i = 0; i < octaves; i++) {
+        value += noise_2d_kernel(&ctx->tables, x * frequency, y * frequency) * amplitude;
+        max_value += amplitude;
+        amplitude *= persistence;
+        frequency *= lacunarity;
     }
+    return value / max_value;
+}
 
-    return 0;
+double simplex_domain_warp_fbm_2d(double x, double y, int octaves, double persistence,
+                                  double lacunarity, const simplex_warp_config_t* warp) {
+    return simplex_domain_warp_fbm_2d_ctx(NULL, x, y, octaves, persistence, lacunarity, warp);
 }
 
-int simplex_noise_array_3d(double x_start, double y_start, double z_start, int width, int height,
-                           int depth, double step, double* output) {
-    if (!output || width <= 0 || height <= 0 || depth <= 0) {
-        return -1;
+double simplex_domain_warp_fbm_2d_ctx(const simplex_context_t* ctx, double x, double y,
+                                      int octaves, double persistence, double lacunarity,
+                                      const simplex_warp_config_t* warp) {
+    simplex_warp_config_t defaults = simplex_get_default_warp_config();
+    warp = warp ? warp : &defaults;
+    if (!warp_config_valid(warp, octaves)) {
+        return 0.0;
     }
-    for (int z = 0; z < depth; z++) {
-        for (int y = 0; y < height; y++) {
-            for (int x = 0; x < width; x++) {
-                double noise_x = x_start + (x * step);
-                double noise_y = y_start + (y * step);
-                double noise_z = z_start + (z * step);
-                output[(((z * height) + y) * width) + x] =
-                    simplex_noise_3d(noise_x, noise_y, noise_z);
-            }
-        }
+    ctx = context_or_default(ctx);
+    SIMPLEX_PROFILE_BEGIN(ctx);
+    double warp_x = x;
+    double warp_y = y;
+    for (int level = 0; level < warp->levels; level++) {
+        const double* offsets = warp->offsets[level];
+        double dx = warp_fbm_2d(ctx, warp_x + offsets[0], warp_y + offsets[1], warp->octaves,
+                                warp->persistence, warp->lacunarity);
+        double dy = warp_fbm_2d(ctx, warp_x + offsets[2], warp_y + offsets[3], warp->octaves,
+                                warp->persistence, warp->lacunarity);
+        warp_x = x + (dx * warp->strength);
+        warp_y = y + (dy * warp->strength);
     }
-
-    return 0;
+    double result = warp_fbm_2d(ctx, warp_x, warp_y, octaves, persistence, lacunarity);
+    SIMPLEX_PROFILE_END(ctx, SIMPLEX_PROFILE_DOMAIN_WARP, 1);
+    return result;
 }
 
-void simplex_cleanup(void) {
-    // Reset all state
-    initialized = 0;
-    cache_enabled = 0;
-    profiling_enabled = 0;
+/* ===== PERFORMANCE & UTILITY FUNCTIONS ===== */
 
-    // Clear cache
-    for (int i = 0; i < CACHE_SIZE; i++) {
-        noise_cache[i].valid = 0;
+/* Samples per fractal tile: each octave sweeps a whole tile before the next
+ * one starts, and the tile's coordinate and noise buffers stay in L1 */
+enum { FRACTAL_TILE_SAMPLES = 512 };
+
+// Fewest grid samples worth a device round trip (a 256x256 array)
+enum { GPU_MIN_SAMPLES = 65536 };
+
+/* Largest integer origin of a chunk-origin array, so lattice sums stay exact
+ * in a double, and largest local coordinate, so local cells fit in an int */
+#define ORIGIN_LIMIT (INT64_C(1) << 50)
+#define ORIGIN_LOCAL_LIMIT 2147483647.0
+
+typedef enum {
+    ARRAY_NOISE = 0,
+    ARRAY_FBM,
+    ARRAY_HYBRID_MULTIFRACTAL,
+    ARRAY_RIDGED,
+    ARRAY_BILLOWY
+} array_kind_t;
+
+// Element type of an array's output buffer
+typedef enum { SAMPLES_F64 = 0, SAMPLES_F32, SAMPLES_U16 } sample_format_t;
+
+struct array_job;
+
+// Evaluates one tile of a job: `count` samples at (x, y, z) into output
+typedef void (*fractal_tile_fn)(const struct array_job* job, const double* x, const double* y,
+                                const double* z, int count, double* output);
+
+// One bulk request, split into rows for simplex_parallel_for()
+typedef struct array_job {
+    const simplex_context_t* ctx;
+    array_kind_t kind;
+    sample_format_t format;
+    int single; /* Evaluate noise with the float32 kernels (precision == SINGLE) */
+    int dims;
+    double x_start;
+    double y_start;
+    double z_start;
+    double step;
+    int width;
+    int height;
+    int octaves;
+    double persistence;
+    double lacunarity;
+    double offset;
+    void* output;
+
+    /* Scattered-point jobs (width and height unused) */
+    const double* xs;
+    const double* ys;
+    const double* zs;
+    const double* ws;
+    size_t count;
+
+    /* Float or interleaved points, gathered a tile at a time when xs is NULL */
+    const void* axes[4]; /* First coordinate of each axis */
+    size_t stride;       /* Elements between consecutive coordinates of an axis */
+    int axes_f32;
+
+    const simplex_warp_config_t* warp; /* Warp fields of a warped grid */
+    fractal_tile_fn tile;              /* Chosen once per call by select_fractal_tile() */
+
+    /* Integer lattice origin of a chunk-origin job; x/y/z_start are then local offsets */
+    int64_t origin[3];
+} array_job_t;
+
+// Run rows [0, rows) of a job with the context's max_threads and chunk_size
+static void run_array_job(array_job_t* job, int rows, simplex_range_fn fn) {
+    const simplex_config_t* config = &job->ctx->config;
+    int chunk_size = config->chunk_size > 0 ? config->chunk_size : DEFAULT_CHUNK_SIZE;
+    int rows_per_task = chunk_size / job->width;
+    if (rows_per_task < 1) {
+        rows_per_task = 1;
+    }
+    simplex_parallel_for(rows, rows_per_task, config->max_threads, fn, job);
+}
+
+/* Double-precision noise straight into a double buffer, one row per kernel
+ * call. Rows of a 3D job are numbered z * height + y; 2D jobs have one slice. */
+static void noise_rows(void* arg, int begin, int end) {
+    const array_job_t* job = arg;
+    const simplex_context_t* ctx = job->ctx;
+    double step = job->step;
+    int width = job->width;
+
+    for (int r = begin; r < end; r++) {
+        double noise_y = job->y_start + ((r % job->height) * step);
+        double noise_z = job->z_start + ((r / job->height) * step);
+        double* row = (double*)job->output + ((size_t)r * width);
+        if (ctx->kernels) {
+            if (job->dims == 2) {
+                ctx->kernels->row_2d(&ctx->tables, job->x_start, noise_y, step, width, row);
+            } else {
+                ctx->kernels->row_3d(&ctx->tables, job->x_start, noise_y, noise_z, step, width,
+                                     row);
+            }
+            continue;
+        }
+        if (job->dims == 2) {
+            noise_row_2d(&ctx->tables, job->x_start, noise_y, step, width, row);
+        } else {
+            noise_row_3d(&ctx->tables, job->x_start, noise_y, noise_z, step, width, row);
+        }
     }
-
-    // Reset performance stats
-    simplex_reset_performance_stats();
 }
 
-double simplex_noise_1d(double x) {
-    if (!initialized) {
-        simplex_noise_init(0);
+/* Chunk-origin noise into doubles, one row per call. Each row's y and z are
+ * split into cell and fraction once; they are never rounded into a double. */
+static void origin_rows(void* arg, int begin, int end) {
+    const array_job_t* job = arg;
+    const simplex_perm_tables_t* tables = &job->ctx->tables;
+    int width = job->width;
+
+    for (int r = begin; r < end; r++) {
+        double fy;
+        double fz;
+        int64_t iy = split_local(job->origin[1], job->y_start + ((r % job->height) * job->step),
+                                 &fy);
+        int64_t iz = split_local(job->origin[2], job->z_start + ((r / job->height) * job->step),
+                                 &fz);
+        double* row = (double*)job->output + ((size_t)r * width);
+        if (job->dims == 2) {
+            origin_row_2d(tables, job->origin[0], job->x_start, iy, fy, job->step, width, row);
+        } else {
+            origin_row_3d(tables, job->origin[0], job->x_start, iy, fy, iz, fz, job->step, width,
+                          row);
+        }
     }
+}
 
-    int i0 = fast_floor(x);
-    int i1 = i0 + 1;
+// Noise at `count` scattered points through the context's kernels
+static void noise_points(const array_job_t* job, const double* x, const double* y,
+                         const double* z, int count, double* output) {
+    const simplex_context_t* ctx = job->ctx;
+    if (ctx->kernels) {
+        if (job->dims == 2) {
+            ctx->kernels->noise_2d(&ctx->tables, x, y, (size_t)count, output);
+        } else {
+            ctx->kernels->noise_3d(&ctx->tables, x, y, z, (size_t)count, output);
+        }
+        return;
+    }
+    if (job->dims == 2) {
+        for (int i = 0; i < count; i++) {
+            output[i] = noise_2d_kernel(&ctx->tables, x[i], y[i]);
+        }
+    } else {
+        for (int i = 0; i < count; i++) {
+            output[i] = noise_3d_kernel(&ctx->tables, x[i], y[i], z[i]);
+        }
+    }
+}
 
-    double x0 = x - i0;
-    double x1 = x0 - 1.0;
+/* One octave at a time over a tile, accumulating into output. Per sample the
+ * arithmetic is the same as the point functions, so results match exactly. */
+static void fractal_tile(const array_job_t* job, const double* x, const double* y,
+                         const double* z, int count, double* output) {
+    double sx[FRACTAL_TILE_SAMPLES];
+    double sy[FRACTAL_TILE_SAMPLES];
+    double sz[FRACTAL_TILE_SAMPLES];
+    double noise[FRACTAL_TILE_SAMPLES];
 
-    double t0 = 1.0 - (x0 * x0);
-    double t1 = 1.0 - (x1 * x1);
+    if (job->kind == ARRAY_NOISE) {
+        noise_points(job, x, y, z, count, output);
+        return;
+    }
+    if (job->kind == ARRAY_RIDGED || job->kind == ARRAY_BILLOWY) {
+        noise_points(job, x, y, z, count, noise);
+        for (int i = 0; i < count; i++) {
+            output[i] = job->kind == ARRAY_RIDGED ? 1.0 - fabs(noise[i]) : fabs(noise[i]);
+        }
+        return;
+    }
 
-    t0 *= t0;
-    t1 *= t1;
+    double initial = job->kind == ARRAY_FBM ? 0.0 : 1.0;
+    for (int i = 0; i < count; i++) {
+        output[i] = initial;
+    }
 
-    double n0 = t0 * t0 * dot2d(grad2[perm[i0 & 0xff] & 7], x0, 0);
-    double n1 = t1 * t1 * dot2d(grad2[perm[i1 & 0xff] & 7], x1, 0);
+    double amplitude = 1.0;
+    double frequency = 1.0;
+    double max_value = 0.0;
+    for (int octave = 0; octave < job->octaves; octave++) {
+        for (int i = 0; i < count; i++) {
+            sx[i] = x[i] * frequency;
+            sy[i] = y[i] * frequency;
+        }
+        if (job->dims == 3) {
+            for (int i = 0; i < count; i++) {
+                sz[i] = z[i] * frequency;
+            }
+        }
+        noise_points(job, sx, sy, sz, count, noise);
 
-    return SIMPLEX_2D_SCALE * (n0 + n1);
-}
+        if (job->kind == ARRAY_FBM) {
+            for (int i = 0; i < count; i++) {
+                output[i] += noise[i] * amplitude;
+            }
+        } else {
+            for (int i = 0; i < count; i++) {
+                output[i] *= (job->offset + fabs(noise[i])) * amplitude;
+            }
+        }
+        max_value += amplitude;
+        amplitude *= job->persistence;
+        frequency *= job->lacunarity;
+    }
 
-double simplex_noise_2d(double x, double y) {
-    if (!initialized) {
-        simplex_noise_init(0);
+    if (job->kind == ARRAY_FBM) {
+        for (int i = 0; i < count; i++) {
+            output[i] /= max_value;
+        }
     }
+}
 
-    const double F2 = 0.5 * (sqrt(3.0) - 1.0);
-    const double G2 = (3.0 - sqrt(3.0)) / 6.0;
+/* fBm and hybrid multifractal over a tile with a constant octave count. The
+ * octave loop unrolls, the amplitude and frequency bookkeeping folds into
+ * constants, the first octave reads the unscaled coordinates and writes the
+ * initial value, and the last one folds in the fBm division, so a tile takes
+ * one pass per octave. The arithmetic per sample matches fractal_tile(). */
+#if defined(__GNUC__)
+__attribute__((always_inline))
+#endif
+static inline void fractal_tile_octaves(const array_job_t* job, const double* x,
+                                        const double* y, const double* z, int count,
+                                        double* output, const int octaves) {
+    double sx[FRACTAL_TILE_SAMPLES];
+    double sy[FRACTAL_TILE_SAMPLES];
+    double sz[FRACTAL_TILE_SAMPLES];
+    double noise[FRACTAL_TILE_SAMPLES];
+    int fbm = job->kind == ARRAY_FBM;
 
-    double s = (x + y) * F2;
-    int i = fast_floor(x + s);
-    int j = fast_floor(y + s);
+    double amplitude = 1.0;
+    double frequency = 1.0;
+    double max_value = 0.0;
+    for (int octave = 0; octave < octaves; octave++) {
+        if (octave == 0) {
+            noise_points(job, x, y, z, count, noise);
+        } else {
+            for (int i = 0; i < count; i++) {
+                sx[i] = x[i] * frequency;
+                sy[i] = y[i] * frequency;
+            }
+            if (job->dims == 3) {
+                for (int i = 0; i < count; i++) {
+                    sz[i] = z[i] * frequency;
+                }
+            }
+            noise_points(job, sx, sy, sz, count, noise);
+        }
+        max_value += amplitude;
 
-    double t = (i + j) * G2;
-    double x0 = x - (i - t);
-    double y0 = y - (j - t);
+        int last = octave == octaves - 1;
+        if (fbm) {
+            for (int i = 0; i < count; i++) {
+                double value = (octave == 0 ? 0.0 : output[i]) + (noise[i] * amplitude);
+                output[i] = last ? value / max_value : value;
+            }
+        } else {
+            for (int i = 0; i < count; i++) {
+                output[i] = (octave == 0 ? 1.0 : output[i]) *
+                            ((job->offset + fabs(noise[i])) * amplitude);
+            }
+        }
+        amplitude *= job->persistence;
+        frequency *= job->lacunarity;
+    }
+}
+
+// Fixed-octave tiles up to FRACTAL_UNROLLED_OCTAVES; larger counts use fractal_tile()
+#define FRACTAL_TILE_FOR(n)                                                                        \
+    static void fractal_tile_##n(const array_job_t* job, const double* x, const double* y,         \
+                                 const double* z, int count, double* output) {                     \
+        fractal_tile_octaves(job, x, y, z, count, output, n);                                      \
+    }
+FRACTAL_TILE_FOR(1)
+FRACTAL_TILE_FOR(2)
+FRACTAL_TILE_FOR(3)
+FRACTAL_TILE_FOR(4)
+FRACTAL_TILE_FOR(5)
+FRACTAL_TILE_FOR(6)
+FRACTAL_TILE_FOR(7)
+FRACTAL_TILE_FOR(8)
+#undef FRACTAL_TILE_FOR
+
+enum { FRACTAL_UNROLLED_OCTAVES = 8 };
+
+// The tile evaluator for a job's kind and octave count
+static fractal_tile_fn select_fractal_tile(const array_job_t* job) {
+    static const fractal_tile_fn unrolled[FRACTAL_UNROLLED_OCTAVES] = {
+        fractal_tile_1, fractal_tile_2, fractal_tile_3, fractal_tile_4,
+        fractal_tile_5, fractal_tile_6, fractal_tile_7, fractal_tile_8};
+    if ((job->kind == ARRAY_FBM || job->kind == ARRAY_HYBRID_MULTIFRACTAL) && job->octaves >= 1 &&
+        job->octaves <= FRACTAL_UNROLLED_OCTAVES) {
+        return unrolled[job->octaves - 1];
+    }
+    return fractal_tile;
+}
+
+// Convert finished samples into a float or uint16 output buffer
+static void store_samples(const array_job_t* job, size_t index, const double* values,
+                          int count) {
+    if (job->format == SAMPLES_F32) {
+        float* out = (float*)job->output + index;
+        for (int i = 0; i < count; i++) {
+            out[i] = (float)values[i];
+        }
+        return;
+    }
+    // [-1, 1] maps onto the full uint16 range; anything outside is clamped
+    uint16_t* out = (uint16_t*)job->output + index;
+    for (int i = 0; i < count; i++) {
+        double v = values[i] < -1.0 ? -1.0 : (values[i] > 1.0 ? 1.0 : values[i]);
+        out[i] = (uint16_t)(((v + 1.0) * 0.5 * UINT16_MAX) + 0.5);
+    }
+}
 
-    int i1;
-    int j1;
-    if (x0 > y0) {
-        i1 = 1;
-        j1 = 0;
+// One octave of a single-precision row segment starting at (x, y, z)
+static void octave_row_f32(const array_job_t* job, double x, double y, double z,
+                           double frequency, int count, float* output) {
+    const simplex_context_t* ctx = job->ctx;
+    float step = (float)(job->step * frequency);
+    if (job->dims == 2) {
+        ctx->kernels_f32->row_2d(&ctx->tables, (float)(x * frequency), (float)(y * frequency),
+                                 step, count, output);
     } else {
-        i1 = 0;
-        j1 = 1;
-    }
+        ctx->kernels_f32->row_3d(&ctx->tables, (float)(x * frequency), (float)(y * frequency),
+                                 (float)(z * frequency), step, count, output);
+    }
+}
+
+/* Single precision (precision == SINGLE) runs every kind through the float32
+ * row kernels, one octave per call. Rows are cut into FRACTAL_TILE_SAMPLES
+ * segments whose start is computed in double, so coordinates stay accurate
+ * across wide rows. */
+static void rows_f32(void* arg, int begin, int end) {
+    const array_job_t* job = arg;
+    float noise[FRACTAL_TILE_SAMPLES];
+    double values[FRACTAL_TILE_SAMPLES];
+    int width = job->width;
+
+    for (int r = begin; r < end; r++) {
+        double y = job->y_start + ((r % job->height) * job->step);
+        double z = job->z_start + ((r / job->height) * job->step);
+        for (int column = 0; column < width; column += FRACTAL_TILE_SAMPLES) {
+            int count = width - column < FRACTAL_TILE_SAMPLES ? width - column
+                                                              : FRACTAL_TILE_SAMPLES;
+            size_t index = ((size_t)r * width) + column;
+            double x = job->x_start + (column * job->step);
+
+            if (job->kind == ARRAY_NOISE && job->format == SAMPLES_F32) {
+                octave_row_f32(job, x, y, z, 1.0, count, (float*)job->output + index);
+                continue;
+            }
+            double* out = job->format == SAMPLES_F64 ? (double*)job->output + index : values;
+
+            if (job->kind == ARRAY_NOISE || job->kind == ARRAY_RIDGED ||
+                job->kind == ARRAY_BILLOWY) {
+                octave_row_f32(job, x, y, z, 1.0, count, noise);
+                for (int i = 0; i < count; i++) {
+                    double n = noise[i];
+                    out[i] = job->kind == ARRAY_NOISE ? n
+                                                      : (job->kind == ARRAY_RIDGED ? 1.0 - fabs(n)
+                                                                                   : fabs(n));
+                }
+            } else {
+                double initial = job->kind == ARRAY_FBM ? 0.0 : 1.0;
+                for (int i = 0; i < count; i++) {
+                    out[i] = initial;
+                }
+                double amplitude = 1.0;
+                double frequency = 1.0;
+                double max_value = 0.0;
+                for (int octave = 0; octave < job->octaves; octave++) {
+                    octave_row_f32(job, x, y, z, frequency, count, noise);
+                    if (job->kind == ARRAY_FBM) {
+                        for (int i = 0; i < count; i++) {
+                            out[i] += noise[i] * amplitude;
+                        }
+                    } else {
+                        for (int i = 0; i < count; i++) {
+                            out[i] *= (job->offset + fabs(noise[i])) * amplitude;
+                        }
+                    }
+                    max_value += amplitude;
+                    amplitude *= job->persistence;
+                    frequency *= job->lacunarity;
+                }
+                if (job->kind == ARRAY_FBM) {
+                    for (int i = 0; i < count; i++) {
+                        out[i] /= max_value;
+                    }
+                }
+            }
 
+            if (out == values) {
+                store_samples(job, index, values, count);
+            }
+        }
+    }
+}
+
+static void fractal_rows(void* arg, int begin, int end) {
+    const array_job_t* job = arg;
+    double x[FRACTAL_TILE_SAMPLES];
+    double y[FRACTAL_TILE_SAMPLES];
+    double z[FRACTAL_TILE_SAMPLES];
+    double values[FRACTAL_TILE_SAMPLES];
+    size_t first = (size_t)begin * job->width;
+    size_t last = (size_t)end * job->width;
+
+    for (size_t tile = first; tile < last; tile += FRACTAL_TILE_SAMPLES) {
+        int count = last - tile < FRACTAL_TILE_SAMPLES ? (int)(last - tile) : FRACTAL_TILE_SAMPLES;
+        for (int i = 0; i < count; i++) {
+            int column = (int)((tile + i) % job->width);
+            int row = (int)((tile + i) / job->width);
+            x[i] = job->x_start + (column * job->step);
+            y[i] = job->y_start + ((row % job->height) * job->step);
+            z[i] = job->z_start + ((row / job->height) * job->step);
+        }
+        if (job->format == SAMPLES_F64) {
+            job->tile(job, x, y, z, count, (double*)job->output + tile);
+        } else {
+            job->tile(job, x, y, z, count, values);
+            store_samples(job, tile, values, count);
+        }
+    }
+}
+
+/* Run a double-precision grid into doubles on the context's device. Smaller
+ * jobs stay on the CPU, where they finish before a kernel launch would, and so
+ * does any job the device fails; returns whether the job is done. */
+static int offload_array(array_job_t* job, int depth, size_t samples) {
+    const simplex_context_t* ctx = job->ctx;
+    if (!ctx->gpu || job->single || job->format != SAMPLES_F64 || samples < GPU_MIN_SAMPLES) {
+        return 0;
+    }
+    static const simplex_gpu_kind_t kinds[] = {SIMPLEX_GPU_NOISE, SIMPLEX_GPU_FBM,
+                                               SIMPLEX_GPU_HYBRID_MULTIFRACTAL,
+                                               SIMPLEX_GPU_RIDGED, SIMPLEX_GPU_BILLOWY};
+    simplex_gpu_grid_t grid = {.kind = kinds[job->kind],
+                               .dims = job->dims,
+                               .x_start = job->x_start,
+                               .y_start = job->y_start,
+                               .z_start = job->z_start,
+                               .step = job->step,
+                               .width = job->width,
+                               .height = job->height,
+                               .depth = depth,
+                               .octaves = job->octaves,
+                               .persistence = job->persistence,
+                               .lacunarity = job->lacunarity,
+                               .offset = job->offset,
+                               .memory_limit_mb = ctx->config.memory_limit_mb};
+    return simplex_gpu_generate(ctx->gpu, &grid, job->output) == 0;
+}
+
+// Validate and run any array request; depth is 1 for 2D
+static int run_array(array_job_t* job, int depth) {
+    if (!job->output || job->width <= 0 || job->height <= 0 || depth <= 0 ||
+        job->height > INT_MAX / depth) {
+        return -1;
+    }
+    if ((job->kind == ARRAY_FBM || job->kind == ARRAY_HYBRID_MULTIFRACTAL) && job->octaves <= 0) {
+        return -1;
+    }
+    job->ctx = context_or_default(job->ctx);
+    job->single = job->ctx->config.precision == SIMPLEX_PRECISION_SINGLE;
+    job->tile = select_fractal_tile(job);
+    size_t samples = (size_t)job->width * (size_t)job->height * (size_t)depth;
+
+    SIMPLEX_PROFILE_BEGIN(job->ctx);
+    if (!offload_array(job, depth, samples)) {
+        // Double-precision noise into doubles keeps one kernel call per row
+        simplex_range_fn rows = fractal_rows;
+        if (job->single) {
+            rows = rows_f32;
+        } else if (job->kind == ARRAY_NOISE && job->format == SAMPLES_F64) {
+            rows = noise_rows;
+        }
+        run_array_job(job, job->height * depth, rows);
+    }
+    SIMPLEX_PROFILE_END(job->ctx,
+                        job->kind == ARRAY_NOISE ? SIMPLEX_PROFILE_NOISE_ARRAY
+                                                 : SIMPLEX_PROFILE_FRACTAL_ARRAY,
+                        samples);
+    return 0;
+}
+
+/* Validate and run a chunk-origin noise request; depth is 1 for 2D. These
+ * always run the scalar double walk on the CPU, so chunks computed by any
+ * context or build configuration line up. */
+static int run_origin_array(array_job_t* job, int depth) {
+    if (!job->output || job->width <= 0 || job->height <= 0 || depth <= 0 ||
+        job->height > INT_MAX / depth) {
+        return -1;
+    }
+    const double starts[3] = {job->x_start, job->y_start, job->z_start};
+    const int spans[3] = {job->width, job->height, depth};
+    for (int axis = 0; axis < job->dims; axis++) {
+        double extent = fabs(starts[axis]) + (fabs(job->step) * spans[axis]);
+        if (job->origin[axis] > ORIGIN_LIMIT || job->origin[axis] < -ORIGIN_LIMIT ||
+            !(extent < ORIGIN_LOCAL_LIMIT)) {
+            return -1;
+        }
+    }
+    job->ctx = context_or_default(job->ctx);
+    SIMPLEX_PROFILE_BEGIN(job->ctx);
+    run_array_job(job, job->height * depth, origin_rows);
+    SIMPLEX_PROFILE_END(job->ctx, SIMPLEX_PROFILE_NOISE_ARRAY,
+                        (size_t)job->width * (size_t)job->height * (size_t)depth);
+    return 0;
+}
+
+int simplex_noise_array_2d(double x_start, double y_start, int width, int height, double step,
+                           double* output) {
+    return simplex_noise_array_2d_ctx(NULL, x_start, y_start, width, height, step, output);
+}
+
+int simplex_noise_array_2d_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                               int width, int height, double step, double* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_NOISE, .dims = 2, .x_start = x_start,
+                       .y_start = y_start, .step = step, .width = width, .height = height,
+                       .output = output};
+    return run_array(&job, 1);
+}
+
+int simplex_noise_array_3d(double x_start, double y_start, double z_start, int width, int height,
+                           int depth, double step, double* output) {
+    return simplex_noise_array_3d_ctx(NULL, x_start, y_start, z_start, width, height, depth, step,
+                                      output);
+}
+
+int simplex_noise_array_3d_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                               double z_start, int width, int height, int depth, double step,
+                               double* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_NOISE, .dims = 3, .x_start = x_start,
+                       .y_start = y_start, .z_start = z_start, .step = step, .width = width,
+                       .height = height, .output = output};
+    return run_array(&job, depth);
+}
+
+int simplex_noise_array_2d_origin(int64_t origin_x, int64_t origin_y, double x_offset,
+                                  double y_offset, int width, int height, double step,
+                                  double* output) {
+    return simplex_noise_array_2d_origin_ctx(NULL, origin_x, origin_y, x_offset, y_offset, width,
+                                             height, step, output);
+}
+
+int simplex_noise_array_2d_origin_ctx(const simplex_context_t* ctx, int64_t origin_x,
+                                      int64_t origin_y, double x_offset, double y_offset,
+                                      int width, int height, double step, double* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_NOISE, .dims = 2, .x_start = x_offset,
+                       .y_start = y_offset, .step = step, .width = width, .height = height,
+                       .output = output, .origin = {origin_x, origin_y, 0}};
+    return run_origin_array(&job, 1);
+}
+
+int simplex_noise_array_3d_origin(int64_t origin_x, int64_t origin_y, int64_t origin_z,
+                                  double x_offset, double y_offset, double z_offset, int width,
+                                  int height, int depth, double step, double* output) {
+    return simplex_noise_array_3d_origin_ctx(NULL, origin_x, origin_y, origin_z, x_offset,
+                                             y_offset, z_offset, width, height, depth, step,
+                                             output);
+}
+
+int simplex_noise_array_3d_origin_ctx(const simplex_context_t* ctx, int64_t origin_x,
+                                      int64_t origin_y, int64_t origin_z, double x_offset,
+                                      double y_offset, double z_offset, int width, int height,
+                                      int depth, double step, double* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_NOISE, .dims = 3, .x_start = x_offset,
+                       .y_start = y_offset, .z_start = z_offset, .step = step, .width = width,
+                       .height = height, .output = output,
+                       .origin = {origin_x, origin_y, origin_z}};
+    return run_origin_array(&job, depth);
+}
+
+int simplex_noise_array_2d_f32(double x_start, double y_start, int width, int height,
+                               double step, float* output) {
+    return simplex_noise_array_2d_f32_ctx(NULL, x_start, y_start, width, height, step, output);
+}
+
+int simplex_noise_array_2d_f32_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                                   int width, int height, double step, float* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_NOISE, .format = SAMPLES_F32, .dims = 2,
+                       .x_start = x_start, .y_start = y_start, .step = step, .width = width,
+                       .height = height, .output = output};
+    return run_array(&job, 1);
+}
+
+int simplex_noise_array_2d_u16(double x_start, double y_start, int width, int height,
+                               double step, uint16_t* output) {
+    return simplex_noise_array_2d_u16_ctx(NULL, x_start, y_start, width, height, step, output);
+}
+
+int simplex_noise_array_2d_u16_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                                   int width, int height, double step, uint16_t* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_NOISE, .format = SAMPLES_U16, .dims = 2,
+                       .x_start = x_start, .y_start = y_start, .step = step, .width = width,
+                       .height = height, .output = output};
+    return run_array(&job, 1);
+}
+
+int simplex_noise_array_3d_f32(double x_start, double y_start, double z_start, int width,
+                               int height, int depth, double step, float* output) {
+    return simplex_noise_array_3d_f32_ctx(NULL, x_start, y_start, z_start, width, height, depth,
+                                          step, output);
+}
+
+int simplex_noise_array_3d_f32_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                                   double z_start, int width, int height, int depth, double step,
+                                   float* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_NOISE, .format = SAMPLES_F32, .dims = 3,
+                       .x_start = x_start, .y_start = y_start, .z_start = z_start, .step = step,
+                       .width = width, .height = height, .output = output};
+    return run_array(&job, depth);
+}
+
+int simplex_fbm_array_2d(double x_start, double y_start, int width, int height, double step,
+                         int octaves, double persistence, double lacunarity, double* output) {
+    return simplex_fbm_array_2d_ctx(NULL, x_start, y_start, width, height, step, octaves,
+                                    persistence, lacunarity, output);
+}
+
+int simplex_fbm_array_2d_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                             int width, int height, double step, int octaves, double persistence,
+                             double lacunarity, double* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_FBM, .dims = 2, .x_start = x_start,
+                       .y_start = y_start, .step = step, .width = width, .height = height,
+                       .octaves = octaves, .persistence = persistence, .lacunarity = lacunarity,
+                       .output = output};
+    return run_array(&job, 1);
+}
+
+int simplex_fbm_array_3d(double x_start, double y_start, double z_start, int width, int height,
+                         int depth, double step, int octaves, double persistence,
+                         double lacunarity, double* output) {
+    return simplex_fbm_array_3d_ctx(NULL, x_start, y_start, z_start, width, height, depth, step,
+                                    octaves, persistence, lacunarity, output);
+}
+
+int simplex_fbm_array_3d_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                             double z_start, int width, int height, int depth, double step,
+                             int octaves, double persistence, double lacunarity, double* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_FBM, .dims = 3, .x_start = x_start,
+                       .y_start = y_start, .z_start = z_start, .step = step, .width = width,
+                       .height = height, .octaves = octaves, .persistence = persistence,
+                       .lacunarity = lacunarity, .output = output};
+    return run_array(&job, depth);
+}
+
+// simplex_fractal_2d/3d are the same sum as fBm
+int simplex_fractal_array_2d(double x_start, double y_start, int width, int height, double step,
+                             int octaves, double persistence, double lacunarity, double* output) {
+    return simplex_fbm_array_2d_ctx(NULL, x_start, y_start, width, height, step, octaves,
+                                    persistence, lacunarity, output);
+}
+
+int simplex_fractal_array_2d_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                                 int width, int height, double step, int octaves,
+                                 double persistence, double lacunarity, double* output) {
+    return simplex_fbm_array_2d_ctx(ctx, x_start, y_start, width, height, step, octaves,
+                                    persistence, lacunarity, output);
+}
+
+int simplex_fractal_array_2d_f32(double x_start, double y_start, int width, int height,
+                                 double step, int octaves, double persistence, double lacunarity,
+                                 float* output) {
+    return simplex_fractal_array_2d_f32_ctx(NULL, x_start, y_start, width, height, step, octaves,
+                                            persistence, lacunarity, output);
+}
+
+int simplex_fractal_array_2d_f32_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                                     int width, int height, double step, int octaves,
+                                     double persistence, double lacunarity, float* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_FBM, .format = SAMPLES_F32, .dims = 2,
+                       .x_start = x_start, .y_start = y_start, .step = step, .width = width,
+                       .height = height, .octaves = octaves, .persistence = persistence,
+                       .lacunarity = lacunarity, .output = output};
+    return run_array(&job, 1);
+}
+
+int simplex_fractal_array_2d_u16(double x_start, double y_start, int width, int height,
+                                 double step, int octaves, double persistence, double lacunarity,
+                                 uint16_t* output) {
+    return simplex_fractal_array_2d_u16_ctx(NULL, x_start, y_start, width, height, step, octaves,
+                                            persistence, lacunarity, output);
+}
+
+int simplex_fractal_array_2d_u16_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                                     int width, int height, double step, int octaves,
+                                     double persistence, double lacunarity, uint16_t* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_FBM, .format = SAMPLES_U16, .dims = 2,
+                       .x_start = x_start, .y_start = y_start, .step = step, .width = width,
+                       .height = height, .octaves = octaves, .persistence = persistence,
+                       .lacunarity = lacunarity, .output = output};
+    return run_array(&job, 1);
+}
+
+int simplex_fractal_array_3d(double x_start, double y_start, double z_start, int width, int height,
+                             int depth, double step, int octaves, double persistence,
+                             double lacunarity, double* output) {
+    return simplex_fbm_array_3d_ctx(NULL, x_start, y_start, z_start, width, height, depth, step,
+                                    octaves, persistence, lacunarity, output);
+}
+
+int simplex_fractal_array_3d_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                                 double z_start, int width, int height, int depth, double step,
+                                 int octaves, double persistence, double lacunarity,
+                                 double* output) {
+    return simplex_fbm_array_3d_ctx(ctx, x_start, y_start, z_start, width, height, depth, step,
+                                    octaves, persistence, lacunarity, output);
+}
+
+int simplex_hybrid_multifractal_array_2d(double x_start, double y_start, int width, int height,
+                                         double step, int octaves, double persistence,
+                                         double lacunarity, double offset, double* output) {
+    return simplex_hybrid_multifractal_array_2d_ctx(NULL, x_start, y_start, width, height, step,
+                                                    octaves, persistence, lacunarity, offset,
+                                                    output);
+}
+
+int simplex_hybrid_multifractal_array_2d_ctx(const simplex_context_t* ctx, double x_start,
+                                             double y_start, int width, int height, double step,
+                                             int octaves, double persistence, double lacunarity,
+                                             double offset, double* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_HYBRID_MULTIFRACTAL, .dims = 2,
+                       .x_start = x_start, .y_start = y_start, .step = step, .width = width,
+                       .height = height, .octaves = octaves, .persistence = persistence,
+                       .lacunarity = lacunarity, .offset = offset, .output = output};
+    return run_array(&job, 1);
+}
+
+int simplex_ridged_array_2d(double x_start, double y_start, int width, int height, double step,
+                            double* output) {
+    return simplex_ridged_array_2d_ctx(NULL, x_start, y_start, width, height, step, output);
+}
+
+int simplex_ridged_array_2d_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                                int width, int height, double step, double* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_RIDGED, .dims = 2, .x_start = x_start,
+                       .y_start = y_start, .step = step, .width = width, .height = height,
+                       .output = output};
+    return run_array(&job, 1);
+}
+
+int simplex_ridged_array_3d(double x_start, double y_start, double z_start, int width, int height,
+                            int depth, double step, double* output) {
+    return simplex_ridged_array_3d_ctx(NULL, x_start, y_start, z_start, width, height, depth, step,
+                                       output);
+}
+
+int simplex_ridged_array_3d_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                                double z_start, int width, int height, int depth, double step,
+                                double* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_RIDGED, .dims = 3, .x_start = x_start,
+                       .y_start = y_start, .z_start = z_start, .step = step, .width = width,
+                       .height = height, .output = output};
+    return run_array(&job, depth);
+}
+
+int simplex_billowy_array_2d(double x_start, double y_start, int width, int height, double step,
+                             double* output) {
+    return simplex_billowy_array_2d_ctx(NULL, x_start, y_start, width, height, step, output);
+}
+
+int simplex_billowy_array_2d_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                                 int width, int height, double step, double* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_BILLOWY, .dims = 2, .x_start = x_start,
+                       .y_start = y_start, .step = step, .width = width, .height = height,
+                       .output = output};
+    return run_array(&job, 1);
+}
+
+int simplex_billowy_array_3d(double x_start, double y_start, double z_start, int width,
+                             int height, int depth, double step, double* output) {
+    return simplex_billowy_array_3d_ctx(NULL, x_start, y_start, z_start, width, height, depth,
+                                        step, output);
+}
+
+int simplex_billowy_array_3d_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                                 double z_start, int width, int height, int depth, double step,
+                                 double* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_BILLOWY, .dims = 3, .x_start = x_start,
+                       .y_start = y_start, .z_start = z_start, .step = step, .width = width,
+                       .height = height, .output = output};
+    return run_array(&job, depth);
+}
+
+// Copy coordinates [first, first + count) of a float or interleaved axis into doubles
+static void gather_axis(const array_job_t* job, int axis, size_t first, int count,
+                        double* output) {
+    size_t stride = job->stride;
+    if (job->axes_f32) {
+        const float* source = (const float*)job->axes[axis] + (first * stride);
+        for (int i = 0; i < count; i++) {
+            output[i] = source[i * stride];
+        }
+    } else {
+        const double* source = (const double*)job->axes[axis] + (first * stride);
+        for (int i = 0; i < count; i++) {
+            output[i] = source[i * stride];
+        }
+    }
+}
+
+/* Points are cut into FRACTAL_TILE_SAMPLES tiles, which the pool hands out
+ * like rows. Double arrays are read in place; other layouts are gathered per
+ * tile and float results stored from a double tile. */
+static void point_tiles(void* arg, int begin, int end) {
+    const array_job_t* job = arg;
+    const simplex_context_t* ctx = job->ctx;
+    const double* arrays[4] = {job->xs, job->ys, job->zs, job->ws};
+    double gathered[4][FRACTAL_TILE_SAMPLES];
+    double samples[FRACTAL_TILE_SAMPLES];
+
+    for (int tile = begin; tile < end; tile++) {
+        size_t first = (size_t)tile * FRACTAL_TILE_SAMPLES;
+        int count = job->count - first < FRACTAL_TILE_SAMPLES ? (int)(job->count - first)
+                                                               : FRACTAL_TILE_SAMPLES;
+        const double* c[4] = {NULL, NULL, NULL, NULL};
+        for (int axis = 0; axis < job->dims; axis++) {
+            if (job->xs) {
+                c[axis] = arrays[axis] + first;
+            } else {
+                gather_axis(job, axis, first, count, gathered[axis]);
+                c[axis] = gathered[axis];
+            }
+        }
+        double* out = job->format == SAMPLES_F32 ? samples : (double*)job->output + first;
+        if (job->dims != 4) {
+            job->tile(job, c[0], c[1], c[2], count, out);
+        } else if (ctx->kernels) {
+            ctx->kernels->noise_4d(&ctx->tables, c[0], c[1], c[2], c[3], (size_t)count, out);
+        } else {
+            for (int i = 0; i < count; i++) {
+                out[i] = simplex_noise_4d_ctx(ctx, c[0][i], c[1][i], c[2][i], c[3][i]);
+            }
+        }
+        if (job->format == SAMPLES_F32) {
+            float* stored = (float*)job->output + first;
+            for (int i = 0; i < count; i++) {
+                stored[i] = (float)samples[i];
+            }
+        }
+    }
+}
+
+// Validate and run a scattered-point request, always in double precision
+static int run_points(array_job_t* job) {
+    if (job->count == 0) {
+        return 0;
+    }
+    const void* axes[4] = {job->xs, job->ys, job->zs, job->ws};
+    for (int axis = 0; axis < job->dims; axis++) {
+        if (!(job->xs ? axes[axis] : job->axes[axis])) {
+            return -1;
+        }
+    }
+    if (!job->output || job->count / FRACTAL_TILE_SAMPLES >= INT_MAX) {
+        return -1;
+    }
+    if (job->kind == ARRAY_FBM && job->octaves <= 0) {
+        return -1;
+    }
+    job->ctx = context_or_default(job->ctx);
+    job->tile = select_fractal_tile(job);
+
+    const simplex_config_t* config = &job->ctx->config;
+    int chunk_size = config->chunk_size > 0 ? config->chunk_size : DEFAULT_CHUNK_SIZE;
+    int tiles_per_task = chunk_size / FRACTAL_TILE_SAMPLES;
+    int tiles = (int)((job->count + FRACTAL_TILE_SAMPLES - 1) / FRACTAL_TILE_SAMPLES);
+    SIMPLEX_PROFILE_BEGIN(job->ctx);
+    simplex_parallel_for(tiles, tiles_per_task < 1 ? 1 : tiles_per_task, config->max_threads,
+                         point_tiles, job);
+    SIMPLEX_PROFILE_END(job->ctx, SIMPLEX_PROFILE_POINTS, job->count);
+    return 0;
+}
+
+// Set up a noise job over interleaved points; false if stride leaves no room for the axes
+static int interleaved_points(array_job_t* job, const void* points, size_t stride) {
+    if (stride < (size_t)job->dims) {
+        return 0;
+    }
+    for (int axis = 0; axis < job->dims; axis++) {
+        job->axes[axis] = points ? (job->axes_f32 ? (const void*)((const float*)points + axis)
+                                                  : (const void*)((const double*)points + axis))
+                                 : NULL;
+    }
+    job->stride = stride;
+    return 1;
+}
+
+int simplex_noise_2d_points(const double* xs, const double* ys, size_t count, double* output) {
+    return simplex_noise_2d_points_ctx(NULL, xs, ys, count, output);
+}
+
+int simplex_noise_2d_points_ctx(const simplex_context_t* ctx, const double* xs, const double* ys,
+                                size_t count, double* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_NOISE, .dims = 2, .xs = xs, .ys = ys,
+                       .count = count, .output = output};
+    return run_points(&job);
+}
+
+int simplex_noise_3d_points(const double* xs, const double* ys, const double* zs, size_t count,
+                            double* output) {
+    return simplex_noise_3d_points_ctx(NULL, xs, ys, zs, count, output);
+}
+
+int simplex_noise_3d_points_ctx(const simplex_context_t* ctx, const double* xs, const double* ys,
+                                const double* zs, size_t count, double* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_NOISE, .dims = 3, .xs = xs, .ys = ys, .zs = zs,
+                       .count = count, .output = output};
+    return run_points(&job);
+}
+
+int simplex_noise_4d_points(const double* xs, const double* ys, const double* zs,
+                            const double* ws, size_t count, double* output) {
+    return simplex_noise_4d_points_ctx(NULL, xs, ys, zs, ws, count, output);
+}
+
+int simplex_noise_4d_points_ctx(const simplex_context_t* ctx, const double* xs, const double* ys,
+                                const double* zs, const double* ws, size_t count,
+                                double* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_NOISE, .dims = 4, .xs = xs, .ys = ys, .zs = zs,
+                       .ws = ws, .count = count, .output = output};
+    return run_points(&job);
+}
+
+int simplex_noise_2d_points_aos(const double* points, size_t stride, size_t count,
+                                double* output) {
+    return simplex_noise_2d_points_aos_ctx(NULL, points, stride, count, output);
+}
+
+int simplex_noise_2d_points_aos_ctx(const simplex_context_t* ctx, const double* points,
+                                    size_t stride, size_t count, double* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_NOISE, .dims = 2, .count = count,
+                       .output = output};
+    return interleaved_points(&job, points, stride) ? run_points(&job) : -1;
+}
+
+int simplex_noise_3d_points_aos(const double* points, size_t stride, size_t count,
+                                double* output) {
+    return simplex_noise_3d_points_aos_ctx(NULL, points, stride, count, output);
+}
+
+int simplex_noise_3d_points_aos_ctx(const simplex_context_t* ctx, const double* points,
+                                    size_t stride, size_t count, double* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_NOISE, .dims = 3, .count = count,
+                       .output = output};
+    return interleaved_points(&job, points, stride) ? run_points(&job) : -1;
+}
+
+int simplex_noise_4d_points_aos(const double* points, size_t stride, size_t count,
+                                double* output) {
+    return simplex_noise_4d_points_aos_ctx(NULL, points, stride, count, output);
+}
+
+int simplex_noise_4d_points_aos_ctx(const simplex_context_t* ctx, const double* points,
+                                    size_t stride, size_t count, double* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_NOISE, .dims = 4, .count = count,
+                       .output = output};
+    return interleaved_points(&job, points, stride) ? run_points(&job) : -1;
+}
+
+int simplex_noise_2d_points_f32(const float* xs, const float* ys, size_t count, float* output) {
+    return simplex_noise_2d_points_f32_ctx(NULL, xs, ys, count, output);
+}
+
+int simplex_noise_2d_points_f32_ctx(const simplex_context_t* ctx, const float* xs,
+                                    const float* ys, size_t count, float* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_NOISE, .format = SAMPLES_F32, .dims = 2,
+                       .count = count, .output = output, .axes = {xs, ys}, .stride = 1,
+                       .axes_f32 = 1};
+    return run_points(&job);
+}
+
+int simplex_noise_3d_points_f32(const float* xs, const float* ys, const float* zs, size_t count,
+                                float* output) {
+    return simplex_noise_3d_points_f32_ctx(NULL, xs, ys, zs, count, output);
+}
+
+int simplex_noise_3d_points_f32_ctx(const simplex_context_t* ctx, const float* xs,
+                                    const float* ys, const float* zs, size_t count,
+                                    float* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_NOISE, .format = SAMPLES_F32, .dims = 3,
+                       .count = count, .output = output, .axes = {xs, ys, zs}, .stride = 1,
+                       .axes_f32 = 1};
+    return run_points(&job);
+}
+
+int simplex_noise_4d_points_f32(const float* xs, const float* ys, const float* zs,
+                                const float* ws, size_t count, float* output) {
+    return simplex_noise_4d_points_f32_ctx(NULL, xs, ys, zs, ws, count, output);
+}
+
+int simplex_noise_4d_points_f32_ctx(const simplex_context_t* ctx, const float* xs,
+                                    const float* ys, const float* zs, const float* ws,
+                                    size_t count, float* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_NOISE, .format = SAMPLES_F32, .dims = 4,
+                       .count = count, .output = output, .axes = {xs, ys, zs, ws},
+                       .stride = 1, .axes_f32 = 1};
+    return run_points(&job);
+}
+
+int simplex_noise_2d_points_aos_f32(const float* points, size_t stride, size_t count,
+                                    float* output) {
+    return simplex_noise_2d_points_aos_f32_ctx(NULL, points, stride, count, output);
+}
+
+int simplex_noise_2d_points_aos_f32_ctx(const simplex_context_t* ctx, const float* points,
+                                        size_t stride, size_t count, float* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_NOISE, .format = SAMPLES_F32, .dims = 2,
+                       .count = count, .output = output, .axes_f32 = 1};
+    return interleaved_points(&job, points, stride) ? run_points(&job) : -1;
+}
+
+int simplex_noise_3d_points_aos_f32(const float* points, size_t stride, size_t count,
+                                    float* output) {
+    return simplex_noise_3d_points_aos_f32_ctx(NULL, points, stride, count, output);
+}
+
+int simplex_noise_3d_points_aos_f32_ctx(const simplex_context_t* ctx, const float* points,
+                                        size_t stride, size_t count, float* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_NOISE, .format = SAMPLES_F32, .dims = 3,
+                       .count = count, .output = output, .axes_f32 = 1};
+    return interleaved_points(&job, points, stride) ? run_points(&job) : -1;
+}
+
+int simplex_noise_4d_points_aos_f32(const float* points, size_t stride, size_t count,
+                                    float* output) {
+    return simplex_noise_4d_points_aos_f32_ctx(NULL, points, stride, count, output);
+}
+
+int simplex_noise_4d_points_aos_f32_ctx(const simplex_context_t* ctx, const float* points,
+                                        size_t stride, size_t count, float* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_NOISE, .format = SAMPLES_F32, .dims = 4,
+                       .count = count, .output = output, .axes_f32 = 1};
+    return interleaved_points(&job, points, stride) ? run_points(&job) : -1;
+}
+
+int simplex_fbm_2d_points(const double* xs, const double* ys, size_t count, int octaves,
+                          double persistence, double lacunarity, double* output) {
+    return simplex_fbm_2d_points_ctx(NULL, xs, ys, count, octaves, persistence, lacunarity,
+                                     output);
+}
+
+int simplex_fbm_2d_points_ctx(const simplex_context_t* ctx, const double* xs, const double* ys,
+                              size_t count, int octaves, double persistence, double lacunarity,
+                              double* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_FBM, .dims = 2, .xs = xs, .ys = ys,
+                       .count = count, .octaves = octaves, .persistence = persistence,
+                       .lacunarity = lacunarity, .output = output};
+    return run_points(&job);
+}
+
+int simplex_fbm_3d_points(const double* xs, const double* ys, const double* zs, size_t count,
+                          int octaves, double persistence, double lacunarity, double* output) {
+    return simplex_fbm_3d_points_ctx(NULL, xs, ys, zs, count, octaves, persistence, lacunarity,
+                                     output);
+}
+
+int simplex_fbm_3d_points_ctx(const simplex_context_t* ctx, const double* xs, const double* ys,
+                              const double* zs, size_t count, int octaves, double persistence,
+                              double lacunarity, double* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_FBM, .dims = 3, .xs = xs, .ys = ys, .zs = zs,
+                       .count = count, .octaves = octaves, .persistence = persistence,
+                       .lacunarity = lacunarity, .output = output};
+    return run_points(&job);
+}
+
+int simplex_ridged_2d_points(const double* xs, const double* ys, size_t count, double* output) {
+    return simplex_ridged_2d_points_ctx(NULL, xs, ys, count, output);
+}
+
+int simplex_ridged_2d_points_ctx(const simplex_context_t* ctx, const double* xs,
+                                 const double* ys, size_t count, double* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_RIDGED, .dims = 2, .xs = xs, .ys = ys,
+                       .count = count, .output = output};
+    return run_points(&job);
+}
+
+int simplex_billowy_2d_points(const double* xs, const double* ys, size_t count, double* output) {
+    return simplex_billowy_2d_points_ctx(NULL, xs, ys, count, output);
+}
+
+int simplex_billowy_2d_points_ctx(const simplex_context_t* ctx, const double* xs,
+                                  const double* ys, size_t count, double* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_BILLOWY, .dims = 2, .xs = xs, .ys = ys,
+                       .count = count, .output = output};
+    return run_points(&job);
+}
+
+/* ===== LOD PYRAMIDS ===== */
+
+// Least samples per noise unit an octave needs to be kept at a level
+#define PYRAMID_NYQUIST 0.5
+enum { PYRAMID_MAX_LEVELS = 32 };
+
+// One pyramid level, reading the unnormalized octave sums of the next coarser level
+typedef struct {
+    array_job_t noise; /* Context and dimensions for noise_points() */
+    double x_start;
+    double y_start;
+    double step; /* Sample spacing of this level */
+    int width;
+    int height;
+    int octaves; /* Octaves kept at this level */
+    double persistence;
+    double lacunarity;
+    const double* coarser; /* NULL at the coarsest level */
+    int coarser_width;
+    int shared; /* Octaves already summed in `coarser` */
+    double* output;
+} pyramid_level_t;
+
+// Octaves kept at sample spacing `step`: the leading ones within PYRAMID_NYQUIST, at least one
+static int visible_octaves(int octaves, double step, double lacunarity) {
+    double frequency = 1.0;
+    int count = 1;
+    while (count < octaves) {
+        frequency *= lacunarity;
+        if (frequency * step > PYRAMID_NYQUIST) {
+            break;
+        }
+        count++;
+    }
+    return count;
+}
+
+/* Level rows [begin, end), a tile at a time. Samples on the coarser grid (even
+ * row and column) start from its sum and add octaves [shared, octaves), the
+ * rest sum every kept octave; all of them add their octaves in order, so the
+ * sums are exactly those of the fBm loop. */
+static void pyramid_rows(void* arg, int begin, int end) {
+    const pyramid_level_t* level = arg;
+    double x[FRACTAL_TILE_SAMPLES];
+    double sx[FRACTAL_TILE_SAMPLES];
+    double sy[FRACTAL_TILE_SAMPLES];
+    double noise[FRACTAL_TILE_SAMPLES];
+    int own[FRACTAL_TILE_SAMPLES]; /* Tile samples not on the coarser grid */
+
+    for (int r = begin; r < end; r++) {
+        double* row = level->output + ((size_t)r * level->width);
+        double y = level->y_start + (r * level->step);
+        const double* coarse_row =
+            level->coarser && r % 2 == 0
+                ? level->coarser + ((size_t)(r / 2) * level->coarser_width)
+                : NULL;
+        for (int column = 0; column < level->width; column += FRACTAL_TILE_SAMPLES) {
+            int count = level->width - column < FRACTAL_TILE_SAMPLES ? level->width - column
+                                                                     : FRACTAL_TILE_SAMPLES;
+            int owned = 0;
+            for (int i = 0; i < count; i++) {
+                int c = column + i;
+                x[i] = level->x_start + (c * level->step);
+                if (coarse_row && c % 2 == 0) {
+                    row[c] = coarse_row[c / 2];
+                } else {
+                    row[c] = 0.0;
+                    own[owned++] = i;
+                }
+            }
+
+            double amplitude = 1.0;
+            double frequency = 1.0;
+            for (int octave = 0; octave < level->octaves; octave++) {
+                int all = octave >= level->shared;
+                int n = all ? count : owned;
+                for (int k = 0; k < n; k++) {
+                    sx[k] = x[all ? k : own[k]] * frequency;
+                    sy[k] = y * frequency;
+                }
+                noise_points(&level->noise, sx, sy, NULL, n, noise);
+                for (int k = 0; k < n; k++) {
+                    row[column + (all ? k : own[k])] += noise[k] * amplitude;
+                }
+                amplitude *= level->persistence;
+                frequency *= level->lacunarity;
+            }
+        }
+    }
+}
+
+// Divide a finished level's octave sums by the amplitude sum
+static void normalize_level(double* samples, size_t count, double max_value) {
+    for (size_t i = 0; i < count; i++) {
+        samples[i] /= max_value;
+    }
+}
+
+size_t simplex_pyramid_level(int width, int height, int level, int* level_width,
+                             int* level_height) {
+    size_t offset = 0;
+    int w = 0;
+    int h = 0;
+    if (width > 0 && height > 0 && level >= 0 && level <= PYRAMID_MAX_LEVELS) {
+        for (int l = 0; l <= level; l++) {
+            offset += (size_t)w * (size_t)h;
+            w = (int)((((uint64_t)width - 1) >> l) + 1);
+            h = (int)((((uint64_t)height - 1) >> l) + 1);
+        }
+    }
+    if (level_width) {
+        *level_width = w;
+    }
+    if (level_height) {
+        *level_height = h;
+    }
+    return offset;
+}
+
+int simplex_fbm_pyramid_2d(double x_start, double y_start, int width, int height, double step,
+                           int levels, int octaves, double persistence, double lacunarity,
+                           double* output) {
+    return simplex_fbm_pyramid_2d_ctx(NULL, x_start, y_start, width, height, step, levels,
+                                      octaves, persistence, lacunarity, output);
+}
+
+int simplex_fbm_pyramid_2d_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                               int width, int height, double step, int levels, int octaves,
+                               double persistence, double lacunarity, double* output) {
+    if (!output || width <= 0 || height <= 0 || levels < 1 || levels > PYRAMID_MAX_LEVELS ||
+        octaves <= 0) {
+        return -1;
+    }
+    ctx = context_or_default(ctx);
+    const simplex_config_t* config = &ctx->config;
+    int chunk_size = config->chunk_size > 0 ? config->chunk_size : DEFAULT_CHUNK_SIZE;
+
+    double max_value = 0.0;
+    double amplitude = 1.0;
+    for (int octave = 0; octave < octaves; octave++) {
+        max_value += amplitude;
+        amplitude *= persistence;
+    }
+
+    SIMPLEX_PROFILE_BEGIN(ctx);
+    pyramid_level_t level = {.noise = {.ctx = ctx, .dims = 2},
+                             .x_start = x_start,
+                             .y_start = y_start,
+                             .persistence = persistence,
+                             .lacunarity = lacunarity};
+    size_t coarser_size = 0;
+    for (int l = levels - 1; l >= 0; l--) {
+        double* samples = output + simplex_pyramid_level(width, height, l, &level.width,
+                                                         &level.height);
+        level.step = ldexp(step, l);
+        level.shared = level.coarser ? level.octaves : 0;
+        level.octaves = visible_octaves(octaves, level.step, lacunarity);
+        level.output = samples;
+        int rows_per_task = chunk_size / level.width;
+        simplex_parallel_for(level.height, rows_per_task < 1 ? 1 : rows_per_task,
+                             config->max_threads, pyramid_rows, &level);
+
+        // The coarser level has been read for the last time
+        if (level.coarser) {
+            normalize_level((double*)level.coarser, coarser_size, max_value);
+        }
+        level.coarser = samples;
+        level.coarser_width = level.width;
+        coarser_size = (size_t)level.width * level.height;
+    }
+    normalize_level(output, coarser_size, max_value);
+    SIMPLEX_PROFILE_END(ctx, SIMPLEX_PROFILE_FRACTAL_ARRAY,
+                        simplex_pyramid_level(width, height, levels, NULL, NULL));
+    return 0;
+}
+
+/* ===== SEEDED LAYERS ===== */
+
+// Rows of all layers of a seeded job; layer l starts `plane` samples after layer l - 1
+typedef struct {
+    const simplex_kernels_t* kernels;
+    const uint32_t* seeds;
+    int layers;
+    int dims;
+    double x_start;
+    double y_start;
+    double z_start;
+    double step;
+    int width;
+    int height;
+    size_t plane;
+    double* output;
+} layer_job_t;
+
+// Rows [begin, end); rows of a 3D job are numbered z * height + y
+static void layer_rows(void* arg, int begin, int end) {
+    const layer_job_t* job = arg;
+    for (int r = begin; r < end; r++) {
+        double y = job->y_start + ((r % job->height) * job->step);
+        double z = job->z_start + ((r / job->height) * job->step);
+        double* row = job->output + ((size_t)r * job->width);
+        if (job->dims == 2) {
+            job->kernels->layers_2d(job->seeds, job->layers, job->x_start, y, job->step,
+                                    job->width, job->plane, row);
+        } else {
+            job->kernels->layers_3d(job->seeds, job->layers, job->x_start, y, z, job->step,
+                                    job->width, job->plane, row);
+        }
+    }
+}
+
+// Validate and run a seeded layer request; depth is 1 for 2D
+static int run_layers(const simplex_context_t* ctx, layer_job_t* job, int depth) {
+    if (!job->output || !job->seeds || job->layers <= 0 || job->width <= 0 || job->height <= 0 ||
+        depth <= 0 || job->height > INT_MAX / depth) {
+        return -1;
+    }
+    ctx = context_or_default(ctx);
+    const simplex_config_t* config = &ctx->config;
+    int rows = job->height * depth;
+    job->plane = (size_t)job->width * (size_t)rows;
+    // Precision does not apply; the seeded kernels only exist in double
+    job->kernels = ctx->kernels ? ctx->kernels : &simplex_kernels_scalar;
+
+    // A task's share of chunk_size counts every layer of its rows
+    int chunk_size = config->chunk_size > 0 ? config->chunk_size : DEFAULT_CHUNK_SIZE;
+    size_t row_samples = (size_t)job->width * (size_t)job->layers;
+    int rows_per_task = (size_t)chunk_size > row_samples ? (int)(chunk_size / row_samples) : 1;
+
+    SIMPLEX_PROFILE_BEGIN(ctx);
+    simplex_parallel_for(rows, rows_per_task, config->max_threads, layer_rows, job);
+    SIMPLEX_PROFILE_END(ctx, SIMPLEX_PROFILE_NOISE_ARRAY, job->plane * (size_t)job->layers);
+    return 0;
+}
+
+int simplex_noise_layers_2d(double x_start, double y_start, int width, int height, double step,
+                            const uint32_t* seeds, int layers, double* output) {
+    return simplex_noise_layers_2d_ctx(NULL, x_start, y_start, width, height, step, seeds, layers,
+                                       output);
+}
+
+int simplex_noise_layers_2d_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                                int width, int height, double step, const uint32_t* seeds,
+                                int layers, double* output) {
+    layer_job_t job = {.seeds = seeds, .layers = layers, .dims = 2, .x_start = x_start,
+                       .y_start = y_start, .step = step, .width = width, .height = height,
+                       .output = output};
+    return run_layers(ctx, &job, 1);
+}
+
+int simplex_noise_layers_3d(double x_start, double y_start, double z_start, int width,
+                            int height, int depth, double step, const uint32_t* seeds,
+                            int layers, double* output) {
+    return simplex_noise_layers_3d_ctx(NULL, x_start, y_start, z_start, width, height, depth, step,
+                                       seeds, layers, output);
+}
+
+int simplex_noise_layers_3d_ctx(const simplex_context_t* ctx, double x_start, double y_start,
+                                double z_start, int width, int height, int depth, double step,
+                                const uint32_t* seeds, int layers, double* output) {
+    layer_job_t job = {.seeds = seeds, .layers = layers, .dims = 3, .x_start = x_start,
+                       .y_start = y_start, .z_start = z_start, .step = step, .width = width,
+                       .height = height, .output = output};
+    return run_layers(ctx, &job, depth);
+}
+
+/* ===== WARPED ARRAYS ===== */
+
+/* Tiles of a warped grid. Every warp field of a tile is one fractal_tile()
+ * pass over the tile's displaced coordinates, so each octave of each field
+ * goes through the batched point kernels; the base fBm is one more pass. */
+static void warp_rows(void* arg, int begin, int end) {
+    const array_job_t* job = arg;
+    const simplex_warp_config_t* warp = job->warp;
+    array_job_t fields = *job;
+    fields.octaves = warp->octaves;
+    fields.persistence = warp->persistence;
+    fields.lacunarity = warp->lacunarity;
+    fields.tile = select_fractal_tile(&fields);
+    double x[FRACTAL_TILE_SAMPLES];
+    double y[FRACTAL_TILE_SAMPLES];
+    double warp_x[FRACTAL_TILE_SAMPLES];
+    double warp_y[FRACTAL_TILE_SAMPLES];
+    double sx[FRACTAL_TILE_SAMPLES];
+    double sy[FRACTAL_TILE_SAMPLES];
+    double dx[FRACTAL_TILE_SAMPLES];
+    double dy[FRACTAL_TILE_SAMPLES];
+    size_t first = (size_t)begin * job->width;
+    size_t last = (size_t)end * job->width;
+
+    for (size_t tile = first; tile < last; tile += FRACTAL_TILE_SAMPLES) {
+        int count = last - tile < FRACTAL_TILE_SAMPLES ? (int)(last - tile) : FRACTAL_TILE_SAMPLES;
+        for (int i = 0; i < count; i++) {
+            x[i] = job->x_start + ((int)((tile + i) % job->width) * job->step);
+            y[i] = job->y_start + ((int)((tile + i) / job->width) * job->step);
+            warp_x[i] = x[i];
+            warp_y[i] = y[i];
+        }
+        for (int level = 0; level < warp->levels; level++) {
+            const double* offsets = warp->offsets[level];
+            for (int i = 0; i < count; i++) {
+                sx[i] = warp_x[i] + offsets[0];
+                sy[i] = warp_y[i] + offsets[1];
+            }
+            fields.tile(&fields, sx, sy, NULL, count, dx);
+            for (int i = 0; i < count; i++) {
+                sx[i] = warp_x[i] + offsets[2];
+                sy[i] = warp_y[i] + offsets[3];
+            }
+            fields.tile(&fields, sx, sy, NULL, count, dy);
+            for (int i = 0; i < count; i++) {
+                warp_x[i] = x[i] + (dx[i] * warp->strength);
+                warp_y[i] = y[i] + (dy[i] * warp->strength);
+            }
+        }
+        job->tile(job, warp_x, warp_y, NULL, count, (double*)job->output + tile);
+    }
+}
+
+// Validate and run a warped grid; it always runs in double on the CPU
+static int run_warp(array_job_t* job) {
+    simplex_warp_config_t defaults = simplex_get_default_warp_config();
+    job->warp = job->warp ? job->warp : &defaults;
+    if (!job->output || job->width <= 0 || job->height <= 0 ||
+        !warp_config_valid(job->warp, job->octaves)) {
+        return -1;
+    }
+    job->ctx = context_or_default(job->ctx);
+    job->tile = select_fractal_tile(job);
+    SIMPLEX_PROFILE_BEGIN(job->ctx);
+    run_array_job(job, job->height, warp_rows);
+    SIMPLEX_PROFILE_END(job->ctx, SIMPLEX_PROFILE_FRACTAL_ARRAY,
+                        (size_t)job->width * (size_t)job->height);
+    return 0;
+}
+
+int simplex_domain_warp_array_2d(double x_start, double y_start, int width, int height,
+                                 double step, int octaves, double persistence, double lacunarity,
+                                 const simplex_warp_config_t* warp, double* output) {
+    return simplex_domain_warp_array_2d_ctx(NULL, x_start, y_start, width, height, step, octaves,
+                                            persistence, lacunarity, warp, output);
+}
+
+int simplex_domain_warp_array_2d_ctx(const simplex_context_t* ctx, double x_start,
+                                     double y_start, int width, int height, double step,
+                                     int octaves, double persistence, double lacunarity,
+                                     const simplex_warp_config_t* warp, double* output) {
+    array_job_t job = {.ctx = ctx, .kind = ARRAY_FBM, .dims = 2, .x_start = x_start,
+                       .y_start = y_start, .step = step, .width = width, .height = height,
+                       .octaves = octaves, .persistence = persistence, .lacunarity = lacunarity,
+                       .warp = warp, .output = output};
+    return run_warp(&job);
+}
+
+void simplex_cleanup(void) {
+    // Cancel queued jobs and let running ones finish before their context goes away
+    simplex_task_runners_shutdown();
+
+    // Reset all state
+    default_context.initialized = 0;
+    default_context.cache_enabled = 0;
+    default_context.profiling_enabled = 0;
+
+    // Reset performance stats, then free the cached tiles
+    simplex_reset_performance_stats();
+    simplex_tile_cache_destroy(default_context.tile_cache);
+    default_context.tile_cache = NULL;
+    simplex_profiler_destroy(default_context.profiler);
+    default_context.profiler = NULL;
+    simplex_gpu_destroy(default_context.gpu);
+    default_context.gpu = NULL;
+
+    // Stop worker threads; they restart on the next parallel array call
+    simplex_thread_pool_shutdown();
+}
+
+double simplex_noise_1d(double x) {
+    return simplex_noise_1d_ctx(NULL, x);
+}
+
+double simplex_noise_1d_ctx(const simplex_context_t* ctx, double x) {
+    ctx = context_or_default(ctx);
+    SIMPLEX_PROFILE_BEGIN(ctx);
+    const uint8_t* perm = ctx->tables.perm;
+
+    int i0 = fast_floor(x);
+    int i1 = i0 + 1;
+
+    double x0 = x - i0;
+    double x1 = x0 - 1.0;
+
+    double t0 = 1.0 - (x0 * x0);
+    double t1 = 1.0 - (x1 * x1);
+
+    t0 *= t0;
+    t1 *= t1;
+
+    double n0 = t0 * t0 * dot2d(simplex_grad2[perm[i0 & 0xff] & 7], x0, 0);
+    double n1 = t1 * t1 * dot2d(simplex_grad2[perm[i1 & 0xff] & 7], x1, 0);
+
+    double result = SIMPLEX_2D_SCALE * (n0 + n1);
+    SIMPLEX_PROFILE_END(ctx, SIMPLEX_PROFILE_NOISE_1D, 1);
+    return result;
+}
+
+double simplex_noise_2d(double x, double y) {
+    return simplex_noise_2d_ctx(NULL, x, y);
+}
+
+// Sum of the three corner contributions of a 2D cell; gi are the corners' gradient indices
+static inline double corners_2d(double x0, double y0, int i1, int j1, int gi0, int gi1,
+                                int gi2) {
+    const double G2 = UNSKEW_2D;
     double x1 = x0 - i1 + G2;
     double y1 = y0 - j1 + G2;
     double x2 = x0 - 1.0 + (2.0 * G2);
     double y2 = y0 - 1.0 + (2.0 * G2);
 
-    int ii = i & 0xff;
-    int jj = j & 0xff;
-    int gi0 = perm[ii + perm[jj]] % SIMPLEX_2D_GRAD_COUNT;
-    int gi1 = perm[ii + i1 + perm[jj + j1]] % SIMPLEX_2D_GRAD_COUNT;
-    int gi2 = perm[ii + 1 + perm[jj + 1]] % SIMPLEX_2D_GRAD_COUNT;
-
     double t0 = SIMPLEX_2D_THRESHOLD - (x0 * x0) - (y0 * y0);
     double n0 = 0.0;
     if (t0 >= 0) {
         t0 *= t0;
-        n0 = t0 * t0 * dot2d(grad2[gi0], x0, y0);
+        n0 = t0 * t0 * dot2d(simplex_grad2[gi0], x0, y0);
     }
 
     double t1 = SIMPLEX_2D_THRESHOLD - (x1 * x1) - (y1 * y1);
     double n1 = 0.0;
     if (t1 >= 0) {
         t1 *= t1;
-        n1 = t1 * t1 * dot2d(grad2[gi1], x1, y1);
+        n1 = t1 * t1 * dot2d(simplex_grad2[gi1], x1, y1);
     }
 
     double t2 = SIMPLEX_2D_THRESHOLD - (x2 * x2) - (y2 * y2);
     double n2 = 0.0;
     if (t2 >= 0) {
         t2 *= t2;
-        n2 = t2 * t2 * dot2d(grad2[gi2], x2, y2);
+        n2 = t2 * t2 * dot2d(simplex_grad2[gi2], x2, y2);
     }
 
     return SIMPLEX_2D_SCALE * (n0 + n1 + n2);
 }
 
-double simplex_noise_3d(double x, double y, double z) {
-    if (!initialized) {
-        simplex_noise_init(0);
-    }
-
-    const double F3 = 1.0 / 3.0;
-    const double G3 = 1.0 / 6.0;
+/* One 2D sample without the context lookup and profiling of the public call;
+ * the fractal loops and the scalar array paths evaluate this directly */
+static inline double noise_2d_kernel(const simplex_perm_tables_t* tables, double x, double y) {
+    const uint8_t* perm = tables->perm;
+    const double F2 = SKEW_2D;
+    const double G2 = UNSKEW_2D;
 
-    double s = (x + y + z) * F3;
+    double s = (x + y) * F2;
     int i = fast_floor(x + s);
     int j = fast_floor(y + s);
-    int k = fast_floor(z + s);
 
-    double t = (i + j + k) * G3;
+    double t = (i + j) * G2;
     double x0 = x - (i - t);
     double y0 = y - (j - t);
-    double z0 = z - (k - t);
 
-    int i1;
-    int j1;
-    int k1;
-    int i2;
-    int j2;
-    int k2;
+    int i1 = x0 > y0;
+    int j1 = !i1;
 
+    int ii = i & 0xff;
+    int jj = j & 0xff;
+    int gi0 = perm[ii + perm[jj]] % SIMPLEX_2D_GRAD_COUNT;
+    int gi1 = perm[ii + i1 + perm[jj + j1]] % SIMPLEX_2D_GRAD_COUNT;
+    int gi2 = perm[ii + 1 + perm[jj + 1]] % SIMPLEX_2D_GRAD_COUNT;
+
+    return corners_2d(x0, y0, i1, j1, gi0, gi1, gi2);
+}
+
+// Reuse a cell's gradients only when steps are short enough to stay in it for a while
+#define ROW_REUSE_STEP 0.5
+
+/* A row of 2D samples x_start + x * step. Every sample keeps the exact
+ * coordinates and cell choice of noise_2d_kernel() (and its values), so grid
+ * arrays, fractal arrays and images agree with the point functions at any
+ * distance from the origin; the walk only keeps the gradients of the current
+ * cell's four corners until a sample lands in another cell. */
+static void noise_row_2d(const simplex_perm_tables_t* tables, double x_start, double y,
+                         double step, int count, double* output) {
+    const uint8_t* perm = tables->perm;
+    const double F2 = SKEW_2D;
+    const double G2 = UNSKEW_2D;
+    int reuse = fabs(step * (1.0 + F2)) < ROW_REUSE_STEP;
+    int cell_i = 0;
+    int cell_j = 0;
+    int gi[4] = {0, 0, 0, 0}; // Corners (0,0), (1,0), (0,1), (1,1)
+    for (int n = 0; n < count; n++) {
+        double x = x_start + (n * step);
+        double s = (x + y) * F2;
+        int i = fast_floor(x + s);
+        int j = fast_floor(y + s);
+        double t = (i + j) * G2;
+        double x0 = x - (i - t);
+        double y0 = y - (j - t);
+
+        int i1 = x0 > y0;
+        int j1 = !i1;
+        int ii = i & 0xff;
+        int jj = j & 0xff;
+        if (!reuse) {
+            output[n] = corners_2d(x0, y0, i1, j1, perm[ii + perm[jj]] % SIMPLEX_2D_GRAD_COUNT,
+                                   perm[ii + i1 + perm[jj + j1]] % SIMPLEX_2D_GRAD_COUNT,
+                                   perm[ii + 1 + perm[jj + 1]] % SIMPLEX_2D_GRAD_COUNT);
+            continue;
+        }
+        if (n == 0 || i != cell_i || j != cell_j) {
+            cell_i = i;
+            cell_j = j;
+            int row0 = perm[jj];
+            int row1 = perm[jj + 1];
+            gi[0] = perm[ii + row0] % SIMPLEX_2D_GRAD_COUNT;
+            gi[1] = perm[ii + 1 + row0] % SIMPLEX_2D_GRAD_COUNT;
+            gi[2] = perm[ii + row1] % SIMPLEX_2D_GRAD_COUNT;
+            gi[3] = perm[ii + 1 + row1] % SIMPLEX_2D_GRAD_COUNT;
+        }
+        output[n] = corners_2d(x0, y0, i1, j1, gi[0], gi[2 - i1], gi[3]);
+    }
+}
+
+double simplex_noise_2d_ctx(const simplex_context_t* ctx, double x, double y) {
+    ctx = context_or_default(ctx);
+    SIMPLEX_PROFILE_BEGIN(ctx);
+    double result = noise_2d_kernel(&ctx->tables, x, y);
+    SIMPLEX_PROFILE_END(ctx, SIMPLEX_PROFILE_NOISE_2D, 1);
+    return result;
+}
+
+double simplex_noise_3d(double x, double y, double z) {
+    return simplex_noise_3d_ctx(NULL, x, y, z);
+}
+
+/* Second and third corners of the 3D simplex containing (x0, y0, z0), as cube
+ * corner codes (4 * i + 2 * j + k) */
+static inline void order_3d(double x0, double y0, double z0, int* second, int* third) {
     if (x0 >= y0) {
         if (y0 >= z0) {
-            i1 = 1;
-            j1 = 0;
-            k1 = 0;
-            i2 = 1;
-            j2 = 1;
-            k2 = 0;
+            *second = 4;
+            *third = 6;
         } else if (x0 >= z0) {
-            i1 = 1;
-            j1 = 0;
-            k1 = 0;
-            i2 = 1;
-            j2 = 0;
-            k2 = 1;
+            *second = 4;
+            *third = 5;
         } else {
-            i1 = 0;
-            j1 = 0;
-            k1 = 1;
-            i2 = 1;
-            j2 = 0;
-            k2 = 1;
+            *second = 1;
+            *third = 5;
         }
     } else {
         if (y0 < z0) {
-            i1 = 0;
-            j1 = 0;
-            k1 = 1;
-            i2 = 0;
-            j2 = 1;
-            k2 = 1;
+            *second = 1;
+            *third = 3;
         } else if (x0 < z0) {
-            i1 = 0;
-            j1 = 1;
-            k1 = 0;
-            i2 = 0;
-            j2 = 1;
-            k2 = 1;
+            *second = 2;
+            *third = 3;
         } else {
-            i1 = 0;
-            j1 = 1;
-            k1 = 0;
-            i2 = 1;
-            j2 = 1;
-            k2 = 0;
+            *second = 2;
+            *third = 6;
         }
     }
+}
+
+// Sum of the four corner contributions of a 3D simplex, corners as in order_3d()
+static inline double corners_3d(double x0, double y0, double z0, int second, int third,
+                                int gi0, int gi1, int gi2, int gi3) {
+    const double G3 = UNSKEW_3D;
+    int i1 = second >> 2;
+    int j1 = (second >> 1) & 1;
+    int k1 = second & 1;
+    int i2 = third >> 2;
+    int j2 = (third >> 1) & 1;
+    int k2 = third & 1;
 
     double x1 = x0 - i1 + G3;
     double y1 = y0 - j1 + G3;
@@ -1708,49 +3550,285 @@ double simplex_noise_3d(double x, double y, double z) {
     double y3 = y0 - 1.0 + (3.0 * G3);
     double z3 = z0 - 1.0 + (3.0 * G3);
 
-    int ii = i & 0xff;
-    int jj = j & 0xff;
-    int kk = k & 0xff;
-    int gi0 = perm[ii + perm[jj + perm[kk]]] % 12;
-    int gi1 = perm[ii + i1 + perm[jj + j1 + perm[kk + k1]]] % 12;
-    int gi2 = perm[ii + i2 + perm[jj + j2 + perm[kk + k2]]] % 12;
-    int gi3 = perm[ii + 1 + perm[jj + 1 + perm[kk + 1]]] % 12;
-
     double t0 = 0.6 - (x0 * x0) - (y0 * y0) - (z0 * z0);
     double n0 = 0.0;
     if (t0 >= 0) {
         t0 *= t0;
-        n0 = t0 * t0 * dot3d(grad3[gi0], x0, y0, z0);
+        n0 = t0 * t0 * dot3d(simplex_grad3[gi0], x0, y0, z0);
     }
 
     double t1 = 0.6 - (x1 * x1) - (y1 * y1) - (z1 * z1);
     double n1 = 0.0;
     if (t1 >= 0) {
         t1 *= t1;
-        n1 = t1 * t1 * dot3d(grad3[gi1], x1, y1, z1);
+        n1 = t1 * t1 * dot3d(simplex_grad3[gi1], x1, y1, z1);
     }
 
     double t2 = 0.6 - (x2 * x2) - (y2 * y2) - (z2 * z2);
     double n2 = 0.0;
     if (t2 >= 0) {
         t2 *= t2;
-        n2 = t2 * t2 * dot3d(grad3[gi2], x2, y2, z2);
+        n2 = t2 * t2 * dot3d(simplex_grad3[gi2], x2, y2, z2);
     }
 
     double t3 = 0.6 - (x3 * x3) - (y3 * y3) - (z3 * z3);
     double n3 = 0.0;
     if (t3 >= 0) {
         t3 *= t3;
-        n3 = t3 * t3 * dot3d(grad3[gi3], x3, y3, z3);
+        n3 = t3 * t3 * dot3d(simplex_grad3[gi3], x3, y3, z3);
     }
 
     return SIMPLEX_3D_SCALE * (n0 + n1 + n2 + n3);
 }
 
-double simplex_noise_4d(double x, double y, double z, double w) {
-    if (!initialized) {
-        simplex_noise_init(0);
+// Gradient index of cube corner `code` (as in order_3d()) of the cell at ii, jj, kk
+static inline int hash_3d(const simplex_perm_tables_t* tables, int ii, int jj, int kk,
+                          int code) {
+    const uint8_t* perm = tables->perm;
+    return tables->mod12[ii + (code >> 2) + perm[jj + ((code >> 1) & 1) + perm[kk + (code & 1)]]];
+}
+
+// One 3D sample, the counterpart of noise_2d_kernel()
+static inline double noise_3d_kernel(const simplex_perm_tables_t* tables, double x, double y,
+                                      double z) {
+    const double F3 = SKEW_3D;
+    const double G3 = UNSKEW_3D;
+
+    double s = (x + y + z) * F3;
+    int i = fast_floor(x + s);
+    int j = fast_floor(y + s);
+    int k = fast_floor(z + s);
+
+    double t = (i + j + k) * G3;
+    double x0 = x - (i - t);
+    double y0 = y - (j - t);
+    double z0 = z - (k - t);
+
+    int second;
+    int third;
+    order_3d(x0, y0, z0, &second, &third);
+
+    int ii = i & 0xff;
+    int jj = j & 0xff;
+    int kk = k & 0xff;
+    return corners_3d(x0, y0, z0, second, third, hash_3d(tables, ii, jj, kk, 0),
+                      hash_3d(tables, ii, jj, kk, second), hash_3d(tables, ii, jj, kk, third),
+                      hash_3d(tables, ii, jj, kk, 7));
+}
+
+/* A row of 3D samples x_start + x * step, the counterpart of noise_row_2d():
+ * every sample keeps the exact coordinates and cell choice of
+ * noise_3d_kernel(), and only the gradients of the current cube's eight
+ * corners are kept until a sample lands in another cube. */
+static void noise_row_3d(const simplex_perm_tables_t* tables, double x_start, double y,
+                         double z, double step, int count, double* output) {
+    const double F3 = SKEW_3D;
+    const double G3 = UNSKEW_3D;
+    int reuse = fabs(step * (1.0 + F3)) < ROW_REUSE_STEP;
+    int cell_i = 0;
+    int cell_j = 0;
+    int cell_k = 0;
+    int gi[8] = {0}; // Indexed by cube corner code
+    for (int n = 0; n < count; n++) {
+        double x = x_start + (n * step);
+        double s = (x + y + z) * F3;
+        int i = fast_floor(x + s);
+        int j = fast_floor(y + s);
+        int k = fast_floor(z + s);
+        double t = (i + j + k) * G3;
+        double x0 = x - (i - t);
+        double y0 = y - (j - t);
+        double z0 = z - (k - t);
+
+        int second;
+        int third;
+        order_3d(x0, y0, z0, &second, &third);
+        int ii = i & 0xff;
+        int jj = j & 0xff;
+        int kk = k & 0xff;
+        if (!reuse) {
+            output[n] = corners_3d(x0, y0, z0, second, third, hash_3d(tables, ii, jj, kk, 0),
+                                   hash_3d(tables, ii, jj, kk, second),
+                                   hash_3d(tables, ii, jj, kk, third),
+                                   hash_3d(tables, ii, jj, kk, 7));
+            continue;
+        }
+        if (n == 0 || i != cell_i || j != cell_j || k != cell_k) {
+            cell_i = i;
+            cell_j = j;
+            cell_k = k;
+            for (int c = 0; c < 8; c++) {
+                gi[c] = hash_3d(tables, ii, jj, kk, c);
+            }
+        }
+        output[n] = corners_3d(x0, y0, z0, second, third, gi[0], gi[second], gi[third], gi[7]);
+    }
+}
+
+/* ===== CHUNK-ORIGIN ROWS ===== */
+
+/* The integer cell and exact fraction of the world coordinate origin + local.
+ * Everything an origin row computes depends only on this split point. */
+static inline int64_t split_local(int64_t origin, double local, double* fraction) {
+    double whole = floor(local);
+    *fraction = local - whole;
+    return origin + (int64_t)whole;
+}
+
+/* Skew of the integer lattice sum n, split into floor(n * F2) and the rest;
+ * the product is carried in two doubles so the rest stays exact to rounding */
+static void skew_cells_2d(int64_t n, int64_t* whole, double* rest) {
+    double hi = (double)n * SKEW_2D;
+    double lo = fma((double)n, SKEW_2D, -hi);
+    double k = floor(hi);
+    *whole = (int64_t)k;
+    *rest = (hi - k) + lo;
+}
+
+// The same split for F3 = 1/3, where floor(n / 3) is exact in integers
+static void skew_cells_3d(int64_t n, int64_t* whole, double* rest) {
+    int64_t k = n / 3 - (n % 3 < 0);
+    *whole = k;
+    *rest = (double)(n - (3 * k)) / 3.0;
+}
+
+/* A row of 2D samples at world x = origin_x + x_offset + x * step and world
+ * y = iy + fy. The skew is applied to the integer cells and fractions apart,
+ * so every sample works on small local coordinates however far the chunk is
+ * from the origin, and the cell's corner gradients are kept as in
+ * noise_row_2d(). */
+static void origin_row_2d(const simplex_perm_tables_t* tables, int64_t origin_x, double x_offset,
+                          int64_t iy, double fy, double step, int count, double* output) {
+    const uint8_t* perm = tables->perm;
+    int reuse = fabs(step * (1.0 + SKEW_2D)) < ROW_REUSE_STEP;
+    int64_t sum = 0;
+    int64_t skew = 0;
+    double rest = 0.0;
+    int64_t cell_i = 0;
+    int64_t cell_j = 0;
+    int gi[4] = {0, 0, 0, 0}; // Corners (0,0), (1,0), (0,1), (1,1)
+    for (int n = 0; n < count; n++) {
+        double fx;
+        int64_t ix = split_local(origin_x, x_offset + (n * step), &fx);
+        if (n == 0 || ix + iy != sum) {
+            sum = ix + iy;
+            skew_cells_2d(sum, &skew, &rest);
+        }
+        double f = (fx + fy) * SKEW_2D;
+        double u = (fx + rest) + f;
+        double v = (fy + rest) + f;
+        double cu = floor(u);
+        double cv = floor(v);
+        int64_t i = ix + skew + (int64_t)cu;
+        int64_t j = iy + skew + (int64_t)cv;
+        double a = u - cu;
+        double b = v - cv;
+        double t = (a + b) * UNSKEW_2D;
+        double x0 = a - t;
+        double y0 = b - t;
+
+        int i1 = x0 > y0;
+        int j1 = !i1;
+        int ii = (int)(i & 0xff);
+        int jj = (int)(j & 0xff);
+        if (!reuse) {
+            output[n] = corners_2d(x0, y0, i1, j1, perm[ii + perm[jj]] % SIMPLEX_2D_GRAD_COUNT,
+                                   perm[ii + i1 + perm[jj + j1]] % SIMPLEX_2D_GRAD_COUNT,
+                                   perm[ii + 1 + perm[jj + 1]] % SIMPLEX_2D_GRAD_COUNT);
+            continue;
+        }
+        if (n == 0 || i != cell_i || j != cell_j) {
+            cell_i = i;
+            cell_j = j;
+            int row0 = perm[jj];
+            int row1 = perm[jj + 1];
+            gi[0] = perm[ii + row0] % SIMPLEX_2D_GRAD_COUNT;
+            gi[1] = perm[ii + 1 + row0] % SIMPLEX_2D_GRAD_COUNT;
+            gi[2] = perm[ii + row1] % SIMPLEX_2D_GRAD_COUNT;
+            gi[3] = perm[ii + 1 + row1] % SIMPLEX_2D_GRAD_COUNT;
+        }
+        output[n] = corners_2d(x0, y0, i1, j1, gi[0], gi[2 - i1], gi[3]);
+    }
+}
+
+// The 3D counterpart of origin_row_2d(), at world y = iy + fy and z = iz + fz
+static void origin_row_3d(const simplex_perm_tables_t* tables, int64_t origin_x, double x_offset,
+                          int64_t iy, double fy, int64_t iz, double fz, double step, int count,
+                          double* output) {
+    int reuse = fabs(step * (1.0 + SKEW_3D)) < ROW_REUSE_STEP;
+    int64_t sum = 0;
+    int64_t skew = 0;
+    double rest = 0.0;
+    int64_t cell_i = 0;
+    int64_t cell_j = 0;
+    int64_t cell_k = 0;
+    int gi[8] = {0}; // Indexed by cube corner code
+    for (int n = 0; n < count; n++) {
+        double fx;
+        int64_t ix = split_local(origin_x, x_offset + (n * step), &fx);
+        if (n == 0 || ix + iy + iz != sum) {
+            sum = ix + iy + iz;
+            skew_cells_3d(sum, &skew, &rest);
+        }
+        double f = (fx + fy + fz) * SKEW_3D;
+        double u = (fx + rest) + f;
+        double v = (fy + rest) + f;
+        double w = (fz + rest) + f;
+        double cu = floor(u);
+        double cv = floor(v);
+        double cw = floor(w);
+        int64_t i = ix + skew + (int64_t)cu;
+        int64_t j = iy + skew + (int64_t)cv;
+        int64_t k = iz + skew + (int64_t)cw;
+        double a = u - cu;
+        double b = v - cv;
+        double c = w - cw;
+        double t = (a + b + c) * UNSKEW_3D;
+        double x0 = a - t;
+        double y0 = b - t;
+        double z0 = c - t;
+
+        int second;
+        int third;
+        order_3d(x0, y0, z0, &second, &third);
+        int ii = (int)(i & 0xff);
+        int jj = (int)(j & 0xff);
+        int kk = (int)(k & 0xff);
+        if (!reuse) {
+            output[n] = corners_3d(x0, y0, z0, second, third, hash_3d(tables, ii, jj, kk, 0),
+                                   hash_3d(tables, ii, jj, kk, second),
+                                   hash_3d(tables, ii, jj, kk, third),
+                                   hash_3d(tables, ii, jj, kk, 7));
+            continue;
+        }
+        if (n == 0 || i != cell_i || j != cell_j || k != cell_k) {
+            cell_i = i;
+            cell_j = j;
+            cell_k = k;
+            for (int corner = 0; corner < 8; corner++) {
+                gi[corner] = hash_3d(tables, ii, jj, kk, corner);
+            }
+        }
+        output[n] = corners_3d(x0, y0, z0, second, third, gi[0], gi[second], gi[third], gi[7]);
     }
+}
+
+double simplex_noise_3d_ctx(const simplex_context_t* ctx, double x, double y, double z) {
+    ctx = context_or_default(ctx);
+    SIMPLEX_PROFILE_BEGIN(ctx);
+    double result = noise_3d_kernel(&ctx->tables, x, y, z);
+    SIMPLEX_PROFILE_END(ctx, SIMPLEX_PROFILE_NOISE_3D, 1);
+    return result;
+}
+
+double simplex_noise_4d(double x, double y, double z, double w) {
+    return simplex_noise_4d_ctx(NULL, x, y, z, w);
+}
+
+double simplex_noise_4d_ctx(const simplex_context_t* ctx, double x, double y, double z, double w) {
+    ctx = context_or_default(ctx);
+    SIMPLEX_PROFILE_BEGIN(ctx);
+    const uint8_t* perm = ctx->tables.perm;
 
     const double F4 = (sqrt(5.0) - 1.0) / 4.0;
     const double G4 = (5.0 - sqrt(5.0)) / 20.0;
@@ -1767,54 +3845,57 @@ double simplex_noise_4d(double x, double y, double z, double w) {
     double z0 = z - (k - t);
     double w0 = w - (l - t);
 
-    int c1 = (x0 > y0) ? 32 : 0;
-    int c2 = (x0 > z0) ? 16 : 0;
-    int c3 = (y0 > z0) ? 8 : 0;
-    int c4 = (x0 > w0) ? 4 : 0;
-    int c5 = (y0 > w0) ? 2 : 0;
-    int c6 = (z0 > w0) ? 1 : 0;
-    int c = c1 + c2 + c3 + c4 + c5 + c6;
-
-    int i1;
-    int j1;
-    int k1;
-    int l1;
-    int i2;
-    int j2;
-    int k2;
-    int l2;
-    int i3;
-    int j3;
-    int k3;
-    int l3;
-
-    static const int simplex[64][4] = {
-        {0, 1, 2, 3}, {0, 1, 3, 2}, {0, 0, 1, 1}, {0, 2, 3, 1}, {0, 0, 1, 1}, {0, 0, 1, 1},
-        {0, 0, 1, 1}, {1, 2, 3, 0}, {0, 2, 1, 3}, {0, 0, 1, 1}, {0, 0, 1, 1}, {0, 0, 1, 1},
-        {1, 3, 0, 2}, {0, 0, 1, 1}, {0, 0, 1, 1}, {0, 0, 1, 1}, {0, 0, 1, 1}, {0, 0, 1, 1},
-        {0, 0, 1, 1}, {0, 0, 1, 1}, {0, 0, 1, 1}, {0, 0, 1, 1}, {0, 0, 1, 1}, {0, 0, 1, 1},
-        {1, 2, 0, 3}, {0, 0, 1, 1}, {0, 0, 1, 1}, {0, 0, 1, 1}, {1, 3, 2, 0}, {0, 0, 1, 1},
-        {0, 0, 1, 1}, {0, 0, 1, 1}, {0, 0, 1, 1}, {0, 0, 1, 1}, {0, 0, 1, 1}, {0, 0, 1, 1},
-        {0, 0, 1, 1}, {0, 0, 1, 1}, {0, 0, 1, 1}, {0, 0, 1, 1}, {2, 3, 0, 1}, {0, 0, 1, 1},
-        {0, 0, 1, 1}, {0, 0, 1, 1}, {2, 3, 1, 0}, {0, 0, 1, 1}, {0, 0, 1, 1}, {0, 0, 1, 1},
-        {0, 0, 1, 1}, {0, 0, 1, 1}, {0, 0, 1, 1}, {0, 0, 1, 1}, {0, 0, 1, 1}, {0, 0, 1, 1},
-        {0, 0, 1, 1}, {0, 0, 1, 1}, {2, 0, 3, 1}, {0, 0, 1, 1}, {0, 0, 1, 1}, {0, 0, 1, 1},
-        {3, 0, 1, 2}, {3, 1, 0, 2}, {0, 0, 1, 1}, {0, 0, 1, 1}};
-
-    i1 = simplex[c][0] >= 3 ? 1 : 0;
-    j1 = simplex[c][1] >= 3 ? 1 : 0;
-    k1 = simplex[c][2] >= 3 ? 1 : 0;
-    l1 = simplex[c][3] >= 3 ? 1 : 0;
-
-    i2 = simplex[c][0] >= 2 ? 1 : 0;
-    j2 = simplex[c][1] >= 2 ? 1 : 0;
-    k2 = simplex[c][2] >= 2 ? 1 : 0;
-    l2 = simplex[c][3] >= 2 ? 1 : 0;
-
-    i3 = simplex[c][0] >= 1 ? 1 : 0;
-    j3 = simplex[c][1] >= 1 ? 1 : 0;
-    k3 = simplex[c][2] >= 1 ? 1 : 0;
-    l3 = simplex[c][3] >= 1 ? 1 : 0;
+    // Rank each coordinate by how many of the others it exceeds; the rank
+    // decides at which corner step that axis is incremented.
+    int rank_x = 0;
+    int rank_y = 0;
+    int rank_z = 0;
+    int rank_w = 0;
+    if (x0 > y0) {
+        rank_x++;
+    } else {
+        rank_y++;
+    }
+    if (x0 > z0) {
+        rank_x++;
+    } else {
+        rank_z++;
+    }
+    if (x0 > w0) {
+        rank_x++;
+    } else {
+        rank_w++;
+    }
+    if (y0 > z0) {
+        rank_y++;
+    } else {
+        rank_z++;
+    }
+    if (y0 > w0) {
+        rank_y++;
+    } else {
+        rank_w++;
+    }
+    if (z0 > w0) {
+        rank_z++;
+    } else {
+        rank_w++;
+    }
+
+    int i1 = rank_x >= 3 ? 1 : 0;
+    int j1 = rank_y >= 3 ? 1 : 0;
+    int k1 = rank_z >= 3 ? 1 : 0;
+    int l1 = rank_w >= 3 ? 1 : 0;
+
+    int i2 = rank_x >= 2 ? 1 : 0;
+    int j2 = rank_y >= 2 ? 1 : 0;
+    int k2 = rank_z >= 2 ? 1 : 0;
+    int l2 = rank_w >= 2 ? 1 : 0;
+
+    int i3 = rank_x >= 1 ? 1 : 0;
+    int j3 = rank_y >= 1 ? 1 : 0;
+    int k3 = rank_z >= 1 ? 1 : 0;
+    int l3 = rank_w >= 1 ? 1 : 0;
 
     double x1 = x0 - i1 + G4;
     double y1 = y0 - j1 + G4;
@@ -1847,71 +3928,160 @@ double simplex_noise_4d(double x, double y, double z, double w) {
     double n0 = 0.0;
     if (t0 >= 0) {
         t0 *= t0;
-        n0 = t0 * t0 * dot4d(grad4[gi0], x0, y0, z0, w0);
+        n0 = t0 * t0 * dot4d(simplex_grad4[gi0], x0, y0, z0, w0);
     }
 
     double t1 = 0.6 - (x1 * x1) - (y1 * y1) - (z1 * z1) - (w1 * w1);
     double n1 = 0.0;
     if (t1 >= 0) {
         t1 *= t1;
-        n1 = t1 * t1 * dot4d(grad4[gi1], x1, y1, z1, w1);
+        n1 = t1 * t1 * dot4d(simplex_grad4[gi1], x1, y1, z1, w1);
     }
 
     double t2 = 0.6 - (x2 * x2) - (y2 * y2) - (z2 * z2) - (w2 * w2);
     double n2 = 0.0;
     if (t2 >= 0) {
         t2 *= t2;
-        n2 = t2 * t2 * dot4d(grad4[gi2], x2, y2, z2, w2);
+        n2 = t2 * t2 * dot4d(simplex_grad4[gi2], x2, y2, z2, w2);
     }
 
     double t3 = 0.6 - (x3 * x3) - (y3 * y3) - (z3 * z3) - (w3 * w3);
     double n3 = 0.0;
     if (t3 >= 0) {
         t3 *= t3;
-        n3 = t3 * t3 * dot4d(grad4[gi3], x3, y3, z3, w3);
+        n3 = t3 * t3 * dot4d(simplex_grad4[gi3], x3, y3, z3, w3);
     }
 
     double t4 = 0.6 - (x4 * x4) - (y4 * y4) - (z4 * z4) - (w4 * w4);
     double n4 = 0.0;
     if (t4 >= 0) {
         t4 *= t4;
-        n4 = t4 * t4 * dot4d(grad4[gi4], x4, y4, z4, w4);
+        n4 = t4 * t4 * dot4d(simplex_grad4[gi4], x4, y4, z4, w4);
     }
 
-    return SIMPLEX_4D_SCALE * (n0 + n1 + n2 + n3 + n4);
+    double result = SIMPLEX_4D_SCALE * (n0 + n1 + n2 + n3 + n4);
+    SIMPLEX_PROFILE_END(ctx, SIMPLEX_PROFILE_NOISE_4D, 1);
+    return result;
+}
+
+// Single-precision noise through the one-lane float32 kernels
+float simplex_noise_2df(float x, float y) {
+    return simplex_noise_2df_ctx(NULL, x, y);
+}
+
+float simplex_noise_2df_ctx(const simplex_context_t* ctx, float x, float y) {
+    ctx = context_or_default(ctx);
+    SIMPLEX_PROFILE_BEGIN(ctx);
+    float result = 0.0f;
+    simplex_kernels_f32_scalar.noise_2d(&ctx->tables, &x, &y, 1, &result);
+    SIMPLEX_PROFILE_END(ctx, SIMPLEX_PROFILE_NOISE_FLOAT, 1);
+    return result;
+}
+
+float simplex_noise_3df(float x, float y, float z) {
+    return simplex_noise_3df_ctx(NULL, x, y, z);
+}
+
+float simplex_noise_3df_ctx(const simplex_context_t* ctx, float x, float y, float z) {
+    ctx = context_or_default(ctx);
+    SIMPLEX_PROFILE_BEGIN(ctx);
+    float result = 0.0f;
+    simplex_kernels_f32_scalar.noise_3d(&ctx->tables, &x, &y, &z, 1, &result);
+    SIMPLEX_PROFILE_END(ctx, SIMPLEX_PROFILE_NOISE_FLOAT, 1);
+    return result;
+}
+
+float simplex_noise_4df(float x, float y, float z, float w) {
+    return simplex_noise_4df_ctx(NULL, x, y, z, w);
+}
+
+float simplex_noise_4df_ctx(const simplex_context_t* ctx, float x, float y, float z, float w) {
+    ctx = context_or_default(ctx);
+    SIMPLEX_PROFILE_BEGIN(ctx);
+    float result = 0.0f;
+    simplex_kernels_f32_scalar.noise_4d(&ctx->tables, &x, &y, &z, &w, 1, &result);
+    SIMPLEX_PROFILE_END(ctx, SIMPLEX_PROFILE_NOISE_FLOAT, 1);
+    return result;
+}
+
+double simplex_noise_2d_seeded(double x, double y, uint32_t seed) {
+    return simplex_noise_2d_seeded_ctx(NULL, x, y, seed);
+}
+
+double simplex_noise_2d_seeded_ctx(const simplex_context_t* ctx, double x, double y,
+                                   uint32_t seed) {
+    ctx = context_or_default(ctx);
+    SIMPLEX_PROFILE_BEGIN(ctx);
+    double result = 0.0;
+    simplex_kernels_scalar.layers_2d(&seed, 1, x, y, 0.0, 1, 1, &result);
+    SIMPLEX_PROFILE_END(ctx, SIMPLEX_PROFILE_NOISE_2D, 1);
+    return result;
+}
+
+double simplex_noise_3d_seeded(double x, double y, double z, uint32_t seed) {
+    return simplex_noise_3d_seeded_ctx(NULL, x, y, z, seed);
+}
+
+double simplex_noise_3d_seeded_ctx(const simplex_context_t* ctx, double x, double y, double z,
+                                   uint32_t seed) {
+    ctx = context_or_default(ctx);
+    SIMPLEX_PROFILE_BEGIN(ctx);
+    double result = 0.0;
+    simplex_kernels_scalar.layers_3d(&seed, 1, x, y, z, 0.0, 1, 1, &result);
+    SIMPLEX_PROFILE_END(ctx, SIMPLEX_PROFILE_NOISE_3D, 1);
+    return result;
 }
 
 double simplex_fractal_2d(double x, double y, int octaves, double persistence, double lacunarity) {
+    return simplex_fractal_2d_ctx(NULL, x, y, octaves, persistence, lacunarity);
+}
+
+double simplex_fractal_2d_ctx(const simplex_context_t* ctx, double x, double y, int octaves,
+                              double persistence, double lacunarity) {
+    ctx = context_or_default(ctx);
+    SIMPLEX_PROFILE_BEGIN(ctx);
     double value = 0.0;
     double amplitude = 1.0;
     double frequency = 1.0;
     double maxValue = 0.0;
 
     for (int i = 0; i < octaves; i++) {
-        value += simplex_noise_2d(x * frequency, y * frequency) * amplitude;
+        value += noise_2d_kernel(&ctx->tables, x * frequency, y * frequency) * amplitude;
         maxValue += amplitude;
         amplitude *= persistence;
         frequency *= lacunarity;
     }
 
-    return value / maxValue;
+    double result = value / maxValue;
+    SIMPLEX_PROFILE_END(ctx, SIMPLEX_PROFILE_FBM, 1);
+    return result;
 }
 
 double simplex_fractal_3d(double x, double y, double z, int octaves, double persistence,
                           double lacunarity) {
+    return simplex_fractal_3d_ctx(NULL, x, y, z, octaves, persistence, lacunarity);
+}
+
+double simplex_fractal_3d_ctx(const simplex_context_t* ctx, double x, double y, double z,
+                              int octaves, double persistence, double lacunarity) {
+    ctx = context_or_default(ctx);
+    SIMPLEX_PROFILE_BEGIN(ctx);
     double value = 0.0;
     double amplitude = 1.0;
     double frequency = 1.0;
     double maxValue = 0.0;
 
     for (int i = 0; i < octaves; i++) {
-        value += simplex_noise_3d(x * frequency, y * frequency, z * frequency) * amplitude;
+        value +=
+            noise_3d_kernel(&ctx->tables, x * frequency, y * frequency, z * frequency) * amplitude;
         maxValue += amplitude;
         amplitude *= persistence;
         frequency *= lacunarity;
     }
 
-    return value / maxValue;
+    double result = value / maxValue;
+    SIMPLEX_PROFILE_END(ctx, SIMPLEX_PROFILE_FBM, 1);
+    return result;
 }
 
 #pragma GCC diagnostic pop
@@ -0,0 +1,511 @@
+/**
+ * @file simplex_opencl.c
+ * @brief OpenCL offload of grid noise and fractal arrays
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @details Built with SIMPLEX_HAVE_OPENCL when CMake finds OpenCL; otherwise
+ *          every function here is a stub and contexts stay on the CPU. A
+ *          device is opened per context that sets enable_gpu, and its
+ *          permutation table is uploaded once per seed. The kernels repeat
+ *          the scalar kernels' arithmetic in the same order with FMA
+ *          contraction off and are meant to match the CPU within
+ *          SIMPLEX_SIMD_TOLERANCE. That is untested: the device path has not
+ *          yet been run on a real OpenCL device, and without one test_gpu
+ *          only checks the CPU fallback. Jobs run in slabs of rows that
+ *          alternate between two device buffers: one queue computes the next
+ *          slab while a second one copies the previous slab into the caller's
+ *          buffer.
+ *
+ * @author Adrian Paredez
+ * @version 2.0.0
+ * @date 9/5/2025
+ */
+
+#include "simplex_internal.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(SIMPLEX_HAVE_OPENCL)
+
+#define CL_TARGET_OPENCL_VERSION 120
+#if defined(__APPLE__)
+#include <OpenCL/opencl.h>
+#else
+#include <CL/cl.h>
+#endif
+
+enum { GPU_NAME_SIZE = 128, GPU_MAX_PLATFORMS = 8, GPU_MAX_DEVICES = 16, GPU_OPTIONS_SIZE = 256 };
+
+/* noise_2d_kernel(), noise_3d_kernel() and fractal_tile() of simplex_noise.c
+ * for one grid sample per work item. The GPU_* kinds come from the build
+ * options so they always match simplex_gpu_kind_t. Split in pieces below the
+ * 4095 characters C99 guarantees for a string literal. */
+static const char* kernel_source[] = {
+    "#pragma OPENCL EXTENSION cl_khr_fp64 : enable\n"
+    "#pragma OPENCL FP_CONTRACT OFF\n"
+    "\n"
+    "__constant double grad2[8][2] = {{1, 1}, {-1, 1}, {1, -1}, {-1, -1},\n"
+    "                                 {1, 0}, {-1, 0}, {0, 1},  {0, -1}};\n"
+    "__constant double grad3[12][3] = {\n"
+    "    {1, 1, 0}, {-1, 1, 0}, {1, -1, 0}, {-1, -1, 0}, {1, 0, 1},  {-1, 0, 1},\n"
+    "    {1, 0, -1}, {-1, 0, -1}, {0, 1, 1}, {0, -1, 1}, {0, 1, -1}, {0, -1, -1}};\n"
+    "\n"
+    "int fast_floor(double x) {\n"
+    "    return x > 0 ? (int)x : (int)x - 1;\n"
+    "}\n"
+    "\n"
+    "double corner2(__constant double* g, double x, double y) {\n"
+    "    double t = 0.5 - (x * x) - (y * y);\n"
+    "    if (t < 0) {\n"
+    "        return 0.0;\n"
+    "    }\n"
+    "    t *= t;\n"
+    "    return t * t * ((g[0] * x) + (g[1] * y));\n"
+    "}\n"
+    "\n"
+    "double corner3(__constant double* g, double x, double y, double z) {\n"
+    "    double t = 0.6 - (x * x) - (y * y) - (z * z);\n"
+    "    if (t < 0) {\n"
+    "        return 0.0;\n"
+    "    }\n"
+    "    t *= t;\n"
+    "    return t * t * ((g[0] * x) + (g[1] * y) + (g[2] * z));\n"
+    "}\n"
+    "\n"
+    "double noise2(__constant uchar* perm, double x, double y) {\n"
+    "    const double F2 = 0.3660254037844386;\n"
+    "    const double G2 = 0.21132486540518713;\n"
+    "    double s = (x + y) * F2;\n"
+    "    int i = fast_floor(x + s);\n"
+    "    int j = fast_floor(y + s);\n"
+    "    double t = (i + j) * G2;\n"
+    "    double x0 = x - (i - t);\n"
+    "    double y0 = y - (j - t);\n"
+    "    int i1 = x0 > y0 ? 1 : 0;\n"
+    "    int j1 = 1 - i1;\n"
+    "    double x1 = x0 - i1 + G2;\n"
+    "    double y1 = y0 - j1 + G2;\n"
+    "    double x2 = x0 - 1.0 + (2.0 * G2);\n"
+    "    double y2 = y0 - 1.0 + (2.0 * G2);\n"
+    "    int ii = i & 0xff;\n"
+    "    int jj = j & 0xff;\n"
+    "    double n0 = corner2(grad2[perm[ii + perm[jj]] % 8], x0, y0);\n"
+    "    double n1 = corner2(grad2[perm[ii + i1 + perm[jj + j1]] % 8], x1, y1);\n"
+    "    double n2 = corner2(grad2[perm[ii + 1 + perm[jj + 1]] % 8], x2, y2);\n"
+    "    return 70.0 * (n0 + n1 + n2);\n"
+    "}\n",
+
+    "double noise3(__constant uchar* perm, double x, double y, double z) {\n"
+    "    const double F3 = 1.0 / 3.0;\n"
+    "    const double G3 = 1.0 / 6.0;\n"
+    "    double s = (x + y + z) * F3;\n"
+    "    int i = fast_floor(x + s);\n"
+    "    int j = fast_floor(y + s);\n"
+    "    int k = fast_floor(z + s);\n"
+    "    double t = (i + j + k) * G3;\n"
+    "    double x0 = x - (i - t);\n"
+    "    double y0 = y - (j - t);\n"
+    "    double z0 = z - (k - t);\n"
+    "    int i1, j1, k1, i2, j2, k2;\n"
+    "    if (x0 >= y0) {\n"
+    "        if (y0 >= z0) {\n"
+    "            i1 = 1; j1 = 0; k1 = 0; i2 = 1; j2 = 1; k2 = 0;\n"
+    "        } else if (x0 >= z0) {\n"
+    "            i1 = 1; j1 = 0; k1 = 0; i2 = 1; j2 = 0; k2 = 1;\n"
+    "        } else {\n"
+    "            i1 = 0; j1 = 0; k1 = 1; i2 = 1; j2 = 0; k2 = 1;\n"
+    "        }\n"
+    "    } else if (y0 < z0) {\n"
+    "        i1 = 0; j1 = 0; k1 = 1; i2 = 0; j2 = 1; k2 = 1;\n"
+    "    } else if (x0 < z0) {\n"
+    "        i1 = 0; j1 = 1; k1 = 0; i2 = 0; j2 = 1; k2 = 1;\n"
+    "    } else {\n"
+    "        i1 = 0; j1 = 1; k1 = 0; i2 = 1; j2 = 1; k2 = 0;\n"
+    "    }\n"
+    "    double x1 = x0 - i1 + G3;\n"
+    "    double y1 = y0 - j1 + G3;\n"
+    "    double z1 = z0 - k1 + G3;\n"
+    "    double x2 = x0 - i2 + (2.0 * G3);\n"
+    "    double y2 = y0 - j2 + (2.0 * G3);\n"
+    "    double z2 = z0 - k2 + (2.0 * G3);\n"
+    "    double x3 = x0 - 1.0 + (3.0 * G3);\n"
+    "    double y3 = y0 - 1.0 + (3.0 * G3);\n"
+    "    double z3 = z0 - 1.0 + (3.0 * G3);\n"
+    "    int ii = i & 0xff;\n"
+    "    int jj = j & 0xff;\n"
+    "    int kk = k & 0xff;\n"
+    "    double n0 = corner3(grad3[perm[ii + perm[jj + perm[kk]]] % 12], x0, y0, z0);\n"
+    "    double n1 =\n"
+    "        corner3(grad3[perm[ii + i1 + perm[jj + j1 + perm[kk + k1]]] % 12], x1, y1, z1);\n"
+    "    double n2 =\n"
+    "        corner3(grad3[perm[ii + i2 + perm[jj + j2 + perm[kk + k2]]] % 12], x2, y2, z2);\n"
+    "    double n3 =\n"
+    "        corner3(grad3[perm[ii + 1 + perm[jj + 1 + perm[kk + 1]]] % 12], x3, y3, z3);\n"
+    "    return 32.0 * (n0 + n1 + n2 + n3);\n"
+    "}\n",
+
+    "double noise(__constant uchar* perm, int dims, double x, double y, double z) {\n"
+    "    return dims == 2 ? noise2(perm, x, y) : noise3(perm, x, y, z);\n"
+    "}\n"
+    "\n"
+    "__kernel void grid(__constant uchar* perm, __global double* output, int dims, int kind,\n"
+    "                   double x_start, double y_start, double z_start, double step,\n"
+    "                   int width, int height, int row0, int octaves, double persistence,\n"
+    "                   double lacunarity, double offset) {\n"
+    "    int index = (int)get_global_id(0);\n"
+    "    int r = row0 + (index / width);\n"
+    "    double x = x_start + ((index % width) * step);\n"
+    "    double y = y_start + ((r % height) * step);\n"
+    "    double z = z_start + ((r / height) * step);\n"
+    "    if (kind == GPU_NOISE) {\n"
+    "        output[index] = noise(perm, dims, x, y, z);\n"
+    "        return;\n"
+    "    }\n"
+    "    if (kind == GPU_RIDGED || kind == GPU_BILLOWY) {\n"
+    "        double n = fabs(noise(perm, dims, x, y, z));\n"
+    "        output[index] = kind == GPU_RIDGED ? 1.0 - n : n;\n"
+    "        return;\n"
+    "    }\n"
+    "    double total = kind == GPU_FBM ? 0.0 : 1.0;\n"
+    "    double amplitude = 1.0;\n"
+    "    double frequency = 1.0;\n"
+    "    double max_value = 0.0;\n"
+    "    for (int octave = 0; octave < octaves; octave++) {\n"
+    "        double n = noise(perm, dims, x * frequency, y * frequency, z * frequency);\n"
+    "        if (kind == GPU_FBM) {\n"
+    "            total += n * amplitude;\n"
+    "        } else {\n"
+    "            total *= (offset + fabs(n)) * amplitude;\n"
+    "        }\n"
+    "        max_value += amplitude;\n"
+    "        amplitude *= persistence;\n"
+    "        frequency *= lacunarity;\n"
+    "    }\n"
+    "    output[index] = kind == GPU_FBM ? total / max_value : total;\n"
+    "}\n"};
+
+// Argument slots of the grid kernel
+enum {
+    ARG_PERM = 0,
+    ARG_OUTPUT,
+    ARG_DIMS,
+    ARG_KIND,
+    ARG_X_START,
+    ARG_Y_START,
+    ARG_Z_START,
+    ARG_STEP,
+    ARG_WIDTH,
+    ARG_HEIGHT,
+    ARG_ROW0,
+    ARG_OCTAVES,
+    ARG_PERSISTENCE,
+    ARG_LACUNARITY,
+    ARG_OFFSET
+};
+
+struct simplex_gpu {
+    cl_context context;
+    cl_command_queue compute;  /* Kernels */
+    cl_command_queue transfer; /* Read-backs, overlapping the next slab's kernel */
+    cl_program program;
+    cl_kernel kernel;
+    cl_mem perm;
+    cl_mem slabs[2];
+    size_t slab_bytes; /* Size of each slab buffer, 0 until the first job */
+    cl_ulong max_alloc;
+    simplex_lock_t* lock; /* Kernel arguments and slab buffers belong to one job at a time */
+    char name[GPU_NAME_SIZE];
+};
+
+// First available device of a type with double precision, over every platform
+static int find_device(cl_device_type type, cl_device_id* found) {
+    cl_platform_id platforms[GPU_MAX_PLATFORMS];
+    cl_uint platform_count = 0;
+    if (clGetPlatformIDs(GPU_MAX_PLATFORMS, platforms, &platform_count) != CL_SUCCESS) {
+        return 0;
+    }
+    platform_count = platform_count < GPU_MAX_PLATFORMS ? platform_count : GPU_MAX_PLATFORMS;
+    for (cl_uint p = 0; p < platform_count; p++) {
+        cl_device_id devices[GPU_MAX_DEVICES];
+        cl_uint count = 0;
+        if (clGetDeviceIDs(platforms[p], type, GPU_MAX_DEVICES, devices, &count) != CL_SUCCESS) {
+            continue;
+        }
+        count = count < GPU_MAX_DEVICES ? count : GPU_MAX_DEVICES;
+        for (cl_uint d = 0; d < count; d++) {
+            cl_device_fp_config doubles = 0;
+            cl_bool available = CL_FALSE;
+            if (clGetDeviceInfo(devices[d], CL_DEVICE_DOUBLE_FP_CONFIG, sizeof(doubles), &doubles,
+                                NULL) == CL_SUCCESS &&
+                clGetDeviceInfo(devices[d], CL_DEVICE_AVAILABLE, sizeof(available), &available,
+                                NULL) == CL_SUCCESS &&
+                doubles != 0 && available) {
+                *found = devices[d];
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+simplex_gpu_t* simplex_gpu_create(void) {
+    cl_device_id device = NULL;
+    if (!find_device(CL_DEVICE_TYPE_GPU, &device) && !find_device(CL_DEVICE_TYPE_ALL, &device)) {
+        return NULL;
+    }
+    simplex_gpu_t* gpu = calloc(1, sizeof(*gpu));
+    if (!gpu) {
+        return NULL;
+    }
+    gpu->lock = simplex_lock_create();
+
+    cl_int err = gpu->lock ? CL_SUCCESS : CL_OUT_OF_HOST_MEMORY;
+    if (err == CL_SUCCESS) {
+        gpu->context = clCreateContext(NULL, 1, &device, NULL, NULL, &err);
+    }
+    if (err == CL_SUCCESS) {
+        gpu->compute = clCreateCommandQueue(gpu->context, device, 0, &err);
+    }
+    if (err == CL_SUCCESS) {
+        gpu->transfer = clCreateCommandQueue(gpu->context, device, 0, &err);
+    }
+    if (err == CL_SUCCESS) {
+        gpu->program = clCreateProgramWithSource(
+            gpu->context, (cl_uint)(sizeof(kernel_source) / sizeof(kernel_source[0])),
+            kernel_source, NULL, &err);
+    }
+    if (err == CL_SUCCESS) {
+        char options[GPU_OPTIONS_SIZE];
+        snprintf(options, sizeof(options),
+                 "-DGPU_NOISE=%d -DGPU_FBM=%d -DGPU_RIDGED=%d -DGPU_BILLOWY=%d",
+                 SIMPLEX_GPU_NOISE, SIMPLEX_GPU_FBM, SIMPLEX_GPU_RIDGED, SIMPLEX_GPU_BILLOWY);
+        err = clBuildProgram(gpu->program, 1, &device, options, NULL, NULL);
+    }
+    if (err == CL_SUCCESS) {
+        gpu->kernel = clCreateKernel(gpu->program, "grid", &err);
+    }
+    if (err == CL_SUCCESS) {
+        gpu->perm = clCreateBuffer(gpu->context, CL_MEM_READ_ONLY,
+                                   SIMPLEX_PERM_DOUBLE_SIZE, NULL, &err);
+    }
+    if (err == CL_SUCCESS) {
+        err = clGetDeviceInfo(device, CL_DEVICE_MAX_MEM_ALLOC_SIZE, sizeof(gpu->max_alloc),
+                              &gpu->max_alloc, NULL);
+    }
+    if (err == CL_SUCCESS) {
+        err = clSetKernelArg(gpu->kernel, ARG_PERM, sizeof(cl_mem), &gpu->perm);
+    }
+    if (err != CL_SUCCESS) {
+        simplex_gpu_destroy(gpu);
+        return NULL;
+    }
+    clGetDeviceInfo(device, CL_DEVICE_NAME, sizeof(gpu->name) - 1, gpu->name, NULL);
+    return gpu;
+}
+
+void simplex_gpu_destroy(simplex_gpu_t* gpu) {
+    if (!gpu) {
+        return;
+    }
+    for (int i = 0; i < 2; i++) {
+        if (gpu->slabs[i]) {
+            clReleaseMemObject(gpu->slabs[i]);
+        }
+    }
+    if (gpu->perm) {
+        clReleaseMemObject(gpu->perm);
+    }
+    if (gpu->kernel) {
+        clReleaseKernel(gpu->kernel);
+    }
+    if (gpu->program) {
+        clReleaseProgram(gpu->program);
+    }
+    if (gpu->transfer) {
+        clReleaseCommandQueue(gpu->transfer);
+    }
+    if (gpu->compute) {
+        clReleaseCommandQueue(gpu->compute);
+    }
+    if (gpu->context) {
+        clReleaseContext(gpu->context);
+    }
+    simplex_lock_destroy(gpu->lock);
+    free(gpu);
+}
+
+const char* simplex_gpu_name(const simplex_gpu_t* gpu) {
+    return gpu ? gpu->name : NULL;
+}
+
+int simplex_gpu_set_perm(simplex_gpu_t* gpu, const uint8_t* perm) {
+    simplex_lock_acquire(gpu->lock);
+    cl_int err = clEnqueueWriteBuffer(gpu->compute, gpu->perm, CL_TRUE, 0,
+                                      SIMPLEX_PERM_DOUBLE_SIZE, perm, 0, NULL, NULL);
+    simplex_lock_release(gpu->lock);
+    return err == CL_SUCCESS ? 0 : -1;
+}
+
+// Grow both slab buffers to at least `bytes`; called with the lock held
+static cl_int reserve_slabs(simplex_gpu_t* gpu, size_t bytes) {
+    if (gpu->slab_bytes >= bytes) {
+        return CL_SUCCESS;
+    }
+    cl_int err = CL_SUCCESS;
+    for (int i = 0; i < 2; i++) {
+        if (gpu->slabs[i]) {
+            clReleaseMemObject(gpu->slabs[i]);
+        }
+        gpu->slabs[i] = err == CL_SUCCESS
+                            ? clCreateBuffer(gpu->context, CL_MEM_WRITE_ONLY, bytes, NULL, &err)
+                            : NULL;
+    }
+    gpu->slab_bytes = err == CL_SUCCESS ? bytes : 0;
+    return err;
+}
+
+// Set the arguments every slab of a job shares
+static cl_int set_grid_args(cl_kernel kernel, const simplex_gpu_grid_t* grid) {
+    cl_int dims = grid->dims;
+    cl_int kind = (cl_int)grid->kind;
+    cl_int width = grid->width;
+    cl_int height = grid->height;
+    cl_int octaves = grid->octaves;
+    cl_int err = clSetKernelArg(kernel, ARG_DIMS, sizeof(cl_int), &dims);
+    if (err == CL_SUCCESS) {
+        err = clSetKernelArg(kernel, ARG_KIND, sizeof(cl_int), &kind);
+    }
+    if (err == CL_SUCCESS) {
+        err = clSetKernelArg(kernel, ARG_X_START, sizeof(cl_double), &grid->x_start);
+    }
+    if (err == CL_SUCCESS) {
+        err = clSetKernelArg(kernel, ARG_Y_START, sizeof(cl_double), &grid->y_start);
+    }
+    if (err == CL_SUCCESS) {
+        err = clSetKernelArg(kernel, ARG_Z_START, sizeof(cl_double), &grid->z_start);
+    }
+    if (err == CL_SUCCESS) {
+        err = clSetKernelArg(kernel, ARG_STEP, sizeof(cl_double), &grid->step);
+    }
+    if (err == CL_SUCCESS) {
+        err = clSetKernelArg(kernel, ARG_WIDTH, sizeof(cl_int), &width);
+    }
+    if (err == CL_SUCCESS) {
+        err = clSetKernelArg(kernel, ARG_HEIGHT, sizeof(cl_int), &height);
+    }
+    if (err == CL_SUCCESS) {
+        err = clSetKernelArg(kernel, ARG_OCTAVES, sizeof(cl_int), &octaves);
+    }
+    if (err == CL_SUCCESS) {
+        err = clSetKernelArg(kernel, ARG_PERSISTENCE, sizeof(cl_double), &grid->persistence);
+    }
+    if (err == CL_SUCCESS) {
+        err = clSetKernelArg(kernel, ARG_LACUNARITY, sizeof(cl_double), &grid->lacunarity);
+    }
+    if (err == CL_SUCCESS) {
+        err = clSetKernelArg(kernel, ARG_OFFSET, sizeof(cl_double), &grid->offset);
+    }
+    return err;
+}
+
+int simplex_gpu_generate(simplex_gpu_t* gpu, const simplex_gpu_grid_t* grid, double* output) {
+    // Two slabs are in flight at once, each within one allocation and INT_MAX work items
+    int rows = grid->height * grid->depth;
+    size_t row_bytes = (size_t)grid->width * sizeof(cl_double);
+    double budget = grid->memory_limit_mb * 1024.0 * 1024.0 / 2.0;
+    if (budget > (double)gpu->max_alloc) {
+        budget = (double)gpu->max_alloc;
+    }
+    double fit = budget / (double)row_bytes;
+    int slab_rows = fit < 1.0 ? 1 : (fit < rows ? (int)fit : rows);
+    if (slab_rows > INT_MAX / grid->width) {
+        slab_rows = INT_MAX / grid->width;
+    }
+
+    simplex_lock_acquire(gpu->lock);
+    cl_event read_done[2] = {NULL, NULL};
+    cl_int err = reserve_slabs(gpu, (size_t)slab_rows * row_bytes);
+    if (err == CL_SUCCESS) {
+        err = set_grid_args(gpu->kernel, grid);
+    }
+    for (int row0 = 0, slab = 0; err == CL_SUCCESS && row0 < rows;
+         row0 += slab_rows, slab ^= 1) {
+        int count = rows - row0 < slab_rows ? rows - row0 : slab_rows;
+        size_t samples = (size_t)count * grid->width;
+        cl_int first_row = row0;
+        cl_event ran = NULL;
+        err = clSetKernelArg(gpu->kernel, ARG_OUTPUT, sizeof(cl_mem), &gpu->slabs[slab]);
+        if (err == CL_SUCCESS) {
+            err = clSetKernelArg(gpu->kernel, ARG_ROW0, sizeof(cl_int), &first_row);
+        }
+        // A slab buffer is reused once the read-back of its previous contents is done
+        if (err == CL_SUCCESS) {
+            err = clEnqueueNDRangeKernel(gpu->compute, gpu->kernel, 1, NULL, &samples, NULL,
+                                         read_done[slab] ? 1 : 0,
+                                         read_done[slab] ? &read_done[slab] : NULL, &ran);
+        }
+        if (read_done[slab]) {
+            clReleaseEvent(read_done[slab]);
+            read_done[slab] = NULL;
+        }
+        if (err == CL_SUCCESS) {
+            clFlush(gpu->compute);
+            err = clEnqueueReadBuffer(gpu->transfer, gpu->slabs[slab], CL_FALSE, 0,
+                                      samples * sizeof(cl_double),
+                                      output + ((size_t)row0 * grid->width), 1, &ran,
+                                      &read_done[slab]);
+        }
+        if (ran) {
+            clReleaseEvent(ran);
+        }
+        if (err == CL_SUCCESS) {
+            clFlush(gpu->transfer);
+        }
+    }
+
+    // Nothing may still write into output once the call returns, even after an error
+    if (clFinish(gpu->compute) != CL_SUCCESS || clFinish(gpu->transfer) != CL_SUCCESS) {
+        err = err == CL_SUCCESS ? CL_INVALID_COMMAND_QUEUE : err;
+    }
+    for (int i = 0; i < 2; i++) {
+        if (read_done[i]) {
+            clReleaseEvent(read_done[i]);
+        }
+    }
+    simplex_lock_release(gpu->lock);
+    return err == CL_SUCCESS ? 0 : -1;
+}
+
+#else
+
+simplex_gpu_t* simplex_gpu_create(void) {
+    return NULL;
+}
+
+void simplex_gpu_destroy(simplex_gpu_t* gpu) {
+    (void)gpu;
+}
+
+const char* simplex_gpu_name(const simplex_gpu_t* gpu) {
+    (void)gpu;
+    return NULL;
+}
+
+int simplex_gpu_set_perm(simplex_gpu_t* gpu, const uint8_t* perm) {
+    (void)gpu;
+    (void)perm;
+    return -1;
+}
+
+int simplex_gpu_generate(simplex_gpu_t* gpu, const simplex_gpu_grid_t* grid, double* output) {
+    (void)gpu;
+    (void)grid;
+    (void)output;
+    return -1;
+}
+
+#endif
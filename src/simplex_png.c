@@ -0,0 +1,438 @@
+/**
+ * @file simplex_png.c
+ * @brief Streaming, row-parallel PNG encoder for the image generators
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @details Rows arrive in batches (the image bands). Each batch is cut into
+ *          groups of rows that are filtered and deflated independently on the
+ *          thread pool: every group is a raw deflate run ending in a sync
+ *          flush, so the runs concatenate into one zlib stream and each is
+ *          written as its own IDAT chunk. An empty final block and the Adler-32
+ *          of the filtered bytes close the stream. Without zlib
+ *          (SIMPLEX_HAVE_ZLIB) the groups are written as stored blocks, which
+ *          is still a valid, uncompressed PNG.
+ *
+ * @author Adrian Paredez
+ * @version 2.0.0
+ * @date 9/5/2025
+ */
+
+#include "simplex_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(SIMPLEX_HAVE_ZLIB)
+#include <zlib.h>
+#endif
+
+/* Filtered bytes per compression group; smaller groups lose more dictionary */
+enum { PNG_GROUP_BYTES = 256 * 1024, PNG_CHUNK_OVERHEAD = 12, PNG_STORED_BLOCK = 65535 };
+
+enum { PNG_COLOR_GRAY = 0, PNG_COLOR_RGB = 2 };
+
+/* Empty final fixed-Huffman block, then the stream's Adler-32 */
+static const uint8_t png_final_block[2] = {0x03, 0x00};
+static const uint8_t png_zlib_header[2] = {0x78, 0x01};
+static const uint8_t png_signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+struct simplex_png_encoder {
+    simplex_png_params_t params;
+    size_t row_bytes;
+    int bpp; /* Bytes per pixel, the filters' left distance */
+    uint8_t* prev_row; /* Last row of the previous batch */
+    int rows_written;
+    uint32_t adler;
+    int failed;
+};
+
+// One group of rows filtered and compressed by one pool task
+typedef struct {
+    const uint8_t* rows;
+    const uint8_t* prev_row; /* Row above the group, NULL for the image's first row */
+    int count;
+    uint8_t* filtered;
+    size_t filtered_size;
+    uint8_t* compressed;
+    size_t compressed_size;
+    int failed;
+} png_group_t;
+
+typedef struct {
+    const simplex_png_encoder_t* png;
+    png_group_t* groups;
+} png_batch_t;
+
+/* ===== CHECKSUMS ===== */
+
+#if defined(SIMPLEX_HAVE_ZLIB)
+
+static uint32_t png_crc(uint32_t crc, const uint8_t* data, size_t size) {
+    while (size > 0) {
+        uInt step = size > 0x40000000 ? 0x40000000 : (uInt)size;
+        crc = (uint32_t)crc32(crc, data, step);
+        data += step;
+        size -= step;
+    }
+    return crc;
+}
+
+static uint32_t png_adler(uint32_t adler, const uint8_t* data, size_t size) {
+    while (size > 0) {
+        uInt step = size > 0x40000000 ? 0x40000000 : (uInt)size;
+        adler = (uint32_t)adler32(adler, data, step);
+        data += step;
+        size -= step;
+    }
+    return adler;
+}
+
+#else
+
+static uint32_t png_crc(uint32_t crc, const uint8_t* data, size_t size) {
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1U)));
+        }
+    }
+    return ~crc;
+}
+
+static uint32_t png_adler(uint32_t adler, const uint8_t* data, size_t size) {
+    uint32_t a = adler & 0xFFFFU;
+    uint32_t b = adler >> 16;
+    while (size > 0) {
+        // 5552 bytes is the longest run whose sums cannot overflow 32 bits
+        size_t run = size < 5552 ? size : 5552;
+        for (size_t i = 0; i < run; i++) {
+            a += data[i];
+            b += a;
+        }
+        a %= 65521U;
+        b %= 65521U;
+        data += run;
+        size -= run;
+    }
+    return (b << 16) | a;
+}
+
+#endif
+
+/* ===== CHUNKS ===== */
+
+static void put_u32(uint8_t* out, uint32_t value) {
+    out[0] = (uint8_t)(value >> 24);
+    out[1] = (uint8_t)(value >> 16);
+    out[2] = (uint8_t)(value >> 8);
+    out[3] = (uint8_t)value;
+}
+
+// Write one chunk: length, type, data and the CRC of type and data
+static int write_chunk(simplex_png_encoder_t* png, const char* type, const uint8_t* data,
+                       size_t size) {
+    uint8_t head[8];
+    uint8_t tail[4];
+    put_u32(head, (uint32_t)size);
+    memcpy(head + 4, type, 4);
+    put_u32(tail, png_crc(png_crc(0, head + 4, 4), data, size));
+    const simplex_png_params_t* p = &png->params;
+    if (p->write(p->user_data, head, sizeof(head)) != 0 ||
+        (size > 0 && p->write(p->user_data, data, size) != 0) ||
+        p->write(p->user_data, tail, sizeof(tail)) != 0) {
+        png->failed = 1;
+        return -1;
+    }
+    return 0;
+}
+
+/* ===== FILTERING ===== */
+
+static uint8_t paeth(uint8_t a, uint8_t b, uint8_t c) {
+    int p = a + b - c;
+    int pa = abs(p - a);
+    int pb = abs(p - b);
+    int pc = abs(p - c);
+    return pa <= pb && pa <= pc ? a : (pb <= pc ? b : c);
+}
+
+// Filter one row with the given PNG filter type into out[0..n]; prev is NULL on row 0
+static void filter_row(int type, const uint8_t* row, const uint8_t* prev, size_t n, int bpp,
+                       uint8_t* out) {
+    uint8_t* dst = out + 1;
+    out[0] = (uint8_t)type;
+    if (!prev) {
+        // Above the first row is all zero: Up is None, Paeth is Sub, Average halves Sub
+        for (size_t i = 0; i < n; i++) {
+            uint8_t left = i >= (size_t)bpp ? row[i - bpp] : 0;
+            uint8_t predictor = type == SIMPLEX_PNG_FILTER_SUB || type == SIMPLEX_PNG_FILTER_PAETH
+                                    ? left
+                                    : (type == SIMPLEX_PNG_FILTER_AVERAGE ? left >> 1 : 0);
+            dst[i] = (uint8_t)(row[i] - predictor);
+        }
+        return;
+    }
+    size_t lead = (size_t)bpp < n ? (size_t)bpp : n;
+    switch (type) {
+        case SIMPLEX_PNG_FILTER_SUB:
+            memcpy(dst, row, lead);
+            for (size_t i = lead; i < n; i++) {
+                dst[i] = (uint8_t)(row[i] - row[i - bpp]);
+            }
+            break;
+        case SIMPLEX_PNG_FILTER_UP:
+            for (size_t i = 0; i < n; i++) {
+                dst[i] = (uint8_t)(row[i] - prev[i]);
+            }
+            break;
+        case SIMPLEX_PNG_FILTER_AVERAGE:
+            for (size_t i = 0; i < lead; i++) {
+                dst[i] = (uint8_t)(row[i] - (prev[i] >> 1));
+            }
+            for (size_t i = lead; i < n; i++) {
+                dst[i] = (uint8_t)(row[i] - ((row[i - bpp] + prev[i]) >> 1));
+            }
+            break;
+        case SIMPLEX_PNG_FILTER_PAETH:
+            // With no left neighbour Paeth predicts the byte above
+            for (size_t i = 0; i < lead; i++) {
+                dst[i] = (uint8_t)(row[i] - prev[i]);
+            }
+            for (size_t i = lead; i < n; i++) {
+                dst[i] = (uint8_t)(row[i] - paeth(row[i - bpp], prev[i], prev[i - bpp]));
+            }
+            break;
+        default:
+            memcpy(dst, row, n);
+            break;
+    }
+}
+
+// Sum of the filtered bytes read as signed, the usual adaptive-filter cost
+static size_t filter_cost(const uint8_t* filtered, size_t n) {
+    size_t cost = 0;
+    for (size_t i = 1; i <= n; i++) {
+        cost += filtered[i] < 128 ? filtered[i] : 256 - filtered[i];
+    }
+    return cost;
+}
+
+// Filter a group's rows, trying every filter per row when adaptive
+static int filter_group(const simplex_png_encoder_t* png, png_group_t* group) {
+    size_t n = png->row_bytes;
+    uint8_t* trial = NULL;
+    int adaptive = png->params.filter == SIMPLEX_PNG_FILTER_ADAPTIVE;
+    if (adaptive && !(trial = malloc(n + 1))) {
+        return -1;
+    }
+    for (int r = 0; r < group->count; r++) {
+        const uint8_t* row = group->rows + ((size_t)r * n);
+        const uint8_t* prev = r > 0 ? row - n : group->prev_row;
+        uint8_t* out = group->filtered + ((size_t)r * (n + 1));
+        if (!adaptive) {
+            filter_row(png->params.filter, row, prev, n, png->bpp, out);
+            continue;
+        }
+        size_t best = (size_t)-1;
+        for (int type = SIMPLEX_PNG_FILTER_NONE; type <= SIMPLEX_PNG_FILTER_PAETH; type++) {
+            filter_row(type, row, prev, n, png->bpp, trial);
+            size_t cost = filter_cost(trial, n);
+            if (cost < best) {
+                best = cost;
+                memcpy(out, trial, n + 1);
+            }
+        }
+    }
+    free(trial);
+    return 0;
+}
+
+/* ===== COMPRESSION ===== */
+
+#if defined(SIMPLEX_HAVE_ZLIB)
+
+// Raw deflate of the filtered group, ending on a byte boundary with a sync flush
+static int compress_group(const simplex_png_encoder_t* png, png_group_t* group) {
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    int level = png->params.level;
+    if (deflateInit2(&stream, level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return -1;
+    }
+    size_t capacity = deflateBound(&stream, (uLong)group->filtered_size) + 16;
+    group->compressed = malloc(capacity);
+    int status = group->compressed ? Z_OK : Z_MEM_ERROR;
+    stream.next_in = group->filtered;
+    stream.avail_in = (uInt)group->filtered_size;
+    while (status == Z_OK) {
+        stream.next_out = group->compressed + stream.total_out;
+        stream.avail_out = (uInt)(capacity - stream.total_out);
+        status = deflate(&stream, Z_SYNC_FLUSH);
+        if (status == Z_OK && stream.avail_out > 0) {
+            break;
+        }
+        // Output full: grow and flush again
+        uint8_t* grown = status == Z_OK ? realloc(group->compressed, capacity * 2) : NULL;
+        if (!grown) {
+            status = Z_MEM_ERROR;
+            break;
+        }
+        group->compressed = grown;
+        capacity *= 2;
+    }
+    group->compressed_size = stream.total_out;
+    deflateEnd(&stream);
+    return status == Z_OK ? 0 : -1;
+}
+
+#else
+
+// Stored (uncompressed) non-final deflate blocks of the filtered group
+static int compress_group(const simplex_png_encoder_t* png, png_group_t* group) {
+    (void)png;
+    size_t blocks = (group->filtered_size + PNG_STORED_BLOCK - 1) / PNG_STORED_BLOCK;
+    group->compressed = malloc(group->filtered_size + (5 * blocks));
+    if (!group->compressed) {
+        return -1;
+    }
+    uint8_t* out = group->compressed;
+    for (size_t offset = 0; offset < group->filtered_size; offset += PNG_STORED_BLOCK) {
+        size_t left = group->filtered_size - offset;
+        uint16_t size = (uint16_t)(left < PNG_STORED_BLOCK ? left : PNG_STORED_BLOCK);
+        out[0] = 0x00;
+        out[1] = (uint8_t)size;
+        out[2] = (uint8_t)(size >> 8);
+        uint16_t inverse = (uint16_t)~size;
+        out[3] = (uint8_t)inverse;
+        out[4] = (uint8_t)(inverse >> 8);
+        memcpy(out + 5, group->filtered + offset, size);
+        out += 5 + size;
+    }
+    group->compressed_size = (size_t)(out - group->compressed);
+    return 0;
+}
+
+#endif
+
+static void encode_groups(void* arg, int begin, int end) {
+    png_batch_t* batch = arg;
+    for (int g = begin; g < end; g++) {
+        png_group_t* group = &batch->groups[g];
+        group->failed =
+            filter_group(batch->png, group) != 0 || compress_group(batch->png, group) != 0;
+    }
+}
+
+/* ===== ENCODER ===== */
+
+size_t simplex_png_bound(int width, int height, int bytes_per_pixel) {
+    size_t filtered = (size_t)height * (((size_t)width * bytes_per_pixel) + 1);
+    // Signature, IHDR, header and trailer IDATs and IEND, plus per-group chunks and flushes
+    return 8 + 25 + (PNG_CHUNK_OVERHEAD + 2) + (PNG_CHUNK_OVERHEAD + 6) + PNG_CHUNK_OVERHEAD +
+           filtered + (5 * (filtered / PNG_STORED_BLOCK + 1)) + (filtered >> 10) +
+           ((size_t)height * (PNG_CHUNK_OVERHEAD + 16));
+}
+
+simplex_png_encoder_t* simplex_png_begin(const simplex_png_params_t* params) {
+    if (!params || !params->write || params->width <= 0 || params->height <= 0 ||
+        (params->channels != 1 && params->channels != 3) ||
+        (params->bit_depth != 8 && params->bit_depth != 16) ||
+        (params->bit_depth == 16 && params->channels != 1) ||
+        (unsigned int)params->filter >= SIMPLEX_PNG_FILTER_COUNT) {
+        return NULL;
+    }
+    simplex_png_encoder_t* png = calloc(1, sizeof(*png));
+    if (!png) {
+        return NULL;
+    }
+    png->params = *params;
+    png->params.level = params->level < 0 ? 0 : (params->level > 9 ? 9 : params->level);
+    png->bpp = params->channels * (params->bit_depth / 8);
+    png->row_bytes = (size_t)params->width * png->bpp;
+    png->prev_row = malloc(png->row_bytes);
+    png->adler = 1;
+
+    uint8_t ihdr[13];
+    put_u32(ihdr, (uint32_t)params->width);
+    put_u32(ihdr + 4, (uint32_t)params->height);
+    ihdr[8] = (uint8_t)params->bit_depth;
+    ihdr[9] = params->channels == 1 ? PNG_COLOR_GRAY : PNG_COLOR_RGB;
+    ihdr[10] = 0; /* Deflate */
+    ihdr[11] = 0; /* Adaptive filtering */
+    ihdr[12] = 0; /* No interlace */
+    if (!png->prev_row || params->write(params->user_data, png_signature, 8) != 0 ||
+        write_chunk(png, "IHDR", ihdr, sizeof(ihdr)) != 0 ||
+        write_chunk(png, "IDAT", png_zlib_header, sizeof(png_zlib_header)) != 0) {
+        free(png->prev_row);
+        free(png);
+        return NULL;
+    }
+    return png;
+}
+
+int simplex_png_write_rows(simplex_png_encoder_t* png, const uint8_t* rows, int count) {
+    if (!png || png->failed || !rows || count <= 0 ||
+        count > png->params.height - png->rows_written) {
+        return -1;
+    }
+    size_t n = png->row_bytes;
+    int group_rows = (int)(PNG_GROUP_BYTES / (n + 1));
+    group_rows = group_rows < 1 ? 1 : group_rows;
+    int group_count = (count + group_rows - 1) / group_rows;
+    png_group_t* groups = calloc((size_t)group_count, sizeof(*groups));
+    uint8_t* filtered = malloc((size_t)count * (n + 1));
+    if (!groups || !filtered) {
+        free(groups);
+        free(filtered);
+        png->failed = 1;
+        return -1;
+    }
+    for (int g = 0; g < group_count; g++) {
+        png_group_t* group = &groups[g];
+        int first = g * group_rows;
+        group->rows = rows + ((size_t)first * n);
+        group->count = count - first < group_rows ? count - first : group_rows;
+        group->prev_row = first > 0 ? group->rows - n : (png->rows_written ? png->prev_row : NULL);
+        group->filtered = filtered + ((size_t)first * (n + 1));
+        group->filtered_size = (size_t)group->count * (n + 1);
+    }
+
+    png_batch_t batch = {.png = png, .groups = groups};
+    simplex_parallel_for(group_count, 1, png->params.max_threads, encode_groups, &batch);
+
+    for (int g = 0; g < group_count; g++) {
+        png_group_t* group = &groups[g];
+        if (!png->failed && (group->failed || write_chunk(png, "IDAT", group->compressed,
+                                                          group->compressed_size) != 0)) {
+            png->failed = 1;
+        }
+        free(group->compressed);
+    }
+    png->adler = png_adler(png->adler, filtered, (size_t)count * (n + 1));
+    memcpy(png->prev_row, rows + ((size_t)(count - 1) * n), n);
+    png->rows_written += count;
+    free(groups);
+    free(filtered);
+    return png->failed ? -1 : 0;
+}
+
+int simplex_png_end(simplex_png_encoder_t* png) {
+    if (!png) {
+        return -1;
+    }
+    int result = png->failed || png->rows_written != png->params.height ? -1 : 0;
+    if (result == 0) {
+        uint8_t trailer[6];
+        memcpy(trailer, png_final_block, sizeof(png_final_block));
+        put_u32(trailer + 2, png->adler);
+        result = write_chunk(png, "IDAT", trailer, sizeof(trailer)) == 0 &&
+                         write_chunk(png, "IEND", NULL, 0) == 0
+                     ? 0
+                     : -1;
+    }
+    free(png->prev_row);
+    free(png);
+    return result;
+}
@@ -0,0 +1,295 @@
+/**
+ * @file simplex_profile.c
+ * @brief Per-API call, sample, time and latency-histogram counters
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @details Built only with SIMPLEX_ENABLE_PROFILING; otherwise every function
+ *          here is a stub and the hooks in the noise functions compile to
+ *          nothing. Every thread records into a counter block of its own,
+ *          registered with the profiler on the thread's first call and found
+ *          again through a thread-local cache, so recording takes no lock and
+ *          shares no cache line. Only the owning thread writes a block; reads
+ *          merge every block and reset moves a per-block baseline, both under
+ *          the profiler's lock. The outermost public call on a thread is
+ *          timed; calls it makes itself, and anything run on pool workers,
+ *          are part of that call.
+ *
+ * @author Adrian Paredez
+ * @version 2.0.0
+ * @date 9/5/2025
+ */
+
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "simplex_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const char* const profile_api_names[SIMPLEX_PROFILE_API_COUNT] = {
+    "noise_1d",    "noise_2d",    "noise_3d",      "noise_4d", "noise_float",
+    "ridged",      "billowy",     "fbm",           "hybrid_multifractal",
+    "domain_warp", "noise_array", "fractal_array", "points",   "tile_acquire",
+    "image",       "volume"};
+
+const char* simplex_get_profile_api_name(simplex_profile_api_t api) {
+    if ((int)api < 0 || api >= SIMPLEX_PROFILE_API_COUNT) {
+        return "unknown";
+    }
+    return profile_api_names[api];
+}
+
+#if defined(SIMPLEX_ENABLE_PROFILING)
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+/* Counters are written by one thread and read by others: relaxed loads and
+ * stores keep that race-free without a locked read-modify-write */
+#if defined(_MSC_VER)
+#define PROFILE_LOAD(counter) (*(volatile uint64_t*)&(counter))
+#define PROFILE_STORE(counter, value) (*(volatile uint64_t*)&(counter) = (value))
+#define PROFILE_NEXT_SERIAL(serial) ((uint64_t)InterlockedIncrement64((volatile LONG64*)&(serial)))
+#else
+#define PROFILE_LOAD(counter) __atomic_load_n(&(counter), __ATOMIC_RELAXED)
+#define PROFILE_STORE(counter, value) __atomic_store_n(&(counter), (value), __ATOMIC_RELAXED)
+#define PROFILE_NEXT_SERIAL(serial) __atomic_add_fetch(&(serial), 1, __ATOMIC_RELAXED)
+#endif
+
+enum { PROFILE_CACHE_SLOTS = 8 };
+
+typedef struct {
+    uint64_t calls;
+    uint64_t samples;
+    uint64_t total_ns;
+    uint64_t histogram[SIMPLEX_PROFILE_HISTOGRAM_BUCKETS];
+} profile_counter_t;
+
+// One thread's counters
+typedef struct profile_block {
+    const void* owner;                                     /* Owning thread's profile_active */
+    profile_counter_t counters[SIMPLEX_PROFILE_API_COUNT]; /* Written by the owner only */
+    profile_counter_t baseline[SIMPLEX_PROFILE_API_COUNT]; /* Counts at the last reset */
+    struct profile_block* next;
+} profile_block_t;
+
+struct simplex_profiler {
+    simplex_lock_t* lock; /* Guards the block list and the baselines */
+    uint64_t serial;      /* Tells a profiler apart from an earlier one at its address */
+    profile_block_t* blocks;
+};
+
+// A thread's block for one profiler
+typedef struct {
+    const simplex_profiler_t* profiler;
+    uint64_t serial;
+    profile_block_t* block;
+} profile_cache_slot_t;
+
+/* Non-zero while the thread is inside a profiled call, or for pool workers */
+static SIMPLEX_THREAD_LOCAL int profile_active;
+static SIMPLEX_THREAD_LOCAL profile_cache_slot_t profile_cache[PROFILE_CACHE_SLOTS];
+static uint64_t profiler_serial;
+
+/* ===== CLOCK ===== */
+
+static uint64_t now_ns(void) {
+#if defined(_WIN32)
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((double)counter.QuadPart * (1e9 / (double)frequency.QuadPart));
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+// Bucket i holds durations in [2^i, 2^(i+1)) ns
+static int histogram_bucket(uint64_t ns) {
+    int bucket = 0;
+    while (ns > 1 && bucket < SIMPLEX_PROFILE_HISTOGRAM_BUCKETS - 1) {
+        ns >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+/* A thread is identified by the address of its profile_active. A thread
+ * started after another has exited may get the same address and then takes
+ * over its block, which no one writes any more. */
+static profile_block_t* register_block(simplex_profiler_t* profiler) {
+    simplex_lock_acquire(profiler->lock);
+    profile_block_t* block = profiler->blocks;
+    while (block && block->owner != &profile_active) {
+        block = block->next;
+    }
+    if (!block && (block = calloc(1, sizeof(*block))) != NULL) {
+        block->owner = &profile_active;
+        block->next = profiler->blocks;
+        profiler->blocks = block;
+    }
+    simplex_lock_release(profiler->lock);
+    return block;
+}
+
+// The calling thread's block, registered on its first call; NULL if out of memory
+static profile_block_t* thread_block(simplex_profiler_t* profiler) {
+    profile_cache_slot_t* slot = &profile_cache[profiler->serial % PROFILE_CACHE_SLOTS];
+    if (slot->profiler != profiler || slot->serial != profiler->serial) {
+        profile_block_t* block = register_block(profiler);
+        if (!block) {
+            return NULL;
+        }
+        slot->profiler = profiler;
+        slot->serial = profiler->serial;
+        slot->block = block;
+    }
+    return slot->block;
+}
+
+static void counter_add(uint64_t* counter, uint64_t amount) {
+    PROFILE_STORE(*counter, PROFILE_LOAD(*counter) + amount);
+}
+
+/* ===== RECORDING ===== */
+
+uint64_t simplex_profile_begin(void) {
+    if (profile_active) {
+        return 0;
+    }
+    profile_active = 1;
+    uint64_t start = now_ns();
+    return start ? start : 1;
+}
+
+void simplex_profile_end(simplex_profiler_t* profiler, simplex_profile_api_t api, uint64_t start,
+                         size_t samples) {
+    uint64_t now = now_ns();
+    uint64_t elapsed = now > start ? now - start : 0;
+    profile_active = 0;
+    if (!profiler) {
+        return;
+    }
+    profile_block_t* block = thread_block(profiler);
+    if (!block) {
+        return;
+    }
+    profile_counter_t* counter = &block->counters[api];
+    counter_add(&counter->calls, 1);
+    counter_add(&counter->samples, samples);
+    counter_add(&counter->total_ns, elapsed);
+    counter_add(&counter->histogram[histogram_bucket(elapsed)], 1);
+}
+
+void simplex_profile_mark_worker(void) {
+    profile_active = 1;
+}
+
+/* ===== LIFETIME AND READS ===== */
+
+simplex_profiler_t* simplex_profiler_create(void) {
+    simplex_profiler_t* profiler = calloc(1, sizeof(*profiler));
+    if (!profiler) {
+        return NULL;
+    }
+    profiler->lock = simplex_lock_create();
+    if (!profiler->lock) {
+        free(profiler);
+        return NULL;
+    }
+    profiler->serial = PROFILE_NEXT_SERIAL(profiler_serial);
+    return profiler;
+}
+
+void simplex_profiler_destroy(simplex_profiler_t* profiler) {
+    if (!profiler) {
+        return;
+    }
+    while (profiler->blocks) {
+        profile_block_t* next = profiler->blocks->next;
+        free(profiler->blocks);
+        profiler->blocks = next;
+    }
+    simplex_lock_destroy(profiler->lock);
+    free(profiler);
+}
+
+// Snapshot of a counter another thread may be writing
+static void counter_load(const profile_counter_t* counter, profile_counter_t* snapshot) {
+    snapshot->calls = PROFILE_LOAD(counter->calls);
+    snapshot->samples = PROFILE_LOAD(counter->samples);
+    snapshot->total_ns = PROFILE_LOAD(counter->total_ns);
+    for (int b = 0; b < SIMPLEX_PROFILE_HISTOGRAM_BUCKETS; b++) {
+        snapshot->histogram[b] = PROFILE_LOAD(counter->histogram[b]);
+    }
+}
+
+// Reset moves every block's baseline up to its counts; only owners write the counters
+void simplex_profiler_reset(simplex_profiler_t* profiler) {
+    if (!profiler) {
+        return;
+    }
+    simplex_lock_acquire(profiler->lock);
+    for (profile_block_t* block = profiler->blocks; block; block = block->next) {
+        for (int api = 0; api < SIMPLEX_PROFILE_API_COUNT; api++) {
+            counter_load(&block->counters[api], &block->baseline[api]);
+        }
+    }
+    simplex_lock_release(profiler->lock);
+}
+
+void simplex_profiler_read(const simplex_profiler_t* profiler, simplex_profile_api_t api,
+                           simplex_profile_entry_t* entry) {
+    memset(entry, 0, sizeof(*entry));
+    if (!profiler) {
+        return;
+    }
+    uint64_t total_ns = 0;
+    simplex_lock_acquire(profiler->lock);
+    for (const profile_block_t* block = profiler->blocks; block; block = block->next) {
+        profile_counter_t counter;
+        const profile_counter_t* baseline = &block->baseline[api];
+        counter_load(&block->counters[api], &counter);
+        entry->calls += (size_t)(counter.calls - baseline->calls);
+        entry->samples += (size_t)(counter.samples - baseline->samples);
+        total_ns += counter.total_ns - baseline->total_ns;
+        for (int b = 0; b < SIMPLEX_PROFILE_HISTOGRAM_BUCKETS; b++) {
+            entry->histogram[b] += (size_t)(counter.histogram[b] - baseline->histogram[b]);
+        }
+    }
+    simplex_lock_release(profiler->lock);
+    entry->total_time = (double)total_ns * 1e-9;
+    entry->average_time = entry->calls ? entry->total_time / (double)entry->calls : 0.0;
+}
+
+#else
+
+simplex_profiler_t* simplex_profiler_create(void) {
+    return NULL;
+}
+
+void simplex_profiler_destroy(simplex_profiler_t* profiler) {
+    (void)profiler;
+}
+
+void simplex_profiler_reset(simplex_profiler_t* profiler) {
+    (void)profiler;
+}
+
+void simplex_profiler_read(const simplex_profiler_t* profiler, simplex_profile_api_t api,
+                           simplex_profile_entry_t* entry) {
+    (void)profiler;
+    (void)api;
+    memset(entry, 0, sizeof(*entry));
+}
+
+#endif
@@ -0,0 +1,202 @@
+/**
+ * @file simplex_simd.c
+ * @brief Runtime selection of the vectorized noise kernels
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @details Always builds the one-lane scalar instantiation of the kernels;
+ *          simplex_simd_f32.c does the same for the float32 kernels. With
+ *          SIMPLEX_ENABLE_SIMD, CMake also compiles simplex_simd_sse41.c,
+ *          simplex_simd_avx2.c and simplex_simd_avx512.c (x86) or
+ *          simplex_simd_neon.c (AArch64) and their *_f32.c counterparts, each
+ *          with its own instruction set flags, and defines SIMPLEX_HAVE_<ISA>
+ *          for every instruction set it built. This file only hands out tables
+ *          the running processor and operating system can execute, so a single
+ *          binary runs on any machine of its architecture.
+ *
+ * @author Adrian Paredez
+ * @version 2.0.0
+ * @date 9/5/2025
+ */
+
+#define SIMPLEX_OPS_SCALAR
+#include "simplex_simd_kernels.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define SIMPLEX_CPU_X86
+#if defined(_MSC_VER)
+#include <immintrin.h>
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+/* ===== CPU DETECTION ===== */
+
+#if defined(SIMPLEX_CPU_X86)
+// cpuid leaf 1 ECX / leaf 7 EBX feature bits
+#define CPUID_1_ECX_SSE41 (1u << 19)
+#define CPUID_1_ECX_OSXSAVE (1u << 27)
+#define CPUID_1_ECX_AVX (1u << 28)
+#define CPUID_7_EBX_AVX2 (1u << 5)
+#define CPUID_7_EBX_AVX512F (1u << 16)
+
+// XCR0 state components the OS must save for YMM / ZMM registers
+#define XCR0_AVX_STATE 0x06u
+#define XCR0_AVX512_STATE 0xE0u
+
+static int cpu_query(unsigned int leaf, unsigned int subleaf, unsigned int regs[4]) {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if ((unsigned int)info[0] < leaf) {
+        return 0;
+    }
+    __cpuidex(info, (int)leaf, (int)subleaf);
+    for (int i = 0; i < 4; i++) {
+        regs[i] = (unsigned int)info[i];
+    }
+    return 1;
+#else
+    if (__get_cpuid_max(0, NULL) < leaf) {
+        return 0;
+    }
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+    return 1;
+#endif
+}
+
+static unsigned long long cpu_xcr0(void) {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned int eax;
+    unsigned int edx;
+    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((unsigned long long)edx << 32) | eax;
+#endif
+}
+#endif
+
+// Bit mask (1 << level) of the levels the running CPU and OS can execute
+static unsigned int cpu_levels(void) {
+    unsigned int levels = 1u << SIMPLEX_SIMD_SCALAR;
+#if defined(SIMPLEX_CPU_X86)
+    unsigned int leaf1[4] = {0, 0, 0, 0};
+    unsigned int leaf7[4] = {0, 0, 0, 0};
+    unsigned long long xcr0 = 0;
+
+    if (!cpu_query(1, 0, leaf1)) {
+        return levels;
+    }
+    cpu_query(7, 0, leaf7);
+    if (leaf1[2] & CPUID_1_ECX_OSXSAVE) {
+        xcr0 = cpu_xcr0();
+    }
+
+    int avx_os = (leaf1[2] & CPUID_1_ECX_AVX) && (xcr0 & XCR0_AVX_STATE) == XCR0_AVX_STATE;
+    int avx2 = avx_os && (leaf7[1] & CPUID_7_EBX_AVX2);
+
+    if (leaf1[2] & CPUID_1_ECX_SSE41) {
+        levels |= 1u << SIMPLEX_SIMD_SSE41;
+    }
+    if (avx2) {
+        levels |= 1u << SIMPLEX_SIMD_AVX2;
+    }
+    // The AVX-512 kernels also use 256-bit AVX2 integer gathers
+    if (avx2 && (leaf7[1] & CPUID_7_EBX_AVX512F) &&
+        (xcr0 & XCR0_AVX512_STATE) == XCR0_AVX512_STATE) {
+        levels |= 1u << SIMPLEX_SIMD_AVX512;
+    }
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    // Advanced SIMD is mandatory on AArch64
+    levels |= 1u << SIMPLEX_SIMD_NEON;
+#endif
+    return levels;
+}
+
+// Kernel table compiled into this build for a level, or NULL
+static const simplex_kernels_t* compiled_kernels(simplex_simd_level_t level) {
+    switch (level) {
+        case SIMPLEX_SIMD_SCALAR:
+            return &simplex_kernels_scalar;
+#if defined(SIMPLEX_HAVE_SSE41)
+        case SIMPLEX_SIMD_SSE41:
+            return &simplex_kernels_sse41;
+#endif
+#if defined(SIMPLEX_HAVE_AVX2)
+        case SIMPLEX_SIMD_AVX2:
+            return &simplex_kernels_avx2;
+#endif
+#if defined(SIMPLEX_HAVE_AVX512)
+        case SIMPLEX_SIMD_AVX512:
+            return &simplex_kernels_avx512;
+#endif
+#if defined(SIMPLEX_HAVE_NEON)
+        case SIMPLEX_SIMD_NEON:
+            return &simplex_kernels_neon;
+#endif
+        default:
+            return NULL;
+    }
+}
+
+// Float32 kernel table compiled into this build for a level, or NULL
+static const simplex_kernels_f32_t* compiled_kernels_f32(simplex_simd_level_t level) {
+    switch (level) {
+        case SIMPLEX_SIMD_SCALAR:
+            return &simplex_kernels_f32_scalar;
+#if defined(SIMPLEX_HAVE_SSE41)
+        case SIMPLEX_SIMD_SSE41:
+            return &simplex_kernels_f32_sse41;
+#endif
+#if defined(SIMPLEX_HAVE_AVX2)
+        case SIMPLEX_SIMD_AVX2:
+            return &simplex_kernels_f32_avx2;
+#endif
+#if defined(SIMPLEX_HAVE_AVX512)
+        case SIMPLEX_SIMD_AVX512:
+            return &simplex_kernels_f32_avx512;
+#endif
+#if defined(SIMPLEX_HAVE_NEON)
+        case SIMPLEX_SIMD_NEON:
+            return &simplex_kernels_f32_neon;
+#endif
+        default:
+            return NULL;
+    }
+}
+
+/* ===== KERNEL SELECTION ===== */
+/* Not cached: the CPU is only queried when a context is (re)configured, which
+ * keeps these functions free of shared mutable state. */
+
+const simplex_kernels_t* simplex_simd_kernels(simplex_simd_level_t level) {
+    if ((int)level < 0 || level >= SIMPLEX_SIMD_COUNT) {
+        return NULL;
+    }
+    return (cpu_levels() & (1u << level)) ? compiled_kernels(level) : NULL;
+}
+
+const simplex_kernels_f32_t* simplex_simd_kernels_f32(simplex_simd_level_t level) {
+    if ((int)level < 0 || level >= SIMPLEX_SIMD_COUNT) {
+        return NULL;
+    }
+    return (cpu_levels() & (1u << level)) ? compiled_kernels_f32(level) : NULL;
+}
+
+simplex_simd_level_t simplex_simd_detect(void) {
+    // Highest preference first
+    static const simplex_simd_level_t preference[] = {
+        SIMPLEX_SIMD_AVX512, SIMPLEX_SIMD_AVX2, SIMPLEX_SIMD_SSE41, SIMPLEX_SIMD_NEON};
+    unsigned int levels = cpu_levels();
+
+    for (size_t i = 0; i < sizeof(preference) / sizeof(preference[0]); i++) {
+        if ((levels & (1u << preference[i])) && compiled_kernels(preference[i])) {
+            return preference[i];
+        }
+    }
+    return SIMPLEX_SIMD_SCALAR;
+}
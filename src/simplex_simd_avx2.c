@@ -0,0 +1,17 @@
+/**
+ * @file simplex_simd_avx2.c
+ * @brief AVX2 instantiation of the vectorized noise kernels
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @details Only this file is compiled with -mavx2; simplex_simd.c hands the table
+ *          out only after cpuid confirms the running CPU supports AVX2.
+ *
+ * @author Adrian Paredez
+ * @version 2.0.0
+ * @date 9/5/2025
+ */
+
+#define SIMPLEX_OPS_AVX2
+#include "simplex_simd_kernels.h"
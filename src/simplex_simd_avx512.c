@@ -0,0 +1,17 @@
+/**
+ * @file simplex_simd_avx512.c
+ * @brief AVX-512F instantiation of the vectorized noise kernels
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @details Only this file is compiled with -mavx512f; simplex_simd.c hands the table
+ *          out only after cpuid confirms the running CPU supports AVX-512F.
+ *
+ * @author Adrian Paredez
+ * @version 2.0.0
+ * @date 9/5/2025
+ */
+
+#define SIMPLEX_OPS_AVX512
+#include "simplex_simd_kernels.h"
@@ -0,0 +1,18 @@
+/**
+ * @file simplex_simd_f32.c
+ * @brief Scalar instantiation of the float32 noise kernels
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @details Always built. Backs the float point functions (simplex_noise_2df
+ *          etc.) and the single-precision array path when SIMD is disabled.
+ *
+ * @author Adrian Paredez
+ * @version 2.0.0
+ * @date 9/5/2025
+ */
+
+#define SIMPLEX_OPS_SCALAR
+#define SIMPLEX_OPS_F32
+#include "simplex_simd_kernels.h"
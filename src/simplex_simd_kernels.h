@@ -0,0 +1,642 @@
+/**
+ * @file simplex_simd_kernels.h
+ * @brief Vectorized 2D/3D/4D simplex kernels written against simplex_simd_ops.h
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @details Included once per instruction set by a translation unit that has
+ *          selected a back-end in simplex_simd_ops.h; defines that back-end's
+ *          simplex_kernels_<isa> table. The kernels follow the
+ *          scalar simplex_noise_2d/3d/4d code operation for operation (same
+ *          skew constants, same evaluation order, no fused multiply-add), but
+ *          replace the simplex ordering branches with comparison masks and
+ *          the per-corner `if (t >= 0)` tests with a masked contribution.
+ *          Permutation and gradient lookups are gathers, the permutation
+ *          ones from the byte tables of simplex_perm_tables_t. With
+ *          SIMPLEX_OPS_F32 the same code builds the float32 table
+ *          simplex_kernels_f32_<isa>, which computes in single precision
+ *          throughout.
+ *
+ * @author Adrian Paredez
+ * @version 2.0.0
+ * @date 9/5/2025
+ */
+
+#ifndef SIMPLEX_SIMD_KERNELS_H
+#define SIMPLEX_SIMD_KERNELS_H
+
+#include "simplex_internal.h"
+#include "simplex_simd_ops.h"
+#include <math.h>
+#include <string.h>
+
+/* ===== SHARED HELPERS ===== */
+
+static inline simd_vd simd_zero(void) {
+    return vd_set1(0.0);
+}
+
+static inline simd_vd simd_one(void) {
+    return vd_set1(1.0);
+}
+
+// Mirrors fast_floor(): truncate, then step down by one wherever x <= 0
+static inline simd_vd simd_fast_floor(simd_vd x) {
+    return vd_sub(vd_trunc(x), vd_select_not(vm_gt(x, simd_zero()), simd_one()));
+}
+
+// Lattice coordinate wrapped to the permutation table, i.e. `i & 0xff`
+static inline simd_vi simd_wrap(simd_vd lattice) {
+    return vi_and(vi_from_vd(lattice), vi_set1(0xff));
+}
+
+/* ===== 2D ===== */
+
+static inline simd_vd simd_corner_2d(simd_vd x, simd_vd y, simd_vi gi) {
+    simd_vd t = vd_sub(vd_sub(vd_set1(SIMPLEX_2D_THRESHOLD), vd_mul(x, x)), vd_mul(y, y));
+    simd_vm inside = vm_ge(t, simd_zero());
+    simd_vi g = vi_add(gi, gi);
+    simd_vd gx = vd_gather(&SIMD_GRAD2[0][0], g);
+    simd_vd gy = vd_gather(&SIMD_GRAD2[0][1], g);
+    t = vd_mul(t, t);
+    simd_vd n = vd_mul(vd_mul(t, t), vd_add(vd_mul(gx, x), vd_mul(gy, y)));
+    return vd_select(inside, n);
+}
+
+static inline simd_vd simd_noise_2d(const simplex_perm_tables_t* tables, simd_vd x, simd_vd y) {
+    const double F2 = 0.5 * (sqrt(3.0) - 1.0);
+    const double G2 = (3.0 - sqrt(3.0)) / 6.0;
+    const simd_vd one = simd_one();
+
+    simd_vd s = vd_mul(vd_add(x, y), vd_set1(F2));
+    simd_vd i = simd_fast_floor(vd_add(x, s));
+    simd_vd j = simd_fast_floor(vd_add(y, s));
+
+    simd_vd t = vd_mul(vd_add(i, j), vd_set1(G2));
+    simd_vd x0 = vd_sub(x, vd_sub(i, t));
+    simd_vd y0 = vd_sub(y, vd_sub(j, t));
+
+    simd_vm lower = vm_gt(x0, y0);
+    simd_vd i1 = vd_select(lower, one);
+    simd_vd j1 = vd_select_not(lower, one);
+
+    simd_vd x1 = vd_add(vd_sub(x0, i1), vd_set1(G2));
+    simd_vd y1 = vd_add(vd_sub(y0, j1), vd_set1(G2));
+    simd_vd x2 = vd_add(vd_sub(x0, one), vd_set1(2.0 * G2));
+    simd_vd y2 = vd_add(vd_sub(y0, one), vd_set1(2.0 * G2));
+
+    simd_vi ii = simd_wrap(i);
+    simd_vi jj = simd_wrap(j);
+    simd_vi i1i = vi_from_vd(i1);
+    simd_vi j1i = vi_from_vd(j1);
+    simd_vi one_i = vi_set1(1);
+    simd_vi mask = vi_set1(SIMPLEX_2D_GRAD_COUNT - 1);
+    const uint8_t* perm = tables->perm;
+
+    simd_vi gi0 = vi_and(vi_gather_u8(perm, vi_add(ii, vi_gather_u8(perm, jj))), mask);
+    simd_vi gi1 = vi_and(
+        vi_gather_u8(perm, vi_add(vi_add(ii, i1i), vi_gather_u8(perm, vi_add(jj, j1i)))), mask);
+    simd_vi gi2 = vi_and(
+        vi_gather_u8(perm, vi_add(vi_add(ii, one_i), vi_gather_u8(perm, vi_add(jj, one_i)))), mask);
+
+    simd_vd n0 = simd_corner_2d(x0, y0, gi0);
+    simd_vd n1 = simd_corner_2d(x1, y1, gi1);
+    simd_vd n2 = simd_corner_2d(x2, y2, gi2);
+
+    return vd_mul(vd_set1(SIMPLEX_2D_SCALE), vd_add(vd_add(n0, n1), n2));
+}
+
+/* ===== 3D ===== */
+
+static inline simd_vd simd_corner_3d(simd_vd x, simd_vd y, simd_vd z, simd_vi gi) {
+    simd_vd t = vd_sub(vd_sub(vd_sub(vd_set1(SIMPLEX_3D_THRESHOLD), vd_mul(x, x)), vd_mul(y, y)),
+                       vd_mul(z, z));
+    simd_vm inside = vm_ge(t, simd_zero());
+    simd_vi g = vi_add(vi_add(gi, gi), gi);
+    simd_vd gx = vd_gather(&SIMD_GRAD3[0][0], g);
+    simd_vd gy = vd_gather(&SIMD_GRAD3[0][1], g);
+    simd_vd gz = vd_gather(&SIMD_GRAD3[0][2], g);
+    t = vd_mul(t, t);
+    simd_vd dot = vd_add(vd_add(vd_mul(gx, x), vd_mul(gy, y)), vd_mul(gz, z));
+    return vd_select(inside, vd_mul(vd_mul(t, t), dot));
+}
+
+// Gradient index perm[ii + perm[jj + perm[kk]]] % 12, the last lookup taken from mod12
+static inline simd_vi simd_hash_3d(const simplex_perm_tables_t* tables, simd_vi ii, simd_vi jj,
+                                   simd_vi kk) {
+    const uint8_t* perm = tables->perm;
+    return vi_gather_u8(tables->mod12,
+                        vi_add(ii, vi_gather_u8(perm, vi_add(jj, vi_gather_u8(perm, kk)))));
+}
+
+static inline simd_vd simd_noise_3d(const simplex_perm_tables_t* tables, simd_vd x, simd_vd y,
+                                    simd_vd z) {
+    const double F3 = 1.0 / 3.0;
+    const double G3 = 1.0 / 6.0;
+    const simd_vd one = simd_one();
+
+    simd_vd s = vd_mul(vd_add(vd_add(x, y), z), vd_set1(F3));
+    simd_vd i = simd_fast_floor(vd_add(x, s));
+    simd_vd j = simd_fast_floor(vd_add(y, s));
+    simd_vd k = simd_fast_floor(vd_add(z, s));
+
+    simd_vd t = vd_mul(vd_add(vd_add(i, j), k), vd_set1(G3));
+    simd_vd x0 = vd_sub(x, vd_sub(i, t));
+    simd_vd y0 = vd_sub(y, vd_sub(j, t));
+    simd_vd z0 = vd_sub(z, vd_sub(k, t));
+
+    // Branchless form of the scalar ordering tree (ties resolve identically)
+    simd_vm xy = vm_ge(x0, y0);
+    simd_vm yz = vm_ge(y0, z0);
+    simd_vm xz = vm_ge(x0, z0);
+    simd_vd i1 = vd_select(vm_and(xy, vm_or(yz, xz)), one);
+    simd_vd j1 = vd_select(vm_andnot(xy, yz), one);
+    simd_vd k1 = vd_select_not(vm_or(yz, vm_and(xy, xz)), one);
+    simd_vd i2 = vd_select(vm_or(xy, vm_and(yz, xz)), one);
+    simd_vd j2 = vd_select_not(vm_andnot(yz, xy), one);
+    simd_vd k2 = vd_select_not(vm_and(yz, vm_or(xy, xz)), one);
+
+    simd_vd x1 = vd_add(vd_sub(x0, i1), vd_set1(G3));
+    simd_vd y1 = vd_add(vd_sub(y0, j1), vd_set1(G3));
+    simd_vd z1 = vd_add(vd_sub(z0, k1), vd_set1(G3));
+    simd_vd x2 = vd_add(vd_sub(x0, i2), vd_set1(2.0 * G3));
+    simd_vd y2 = vd_add(vd_sub(y0, j2), vd_set1(2.0 * G3));
+    simd_vd z2 = vd_add(vd_sub(z0, k2), vd_set1(2.0 * G3));
+    simd_vd x3 = vd_add(vd_sub(x0, one), vd_set1(3.0 * G3));
+    simd_vd y3 = vd_add(vd_sub(y0, one), vd_set1(3.0 * G3));
+    simd_vd z3 = vd_add(vd_sub(z0, one), vd_set1(3.0 * G3));
+
+    simd_vi ii = simd_wrap(i);
+    simd_vi jj = simd_wrap(j);
+    simd_vi kk = simd_wrap(k);
+    simd_vi one_i = vi_set1(1);
+
+    simd_vi gi0 = simd_hash_3d(tables, ii, jj, kk);
+    simd_vi gi1 = simd_hash_3d(tables, vi_add(ii, vi_from_vd(i1)), vi_add(jj, vi_from_vd(j1)),
+                               vi_add(kk, vi_from_vd(k1)));
+    simd_vi gi2 = simd_hash_3d(tables, vi_add(ii, vi_from_vd(i2)), vi_add(jj, vi_from_vd(j2)),
+                               vi_add(kk, vi_from_vd(k2)));
+    simd_vi gi3 = simd_hash_3d(tables, vi_add(ii, one_i), vi_add(jj, one_i), vi_add(kk, one_i));
+
+    simd_vd n0 = simd_corner_3d(x0, y0, z0, gi0);
+    simd_vd n1 = simd_corner_3d(x1, y1, z1, gi1);
+    simd_vd n2 = simd_corner_3d(x2, y2, z2, gi2);
+    simd_vd n3 = simd_corner_3d(x3, y3, z3, gi3);
+
+    return vd_mul(vd_set1(SIMPLEX_3D_SCALE), vd_add(vd_add(vd_add(n0, n1), n2), n3));
+}
+
+/* ===== 4D ===== */
+
+static inline simd_vd simd_corner_4d(simd_vd x, simd_vd y, simd_vd z, simd_vd w, simd_vi gi) {
+    simd_vd t = vd_sub(
+        vd_sub(vd_sub(vd_sub(vd_set1(SIMPLEX_4D_THRESHOLD), vd_mul(x, x)), vd_mul(y, y)),
+               vd_mul(z, z)),
+        vd_mul(w, w));
+    simd_vm inside = vm_ge(t, simd_zero());
+    simd_vi g = vi_add(vi_add(gi, gi), vi_add(gi, gi));
+    simd_vd gx = vd_gather(&SIMD_GRAD4[0][0], g);
+    simd_vd gy = vd_gather(&SIMD_GRAD4[0][1], g);
+    simd_vd gz = vd_gather(&SIMD_GRAD4[0][2], g);
+    simd_vd gw = vd_gather(&SIMD_GRAD4[0][3], g);
+    t = vd_mul(t, t);
+    simd_vd dot =
+        vd_add(vd_add(vd_add(vd_mul(gx, x), vd_mul(gy, y)), vd_mul(gz, z)), vd_mul(gw, w));
+    return vd_select(inside, vd_mul(vd_mul(t, t), dot));
+}
+
+static inline simd_vi simd_hash_4d(const simplex_perm_tables_t* tables, simd_vi ii, simd_vi jj,
+                                   simd_vi kk, simd_vi ll) {
+    const uint8_t* perm = tables->perm;
+    simd_vi h = vi_gather_u8(perm, vi_add(kk, vi_gather_u8(perm, ll)));
+    h = vi_gather_u8(perm, vi_add(ii, vi_gather_u8(perm, vi_add(jj, h))));
+    return vi_and(h, vi_set1(SIMPLEX_4D_GRAD_COUNT - 1));
+}
+
+// Corner offset for a coordinate whose magnitude rank is at least `threshold`
+static inline simd_vd simd_rank_step(simd_vd rank, double threshold) {
+    return vd_select(vm_ge(rank, vd_set1(threshold)), simd_one());
+}
+
+static inline simd_vd simd_noise_4d(const simplex_perm_tables_t* tables, simd_vd x, simd_vd y,
+                                    simd_vd z, simd_vd w) {
+    const double F4 = (sqrt(5.0) - 1.0) / 4.0;
+    const double G4 = (5.0 - sqrt(5.0)) / 20.0;
+    const simd_vd one = simd_one();
+
+    simd_vd s = vd_mul(vd_add(vd_add(vd_add(x, y), z), w), vd_set1(F4));
+    simd_vd i = simd_fast_floor(vd_add(x, s));
+    simd_vd j = simd_fast_floor(vd_add(y, s));
+    simd_vd k = simd_fast_floor(vd_add(z, s));
+    simd_vd l = simd_fast_floor(vd_add(w, s));
+
+    simd_vd t = vd_mul(vd_add(vd_add(vd_add(i, j), k), l), vd_set1(G4));
+    simd_vd x0 = vd_sub(x, vd_sub(i, t));
+    simd_vd y0 = vd_sub(y, vd_sub(j, t));
+    simd_vd z0 = vd_sub(z, vd_sub(k, t));
+    simd_vd w0 = vd_sub(w, vd_sub(l, t));
+
+    // Rank each coordinate by how many of the others it exceeds
+    simd_vd c1 = vd_select(vm_gt(x0, y0), one);
+    simd_vd c2 = vd_select(vm_gt(x0, z0), one);
+    simd_vd c3 = vd_select(vm_gt(y0, z0), one);
+    simd_vd c4 = vd_select(vm_gt(x0, w0), one);
+    simd_vd c5 = vd_select(vm_gt(y0, w0), one);
+    simd_vd c6 = vd_select(vm_gt(z0, w0), one);
+    simd_vd rank_x = vd_add(vd_add(c1, c2), c4);
+    simd_vd rank_y = vd_add(vd_add(vd_sub(one, c1), c3), c5);
+    simd_vd rank_z = vd_add(vd_add(vd_sub(one, c2), vd_sub(one, c3)), c6);
+    simd_vd rank_w = vd_add(vd_add(vd_sub(one, c4), vd_sub(one, c5)), vd_sub(one, c6));
+
+    simd_vd i1 = simd_rank_step(rank_x, 3.0);
+    simd_vd j1 = simd_rank_step(rank_y, 3.0);
+    simd_vd k1 = simd_rank_step(rank_z, 3.0);
+    simd_vd l1 = simd_rank_step(rank_w, 3.0);
+    simd_vd i2 = simd_rank_step(rank_x, 2.0);
+    simd_vd j2 = simd_rank_step(rank_y, 2.0);
+    simd_vd k2 = simd_rank_step(rank_z, 2.0);
+    simd_vd l2 = simd_rank_step(rank_w, 2.0);
+    simd_vd i3 = simd_rank_step(rank_x, 1.0);
+    simd_vd j3 = simd_rank_step(rank_y, 1.0);
+    simd_vd k3 = simd_rank_step(rank_z, 1.0);
+    simd_vd l3 = simd_rank_step(rank_w, 1.0);
+
+    const simd_vd g1 = vd_set1(G4);
+    const simd_vd g2 = vd_set1(2.0 * G4);
+    const simd_vd g3 = vd_set1(3.0 * G4);
+    const simd_vd g4 = vd_set1(4.0 * G4);
+
+    simd_vi ii = simd_wrap(i);
+    simd_vi jj = simd_wrap(j);
+    simd_vi kk = simd_wrap(k);
+    simd_vi ll = simd_wrap(l);
+    simd_vi one_i = vi_set1(1);
+
+    simd_vi gi0 = simd_hash_4d(tables, ii, jj, kk, ll);
+    simd_vi gi1 = simd_hash_4d(tables, vi_add(ii, vi_from_vd(i1)), vi_add(jj, vi_from_vd(j1)),
+                               vi_add(kk, vi_from_vd(k1)), vi_add(ll, vi_from_vd(l1)));
+    simd_vi gi2 = simd_hash_4d(tables, vi_add(ii, vi_from_vd(i2)), vi_add(jj, vi_from_vd(j2)),
+                               vi_add(kk, vi_from_vd(k2)), vi_add(ll, vi_from_vd(l2)));
+    simd_vi gi3 = simd_hash_4d(tables, vi_add(ii, vi_from_vd(i3)), vi_add(jj, vi_from_vd(j3)),
+                               vi_add(kk, vi_from_vd(k3)), vi_add(ll, vi_from_vd(l3)));
+    simd_vi gi4 = simd_hash_4d(tables, vi_add(ii, one_i), vi_add(jj, one_i), vi_add(kk, one_i),
+                               vi_add(ll, one_i));
+
+    simd_vd n0 = simd_corner_4d(x0, y0, z0, w0, gi0);
+    simd_vd n1 = simd_corner_4d(vd_add(vd_sub(x0, i1), g1), vd_add(vd_sub(y0, j1), g1),
+                                vd_add(vd_sub(z0, k1), g1), vd_add(vd_sub(w0, l1), g1), gi1);
+    simd_vd n2 = simd_corner_4d(vd_add(vd_sub(x0, i2), g2), vd_add(vd_sub(y0, j2), g2),
+                                vd_add(vd_sub(z0, k2), g2), vd_add(vd_sub(w0, l2), g2), gi2);
+    simd_vd n3 = simd_corner_4d(vd_add(vd_sub(x0, i3), g3), vd_add(vd_sub(y0, j3), g3),
+                                vd_add(vd_sub(z0, k3), g3), vd_add(vd_sub(w0, l3), g3), gi3);
+    simd_vd n4 = simd_corner_4d(vd_add(vd_sub(x0, one), g4), vd_add(vd_sub(y0, one), g4),
+                                vd_add(vd_sub(z0, one), g4), vd_add(vd_sub(w0, one), g4), gi4);
+
+    return vd_mul(vd_set1(SIMPLEX_4D_SCALE),
+                  vd_add(vd_add(vd_add(vd_add(n0, n1), n2), n3), n4));
+}
+
+/* ===== SEEDED LATTICE ===== */
+/* Double precision only. A corner's gradient index is an integer hash of its
+ * unwrapped lattice point and a seed, so no table is read, the lattice does
+ * not repeat every 256 units, and one skew of a vector of points serves every
+ * seed evaluated there. */
+#if !defined(SIMPLEX_OPS_F32)
+
+// Finalizes a lattice hash (two multiply-xorshift rounds, modulo 2^32)
+static inline simd_vi simd_seed_mix(simd_vi h) {
+    h = vi_mul(vi_xor(h, vi_srli(h, 16)), vi_set1(SIMPLEX_HASH_MIX_A));
+    h = vi_mul(vi_xor(h, vi_srli(h, 15)), vi_set1(SIMPLEX_HASH_MIX_B));
+    return vi_xor(h, vi_srli(h, 16));
+}
+
+// 2D gradient index 0..7 of lattice point (i, j): the top three hash bits
+static inline simd_vi simd_seed_hash_2d(simd_vi seed, simd_vi i, simd_vi j) {
+    simd_vi h = vi_xor(vi_xor(seed, vi_mul(i, vi_set1(SIMPLEX_HASH_X))),
+                       vi_mul(j, vi_set1(SIMPLEX_HASH_Y)));
+    return vi_srli(simd_seed_mix(h), 29);
+}
+
+// 3D gradient index 0..11 of lattice point (i, j, k): the top 16 hash bits scaled to 12
+static inline simd_vi simd_seed_hash_3d(simd_vi seed, simd_vi i, simd_vi j, simd_vi k) {
+    simd_vi h = vi_xor(vi_xor(seed, vi_mul(i, vi_set1(SIMPLEX_HASH_X))),
+                       vi_mul(j, vi_set1(SIMPLEX_HASH_Y)));
+    h = vi_srli(simd_seed_mix(vi_xor(h, vi_mul(k, vi_set1(SIMPLEX_HASH_Z)))), 16);
+    return vi_srli(vi_mul(h, vi_set1(SIMPLEX_3D_GRAD_COUNT)), 16);
+}
+
+// Seed-independent part of a 2D sample: each corner's offset and lattice point
+typedef struct {
+    simd_vd x[3];
+    simd_vd y[3];
+    simd_vi i[3];
+    simd_vi j[3];
+} simd_corners_2d_t;
+
+// The skew and corner selection of simd_noise_2d(), without wrapping the lattice
+static inline void simd_skew_2d(simd_vd x, simd_vd y, simd_corners_2d_t* corners) {
+    const double F2 = 0.5 * (sqrt(3.0) - 1.0);
+    const double G2 = (3.0 - sqrt(3.0)) / 6.0;
+    const simd_vd one = simd_one();
+
+    simd_vd s = vd_mul(vd_add(x, y), vd_set1(F2));
+    simd_vd i = simd_fast_floor(vd_add(x, s));
+    simd_vd j = simd_fast_floor(vd_add(y, s));
+
+    simd_vd t = vd_mul(vd_add(i, j), vd_set1(G2));
+    simd_vd x0 = vd_sub(x, vd_sub(i, t));
+    simd_vd y0 = vd_sub(y, vd_sub(j, t));
+
+    simd_vm lower = vm_gt(x0, y0);
+    simd_vd i1 = vd_select(lower, one);
+    simd_vd j1 = vd_select_not(lower, one);
+
+    corners->x[0] = x0;
+    corners->y[0] = y0;
+    corners->x[1] = vd_add(vd_sub(x0, i1), vd_set1(G2));
+    corners->y[1] = vd_add(vd_sub(y0, j1), vd_set1(G2));
+    corners->x[2] = vd_add(vd_sub(x0, one), vd_set1(2.0 * G2));
+    corners->y[2] = vd_add(vd_sub(y0, one), vd_set1(2.0 * G2));
+
+    simd_vi ii = vi_from_vd(i);
+    simd_vi jj = vi_from_vd(j);
+    corners->i[0] = ii;
+    corners->j[0] = jj;
+    corners->i[1] = vi_add(ii, vi_from_vd(i1));
+    corners->j[1] = vi_add(jj, vi_from_vd(j1));
+    corners->i[2] = vi_add(ii, vi_set1(1));
+    corners->j[2] = vi_add(jj, vi_set1(1));
+}
+
+static inline simd_vd simd_seeded_2d(const simd_corners_2d_t* c, simd_vi seed) {
+    simd_vd n[3];
+    for (int corner = 0; corner < 3; corner++) {
+        simd_vi gi = simd_seed_hash_2d(seed, c->i[corner], c->j[corner]);
+        n[corner] = simd_corner_2d(c->x[corner], c->y[corner], gi);
+    }
+    return vd_mul(vd_set1(SIMPLEX_2D_SCALE), vd_add(vd_add(n[0], n[1]), n[2]));
+}
+
+// Seed-independent part of a 3D sample
+typedef struct {
+    simd_vd x[4];
+    simd_vd y[4];
+    simd_vd z[4];
+    simd_vi i[4];
+    simd_vi j[4];
+    simd_vi k[4];
+} simd_corners_3d_t;
+
+// The skew and corner selection of simd_noise_3d(), without wrapping the lattice
+static inline void simd_skew_3d(simd_vd x, simd_vd y, simd_vd z, simd_corners_3d_t* corners) {
+    const double F3 = 1.0 / 3.0;
+    const double G3 = 1.0 / 6.0;
+    const simd_vd one = simd_one();
+
+    simd_vd s = vd_mul(vd_add(vd_add(x, y), z), vd_set1(F3));
+    simd_vd i = simd_fast_floor(vd_add(x, s));
+    simd_vd j = simd_fast_floor(vd_add(y, s));
+    simd_vd k = simd_fast_floor(vd_add(z, s));
+
+    simd_vd t = vd_mul(vd_add(vd_add(i, j), k), vd_set1(G3));
+    simd_vd x0 = vd_sub(x, vd_sub(i, t));
+    simd_vd y0 = vd_sub(y, vd_sub(j, t));
+    simd_vd z0 = vd_sub(z, vd_sub(k, t));
+
+    simd_vm xy = vm_ge(x0, y0);
+    simd_vm yz = vm_ge(y0, z0);
+    simd_vm xz = vm_ge(x0, z0);
+    simd_vd i1 = vd_select(vm_and(xy, vm_or(yz, xz)), one);
+    simd_vd j1 = vd_select(vm_andnot(xy, yz), one);
+    simd_vd k1 = vd_select_not(vm_or(yz, vm_and(xy, xz)), one);
+    simd_vd i2 = vd_select(vm_or(xy, vm_and(yz, xz)), one);
+    simd_vd j2 = vd_select_not(vm_andnot(yz, xy), one);
+    simd_vd k2 = vd_select_not(vm_and(yz, vm_or(xy, xz)), one);
+
+    corners->x[0] = x0;
+    corners->y[0] = y0;
+    corners->z[0] = z0;
+    corners->x[1] = vd_add(vd_sub(x0, i1), vd_set1(G3));
+    corners->y[1] = vd_add(vd_sub(y0, j1), vd_set1(G3));
+    corners->z[1] = vd_add(vd_sub(z0, k1), vd_set1(G3));
+    corners->x[2] = vd_add(vd_sub(x0, i2), vd_set1(2.0 * G3));
+    corners->y[2] = vd_add(vd_sub(y0, j2), vd_set1(2.0 * G3));
+    corners->z[2] = vd_add(vd_sub(z0, k2), vd_set1(2.0 * G3));
+    corners->x[3] = vd_add(vd_sub(x0, one), vd_set1(3.0 * G3));
+    corners->y[3] = vd_add(vd_sub(y0, one), vd_set1(3.0 * G3));
+    corners->z[3] = vd_add(vd_sub(z0, one), vd_set1(3.0 * G3));
+
+    simd_vi ii = vi_from_vd(i);
+    simd_vi jj = vi_from_vd(j);
+    simd_vi kk = vi_from_vd(k);
+    simd_vi one_i = vi_set1(1);
+    corners->i[0] = ii;
+    corners->j[0] = jj;
+    corners->k[0] = kk;
+    corners->i[1] = vi_add(ii, vi_from_vd(i1));
+    corners->j[1] = vi_add(jj, vi_from_vd(j1));
+    corners->k[1] = vi_add(kk, vi_from_vd(k1));
+    corners->i[2] = vi_add(ii, vi_from_vd(i2));
+    corners->j[2] = vi_add(jj, vi_from_vd(j2));
+    corners->k[2] = vi_add(kk, vi_from_vd(k2));
+    corners->i[3] = vi_add(ii, one_i);
+    corners->j[3] = vi_add(jj, one_i);
+    corners->k[3] = vi_add(kk, one_i);
+}
+
+static inline simd_vd simd_seeded_3d(const simd_corners_3d_t* c, simd_vi seed) {
+    simd_vd n[4];
+    for (int corner = 0; corner < 4; corner++) {
+        simd_vi gi = simd_seed_hash_3d(seed, c->i[corner], c->j[corner], c->k[corner]);
+        n[corner] = simd_corner_3d(c->x[corner], c->y[corner], c->z[corner], gi);
+    }
+    return vd_mul(vd_set1(SIMPLEX_3D_SCALE), vd_add(vd_add(vd_add(n[0], n[1]), n[2]), n[3]));
+}
+
+#endif /* !SIMPLEX_OPS_F32 */
+
+/* ===== BATCH DRIVERS ===== */
+/* Full vectors are processed in place; a trailing partial vector is padded
+ * with zeros in a local buffer so the tail goes through the same kernel. */
+
+static void SIMD_SUFFIX(simplex_kernel_noise_2d)(const simplex_perm_tables_t* tables,
+                                                 const simd_real* x, const simd_real* y,
+                                                 size_t count, simd_real* output) {
+    size_t i = 0;
+    for (; i + SIMD_LANES <= count; i += SIMD_LANES) {
+        vd_storeu(output + i, simd_noise_2d(tables, vd_loadu(x + i), vd_loadu(y + i)));
+    }
+    if (i < count) {
+        simd_real px[SIMD_LANES] = {0};
+        simd_real py[SIMD_LANES] = {0};
+        simd_real result[SIMD_LANES];
+        size_t rem = count - i;
+        memcpy(px, x + i, rem * sizeof(simd_real));
+        memcpy(py, y + i, rem * sizeof(simd_real));
+        vd_storeu(result, simd_noise_2d(tables, vd_loadu(px), vd_loadu(py)));
+        memcpy(output + i, result, rem * sizeof(simd_real));
+    }
+}
+
+static void SIMD_SUFFIX(simplex_kernel_noise_3d)(const simplex_perm_tables_t* tables,
+                                                 const simd_real* x, const simd_real* y,
+                                                 const simd_real* z, size_t count,
+                                                 simd_real* output) {
+    size_t i = 0;
+    for (; i + SIMD_LANES <= count; i += SIMD_LANES) {
+        vd_storeu(output + i,
+                  simd_noise_3d(tables, vd_loadu(x + i), vd_loadu(y + i), vd_loadu(z + i)));
+    }
+    if (i < count) {
+        simd_real px[SIMD_LANES] = {0};
+        simd_real py[SIMD_LANES] = {0};
+        simd_real pz[SIMD_LANES] = {0};
+        simd_real result[SIMD_LANES];
+        size_t rem = count - i;
+        memcpy(px, x + i, rem * sizeof(simd_real));
+        memcpy(py, y + i, rem * sizeof(simd_real));
+        memcpy(pz, z + i, rem * sizeof(simd_real));
+        vd_storeu(result, simd_noise_3d(tables, vd_loadu(px), vd_loadu(py), vd_loadu(pz)));
+        memcpy(output + i, result, rem * sizeof(simd_real));
+    }
+}
+
+static void SIMD_SUFFIX(simplex_kernel_noise_4d)(const simplex_perm_tables_t* tables,
+                                                 const simd_real* x, const simd_real* y,
+                                                 const simd_real* z, const simd_real* w,
+                                                 size_t count, simd_real* output) {
+    size_t i = 0;
+    for (; i + SIMD_LANES <= count; i += SIMD_LANES) {
+        vd_storeu(output + i, simd_noise_4d(tables, vd_loadu(x + i), vd_loadu(y + i),
+                                            vd_loadu(z + i), vd_loadu(w + i)));
+    }
+    if (i < count) {
+        simd_real px[SIMD_LANES] = {0};
+        simd_real py[SIMD_LANES] = {0};
+        simd_real pz[SIMD_LANES] = {0};
+        simd_real pw[SIMD_LANES] = {0};
+        simd_real result[SIMD_LANES];
+        size_t rem = count - i;
+        memcpy(px, x + i, rem * sizeof(simd_real));
+        memcpy(py, y + i, rem * sizeof(simd_real));
+        memcpy(pz, z + i, rem * sizeof(simd_real));
+        memcpy(pw, w + i, rem * sizeof(simd_real));
+        vd_storeu(result, simd_noise_4d(tables, vd_loadu(px), vd_loadu(py), vd_loadu(pz),
+                                        vd_loadu(pw)));
+        memcpy(output + i, result, rem * sizeof(simd_real));
+    }
+}
+
+static void SIMD_SUFFIX(simplex_kernel_row_2d)(const simplex_perm_tables_t* tables,
+                                               simd_real x_start, simd_real y, simd_real step,
+                                               int count, simd_real* output) {
+    const simd_vd vx_start = vd_set1(x_start);
+    const simd_vd vstep = vd_set1(step);
+    const simd_vd vy = vd_set1(y);
+    const simd_vd iota = vd_iota();
+    int i = 0;
+    for (; i + SIMD_LANES <= count; i += SIMD_LANES) {
+        simd_vd vx = vd_add(vx_start, vd_mul(vd_add(vd_set1((simd_real)i), iota), vstep));
+        vd_storeu(output + i, simd_noise_2d(tables, vx, vy));
+    }
+    if (i < count) {
+        simd_real result[SIMD_LANES];
+        simd_vd vx = vd_add(vx_start, vd_mul(vd_add(vd_set1((simd_real)i), iota), vstep));
+        vd_storeu(result, simd_noise_2d(tables, vx, vy));
+        memcpy(output + i, result, (size_t)(count - i) * sizeof(simd_real));
+    }
+}
+
+static void SIMD_SUFFIX(simplex_kernel_row_3d)(const simplex_perm_tables_t* tables,
+                                               simd_real x_start, simd_real y, simd_real z,
+                                               simd_real step, int count, simd_real* output) {
+    const simd_vd vx_start = vd_set1(x_start);
+    const simd_vd vstep = vd_set1(step);
+    const simd_vd vy = vd_set1(y);
+    const simd_vd vz = vd_set1(z);
+    const simd_vd iota = vd_iota();
+    int i = 0;
+    for (; i + SIMD_LANES <= count; i += SIMD_LANES) {
+        simd_vd vx = vd_add(vx_start, vd_mul(vd_add(vd_set1((simd_real)i), iota), vstep));
+        vd_storeu(output + i, simd_noise_3d(tables, vx, vy, vz));
+    }
+    if (i < count) {
+        simd_real result[SIMD_LANES];
+        simd_vd vx = vd_add(vx_start, vd_mul(vd_add(vd_set1((simd_real)i), iota), vstep));
+        vd_storeu(result, simd_noise_3d(tables, vx, vy, vz));
+        memcpy(output + i, result, (size_t)(count - i) * sizeof(simd_real));
+    }
+}
+
+#if !defined(SIMPLEX_OPS_F32)
+// Store the first `lanes` samples of v at output
+static inline void simd_store_partial(double* output, simd_vd v, int lanes) {
+    if (lanes == SIMD_LANES) {
+        vd_storeu(output, v);
+        return;
+    }
+    double result[SIMD_LANES];
+    vd_storeu(result, v);
+    memcpy(output, result, (size_t)lanes * sizeof(double));
+}
+
+static void SIMD_SUFFIX(simplex_kernel_layers_2d)(const uint32_t* seeds, int layers,
+                                                  double x_start, double y, double step,
+                                                  int count, size_t stride, double* output) {
+    const simd_vd vx_start = vd_set1(x_start);
+    const simd_vd vstep = vd_set1(step);
+    const simd_vd vy = vd_set1(y);
+    const simd_vd iota = vd_iota();
+    for (int i = 0; i < count; i += SIMD_LANES) {
+        simd_vd vx = vd_add(vx_start, vd_mul(vd_add(vd_set1((double)i), iota), vstep));
+        int lanes = count - i < SIMD_LANES ? count - i : SIMD_LANES;
+        simd_corners_2d_t corners;
+        simd_skew_2d(vx, vy, &corners);
+        for (int l = 0; l < layers; l++) {
+            simd_store_partial(output + ((size_t)l * stride) + i,
+                               simd_seeded_2d(&corners, vi_set1((int)seeds[l])), lanes);
+        }
+    }
+}
+
+static void SIMD_SUFFIX(simplex_kernel_layers_3d)(const uint32_t* seeds, int layers,
+                                                  double x_start, double y, double z,
+                                                  double step, int count, size_t stride,
+                                                  double* output) {
+    const simd_vd vx_start = vd_set1(x_start);
+    const simd_vd vstep = vd_set1(step);
+    const simd_vd vy = vd_set1(y);
+    const simd_vd vz = vd_set1(z);
+    const simd_vd iota = vd_iota();
+    for (int i = 0; i < count; i += SIMD_LANES) {
+        simd_vd vx = vd_add(vx_start, vd_mul(vd_add(vd_set1((double)i), iota), vstep));
+        int lanes = count - i < SIMD_LANES ? count - i : SIMD_LANES;
+        simd_corners_3d_t corners;
+        simd_skew_3d(vx, vy, vz, &corners);
+        for (int l = 0; l < layers; l++) {
+            simd_store_partial(output + ((size_t)l * stride) + i,
+                               simd_seeded_3d(&corners, vi_set1((int)seeds[l])), lanes);
+        }
+    }
+}
+#endif /* !SIMPLEX_OPS_F32 */
+
+/* ===== KERNEL TABLE ===== */
+
+const SIMD_KERNELS_T SIMD_SUFFIX(simplex_kernels) = {
+    SIMD_LEVEL,
+    SIMD_ISA_NAME,
+    SIMD_LANES,
+    SIMD_SUFFIX(simplex_kernel_noise_2d),
+    SIMD_SUFFIX(simplex_kernel_noise_3d),
+    SIMD_SUFFIX(simplex_kernel_noise_4d),
+    SIMD_SUFFIX(simplex_kernel_row_2d),
+    SIMD_SUFFIX(simplex_kernel_row_3d),
+#if !defined(SIMPLEX_OPS_F32)
+    SIMD_SUFFIX(simplex_kernel_layers_2d),
+    SIMD_SUFFIX(simplex_kernel_layers_3d),
+#endif
+};
+
+#endif /* SIMPLEX_SIMD_KERNELS_H */
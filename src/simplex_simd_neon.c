@@ -0,0 +1,17 @@
+/**
+ * @file simplex_simd_neon.c
+ * @brief NEON instantiation of the vectorized noise kernels
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @details Built only for AArch64 targets, where NEON is part of the baseline
+ *          instruction set and needs no extra compiler flag.
+ *
+ * @author Adrian Paredez
+ * @version 2.0.0
+ * @date 9/5/2025
+ */
+
+#define SIMPLEX_OPS_NEON
+#include "simplex_simd_kernels.h"
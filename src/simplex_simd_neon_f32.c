@@ -0,0 +1,17 @@
+/**
+ * @file simplex_simd_neon_f32.c
+ * @brief NEON instantiation of the float32 noise kernels
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @details Built only for AArch64 targets, alongside simplex_simd_neon.c.
+ *
+ * @author Adrian Paredez
+ * @version 2.0.0
+ * @date 9/5/2025
+ */
+
+#define SIMPLEX_OPS_NEON
+#define SIMPLEX_OPS_F32
+#include "simplex_simd_kernels.h"
@@ -0,0 +1,495 @@
+/**
+ * @file simplex_simd_ops.h
+ * @brief Thin vector primitive layer used by the SIMD noise kernels
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @details Define exactly one of SIMPLEX_OPS_SCALAR, SIMPLEX_OPS_SSE41,
+ *          SIMPLEX_OPS_AVX2, SIMPLEX_OPS_AVX512 or SIMPLEX_OPS_NEON before
+ *          including this header. Each back-end maps the same small set of
+ *          operations onto its intrinsics:
+ *
+ *          - simd_vd: vector of doubles (SIMD_LANES wide)
+ *          - simd_vm: comparison mask for simd_vd
+ *          - simd_vi: vector of int32 lattice/permutation indices
+ *
+ *          Gathers are native on AVX2/AVX-512 and emulated lane-by-lane
+ *          elsewhere. vi_gather_u8 fetches permutation bytes; the native forms
+ *          load 32 bits at the byte offset and mask off the neighbours, so
+ *          tables need three readable bytes past the last entry. The scalar
+ *          back-end is one lane of plain C. Defining SIMPLEX_OPS_F32 as well
+ *          selects the single-precision variant of the chosen back-end from
+ *          simplex_simd_ops_f32.h instead.
+ *
+ * @author Adrian Paredez
+ * @version 2.0.0
+ * @date 9/5/2025
+ */
+
+#ifndef SIMPLEX_SIMD_OPS_H
+#define SIMPLEX_SIMD_OPS_H
+
+#include <stdint.h>
+
+#if defined(SIMPLEX_OPS_F32)
+#include "simplex_simd_ops_f32.h"
+#else
+
+typedef double simd_real;
+#define SIMD_KERNELS_T simplex_kernels_t
+#define SIMD_GRAD2 simplex_grad2
+#define SIMD_GRAD3 simplex_grad3
+#define SIMD_GRAD4 simplex_grad4
+
+/* ===== AVX2: 4 x double ===== */
+#if defined(SIMPLEX_OPS_AVX2)
+#include <immintrin.h>
+
+#define SIMD_LANES 4
+#define SIMD_SUFFIX(name) name##_avx2
+#define SIMD_ISA_NAME "avx2"
+#define SIMD_LEVEL SIMPLEX_SIMD_AVX2
+
+typedef __m256d simd_vd;
+typedef __m256d simd_vm;
+typedef __m128i simd_vi;
+
+static inline simd_vd vd_set1(double v) {
+    return _mm256_set1_pd(v);
+}
+static inline simd_vd vd_iota(void) {
+    return _mm256_set_pd(3.0, 2.0, 1.0, 0.0);
+}
+static inline simd_vd vd_loadu(const double* p) {
+    return _mm256_loadu_pd(p);
+}
+static inline void vd_storeu(double* p, simd_vd v) {
+    _mm256_storeu_pd(p, v);
+}
+static inline simd_vd vd_add(simd_vd a, simd_vd b) {
+    return _mm256_add_pd(a, b);
+}
+static inline simd_vd vd_sub(simd_vd a, simd_vd b) {
+    return _mm256_sub_pd(a, b);
+}
+static inline simd_vd vd_mul(simd_vd a, simd_vd b) {
+    return _mm256_mul_pd(a, b);
+}
+static inline simd_vd vd_trunc(simd_vd v) {
+    return _mm256_round_pd(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+}
+static inline simd_vm vm_gt(simd_vd a, simd_vd b) {
+    return _mm256_cmp_pd(a, b, _CMP_GT_OQ);
+}
+static inline simd_vm vm_ge(simd_vd a, simd_vd b) {
+    return _mm256_cmp_pd(a, b, _CMP_GE_OQ);
+}
+static inline simd_vm vm_and(simd_vm a, simd_vm b) {
+    return _mm256_and_pd(a, b);
+}
+static inline simd_vm vm_or(simd_vm a, simd_vm b) {
+    return _mm256_or_pd(a, b);
+}
+/* (!a) & b */
+static inline simd_vm vm_andnot(simd_vm a, simd_vm b) {
+    return _mm256_andnot_pd(a, b);
+}
+/* v where m is set, 0 elsewhere */
+static inline simd_vd vd_select(simd_vm m, simd_vd v) {
+    return _mm256_and_pd(m, v);
+}
+/* v where m is clear, 0 elsewhere */
+static inline simd_vd vd_select_not(simd_vm m, simd_vd v) {
+    return _mm256_andnot_pd(m, v);
+}
+static inline simd_vi vi_set1(int v) {
+    return _mm_set1_epi32(v);
+}
+/* Input lanes must already hold integral values */
+static inline simd_vi vi_from_vd(simd_vd v) {
+    return _mm256_cvttpd_epi32(v);
+}
+static inline simd_vi vi_add(simd_vi a, simd_vi b) {
+    return _mm_add_epi32(a, b);
+}
+static inline simd_vi vi_sub(simd_vi a, simd_vi b) {
+    return _mm_sub_epi32(a, b);
+}
+static inline simd_vi vi_mul(simd_vi a, simd_vi b) {
+    return _mm_mullo_epi32(a, b);
+}
+static inline simd_vi vi_and(simd_vi a, simd_vi b) {
+    return _mm_and_si128(a, b);
+}
+static inline simd_vi vi_xor(simd_vi a, simd_vi b) {
+    return _mm_xor_si128(a, b);
+}
+#define vi_srli(a, imm) _mm_srli_epi32((a), (imm))
+static inline simd_vi vi_gather_u8(const uint8_t* table, simd_vi idx) {
+    return _mm_and_si128(_mm_i32gather_epi32((const int*)table, idx, 1), _mm_set1_epi32(0xff));
+}
+static inline simd_vd vd_gather(const double* table, simd_vi idx) {
+    return _mm256_i32gather_pd(table, idx, 8);
+}
+
+/* ===== AVX-512F: 8 x double ===== */
+#elif defined(SIMPLEX_OPS_AVX512)
+#include <immintrin.h>
+
+#define SIMD_LANES 8
+#define SIMD_SUFFIX(name) name##_avx512
+#define SIMD_ISA_NAME "avx512"
+#define SIMD_LEVEL SIMPLEX_SIMD_AVX512
+
+typedef __m512d simd_vd;
+typedef __mmask8 simd_vm;
+typedef __m256i simd_vi;
+
+static inline simd_vd vd_set1(double v) {
+    return _mm512_set1_pd(v);
+}
+static inline simd_vd vd_iota(void) {
+    return _mm512_set_pd(7.0, 6.0, 5.0, 4.0, 3.0, 2.0, 1.0, 0.0);
+}
+static inline simd_vd vd_loadu(const double* p) {
+    return _mm512_loadu_pd(p);
+}
+static inline void vd_storeu(double* p, simd_vd v) {
+    _mm512_storeu_pd(p, v);
+}
+static inline simd_vd vd_add(simd_vd a, simd_vd b) {
+    return _mm512_add_pd(a, b);
+}
+static inline simd_vd vd_sub(simd_vd a, simd_vd b) {
+    return _mm512_sub_pd(a, b);
+}
+static inline simd_vd vd_mul(simd_vd a, simd_vd b) {
+    return _mm512_mul_pd(a, b);
+}
+static inline simd_vd vd_trunc(simd_vd v) {
+    return _mm512_roundscale_pd(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+}
+static inline simd_vm vm_gt(simd_vd a, simd_vd b) {
+    return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ);
+}
+static inline simd_vm vm_ge(simd_vd a, simd_vd b) {
+    return _mm512_cmp_pd_mask(a, b, _CMP_GE_OQ);
+}
+static inline simd_vm vm_and(simd_vm a, simd_vm b) {
+    return (simd_vm)(a & b);
+}
+static inline simd_vm vm_or(simd_vm a, simd_vm b) {
+    return (simd_vm)(a | b);
+}
+static inline simd_vm vm_andnot(simd_vm a, simd_vm b) {
+    return (simd_vm)(~a & b);
+}
+static inline simd_vd vd_select(simd_vm m, simd_vd v) {
+    return _mm512_maskz_mov_pd(m, v);
+}
+static inline simd_vd vd_select_not(simd_vm m, simd_vd v) {
+    return _mm512_maskz_mov_pd((simd_vm)~m, v);
+}
+static inline simd_vi vi_set1(int v) {
+    return _mm256_set1_epi32(v);
+}
+static inline simd_vi vi_from_vd(simd_vd v) {
+    return _mm512_cvttpd_epi32(v);
+}
+static inline simd_vi vi_add(simd_vi a, simd_vi b) {
+    return _mm256_add_epi32(a, b);
+}
+static inline simd_vi vi_sub(simd_vi a, simd_vi b) {
+    return _mm256_sub_epi32(a, b);
+}
+static inline simd_vi vi_mul(simd_vi a, simd_vi b) {
+    return _mm256_mullo_epi32(a, b);
+}
+static inline simd_vi vi_and(simd_vi a, simd_vi b) {
+    return _mm256_and_si256(a, b);
+}
+static inline simd_vi vi_xor(simd_vi a, simd_vi b) {
+    return _mm256_xor_si256(a, b);
+}
+#define vi_srli(a, imm) _mm256_srli_epi32((a), (imm))
+static inline simd_vi vi_gather_u8(const uint8_t* table, simd_vi idx) {
+    return _mm256_and_si256(_mm256_i32gather_epi32((const int*)table, idx, 1),
+                            _mm256_set1_epi32(0xff));
+}
+static inline simd_vd vd_gather(const double* table, simd_vi idx) {
+    return _mm512_i32gather_pd(idx, table, 8);
+}
+
+/* ===== SSE4.1: 2 x double ===== */
+#elif defined(SIMPLEX_OPS_SSE41)
+#include <smmintrin.h>
+
+#define SIMD_LANES 2
+#define SIMD_SUFFIX(name) name##_sse41
+#define SIMD_ISA_NAME "sse4.1"
+#define SIMD_LEVEL SIMPLEX_SIMD_SSE41
+
+typedef __m128d simd_vd;
+typedef __m128d simd_vm;
+typedef __m128i simd_vi; /* Only the low two int32 lanes are used */
+
+static inline simd_vd vd_set1(double v) {
+    return _mm_set1_pd(v);
+}
+static inline simd_vd vd_iota(void) {
+    return _mm_set_pd(1.0, 0.0);
+}
+static inline simd_vd vd_loadu(const double* p) {
+    return _mm_loadu_pd(p);
+}
+static inline void vd_storeu(double* p, simd_vd v) {
+    _mm_storeu_pd(p, v);
+}
+static inline simd_vd vd_add(simd_vd a, simd_vd b) {
+    return _mm_add_pd(a, b);
+}
+static inline simd_vd vd_sub(simd_vd a, simd_vd b) {
+    return _mm_sub_pd(a, b);
+}
+static inline simd_vd vd_mul(simd_vd a, simd_vd b) {
+    return _mm_mul_pd(a, b);
+}
+static inline simd_vd vd_trunc(simd_vd v) {
+    return _mm_round_pd(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+}
+static inline simd_vm vm_gt(simd_vd a, simd_vd b) {
+    return _mm_cmpgt_pd(a, b);
+}
+static inline simd_vm vm_ge(simd_vd a, simd_vd b) {
+    return _mm_cmpge_pd(a, b);
+}
+static inline simd_vm vm_and(simd_vm a, simd_vm b) {
+    return _mm_and_pd(a, b);
+}
+static inline simd_vm vm_or(simd_vm a, simd_vm b) {
+    return _mm_or_pd(a, b);
+}
+static inline simd_vm vm_andnot(simd_vm a, simd_vm b) {
+    return _mm_andnot_pd(a, b);
+}
+static inline simd_vd vd_select(simd_vm m, simd_vd v) {
+    return _mm_and_pd(m, v);
+}
+static inline simd_vd vd_select_not(simd_vm m, simd_vd v) {
+    return _mm_andnot_pd(m, v);
+}
+static inline simd_vi vi_set1(int v) {
+    return _mm_set1_epi32(v);
+}
+static inline simd_vi vi_from_vd(simd_vd v) {
+    return _mm_cvttpd_epi32(v);
+}
+static inline simd_vi vi_add(simd_vi a, simd_vi b) {
+    return _mm_add_epi32(a, b);
+}
+static inline simd_vi vi_sub(simd_vi a, simd_vi b) {
+    return _mm_sub_epi32(a, b);
+}
+static inline simd_vi vi_mul(simd_vi a, simd_vi b) {
+    return _mm_mullo_epi32(a, b);
+}
+static inline simd_vi vi_and(simd_vi a, simd_vi b) {
+    return _mm_and_si128(a, b);
+}
+static inline simd_vi vi_xor(simd_vi a, simd_vi b) {
+    return _mm_xor_si128(a, b);
+}
+#define vi_srli(a, imm) _mm_srli_epi32((a), (imm))
+static inline simd_vi vi_gather_u8(const uint8_t* table, simd_vi idx) {
+    return _mm_set_epi32(0, 0, table[_mm_extract_epi32(idx, 1)], table[_mm_cvtsi128_si32(idx)]);
+}
+static inline simd_vd vd_gather(const double* table, simd_vi idx) {
+    return _mm_set_pd(table[_mm_extract_epi32(idx, 1)], table[_mm_cvtsi128_si32(idx)]);
+}
+
+/* ===== NEON (AArch64): 2 x double ===== */
+#elif defined(SIMPLEX_OPS_NEON)
+#include <arm_neon.h>
+
+#define SIMD_LANES 2
+#define SIMD_SUFFIX(name) name##_neon
+#define SIMD_ISA_NAME "neon"
+#define SIMD_LEVEL SIMPLEX_SIMD_NEON
+
+typedef float64x2_t simd_vd;
+typedef uint64x2_t simd_vm;
+typedef int32x2_t simd_vi;
+
+static inline simd_vd vd_set1(double v) {
+    return vdupq_n_f64(v);
+}
+static inline simd_vd vd_iota(void) {
+    static const double iota[2] = {0.0, 1.0};
+    return vld1q_f64(iota);
+}
+static inline simd_vd vd_loadu(const double* p) {
+    return vld1q_f64(p);
+}
+static inline void vd_storeu(double* p, simd_vd v) {
+    vst1q_f64(p, v);
+}
+static inline simd_vd vd_add(simd_vd a, simd_vd b) {
+    return vaddq_f64(a, b);
+}
+static inline simd_vd vd_sub(simd_vd a, simd_vd b) {
+    return vsubq_f64(a, b);
+}
+static inline simd_vd vd_mul(simd_vd a, simd_vd b) {
+    return vmulq_f64(a, b);
+}
+static inline simd_vd vd_trunc(simd_vd v) {
+    return vrndq_f64(v);
+}
+static inline simd_vm vm_gt(simd_vd a, simd_vd b) {
+    return vcgtq_f64(a, b);
+}
+static inline simd_vm vm_ge(simd_vd a, simd_vd b) {
+    return vcgeq_f64(a, b);
+}
+static inline simd_vm vm_and(simd_vm a, simd_vm b) {
+    return vandq_u64(a, b);
+}
+static inline simd_vm vm_or(simd_vm a, simd_vm b) {
+    return vorrq_u64(a, b);
+}
+static inline simd_vm vm_andnot(simd_vm a, simd_vm b) {
+    return vbicq_u64(b, a);
+}
+static inline simd_vd vd_select(simd_vm m, simd_vd v) {
+    return vreinterpretq_f64_u64(vandq_u64(m, vreinterpretq_u64_f64(v)));
+}
+static inline simd_vd vd_select_not(simd_vm m, simd_vd v) {
+    return vreinterpretq_f64_u64(vbicq_u64(vreinterpretq_u64_f64(v), m));
+}
+static inline simd_vi vi_set1(int v) {
+    return vdup_n_s32(v);
+}
+static inline simd_vi vi_from_vd(simd_vd v) {
+    return vmovn_s64(vcvtq_s64_f64(v));
+}
+static inline simd_vi vi_add(simd_vi a, simd_vi b) {
+    return vadd_s32(a, b);
+}
+static inline simd_vi vi_sub(simd_vi a, simd_vi b) {
+    return vsub_s32(a, b);
+}
+static inline simd_vi vi_mul(simd_vi a, simd_vi b) {
+    return vmul_s32(a, b);
+}
+static inline simd_vi vi_and(simd_vi a, simd_vi b) {
+    return vand_s32(a, b);
+}
+static inline simd_vi vi_xor(simd_vi a, simd_vi b) {
+    return veor_s32(a, b);
+}
+#define vi_srli(a, imm) vreinterpret_s32_u32(vshr_n_u32(vreinterpret_u32_s32(a), (imm)))
+static inline simd_vi vi_gather_u8(const uint8_t* table, simd_vi idx) {
+    int32x2_t r = vdup_n_s32(table[vget_lane_s32(idx, 0)]);
+    return vset_lane_s32(table[vget_lane_s32(idx, 1)], r, 1);
+}
+static inline simd_vd vd_gather(const double* table, simd_vi idx) {
+    float64x2_t r = vdupq_n_f64(table[vget_lane_s32(idx, 0)]);
+    return vsetq_lane_f64(table[vget_lane_s32(idx, 1)], r, 1);
+}
+
+/* ===== Scalar: 1 x double ===== */
+#elif defined(SIMPLEX_OPS_SCALAR)
+#include <math.h>
+
+#define SIMD_LANES 1
+#define SIMD_SUFFIX(name) name##_scalar
+#define SIMD_ISA_NAME "scalar"
+#define SIMD_LEVEL SIMPLEX_SIMD_SCALAR
+
+typedef double simd_vd;
+typedef int simd_vm;
+typedef int simd_vi;
+
+static inline simd_vd vd_set1(double v) {
+    return v;
+}
+static inline simd_vd vd_iota(void) {
+    return 0.0;
+}
+static inline simd_vd vd_loadu(const double* p) {
+    return *p;
+}
+static inline void vd_storeu(double* p, simd_vd v) {
+    *p = v;
+}
+static inline simd_vd vd_add(simd_vd a, simd_vd b) {
+    return a + b;
+}
+static inline simd_vd vd_sub(simd_vd a, simd_vd b) {
+    return a - b;
+}
+static inline simd_vd vd_mul(simd_vd a, simd_vd b) {
+    return a * b;
+}
+static inline simd_vd vd_trunc(simd_vd v) {
+    return trunc(v);
+}
+static inline simd_vm vm_gt(simd_vd a, simd_vd b) {
+    return a > b;
+}
+static inline simd_vm vm_ge(simd_vd a, simd_vd b) {
+    return a >= b;
+}
+static inline simd_vm vm_and(simd_vm a, simd_vm b) {
+    return a && b;
+}
+static inline simd_vm vm_or(simd_vm a, simd_vm b) {
+    return a || b;
+}
+static inline simd_vm vm_andnot(simd_vm a, simd_vm b) {
+    return !a && b;
+}
+static inline simd_vd vd_select(simd_vm m, simd_vd v) {
+    return m ? v : 0.0;
+}
+static inline simd_vd vd_select_not(simd_vm m, simd_vd v) {
+    return m ? 0.0 : v;
+}
+static inline simd_vi vi_set1(int v) {
+    return v;
+}
+static inline simd_vi vi_from_vd(simd_vd v) {
+    return (int)v;
+}
+static inline simd_vi vi_add(simd_vi a, simd_vi b) {
+    return a + b;
+}
+static inline simd_vi vi_sub(simd_vi a, simd_vi b) {
+    return a - b;
+}
+// Wraps modulo 2^32 like the vector multiplies
+static inline simd_vi vi_mul(simd_vi a, simd_vi b) {
+    return (int)((unsigned int)a * (unsigned int)b);
+}
+static inline simd_vi vi_and(simd_vi a, simd_vi b) {
+    return a & b;
+}
+static inline simd_vi vi_xor(simd_vi a, simd_vi b) {
+    return a ^ b;
+}
+#define vi_srli(a, imm) ((int)((unsigned int)(a) >> (imm)))
+static inline simd_vi vi_gather_u8(const uint8_t* table, simd_vi idx) {
+    return table[idx];
+}
+static inline simd_vd vd_gather(const double* table, simd_vi idx) {
+    return table[idx];
+}
+
+#else
+#error "simplex_simd_ops.h: no SIMD back-end selected"
+#endif
+
+#endif /* SIMPLEX_OPS_F32 */
+
+#endif /* SIMPLEX_SIMD_OPS_H */
@@ -0,0 +1,482 @@
+/**
+ * @file simplex_simd_ops_f32.h
+ * @brief Single-precision vector primitive layer used by the float32 kernels
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @details Included by simplex_simd_ops.h when SIMPLEX_OPS_F32 is defined
+ *          alongside a back-end. Provides the same operation names as the
+ *          double back-ends so simplex_simd_kernels.h compiles unchanged, but
+ *          simd_vd holds floats and simd_vi is a full-width int32 vector.
+ *          Each vector therefore carries twice as many lanes as its double
+ *          counterpart.
+ *
+ * @author Adrian Paredez
+ * @version 2.0.0
+ * @date 9/5/2025
+ */
+
+#ifndef SIMPLEX_SIMD_OPS_F32_H
+#define SIMPLEX_SIMD_OPS_F32_H
+
+#include <stdint.h>
+
+typedef float simd_real;
+#define SIMD_KERNELS_T simplex_kernels_f32_t
+#define SIMD_GRAD2 simplex_grad2f
+#define SIMD_GRAD3 simplex_grad3f
+#define SIMD_GRAD4 simplex_grad4f
+
+/* ===== AVX2: 8 x float ===== */
+#if defined(SIMPLEX_OPS_AVX2)
+#include <immintrin.h>
+
+#define SIMD_LANES 8
+#define SIMD_SUFFIX(name) name##_f32_avx2
+#define SIMD_ISA_NAME "avx2"
+#define SIMD_LEVEL SIMPLEX_SIMD_AVX2
+
+typedef __m256 simd_vd;
+typedef __m256 simd_vm;
+typedef __m256i simd_vi;
+
+static inline simd_vd vd_set1(float v) {
+    return _mm256_set1_ps(v);
+}
+static inline simd_vd vd_iota(void) {
+    return _mm256_set_ps(7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+}
+static inline simd_vd vd_loadu(const float* p) {
+    return _mm256_loadu_ps(p);
+}
+static inline void vd_storeu(float* p, simd_vd v) {
+    _mm256_storeu_ps(p, v);
+}
+static inline simd_vd vd_add(simd_vd a, simd_vd b) {
+    return _mm256_add_ps(a, b);
+}
+static inline simd_vd vd_sub(simd_vd a, simd_vd b) {
+    return _mm256_sub_ps(a, b);
+}
+static inline simd_vd vd_mul(simd_vd a, simd_vd b) {
+    return _mm256_mul_ps(a, b);
+}
+static inline simd_vd vd_trunc(simd_vd v) {
+    return _mm256_round_ps(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+}
+static inline simd_vm vm_gt(simd_vd a, simd_vd b) {
+    return _mm256_cmp_ps(a, b, _CMP_GT_OQ);
+}
+static inline simd_vm vm_ge(simd_vd a, simd_vd b) {
+    return _mm256_cmp_ps(a, b, _CMP_GE_OQ);
+}
+static inline simd_vm vm_and(simd_vm a, simd_vm b) {
+    return _mm256_and_ps(a, b);
+}
+static inline simd_vm vm_or(simd_vm a, simd_vm b) {
+    return _mm256_or_ps(a, b);
+}
+static inline simd_vm vm_andnot(simd_vm a, simd_vm b) {
+    return _mm256_andnot_ps(a, b);
+}
+static inline simd_vd vd_select(simd_vm m, simd_vd v) {
+    return _mm256_and_ps(m, v);
+}
+static inline simd_vd vd_select_not(simd_vm m, simd_vd v) {
+    return _mm256_andnot_ps(m, v);
+}
+static inline simd_vi vi_set1(int v) {
+    return _mm256_set1_epi32(v);
+}
+static inline simd_vi vi_from_vd(simd_vd v) {
+    return _mm256_cvttps_epi32(v);
+}
+static inline simd_vi vi_add(simd_vi a, simd_vi b) {
+    return _mm256_add_epi32(a, b);
+}
+static inline simd_vi vi_sub(simd_vi a, simd_vi b) {
+    return _mm256_sub_epi32(a, b);
+}
+static inline simd_vi vi_mul(simd_vi a, simd_vi b) {
+    return _mm256_mullo_epi32(a, b);
+}
+static inline simd_vi vi_and(simd_vi a, simd_vi b) {
+    return _mm256_and_si256(a, b);
+}
+static inline simd_vi vi_xor(simd_vi a, simd_vi b) {
+    return _mm256_xor_si256(a, b);
+}
+#define vi_srli(a, imm) _mm256_srli_epi32((a), (imm))
+static inline simd_vi vi_gather_u8(const uint8_t* table, simd_vi idx) {
+    return _mm256_and_si256(_mm256_i32gather_epi32((const int*)table, idx, 1),
+                            _mm256_set1_epi32(0xff));
+}
+static inline simd_vd vd_gather(const float* table, simd_vi idx) {
+    return _mm256_i32gather_ps(table, idx, 4);
+}
+
+/* ===== AVX-512F: 16 x float ===== */
+#elif defined(SIMPLEX_OPS_AVX512)
+#include <immintrin.h>
+
+#define SIMD_LANES 16
+#define SIMD_SUFFIX(name) name##_f32_avx512
+#define SIMD_ISA_NAME "avx512"
+#define SIMD_LEVEL SIMPLEX_SIMD_AVX512
+
+typedef __m512 simd_vd;
+typedef __mmask16 simd_vm;
+typedef __m512i simd_vi;
+
+static inline simd_vd vd_set1(float v) {
+    return _mm512_set1_ps(v);
+}
+static inline simd_vd vd_iota(void) {
+    return _mm512_set_ps(15.0f, 14.0f, 13.0f, 12.0f, 11.0f, 10.0f, 9.0f, 8.0f, 7.0f, 6.0f, 5.0f,
+                         4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+}
+static inline simd_vd vd_loadu(const float* p) {
+    return _mm512_loadu_ps(p);
+}
+static inline void vd_storeu(float* p, simd_vd v) {
+    _mm512_storeu_ps(p, v);
+}
+static inline simd_vd vd_add(simd_vd a, simd_vd b) {
+    return _mm512_add_ps(a, b);
+}
+static inline simd_vd vd_sub(simd_vd a, simd_vd b) {
+    return _mm512_sub_ps(a, b);
+}
+static inline simd_vd vd_mul(simd_vd a, simd_vd b) {
+    return _mm512_mul_ps(a, b);
+}
+static inline simd_vd vd_trunc(simd_vd v) {
+    return _mm512_roundscale_ps(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+}
+static inline simd_vm vm_gt(simd_vd a, simd_vd b) {
+    return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ);
+}
+static inline simd_vm vm_ge(simd_vd a, simd_vd b) {
+    return _mm512_cmp_ps_mask(a, b, _CMP_GE_OQ);
+}
+static inline simd_vm vm_and(simd_vm a, simd_vm b) {
+    return (simd_vm)(a & b);
+}
+static inline simd_vm vm_or(simd_vm a, simd_vm b) {
+    return (simd_vm)(a | b);
+}
+static inline simd_vm vm_andnot(simd_vm a, simd_vm b) {
+    return (simd_vm)(~a & b);
+}
+static inline simd_vd vd_select(simd_vm m, simd_vd v) {
+    return _mm512_maskz_mov_ps(m, v);
+}
+static inline simd_vd vd_select_not(simd_vm m, simd_vd v) {
+    return _mm512_maskz_mov_ps((simd_vm)~m, v);
+}
+static inline simd_vi vi_set1(int v) {
+    return _mm512_set1_epi32(v);
+}
+static inline simd_vi vi_from_vd(simd_vd v) {
+    return _mm512_cvttps_epi32(v);
+}
+static inline simd_vi vi_add(simd_vi a, simd_vi b) {
+    return _mm512_add_epi32(a, b);
+}
+static inline simd_vi vi_sub(simd_vi a, simd_vi b) {
+    return _mm512_sub_epi32(a, b);
+}
+static inline simd_vi vi_mul(simd_vi a, simd_vi b) {
+    return _mm512_mullo_epi32(a, b);
+}
+static inline simd_vi vi_and(simd_vi a, simd_vi b) {
+    return _mm512_and_si512(a, b);
+}
+static inline simd_vi vi_xor(simd_vi a, simd_vi b) {
+    return _mm512_xor_si512(a, b);
+}
+#define vi_srli(a, imm) _mm512_srli_epi32((a), (imm))
+static inline simd_vi vi_gather_u8(const uint8_t* table, simd_vi idx) {
+    return _mm512_and_si512(_mm512_i32gather_epi32(idx, table, 1), _mm512_set1_epi32(0xff));
+}
+static inline simd_vd vd_gather(const float* table, simd_vi idx) {
+    return _mm512_i32gather_ps(idx, table, 4);
+}
+
+/* ===== SSE4.1: 4 x float ===== */
+#elif defined(SIMPLEX_OPS_SSE41)
+#include <smmintrin.h>
+
+#define SIMD_LANES 4
+#define SIMD_SUFFIX(name) name##_f32_sse41
+#define SIMD_ISA_NAME "sse4.1"
+#define SIMD_LEVEL SIMPLEX_SIMD_SSE41
+
+typedef __m128 simd_vd;
+typedef __m128 simd_vm;
+typedef __m128i simd_vi;
+
+static inline simd_vd vd_set1(float v) {
+    return _mm_set1_ps(v);
+}
+static inline simd_vd vd_iota(void) {
+    return _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+}
+static inline simd_vd vd_loadu(const float* p) {
+    return _mm_loadu_ps(p);
+}
+static inline void vd_storeu(float* p, simd_vd v) {
+    _mm_storeu_ps(p, v);
+}
+static inline simd_vd vd_add(simd_vd a, simd_vd b) {
+    return _mm_add_ps(a, b);
+}
+static inline simd_vd vd_sub(simd_vd a, simd_vd b) {
+    return _mm_sub_ps(a, b);
+}
+static inline simd_vd vd_mul(simd_vd a, simd_vd b) {
+    return _mm_mul_ps(a, b);
+}
+static inline simd_vd vd_trunc(simd_vd v) {
+    return _mm_round_ps(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+}
+static inline simd_vm vm_gt(simd_vd a, simd_vd b) {
+    return _mm_cmpgt_ps(a, b);
+}
+static inline simd_vm vm_ge(simd_vd a, simd_vd b) {
+    return _mm_cmpge_ps(a, b);
+}
+static inline simd_vm vm_and(simd_vm a, simd_vm b) {
+    return _mm_and_ps(a, b);
+}
+static inline simd_vm vm_or(simd_vm a, simd_vm b) {
+    return _mm_or_ps(a, b);
+}
+static inline simd_vm vm_andnot(simd_vm a, simd_vm b) {
+    return _mm_andnot_ps(a, b);
+}
+static inline simd_vd vd_select(simd_vm m, simd_vd v) {
+    return _mm_and_ps(m, v);
+}
+static inline simd_vd vd_select_not(simd_vm m, simd_vd v) {
+    return _mm_andnot_ps(m, v);
+}
+static inline simd_vi vi_set1(int v) {
+    return _mm_set1_epi32(v);
+}
+static inline simd_vi vi_from_vd(simd_vd v) {
+    return _mm_cvttps_epi32(v);
+}
+static inline simd_vi vi_add(simd_vi a, simd_vi b) {
+    return _mm_add_epi32(a, b);
+}
+static inline simd_vi vi_sub(simd_vi a, simd_vi b) {
+    return _mm_sub_epi32(a, b);
+}
+static inline simd_vi vi_mul(simd_vi a, simd_vi b) {
+    return _mm_mullo_epi32(a, b);
+}
+static inline simd_vi vi_and(simd_vi a, simd_vi b) {
+    return _mm_and_si128(a, b);
+}
+static inline simd_vi vi_xor(simd_vi a, simd_vi b) {
+    return _mm_xor_si128(a, b);
+}
+#define vi_srli(a, imm) _mm_srli_epi32((a), (imm))
+static inline simd_vi vi_gather_u8(const uint8_t* table, simd_vi idx) {
+    return _mm_set_epi32(table[_mm_extract_epi32(idx, 3)], table[_mm_extract_epi32(idx, 2)],
+                         table[_mm_extract_epi32(idx, 1)], table[_mm_cvtsi128_si32(idx)]);
+}
+static inline simd_vd vd_gather(const float* table, simd_vi idx) {
+    return _mm_set_ps(table[_mm_extract_epi32(idx, 3)], table[_mm_extract_epi32(idx, 2)],
+                      table[_mm_extract_epi32(idx, 1)], table[_mm_cvtsi128_si32(idx)]);
+}
+
+/* ===== NEON (AArch64): 4 x float ===== */
+#elif defined(SIMPLEX_OPS_NEON)
+#include <arm_neon.h>
+
+#define SIMD_LANES 4
+#define SIMD_SUFFIX(name) name##_f32_neon
+#define SIMD_ISA_NAME "neon"
+#define SIMD_LEVEL SIMPLEX_SIMD_NEON
+
+typedef float32x4_t simd_vd;
+typedef uint32x4_t simd_vm;
+typedef int32x4_t simd_vi;
+
+static inline simd_vd vd_set1(float v) {
+    return vdupq_n_f32(v);
+}
+static inline simd_vd vd_iota(void) {
+    static const float iota[4] = {0.0f, 1.0f, 2.0f, 3.0f};
+    return vld1q_f32(iota);
+}
+static inline simd_vd vd_loadu(const float* p) {
+    return vld1q_f32(p);
+}
+static inline void vd_storeu(float* p, simd_vd v) {
+    vst1q_f32(p, v);
+}
+static inline simd_vd vd_add(simd_vd a, simd_vd b) {
+    return vaddq_f32(a, b);
+}
+static inline simd_vd vd_sub(simd_vd a, simd_vd b) {
+    return vsubq_f32(a, b);
+}
+static inline simd_vd vd_mul(simd_vd a, simd_vd b) {
+    return vmulq_f32(a, b);
+}
+static inline simd_vd vd_trunc(simd_vd v) {
+    return vrndq_f32(v);
+}
+static inline simd_vm vm_gt(simd_vd a, simd_vd b) {
+    return vcgtq_f32(a, b);
+}
+static inline simd_vm vm_ge(simd_vd a, simd_vd b) {
+    return vcgeq_f32(a, b);
+}
+static inline simd_vm vm_and(simd_vm a, simd_vm b) {
+    return vandq_u32(a, b);
+}
+static inline simd_vm vm_or(simd_vm a, simd_vm b) {
+    return vorrq_u32(a, b);
+}
+static inline simd_vm vm_andnot(simd_vm a, simd_vm b) {
+    return vbicq_u32(b, a);
+}
+static inline simd_vd vd_select(simd_vm m, simd_vd v) {
+    return vreinterpretq_f32_u32(vandq_u32(m, vreinterpretq_u32_f32(v)));
+}
+static inline simd_vd vd_select_not(simd_vm m, simd_vd v) {
+    return vreinterpretq_f32_u32(vbicq_u32(vreinterpretq_u32_f32(v), m));
+}
+static inline simd_vi vi_set1(int v) {
+    return vdupq_n_s32(v);
+}
+static inline simd_vi vi_from_vd(simd_vd v) {
+    return vcvtq_s32_f32(v);
+}
+static inline simd_vi vi_add(simd_vi a, simd_vi b) {
+    return vaddq_s32(a, b);
+}
+static inline simd_vi vi_sub(simd_vi a, simd_vi b) {
+    return vsubq_s32(a, b);
+}
+static inline simd_vi vi_mul(simd_vi a, simd_vi b) {
+    return vmulq_s32(a, b);
+}
+static inline simd_vi vi_and(simd_vi a, simd_vi b) {
+    return vandq_s32(a, b);
+}
+static inline simd_vi vi_xor(simd_vi a, simd_vi b) {
+    return veorq_s32(a, b);
+}
+#define vi_srli(a, imm) vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(a), (imm)))
+static inline simd_vi vi_gather_u8(const uint8_t* table, simd_vi idx) {
+    int32x4_t r = vdupq_n_s32(table[vgetq_lane_s32(idx, 0)]);
+    r = vsetq_lane_s32(table[vgetq_lane_s32(idx, 1)], r, 1);
+    r = vsetq_lane_s32(table[vgetq_lane_s32(idx, 2)], r, 2);
+    return vsetq_lane_s32(table[vgetq_lane_s32(idx, 3)], r, 3);
+}
+static inline simd_vd vd_gather(const float* table, simd_vi idx) {
+    float32x4_t r = vdupq_n_f32(table[vgetq_lane_s32(idx, 0)]);
+    r = vsetq_lane_f32(table[vgetq_lane_s32(idx, 1)], r, 1);
+    r = vsetq_lane_f32(table[vgetq_lane_s32(idx, 2)], r, 2);
+    return vsetq_lane_f32(table[vgetq_lane_s32(idx, 3)], r, 3);
+}
+
+/* ===== Scalar: 1 x float ===== */
+#elif defined(SIMPLEX_OPS_SCALAR)
+#include <math.h>
+
+#define SIMD_LANES 1
+#define SIMD_SUFFIX(name) name##_f32_scalar
+#define SIMD_ISA_NAME "scalar"
+#define SIMD_LEVEL SIMPLEX_SIMD_SCALAR
+
+typedef float simd_vd;
+typedef int simd_vm;
+typedef int simd_vi;
+
+static inline simd_vd vd_set1(float v) {
+    return v;
+}
+static inline simd_vd vd_iota(void) {
+    return 0.0f;
+}
+static inline simd_vd vd_loadu(const float* p) {
+    return *p;
+}
+static inline void vd_storeu(float* p, simd_vd v) {
+    *p = v;
+}
+static inline simd_vd vd_add(simd_vd a, simd_vd b) {
+    return a + b;
+}
+static inline simd_vd vd_sub(simd_vd a, simd_vd b) {
+    return a - b;
+}
+static inline simd_vd vd_mul(simd_vd a, simd_vd b) {
+    return a * b;
+}
+static inline simd_vd vd_trunc(simd_vd v) {
+    return truncf(v);
+}
+static inline simd_vm vm_gt(simd_vd a, simd_vd b) {
+    return a > b;
+}
+static inline simd_vm vm_ge(simd_vd a, simd_vd b) {
+    return a >= b;
+}
+static inline simd_vm vm_and(simd_vm a, simd_vm b) {
+    return a && b;
+}
+static inline simd_vm vm_or(simd_vm a, simd_vm b) {
+    return a || b;
+}
+static inline simd_vm vm_andnot(simd_vm a, simd_vm b) {
+    return !a && b;
+}
+static inline simd_vd vd_select(simd_vm m, simd_vd v) {
+    return m ? v : 0.0f;
+}
+static inline simd_vd vd_select_not(simd_vm m, simd_vd v) {
+    return m ? 0.0f : v;
+}
+static inline simd_vi vi_set1(int v) {
+    return v;
+}
+static inline simd_vi vi_from_vd(simd_vd v) {
+    return (int)v;
+}
+static inline simd_vi vi_add(simd_vi a, simd_vi b) {
+    return a + b;
+}
+static inline simd_vi vi_sub(simd_vi a, simd_vi b) {
+    return a - b;
+}
+// Wraps modulo 2^32 like the vector multiplies
+static inline simd_vi vi_mul(simd_vi a, simd_vi b) {
+    return (int)((unsigned int)a * (unsigned int)b);
+}
+static inline simd_vi vi_and(simd_vi a, simd_vi b) {
+    return a & b;
+}
+static inline simd_vi vi_xor(simd_vi a, simd_vi b) {
+    return a ^ b;
+}
+#define vi_srli(a, imm) ((int)((unsigned int)(a) >> (imm)))
+static inline simd_vi vi_gather_u8(const uint8_t* table, simd_vi idx) {
+    return table[idx];
+}
+static inline simd_vd vd_gather(const float* table, simd_vi idx) {
+    return table[idx];
+}
+
+#else
+#error "simplex_simd_ops_f32.h: no SIMD back-end selected"
+#endif
+
+#endif /* SIMPLEX_SIMD_OPS_F32_H */
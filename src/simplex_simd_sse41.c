@@ -0,0 +1,17 @@
+/**
+ * @file simplex_simd_sse41.c
+ * @brief SSE4.1 instantiation of the vectorized noise kernels
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @details Only this file is compiled with -msse4.1; simplex_simd.c hands the table
+ *          out only after cpuid confirms the running CPU supports SSE4.1.
+ *
+ * @author Adrian Paredez
+ * @version 2.0.0
+ * @date 9/5/2025
+ */
+
+#define SIMPLEX_OPS_SSE41
+#include "simplex_simd_kernels.h"
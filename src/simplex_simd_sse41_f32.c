@@ -0,0 +1,18 @@
+/**
+ * @file simplex_simd_sse41_f32.c
+ * @brief SSE4.1 instantiation of the float32 noise kernels
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @details Compiled with the same flags as simplex_simd_sse41.c and handed out
+ *          under the same cpuid check.
+ *
+ * @author Adrian Paredez
+ * @version 2.0.0
+ * @date 9/5/2025
+ */
+
+#define SIMPLEX_OPS_SSE41
+#define SIMPLEX_OPS_F32
+#include "simplex_simd_kernels.h"
@@ -0,0 +1,559 @@
+/**
+ * @file simplex_thread.c
+ * @brief Built-in work-stealing thread pool for the bulk array functions
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @details Worker threads are started lazily the first time a loop asks for
+ *          them and are reused afterwards. A loop over [0, count) is cut into
+ *          chunks of `grain` items; each participant (the caller plus up to
+ *          max_threads - 1 workers) starts with an equal contiguous run of
+ *          chunks, takes chunks from the front of its own run, and once it is
+ *          empty steals the back half of another participant's run. Output is
+ *          identical for any thread count because every chunk writes its own
+ *          items only.
+ *
+ *          Asynchronous jobs are queued by priority for a separate pair of
+ *          runner threads, which call the blocking functions and so drive the
+ *          pool like any other caller.
+ *
+ * @author Adrian Paredez
+ * @version 2.0.0
+ * @date 9/5/2025
+ */
+
+#include "simplex_internal.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+/* ===== PLATFORM THREADS ===== */
+
+#if defined(_WIN32)
+#include <windows.h>
+
+typedef HANDLE pool_thread_t;
+typedef SRWLOCK pool_mutex_t;
+typedef CONDITION_VARIABLE pool_cond_t;
+#define POOL_MUTEX_INIT SRWLOCK_INIT
+#define POOL_COND_INIT CONDITION_VARIABLE_INIT
+
+static void mutex_init(pool_mutex_t* m) {
+    InitializeSRWLock(m);
+}
+static void mutex_lock(pool_mutex_t* m) {
+    AcquireSRWLockExclusive(m);
+}
+static int mutex_trylock(pool_mutex_t* m) {
+    return TryAcquireSRWLockExclusive(m) ? 1 : 0;
+}
+static void mutex_unlock(pool_mutex_t* m) {
+    ReleaseSRWLockExclusive(m);
+}
+static void cond_wait(pool_cond_t* c, pool_mutex_t* m) {
+    SleepConditionVariableSRW(c, m, INFINITE, 0);
+}
+static void cond_broadcast(pool_cond_t* c) {
+    WakeAllConditionVariable(c);
+}
+static void cond_signal(pool_cond_t* c) {
+    WakeConditionVariable(c);
+}
+
+typedef LPTHREAD_START_ROUTINE pool_entry_t;
+
+static DWORD WINAPI worker_entry(LPVOID param);
+static DWORD WINAPI runner_entry(LPVOID param);
+
+static int thread_start(pool_thread_t* thread, pool_entry_t entry, int index) {
+    *thread = CreateThread(NULL, 0, entry, (LPVOID)(intptr_t)index, 0, NULL);
+    return *thread ? 0 : -1;
+}
+static void thread_join(pool_thread_t thread) {
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+#else
+#include <pthread.h>
+
+typedef pthread_t pool_thread_t;
+typedef pthread_mutex_t pool_mutex_t;
+typedef pthread_cond_t pool_cond_t;
+#define POOL_MUTEX_INIT PTHREAD_MUTEX_INITIALIZER
+#define POOL_COND_INIT PTHREAD_COND_INITIALIZER
+
+static void mutex_init(pool_mutex_t* m) {
+    pthread_mutex_init(m, NULL);
+}
+static void mutex_lock(pool_mutex_t* m) {
+    pthread_mutex_lock(m);
+}
+static int mutex_trylock(pool_mutex_t* m) {
+    return pthread_mutex_trylock(m) == 0;
+}
+static void mutex_unlock(pool_mutex_t* m) {
+    pthread_mutex_unlock(m);
+}
+static void cond_wait(pool_cond_t* c, pool_mutex_t* m) {
+    pthread_cond_wait(c, m);
+}
+static void cond_broadcast(pool_cond_t* c) {
+    pthread_cond_broadcast(c);
+}
+static void cond_signal(pool_cond_t* c) {
+    pthread_cond_signal(c);
+}
+
+typedef void* (*pool_entry_t)(void*);
+
+static void* worker_entry(void* param);
+static void* runner_entry(void* param);
+
+static int thread_start(pool_thread_t* thread, pool_entry_t entry, int index) {
+    return pthread_create(thread, NULL, entry, (void*)(intptr_t)index) == 0 ? 0 : -1;
+}
+static void thread_join(pool_thread_t thread) {
+    pthread_join(thread, NULL);
+}
+#endif
+
+/* ===== LOCKS ===== */
+
+struct simplex_lock {
+    pool_mutex_t mutex;
+};
+
+simplex_lock_t* simplex_lock_create(void) {
+    simplex_lock_t* lock = malloc(sizeof(*lock));
+    if (lock) {
+        mutex_init(&lock->mutex);
+    }
+    return lock;
+}
+
+void simplex_lock_destroy(simplex_lock_t* lock) {
+#if !defined(_WIN32)
+    if (lock) {
+        pthread_mutex_destroy(&lock->mutex);
+    }
+#endif
+    free(lock);
+}
+
+void simplex_lock_acquire(simplex_lock_t* lock) {
+    mutex_lock(&lock->mutex);
+}
+
+void simplex_lock_release(simplex_lock_t* lock) {
+    mutex_unlock(&lock->mutex);
+}
+
+/* ===== POOL STATE ===== */
+
+enum { POOL_MAX_PARTICIPANTS = SIMPLEX_MAX_THREADS };
+
+// Run of chunk indices [next, end) still owned by one participant
+typedef struct {
+    pool_mutex_t lock;
+    int next;
+    int end;
+} pool_slot_t;
+
+static struct {
+    pool_mutex_t submit; /* Held by the caller driving the current loop */
+    pool_mutex_t lock;   /* Guards the fields below (slots have their own locks) */
+    pool_cond_t wake;
+    pool_cond_t done;
+
+    pool_thread_t threads[POOL_MAX_PARTICIPANTS];
+    unsigned int start_generation[POOL_MAX_PARTICIPANTS]; /* Loop count when started */
+    int worker_count;
+    int slots_ready;
+    int shutting_down;
+    unsigned int generation;
+
+    /* Current loop */
+    simplex_range_fn fn;
+    void* arg;
+    int count;
+    int grain;
+    int participants;
+    int pending;
+    pool_slot_t slots[POOL_MAX_PARTICIPANTS];
+} pool = {.submit = POOL_MUTEX_INIT,
+          .lock = POOL_MUTEX_INIT,
+          .wake = POOL_COND_INIT,
+          .done = POOL_COND_INIT};
+
+/* ===== WORK STEALING ===== */
+
+// Move the back half of another participant's run into `self`'s empty slot
+static int steal_chunks(int self) {
+    for (int offset = 1; offset < pool.participants; offset++) {
+        pool_slot_t* victim = &pool.slots[(self + offset) % pool.participants];
+
+        mutex_lock(&victim->lock);
+        int remaining = victim->end - victim->next;
+        if (remaining <= 0) {
+            mutex_unlock(&victim->lock);
+            continue;
+        }
+        int stolen_end = victim->end;
+        victim->end -= (remaining + 1) / 2;
+        int stolen_begin = victim->end;
+        mutex_unlock(&victim->lock);
+
+        mutex_lock(&pool.slots[self].lock);
+        pool.slots[self].next = stolen_begin;
+        pool.slots[self].end = stolen_end;
+        mutex_unlock(&pool.slots[self].lock);
+        return 1;
+    }
+    return 0;
+}
+
+static void run_participant(int self) {
+    pool_slot_t* slot = &pool.slots[self];
+
+    for (;;) {
+        mutex_lock(&slot->lock);
+        int chunk = slot->next < slot->end ? slot->next++ : -1;
+        mutex_unlock(&slot->lock);
+
+        if (chunk < 0) {
+            if (!steal_chunks(self)) {
+                return;
+            }
+            continue;
+        }
+
+        int begin = chunk * pool.grain;
+        int end = begin + pool.grain < pool.count ? begin + pool.grain : pool.count;
+        pool.fn(pool.arg, begin, end);
+    }
+}
+
+static void worker_main(int index) {
+#if defined(SIMPLEX_ENABLE_PROFILING)
+    // Work done here belongs to the profiled call that started the loop
+    simplex_profile_mark_worker();
+#endif
+    mutex_lock(&pool.lock);
+    unsigned int seen = pool.start_generation[index];
+    for (;;) {
+        while (!pool.shutting_down && pool.generation == seen) {
+            cond_wait(&pool.wake, &pool.lock);
+        }
+        if (pool.shutting_down) {
+            break;
+        }
+        seen = pool.generation;
+        if (index >= pool.participants) {
+            continue;
+        }
+
+        mutex_unlock(&pool.lock);
+        run_participant(index);
+        mutex_lock(&pool.lock);
+
+        if (--pool.pending == 0) {
+            cond_signal(&pool.done);
+        }
+    }
+    mutex_unlock(&pool.lock);
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI worker_entry(LPVOID param) {
+    worker_main((int)(intptr_t)param);
+    return 0;
+}
+#else
+static void* worker_entry(void* param) {
+    worker_main((int)(intptr_t)param);
+    return NULL;
+}
+#endif
+
+/* ===== PARALLEL LOOPS ===== */
+
+void simplex_parallel_for(int count, int grain, int max_threads, simplex_range_fn fn, void* arg) {
+    if (count <= 0) {
+        return;
+    }
+    if (grain < 1) {
+        grain = 1;
+    }
+    int chunks = (count / grain) + (count % grain != 0);
+    int participants = max_threads < chunks ? max_threads : chunks;
+    if (participants > POOL_MAX_PARTICIPANTS) {
+        participants = POOL_MAX_PARTICIPANTS;
+    }
+
+    // Nested or concurrent loops run inline instead of waiting for the pool
+    if (participants <= 1 || !mutex_trylock(&pool.submit)) {
+        fn(arg, 0, count);
+        return;
+    }
+
+    if (!pool.slots_ready) {
+        for (int i = 0; i < POOL_MAX_PARTICIPANTS; i++) {
+            mutex_init(&pool.slots[i].lock);
+        }
+        pool.slots_ready = 1;
+    }
+
+    // Worker i serves participant slot i; slot 0 is the caller
+    while (pool.worker_count < participants - 1) {
+        int index = pool.worker_count + 1;
+        pool.start_generation[index] = pool.generation;
+        if (thread_start(&pool.threads[pool.worker_count], worker_entry, index) != 0) {
+            break;
+        }
+        pool.worker_count++;
+    }
+    if (participants > pool.worker_count + 1) {
+        participants = pool.worker_count + 1;
+    }
+
+    for (int i = 0; i < participants; i++) {
+        pool.slots[i].next = (int)(((long long)chunks * i) / participants);
+        pool.slots[i].end = (int)(((long long)chunks * (i + 1)) / participants);
+    }
+
+    mutex_lock(&pool.lock);
+    pool.fn = fn;
+    pool.arg = arg;
+    pool.count = count;
+    pool.grain = grain;
+    pool.participants = participants;
+    pool.pending = participants - 1;
+    pool.generation++;
+    cond_broadcast(&pool.wake);
+    mutex_unlock(&pool.lock);
+
+    run_participant(0);
+
+    mutex_lock(&pool.lock);
+    while (pool.pending > 0) {
+        cond_wait(&pool.done, &pool.lock);
+    }
+    mutex_unlock(&pool.lock);
+
+    mutex_unlock(&pool.submit);
+}
+
+void simplex_thread_pool_shutdown(void) {
+    mutex_lock(&pool.submit);
+
+    mutex_lock(&pool.lock);
+    pool.shutting_down = 1;
+    cond_broadcast(&pool.wake);
+    mutex_unlock(&pool.lock);
+
+    for (int i = 0; i < pool.worker_count; i++) {
+        thread_join(pool.threads[i]);
+    }
+
+    mutex_lock(&pool.lock);
+    pool.worker_count = 0;
+    pool.shutting_down = 0;
+    mutex_unlock(&pool.lock);
+
+    mutex_unlock(&pool.submit);
+}
+
+/* ===== BACKGROUND TASKS ===== */
+
+/* Runner 0 takes any task and runner 1 only top-priority ones, so a
+ * top-priority task starts at once even while a long task is running */
+enum { TASK_RUNNER_COUNT = 2, TASK_TOP_PRIORITY = SIMPLEX_JOB_PRIORITY_COUNT - 1 };
+
+static struct {
+    pool_mutex_t lock; /* Guards the queues, the runners and every task's state and refs */
+    pool_cond_t wake;  /* Tasks queued or runners shutting down */
+    pool_cond_t done;  /* A task finished */
+
+    simplex_task_t* heads[SIMPLEX_JOB_PRIORITY_COUNT];
+    simplex_task_t* tails[SIMPLEX_JOB_PRIORITY_COUNT];
+    pool_thread_t threads[TASK_RUNNER_COUNT];
+    int runner_count;
+    int shutting_down;
+} tasks = {.lock = POOL_MUTEX_INIT, .wake = POOL_COND_INIT, .done = POOL_COND_INIT};
+
+// Pop the oldest task of the highest priority at or above `lowest`, NULL if none
+static simplex_task_t* take_task(int lowest) {
+    for (int priority = TASK_TOP_PRIORITY; priority >= lowest; priority--) {
+        simplex_task_t* task = tasks.heads[priority];
+        if (task) {
+            tasks.heads[priority] = task->next;
+            if (!task->next) {
+                tasks.tails[priority] = NULL;
+            }
+            task->next = NULL;
+            return task;
+        }
+    }
+    return NULL;
+}
+
+// Remove a queued task from its queue; 0 if it was not queued
+static int unlink_task(simplex_task_t* task) {
+    simplex_task_t** link = &tasks.heads[task->priority];
+    simplex_task_t* previous = NULL;
+    while (*link && *link != task) {
+        previous = *link;
+        link = &previous->next;
+    }
+    if (!*link) {
+        return 0;
+    }
+    *link = task->next;
+    if (tasks.tails[task->priority] == task) {
+        tasks.tails[task->priority] = previous;
+    }
+    task->next = NULL;
+    return 1;
+}
+
+// Record a task's outcome, wake its waiters and drop the queue's reference; needs tasks.lock
+static void finish_task(simplex_task_t* task, simplex_task_state_t state, int result) {
+    task->state = state;
+    task->result = result;
+    cond_broadcast(&tasks.done);
+    if (--task->refs == 0) {
+        task->destroy(task);
+    }
+}
+
+static void runner_main(int index) {
+    int lowest = index == 0 ? 0 : TASK_TOP_PRIORITY;
+    mutex_lock(&tasks.lock);
+    for (;;) {
+        simplex_task_t* task = NULL;
+        while (!tasks.shutting_down && !(task = take_task(lowest))) {
+            cond_wait(&tasks.wake, &tasks.lock);
+        }
+        if (!task) {
+            break;
+        }
+        task->state = SIMPLEX_TASK_RUNNING;
+        mutex_unlock(&tasks.lock);
+        int result = task->run(task, 0);
+        mutex_lock(&tasks.lock);
+        finish_task(task, SIMPLEX_TASK_FINISHED, result);
+    }
+    mutex_unlock(&tasks.lock);
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI runner_entry(LPVOID param) {
+    runner_main((int)(intptr_t)param);
+    return 0;
+}
+#else
+static void* runner_entry(void* param) {
+    runner_main((int)(intptr_t)param);
+    return NULL;
+}
+#endif
+
+int simplex_task_submit(simplex_task_t* task) {
+    mutex_lock(&tasks.lock);
+    while (!tasks.shutting_down && tasks.runner_count < TASK_RUNNER_COUNT) {
+        int index = tasks.runner_count;
+        if (thread_start(&tasks.threads[index], runner_entry, index) != 0) {
+            break;
+        }
+        tasks.runner_count++;
+    }
+    // Without runner 0 only top-priority tasks would ever run
+    if (tasks.shutting_down || tasks.runner_count == 0) {
+        mutex_unlock(&tasks.lock);
+        return -1;
+    }
+    task->next = NULL;
+    task->state = SIMPLEX_TASK_QUEUED;
+    if (tasks.tails[task->priority]) {
+        tasks.tails[task->priority]->next = task;
+    } else {
+        tasks.heads[task->priority] = task;
+    }
+    tasks.tails[task->priority] = task;
+    cond_broadcast(&tasks.wake);
+    mutex_unlock(&tasks.lock);
+    return 0;
+}
+
+int simplex_task_cancel(simplex_task_t* task) {
+    mutex_lock(&tasks.lock);
+    int queued = task->state == SIMPLEX_TASK_QUEUED && unlink_task(task);
+    mutex_unlock(&tasks.lock);
+    if (!queued) {
+        return -1;
+    }
+    int result = task->run(task, 1);
+    mutex_lock(&tasks.lock);
+    finish_task(task, SIMPLEX_TASK_CANCELLED, result);
+    mutex_unlock(&tasks.lock);
+    return 0;
+}
+
+simplex_task_state_t simplex_task_state(simplex_task_t* task, int* result) {
+    mutex_lock(&tasks.lock);
+    simplex_task_state_t state = task->state;
+    *result = task->result;
+    mutex_unlock(&tasks.lock);
+    return state;
+}
+
+simplex_task_state_t simplex_task_wait(simplex_task_t* task, int* result) {
+    mutex_lock(&tasks.lock);
+    while (task->state < SIMPLEX_TASK_FINISHED) {
+        cond_wait(&tasks.done, &tasks.lock);
+    }
+    simplex_task_state_t state = task->state;
+    *result = task->result;
+    mutex_unlock(&tasks.lock);
+    return state;
+}
+
+void simplex_task_release(simplex_task_t* task) {
+    mutex_lock(&tasks.lock);
+    if (--task->refs == 0) {
+        task->destroy(task);
+    }
+    mutex_unlock(&tasks.lock);
+}
+
+void simplex_task_runners_shutdown(void) {
+    simplex_task_t* cancelled = NULL;
+    simplex_task_t** tail = &cancelled;
+    mutex_lock(&tasks.lock);
+    tasks.shutting_down = 1;
+    for (simplex_task_t* task = take_task(0); task; task = take_task(0)) {
+        *tail = task;
+        tail = &task->next;
+    }
+    cond_broadcast(&tasks.wake);
+    mutex_unlock(&tasks.lock);
+
+    // Queued tasks are reported cancelled, in priority order
+    while (cancelled) {
+        simplex_task_t* task = cancelled;
+        cancelled = task->next;
+        task->next = NULL;
+        int result = task->run(task, 1);
+        mutex_lock(&tasks.lock);
+        finish_task(task, SIMPLEX_TASK_CANCELLED, result);
+        mutex_unlock(&tasks.lock);
+    }
+    for (int i = 0; i < tasks.runner_count; i++) {
+        thread_join(tasks.threads[i]);
+    }
+
+    mutex_lock(&tasks.lock);
+    tasks.runner_count = 0;
+    tasks.shutting_down = 0;
+    mutex_unlock(&tasks.lock);
+}
@@ -0,0 +1,580 @@
+/**
+ * @file simplex_volume.c
+ * @brief Memory-mapped 3D noise volume files
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @details Volumes are written straight into a mapping of the output file,
+ *          one slab of z slices at a time, so no more than a slab is ever
+ *          mapped and no double-precision copy of the volume exists. Rows
+ *          of a slab are generated in parallel on the thread pool; every row
+ *          writes its own samples only, so files are identical for any
+ *          thread count and memory limit. Reading maps the whole file
+ *          read-only and hands out a pointer to the samples.
+ *
+ * @author Adrian Paredez
+ * @version 2.0.0
+ * @date 9/5/2025
+ */
+
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 200112L
+#define _FILE_OFFSET_BITS 64
+#endif
+
+#include "../include/simplex_image.h"
+#include "../include/simplex_noise.h"
+#include "simplex_internal.h"
+#include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/* ===== VOLUME LAYOUT ===== */
+
+static const char volume_magic[8] = {'S', 'X', 'V', 'O', 'L', 'U', 'M', 'E'};
+
+static const uint32_t volume_sample_sizes[SIMPLEX_VOLUME_COUNT] = {
+    4, /* SIMPLEX_VOLUME_FLOAT32 */
+    1, /* SIMPLEX_VOLUME_UINT8 */
+    2  /* SIMPLEX_VOLUME_UINT16 */
+};
+
+// Rows are generated in tiles of VOLUME_TILE_SAMPLES, like image rows
+enum { VOLUME_TILE_SAMPLES = 512, VOLUME_DEFAULT_CHUNK_SIZE = 1024 };
+#define VOLUME_UINT8_MAX 255.0
+#define VOLUME_UINT16_MAX 65535.0
+#define VOLUME_BYTES_PER_MB (1024.0 * 1024.0)
+
+/* ===== PLATFORM FILE MAPPING ===== */
+
+// An open volume file and the alignment its mapping offsets need
+typedef struct {
+#if defined(_WIN32)
+    HANDLE file;
+    HANDLE mapping;
+#else
+    int fd;
+#endif
+    uint64_t granularity;
+} volume_file_t;
+
+#if defined(_WIN32)
+
+static uint64_t map_granularity(void) {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwAllocationGranularity;
+}
+
+// Create (or truncate) filename at exactly size bytes, mapped read-write
+static int file_create(volume_file_t* file, const char* filename, uint64_t size) {
+    file->granularity = map_granularity();
+    file->file = CreateFileA(filename, GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_ALWAYS,
+                             FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file->file == INVALID_HANDLE_VALUE) {
+        return -1;
+    }
+    // Creating a mapping larger than the file extends the file
+    file->mapping = CreateFileMappingA(file->file, NULL, PAGE_READWRITE, (DWORD)(size >> 32),
+                                       (DWORD)size, NULL);
+    if (!file->mapping) {
+        CloseHandle(file->file);
+        return -1;
+    }
+    return 0;
+}
+
+// Open filename for read-only mapping and report its size
+static int file_open(volume_file_t* file, const char* filename, uint64_t* size) {
+    LARGE_INTEGER length;
+    file->granularity = map_granularity();
+    file->file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file->file == INVALID_HANDLE_VALUE) {
+        return -1;
+    }
+    if (!GetFileSizeEx(file->file, &length) || length.QuadPart <= 0) {
+        CloseHandle(file->file);
+        return -1;
+    }
+    *size = (uint64_t)length.QuadPart;
+    file->mapping = CreateFileMappingA(file->file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!file->mapping) {
+        CloseHandle(file->file);
+        return -1;
+    }
+    return 0;
+}
+
+static int map_view(volume_file_t* file, uint64_t offset, size_t length, int writable,
+                    void** base) {
+    *base = MapViewOfFile(file->mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ,
+                          (DWORD)(offset >> 32), (DWORD)offset, length);
+    return *base ? 0 : -1;
+}
+
+static int unmap_view(void* base, size_t length) {
+    (void)length;
+    return UnmapViewOfFile(base) ? 0 : -1;
+}
+
+// Views stay valid after the handles are closed
+static int file_close(volume_file_t* file) {
+    int mapping_closed = CloseHandle(file->mapping);
+    int file_closed = CloseHandle(file->file);
+    return mapping_closed && file_closed ? 0 : -1;
+}
+
+#else
+
+// Create (or truncate) filename at exactly size bytes, mapped read-write
+static int file_create(volume_file_t* file, const char* filename, uint64_t size) {
+    file->granularity = (uint64_t)sysconf(_SC_PAGESIZE);
+    file->fd = open(filename, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (file->fd < 0) {
+        return -1;
+    }
+#if defined(__linux__)
+    // Reserve the blocks now, so a full disk fails here instead of faulting a later store
+    int reserved = posix_fallocate(file->fd, 0, (off_t)size);
+    if (reserved != 0 && reserved != EINVAL && reserved != EOPNOTSUPP) {
+        close(file->fd);
+        return -1;
+    }
+#endif
+    if (ftruncate(file->fd, (off_t)size) != 0) {
+        close(file->fd);
+        return -1;
+    }
+    return 0;
+}
+
+// Open filename for read-only mapping and report its size
+static int file_open(volume_file_t* file, const char* filename, uint64_t* size) {
+    struct stat info;
+    file->granularity = (uint64_t)sysconf(_SC_PAGESIZE);
+    file->fd = open(filename, O_RDONLY);
+    if (file->fd < 0) {
+        return -1;
+    }
+    if (fstat(file->fd, &info) != 0 || info.st_size <= 0) {
+        close(file->fd);
+        return -1;
+    }
+    *size = (uint64_t)info.st_size;
+    return 0;
+}
+
+static int map_view(volume_file_t* file, uint64_t offset, size_t length, int writable,
+                    void** base) {
+    *base = mmap(NULL, length, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED,
+                 file->fd, (off_t)offset);
+    return *base == MAP_FAILED ? -1 : 0;
+}
+
+static int unmap_view(void* base, size_t length) {
+    return munmap(base, length);
+}
+
+// Mappings stay valid after the descriptor is closed
+static int file_close(volume_file_t* file) {
+    return close(file->fd);
+}
+
+#endif
+
+// A mapped window of a volume file; data points at the requested offset inside it
+typedef struct {
+    void* base;
+    size_t length;
+    uint8_t* data;
+} volume_view_t;
+
+// Map [offset, offset + length), starting the mapping at the alignment boundary below offset
+static int map_range(volume_file_t* file, uint64_t offset, size_t length, int writable,
+                     volume_view_t* view) {
+    uint64_t aligned = offset - (offset % file->granularity);
+    size_t lead = (size_t)(offset - aligned);
+    if (length > SIZE_MAX - lead) {
+        return -1;
+    }
+    view->length = length + lead;
+    if (map_view(file, aligned, view->length, writable, &view->base) != 0) {
+        return -1;
+    }
+    view->data = (uint8_t*)view->base + lead;
+    return 0;
+}
+
+/* ===== LITTLE-ENDIAN FIELDS ===== */
+
+static void put_u16(uint8_t* out, uint32_t value) {
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+}
+
+static void put_u32(uint8_t* out, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        out[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+static void put_f64(uint8_t* out, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    for (int i = 0; i < 8; i++) {
+        out[i] = (uint8_t)(bits >> (8 * i));
+    }
+}
+
+static uint32_t get_u32(const uint8_t* in) {
+    return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) |
+           ((uint32_t)in[3] << 24);
+}
+
+static double get_f64(const uint8_t* in) {
+    uint64_t bits = 0;
+    double value;
+    for (int i = 0; i < 8; i++) {
+        bits |= (uint64_t)in[i] << (8 * i);
+    }
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/* ===== HEADER ===== */
+
+// Bytes of sample data, or 0 if the dimensions are invalid or the file could not be addressed
+static uint64_t sample_bytes(uint64_t width, uint64_t height, uint64_t depth,
+                             uint64_t sample_size) {
+    // Dimensions are below 2^32, so a slice's sample count cannot overflow
+    uint64_t slice = width * height;
+    uint64_t limit = (UINT64_MAX / 2) - SIMPLEX_VOLUME_HEADER_SIZE;
+    if (slice == 0 || depth == 0 || slice > limit / (depth * sample_size)) {
+        return 0;
+    }
+    return slice * depth * sample_size;
+}
+
+// Serialize the header of config's volume at the offsets of simplex_volume_header_t
+static void encode_header(uint8_t* out, const simplex_volume_config_t* config) {
+    memset(out, 0, SIMPLEX_VOLUME_HEADER_SIZE);
+    memcpy(out + offsetof(simplex_volume_header_t, magic), volume_magic, sizeof(volume_magic));
+    put_u32(out + offsetof(simplex_volume_header_t, version), SIMPLEX_VOLUME_VERSION);
+    put_u32(out + offsetof(simplex_volume_header_t, header_size), SIMPLEX_VOLUME_HEADER_SIZE);
+    put_u32(out + offsetof(simplex_volume_header_t, width), (uint32_t)config->width);
+    put_u32(out + offsetof(simplex_volume_header_t, height), (uint32_t)config->height);
+    put_u32(out + offsetof(simplex_volume_header_t, depth), (uint32_t)config->depth);
+    put_u32(out + offsetof(simplex_volume_header_t, format), (uint32_t)config->format);
+    put_u32(out + offsetof(simplex_volume_header_t, sample_size),
+            volume_sample_sizes[config->format]);
+    put_u32(out + offsetof(simplex_volume_header_t, seed), config->seed);
+    put_f64(out + offsetof(simplex_volume_header_t, min_value), config->min_value);
+    put_f64(out + offsetof(simplex_volume_header_t, max_value), config->max_value);
+    put_f64(out + offsetof(simplex_volume_header_t, scale), config->scale);
+}
+
+// Parse and validate a header against the size of its file
+static int decode_header(const uint8_t* in, uint64_t file_size, simplex_volume_header_t* header) {
+    memcpy(header->magic, in + offsetof(simplex_volume_header_t, magic), sizeof(header->magic));
+    header->version = get_u32(in + offsetof(simplex_volume_header_t, version));
+    header->header_size = get_u32(in + offsetof(simplex_volume_header_t, header_size));
+    header->width = get_u32(in + offsetof(simplex_volume_header_t, width));
+    header->height = get_u32(in + offsetof(simplex_volume_header_t, height));
+    header->depth = get_u32(in + offsetof(simplex_volume_header_t, depth));
+    header->format = get_u32(in + offsetof(simplex_volume_header_t, format));
+    header->sample_size = get_u32(in + offsetof(simplex_volume_header_t, sample_size));
+    header->seed = get_u32(in + offsetof(simplex_volume_header_t, seed));
+    header->min_value = get_f64(in + offsetof(simplex_volume_header_t, min_value));
+    header->max_value = get_f64(in + offsetof(simplex_volume_header_t, max_value));
+    header->scale = get_f64(in + offsetof(simplex_volume_header_t, scale));
+
+    if (memcmp(header->magic, volume_magic, sizeof(volume_magic)) != 0 ||
+        header->version != SIMPLEX_VOLUME_VERSION ||
+        header->header_size < SIMPLEX_VOLUME_HEADER_SIZE ||
+        header->format >= SIMPLEX_VOLUME_COUNT ||
+        header->sample_size != volume_sample_sizes[header->format]) {
+        return -1;
+    }
+    uint64_t bytes = sample_bytes(header->width, header->height, header->depth,
+                                  header->sample_size);
+    return bytes != 0 && header->header_size <= file_size &&
+                   bytes <= file_size - header->header_size
+               ? 0
+               : -1;
+}
+
+/* ===== SLAB GENERATION ===== */
+
+// One slab of z slices being generated into its mapped window
+typedef struct {
+    const simplex_volume_config_t* config;
+    const simplex_context_t* ctx;
+    uint8_t* data;       /* First sample of slice z0 */
+    int z0;              /* First slice of the slab */
+    double quantization; /* Integer formats: format maximum / (max_value - min_value) */
+} volume_slab_t;
+
+// Store `count` noise samples in the volume's sample format
+static void store_samples(const volume_slab_t* slab, const double* samples, int count,
+                          uint8_t* out) {
+    const simplex_volume_config_t* config = slab->config;
+    if (config->format == SIMPLEX_VOLUME_FLOAT32) {
+        for (int i = 0; i < count; i++) {
+            float value = (float)samples[i];
+            uint32_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            put_u32(out + (4 * (size_t)i), bits);
+        }
+        return;
+    }
+    double maximum = config->format == SIMPLEX_VOLUME_UINT8 ? VOLUME_UINT8_MAX : VOLUME_UINT16_MAX;
+    for (int i = 0; i < count; i++) {
+        double value = (samples[i] - config->min_value) * slab->quantization;
+        value = value < 0.0 ? 0.0 : (value > maximum ? maximum : value);
+        uint32_t sample = (uint32_t)(value + 0.5);
+        if (config->format == SIMPLEX_VOLUME_UINT8) {
+            out[i] = (uint8_t)sample;
+        } else {
+            put_u16(out + (2 * (size_t)i), sample);
+        }
+    }
+}
+
+// Slab rows [begin, end); row r is row r % height of slice z0 + r / height
+static void generate_slab_rows(void* arg, int begin, int end) {
+    const volume_slab_t* slab = arg;
+    const simplex_volume_config_t* config = slab->config;
+    size_t sample_size = volume_sample_sizes[config->format];
+    double scratch[VOLUME_TILE_SAMPLES];
+
+    for (int r = begin; r < end; r++) {
+        int y = r % config->height;
+        int z = slab->z0 + (r / config->height);
+        double y_start = (config->offset_y * config->scale) + (y * config->scale);
+        double z_start = (config->offset_z * config->scale) + (z * config->scale);
+        uint8_t* row = slab->data + ((size_t)r * (size_t)config->width * sample_size);
+        for (int x0 = 0; x0 < config->width; x0 += VOLUME_TILE_SAMPLES) {
+            int count = config->width - x0 < VOLUME_TILE_SAMPLES ? config->width - x0
+                                                                 : VOLUME_TILE_SAMPLES;
+            double x_start = (config->offset_x * config->scale) + (x0 * config->scale);
+            // The configuration was validated, so the array calls cannot fail
+            if (config->octaves > 1) {
+                simplex_fractal_array_3d_ctx(slab->ctx, x_start, y_start, z_start, count, 1, 1,
+                                             config->scale, config->octaves, config->persistence,
+                                             config->lacunarity, scratch);
+            } else {
+                simplex_noise_array_3d_ctx(slab->ctx, x_start, y_start, z_start, count, 1, 1,
+                                           config->scale, scratch);
+            }
+            store_samples(slab, scratch, count, row + ((size_t)x0 * sample_size));
+        }
+    }
+}
+
+// Size the file, fill it slab by slab, then write the header
+static int write_volume(const simplex_volume_config_t* config, const simplex_context_t* ctx,
+                        const simplex_config_t* noise_config, uint64_t file_size) {
+    uint64_t slice_bytes =
+        (uint64_t)config->width * (uint64_t)config->height * volume_sample_sizes[config->format];
+    double limit = noise_config->memory_limit_mb * VOLUME_BYTES_PER_MB;
+    int slices = limit / (double)slice_bytes < config->depth ? (int)(limit / (double)slice_bytes)
+                                                             : config->depth;
+    if (slices < 1) {
+        slices = 1;
+    }
+    if (slices > INT_MAX / config->height) {
+        slices = INT_MAX / config->height;
+    }
+    if (slices < 1 || slice_bytes > SIZE_MAX / (uint64_t)slices) {
+        return -1;
+    }
+    int chunk_size =
+        noise_config->chunk_size > 0 ? noise_config->chunk_size : VOLUME_DEFAULT_CHUNK_SIZE;
+    int rows_per_task = chunk_size / config->width > 1 ? chunk_size / config->width : 1;
+
+    volume_file_t file;
+    if (file_create(&file, config->filename, file_size) != 0) {
+        return -1;
+    }
+    volume_slab_t slab = {config, ctx, NULL, 0, 0.0};
+    double maximum = config->format == SIMPLEX_VOLUME_UINT8 ? VOLUME_UINT8_MAX : VOLUME_UINT16_MAX;
+    slab.quantization = maximum / (config->max_value - config->min_value);
+
+    int result = 0;
+    volume_view_t view;
+    for (int z0 = 0; result == 0 && z0 < config->depth; z0 += slices) {
+        int count = slices < config->depth - z0 ? slices : config->depth - z0;
+        uint64_t offset = SIMPLEX_VOLUME_HEADER_SIZE + ((uint64_t)z0 * slice_bytes);
+        if (map_range(&file, offset, (size_t)(count * slice_bytes), 1, &view) != 0) {
+            result = -1;
+            break;
+        }
+        slab.data = view.data;
+        slab.z0 = z0;
+        simplex_parallel_for(count * config->height, rows_per_task, noise_config->max_threads,
+                             generate_slab_rows, &slab);
+        result = unmap_view(view.base, view.length);
+    }
+
+    // The header goes in last, so only complete volumes carry the magic
+    if (result == 0) {
+        result = map_range(&file, 0, SIMPLEX_VOLUME_HEADER_SIZE, 1, &view);
+        if (result == 0) {
+            encode_header(view.data, config);
+            result = unmap_view(view.base, view.length);
+        }
+    }
+    if (file_close(&file) != 0) {
+        result = -1;
+    }
+    if (result != 0) {
+        remove(config->filename);
+    }
+    return result;
+}
+
+// Clamp an index to [0, size)
+static uint32_t clamp_index(int index, uint32_t size) {
+    if (index < 0) {
+        return 0;
+    }
+    return (uint32_t)index < size ? (uint32_t)index : size - 1;
+}
+
+/* ===== PUBLIC FUNCTIONS ===== */
+
+simplex_volume_config_t simplex_get_default_volume_config(void) {
+    simplex_volume_config_t config = {0};
+    config.width = 256;
+    config.height = 256;
+    config.depth = 256;
+    config.format = SIMPLEX_VOLUME_FLOAT32;
+    config.scale = 0.01;
+    config.octaves = 4;
+    config.persistence = 0.5;
+    config.lacunarity = 2.0;
+    config.min_value = -1.0;
+    config.max_value = 1.0;
+    config.seed = 12345;
+    strncpy(config.filename, "simplex_volume.raw", sizeof(config.filename) - 1);
+    return config;
+}
+
+uint64_t simplex_volume_file_size(const simplex_volume_config_t* config) {
+    if (!config || config->width <= 0 || config->height <= 0 || config->depth <= 0 ||
+        (int)config->format < 0 || config->format >= SIMPLEX_VOLUME_COUNT ||
+        config->octaves < 1 || !(config->max_value > config->min_value)) {
+        return 0;
+    }
+    uint64_t bytes = sample_bytes((uint64_t)config->width, (uint64_t)config->height,
+                                  (uint64_t)config->depth, volume_sample_sizes[config->format]);
+    return bytes ? SIMPLEX_VOLUME_HEADER_SIZE + bytes : 0;
+}
+
+int simplex_generate_volume(const simplex_volume_config_t* config) {
+    simplex_config_t noise_config;
+    uint64_t file_size = simplex_volume_file_size(config);
+    if (file_size == 0 || config->filename[0] == '\0' ||
+        simplex_context_get_config(NULL, &noise_config) != 0) {
+        return -1;
+    }
+
+    // A context of its own keeps the default context's seed
+    noise_config.seed = config->seed;
+    simplex_context_t* ctx = simplex_context_create(&noise_config);
+    if (!ctx) {
+        return -1;
+    }
+    const simplex_context_t* profile_ctx = simplex_context_resolve(NULL);
+    SIMPLEX_PROFILE_BEGIN(profile_ctx);
+    int result = write_volume(config, ctx, &noise_config, file_size);
+    SIMPLEX_PROFILE_END(profile_ctx, SIMPLEX_PROFILE_VOLUME,
+                        result == 0 ? (size_t)config->width * (size_t)config->height *
+                                          (size_t)config->depth
+                                    : 0);
+    simplex_context_destroy(ctx);
+    return result;
+}
+
+int simplex_volume_open(const char* filename, simplex_volume_t* volume) {
+    volume_file_t file;
+    volume_view_t view;
+    uint64_t size = 0;
+    if (!volume) {
+        return -1;
+    }
+    memset(volume, 0, sizeof(*volume));
+    if (!filename || file_open(&file, filename, &size) != 0) {
+        return -1;
+    }
+    int result = size >= SIMPLEX_VOLUME_HEADER_SIZE && size <= SIZE_MAX
+                     ? map_range(&file, 0, (size_t)size, 0, &view)
+                     : -1;
+    file_close(&file);
+    if (result != 0) {
+        return -1;
+    }
+    if (decode_header(view.data, size, &volume->header) != 0) {
+        unmap_view(view.base, view.length);
+        memset(&volume->header, 0, sizeof(volume->header));
+        return -1;
+    }
+    volume->data = view.data + volume->header.header_size;
+    volume->size = (size_t)sample_bytes(volume->header.width, volume->header.height,
+                                        volume->header.depth, volume->header.sample_size);
+    volume->mapping = view.base;
+    volume->mapping_size = view.length;
+    return 0;
+}
+
+void simplex_volume_close(simplex_volume_t* volume) {
+    if (!volume) {
+        return;
+    }
+    if (volume->mapping) {
+        unmap_view(volume->mapping, volume->mapping_size);
+    }
+    memset(volume, 0, sizeof(*volume));
+}
+
+double simplex_volume_sample(const simplex_volume_t* volume, int x, int y, int z) {
+    if (!volume || !volume->data) {
+        return 0.0;
+    }
+    const simplex_volume_header_t* header = &volume->header;
+    size_t index = (((size_t)clamp_index(z, header->depth) * header->height) +
+                    clamp_index(y, header->height)) *
+                       header->width +
+                   clamp_index(x, header->width);
+    const uint8_t* sample = (const uint8_t*)volume->data + (index * header->sample_size);
+    double range = header->max_value - header->min_value;
+
+    switch (header->format) {
+    case SIMPLEX_VOLUME_UINT8:
+        return header->min_value + (sample[0] * range / VOLUME_UINT8_MAX);
+    case SIMPLEX_VOLUME_UINT16:
+        return header->min_value +
+               ((sample[0] | ((uint32_t)sample[1] << 8)) * range / VOLUME_UINT16_MAX);
+    default: {
+        uint32_t bits = get_u32(sample);
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+    }
+}
@@ -0,0 +1,226 @@
+/**
+ * @file test_arena.c
+ * @brief Reusable buffer arena test
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @author Adrian Paredez
+ * @version 1.0
+ * @date 9/5/2025
+ */
+
+#include <simplex_image.h>
+#include <simplex_noise.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test_util.h"
+
+#define WIDTH 96
+#define HEIGHT 40
+#define STEP 0.021
+#define ROOMY_MEMORY_MB 256.0
+// A few rows per band, so band buffers are smaller than the image
+#define BANDED_MEMORY_MB 0.01
+#define SERIES_COUNT 3
+// Larger than a huge page
+#define HUGE_BYTES ((size_t)5 * 1024 * 1024)
+#define HUGE_SIDE 1024
+#define IMAGE_FILE "test_arena_image.ppm"
+
+static int aligned(const void* buffer) {
+    return ((uintptr_t)buffer % SIMPLEX_ARENA_ALIGNMENT) == 0;
+}
+
+// The same bytes from a render into a buffer and into a file
+static int same_render(const simplex_image_config_t* config, const unsigned char* expected,
+                       size_t size) {
+    unsigned char* buffer = malloc(size);
+    unsigned char* file_bytes = NULL;
+    size_t written = 0;
+    int same = buffer && simplex_render_to_buffer(config, buffer, size, &written) == 0 &&
+               written == size && memcmp(buffer, expected, size) == 0 &&
+               simplex_generate_2d_image(config) == 0 &&
+               read_file(config->filename, &file_bytes) == size &&
+               memcmp(file_bytes, expected, size) == 0;
+    remove(config->filename);
+    free(buffer);
+    free(file_bytes);
+    return same;
+}
+
+// Series files with and without an arena are identical
+static int same_series(const simplex_image_config_t* config, simplex_arena_t* arena) {
+    unsigned char* plain[SERIES_COUNT] = {NULL};
+    size_t sizes[SERIES_COUNT] = {0};
+    char name[64];
+    int same = simplex_generate_image_series(config, SERIES_COUNT, NULL, NULL) == 0;
+    for (int i = 0; same && i < SERIES_COUNT; i++) {
+        snprintf(name, sizeof(name), "simplex_series_%d.ppm", i);
+        sizes[i] = read_file(name, &plain[i]);
+        same = sizes[i] > 0;
+    }
+    simplex_image_config_t reused = *config;
+    reused.arena = arena;
+    same = same && simplex_generate_image_series(&reused, SERIES_COUNT, NULL, NULL) == 0;
+    for (int i = 0; i < SERIES_COUNT; i++) {
+        unsigned char* bytes = NULL;
+        snprintf(name, sizeof(name), "simplex_series_%d.ppm", i);
+        same = same && read_file(name, &bytes) == sizes[i] &&
+               memcmp(bytes, plain[i], sizes[i]) == 0;
+        remove(name);
+        free(bytes);
+        free(plain[i]);
+    }
+    return same;
+}
+
+int main(void) {
+    printf("Simplex Noise Buffer Arena Test\n");
+    printf("===============================\n\n");
+
+    // Test 1: Buffers are aligned and reused until a larger one is asked for
+    printf("Test 1: Arena buffers...\n");
+    simplex_arena_t* arena = simplex_arena_create(SIMPLEX_ARENA_DEFAULT);
+    if (!arena || simplex_arena_create(SIMPLEX_ARENA_HUGE_PAGES << 1) != NULL ||
+        simplex_arena_capacity(arena) != 0 || simplex_arena_buffer(arena, 0) != NULL ||
+        simplex_arena_buffer(NULL, 16) != NULL) {
+        printf("✗ Arena creation or validation failed\n\n");
+        return 1;
+    }
+    unsigned char* first = simplex_arena_buffer(arena, 1000);
+    size_t capacity = simplex_arena_capacity(arena);
+    if (!first || !aligned(first) || capacity < 1000) {
+        printf("✗ First buffer invalid\n\n");
+        return 1;
+    }
+    memset(first, 0x5A, 1000);
+    unsigned char* smaller = simplex_arena_buffer(arena, 700);
+    if (smaller != first || simplex_arena_capacity(arena) != capacity || smaller[699] != 0x5A) {
+        printf("✗ Smaller buffer not reused\n\n");
+        return 1;
+    }
+    unsigned char* larger = simplex_arena_buffer(arena, 10000);
+    if (!larger || !aligned(larger) || simplex_arena_capacity(arena) < 10000) {
+        printf("✗ Arena did not grow\n\n");
+        return 1;
+    }
+    memset(larger, 0, 10000);
+    simplex_arena_release(arena);
+    if (simplex_arena_capacity(arena) != 0 || !simplex_arena_buffer(arena, 64)) {
+        printf("✗ Released arena unusable\n\n");
+        return 1;
+    }
+    printf("✓ Buffers aligned, reused and grown on demand\n\n");
+
+    // Test 2: Array output taken from an arena
+    printf("Test 2: Array output in an arena buffer...\n");
+    size_t array_bytes = (size_t)WIDTH * HEIGHT * sizeof(double);
+    double* expected = malloc(array_bytes);
+    double* output = simplex_arena_buffer(arena, array_bytes);
+    if (!expected || !output || !aligned(output) ||
+        simplex_fbm_array_2d(0.5, -1.25, WIDTH, HEIGHT, STEP, 4, 0.5, 2.0, expected) != 0 ||
+        simplex_fbm_array_2d(0.5, -1.25, WIDTH, HEIGHT, STEP, 4, 0.5, 2.0, output) != 0 ||
+        memcmp(expected, output, array_bytes) != 0) {
+        printf("✗ Array differs in an arena buffer\n\n");
+        return 1;
+    }
+    free(expected);
+    printf("✓ Same array in arena storage\n\n");
+
+    // Test 3: Images are identical with an arena, which stops growing after one call
+    printf("Test 3: Images with an arena...\n");
+    simplex_image_config_t config = simplex_get_default_image_config();
+    config.width = WIDTH;
+    config.height = HEIGHT;
+    config.scale = STEP;
+    config.color_mode = SIMPLEX_COLOR_GRAYSCALE16;
+    config.auto_normalize = SIMPLEX_NORMALIZE_EXACT;
+    strncpy(config.filename, IMAGE_FILE, sizeof(config.filename) - 1);
+    double limits[] = {ROOMY_MEMORY_MB, BANDED_MEMORY_MB};
+    for (int l = 0; l < 2; l++) {
+        set_limits(limits[l], 2);
+        for (int mode = SIMPLEX_COLOR_GRAYSCALE; mode < SIMPLEX_COLOR_COUNT; mode++) {
+            simplex_image_config_t image = config;
+            image.color_mode = (simplex_color_mode_t)mode;
+            image.auto_normalize = mode % 2 ? SIMPLEX_NORMALIZE_EXACT : SIMPLEX_NORMALIZE_BOUNDED;
+            size_t size = simplex_image_encoded_size(&image);
+            unsigned char* plain = malloc(size);
+            if (!plain || simplex_render_to_buffer(&image, plain, size, NULL) != 0) {
+                printf("✗ Plain render failed\n\n");
+                return 1;
+            }
+            image.arena = arena;
+            int same = same_render(&image, plain, size);
+            capacity = simplex_arena_capacity(arena);
+            same = same && same_render(&image, plain, size) &&
+                   simplex_arena_capacity(arena) == capacity;
+            free(plain);
+            if (!same) {
+                printf("✗ Color mode %d differs with an arena or kept growing\n\n", mode);
+                return 1;
+            }
+        }
+    }
+    printf("✓ Same images, no growth on repeated calls\n\n");
+
+    // Test 4: Series and normal maps with an arena
+    printf("Test 4: Series and normal maps...\n");
+    set_limits(ROOMY_MEMORY_MB, 4);
+    unsigned char* plain = NULL;
+    unsigned char* reused = NULL;
+    simplex_image_config_t normals = config;
+    size_t plain_size = 0;
+    if (!same_series(&config, arena) || simplex_generate_normal_map(&normals, 2.0) != 0 ||
+        (plain_size = read_file(IMAGE_FILE, &plain)) == 0) {
+        printf("✗ Series differs with an arena\n\n");
+        return 1;
+    }
+    normals.arena = arena;
+    if (simplex_generate_normal_map(&normals, 2.0) != 0 ||
+        read_file(IMAGE_FILE, &reused) != plain_size || memcmp(plain, reused, plain_size) != 0) {
+        printf("✗ Normal map differs with an arena\n\n");
+        return 1;
+    }
+    remove(IMAGE_FILE);
+    free(plain);
+    free(reused);
+    printf("✓ Same series and normal map\n\n");
+
+    // Test 5: Huge-page arenas hand out aligned, writable blocks
+    printf("Test 5: Huge-page arena...\n");
+    simplex_arena_t* huge = simplex_arena_create(SIMPLEX_ARENA_HUGE_PAGES);
+    unsigned char* block = simplex_arena_buffer(huge, HUGE_BYTES);
+    if (!block || !aligned(block) || simplex_arena_capacity(huge) < HUGE_BYTES) {
+        printf("✗ Huge-page block invalid\n\n");
+        return 1;
+    }
+    memset(block, 0xA5, HUGE_BYTES);
+    simplex_image_config_t large = config;
+    large.width = HUGE_SIDE;
+    large.height = HUGE_SIDE;
+    size_t large_size = simplex_image_encoded_size(&large);
+    plain = malloc(large_size);
+    if (!plain || simplex_render_to_buffer(&large, plain, large_size, NULL) != 0) {
+        printf("✗ Plain render failed\n\n");
+        return 1;
+    }
+    large.arena = huge;
+    if (!same_render(&large, plain, large_size)) {
+        printf("✗ Image differs with a huge-page arena\n\n");
+        return 1;
+    }
+    free(plain);
+    simplex_arena_destroy(huge);
+    simplex_arena_destroy(NULL);
+    printf("✓ Huge-page arena works\n\n");
+
+    simplex_arena_destroy(arena);
+    simplex_cleanup();
+
+    printf("All buffer arena tests passed! ✓\n");
+    return 0;
+}
@@ -0,0 +1,187 @@
+/**
+ * @file test_config_blob.c
+ * @brief Binary configuration blob and precomputed seed table test
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @author Adrian Paredez
+ * @version 1.0
+ * @date 9/5/2025
+ */
+
+#include <simplex_noise.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BLOB_FILE "test_config_blob.bin"
+#define DAMAGED_FILE "test_config_blob_damaged.bin"
+#define WIDTH 64
+#define HEIGHT 48
+#define STEP 0.037
+
+// A configuration with every field moved off its default
+static simplex_config_t custom_config(simplex_prng_type_t prng_type) {
+    simplex_config_t config = simplex_get_default_config();
+    config.prng_type = prng_type;
+    config.seed = 424242;  // NOLINT(readability-magic-numbers)
+    config.octaves = 7;
+    config.persistence = 0.625;
+    config.lacunarity = 1.875;
+    config.cache_size_mb = 3.5;
+    config.max_threads = 3;
+    config.chunk_size = 2048;
+    strncpy(config.output_file, "terrain.ppm", sizeof(config.output_file) - 1);
+    return config;
+}
+
+// Whether two contexts produce the same 2D and 3D fBm grids
+static int same_noise(const simplex_context_t* a, const simplex_context_t* b) {
+    static double first[WIDTH * HEIGHT];
+    static double second[WIDTH * HEIGHT];
+    int same = 1;
+    simplex_fbm_array_2d_ctx(a, -3.0, 1.5, WIDTH, HEIGHT, STEP, 4, 0.5, 2.0, first);
+    simplex_fbm_array_2d_ctx(b, -3.0, 1.5, WIDTH, HEIGHT, STEP, 4, 0.5, 2.0, second);
+    same = same && memcmp(first, second, sizeof(first)) == 0;
+    simplex_noise_array_3d_ctx(a, 0.25, -1.0, 2.0, WIDTH, HEIGHT, 1, STEP, first);
+    simplex_noise_array_3d_ctx(b, 0.25, -1.0, 2.0, WIDTH, HEIGHT, 1, STEP, second);
+    return same && memcmp(first, second, sizeof(first)) == 0;
+}
+
+// Context for `seed` created the usual way, by shuffling
+static int matches_shuffled(const simplex_config_blob_t* blob, simplex_config_t config,
+                            uint32_t seed) {
+    config.seed = seed;
+    simplex_context_t* shuffled = simplex_context_create(&config);
+    simplex_context_t* mapped = simplex_context_create_blob(blob, seed);
+    simplex_config_t resolved;
+    int same = shuffled && mapped && same_noise(shuffled, mapped) &&
+               simplex_context_get_config(mapped, &resolved) == 0 && resolved.seed == seed;
+    simplex_context_destroy(shuffled);
+    simplex_context_destroy(mapped);
+    return same;
+}
+
+// Copy of the blob with one byte changed
+static int write_damaged(size_t offset, unsigned char value) {
+    FILE* in = fopen(BLOB_FILE, "rb");
+    if (!in) {
+        return -1;
+    }
+    unsigned char bytes[16384];  // NOLINT(readability-magic-numbers)
+    size_t size = fread(bytes, 1, sizeof(bytes), in);
+    fclose(in);
+    if (offset >= size) {
+        return -1;
+    }
+    bytes[offset] = value;
+    FILE* out = fopen(DAMAGED_FILE, "wb");
+    if (!out) {
+        return -1;
+    }
+    size_t written = fwrite(bytes, 1, size, out);
+    return fclose(out) == 0 && written == size ? 0 : -1;
+}
+
+int main(void) {
+    printf("Simplex Noise Binary Configuration Test\n");
+    printf("=======================================\n\n");
+
+    // Test 1: Configuration round trip through the binary format
+    printf("Test 1: Binary round trip...\n");
+    simplex_config_t config = custom_config(SIMPLEX_PRG_PCG);
+    simplex_config_t loaded;
+    if (simplex_save_config(BLOB_FILE, SIMPLEX_CONFIG_BINARY, &config) != 0 ||
+        simplex_load_config(BLOB_FILE, SIMPLEX_CONFIG_BINARY, &loaded) != 0 ||
+        loaded.seed != config.seed || loaded.octaves != config.octaves ||
+        loaded.persistence != config.persistence || loaded.lacunarity != config.lacunarity ||
+        loaded.cache_size_mb != config.cache_size_mb || loaded.chunk_size != config.chunk_size ||
+        strcmp(loaded.output_file, config.output_file) != 0) {
+        printf("✗ Binary configuration did not round trip\n\n");
+        return 1;
+    }
+    printf("✓ Every field survives the round trip\n\n");
+
+    // Test 2: Stored tables give the contexts a shuffle would
+    printf("Test 2: Precomputed seed tables...\n");
+    const simplex_prng_type_t prngs[] = {SIMPLEX_PRG_PCG, SIMPLEX_PRG_MERSENNE_TWISTER,
+                                         SIMPLEX_PRG_XORSHIFT, SIMPLEX_PRG_LINEAR_CONGRUENTIAL};
+    const uint32_t seeds[] = {907, 12, 5000, 12, 1};
+    for (size_t p = 0; p < sizeof(prngs) / sizeof(prngs[0]); p++) {
+        config = custom_config(prngs[p]);
+        simplex_config_blob_t* blob = NULL;
+        if (simplex_save_config_binary(BLOB_FILE, &config, seeds, 5) != 0 ||
+            !(blob = simplex_config_blob_open(BLOB_FILE)) ||
+            simplex_config_blob_seed_count(blob) != 4 || simplex_config_blob_seed(blob, 0) != 1 ||
+            simplex_config_blob_seed(blob, 3) != 5000 || simplex_config_blob_seed(blob, 4) != 0 ||
+            simplex_config_blob_config(blob)->prng_type != prngs[p]) {
+            printf("✗ Blob with seeds could not be written or opened\n\n");
+            return 1;
+        }
+        // Stored seeds, a seed without tables, and the configuration's own seed
+        if (!matches_shuffled(blob, config, 12) || !matches_shuffled(blob, config, 5000) ||
+            !matches_shuffled(blob, config, 31337) ||
+            !matches_shuffled(blob, config, config.seed)) {
+            printf("✗ Context from blob differs from a shuffled one (PRNG %d)\n\n", prngs[p]);
+            return 1;
+        }
+        simplex_config_blob_close(blob);
+    }
+    printf("✓ Blob contexts match shuffled contexts for every PRNG\n\n");
+
+    // Test 3: The default context starts from a blob too
+    printf("Test 3: Default context from a blob...\n");
+    simplex_config_blob_t* blob = simplex_config_blob_open(BLOB_FILE);
+    config.seed = 907;  // NOLINT(readability-magic-numbers)
+    simplex_context_t* expected = simplex_context_create(&config);
+    simplex_config_t active;
+    if (!blob || !expected || simplex_noise_init_blob(blob, 907) != 0 ||
+        simplex_context_get_config(NULL, &active) != 0 || active.seed != 907 ||
+        active.octaves != config.octaves || !same_noise(NULL, expected)) {
+        printf("✗ Default context from blob differs\n\n");
+        return 1;
+    }
+    simplex_config_blob_close(blob);
+    // The default context keeps its tables once the blob is unmapped
+    if (!same_noise(NULL, expected)) {
+        printf("✗ Default context changed after closing the blob\n\n");
+        return 1;
+    }
+    simplex_context_destroy(expected);
+    printf("✓ Default context matches\n\n");
+
+    // Test 4: Damaged, foreign and invalid blobs are rejected
+    printf("Test 4: Validation...\n");
+    const uint32_t zero_seed[] = {3, 0};
+    simplex_config_t unused;
+    if (simplex_save_config_binary(BLOB_FILE, &config, zero_seed, 2) != -1 ||
+        simplex_save_config_binary(BLOB_FILE, &config, NULL, 1) != -1 ||
+        simplex_save_config_binary(BLOB_FILE, NULL, NULL, 0) != -1 ||
+        simplex_config_blob_open("missing_config_blob.bin") != NULL ||
+        simplex_load_config("missing_config_blob.bin", SIMPLEX_CONFIG_BINARY, &unused) != -1 ||
+        simplex_context_create_blob(NULL, 1) != NULL || simplex_noise_init_blob(NULL, 1) != -1) {
+        printf("✗ Invalid arguments accepted\n\n");
+        return 1;
+    }
+    if (simplex_save_config_binary(BLOB_FILE, &config, seeds, 5) != 0 ||
+        write_damaged(0, 'X') != 0 || simplex_config_blob_open(DAMAGED_FILE) != NULL ||
+        write_damaged(8, SIMPLEX_CONFIG_BLOB_VERSION + 1) != 0 ||
+        simplex_config_blob_open(DAMAGED_FILE) != NULL) {
+        printf("✗ Damaged header accepted\n\n");
+        return 1;
+    }
+    // A text configuration is not a blob
+    if (simplex_save_config(DAMAGED_FILE, SIMPLEX_CONFIG_INI, &config) != 0 ||
+        simplex_config_blob_open(DAMAGED_FILE) != NULL) {
+        printf("✗ Text configuration accepted as a blob\n\n");
+        return 1;
+    }
+    remove(BLOB_FILE);
+    remove(DAMAGED_FILE);
+    printf("✓ Invalid blobs rejected\n\n");
+
+    simplex_cleanup();
+    printf("All binary configuration tests passed! ✓\n");
+    return 0;
+}
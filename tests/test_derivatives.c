@@ -0,0 +1,231 @@
+/**
+ * @file test_derivatives.c
+ * @brief Analytic-derivative noise and normal map test
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @author Adrian Paredez
+ * @version 1.0
+ * @date 9/5/2025
+ */
+
+#include <math.h>
+#include <simplex_image.h>
+#include <simplex_noise.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SAMPLES 2000
+#define OCTAVES 5
+#define PERSISTENCE 0.5
+#define LACUNARITY 2.0
+// Central differences with this step agree with the analytic gradient to ~1e-6
+#define DELTA 1e-5
+#define TOLERANCE 1e-4
+// One-sided differences this far apart mean a jump, not curvature
+#define JUMP_SLOPE 1.0
+#define WIDTH 40
+#define HEIGHT 24
+#define DEPTH 3
+#define STEP 0.07
+#define NORMAL_FILE "test_normal_map.ppm"
+
+static double coordinate(void) {
+    return ((double)rand() / RAND_MAX * 100.0) - 50.0;
+}
+
+static int close_enough(double analytic, double numeric) {
+    return fabs(analytic - numeric) <= TOLERANCE * (1.0 + fabs(numeric));
+}
+
+/* Compare one 3D gradient component with a central difference: 1 if it matches,
+ * 0 if not, -1 if the difference straddles one of the small jumps 3D noise has
+ * at simplex faces (its 0.6 radius reaches past them), where it cannot match */
+static int difference_3d(double x, double y, double z, int axis, double analytic) {
+    double p[3] = {x, y, z};
+    double center = simplex_noise_3d(x, y, z);
+    p[axis] += DELTA;
+    double forward = (simplex_noise_3d(p[0], p[1], p[2]) - center) / DELTA;
+    p[axis] -= 2 * DELTA;
+    double backward = (center - simplex_noise_3d(p[0], p[1], p[2])) / DELTA;
+    if (fabs(forward - backward) > JUMP_SLOPE) {
+        return -1;
+    }
+    return close_enough(analytic, 0.5 * (forward + backward));
+}
+
+int main(void) {
+    printf("Simplex Noise Derivative Test\n");
+    printf("=============================\n\n");
+    simplex_noise_init(2024);  // NOLINT(readability-magic-numbers)
+    srand(777);                // NOLINT(readability-magic-numbers)
+
+    // Test 1: Values match the plain functions, gradients match finite differences
+    printf("Test 1: Point derivatives...\n");
+    int jumps = 0;
+    for (int i = 0; i < SAMPLES; i++) {
+        double x = coordinate();
+        double y = coordinate();
+        double z = coordinate();
+        double g2[2];
+        double g3[3];
+        double gf[2];
+        double n2 = simplex_noise_2d_deriv(x, y, g2);
+        double n3 = simplex_noise_3d_deriv(x, y, z, g3);
+        double f2 = simplex_fbm_2d_deriv(x, y, OCTAVES, PERSISTENCE, LACUNARITY, gf);
+        if (n2 != simplex_noise_2d(x, y) || n3 != simplex_noise_3d(x, y, z) ||
+            f2 != simplex_fbm_2d(x, y, OCTAVES, PERSISTENCE, LACUNARITY)) {
+            printf("✗ Value differs from the plain function at (%g, %g, %g)\n\n", x, y, z);
+            return 1;
+        }
+        double dx2 =
+            (simplex_noise_2d(x + DELTA, y) - simplex_noise_2d(x - DELTA, y)) / (2 * DELTA);
+        double dy2 =
+            (simplex_noise_2d(x, y + DELTA) - simplex_noise_2d(x, y - DELTA)) / (2 * DELTA);
+        double dxf = (simplex_fbm_2d(x + DELTA, y, OCTAVES, PERSISTENCE, LACUNARITY) -
+                      simplex_fbm_2d(x - DELTA, y, OCTAVES, PERSISTENCE, LACUNARITY)) /
+                     (2 * DELTA);
+        double dyf = (simplex_fbm_2d(x, y + DELTA, OCTAVES, PERSISTENCE, LACUNARITY) -
+                      simplex_fbm_2d(x, y - DELTA, OCTAVES, PERSISTENCE, LACUNARITY)) /
+                     (2 * DELTA);
+        int bad_3d = 0;
+        for (int axis = 0; axis < 3; axis++) {
+            int analytic_matches = difference_3d(x, y, z, axis, g3[axis]);
+            jumps += analytic_matches < 0;
+            bad_3d |= analytic_matches == 0;
+        }
+        if (!close_enough(g2[0], dx2) || !close_enough(g2[1], dy2) || bad_3d ||
+            !close_enough(gf[0], dxf) || !close_enough(gf[1], dyf)) {
+            printf("✗ Gradient differs from finite differences at (%g, %g, %g)\n\n", x, y, z);
+            return 1;
+        }
+    }
+    if (simplex_noise_2d_deriv(1.5, 2.5, NULL) != simplex_noise_2d(1.5, 2.5)) {
+        printf("✗ NULL gradient changed the value\n\n");
+        return 1;
+    }
+    if (jumps > SAMPLES / 100) {
+        printf("✗ %d samples straddle 3D discontinuities\n\n", jumps);
+        return 1;
+    }
+    printf("✓ Values exact, gradients within %g of finite differences\n\n", TOLERANCE);
+
+    // Test 2: Arrays match the point functions on a pooled context
+    printf("Test 2: Derivative arrays...\n");
+    simplex_config_t config = simplex_get_default_config();
+    config.seed = 2024;  // NOLINT(readability-magic-numbers)
+    config.max_threads = 4;
+    config.chunk_size = 1;
+    simplex_context_t* ctx = simplex_context_create(&config);
+    size_t count = (size_t)WIDTH * HEIGHT * DEPTH;
+    double* values = malloc(count * sizeof(double));
+    double* gradient = malloc(3 * count * sizeof(double));
+    if (!ctx || !values || !gradient) {
+        return 1;
+    }
+    for (int kind = 0; kind < 3; kind++) {
+        int status = kind == 0 ? simplex_noise_array_2d_deriv_ctx(ctx, -1.0, 2.0, WIDTH, HEIGHT,
+                                                                  STEP, values, gradient)
+                     : kind == 1 ? simplex_fbm_array_2d_deriv_ctx(ctx, -1.0, 2.0, WIDTH, HEIGHT,
+                                                                  STEP, OCTAVES, PERSISTENCE,
+                                                                  LACUNARITY, values, gradient)
+                                 : simplex_noise_array_3d_deriv_ctx(ctx, -1.0, 2.0, 0.5, WIDTH,
+                                                                    HEIGHT, DEPTH, STEP, values,
+                                                                    gradient);
+        if (status != 0) {
+            printf("✗ Array %d failed\n\n", kind);
+            return 1;
+        }
+        int dims = kind == 2 ? 3 : 2;
+        size_t samples = kind == 2 ? count : (size_t)WIDTH * HEIGHT;
+        for (size_t i = 0; i < samples; i++) {
+            double x = -1.0 + ((double)(i % WIDTH) * STEP);
+            double y = 2.0 + ((double)((i / WIDTH) % HEIGHT) * STEP);
+            double z = 0.5 + ((double)(i / ((size_t)WIDTH * HEIGHT)) * STEP);
+            double g[3] = {0.0, 0.0, 0.0};
+            double value = kind == 0   ? simplex_noise_2d_deriv_ctx(ctx, x, y, g)
+                           : kind == 1 ? simplex_fbm_2d_deriv_ctx(ctx, x, y, OCTAVES, PERSISTENCE,
+                                                                  LACUNARITY, g)
+                                       : simplex_noise_3d_deriv_ctx(ctx, x, y, z, g);
+            for (int d = 0; d < dims; d++) {
+                if (gradient[(i * dims) + d] != g[d]) {
+                    value = NAN;
+                }
+            }
+            if (values[i] != value) {
+                printf("✗ Array %d differs at sample %zu\n\n", kind, i);
+                return 1;
+            }
+        }
+    }
+    if (simplex_noise_array_2d_deriv_ctx(ctx, 0.0, 0.0, WIDTH, HEIGHT, STEP, NULL, gradient) !=
+            0 ||
+        simplex_noise_array_2d_deriv(0.0, 0.0, WIDTH, HEIGHT, STEP, values, NULL) == 0 ||
+        simplex_fbm_array_2d_deriv(0.0, 0.0, WIDTH, HEIGHT, STEP, 0, PERSISTENCE, LACUNARITY,
+                                   values, gradient) == 0) {
+        printf("✗ Argument validation wrong\n\n");
+        return 1;
+    }
+    simplex_context_destroy(ctx);
+    printf("✓ Arrays match the point functions\n\n");
+
+    // Test 3: Normal map pixels encode the normalized analytic normal
+    printf("Test 3: Normal map...\n");
+    simplex_image_config_t image = simplex_get_default_image_config();
+    simplex_set_image_size(&image, WIDTH, HEIGHT);
+    simplex_set_noise_params(&image, 0.05, OCTAVES, PERSISTENCE, LACUNARITY);
+    simplex_set_image_filename(&image, NORMAL_FILE);
+    const double strength = 20.0;
+    if (simplex_generate_normal_map(&image, strength) != 0) {
+        printf("✗ Normal map generation failed\n\n");
+        return 1;
+    }
+    FILE* file = fopen(NORMAL_FILE, "rb");
+    int file_width = 0;
+    int file_height = 0;
+    int max_value = 0;
+    unsigned char* pixels = malloc((size_t)WIDTH * HEIGHT * 3);
+    if (!file || !pixels ||
+        fscanf(file, "P6\n%d %d\n%d", &file_width, &file_height, &max_value) != 3 ||
+        fgetc(file) != '\n' || file_width != WIDTH || file_height != HEIGHT ||
+        fread(pixels, 1, (size_t)WIDTH * HEIGHT * 3, file) != (size_t)WIDTH * HEIGHT * 3) {
+        printf("✗ Normal map has the wrong header or size\n\n");
+        return 1;
+    }
+    fclose(file);
+    remove(NORMAL_FILE);
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < WIDTH; x++) {
+            double g[2];
+            simplex_fbm_2d_deriv(x * image.scale, y * image.scale, OCTAVES, PERSISTENCE,
+                                 LACUNARITY, g);
+            double nx = -g[0] * strength * image.scale;
+            double ny = -g[1] * strength * image.scale;
+            double length = sqrt((nx * nx) + (ny * ny) + 1.0);
+            const unsigned char* p = &pixels[3 * (((size_t)y * WIDTH) + x)];
+            double expected[3] = {nx / length, ny / length, 1.0 / length};
+            for (int c = 0; c < 3; c++) {
+                if (fabs((p[c] / 127.5) - 1.0 - expected[c]) > 1.0 / 64) {
+                    printf("✗ Pixel (%d, %d) does not encode the analytic normal\n\n", x, y);
+                    return 1;
+                }
+            }
+        }
+    }
+    image.format = SIMPLEX_IMAGE_PGM;
+    if (simplex_generate_normal_map(&image, strength) != -1 ||
+        simplex_generate_normal_map(NULL, strength) != -1) {
+        printf("✗ Invalid normal map request accepted\n\n");
+        return 1;
+    }
+    printf("✓ Normal map matches the analytic normals\n\n");
+
+    free(pixels);
+    free(values);
+    free(gradient);
+    simplex_cleanup();
+
+    printf("All derivative tests passed! ✓\n");
+    return 0;
+}
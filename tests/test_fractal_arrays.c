@@ -0,0 +1,158 @@
+/**
+ * @file test_fractal_arrays.c
+ * @brief Fractal array functions vs per-point evaluation test
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @author Adrian Paredez
+ * @version 1.0
+ * @date 9/5/2025
+ */
+
+#include <simplex_noise.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Not a multiple of the tile size, so tiles straddle rows and slices
+#define WIDTH 45
+#define HEIGHT 31
+#define DEPTH 3
+#define SAMPLES ((size_t)WIDTH * HEIGHT * DEPTH)
+
+#define X0 (-3.5)
+#define Y0 1.25
+#define Z0 0.75
+#define STEP 0.043
+#define OCTAVES 6
+#define PERSISTENCE 0.55
+#define LACUNARITY 2.1
+#define OFFSET 0.7
+#define MAX_UNROLLED_OCTAVES 8
+
+// Compare every sample of a 2D (depth 1) or 3D array against the point function
+static int check(const char* name, const simplex_context_t* ctx, const double* output, int depth,
+                 int kind, int octaves) {
+    for (int z = 0; z < depth; z++) {
+        for (int y = 0; y < HEIGHT; y++) {
+            for (int x = 0; x < WIDTH; x++) {
+                double px = X0 + (x * STEP);
+                double py = Y0 + (y * STEP);
+                double pz = Z0 + (z * STEP);
+                double expected = 0.0;
+                switch (kind) {
+                    case 0:
+                        expected = depth == 1
+                                       ? simplex_fractal_2d_ctx(ctx, px, py, octaves, PERSISTENCE,
+                                                                LACUNARITY)
+                                       : simplex_fractal_3d_ctx(ctx, px, py, pz, octaves,
+                                                                PERSISTENCE, LACUNARITY);
+                        break;
+                    case 1:
+                        expected = simplex_hybrid_multifractal_2d_ctx(ctx, px, py, octaves,
+                                                                      PERSISTENCE, LACUNARITY,
+                                                                      OFFSET);
+                        break;
+                    case 2:
+                        expected = depth == 1 ? simplex_ridged_2d_ctx(ctx, px, py)
+                                              : simplex_ridged_3d_ctx(ctx, px, py, pz);
+                        break;
+                    default:
+                        expected = depth == 1 ? simplex_billowy_2d_ctx(ctx, px, py)
+                                              : simplex_billowy_3d_ctx(ctx, px, py, pz);
+                        break;
+                }
+                size_t index = ((size_t)z * HEIGHT + y) * WIDTH + x;
+                if (output[index] != expected) {
+                    printf("✗ %s differs at (%d, %d, %d): %.17g vs %.17g\n\n", name, x, y, z,
+                           output[index], expected);
+                    return -1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+int main(void) {
+    printf("Simplex Noise Fractal Array Test\n");
+    printf("================================\n\n");
+
+    double* output = malloc(SAMPLES * sizeof(double));
+    if (!output) {
+        return 1;
+    }
+
+    for (int simd = 0; simd <= 1; simd++) {
+        printf("Test %d: fractal arrays vs point functions (SIMD %s)...\n", simd + 1,
+               simd ? "on" : "off");
+
+        simplex_config_t config = simplex_get_default_config();
+        config.seed = 777;  // NOLINT(readability-magic-numbers)
+        config.enable_simd = simd;
+        config.max_threads = 3;
+        config.chunk_size = 100;  // NOLINT(readability-magic-numbers)
+        simplex_context_t* ctx = simplex_context_create(&config);
+        if (!ctx) {
+            printf("✗ Context creation failed\n\n");
+            return 1;
+        }
+
+        if (simplex_fractal_array_2d_ctx(ctx, X0, Y0, WIDTH, HEIGHT, STEP, OCTAVES, PERSISTENCE,
+                                         LACUNARITY, output) != 0 ||
+            check("fractal_array_2d", ctx, output, 1, 0, OCTAVES) != 0 ||
+            simplex_fractal_array_3d_ctx(ctx, X0, Y0, Z0, WIDTH, HEIGHT, DEPTH, STEP, OCTAVES,
+                                         PERSISTENCE, LACUNARITY, output) != 0 ||
+            check("fractal_array_3d", ctx, output, DEPTH, 0, OCTAVES) != 0 ||
+            simplex_hybrid_multifractal_array_2d_ctx(ctx, X0, Y0, WIDTH, HEIGHT, STEP, OCTAVES,
+                                                     PERSISTENCE, LACUNARITY, OFFSET,
+                                                     output) != 0 ||
+            check("hybrid_multifractal_array_2d", ctx, output, 1, 1, OCTAVES) != 0 ||
+            simplex_ridged_array_2d_ctx(ctx, X0, Y0, WIDTH, HEIGHT, STEP, output) != 0 ||
+            check("ridged_array_2d", ctx, output, 1, 2, 1) != 0 ||
+            simplex_ridged_array_3d_ctx(ctx, X0, Y0, Z0, WIDTH, HEIGHT, DEPTH, STEP, output) != 0 ||
+            check("ridged_array_3d", ctx, output, DEPTH, 2, 1) != 0 ||
+            simplex_billowy_array_2d_ctx(ctx, X0, Y0, WIDTH, HEIGHT, STEP, output) != 0 ||
+            check("billowy_array_2d", ctx, output, 1, 3, 1) != 0 ||
+            simplex_billowy_array_3d_ctx(ctx, X0, Y0, Z0, WIDTH, HEIGHT, DEPTH, STEP, output) !=
+                0 ||
+            check("billowy_array_3d", ctx, output, DEPTH, 3, 1) != 0) {
+            return 1;
+        }
+        simplex_context_destroy(ctx);
+        printf("✓ Every sample matches the per-point function\n\n");
+    }
+
+    // Test 3: Octave counts with a fixed-octave tile kernel and the first without one
+    printf("Test 3: fractal arrays at 1 to %d octaves...\n", MAX_UNROLLED_OCTAVES + 1);
+    for (int octaves = 1; octaves <= MAX_UNROLLED_OCTAVES + 1; octaves++) {
+        if (simplex_fractal_array_2d(X0, Y0, WIDTH, HEIGHT, STEP, octaves, PERSISTENCE, LACUNARITY,
+                                     output) != 0 ||
+            check("fractal_array_2d", NULL, output, 1, 0, octaves) != 0 ||
+            simplex_fractal_array_3d(X0, Y0, Z0, WIDTH, HEIGHT, DEPTH, STEP, octaves, PERSISTENCE,
+                                     LACUNARITY, output) != 0 ||
+            check("fractal_array_3d", NULL, output, DEPTH, 0, octaves) != 0 ||
+            simplex_hybrid_multifractal_array_2d(X0, Y0, WIDTH, HEIGHT, STEP, octaves,
+                                                 PERSISTENCE, LACUNARITY, OFFSET, output) != 0 ||
+            check("hybrid_multifractal_array_2d", NULL, output, 1, 1, octaves) != 0) {
+            return 1;
+        }
+    }
+    printf("✓ Every octave count matches the per-point function\n\n");
+
+    // Test 4: Invalid arguments are rejected
+    printf("Test 4: Argument validation...\n");
+    if (simplex_fractal_array_2d(0.0, 0.0, WIDTH, HEIGHT, STEP, 0, 0.5, 2.0, output) == 0 ||
+        simplex_ridged_array_3d(0.0, 0.0, 0.0, WIDTH, HEIGHT, 0, STEP, output) == 0 ||
+        simplex_billowy_array_2d(0.0, 0.0, WIDTH, HEIGHT, STEP, NULL) == 0) {
+        printf("✗ Invalid arguments accepted\n\n");
+        return 1;
+    }
+    printf("✓ Invalid arguments rejected\n\n");
+
+    free(output);
+    simplex_cleanup();
+
+    printf("All fractal array tests passed! ✓\n");
+    return 0;
+}
@@ -0,0 +1,219 @@
+/**
+ * @file test_gpu.c
+ * @brief OpenCL offload vs CPU array and image generation test
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @author Adrian Paredez
+ * @version 1.0
+ * @date 9/5/2025
+ */
+
+#include <math.h>
+#include <simplex_image.h>
+#include <simplex_noise.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Every job is above the offload threshold of 65536 samples
+#define WIDTH 384
+#define HEIGHT 200
+#define DEPTH 3
+#define STEP 0.0137
+#define OCTAVES 5
+#define PERSISTENCE 0.5
+#define LACUNARITY 2.03
+#define OFFSET 0.8
+#define ROOMY_MEMORY_MB 256.0
+// A few rows per slab, so jobs stream through both device buffers many times
+#define SLAB_MEMORY_MB 0.05
+#define IMAGE_WIDTH 512
+#define IMAGE_HEIGHT 160
+// Grid starts near the origin and far enough out to keep few fraction bits
+#define FAR_X 1.5e6
+
+enum { JOB_NOISE_2D = 0, JOB_NOISE_3D, JOB_FBM_2D, JOB_FBM_3D, JOB_HYBRID_2D, JOB_RIDGED_2D,
+       JOB_RIDGED_3D, JOB_BILLOWY_2D, JOB_BILLOWY_3D, JOB_COUNT };
+
+static const char* const job_names[JOB_COUNT] = {
+    "noise_array_2d",  "noise_array_3d",  "fbm_array_2d",     "fbm_array_3d",
+    "hybrid_array_2d", "ridged_array_2d", "ridged_array_3d", "billowy_array_2d",
+    "billowy_array_3d"};
+
+static const double near_start[3] = {-12.5, 3.25, 0.75};
+static const double far_start[3] = {FAR_X + 0.37, -2.0 * FAR_X, 0.5 * FAR_X};
+
+// Run one job kind on a grid starting at start
+static int run_job(const simplex_context_t* ctx, int job, const double* start, double* output) {
+    const double x0 = start[0];
+    const double y0 = start[1];
+    const double z0 = start[2];
+    switch (job) {
+    case JOB_NOISE_2D:
+        return simplex_noise_array_2d_ctx(ctx, x0, y0, WIDTH, HEIGHT, STEP, output);
+    case JOB_NOISE_3D:
+        return simplex_noise_array_3d_ctx(ctx, x0, y0, z0, WIDTH, HEIGHT, DEPTH, STEP, output);
+    case JOB_FBM_2D:
+        return simplex_fbm_array_2d_ctx(ctx, x0, y0, WIDTH, HEIGHT, STEP, OCTAVES, PERSISTENCE,
+                                        LACUNARITY, output);
+    case JOB_FBM_3D:
+        return simplex_fbm_array_3d_ctx(ctx, x0, y0, z0, WIDTH, HEIGHT, DEPTH, STEP, OCTAVES,
+                                        PERSISTENCE, LACUNARITY, output);
+    case JOB_HYBRID_2D:
+        return simplex_hybrid_multifractal_array_2d_ctx(ctx, x0, y0, WIDTH, HEIGHT, STEP,
+                                                        OCTAVES, PERSISTENCE, LACUNARITY,
+                                                        OFFSET, output);
+    case JOB_RIDGED_2D:
+        return simplex_ridged_array_2d_ctx(ctx, x0, y0, WIDTH, HEIGHT, STEP, output);
+    case JOB_RIDGED_3D:
+        return simplex_ridged_array_3d_ctx(ctx, x0, y0, z0, WIDTH, HEIGHT, DEPTH, STEP, output);
+    case JOB_BILLOWY_2D:
+        return simplex_billowy_array_2d_ctx(ctx, x0, y0, WIDTH, HEIGHT, STEP, output);
+    default:
+        return simplex_billowy_array_3d_ctx(ctx, x0, y0, z0, WIDTH, HEIGHT, DEPTH, STEP, output);
+    }
+}
+
+// Context with a seed, offload setting and device memory limit
+static simplex_context_t* make_context(uint32_t seed, int enable_gpu, double memory_limit_mb) {
+    simplex_config_t config = simplex_get_default_config();
+    config.seed = seed;
+    config.enable_gpu = enable_gpu;
+    config.memory_limit_mb = memory_limit_mb;
+    config.max_threads = 2;
+    return simplex_context_create(&config);
+}
+
+// Every job on gpu matches cpu within SIMPLEX_SIMD_TOLERANCE
+static int same_as_cpu(const simplex_context_t* gpu, const simplex_context_t* cpu,
+                       const double* start, double* expected, double* output) {
+    for (int job = 0; job < JOB_COUNT; job++) {
+        int depth = job == JOB_NOISE_3D || job == JOB_FBM_3D || job == JOB_RIDGED_3D ||
+                            job == JOB_BILLOWY_3D
+                        ? DEPTH
+                        : 1;
+        if (run_job(cpu, job, start, expected) != 0 || run_job(gpu, job, start, output) != 0) {
+            printf("✗ %s failed\n\n", job_names[job]);
+            return 0;
+        }
+        for (size_t i = 0; i < (size_t)WIDTH * HEIGHT * depth; i++) {
+            if (fabs(output[i] - expected[i]) > SIMPLEX_SIMD_TOLERANCE) {
+                printf("✗ %s differs at %zu: %.17g vs %.17g\n\n", job_names[job], i, output[i],
+                       expected[i]);
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+int main(void) {
+    printf("Simplex Noise GPU Offload Test\n");
+    printf("==============================\n\n");
+
+    double* expected = malloc((size_t)WIDTH * HEIGHT * DEPTH * sizeof(double));
+    double* output = malloc((size_t)WIDTH * HEIGHT * DEPTH * sizeof(double));
+    simplex_context_t* cpu = make_context(2024, 0, ROOMY_MEMORY_MB);
+    simplex_context_t* gpu = make_context(2024, 1, ROOMY_MEMORY_MB);
+    simplex_context_t* slabbed = make_context(2024, 1, SLAB_MEMORY_MB);
+    if (!expected || !output || !cpu || !gpu || !slabbed) {
+        return 1;
+    }
+    const char* device = simplex_get_gpu_name_ctx(gpu);
+    if (simplex_get_gpu_name_ctx(cpu) != NULL) {
+        printf("✗ Context without enable_gpu reports a device\n\n");
+        return 1;
+    }
+    if (device) {
+        printf("Offloading to %s\n\n", device);
+    } else {
+        printf("No usable OpenCL device; checking the CPU fallback\n\n");
+    }
+
+    // Test 1: Every offloaded array kind matches the CPU
+    printf("Test 1: Arrays vs CPU...\n");
+    if (!same_as_cpu(gpu, cpu, near_start, expected, output)) {
+        return 1;
+    }
+    printf("✓ Every array matches the CPU\n\n");
+
+    // Test 2: Far grids, where the CPU rows must still be the point functions
+    printf("Test 2: Far arrays vs CPU and point functions...\n");
+    if (!same_as_cpu(gpu, cpu, far_start, expected, output) ||
+        run_job(cpu, JOB_NOISE_2D, far_start, expected) != 0) {
+        return 1;
+    }
+    for (size_t i = 0; i < (size_t)WIDTH * HEIGHT; i++) {
+        double x = far_start[0] + ((double)(i % WIDTH) * STEP);
+        double y = far_start[1] + ((double)(i / WIDTH) * STEP);
+        if (fabs(expected[i] - simplex_noise_2d_ctx(cpu, x, y)) > SIMPLEX_SIMD_TOLERANCE) {
+            printf("✗ Far CPU sample %zu differs from simplex_noise_2d()\n\n", i);
+            return 1;
+        }
+    }
+    printf("✓ Far arrays match the CPU and the point functions\n\n");
+
+    // Test 3: Streaming in slabs and other seeds change nothing
+    printf("Test 3: Slabs and seeds...\n");
+    simplex_context_t* cpu_reseeded = make_context(99, 0, ROOMY_MEMORY_MB);
+    simplex_context_t* gpu_reseeded = make_context(99, 1, SLAB_MEMORY_MB);
+    if (!cpu_reseeded || !gpu_reseeded ||
+        !same_as_cpu(slabbed, cpu, near_start, expected, output) ||
+        !same_as_cpu(gpu_reseeded, cpu_reseeded, near_start, expected, output)) {
+        return 1;
+    }
+    simplex_context_destroy(cpu_reseeded);
+    simplex_context_destroy(gpu_reseeded);
+    printf("✓ Slabbed and reseeded arrays match the CPU\n\n");
+
+    // Test 4: The default context's switch and the image pipeline
+    printf("Test 4: Default context and images...\n");
+    simplex_image_config_t image = simplex_get_default_image_config();
+    image.width = IMAGE_WIDTH;
+    image.height = IMAGE_HEIGHT;
+    image.octaves = 3;
+    image.format = SIMPLEX_IMAGE_RAW;
+    size_t size = simplex_image_encoded_size(&image);
+    unsigned char* pixels = malloc(size);
+    unsigned char* reference = malloc(size);
+    if (!pixels || !reference || simplex_render_to_buffer(&image, reference, size, NULL) != 0) {
+        return 1;
+    }
+    int enabled = simplex_set_gpu(1);
+    simplex_config_t defaults;
+    simplex_context_get_config(NULL, &defaults);
+    if ((enabled == 0) != (simplex_get_gpu_name() != NULL) ||
+        defaults.enable_gpu != (enabled == 0)) {
+        printf("✗ simplex_set_gpu() result and device state disagree\n\n");
+        return 1;
+    }
+    if (simplex_render_to_buffer(&image, pixels, size, NULL) != 0) {
+        printf("✗ Offloaded image failed\n\n");
+        return 1;
+    }
+    // Pixels may round differently where a sample sits on a quantization step
+    for (size_t i = 0; i < size; i++) {
+        if (abs(pixels[i] - reference[i]) > 1) {
+            printf("✗ Offloaded image differs at byte %zu\n\n", i);
+            return 1;
+        }
+    }
+    if (simplex_set_gpu(0) != 0 || simplex_get_gpu_name() != NULL) {
+        printf("✗ Offload not switched off\n\n");
+        return 1;
+    }
+    free(pixels);
+    free(reference);
+    printf("✓ Images match the CPU\n\n");
+
+    simplex_context_destroy(cpu);
+    simplex_context_destroy(gpu);
+    simplex_context_destroy(slabbed);
+    free(expected);
+    free(output);
+    simplex_cleanup();
+
+    printf("All GPU offload tests passed! ✓\n");
+    return 0;
+}
@@ -0,0 +1,160 @@
+/**
+ * @file test_image_batch.c
+ * @brief Pipelined animation and image series test
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @author Adrian Paredez
+ * @version 1.0
+ * @date 9/5/2025
+ */
+
+#include <simplex_image.h>
+#include <simplex_noise.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test_util.h"
+
+#define WIDTH 48
+#define HEIGHT 32
+#define FRAMES 7
+#define TIME_STEP 0.25
+#define SERIES 5
+#define PIPELINE_THREADS 4
+#define ROOMY_MEMORY_MB 256.0
+// Two frame slots per set, without room to keep samples between passes
+#define TIGHT_MEMORY_MB 0.01
+// Less than one frame slot per set, so frames are streamed in bands
+#define BANDED_MEMORY_MB 0.003
+#define REFERENCE_FILE "test_batch_reference.img"
+
+// Compare a batch output file with the reference file, removing both
+static int same_files(const char* filename) {
+    unsigned char* a = NULL;
+    unsigned char* b = NULL;
+    size_t a_size = read_file(filename, &a);
+    size_t b_size = read_file(REFERENCE_FILE, &b);
+    int same = a_size > 0 && a_size == b_size && memcmp(a, b, a_size) == 0;
+    free(a);
+    free(b);
+    remove(filename);
+    remove(REFERENCE_FILE);
+    return same;
+}
+
+// Generate the animation, then check every frame against a one-at-a-time 3D image
+static int check_animation(const simplex_image_config_t* config, double memory_limit_mb,
+                           int max_threads) {
+    set_limits(memory_limit_mb, max_threads);
+    if (simplex_generate_animation(config, FRAMES, TIME_STEP, ".") != 0) {
+        return 0;
+    }
+    set_limits(ROOMY_MEMORY_MB, 1);
+    for (int frame = 0; frame < FRAMES; frame++) {
+        simplex_image_config_t reference = *config;
+        simplex_set_image_filename(&reference, REFERENCE_FILE);
+        reference.offset_z = frame * TIME_STEP;
+        char filename[64];
+        snprintf(filename, sizeof(filename), "./frame_%04d.ppm", frame);
+        if (simplex_generate_3d_image(&reference, frame * TIME_STEP) != 0 ||
+            !same_files(filename)) {
+            printf("✗ Frame %d differs from a single 3D image\n\n", frame);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Generate the series, then check every image against a one-at-a-time 2D image
+static int check_series(const simplex_image_config_t* config, const double* scales,
+                        const uint32_t* seeds, double memory_limit_mb, int max_threads) {
+    set_limits(memory_limit_mb, max_threads);
+    if (simplex_generate_image_series(config, SERIES, scales, seeds) != 0) {
+        return 0;
+    }
+    set_limits(ROOMY_MEMORY_MB, 1);
+    for (int i = 0; i < SERIES; i++) {
+        simplex_image_config_t reference = *config;
+        simplex_set_image_filename(&reference, REFERENCE_FILE);
+        reference.scale = scales ? scales[i] : reference.scale;
+        reference.seed = seeds ? seeds[i] : reference.seed;
+        char filename[64];
+        snprintf(filename, sizeof(filename), "simplex_series_%d.ppm", i);
+        if (simplex_generate_2d_image(&reference) != 0 || !same_files(filename)) {
+            printf("✗ Series image %d differs from a single 2D image\n\n", i);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int main(void) {
+    printf("Simplex Noise Image Batch Test\n");
+    printf("==============================\n\n");
+
+    simplex_image_config_t config = simplex_get_default_image_config();
+    simplex_set_image_size(&config, WIDTH, HEIGHT);
+    simplex_set_noise_params(&config, 0.05, 3, 0.5, 2.0);
+    config.seed = 4242;  // NOLINT(readability-magic-numbers)
+
+    // Test 1: Animation frames match single 3D images however they are scheduled
+    printf("Test 1: Animation...\n");
+    static const int modes[] = {SIMPLEX_NORMALIZE_EXACT, SIMPLEX_NORMALIZE_BOUNDED};
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+        config.auto_normalize = modes[m];
+        config.color_mode = m == 0 ? SIMPLEX_COLOR_GRAYSCALE : SIMPLEX_COLOR_TERRAIN;
+        if (!check_animation(&config, ROOMY_MEMORY_MB, PIPELINE_THREADS) ||
+            !check_animation(&config, TIGHT_MEMORY_MB, PIPELINE_THREADS) ||
+            !check_animation(&config, BANDED_MEMORY_MB, PIPELINE_THREADS) ||
+            !check_animation(&config, ROOMY_MEMORY_MB, 1)) {
+            printf("✗ Animation wrong in normalization mode %d\n\n", modes[m]);
+            return 1;
+        }
+    }
+    printf("✓ Pipelined, two-pass and streamed frames match\n\n");
+
+    // Test 2: Series images with repeated seeds and varying scales
+    printf("Test 2: Image series...\n");
+    config.auto_normalize = SIMPLEX_NORMALIZE_EXACT;
+    config.color_mode = SIMPLEX_COLOR_HEIGHTMAP;
+    static const double scales[SERIES] = {0.01, 0.02, 0.05, 0.1, 0.03};
+    static const uint32_t seeds[SERIES] = {11, 22, 11, 33, 22};
+    if (!check_series(&config, scales, seeds, ROOMY_MEMORY_MB, PIPELINE_THREADS) ||
+        !check_series(&config, NULL, seeds, TIGHT_MEMORY_MB, PIPELINE_THREADS) ||
+        !check_series(&config, scales, NULL, ROOMY_MEMORY_MB, 1)) {
+        return 1;
+    }
+    printf("✓ Series images match\n\n");
+
+    // Test 3: The default context keeps its seed, invalid batches are rejected
+    printf("Test 3: Default context and validation...\n");
+    set_limits(ROOMY_MEMORY_MB, PIPELINE_THREADS);
+    double before = simplex_noise_2d(0.3, 0.7);
+    int series_result = simplex_generate_image_series(&config, SERIES, NULL, seeds);
+    for (int i = 0; i < SERIES; i++) {
+        char filename[64];
+        snprintf(filename, sizeof(filename), "simplex_series_%d.ppm", i);
+        remove(filename);
+    }
+    if (series_result != 0 || simplex_noise_2d(0.3, 0.7) != before) {
+        printf("✗ Batch rendering changed the default context\n\n");
+        return 1;
+    }
+    config.format = SIMPLEX_IMAGE_PGM;
+    if (simplex_generate_animation(&config, FRAMES, TIME_STEP, ".") != -1 ||
+        simplex_generate_image_series(&config, SERIES, NULL, NULL) != -1 ||
+        simplex_generate_animation(&config, 0, TIME_STEP, ".") != -1 ||
+        simplex_generate_image_series(NULL, SERIES, NULL, NULL) != -1) {
+        printf("✗ Invalid batch accepted\n\n");
+        return 1;
+    }
+    printf("✓ Default context untouched, invalid batches rejected\n\n");
+
+    simplex_cleanup();
+
+    printf("All image batch tests passed! ✓\n");
+    return 0;
+}
@@ -0,0 +1,162 @@
+/**
+ * @file test_image_buffer.c
+ * @brief In-memory (buffer and stream) image generation test
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @author Adrian Paredez
+ * @version 1.0
+ * @date 9/5/2025
+ */
+
+#include <simplex_image.h>
+#include <simplex_noise.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test_util.h"
+
+#define WIDTH 83
+#define HEIGHT 41
+#define Z_SLICE 0.6
+#define ROOMY_MEMORY_MB 256.0
+// A couple of pixel rows, so streams arrive in many bands
+#define BANDED_MEMORY_MB 0.002
+#define FILE_NAME "test_buffer_reference.img"
+
+// Growable byte buffer filled by the stream callback
+typedef struct {
+    unsigned char* data;
+    size_t size;
+    size_t capacity;
+    int calls;
+    int empty_calls; /* Calls with no bytes, which a RAW header must not make */
+    int fail_after;  /* Fail this call, 0 for never */
+} collector_t;
+
+static int collect(void* user_data, const void* data, size_t size) {
+    collector_t* collector = user_data;
+    collector->calls++;
+    collector->empty_calls += size == 0;
+    if (collector->fail_after && collector->calls >= collector->fail_after) {
+        return 1;
+    }
+    if (collector->size + size > collector->capacity) {
+        size_t capacity = (collector->size + size) * 2;
+        unsigned char* grown = realloc(collector->data, capacity);
+        if (!grown) {
+            return 1;
+        }
+        collector->data = grown;
+        collector->capacity = capacity;
+    }
+    if (size) {
+        memcpy(collector->data + collector->size, data, size);
+    }
+    collector->size += size;
+    return 0;
+}
+
+// Render config to a file, a buffer and a stream and compare all three
+static int compare_outputs(const simplex_image_config_t* config, int dims,
+                           double memory_limit_mb) {
+    simplex_image_config_t file_config = *config;
+    simplex_set_image_filename(&file_config, FILE_NAME);
+    set_limits(ROOMY_MEMORY_MB, 1);
+    int file_result = dims == 3 ? simplex_generate_3d_image(&file_config, Z_SLICE)
+                                : simplex_generate_2d_image(&file_config);
+    unsigned char* expected = NULL;
+    size_t expected_size = read_file(FILE_NAME, &expected);
+    remove(FILE_NAME);
+
+    set_limits(memory_limit_mb, 4);
+    size_t size = simplex_image_encoded_size(config);
+    unsigned char* buffer = malloc(size);
+    size_t written = 0;
+    int buffer_result =
+        dims == 3 ? simplex_render_3d_to_buffer(config, Z_SLICE, buffer, size, &written)
+                  : simplex_render_to_buffer(config, buffer, size, &written);
+    collector_t stream = {0};
+    int stream_result = dims == 3 ? simplex_render_3d_to_stream(config, Z_SLICE, collect, &stream)
+                                  : simplex_render_to_stream(config, collect, &stream);
+
+    int status = file_result != 0 || buffer_result != 0 || stream_result != 0 ||
+                 expected_size == 0 || size != expected_size || written != expected_size ||
+                 stream.size != expected_size || stream.empty_calls != 0 ||
+                 memcmp(buffer, expected, size) != 0 ||
+                 memcmp(stream.data, expected, size) != 0;
+    // Banded streams deliver the header and then one call per band
+    if (memory_limit_mb == BANDED_MEMORY_MB && stream.calls < 3) {
+        status = 1;
+    }
+    free(expected);
+    free(buffer);
+    free(stream.data);
+    return status;
+}
+
+int main(void) {
+    printf("Simplex Noise In-Memory Image Test\n");
+    printf("==================================\n\n");
+
+    simplex_image_config_t config = simplex_get_default_image_config();
+    simplex_set_image_size(&config, WIDTH, HEIGHT);
+    simplex_set_noise_params(&config, 0.04, 4, 0.5, 2.0);
+
+    // Test 1: Buffers and streams match files in every format and normalization mode
+    printf("Test 1: Buffer and stream output...\n");
+    static const int modes[] = {SIMPLEX_NORMALIZE_NONE, SIMPLEX_NORMALIZE_EXACT,
+                                SIMPLEX_NORMALIZE_BOUNDED};
+    static const simplex_image_format_t formats[] = {SIMPLEX_IMAGE_PPM, SIMPLEX_IMAGE_RAW,
+                                                     SIMPLEX_IMAGE_PGM};
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+        for (size_t f = 0; f < sizeof(formats) / sizeof(formats[0]); f++) {
+            config.auto_normalize = modes[m];
+            config.format = formats[f];
+            config.color_mode =
+                formats[f] == SIMPLEX_IMAGE_PGM ? SIMPLEX_COLOR_GRAYSCALE : SIMPLEX_COLOR_TERRAIN;
+            for (int dims = 2; dims <= 3; dims++) {
+                if (compare_outputs(&config, dims, ROOMY_MEMORY_MB) != 0 ||
+                    compare_outputs(&config, dims, BANDED_MEMORY_MB) != 0) {
+                    printf("✗ Format %d, mode %d, %dD differs from the file\n\n", formats[f],
+                           modes[m], dims);
+                    return 1;
+                }
+            }
+        }
+    }
+    printf("✓ Buffers and streams match the files byte for byte\n\n");
+
+    // Test 2: Size queries, short buffers and failing callbacks
+    printf("Test 2: Sizes and errors...\n");
+    config.format = SIMPLEX_IMAGE_PPM;
+    config.color_mode = SIMPLEX_COLOR_RGB;
+    char header[64];
+    size_t expected_size =
+        (size_t)snprintf(header, sizeof(header), "P6\n%d %d\n255\n", WIDTH, HEIGHT) +
+        (3 * (size_t)WIDTH * HEIGHT);
+    size_t size = 0;
+    unsigned char small[16];
+    collector_t failing = {.fail_after = 2};
+    simplex_image_config_t invalid = config;
+    invalid.format = SIMPLEX_IMAGE_PGM;
+    if (simplex_image_encoded_size(&config) != expected_size ||
+        simplex_render_to_buffer(&config, NULL, 0, &size) != -1 || size != expected_size ||
+        simplex_render_to_buffer(&config, small, sizeof(small), NULL) != -1 ||
+        simplex_render_to_stream(&config, collect, &failing) != -1 ||
+        simplex_image_encoded_size(&invalid) != 0 || simplex_image_encoded_size(NULL) != 0 ||
+        simplex_render_to_stream(&config, NULL, NULL) != -1 ||
+        simplex_render_3d_to_buffer(NULL, 0.0, small, sizeof(small), &size) != -1 || size != 0) {
+        printf("✗ Sizes or error handling wrong\n\n");
+        return 1;
+    }
+    free(failing.data);
+    printf("✓ Sizes reported, errors caught\n\n");
+
+    simplex_cleanup();
+
+    printf("All in-memory image tests passed! ✓\n");
+    return 0;
+}
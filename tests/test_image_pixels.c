@@ -0,0 +1,179 @@
+/**
+ * @file test_image_pixels.c
+ * @brief Float height, heightmap and texture rendering into caller buffers
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @author Adrian Paredez
+ * @version 1.0
+ * @date 9/5/2025
+ */
+
+#include <simplex_image.h>
+#include <simplex_noise.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define WIDTH 96
+#define HEIGHT 64
+#define PIXELS (WIDTH * HEIGHT)
+
+static float heights[PIXELS];
+static float expected_heights[PIXELS];
+static uint8_t pixels[PIXELS * 3];
+static uint8_t expected_pixels[PIXELS * 3];
+
+static simplex_image_config_t test_config(void) {
+    simplex_image_config_t config = simplex_get_default_image_config();
+    simplex_set_image_size(&config, WIDTH, HEIGHT);
+    config.format = SIMPLEX_IMAGE_RAW;
+    config.scale = 0.021;
+    config.offset_x = 3.5;
+    config.offset_y = -7.25;
+    config.seed = 2024;  // NOLINT(readability-magic-numbers)
+    return config;
+}
+
+// Whether the float heights round to the 16-bit samples of the same image
+static int heights_match_gray16(const simplex_image_config_t* config) {
+    simplex_image_config_t gray16 = *config;
+    gray16.format = SIMPLEX_IMAGE_RAW;
+    gray16.color_mode = SIMPLEX_COLOR_GRAYSCALE16;
+    if (simplex_render_to_buffer(&gray16, pixels, sizeof(pixels), NULL) != 0) {
+        return 0;
+    }
+    for (int i = 0; i < PIXELS; i++) {
+        int sample = (pixels[2 * i] << 8) | pixels[(2 * i) + 1];
+        int rounded = (int)((heights[i] * 65535.0) + 0.5);
+        if (heights[i] < 0.0f || heights[i] > 1.0f || abs(sample - rounded) > 1) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int main(void) {
+    printf("Simplex Noise Image Pixel Buffer Test\n");
+    printf("=====================================\n\n");
+
+    // Test 1: Float heights are the normalized image samples
+    printf("Test 1: Float heights...\n");
+    simplex_image_config_t config = test_config();
+    float low = 1.0f;
+    float high = 0.0f;
+    if (simplex_render_heights_f32(&config, heights, PIXELS) != 0 ||
+        !heights_match_gray16(&config)) {
+        printf("✗ Heights differ from the 16-bit image\n\n");
+        return 1;
+    }
+    for (int i = 0; i < PIXELS; i++) {
+        low = heights[i] < low ? heights[i] : low;
+        high = heights[i] > high ? heights[i] : high;
+    }
+    if (low != 0.0f || high != 1.0f) {
+        printf("✗ Exact normalization spans %f to %f\n\n", low, high);
+        return 1;
+    }
+    // Format and color mode do not matter, bounded normalization clamps
+    config.format = SIMPLEX_IMAGE_PNG;
+    config.color_mode = SIMPLEX_COLOR_TERRAIN;
+    config.auto_normalize = SIMPLEX_NORMALIZE_BOUNDED;
+    if (simplex_render_heights_f32(&config, heights, PIXELS) != 0 ||
+        !heights_match_gray16(&config)) {
+        printf("✗ Bounded heights differ from the 16-bit image\n\n");
+        return 1;
+    }
+    printf("✓ Heights span 0 to 1 and match the 16-bit image\n\n");
+
+    // Test 2: Raw heights without normalization
+    printf("Test 2: Unnormalized heights...\n");
+    config = test_config();
+    config.auto_normalize = SIMPLEX_NORMALIZE_NONE;
+    memcpy(expected_heights, heights, sizeof(heights));
+    if (simplex_render_heights_f32(&config, heights, PIXELS) != 0 ||
+        memcmp(expected_heights, heights, sizeof(heights)) == 0) {
+        printf("✗ Unnormalized heights not rendered\n\n");
+        return 1;
+    }
+    for (int i = 0; i < PIXELS; i++) {
+        if (heights[i] < -1.0f || heights[i] > 1.0f) {
+            printf("✗ Raw height %f out of range\n\n", heights[i]);
+            return 1;
+        }
+    }
+    printf("✓ Raw noise passed through\n\n");
+
+    // Test 3: Heightmap and texture presets
+    printf("Test 3: Heightmap and texture buffers...\n");
+    config = test_config();
+    config.octaves = 1;
+    simplex_image_config_t preset = config;
+    preset.color_mode = SIMPLEX_COLOR_HEIGHTMAP;
+    preset.octaves = 6;
+    size_t size = 0;
+    if (simplex_render_heightmap_to_buffer(&config, pixels, sizeof(pixels), &size) != 0 ||
+        size != sizeof(pixels) ||
+        simplex_render_to_buffer(&preset, expected_pixels, sizeof(expected_pixels), NULL) != 0 ||
+        memcmp(pixels, expected_pixels, sizeof(pixels)) != 0) {
+        printf("✗ Heightmap buffer differs from the heightmap preset\n\n");
+        return 1;
+    }
+    preset.color_mode = SIMPLEX_COLOR_TERRAIN;
+    preset.octaves = 3;
+    if (simplex_render_texture_to_buffer(&config, pixels, sizeof(pixels), &size) != 0 ||
+        simplex_render_to_buffer(&preset, expected_pixels, sizeof(expected_pixels), NULL) != 0 ||
+        memcmp(pixels, expected_pixels, sizeof(pixels)) != 0) {
+        printf("✗ Texture buffer differs from the texture preset\n\n");
+        return 1;
+    }
+    // Heightmaps keep 16-bit samples
+    config.color_mode = SIMPLEX_COLOR_GRAYSCALE16;
+    if (simplex_render_heightmap_to_buffer(&config, pixels, sizeof(pixels), &size) != 0 ||
+        size != (size_t)PIXELS * 2) {
+        printf("✗ 16-bit heightmap not rendered\n\n");
+        return 1;
+    }
+    printf("✓ Presets render into buffers\n\n");
+
+    // Test 4: Thread count of the default context
+    printf("Test 4: Thread count...\n");
+    config = test_config();
+    simplex_config_t active;
+    if (simplex_render_heights_f32(&config, expected_heights, PIXELS) != 0 ||
+        simplex_set_max_threads(4) != 0 ||
+        simplex_render_heights_f32(&config, heights, PIXELS) != 0 ||
+        simplex_context_get_config(NULL, &active) != 0 || active.max_threads != 4 ||
+        memcmp(expected_heights, heights, sizeof(heights)) != 0) {
+        printf("✗ Threaded heights differ or the thread count was lost\n\n");
+        return 1;
+    }
+    if (simplex_set_max_threads(0) != -1 || simplex_set_max_threads(65) != -1) {
+        printf("✗ Invalid thread count accepted\n\n");
+        return 1;
+    }
+    printf("✓ Thread count kept across images\n\n");
+
+    // Test 5: Invalid requests
+    printf("Test 5: Validation...\n");
+    config = test_config();
+    simplex_image_config_t invalid = config;
+    invalid.width = 0;
+    if (simplex_render_heights_f32(&config, heights, PIXELS - 1) != -1 ||
+        simplex_render_heights_f32(&config, NULL, PIXELS) != -1 ||
+        simplex_render_heights_f32(NULL, heights, PIXELS) != -1 ||
+        simplex_render_heights_f32(&invalid, heights, PIXELS) != -1 ||
+        simplex_render_heightmap_to_buffer(&config, pixels, PIXELS, &size) != -1 ||
+        size != sizeof(pixels) || simplex_render_heightmap_to_buffer(NULL, pixels, 1, NULL) != -1 ||
+        simplex_render_texture_to_buffer(NULL, pixels, 1, NULL) != -1) {
+        printf("✗ Invalid request accepted\n\n");
+        return 1;
+    }
+    printf("✓ Invalid requests rejected\n\n");
+
+    simplex_cleanup();
+    printf("All image pixel buffer tests passed! ✓\n");
+    return 0;
+}
@@ -0,0 +1,158 @@
+/**
+ * @file test_image_stream.c
+ * @brief Banded (streaming) image generation test
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @author Adrian Paredez
+ * @version 1.0
+ * @date 9/5/2025
+ */
+
+#include <simplex_image.h>
+#include <simplex_noise.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test_util.h"
+
+#define WIDTH 97
+#define HEIGHT 61
+#define PIXELS ((size_t)WIDTH * HEIGHT)
+// Rows of three 512-sample tiles, the last one partial
+#define WIDE_WIDTH 1100
+#define WIDE_HEIGHT 5
+// A couple of pixel rows, so the images take many bands
+#define BANDED_MEMORY_MB 0.002
+#define SINGLE_BAND_MEMORY_MB 256.0
+#define BANDED_FILE "test_stream_banded.img"
+#define SINGLE_FILE "test_stream_single.img"
+
+// Render config banded on several threads and in one band on one thread
+static int compare_banded(const simplex_image_config_t* config, int dims, size_t expected_size) {
+    simplex_image_config_t banded = *config;
+    simplex_image_config_t single = *config;
+    simplex_set_image_filename(&banded, BANDED_FILE);
+    simplex_set_image_filename(&single, SINGLE_FILE);
+
+    set_limits(BANDED_MEMORY_MB, 8);
+    int banded_result = dims == 3 ? simplex_generate_3d_image(&banded, 0.75)
+                                  : simplex_generate_2d_image(&banded);
+    set_limits(SINGLE_BAND_MEMORY_MB, 1);
+    int single_result = dims == 3 ? simplex_generate_3d_image(&single, 0.75)
+                                  : simplex_generate_2d_image(&single);
+
+    unsigned char* a = NULL;
+    unsigned char* b = NULL;
+    size_t a_size = read_file(BANDED_FILE, &a);
+    size_t b_size = read_file(SINGLE_FILE, &b);
+    int status = banded_result != 0 || single_result != 0 || a_size != expected_size ||
+                 b_size != expected_size || memcmp(a, b, a_size) != 0;
+    free(a);
+    free(b);
+    remove(BANDED_FILE);
+    remove(SINGLE_FILE);
+    return status;
+}
+
+int main(void) {
+    printf("Simplex Noise Image Streaming Test\n");
+    printf("==================================\n\n");
+
+    simplex_image_config_t config = simplex_get_default_image_config();
+    simplex_set_image_size(&config, WIDTH, HEIGHT);
+    simplex_set_noise_params(&config, 0.03, 5, 0.5, 2.0);
+    char header[64];
+    size_t gray_header =
+        (size_t)snprintf(header, sizeof(header), "P5\n%d %d\n255\n", WIDTH, HEIGHT);
+    size_t rgb_header =
+        (size_t)snprintf(header, sizeof(header), "P6\n%d %d\n255\n", WIDTH, HEIGHT);
+
+    // Test 1: A single-band image matches the noise arrays exactly
+    printf("Test 1: Single-band output...\n");
+    set_limits(SINGLE_BAND_MEMORY_MB, 1);
+    simplex_set_image_filename(&config, SINGLE_FILE);
+    double* expected = malloc(PIXELS * sizeof(double));
+    unsigned char* file = NULL;
+    if (!expected || simplex_generate_2d_image(&config) != 0 ||
+        read_file(SINGLE_FILE, &file) != gray_header + PIXELS) {
+        printf("✗ Image generation failed\n\n");
+        return 1;
+    }
+    simplex_fractal_array_2d(0.0, 0.0, WIDTH, HEIGHT, 0.03, 5, 0.5, 2.0, expected);
+    double min_val = expected[0];
+    double max_val = expected[0];
+    for (size_t i = 0; i < PIXELS; i++) {
+        min_val = expected[i] < min_val ? expected[i] : min_val;
+        max_val = expected[i] > max_val ? expected[i] : max_val;
+    }
+    for (size_t i = 0; i < PIXELS; i++) {
+        double normalized = (expected[i] - min_val) / (max_val - min_val);
+        if (file[gray_header + i] != simplex_noise_to_grayscale(normalized)) {
+            printf("✗ Pixel %zu differs from the normalized fractal array\n\n", i);
+            return 1;
+        }
+    }
+    free(file);
+    free(expected);
+    remove(SINGLE_FILE);
+    printf("✓ Pixels match the normalized fractal array\n\n");
+
+    // Test 2: Banded output against single-band output for every mode
+    printf("Test 2: Banded vs single-band output...\n");
+    static const int modes[] = {SIMPLEX_NORMALIZE_NONE, SIMPLEX_NORMALIZE_EXACT,
+                                SIMPLEX_NORMALIZE_BOUNDED};
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+        config.auto_normalize = modes[m];
+        config.color_mode = SIMPLEX_COLOR_GRAYSCALE;
+        if (compare_banded(&config, 2, gray_header + PIXELS) != 0) {
+            printf("✗ Normalization mode %d differs when banded\n\n", modes[m]);
+            return 1;
+        }
+        config.color_mode = SIMPLEX_COLOR_TERRAIN;
+        if (compare_banded(&config, 3, rgb_header + (3 * PIXELS)) != 0) {
+            printf("✗ 3D slice, normalization mode %d differs when banded\n\n", modes[m]);
+            return 1;
+        }
+    }
+
+    // Rows wider than one pipeline tile
+    config.color_mode = SIMPLEX_COLOR_RGB;
+    simplex_set_image_size(&config, WIDE_WIDTH, WIDE_HEIGHT);
+    size_t wide_header = (size_t)snprintf(header, sizeof(header), "P6\n%d %d\n255\n", WIDE_WIDTH,
+                                          WIDE_HEIGHT);
+    if (compare_banded(&config, 2, wide_header + (3 * (size_t)WIDE_WIDTH * WIDE_HEIGHT)) != 0) {
+        printf("✗ Multi-tile rows differ when banded\n\n");
+        return 1;
+    }
+    simplex_set_image_size(&config, WIDTH, HEIGHT);
+    printf("✓ Banded images match in every normalization mode\n\n");
+
+    // Test 3: RAW and PGM formats
+    printf("Test 3: Formats...\n");
+    config.format = SIMPLEX_IMAGE_RAW;
+    config.color_mode = SIMPLEX_COLOR_HEIGHTMAP;
+    if (compare_banded(&config, 2, 3 * PIXELS) != 0) {
+        printf("✗ RAW output has the wrong size or content\n\n");
+        return 1;
+    }
+    config.format = SIMPLEX_IMAGE_PGM;
+    simplex_set_image_filename(&config, SINGLE_FILE);
+    if (simplex_generate_2d_image(&config) != -1) {
+        printf("✗ PGM accepted a color image\n\n");
+        return 1;
+    }
+    config.color_mode = SIMPLEX_COLOR_GRAYSCALE;
+    if (compare_banded(&config, 2, gray_header + PIXELS) != 0) {
+        printf("✗ PGM output has the wrong size or content\n\n");
+        return 1;
+    }
+    printf("✓ RAW and PGM written\n\n");
+
+    simplex_cleanup();
+
+    printf("All image streaming tests passed! ✓\n");
+    return 0;
+}
@@ -0,0 +1,242 @@
+/**
+ * @file test_image_tiles.c
+ * @brief Distributed tile rendering and assembly test
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @author Adrian Paredez
+ * @version 1.0
+ * @date 9/5/2025
+ */
+
+#include <simplex_image.h>
+#include <simplex_noise.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test_util.h"
+
+// Three aligned tile columns, the last one clipped, and a short last tile row
+#define WIDTH 1100
+#define HEIGHT 37
+#define TILE_HEIGHT 16
+#define UNALIGNED_TILE_WIDTH 300
+#define STRIP_HEIGHT 10
+#define ROOMY_MEMORY_MB 256.0
+// A few rows per band, so tiles are banded as well
+#define BANDED_MEMORY_MB 0.01
+#define IMAGE_FILE "test_tiles_image.ppm"
+#define MAX_TILES 16
+
+// Growable byte buffer filled by the stream callback
+typedef struct {
+    unsigned char* data;
+    size_t size;
+} collector_t;
+
+static int collect(void* user_data, const void* data, size_t size) {
+    collector_t* collector = user_data;
+    unsigned char* grown = realloc(collector->data, collector->size + size);
+    if (!grown) {
+        return 1;
+    }
+    memcpy(grown + collector->size, data, size);
+    collector->data = grown;
+    collector->size += size;
+    return 0;
+}
+
+// The whole image rendered into a new buffer; returns its size or 0 on failure
+static size_t render_whole(const simplex_image_config_t* config, unsigned char** image) {
+    size_t size = simplex_image_encoded_size(config);
+    *image = malloc(size);
+    if (!*image || simplex_render_to_buffer(config, *image, size, &size) != 0) {
+        return 0;
+    }
+    return size;
+}
+
+/* Render every tile of a grid to its own file and assemble them; returns the
+ * assembled image's size or 0 on failure */
+static size_t render_tiles(const simplex_image_config_t* config, int tile_width,
+                           unsigned char** image) {
+    char names[MAX_TILES][48];
+    const char* files[MAX_TILES];
+    int columns = ((config->width - 1) / tile_width) + 1;
+    int rows = ((config->height - 1) / TILE_HEIGHT) + 1;
+    if (columns * rows > MAX_TILES) {
+        return 0;
+    }
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < columns; c++) {
+            int index = (r * columns) + c;
+            simplex_image_tile_t tile = {tile_width, TILE_HEIGHT, c, r};
+            simplex_image_config_t node = *config;
+            snprintf(names[index], sizeof(names[index]), "test_tile_%d_%d.img", c, r);
+            strncpy(node.filename, names[index], sizeof(node.filename) - 1);
+            files[index] = names[index];
+            if (simplex_generate_image_tile(&node, &tile) != 0) {
+                return 0;
+            }
+        }
+    }
+    int assembled = simplex_assemble_image_tiles(config, tile_width, TILE_HEIGHT, files);
+    for (int i = 0; i < columns * rows; i++) {
+        remove(files[i]);
+    }
+    size_t size = assembled == 0 ? read_file(config->filename, image) : 0;
+    remove(config->filename);
+    return size;
+}
+
+int main(void) {
+    printf("Simplex Noise Tiled Rendering Test\n");
+    printf("==================================\n\n");
+
+    simplex_image_config_t config = simplex_get_default_image_config();
+    config.width = WIDTH;
+    config.height = HEIGHT;
+    config.format = SIMPLEX_IMAGE_PPM;
+    config.color_mode = SIMPLEX_COLOR_HEIGHTMAP;
+    config.auto_normalize = SIMPLEX_NORMALIZE_BOUNDED;
+    config.scale = 0.011;
+    config.offset_x = -40.0;
+    config.offset_y = 12.0;
+    config.octaves = 3;
+    config.seed = 4242;  // NOLINT(readability-magic-numbers)
+    strncpy(config.filename, IMAGE_FILE, sizeof(config.filename) - 1);
+
+    // Test 1: Aligned tiles assemble into the whole image, byte for byte
+    printf("Test 1: Aligned tile grid...\n");
+    set_limits(BANDED_MEMORY_MB, 4);
+    unsigned char* whole = NULL;
+    unsigned char* tiled = NULL;
+    size_t whole_size = render_whole(&config, &whole);
+    size_t tiled_size = render_tiles(&config, SIMPLEX_IMAGE_TILE_ALIGN, &tiled);
+    if (whole_size == 0 || tiled_size != whole_size || memcmp(whole, tiled, whole_size) != 0) {
+        printf("✗ Assembled tiles differ from the whole image\n\n");
+        return 1;
+    }
+    free(tiled);
+    printf("✓ Assembled image identical\n\n");
+
+    // Test 2: Unaligned tiles agree to within sample rounding
+    printf("Test 2: Unaligned tile grid...\n");
+    tiled_size = render_tiles(&config, UNALIGNED_TILE_WIDTH, &tiled);
+    size_t differing = 0;
+    for (size_t i = 0; i < tiled_size && tiled_size == whole_size; i++) {
+        int delta = (int)tiled[i] - (int)whole[i];
+        if (delta < -1 || delta > 1) {
+            differing = whole_size;
+            break;
+        }
+        differing += delta != 0;
+    }
+    if (tiled_size != whole_size || differing > whole_size / 1000) {
+        printf("✗ Unaligned tiles differ from the whole image\n\n");
+        return 1;
+    }
+    free(tiled);
+    free(whole);
+    printf("✓ Unaligned tiles match to rounding\n\n");
+
+    // Test 3: Full-width strips concatenate into the image, exact normalization via a range
+    printf("Test 3: Concatenated strips with a measured range...\n");
+    simplex_image_config_t exact = config;
+    exact.color_mode = SIMPLEX_COLOR_GRAYSCALE16;
+    exact.auto_normalize = SIMPLEX_NORMALIZE_EXACT;
+    whole_size = render_whole(&exact, &whole);
+    simplex_image_config_t strips = exact;
+    strips.auto_normalize = SIMPLEX_NORMALIZE_BOUNDED;
+    collector_t joined = {NULL, 0};
+    if (simplex_measure_image_range(&strips, &strips.min_value, &strips.max_value) != 0 ||
+        strips.min_value >= strips.max_value) {
+        printf("✗ Range measurement failed\n\n");
+        return 1;
+    }
+    for (int row = 0; row * STRIP_HEIGHT < HEIGHT; row++) {
+        simplex_image_tile_t strip = {WIDTH, STRIP_HEIGHT, 0, row};
+        if (simplex_render_tile_to_stream(&strips, &strip, collect, &joined) != 0) {
+            printf("✗ Strip %d failed\n\n", row);
+            return 1;
+        }
+    }
+    if (whole_size == 0 || joined.size != whole_size ||
+        memcmp(joined.data, whole, whole_size) != 0) {
+        printf("✗ Concatenated strips differ from the exactly normalized image\n\n");
+        return 1;
+    }
+    free(joined.data);
+    free(whole);
+    printf("✓ Strips concatenate into the image\n\n");
+
+    // Test 4: A tile is the same whatever the size of the full image
+    printf("Test 4: Tiles independent of the image size...\n");
+    set_limits(ROOMY_MEMORY_MB, 1);
+    simplex_image_config_t huge = config;
+    huge.width = WIDTH * 1000;
+    huge.height = HEIGHT * 1000;
+    simplex_image_tile_t inner = {SIMPLEX_IMAGE_TILE_ALIGN, TILE_HEIGHT, 1, 1};
+    size_t small_size = simplex_image_tile_encoded_size(&config, &inner);
+    unsigned char* small = malloc(small_size);
+    unsigned char* large = malloc(small_size);
+    size_t large_size = 0;
+    if (!small || !large ||
+        simplex_render_tile_to_buffer(&config, &inner, small, small_size, NULL) != 0 ||
+        simplex_render_tile_to_buffer(&huge, &inner, large, small_size, &large_size) != 0 ||
+        large_size != small_size || memcmp(small, large, small_size) != 0) {
+        printf("✗ Tile depends on the full image size\n\n");
+        return 1;
+    }
+    free(small);
+    free(large);
+    printf("✓ Same tile for every image size\n\n");
+
+    // Test 5: Invalid tiles and damaged tile sets are rejected
+    printf("Test 5: Validation...\n");
+    simplex_image_tile_t outside = {SIMPLEX_IMAGE_TILE_ALIGN, TILE_HEIGHT, 3, 0};
+    simplex_image_tile_t below = {SIMPLEX_IMAGE_TILE_ALIGN, TILE_HEIGHT, 0, 3};
+    simplex_image_tile_t empty = {0, TILE_HEIGHT, 0, 0};
+    simplex_image_tile_t first = {SIMPLEX_IMAGE_TILE_ALIGN, TILE_HEIGHT, 0, 0};
+    simplex_image_config_t png = config;
+    png.format = SIMPLEX_IMAGE_PNG;
+    if (simplex_image_tile_encoded_size(&config, &outside) != 0 ||
+        simplex_image_tile_encoded_size(&config, &below) != 0 ||
+        simplex_image_tile_encoded_size(&config, &empty) != 0 ||
+        simplex_image_tile_encoded_size(&config, NULL) != 0 ||
+        simplex_generate_image_tile(&exact, &first) != -1 ||
+        simplex_generate_image_tile(&png, &first) != -1 ||
+        simplex_render_tile_to_stream(&config, &first, NULL, NULL) != -1 ||
+        simplex_measure_image_range(&config, NULL, NULL) != -1) {
+        printf("✗ Invalid tile accepted\n\n");
+        return 1;
+    }
+    const char* missing[MAX_TILES] = {"missing_tile.img"};
+    simplex_image_config_t single = config;
+    single.width = 40;
+    single.height = 8;
+    const char* short_set[] = {IMAGE_FILE};
+    strncpy(single.filename, "test_tiles_single.img", sizeof(single.filename) - 1);
+    simplex_image_tile_t whole_tile = {40, 8, 0, 0};
+    simplex_image_tile_t half_tile = {40, 4, 0, 0};
+    simplex_image_config_t fragment = single;
+    strncpy(fragment.filename, IMAGE_FILE, sizeof(fragment.filename) - 1);
+    if (simplex_assemble_image_tiles(&single, 40, 8, missing) != -1 ||
+        simplex_generate_image_tile(&fragment, &half_tile) != 0 ||
+        simplex_assemble_image_tiles(&single, 40, 8, short_set) != -1 ||
+        simplex_generate_image_tile(&fragment, &whole_tile) != 0 ||
+        simplex_assemble_image_tiles(&single, 40, 8, short_set) != 0) {
+        printf("✗ Damaged tile set accepted or good one rejected\n\n");
+        return 1;
+    }
+    remove(IMAGE_FILE);
+    remove(single.filename);
+    printf("✓ Invalid tiles and damaged tile sets rejected\n\n");
+
+    simplex_cleanup();
+
+    printf("All tiled rendering tests passed! ✓\n");
+    return 0;
+}
@@ -0,0 +1,288 @@
+/**
+ * @file test_jobs.c
+ * @brief Asynchronous job queue test
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @author Adrian Paredez
+ * @version 1.0
+ * @date 9/5/2025
+ */
+
+#include <simplex_image.h>
+#include <simplex_noise.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test_util.h"
+
+#define WIDTH 80
+#define HEIGHT 30
+#define STEP 0.043
+#define X0 -2.5
+#define Y0 7.25
+#define OCTAVES 5
+#define IMAGE_FILE "test_jobs_image.ppm"
+#define MAX_EVENTS 8
+
+// Holds the general runner inside a callback until released
+typedef struct {
+    volatile int started;
+    volatile int release;
+} gate_t;
+
+// Callback statuses in the order they were reported
+typedef struct {
+    char names[MAX_EVENTS];
+    simplex_job_status_t statuses[MAX_EVENTS];
+    volatile int count;
+} event_log_t;
+
+typedef struct {
+    event_log_t* log;
+    char name;
+} tagged_t;
+
+static void hold_gate(simplex_job_t* job, simplex_job_status_t status, void* user_data) {
+    (void)job;
+    (void)status;
+    gate_t* gate = user_data;
+    gate->started = 1;
+    while (!gate->release) {
+    }
+}
+
+static void record(simplex_job_t* job, simplex_job_status_t status, void* user_data) {
+    (void)job;
+    tagged_t* tag = user_data;
+    event_log_t* log = tag->log;
+    if (log->count < MAX_EVENTS) {
+        log->names[log->count] = tag->name;
+        log->statuses[log->count] = status;
+        log->count++;
+    }
+}
+
+// Cancelled during simplex_cleanup(): lets the held runner go so it can be joined
+static void release_gate(simplex_job_t* job, simplex_job_status_t status, void* user_data) {
+    (void)job;
+    gate_t* gate = user_data;
+    gate->release = status == SIMPLEX_JOB_CANCELLED ? 2 : 1;
+}
+
+static simplex_array_params_t grid(int octaves) {
+    simplex_array_params_t params = {X0, Y0, WIDTH, HEIGHT, STEP, octaves, 0.5, 2.0};
+    return params;
+}
+
+static simplex_image_config_t image_config(void) {
+    simplex_image_config_t config = simplex_get_default_image_config();
+    config.width = WIDTH;
+    config.height = HEIGHT;
+    config.color_mode = SIMPLEX_COLOR_TERRAIN;
+    config.seed = 4242;  // NOLINT(readability-magic-numbers)
+    strncpy(config.filename, IMAGE_FILE, sizeof(config.filename) - 1);
+    return config;
+}
+
+int main(void) {
+    printf("Simplex Noise Asynchronous Job Test\n");
+    printf("===================================\n\n");
+
+    size_t samples = (size_t)WIDTH * HEIGHT;
+    double* expected = malloc(samples * sizeof(double));
+    double* outputs[4];
+    for (int i = 0; i < 4; i++) {
+        outputs[i] = malloc(samples * sizeof(double));
+        if (!outputs[i]) {
+            return 1;
+        }
+    }
+    if (!expected) {
+        return 1;
+    }
+    simplex_config_t config = simplex_get_default_config();
+    config.max_threads = 4;
+    config.seed = 777;  // NOLINT(readability-magic-numbers)
+    simplex_noise_init_advanced(&config);
+
+    // Test 1: Array jobs produce the blocking results and report completion
+    printf("Test 1: Array jobs...\n");
+    event_log_t log = {{0}, {0}, 0};
+    tagged_t noise_tag = {&log, 'n'};
+    tagged_t fbm_tag = {&log, 'f'};
+    simplex_array_params_t noise = grid(1);
+    simplex_array_params_t fbm = grid(OCTAVES);
+    simplex_context_t* ctx = simplex_context_create(&config);
+    simplex_job_t* jobs[4] = {NULL};
+    if (!ctx ||
+        simplex_submit_array_2d(NULL, &noise, outputs[0], SIMPLEX_JOB_NORMAL, record, &noise_tag,
+                                &jobs[0]) != 0 ||
+        simplex_submit_array_2d(ctx, &fbm, outputs[1], SIMPLEX_JOB_BACKGROUND, record, &fbm_tag,
+                                &jobs[1]) != 0 ||
+        simplex_job_wait_all(jobs, 2) != 0 || simplex_job_status(jobs[0]) != SIMPLEX_JOB_DONE ||
+        log.count != 2 || log.statuses[0] != SIMPLEX_JOB_DONE ||
+        log.statuses[1] != SIMPLEX_JOB_DONE) {
+        printf("✗ Array jobs failed\n\n");
+        return 1;
+    }
+    simplex_noise_array_2d(X0, Y0, WIDTH, HEIGHT, STEP, expected);
+    int same = memcmp(expected, outputs[0], samples * sizeof(double)) == 0;
+    simplex_fbm_array_2d_ctx(ctx, X0, Y0, WIDTH, HEIGHT, STEP, OCTAVES, 0.5, 2.0, expected);
+    same = same && memcmp(expected, outputs[1], samples * sizeof(double)) == 0;
+    simplex_job_release(jobs[0]);
+    simplex_job_release(jobs[1]);
+    if (!same) {
+        printf("✗ Job output differs from the blocking call\n\n");
+        return 1;
+    }
+    printf("✓ Jobs match the blocking calls\n\n");
+
+    // Test 2: Priorities, the interactive runner and cancellation
+    printf("Test 2: Priorities and cancellation...\n");
+    gate_t gate = {0, 0};
+    simplex_job_t* held = NULL;
+    if (simplex_submit_array_2d(ctx, &noise, outputs[0], SIMPLEX_JOB_BACKGROUND, hold_gate, &gate,
+                                &held) != 0) {
+        printf("✗ Submission failed\n\n");
+        return 1;
+    }
+    while (!gate.started) {
+    }
+    log.count = 0;
+    tagged_t background_a = {&log, 'a'};
+    tagged_t background_b = {&log, 'b'};
+    tagged_t normal_c = {&log, 'c'};
+    simplex_job_t* interactive = NULL;
+    if (simplex_submit_array_2d(ctx, &fbm, outputs[1], SIMPLEX_JOB_BACKGROUND, record,
+                                &background_a, &jobs[0]) != 0 ||
+        simplex_submit_array_2d(ctx, &fbm, outputs[2], SIMPLEX_JOB_BACKGROUND, record,
+                                &background_b, &jobs[1]) != 0 ||
+        simplex_submit_array_2d(ctx, &fbm, outputs[3], SIMPLEX_JOB_NORMAL, record, &normal_c,
+                                &jobs[2]) != 0 ||
+        simplex_submit_array_2d(ctx, &noise, expected, SIMPLEX_JOB_INTERACTIVE, NULL, NULL,
+                                &interactive) != 0) {
+        printf("✗ Submission failed\n\n");
+        return 1;
+    }
+    // The general runner is still held, so only the interactive runner makes progress
+    if (simplex_job_wait(interactive) != SIMPLEX_JOB_DONE ||
+        simplex_job_status(jobs[0]) != SIMPLEX_JOB_QUEUED ||
+        simplex_job_status(held) != SIMPLEX_JOB_RUNNING) {
+        printf("✗ Interactive job waited behind background work\n\n");
+        return 1;
+    }
+    if (simplex_job_cancel(jobs[1]) != 0 || simplex_job_cancel(jobs[1]) != -1 ||
+        simplex_job_cancel(interactive) != -1 ||
+        simplex_job_status(jobs[1]) != SIMPLEX_JOB_CANCELLED || log.count != 1 ||
+        log.names[0] != 'b' || log.statuses[0] != SIMPLEX_JOB_CANCELLED) {
+        printf("✗ Cancellation failed\n\n");
+        return 1;
+    }
+    gate.release = 1;
+    simplex_job_t* batch[] = {held, jobs[0], jobs[2]};
+    if (simplex_job_wait_all(batch, 3) != 0 || simplex_job_wait_all(jobs, 3) != -1 ||
+        log.count != 3 || log.names[1] != 'c' || log.names[2] != 'a') {
+        printf("✗ Jobs did not run in priority order\n\n");
+        return 1;
+    }
+    for (int i = 0; i < 3; i++) {
+        simplex_job_release(jobs[i]);
+    }
+    simplex_job_release(held);
+    simplex_job_release(interactive);
+    printf("✓ Interactive jobs bypass the queue, pending jobs cancel\n\n");
+
+    // Test 3: Image jobs render the blocking images without reseeding the default context
+    printf("Test 3: Image jobs...\n");
+    simplex_image_config_t image = image_config();
+    size_t size = simplex_image_encoded_size(&image);
+    unsigned char* buffer = malloc(size);
+    unsigned char* file_bytes = NULL;
+    unsigned char* blocking = malloc(size);
+    size_t written = 0;
+    simplex_config_t after;
+    if (!buffer || !blocking ||
+        simplex_submit_image_to_buffer(&image, buffer, size, &written, SIMPLEX_JOB_INTERACTIVE,
+                                       NULL, NULL, &jobs[0]) != 0 ||
+        simplex_submit_image(&image, SIMPLEX_JOB_NORMAL, NULL, NULL, &jobs[1]) != 0 ||
+        simplex_job_wait_all(jobs, 2) != 0 || written != size ||
+        read_file(IMAGE_FILE, &file_bytes) != size ||
+        simplex_context_get_config(NULL, &after) != 0 || after.seed != config.seed) {
+        printf("✗ Image jobs failed or reseeded the default context\n\n");
+        return 1;
+    }
+    simplex_job_release(jobs[0]);
+    simplex_job_release(jobs[1]);
+    remove(IMAGE_FILE);
+    if (simplex_render_to_buffer(&image, blocking, size, NULL) != 0 ||
+        memcmp(blocking, buffer, size) != 0 || memcmp(blocking, file_bytes, size) != 0) {
+        printf("✗ Image jobs differ from the blocking render\n\n");
+        return 1;
+    }
+    free(buffer);
+    free(file_bytes);
+    free(blocking);
+    printf("✓ Same images, default context untouched\n\n");
+
+    // Test 4: Invalid requests are rejected
+    printf("Test 4: Validation...\n");
+    simplex_array_params_t empty = grid(1);
+    empty.width = 0;
+    simplex_array_params_t no_octaves = grid(0);
+    simplex_image_config_t bad_image = image_config();
+    bad_image.height = 0;
+    unsigned char small[4];
+    if (simplex_submit_array_2d(NULL, NULL, expected, SIMPLEX_JOB_NORMAL, NULL, NULL, NULL) !=
+            -1 ||
+        simplex_submit_array_2d(NULL, &noise, NULL, SIMPLEX_JOB_NORMAL, NULL, NULL, NULL) != -1 ||
+        simplex_submit_array_2d(NULL, &empty, expected, SIMPLEX_JOB_NORMAL, NULL, NULL, NULL) !=
+            -1 ||
+        simplex_submit_array_2d(NULL, &no_octaves, expected, SIMPLEX_JOB_NORMAL, NULL, NULL,
+                                NULL) != -1 ||
+        simplex_submit_array_2d(NULL, &noise, expected, SIMPLEX_JOB_PRIORITY_COUNT, NULL, NULL,
+                                NULL) != -1 ||
+        simplex_submit_image(&bad_image, SIMPLEX_JOB_NORMAL, NULL, NULL, NULL) != -1 ||
+        simplex_submit_image_to_buffer(&image, small, sizeof(small), NULL, SIMPLEX_JOB_NORMAL,
+                                       NULL, NULL, NULL) != -1 ||
+        simplex_job_cancel(NULL) != -1 || simplex_job_wait(NULL) != SIMPLEX_JOB_FAILED ||
+        simplex_job_wait_all(NULL, 1) != -1) {
+        printf("✗ Invalid request accepted\n\n");
+        return 1;
+    }
+    simplex_job_release(NULL);
+    printf("✓ Invalid requests rejected\n\n");
+
+    // Test 5: Cleanup cancels queued jobs and waits for running ones
+    printf("Test 5: Cleanup with queued jobs...\n");
+    gate_t cleanup_gate = {0, 0};
+    if (simplex_submit_array_2d(ctx, &noise, outputs[0], SIMPLEX_JOB_BACKGROUND, hold_gate,
+                                &cleanup_gate, NULL) != 0) {
+        printf("✗ Submission failed\n\n");
+        return 1;
+    }
+    while (!cleanup_gate.started) {
+    }
+    if (simplex_submit_array_2d(ctx, &fbm, outputs[1], SIMPLEX_JOB_BACKGROUND, release_gate,
+                                (void*)&cleanup_gate, NULL) != 0) {
+        printf("✗ Submission failed\n\n");
+        return 1;
+    }
+    simplex_cleanup();
+    if (cleanup_gate.release != 2) {
+        printf("✗ Queued job not cancelled by cleanup\n\n");
+        return 1;
+    }
+    printf("✓ Cleanup cancelled the queued job\n\n");
+
+    simplex_context_destroy(ctx);
+    for (int i = 0; i < 4; i++) {
+        free(outputs[i]);
+    }
+    free(expected);
+
+    printf("All asynchronous job tests passed! ✓\n");
+    return 0;
+}
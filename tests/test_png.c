@@ -0,0 +1,284 @@
+/**
+ * @file test_png.c
+ * @brief PNG encoder test: decode the output and compare it with RAW pixels
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @author Adrian Paredez
+ * @version 1.0
+ * @date 9/5/2025
+ */
+
+#include <simplex_image.h>
+#include <simplex_noise.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(SIMPLEX_HAVE_ZLIB)
+#include <zlib.h>
+#endif
+
+#include "test_util.h"
+
+#define WIDTH 300
+#define HEIGHT 211
+#define ROOMY_MEMORY_MB 256.0
+// A few pixel rows, so rows reach the encoder in many batches
+#define BANDED_MEMORY_MB 0.01
+#define PNG_FILE "test_png_output.png"
+#define RAW_FILE "test_png_output.raw"
+
+/* ===== DECODING ===== */
+
+static uint32_t get_u32(const unsigned char* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static uint32_t crc32_bytes(uint32_t crc, const unsigned char* data, size_t size) {
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1U)));
+        }
+    }
+    return ~crc;
+}
+
+// Inflate a zlib stream of known size; stored blocks only without zlib
+static int inflate_stream(const unsigned char* data, size_t size, unsigned char* out,
+                          size_t out_size) {
+#if defined(SIMPLEX_HAVE_ZLIB)
+    uLongf length = (uLongf)out_size;
+    return uncompress(out, &length, data, (uLong)size) == Z_OK && length == out_size ? 0 : -1;
+#else
+    size_t in = 2;
+    size_t written = 0;
+    while (in < size) {
+        if (data[in] == 0x03 && data[in + 1] == 0x00) {
+            return written == out_size ? 0 : -1;  // Empty final block
+        }
+        size_t length = data[in + 1] | ((size_t)data[in + 2] << 8);
+        if (data[in] != 0x00 || written + length > out_size) {
+            return -1;
+        }
+        memcpy(out + written, data + in + 5, length);
+        written += length;
+        in += 5 + length;
+    }
+    return -1;
+#endif
+}
+
+static int paeth(int a, int b, int c) {
+    int p = a + b - c;
+    int pa = abs(p - a);
+    int pb = abs(p - b);
+    int pc = abs(p - c);
+    return pa <= pb && pa <= pc ? a : (pb <= pc ? b : c);
+}
+
+// Undo the row filters in place; returns 0 if every filter type was valid
+static int unfilter(unsigned char* data, unsigned char* pixels, int height, size_t row_bytes,
+                    int bpp) {
+    for (int y = 0; y < height; y++) {
+        const unsigned char* in = data + ((size_t)y * (row_bytes + 1));
+        unsigned char* row = pixels + ((size_t)y * row_bytes);
+        const unsigned char* prev = y > 0 ? row - row_bytes : NULL;
+        for (size_t i = 0; i < row_bytes; i++) {
+            int left = i >= (size_t)bpp ? row[i - bpp] : 0;
+            int up = prev ? prev[i] : 0;
+            int corner = prev && i >= (size_t)bpp ? prev[i - bpp] : 0;
+            int predictor = in[0] == 0   ? 0
+                            : in[0] == 1 ? left
+                            : in[0] == 2 ? up
+                            : in[0] == 3 ? (left + up) / 2
+                                         : paeth(left, up, corner);
+            if (in[0] > 4) {
+                return -1;
+            }
+            row[i] = (unsigned char)(in[1 + i] + predictor);
+        }
+    }
+    return 0;
+}
+
+/* Decode a PNG written by the library: check the signature, every chunk CRC and
+ * the header, then inflate and unfilter its pixels. Returns the pixel bytes. */
+static unsigned char* decode_png(const unsigned char* png, size_t size, int bit_depth,
+                                 int color_type, size_t* pixel_size) {
+    static const unsigned char signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    if (size < 8 || memcmp(png, signature, 8) != 0) {
+        return NULL;
+    }
+    unsigned char* idat = malloc(size);
+    size_t idat_size = 0;
+    int width = 0;
+    int height = 0;
+    int ended = 0;
+    for (size_t at = 8; idat && !ended && at + 12 <= size;) {
+        uint32_t length = get_u32(png + at);
+        const unsigned char* type = png + at + 4;
+        if (at + 12 + length > size ||
+            crc32_bytes(0, type, 4 + (size_t)length) != get_u32(type + 4 + length)) {
+            break;
+        }
+        if (memcmp(type, "IHDR", 4) == 0) {
+            width = (int)get_u32(type + 4);
+            height = (int)get_u32(type + 8);
+            if (type[12] != bit_depth || type[13] != color_type || type[16] != 0) {
+                break;
+            }
+        } else if (memcmp(type, "IDAT", 4) == 0) {
+            memcpy(idat + idat_size, type + 4, length);
+            idat_size += length;
+        } else if (memcmp(type, "IEND", 4) == 0) {
+            ended = at + 12 == size;
+        }
+        at += 12 + (size_t)length;
+    }
+
+    int bpp = (color_type == 2 ? 3 : 1) * (bit_depth / 8);
+    size_t row_bytes = (size_t)width * bpp;
+    size_t filtered_size = (size_t)height * (row_bytes + 1);
+    unsigned char* filtered = ended && width > 0 ? malloc(filtered_size) : NULL;
+    unsigned char* pixels = filtered ? malloc(row_bytes * height) : NULL;
+    int ok = pixels && inflate_stream(idat, idat_size, filtered, filtered_size) == 0 &&
+             unfilter(filtered, pixels, height, row_bytes, bpp) == 0;
+    free(idat);
+    free(filtered);
+    if (!ok) {
+        free(pixels);
+        return NULL;
+    }
+    *pixel_size = row_bytes * height;
+    return pixels;
+}
+
+/* ===== HELPERS ===== */
+
+// Write config as PNG and as RAW, and check the decoded PNG against the RAW pixels
+static int check_png(const simplex_image_config_t* config, int bit_depth, int color_type,
+                     double memory_limit_mb, size_t* png_size) {
+    simplex_image_config_t png_config = *config;
+    simplex_image_config_t raw_config = *config;
+    png_config.format = SIMPLEX_IMAGE_PNG;
+    raw_config.format = SIMPLEX_IMAGE_RAW;
+    simplex_set_image_filename(&png_config, PNG_FILE);
+    simplex_set_image_filename(&raw_config, RAW_FILE);
+    set_limits(memory_limit_mb, 4);
+    int png_result = simplex_generate_2d_image(&png_config);
+    int raw_result = simplex_generate_2d_image(&raw_config);
+
+    unsigned char* png = NULL;
+    unsigned char* raw = NULL;
+    *png_size = read_file(PNG_FILE, &png);
+    size_t raw_size = read_file(RAW_FILE, &raw);
+    size_t pixel_size = 0;
+    unsigned char* pixels = png_result == 0 && raw_result == 0
+                                ? decode_png(png, *png_size, bit_depth, color_type, &pixel_size)
+                                : NULL;
+    int ok = pixels && pixel_size == raw_size && memcmp(pixels, raw, raw_size) == 0 &&
+             *png_size <= simplex_image_encoded_size(&png_config);
+    free(png);
+    free(raw);
+    free(pixels);
+    remove(PNG_FILE);
+    remove(RAW_FILE);
+    return ok;
+}
+
+int main(void) {
+    printf("Simplex Noise PNG Test\n");
+    printf("======================\n\n");
+
+    simplex_image_config_t config = simplex_get_default_image_config();
+    simplex_set_image_size(&config, WIDTH, HEIGHT);
+    simplex_set_noise_params(&config, 0.01, 4, 0.5, 2.0);
+    size_t size = 0;
+
+    // Test 1: Every filter and a range of levels decode to the RAW pixels
+    printf("Test 1: Filters and compression levels...\n");
+    static const int levels[] = {0, 1, 6, 9};
+    for (int filter = 0; filter < SIMPLEX_PNG_FILTER_COUNT; filter++) {
+        for (size_t l = 0; l < sizeof(levels) / sizeof(levels[0]); l++) {
+            config.png_filter = (simplex_png_filter_t)filter;
+            config.png_compression = levels[l];
+            config.color_mode = SIMPLEX_COLOR_TERRAIN;
+            if (!check_png(&config, 8, 2, ROOMY_MEMORY_MB, &size)) {
+                printf("✗ Filter %d, level %d does not round-trip\n\n", filter, levels[l]);
+                return 1;
+            }
+        }
+    }
+    printf("✓ All filters and levels round-trip\n\n");
+
+    // Test 2: Grayscale, 16-bit grayscale and banded rows
+    printf("Test 2: Color types and bands...\n");
+    config.png_filter = SIMPLEX_PNG_FILTER_PAETH;
+    config.png_compression = 6;
+    config.color_mode = SIMPLEX_COLOR_GRAYSCALE;
+    size_t gray_size = 0;
+    size_t gray16_size = 0;
+    int ok = check_png(&config, 8, 0, ROOMY_MEMORY_MB, &gray_size) &&
+             check_png(&config, 8, 0, BANDED_MEMORY_MB, &size);
+    config.color_mode = SIMPLEX_COLOR_GRAYSCALE16;
+    config.png_filter = SIMPLEX_PNG_FILTER_ADAPTIVE;
+    ok = ok && check_png(&config, 16, 0, ROOMY_MEMORY_MB, &gray16_size) &&
+         check_png(&config, 16, 0, BANDED_MEMORY_MB, &size);
+    if (!ok) {
+        printf("✗ Grayscale or banded PNG does not round-trip\n\n");
+        return 1;
+    }
+#if defined(SIMPLEX_HAVE_ZLIB)
+    if (gray_size >= (size_t)WIDTH * HEIGHT / 2) {
+        printf("✗ Smooth grayscale noise compressed to %zu bytes\n\n", gray_size);
+        return 1;
+    }
+#endif
+    printf("✓ 8-bit PNG %zu bytes, 16-bit PNG %zu bytes for %d pixels\n\n", gray_size,
+           gray16_size, WIDTH * HEIGHT);
+
+    // Test 3: 16-bit samples in PGM and heightmaps, PNG in memory
+    printf("Test 3: 16-bit PGM, heightmaps and buffers...\n");
+    set_limits(ROOMY_MEMORY_MB, 1);
+    config.format = SIMPLEX_IMAGE_PGM;
+    simplex_set_image_filename(&config, RAW_FILE);
+    unsigned char* file = NULL;
+    char header[64];
+    size_t header_size =
+        (size_t)snprintf(header, sizeof(header), "P5\n%d %d\n65535\n", WIDTH, HEIGHT);
+    if (simplex_generate_heightmap(&config) != 0 ||
+        read_file(RAW_FILE, &file) != header_size + (2 * (size_t)WIDTH * HEIGHT) ||
+        memcmp(file, header, header_size) != 0) {
+        printf("✗ 16-bit heightmap PGM has the wrong header or size\n\n");
+        return 1;
+    }
+    free(file);
+    remove(RAW_FILE);
+
+    config.format = SIMPLEX_IMAGE_PNG;
+    simplex_set_image_filename(&config, PNG_FILE);
+    size_t bound = simplex_image_encoded_size(&config);
+    unsigned char* buffer = malloc(bound);
+    size_t written = 0;
+    size_t file_size = 0;
+    if (!buffer || simplex_generate_2d_image(&config) != 0 ||
+        (file_size = read_file(PNG_FILE, &file)) == 0 ||
+        simplex_render_to_buffer(&config, buffer, bound, &written) != 0 ||
+        written != file_size || memcmp(buffer, file, file_size) != 0) {
+        printf("✗ PNG rendered in memory differs from the file\n\n");
+        return 1;
+    }
+    free(file);
+    free(buffer);
+    remove(PNG_FILE);
+    printf("✓ 16-bit samples written, in-memory PNG matches the file\n\n");
+
+    simplex_cleanup();
+
+    printf("All PNG tests passed! ✓\n");
+    return 0;
+}
@@ -0,0 +1,246 @@
+/**
+ * @file test_points.c
+ * @brief Scattered-point array functions vs per-point evaluation test, in every layout
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @author Adrian Paredez
+ * @version 1.0
+ * @date 9/5/2025
+ */
+
+#include <simplex_noise.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Several 512-sample tiles, the last one partial
+#define COUNT 1337
+#define OCTAVES 5
+#define PERSISTENCE 0.55
+#define LACUNARITY 2.1
+
+enum { POINT_NOISE_2D = 0, POINT_NOISE_3D, POINT_NOISE_4D, POINT_FBM_2D, POINT_FBM_3D,
+       POINT_RIDGED_2D, POINT_BILLOWY_2D, POINT_KIND_COUNT };
+
+static const char* const kind_names[POINT_KIND_COUNT] = {
+    "noise_2d_points", "noise_3d_points", "noise_4d_points", "fbm_2d_points",
+    "fbm_3d_points",   "ridged_2d_points", "billowy_2d_points"};
+
+static int run_kind(const simplex_context_t* ctx, int kind, const double* const* c,
+                    size_t count, double* output) {
+    switch (kind) {
+        case POINT_NOISE_2D:
+            return simplex_noise_2d_points_ctx(ctx, c[0], c[1], count, output);
+        case POINT_NOISE_3D:
+            return simplex_noise_3d_points_ctx(ctx, c[0], c[1], c[2], count, output);
+        case POINT_NOISE_4D:
+            return simplex_noise_4d_points_ctx(ctx, c[0], c[1], c[2], c[3], count, output);
+        case POINT_FBM_2D:
+            return simplex_fbm_2d_points_ctx(ctx, c[0], c[1], count, OCTAVES, PERSISTENCE,
+                                             LACUNARITY, output);
+        case POINT_FBM_3D:
+            return simplex_fbm_3d_points_ctx(ctx, c[0], c[1], c[2], count, OCTAVES, PERSISTENCE,
+                                             LACUNARITY, output);
+        case POINT_RIDGED_2D:
+            return simplex_ridged_2d_points_ctx(ctx, c[0], c[1], count, output);
+        default:
+            return simplex_billowy_2d_points_ctx(ctx, c[0], c[1], count, output);
+    }
+}
+
+static double expected_value(const simplex_context_t* ctx, int kind, const double* const* c,
+                             size_t i) {
+    switch (kind) {
+        case POINT_NOISE_2D:
+            return simplex_noise_2d_ctx(ctx, c[0][i], c[1][i]);
+        case POINT_NOISE_3D:
+            return simplex_noise_3d_ctx(ctx, c[0][i], c[1][i], c[2][i]);
+        case POINT_NOISE_4D:
+            return simplex_noise_4d_ctx(ctx, c[0][i], c[1][i], c[2][i], c[3][i]);
+        case POINT_FBM_2D:
+            return simplex_fbm_2d_ctx(ctx, c[0][i], c[1][i], OCTAVES, PERSISTENCE, LACUNARITY);
+        case POINT_FBM_3D:
+            return simplex_fbm_3d_ctx(ctx, c[0][i], c[1][i], c[2][i], OCTAVES, PERSISTENCE,
+                                      LACUNARITY);
+        case POINT_RIDGED_2D:
+            return simplex_ridged_2d_ctx(ctx, c[0][i], c[1][i]);
+        default:
+            return simplex_billowy_2d_ctx(ctx, c[0][i], c[1][i]);
+    }
+}
+
+// Noise of one dimension count through the double interleaved and float layouts
+static int run_layout(const simplex_context_t* ctx, int dims, int f32, const void* points,
+                      size_t stride, const float* const* f, size_t count, void* output) {
+    switch (dims * 4 + (points ? 2 : 0) + f32) {
+        case 2 * 4 + 2:
+            return simplex_noise_2d_points_aos_ctx(ctx, points, stride, count, output);
+        case 3 * 4 + 2:
+            return simplex_noise_3d_points_aos_ctx(ctx, points, stride, count, output);
+        case 4 * 4 + 2:
+            return simplex_noise_4d_points_aos_ctx(ctx, points, stride, count, output);
+        case 2 * 4 + 1:
+            return simplex_noise_2d_points_f32_ctx(ctx, f[0], f[1], count, output);
+        case 3 * 4 + 1:
+            return simplex_noise_3d_points_f32_ctx(ctx, f[0], f[1], f[2], count, output);
+        case 4 * 4 + 1:
+            return simplex_noise_4d_points_f32_ctx(ctx, f[0], f[1], f[2], f[3], count, output);
+        case 2 * 4 + 3:
+            return simplex_noise_2d_points_aos_f32_ctx(ctx, points, stride, count, output);
+        case 3 * 4 + 3:
+            return simplex_noise_3d_points_aos_f32_ctx(ctx, points, stride, count, output);
+        default:
+            return simplex_noise_4d_points_aos_f32_ctx(ctx, points, stride, count, output);
+    }
+}
+
+/* Interleaved points (with one padding element per point) must give the
+ * double results, float points the double results at the float coordinates
+ * rounded to float. */
+static int check_layouts(const simplex_context_t* ctx, const double* const* c) {
+    const size_t stride = 5;
+    double* aos = malloc(COUNT * stride * sizeof(double));
+    float* aos_f32 = malloc(COUNT * stride * sizeof(float));
+    float* soa_f32 = malloc(COUNT * 4 * sizeof(float));
+    double* output = malloc(COUNT * sizeof(double));
+    float* output_f32 = malloc(COUNT * sizeof(float));
+    if (!aos || !aos_f32 || !soa_f32 || !output || !output_f32) {
+        return 0;
+    }
+    const float* f[4];
+    for (int axis = 0; axis < 4; axis++) {
+        f[axis] = soa_f32 + ((size_t)axis * COUNT);
+        for (size_t i = 0; i < COUNT; i++) {
+            aos[(i * stride) + axis] = c[axis][i];
+            aos_f32[(i * stride) + axis] = (float)c[axis][i];
+            soa_f32[((size_t)axis * COUNT) + i] = (float)c[axis][i];
+        }
+    }
+
+    int ok = 1;
+    for (int dims = 2; dims <= 4 && ok; dims++) {
+        for (int layout = 0; layout < 3 && ok; layout++) {
+            int f32 = layout > 0;
+            const void* points = layout == 0 ? (const void*)aos
+                                 : layout == 2 ? (const void*)aos_f32
+                                               : NULL;
+            void* out = f32 ? (void*)output_f32 : (void*)output;
+            if (run_layout(ctx, dims, f32, points, stride, f, COUNT, out) != 0) {
+                printf("✗ %dD layout %d failed\n\n", dims, layout);
+                ok = 0;
+                break;
+            }
+            for (size_t i = 0; i < COUNT; i++) {
+                double x = f32 ? f[0][i] : c[0][i];
+                double y = f32 ? f[1][i] : c[1][i];
+                double z = f32 ? f[2][i] : c[2][i];
+                double w = f32 ? f[3][i] : c[3][i];
+                double expected = dims == 2   ? simplex_noise_2d_ctx(ctx, x, y)
+                                  : dims == 3 ? simplex_noise_3d_ctx(ctx, x, y, z)
+                                              : simplex_noise_4d_ctx(ctx, x, y, z, w);
+                if (f32 ? output_f32[i] != (float)expected : output[i] != expected) {
+                    printf("✗ %dD layout %d differs at point %zu\n\n", dims, layout, i);
+                    ok = 0;
+                    break;
+                }
+            }
+        }
+        // A stride shorter than a point is rejected
+        if (ok && run_layout(ctx, dims, 0, aos, (size_t)dims - 1, f, COUNT, output) == 0) {
+            printf("✗ %dD interleaved points with a short stride accepted\n\n", dims);
+            ok = 0;
+        }
+    }
+    free(aos);
+    free(aos_f32);
+    free(soa_f32);
+    free(output);
+    free(output_f32);
+    return ok;
+}
+
+int main(void) {
+    printf("Simplex Noise Point Array Test\n");
+    printf("==============================\n\n");
+
+    double* coords[4];
+    double* output = malloc(COUNT * sizeof(double));
+    for (int axis = 0; axis < 4; axis++) {
+        coords[axis] = malloc(COUNT * sizeof(double));
+        if (!coords[axis] || !output) {
+            return 1;
+        }
+    }
+    // Scattered, deterministic coordinates, including negative ones
+    srand(12345);  // NOLINT(readability-magic-numbers)
+    for (int axis = 0; axis < 4; axis++) {
+        for (size_t i = 0; i < COUNT; i++) {
+            coords[axis][i] = ((double)rand() / RAND_MAX * 200.0) - 100.0;
+        }
+    }
+    const double* const* c = (const double* const*)coords;
+
+    for (int simd = 0; simd <= 1; simd++) {
+        printf("Test %d: points vs point functions (SIMD %s)...\n", simd + 1,
+               simd ? "on" : "off");
+
+        simplex_config_t config = simplex_get_default_config();
+        config.seed = 4242;  // NOLINT(readability-magic-numbers)
+        config.enable_simd = simd;
+        config.max_threads = 4;
+        config.chunk_size = 512;  // NOLINT(readability-magic-numbers)
+        simplex_context_t* ctx = simplex_context_create(&config);
+        if (!ctx) {
+            printf("✗ Context creation failed\n\n");
+            return 1;
+        }
+
+        for (int kind = 0; kind < POINT_KIND_COUNT; kind++) {
+            if (run_kind(ctx, kind, c, COUNT, output) != 0) {
+                printf("✗ %s failed\n\n", kind_names[kind]);
+                return 1;
+            }
+            for (size_t i = 0; i < COUNT; i++) {
+                double expected = expected_value(ctx, kind, c, i);
+                if (output[i] != expected) {
+                    printf("✗ %s differs at point %zu: %.17g vs %.17g\n\n", kind_names[kind],
+                           i, output[i], expected);
+                    return 1;
+                }
+            }
+        }
+        if (!check_layouts(ctx, c)) {
+            return 1;
+        }
+        simplex_context_destroy(ctx);
+        printf("✓ Every point matches the per-point function in every layout\n\n");
+    }
+
+    // Test 3: Empty and invalid requests
+    printf("Test 3: Argument validation...\n");
+    if (simplex_noise_2d_points(NULL, NULL, 0, NULL) != 0) {
+        printf("✗ Empty request failed\n\n");
+        return 1;
+    }
+    if (simplex_noise_2d_points(c[0], NULL, COUNT, output) == 0 ||
+        simplex_noise_3d_points(c[0], c[1], NULL, COUNT, output) == 0 ||
+        simplex_noise_4d_points(c[0], c[1], c[2], NULL, COUNT, output) == 0 ||
+        simplex_fbm_2d_points(c[0], c[1], COUNT, 0, PERSISTENCE, LACUNARITY, output) == 0 ||
+        simplex_ridged_2d_points(c[0], c[1], COUNT, NULL) == 0 ||
+        simplex_noise_3d_points_aos(NULL, 3, COUNT, output) == 0 ||
+        simplex_noise_2d_points_f32(NULL, NULL, COUNT, NULL) == 0) {
+        printf("✗ Invalid arguments accepted\n\n");
+        return 1;
+    }
+    printf("✓ Invalid arguments rejected\n\n");
+
+    for (int axis = 0; axis < 4; axis++) {
+        free(coords[axis]);
+    }
+    free(output);
+    simplex_cleanup();
+
+    printf("All point array tests passed! ✓\n");
+    return 0;
+}
@@ -0,0 +1,179 @@
+/**
+ * @file test_precision.c
+ * @brief Single-precision kernels and float/uint16 array output test
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @author Adrian Paredez
+ * @version 1.0
+ * @date 9/5/2025
+ */
+
+#include <math.h>
+#include <simplex_noise.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Odd sizes exercise the partial-vector tail of the 16-lane kernels
+#define WIDTH 53
+#define HEIGHT 19
+#define DEPTH 3
+#define SAMPLES ((size_t)WIDTH * HEIGHT * DEPTH)
+#define STEP 0.137
+
+static void init(simplex_precision_t precision) {
+    simplex_config_t config = simplex_get_default_config();
+    config.seed = 2468;  // NOLINT(readability-magic-numbers)
+    config.enable_simd = 1;
+    config.precision = precision;
+    simplex_noise_init_advanced(&config);
+}
+
+static uint16_t to_u16(double v) {
+    v = v < -1.0 ? -1.0 : (v > 1.0 ? 1.0 : v);
+    return (uint16_t)(((v + 1.0) * 0.5 * UINT16_MAX) + 0.5);
+}
+
+// Rows narrower than 512 samples step along x in float from their first sample
+static float row_x(double x_start, int x) {
+    return (float)x_start + ((float)x * (float)STEP);
+}
+
+// Single-precision arrays must match simplex_noise_2df/3df exactly on every level
+static int check_level(simplex_simd_level_t level, float* output_f32, double* output) {
+    const char* name = simplex_get_simd_level_name(level);
+
+    simplex_noise_array_2d_f32(-7.3, 4.1, WIDTH, HEIGHT, STEP, output_f32);
+    simplex_noise_array_2d(-7.3, 4.1, WIDTH, HEIGHT, STEP, output);
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < WIDTH; x++) {
+            float expected = simplex_noise_2df(row_x(-7.3, x), (float)(4.1 + (y * STEP)));
+            int i = (y * WIDTH) + x;
+            if (output_f32[i] != expected || output[i] != (double)expected) {
+                printf("✗ [%s] 2D float sample (%d, %d) differs\n\n", name, x, y);
+                return 1;
+            }
+        }
+    }
+
+    simplex_noise_array_3d_f32(2.2, -0.6, 1.4, WIDTH, HEIGHT, DEPTH, STEP, output_f32);
+    for (int z = 0; z < DEPTH; z++) {
+        for (int y = 0; y < HEIGHT; y++) {
+            for (int x = 0; x < WIDTH; x++) {
+                float expected = simplex_noise_3df(row_x(2.2, x), (float)(-0.6 + (y * STEP)),
+                                                   (float)(1.4 + (z * STEP)));
+                if (output_f32[(((z * HEIGHT) + y) * WIDTH) + x] != expected) {
+                    printf("✗ [%s] 3D float sample (%d, %d, %d) differs\n\n", name, x, y, z);
+                    return 1;
+                }
+            }
+        }
+    }
+    printf("✓ [%s] float arrays match the float point functions\n", name);
+    return 0;
+}
+
+int main(void) {
+    printf("Simplex Noise Precision Test\n");
+    printf("============================\n\n");
+
+    float* output_f32 = malloc(SAMPLES * sizeof(float));
+    uint16_t* output_u16 = malloc(SAMPLES * sizeof(uint16_t));
+    double* output = malloc(SAMPLES * sizeof(double));
+    if (!output_f32 || !output_u16 || !output) {
+        return 1;
+    }
+
+    // Test 1: Float point functions track the double ones
+    printf("Test 1: Single vs double precision...\n");
+    init(SIMPLEX_PRECISION_DOUBLE);
+    double max_error = 0.0;
+    for (int i = 0; i < 2000; i++) {
+        double x = (i * 0.731) - 700.0;
+        double y = (i * 0.377) - 300.0;
+        double z = (i * 0.119) + 20.0;
+        double errors[3] = {
+            fabs(simplex_noise_2df((float)x, (float)y) -
+                 simplex_noise_2d((float)x, (float)y)),
+            fabs(simplex_noise_3df((float)x, (float)y, (float)z) -
+                 simplex_noise_3d((float)x, (float)y, (float)z)),
+            fabs(simplex_noise_4df((float)x, (float)y, (float)z, 1.5f) -
+                 simplex_noise_4d((float)x, (float)y, (float)z, 1.5))};
+        for (int k = 0; k < 3; k++) {
+            max_error = errors[k] > max_error ? errors[k] : max_error;
+        }
+    }
+    printf("Max single/double difference: %.3e\n", max_error);
+    if (max_error > SIMPLEX_F32_TOLERANCE) {
+        printf("✗ Single precision exceeds tolerance\n\n");
+        return 1;
+    }
+    printf("✓ Single precision within tolerance\n\n");
+
+    // Test 2: Double precision with reduced-size outputs converts the double result
+    printf("Test 2: Float/uint16 outputs in double precision...\n");
+    simplex_noise_array_2d(-1.0, 3.0, WIDTH, HEIGHT, STEP, output);
+    simplex_noise_array_2d_f32(-1.0, 3.0, WIDTH, HEIGHT, STEP, output_f32);
+    simplex_noise_array_2d_u16(-1.0, 3.0, WIDTH, HEIGHT, STEP, output_u16);
+    for (int i = 0; i < WIDTH * HEIGHT; i++) {
+        if (output_f32[i] != (float)output[i] || output_u16[i] != to_u16(output[i])) {
+            printf("✗ Noise sample %d converted incorrectly\n\n", i);
+            return 1;
+        }
+    }
+    simplex_fractal_array_2d(0.5, 0.5, WIDTH, HEIGHT, 0.02, 5, 0.5, 2.0, output);
+    simplex_fractal_array_2d_f32(0.5, 0.5, WIDTH, HEIGHT, 0.02, 5, 0.5, 2.0, output_f32);
+    simplex_fractal_array_2d_u16(0.5, 0.5, WIDTH, HEIGHT, 0.02, 5, 0.5, 2.0, output_u16);
+    for (int i = 0; i < WIDTH * HEIGHT; i++) {
+        if (output_f32[i] != (float)output[i] || output_u16[i] != to_u16(output[i])) {
+            printf("✗ Fractal sample %d converted incorrectly\n\n", i);
+            return 1;
+        }
+    }
+    printf("✓ Outputs match the converted double arrays\n\n");
+
+    // Test 3: Single precision selects the float32 kernels on every level
+    printf("Test 3: Single-precision arrays on every SIMD level...\n");
+    init(SIMPLEX_PRECISION_SINGLE);
+    int tested = 0;
+    for (int level = 0; level < SIMPLEX_SIMD_COUNT; level++) {
+        if (simplex_set_simd_level((simplex_simd_level_t)level) != 0) {
+            continue;
+        }
+        if (check_level((simplex_simd_level_t)level, output_f32, output) != 0) {
+            return 1;
+        }
+        tested++;
+    }
+    if (tested == 0) {
+        printf("✗ No SIMD level available\n\n");
+        return 1;
+    }
+    printf("\n");
+
+    // Test 4: Single-precision fractal arrays stay close to double precision
+    printf("Test 4: Single-precision fractal arrays...\n");
+    simplex_fractal_array_2d_f32(10.0, -4.0, WIDTH, HEIGHT, 0.05, 6, 0.5, 2.0, output_f32);
+    init(SIMPLEX_PRECISION_DOUBLE);
+    simplex_fractal_array_2d(10.0, -4.0, WIDTH, HEIGHT, 0.05, 6, 0.5, 2.0, output);
+    max_error = 0.0;
+    for (int i = 0; i < WIDTH * HEIGHT; i++) {
+        double error = fabs(output_f32[i] - output[i]);
+        max_error = error > max_error ? error : max_error;
+    }
+    printf("Max fractal difference: %.3e\n", max_error);
+    if (max_error > SIMPLEX_F32_TOLERANCE) {
+        printf("✗ Single-precision fractal exceeds tolerance\n\n");
+        return 1;
+    }
+    printf("✓ Single-precision fractal within tolerance\n\n");
+
+    free(output_f32);
+    free(output_u16);
+    free(output);
+    simplex_cleanup();
+
+    printf("All precision tests passed! ✓\n");
+    return 0;
+}
@@ -0,0 +1,179 @@
+/**
+ * @file test_profiling.c
+ * @brief Per-API profiling counters test
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @author Adrian Paredez
+ * @version 1.0
+ * @date 9/5/2025
+ */
+
+#include <simplex_noise.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define POINT_CALLS 100
+#define FBM_CALLS 10
+// The array fills the output buffer; the points use the first COUNT samples
+#define WIDTH 64
+#define HEIGHT 32
+#define COUNT 1337
+
+static simplex_context_t* make_context(int enable_profiling) {
+    simplex_config_t config = simplex_get_default_config();
+    config.seed = 99;  // NOLINT(readability-magic-numbers)
+    config.enable_profiling = enable_profiling;
+    config.max_threads = 4;
+    config.chunk_size = 1;
+    return simplex_context_create(&config);
+}
+
+// Check one API's calls and samples, and that its histogram covers every call
+static int expect_profile(const simplex_context_t* ctx, simplex_profile_api_t api, size_t calls,
+                          size_t samples) {
+    simplex_profile_entry_t entry;
+    simplex_get_profile_ctx(ctx, api, &entry);
+    size_t histogram_calls = 0;
+    for (int b = 0; b < SIMPLEX_PROFILE_HISTOGRAM_BUCKETS; b++) {
+        histogram_calls += entry.histogram[b];
+    }
+    if (entry.calls != calls || entry.samples != samples || histogram_calls != calls ||
+        entry.total_time < 0.0 || (calls > 0 && entry.average_time != entry.total_time / calls)) {
+        printf("✗ %s: expected %zu calls / %zu samples, got %zu / %zu (histogram %zu)\n\n",
+               simplex_get_profile_api_name(api), calls, samples, entry.calls, entry.samples,
+               histogram_calls);
+        return 1;
+    }
+    return 0;
+}
+
+// Make a few calls of every kind the test checks
+static int exercise(const simplex_context_t* ctx, double* output, const double* coords) {
+    volatile double sink = 0.0;
+    for (int i = 0; i < POINT_CALLS; i++) {
+        sink += simplex_noise_2d_ctx(ctx, i * 0.37, i * 0.11);
+    }
+    for (int i = 0; i < FBM_CALLS; i++) {
+        sink += simplex_fbm_2d_ctx(ctx, i * 0.5, 1.0, 4, 0.5, 2.0);
+    }
+    (void)sink;
+    simplex_tile_request_t request = {.resolution = 16, .tile_size = 1.0, .octaves = 3,
+                                      .persistence = 0.5, .lacunarity = 2.0};
+    const double* tile = simplex_tile_acquire_ctx(ctx, &request);
+    simplex_tile_release(tile);
+    return simplex_noise_array_2d_ctx(ctx, 0.0, 0.0, WIDTH, HEIGHT, 0.1, output) != 0 ||
+           simplex_fractal_array_2d_ctx(ctx, 0.0, 0.0, WIDTH, HEIGHT, 0.1, 4, 0.5, 2.0,
+                                        output) != 0 ||
+           simplex_noise_2d_points_ctx(ctx, coords, coords, COUNT, output) != 0 || !tile;
+}
+
+int main(void) {
+    printf("Simplex Noise Profiling Test\n");
+    printf("============================\n\n");
+
+    double* output = malloc((size_t)WIDTH * HEIGHT * sizeof(double));
+    double* coords = malloc(COUNT * sizeof(double));
+    if (!output || !coords) {
+        return 1;
+    }
+    for (size_t i = 0; i < COUNT; i++) {
+        coords[i] = (double)i * 0.173;  // NOLINT(readability-magic-numbers)
+    }
+
+    simplex_context_t* ctx = make_context(1);
+    if (!ctx || exercise(ctx, output, coords) != 0) {
+        printf("✗ Noise calls failed\n\n");
+        return 1;
+    }
+
+    simplex_profile_entry_t entry;
+    if (simplex_get_profile_ctx(ctx, SIMPLEX_PROFILE_NOISE_2D, &entry) != 0) {
+        // Test 1 (profiling compiled out): nothing is recorded
+        printf("Test 1: Profiling compiled out...\n");
+        simplex_perf_stats_t stats;
+        simplex_get_performance_stats_ctx(ctx, &stats);
+        if (entry.calls != 0 || stats.function_calls != 0 ||
+            simplex_get_function_call_count() != 0) {
+            printf("✗ Counters moved without SIMPLEX_ENABLE_PROFILING\n\n");
+            return 1;
+        }
+        printf("✓ No counters without SIMPLEX_ENABLE_PROFILING\n\n");
+    } else {
+        // Test 1: Outermost calls are counted once, nested and worker calls not at all
+        printf("Test 1: Per-API counters...\n");
+        if (expect_profile(ctx, SIMPLEX_PROFILE_NOISE_2D, POINT_CALLS, POINT_CALLS) != 0 ||
+            expect_profile(ctx, SIMPLEX_PROFILE_FBM, FBM_CALLS, FBM_CALLS) != 0 ||
+            expect_profile(ctx, SIMPLEX_PROFILE_NOISE_ARRAY, 1, (size_t)WIDTH * HEIGHT) != 0 ||
+            expect_profile(ctx, SIMPLEX_PROFILE_FRACTAL_ARRAY, 1, (size_t)WIDTH * HEIGHT) != 0 ||
+            expect_profile(ctx, SIMPLEX_PROFILE_POINTS, 1, COUNT) != 0 ||
+            expect_profile(ctx, SIMPLEX_PROFILE_TILE_ACQUIRE, 1, 16 * 16) != 0 ||
+            expect_profile(ctx, SIMPLEX_PROFILE_RIDGED, 0, 0) != 0) {
+            return 1;
+        }
+        printf("✓ Calls, samples and histograms match\n\n");
+
+        // Test 2: Totals feed the performance stats
+        printf("Test 2: Performance stats...\n");
+        simplex_perf_stats_t stats;
+        simplex_get_performance_stats_ctx(ctx, &stats);
+        size_t calls = POINT_CALLS + FBM_CALLS + 4;
+        if (stats.function_calls != calls || !(stats.generation_time > 0.0) ||
+            !(stats.average_execution_time > 0.0)) {
+            printf("✗ Expected %zu calls with time, got %zu in %g s\n\n", calls,
+                   stats.function_calls, stats.generation_time);
+            return 1;
+        }
+        printf("✓ %zu calls, %.3f us on average\n\n", stats.function_calls,
+               stats.average_execution_time);
+
+        // Test 3: Reset clears the counters
+        printf("Test 3: Reset...\n");
+        simplex_reset_performance_stats_ctx(ctx);
+        simplex_get_performance_stats_ctx(ctx, &stats);
+        if (stats.function_calls != 0 || expect_profile(ctx, SIMPLEX_PROFILE_NOISE_2D, 0, 0)) {
+            printf("✗ Counters survived the reset\n\n");
+            return 1;
+        }
+        printf("✓ Counters cleared\n\n");
+
+        // Test 4: Disabled profiling records nothing; re-initializing keeps history
+        printf("Test 4: Enabling and re-initializing...\n");
+        simplex_noise_init(7);  // NOLINT(readability-magic-numbers)
+        simplex_noise_2d(0.5, 0.5);
+        simplex_set_profiling(1);
+        simplex_noise_2d(0.5, 0.5);
+        simplex_config_t config;
+        simplex_context_get_config(NULL, &config);
+        simplex_noise_init_advanced(&config);
+        simplex_noise_2d(0.5, 0.5);
+        simplex_get_profile(SIMPLEX_PROFILE_NOISE_2D, &entry);
+        if (entry.calls != 2 || simplex_get_function_call_count() != 2) {
+            printf("✗ Expected 2 profiled calls, got %zu\n\n", entry.calls);
+            return 1;
+        }
+        printf("✓ Only enabled calls counted, history kept across init\n\n");
+    }
+
+    // Test 5: Names and invalid arguments
+    printf("Test 5: Names and validation...\n");
+    if (strcmp(simplex_get_profile_api_name(SIMPLEX_PROFILE_NOISE_2D), "noise_2d") != 0 ||
+        strcmp(simplex_get_profile_api_name(SIMPLEX_PROFILE_IMAGE), "image") != 0 ||
+        strcmp(simplex_get_profile_api_name(SIMPLEX_PROFILE_API_COUNT), "unknown") != 0 ||
+        simplex_get_profile(SIMPLEX_PROFILE_API_COUNT, &entry) != -1 ||
+        simplex_get_profile(SIMPLEX_PROFILE_NOISE_2D, NULL) != -1) {
+        printf("✗ Names or validation wrong\n\n");
+        return 1;
+    }
+    printf("✓ Names and validation correct\n\n");
+
+    simplex_context_destroy(ctx);
+    free(output);
+    free(coords);
+    simplex_cleanup();
+
+    printf("All profiling tests passed! ✓\n");
+    return 0;
+}
@@ -0,0 +1,169 @@
+/**
+ * @file test_pyramid.c
+ * @brief fBm LOD pyramid vs per-level octave sums test
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @author Adrian Paredez
+ * @version 1.0
+ * @date 9/5/2025
+ */
+
+#include <math.h>
+#include <simplex_noise.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Several 512-sample tiles per row, odd sizes so coarse levels round up
+#define WIDTH 1100
+#define HEIGHT 37
+#define LEVELS 5
+#define X_START -3.7
+#define Y_START 12.25
+// Leaves 5, 4, 3, 2 and 1 of the octaves visible on levels 0 to 4
+#define STEP 0.03
+#define OCTAVES 6
+#define PERSISTENCE 0.55
+#define LACUNARITY 2.0
+
+// Sum of the leading octaves with frequency * spacing <= 0.5, over the full amplitude sum
+static double expected_sample(const simplex_context_t* ctx, double x, double y, double spacing,
+                              int octaves) {
+    double sum = 0.0;
+    double max_value = 0.0;
+    double amplitude = 1.0;
+    double frequency = 1.0;
+    int visible = 1;
+    for (int octave = 0; octave < octaves; octave++) {
+        visible = visible && (octave == 0 || frequency * spacing <= 0.5);
+        if (visible) {
+            sum += simplex_noise_2d_ctx(ctx, x * frequency, y * frequency) * amplitude;
+        }
+        max_value += amplitude;
+        amplitude *= PERSISTENCE;
+        frequency *= LACUNARITY;
+    }
+    return sum / max_value;
+}
+
+// Compare every level of a pyramid with expected_sample()
+static int check_pyramid(const simplex_context_t* ctx, const double* pyramid) {
+    for (int level = 0; level < LEVELS; level++) {
+        int width = 0;
+        int height = 0;
+        const double* samples =
+            pyramid + simplex_pyramid_level(WIDTH, HEIGHT, level, &width, &height);
+        double spacing = ldexp(STEP, level);
+        for (int j = 0; j < height; j++) {
+            for (int i = 0; i < width; i++) {
+                double expected = expected_sample(ctx, X_START + (i * spacing),
+                                                  Y_START + (j * spacing), spacing, OCTAVES);
+                if (samples[((size_t)j * width) + i] != expected) {
+                    printf("✗ Level %d differs at (%d, %d): %.17g vs %.17g\n\n", level, i, j,
+                           samples[((size_t)j * width) + i], expected);
+                    return 0;
+                }
+            }
+        }
+    }
+    return 1;
+}
+
+int main(void) {
+    printf("Simplex Noise LOD Pyramid Test\n");
+    printf("==============================\n\n");
+
+    // Test 1: Level dimensions and offsets
+    printf("Test 1: Level layout...\n");
+    int width = 0;
+    int height = 0;
+    size_t total = simplex_pyramid_level(WIDTH, HEIGHT, LEVELS, NULL, NULL);
+    if (simplex_pyramid_level(WIDTH, HEIGHT, 0, &width, &height) != 0 || width != WIDTH ||
+        height != HEIGHT ||
+        simplex_pyramid_level(WIDTH, HEIGHT, 1, &width, &height) != (size_t)WIDTH * HEIGHT ||
+        width != 550 || height != 19 ||
+        simplex_pyramid_level(WIDTH, HEIGHT, 4, &width, &height) !=
+            (size_t)(WIDTH * HEIGHT) + (550 * 19) + (275 * 10) + (138 * 5) ||
+        width != 69 || height != 3 ||
+        total != (size_t)(WIDTH * HEIGHT) + (550 * 19) + (275 * 10) + (138 * 5) + (69 * 3) ||
+        simplex_pyramid_level(1, 1, 32, &width, &height) != 32 || width != 1 || height != 1) {
+        printf("✗ Level dimensions or offsets wrong\n\n");
+        return 1;
+    }
+    if (simplex_pyramid_level(0, HEIGHT, 1, &width, &height) != 0 || width != 0 ||
+        height != 0 || simplex_pyramid_level(WIDTH, HEIGHT, -1, NULL, NULL) != 0 ||
+        simplex_pyramid_level(WIDTH, HEIGHT, 33, NULL, NULL) != 0) {
+        printf("✗ Invalid layout request accepted\n\n");
+        return 1;
+    }
+    printf("✓ Levels sized and placed correctly\n\n");
+
+    double* pyramid = malloc(total * sizeof(double));
+    double* reference = malloc((size_t)WIDTH * HEIGHT * sizeof(double));
+    if (!pyramid || !reference) {
+        return 1;
+    }
+
+    for (int simd = 0; simd <= 1; simd++) {
+        printf("Test %d: levels vs visible octave sums (SIMD %s)...\n", simd + 2,
+               simd ? "on" : "off");
+
+        simplex_config_t config = simplex_get_default_config();
+        config.seed = 4242;  // NOLINT(readability-magic-numbers)
+        config.enable_simd = simd;
+        config.max_threads = 3;
+        config.chunk_size = 100;  // NOLINT(readability-magic-numbers)
+        simplex_context_t* ctx = simplex_context_create(&config);
+        if (!ctx) {
+            printf("✗ Context creation failed\n\n");
+            return 1;
+        }
+        if (simplex_fbm_pyramid_2d_ctx(ctx, X_START, Y_START, WIDTH, HEIGHT, STEP, LEVELS,
+                                       OCTAVES, PERSISTENCE, LACUNARITY, pyramid) != 0 ||
+            !check_pyramid(ctx, pyramid)) {
+            return 1;
+        }
+
+        // With every octave below Nyquist, level 0 is the fBm array
+        if (simplex_fbm_pyramid_2d_ctx(ctx, X_START, Y_START, WIDTH, HEIGHT, STEP, LEVELS, 4,
+                                       PERSISTENCE, LACUNARITY, pyramid) != 0 ||
+            simplex_fbm_array_2d_ctx(ctx, X_START, Y_START, WIDTH, HEIGHT, STEP, 4, PERSISTENCE,
+                                     LACUNARITY, reference) != 0) {
+            printf("✗ Pyramid or fBm array generation failed\n\n");
+            return 1;
+        }
+        for (size_t i = 0; i < (size_t)WIDTH * HEIGHT; i++) {
+            if (pyramid[i] != reference[i]) {
+                printf("✗ Level 0 differs from simplex_fbm_array_2d at %zu\n\n", i);
+                return 1;
+            }
+        }
+        simplex_context_destroy(ctx);
+        printf("✓ Every level matches its band-limited octave sum\n\n");
+    }
+
+    // Test 4: Invalid requests
+    printf("Test 4: Argument validation...\n");
+    if (simplex_fbm_pyramid_2d(X_START, Y_START, WIDTH, HEIGHT, STEP, LEVELS, OCTAVES,
+                               PERSISTENCE, LACUNARITY, NULL) == 0 ||
+        simplex_fbm_pyramid_2d(X_START, Y_START, 0, HEIGHT, STEP, LEVELS, OCTAVES, PERSISTENCE,
+                               LACUNARITY, pyramid) == 0 ||
+        simplex_fbm_pyramid_2d(X_START, Y_START, WIDTH, HEIGHT, STEP, 0, OCTAVES, PERSISTENCE,
+                               LACUNARITY, pyramid) == 0 ||
+        simplex_fbm_pyramid_2d(X_START, Y_START, WIDTH, HEIGHT, STEP, 33, OCTAVES, PERSISTENCE,
+                               LACUNARITY, pyramid) == 0 ||
+        simplex_fbm_pyramid_2d(X_START, Y_START, WIDTH, HEIGHT, STEP, LEVELS, 0, PERSISTENCE,
+                               LACUNARITY, pyramid) == 0) {
+        printf("✗ Invalid arguments accepted\n\n");
+        return 1;
+    }
+    printf("✓ Invalid arguments rejected\n\n");
+
+    free(pyramid);
+    free(reference);
+    simplex_cleanup();
+
+    printf("All LOD pyramid tests passed! ✓\n");
+    return 0;
+}
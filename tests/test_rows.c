@@ -0,0 +1,269 @@
+/**
+ * @file test_rows.c
+ * @brief Grid array rows and chunk-origin arrays test
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @author Adrian Paredez
+ * @version 1.0
+ * @date 9/5/2025
+ */
+
+#include <math.h>
+#include <simplex_image.h>
+#include <simplex_noise.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Long rows cross many cells; small steps stay in one cell for many samples
+#define WIDTH 1031
+#define HEIGHT 7
+#define DEPTH 3
+#define SMALL_STEP 0.0113
+// Large steps enter a new cell almost every sample
+#define LARGE_STEP 0.93
+#define SHORT_WIDTH 53
+// Rows this far out keep few fraction bits in x_start + x * step
+#define FAR_X 3.0e6
+// Narrower than an image tile, so each image row is one array call
+#define IMAGE_WIDTH 300
+#define IMAGE_HEIGHT 5
+// Chunks of CHUNK samples at a power-of-two step span two whole lattice units
+#define CHUNK 128
+#define CHUNK_STEP (1.0 / 64.0)
+#define CHUNK_UNITS 2
+#define CHUNK_ORIGIN_X INT64_C(1000003)
+#define CHUNK_ORIGIN_Y INT64_C(-2500001)
+#define CHUNK_ORIGIN_Z INT64_C(1700002)
+
+static double max_difference(const double* a, const double* b, size_t count) {
+    double max_error = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        double error = fabs(a[i] - b[i]);
+        max_error = error > max_error ? error : max_error;
+    }
+    return max_error;
+}
+
+// Scalar rows starting at (x0, y0, z0) against the point functions, exactly
+static int check_scalar(double x0, double y0, double z0, int width, double step,
+                        double* output) {
+    simplex_noise_array_2d(x0, y0, width, HEIGHT, step, output);
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < width; x++) {
+            if (output[(y * width) + x] != simplex_noise_2d(x0 + (x * step), y0 + (y * step))) {
+                printf("✗ 2D sample (%d, %d) from x = %g differs\n\n", x, y, x0);
+                return 0;
+            }
+        }
+    }
+    simplex_noise_array_3d(x0, y0, z0, width, HEIGHT, DEPTH, step, output);
+    for (int z = 0; z < DEPTH; z++) {
+        for (int y = 0; y < HEIGHT; y++) {
+            for (int x = 0; x < width; x++) {
+                double expected =
+                    simplex_noise_3d(x0 + (x * step), y0 + (y * step), z0 + (z * step));
+                if (output[(((z * HEIGHT) + y) * width) + x] != expected) {
+                    printf("✗ 3D sample (%d, %d, %d) from x = %g differs\n\n", x, y, z, x0);
+                    return 0;
+                }
+            }
+        }
+    }
+    return 1;
+}
+
+// Every 2D grid path far from the origin against simplex_noise_2d(), exactly
+static int check_far_paths(double* output) {
+    const double x0 = FAR_X + 0.37;
+    const double y0 = -0.75 * FAR_X;
+    float floats[WIDTH * HEIGHT];
+    uint16_t words[WIDTH * HEIGHT];
+    if (simplex_fractal_array_2d(x0, y0, WIDTH, HEIGHT, SMALL_STEP, 1, 0.5, 2.0, output) != 0 ||
+        simplex_noise_array_2d_f32(x0, y0, WIDTH, HEIGHT, SMALL_STEP, floats) != 0 ||
+        simplex_noise_array_2d_u16(x0, y0, WIDTH, HEIGHT, SMALL_STEP, words) != 0) {
+        printf("✗ Far arrays failed\n\n");
+        return 0;
+    }
+    for (int i = 0; i < WIDTH * HEIGHT; i++) {
+        double expected =
+            simplex_noise_2d(x0 + ((i % WIDTH) * SMALL_STEP), y0 + ((i / WIDTH) * SMALL_STEP));
+        double clamped = expected < -1.0 ? -1.0 : (expected > 1.0 ? 1.0 : expected);
+        if (output[i] != expected || floats[i] != (float)expected ||
+            words[i] != (uint16_t)(((clamped + 1.0) * 0.5 * UINT16_MAX) + 0.5)) {
+            printf("✗ Far fractal, f32 or u16 sample %d differs\n\n", i);
+            return 0;
+        }
+    }
+
+    // Image rows start at offset * scale and step by scale
+    simplex_image_config_t image = simplex_get_default_image_config();
+    simplex_set_image_size(&image, IMAGE_WIDTH, IMAGE_HEIGHT);
+    image.scale = SMALL_STEP;
+    image.offset_x = x0 / SMALL_STEP;
+    image.offset_y = y0 / SMALL_STEP;
+    image.octaves = 1;
+    image.auto_normalize = SIMPLEX_NORMALIZE_NONE;
+    if (simplex_render_heights_f32(&image, floats, IMAGE_WIDTH * IMAGE_HEIGHT) != 0) {
+        printf("✗ Far image failed\n\n");
+        return 0;
+    }
+    for (int i = 0; i < IMAGE_WIDTH * IMAGE_HEIGHT; i++) {
+        double x = (image.offset_x * image.scale) + ((i % IMAGE_WIDTH) * image.scale);
+        double y = (image.offset_y * image.scale) + ((i / IMAGE_WIDTH) * image.scale);
+        if (floats[i] != (float)simplex_noise_2d(x, y)) {
+            printf("✗ Far image sample %d differs\n\n", i);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Whether a chunk matches columns [column, column + width) of a wider chunk
+static int same_columns(const double* wide, int wide_width, int column, const double* chunk,
+                        int width, int rows) {
+    for (int r = 0; r < rows; r++) {
+        for (int x = 0; x < width; x++) {
+            if (wide[((size_t)r * wide_width) + column + x] != chunk[((size_t)r * width) + x]) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+// Neighbouring chunks far out agree bit-for-bit with one chunk covering both
+static int check_chunks(double* wide, double* chunk) {
+    const int half = CHUNK / 2;
+    const double half_units = CHUNK_UNITS / 2.0;
+    // 2D: two chunks side by side, one above them, and the right half as an offset
+    simplex_noise_array_2d_origin(CHUNK_ORIGIN_X, CHUNK_ORIGIN_Y, 0.0, 0.0, 2 * CHUNK, 2 * CHUNK,
+                                  CHUNK_STEP, wide);
+    for (int cx = 0; cx < 2; cx++) {
+        for (int cy = 0; cy < 2; cy++) {
+            simplex_noise_array_2d_origin(CHUNK_ORIGIN_X + (cx * CHUNK_UNITS),
+                                          CHUNK_ORIGIN_Y + (cy * CHUNK_UNITS), 0.0, 0.0, CHUNK,
+                                          CHUNK, CHUNK_STEP, chunk);
+            if (!same_columns(wide + ((size_t)cy * CHUNK * 2 * CHUNK), 2 * CHUNK, cx * CHUNK,
+                              chunk, CHUNK, CHUNK)) {
+                printf("✗ 2D chunk (%d, %d) differs from its neighbours\n\n", cx, cy);
+                return 0;
+            }
+        }
+    }
+    simplex_noise_array_2d_origin(CHUNK_ORIGIN_X, CHUNK_ORIGIN_Y, half_units, 0.0, half, CHUNK,
+                                  CHUNK_STEP, chunk);
+    if (!same_columns(wide, 2 * CHUNK, half, chunk, half, CHUNK)) {
+        printf("✗ 2D chunk given as a local offset differs\n\n");
+        return 0;
+    }
+
+    // 3D: the same along x, through every slice
+    simplex_noise_array_3d_origin(CHUNK_ORIGIN_X, CHUNK_ORIGIN_Y, CHUNK_ORIGIN_Z, 0.0, 0.0, 0.0,
+                                  CHUNK, HEIGHT, DEPTH, CHUNK_STEP, wide);
+    simplex_noise_array_3d_origin(CHUNK_ORIGIN_X + 1, CHUNK_ORIGIN_Y, CHUNK_ORIGIN_Z, 0.0, 0.0,
+                                  0.0, half, HEIGHT, DEPTH, CHUNK_STEP, chunk);
+    if (!same_columns(wide, CHUNK, half, chunk, half, HEIGHT * DEPTH)) {
+        printf("✗ 3D chunk differs from its neighbour\n\n");
+        return 0;
+    }
+    return 1;
+}
+
+int main(void) {
+    printf("Simplex Noise Row Walk Test\n");
+    printf("===========================\n\n");
+
+    size_t samples = (size_t)4 * CHUNK * CHUNK;
+    double* output = malloc(samples * sizeof(double));
+    double* reference = malloc(samples * sizeof(double));
+    if (!output || !reference) {
+        return 1;
+    }
+
+    // Test 1: Scalar rows reuse cells without changing the samples
+    printf("Test 1: Scalar rows vs point functions...\n");
+    simplex_set_simd(0);
+    if (!check_scalar(-3.7, 2.1, 0.4, WIDTH, SMALL_STEP, output) ||
+        !check_scalar(-3.7, 2.1, 0.4, SHORT_WIDTH, LARGE_STEP, output) ||
+        !check_scalar(-3.7, 2.1, 0.4, SHORT_WIDTH, 1.0, output) ||
+        !check_scalar(FAR_X + 0.37, -0.75 * FAR_X, 0.5 * FAR_X, WIDTH, SMALL_STEP, output)) {
+        return 1;
+    }
+    printf("✓ 2D and 3D identical near and far from the origin\n\n");
+
+    // Test 2: Fractal, float, uint16 and image paths far from the origin
+    printf("Test 2: Far grid paths vs simplex_noise_2d()...\n");
+    if (!check_far_paths(output)) {
+        return 1;
+    }
+    printf("✓ Every 2D grid path matches the point function\n\n");
+
+    // Test 3: Far rows agree between the scalar walk and every SIMD level
+    printf("Test 3: Far rows on every SIMD level...\n");
+    simplex_noise_array_2d(FAR_X, -FAR_X, WIDTH, HEIGHT, SMALL_STEP, reference);
+    simplex_set_simd(1);
+    for (int level = 0; level < SIMPLEX_SIMD_COUNT; level++) {
+        if (simplex_set_simd_level((simplex_simd_level_t)level) != 0) {
+            continue;
+        }
+        simplex_noise_array_2d(FAR_X, -FAR_X, WIDTH, HEIGHT, SMALL_STEP, output);
+        double error = max_difference(reference, output, (size_t)WIDTH * HEIGHT);
+        printf("[%s] max difference: %.3e\n",
+               simplex_get_simd_level_name((simplex_simd_level_t)level), error);
+        if (error > SIMPLEX_SIMD_TOLERANCE) {
+            printf("✗ Far row differs from the scalar walk\n\n");
+            return 1;
+        }
+    }
+    printf("✓ Far rows agree\n\n");
+
+    // Test 4: Chunk origins line up exactly and match the points near the origin
+    printf("Test 4: Chunk-origin arrays...\n");
+    if (!check_chunks(output, reference)) {
+        return 1;
+    }
+    simplex_noise_array_2d_origin(-4, 2, 0.3, 0.1, WIDTH, HEIGHT, SMALL_STEP, output);
+    for (int i = 0; i < WIDTH * HEIGHT; i++) {
+        double expected = simplex_noise_2d(-3.7 + ((i % WIDTH) * SMALL_STEP),
+                                           2.1 + ((i / WIDTH) * SMALL_STEP));
+        if (fabs(output[i] - expected) > SIMPLEX_SIMD_TOLERANCE) {
+            printf("✗ Chunk-origin sample %d off by %.3e\n\n", i, fabs(output[i] - expected));
+            return 1;
+        }
+    }
+    // The walk is scalar, so SIMD and threads change nothing
+    simplex_set_simd(0);
+    simplex_noise_array_2d_origin(-4, 2, 0.3, 0.1, WIDTH, HEIGHT, SMALL_STEP, reference);
+    if (max_difference(reference, output, (size_t)WIDTH * HEIGHT) != 0.0) {
+        printf("✗ Chunk-origin arrays depend on the SIMD level\n\n");
+        return 1;
+    }
+    printf("✓ Neighbouring chunks identical, near samples within tolerance\n\n");
+
+    // Test 5: Invalid chunk-origin requests
+    printf("Test 5: Chunk-origin validation...\n");
+    const int64_t too_far = INT64_C(1) << 51;
+    if (simplex_noise_array_2d_origin(0, 0, 0.0, 0.0, WIDTH, HEIGHT, SMALL_STEP, NULL) != -1 ||
+        simplex_noise_array_2d_origin(0, 0, 0.0, 0.0, 0, HEIGHT, SMALL_STEP, output) != -1 ||
+        simplex_noise_array_2d_origin(too_far, 0, 0.0, 0.0, WIDTH, HEIGHT, SMALL_STEP, output) !=
+            -1 ||
+        simplex_noise_array_2d_origin(0, 0, NAN, 0.0, WIDTH, HEIGHT, SMALL_STEP, output) != -1 ||
+        simplex_noise_array_3d_origin(0, 0, -too_far, 0.0, 0.0, 0.0, 8, 8, 8, SMALL_STEP,
+                                      output) != -1 ||
+        simplex_noise_array_3d_origin(0, 0, 0, 0.0, 0.0, 0.0, 8, 8, 0, SMALL_STEP, output) !=
+            -1) {
+        printf("✗ Invalid request accepted\n\n");
+        return 1;
+    }
+    printf("✓ Invalid requests rejected\n\n");
+
+    free(output);
+    free(reference);
+    simplex_cleanup();
+
+    printf("All row walk tests passed! ✓\n");
+    return 0;
+}
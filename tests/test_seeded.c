@@ -0,0 +1,204 @@
+/**
+ * @file test_seeded.c
+ * @brief Hash-based seeded noise and multi-seed layer array test
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @author Adrian Paredez
+ * @version 1.0
+ * @date 9/5/2025
+ */
+
+#include <math.h>
+#include <simplex_noise.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// A width that is not a multiple of any vector width exercises the partial stores
+#define WIDTH 67
+#define HEIGHT 13
+#define DEPTH 5
+#define LAYERS 9
+#define STEP 0.093
+#define X0 -4.25
+#define Y0 1.5
+#define Z0 0.375
+// The statistics grid spans thousands of lattice cells
+#define STATS_SIZE 256
+#define STATS_STEP 0.37
+#define MAX_CORRELATION 0.1
+
+static const uint32_t seeds[LAYERS] = {0u, 1u, 2u, 3u, 42u, 777u, 0x7FFFFFFFu, 0x80000000u,
+                                       0xFFFFFFFFu};
+
+// Every layer sample equals the point function of its seed
+static int matches_points(const double* output, int depth) {
+    size_t plane = (size_t)WIDTH * HEIGHT * depth;
+    for (int l = 0; l < LAYERS; l++) {
+        for (int z = 0; z < depth; z++) {
+            for (int y = 0; y < HEIGHT; y++) {
+                for (int x = 0; x < WIDTH; x++) {
+                    double px = X0 + (x * STEP);
+                    double py = Y0 + (y * STEP);
+                    double pz = Z0 + (z * STEP);
+                    double expected = depth == 1 ? simplex_noise_2d_seeded(px, py, seeds[l])
+                                                 : simplex_noise_3d_seeded(px, py, pz, seeds[l]);
+                    size_t index = (l * plane) + ((((size_t)z * HEIGHT) + y) * WIDTH) + x;
+                    if (output[index] != expected) {
+                        printf("✗ Layer %d sample (%d, %d, %d): %.17g vs %.17g\n", l, x, y, z,
+                               output[index], expected);
+                        return 0;
+                    }
+                }
+            }
+        }
+    }
+    return 1;
+}
+
+// Pearson correlation of two equally long sample runs
+static double correlation(const double* a, const double* b, size_t count) {
+    double mean_a = 0.0;
+    double mean_b = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        mean_a += a[i];
+        mean_b += b[i];
+    }
+    mean_a /= (double)count;
+    mean_b /= (double)count;
+    double ab = 0.0;
+    double aa = 0.0;
+    double bb = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        ab += (a[i] - mean_a) * (b[i] - mean_b);
+        aa += (a[i] - mean_a) * (a[i] - mean_a);
+        bb += (b[i] - mean_b) * (b[i] - mean_b);
+    }
+    return ab / sqrt(aa * bb);
+}
+
+int main(void) {
+    printf("Simplex Noise Seeded Layers Test\n");
+    printf("================================\n\n");
+
+    size_t plane_3d = (size_t)WIDTH * HEIGHT * DEPTH;
+    double* output = malloc(plane_3d * LAYERS * sizeof(double));
+    if (!output) {
+        return 1;
+    }
+
+    // Test 1: Layers match the point functions on every SIMD level
+    printf("Test 1: Layers vs point functions...\n");
+    double before = simplex_noise_3d(0.3, 0.7, 0.1);
+    for (int level = SIMPLEX_SIMD_SCALAR; level < SIMPLEX_SIMD_COUNT; level++) {
+        if (simplex_set_simd_level((simplex_simd_level_t)level) != 0) {
+            continue;
+        }
+        if (simplex_noise_layers_2d(X0, Y0, WIDTH, HEIGHT, STEP, seeds, LAYERS, output) != 0 ||
+            !matches_points(output, 1) ||
+            simplex_noise_layers_3d(X0, Y0, Z0, WIDTH, HEIGHT, DEPTH, STEP, seeds, LAYERS,
+                                    output) != 0 ||
+            !matches_points(output, DEPTH)) {
+            printf("✗ Layers differ on %s\n\n",
+                   simplex_get_simd_level_name((simplex_simd_level_t)level));
+            return 1;
+        }
+    }
+    printf("✓ Layers identical to the point functions\n\n");
+
+    // Test 2: Thread counts, chunk sizes and the context seed do not matter
+    printf("Test 2: Context independence...\n");
+    simplex_config_t config = simplex_get_default_config();
+    config.seed = 31337;  // NOLINT(readability-magic-numbers)
+    config.max_threads = 4;
+    config.chunk_size = 1;
+    simplex_context_t* ctx = simplex_context_create(&config);
+    double* threaded = malloc(plane_3d * LAYERS * sizeof(double));
+    if (!ctx || !threaded ||
+        simplex_noise_layers_3d_ctx(ctx, X0, Y0, Z0, WIDTH, HEIGHT, DEPTH, STEP, seeds, LAYERS,
+                                    threaded) != 0) {
+        printf("✗ Context layer generation failed\n\n");
+        return 1;
+    }
+    for (size_t i = 0; i < plane_3d * LAYERS; i++) {
+        if (threaded[i] != output[i]) {
+            printf("✗ Threaded layers differ at %zu\n\n", i);
+            return 1;
+        }
+    }
+    if (simplex_noise_2d_seeded_ctx(ctx, 0.3, 0.7, 5) != simplex_noise_2d_seeded(0.3, 0.7, 5) ||
+        simplex_noise_3d(0.3, 0.7, 0.1) != before) {
+        printf("✗ Seeded noise depends on the context or reseeded it\n\n");
+        return 1;
+    }
+    free(threaded);
+    simplex_context_destroy(ctx);
+    printf("✓ Same layers for every context\n\n");
+
+    // Test 3: Each layer is noise in range and unrelated to its neighbours
+    printf("Test 3: Layer statistics...\n");
+    size_t plane = (size_t)STATS_SIZE * STATS_SIZE;
+    double* stats = malloc(plane * LAYERS * sizeof(double));
+    if (!stats || simplex_noise_layers_2d(X0, Y0, STATS_SIZE, STATS_SIZE, STATS_STEP, seeds,
+                                          LAYERS, stats) != 0) {
+        printf("✗ Statistics layers failed\n\n");
+        return 1;
+    }
+    for (int l = 0; l < LAYERS; l++) {
+        const double* layer = stats + (l * plane);
+        double min = layer[0];
+        double max = layer[0];
+        for (size_t i = 0; i < plane; i++) {
+            min = fmin(min, layer[i]);
+            max = fmax(max, layer[i]);
+        }
+        if (min < -1.0 || max > 1.0 || max - min < 1.0) {
+            printf("✗ Layer %d range [%f, %f]\n\n", l, min, max);
+            return 1;
+        }
+        if (l > 0) {
+            double r = correlation(layer - plane, layer, plane);
+            if (fabs(r) > MAX_CORRELATION) {
+                printf("✗ Layers %d and %d correlate by %f\n\n", l - 1, l, r);
+                return 1;
+            }
+        }
+    }
+    free(stats);
+    printf("✓ Layers in range and uncorrelated\n\n");
+
+    // Test 4: The hashed lattice has no 256-unit period
+    printf("Test 4: Aperiodic lattice...\n");
+    int repeats = 0;
+    for (int i = 0; i < 16; i++) {
+        double x = 0.37 + (i * 1.7);
+        repeats +=
+            simplex_noise_2d_seeded(x, 0.61, 9) == simplex_noise_2d_seeded(x + 256.0, 0.61, 9);
+        repeats += simplex_noise_3d_seeded(x, 0.61, 2.2, 9) ==
+                   simplex_noise_3d_seeded(x + 256.0, 0.61, 2.2, 9);
+    }
+    if (repeats > 2) {
+        printf("✗ Noise repeats after 256 units\n\n");
+        return 1;
+    }
+    printf("✓ No permutation period\n\n");
+
+    // Test 5: Invalid requests are rejected
+    printf("Test 5: Validation...\n");
+    if (simplex_noise_layers_2d(X0, Y0, WIDTH, HEIGHT, STEP, NULL, LAYERS, output) != -1 ||
+        simplex_noise_layers_2d(X0, Y0, WIDTH, HEIGHT, STEP, seeds, 0, output) != -1 ||
+        simplex_noise_layers_2d(X0, Y0, 0, HEIGHT, STEP, seeds, LAYERS, output) != -1 ||
+        simplex_noise_layers_2d(X0, Y0, WIDTH, HEIGHT, STEP, seeds, LAYERS, NULL) != -1 ||
+        simplex_noise_layers_3d(X0, Y0, Z0, WIDTH, HEIGHT, 0, STEP, seeds, LAYERS, output) != -1) {
+        printf("✗ Invalid request accepted\n\n");
+        return 1;
+    }
+    printf("✓ Invalid requests rejected\n\n");
+
+    free(output);
+    simplex_cleanup();
+
+    printf("All seeded layer tests passed! ✓\n");
+    return 0;
+}
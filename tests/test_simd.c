@@ -0,0 +1,127 @@
+/**
+ * @file test_simd.c
+ * @brief SIMD/scalar consistency test for the bulk noise functions
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @author Adrian Paredez
+ * @version 1.0
+ * @date 9/5/2025
+ */
+
+#include <math.h>
+#include <simplex_noise.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Grid shared by every level; odd sizes exercise the partial-vector tail
+#define WIDTH 37
+#define HEIGHT 23
+#define DEPTH 5
+#define STEP 0.173
+
+static int check_level(simplex_simd_level_t level, double* output) {
+    const char* name = simplex_get_simd_level_name(level);
+    if (simplex_get_simd_level() != level) {
+        printf("✗ Requested %s but %s is active\n\n", name,
+               simplex_get_simd_level_name(simplex_get_simd_level()));
+        return 1;
+    }
+
+    // Test 1: 2D array against per-point scalar noise
+    printf("[%s] Test 1: 2D array vs scalar...\n", name);
+    double max_error = 0.0;
+    simplex_noise_array_2d(-3.1, -2.7, WIDTH, HEIGHT, STEP, output);
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < WIDTH; x++) {
+            double expected = simplex_noise_2d(-3.1 + (x * STEP), -2.7 + (y * STEP));
+            double error = fabs(output[(y * WIDTH) + x] - expected);
+            max_error = error > max_error ? error : max_error;
+        }
+    }
+    printf("Max 2D error: %.3e\n", max_error);
+    if (max_error > SIMPLEX_SIMD_TOLERANCE) {
+        printf("✗ 2D SIMD path exceeds tolerance\n\n");
+        return 1;
+    }
+    printf("✓ 2D SIMD path within tolerance\n\n");
+
+    // Test 2: 3D array against per-point scalar noise
+    printf("[%s] Test 2: 3D array vs scalar...\n", name);
+    max_error = 0.0;
+    simplex_noise_array_3d(-1.3, 0.4, -2.2, WIDTH, HEIGHT, DEPTH, STEP, output);
+    for (int z = 0; z < DEPTH; z++) {
+        for (int y = 0; y < HEIGHT; y++) {
+            for (int x = 0; x < WIDTH; x++) {
+                double expected =
+                    simplex_noise_3d(-1.3 + (x * STEP), 0.4 + (y * STEP), -2.2 + (z * STEP));
+                double error = fabs(output[(((z * HEIGHT) + y) * WIDTH) + x] - expected);
+                max_error = error > max_error ? error : max_error;
+            }
+        }
+    }
+    printf("Max 3D error: %.3e\n", max_error);
+    if (max_error > SIMPLEX_SIMD_TOLERANCE) {
+        printf("✗ 3D SIMD path exceeds tolerance\n\n");
+        return 1;
+    }
+    printf("✓ 3D SIMD path within tolerance\n\n");
+
+    // Test 3: Integer lattice coordinates hit the fast_floor edge cases
+    printf("[%s] Test 3: Lattice-aligned samples...\n", name);
+    simplex_noise_array_2d(-4.0, -4.0, 9, 9, 1.0, output);
+    for (int i = 0; i < 81; i++) {
+        double expected = simplex_noise_2d(-4.0 + (i % 9), -4.0 + (i / 9));
+        if (fabs(output[i] - expected) > SIMPLEX_SIMD_TOLERANCE) {
+            printf("✗ Lattice sample %d differs\n\n", i);
+            return 1;
+        }
+    }
+    printf("✓ Lattice-aligned samples match\n\n");
+
+    return 0;
+}
+
+int main(void) {
+    printf("Simplex Noise SIMD Consistency Test\n");
+    printf("===================================\n\n");
+
+    simplex_config_t config = simplex_get_default_config();
+    config.seed = 12345;  // NOLINT(readability-magic-numbers)
+    config.enable_simd = 1;
+    simplex_noise_init_advanced(&config);
+    printf("Auto-selected SIMD level: %s\n\n",
+           simplex_get_simd_level_name(simplex_get_simd_level()));
+
+    double* output = malloc((size_t)WIDTH * HEIGHT * DEPTH * sizeof(double));
+    if (!output) {
+        return 1;
+    }
+
+    // Every instruction set this build and CPU can run, scalar kernels included
+    int tested = 0;
+    for (int level = 0; level < SIMPLEX_SIMD_COUNT; level++) {
+        if (simplex_set_simd_level((simplex_simd_level_t)level) != 0) {
+            printf("Skipping %s (not available)\n\n",
+                   simplex_get_simd_level_name((simplex_simd_level_t)level));
+            continue;
+        }
+        if (check_level((simplex_simd_level_t)level, output) != 0) {
+            free(output);
+            return 1;
+        }
+        tested++;
+    }
+    if (tested == 0) {
+        printf("✗ No SIMD level available (scalar kernels must always be)\n\n");
+        free(output);
+        return 1;
+    }
+
+    free(output);
+    simplex_cleanup();
+
+    printf("All SIMD consistency tests passed! ✓\n");
+    return 0;
+}
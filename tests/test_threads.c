@@ -0,0 +1,111 @@
+/**
+ * @file test_threads.c
+ * @brief Multithreaded array generation test
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @author Adrian Paredez
+ * @version 1.0
+ * @date 9/5/2025
+ */
+
+#include <simplex_noise.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Odd sizes leave a partial last task
+#define WIDTH 123
+#define HEIGHT 77
+#define DEPTH 6
+#define SAMPLES ((size_t)WIDTH * HEIGHT * DEPTH)
+
+static simplex_context_t* make_context(int max_threads, int chunk_size, int enable_simd) {
+    simplex_config_t config = simplex_get_default_config();
+    config.seed = 4242;  // NOLINT(readability-magic-numbers)
+    config.max_threads = max_threads;
+    config.chunk_size = chunk_size;
+    config.enable_simd = enable_simd;
+    return simplex_context_create(&config);
+}
+
+// Fill all four array kinds into out (4 * SAMPLES doubles)
+static int generate(const simplex_context_t* ctx, double* out) {
+    if (simplex_noise_array_2d_ctx(ctx, -5.0, 2.0, WIDTH, HEIGHT, 0.07, out) != 0 ||
+        simplex_noise_array_3d_ctx(ctx, 1.0, -3.0, 0.5, WIDTH, HEIGHT, DEPTH, 0.05,
+                                   out + SAMPLES) != 0 ||
+        simplex_fbm_array_2d_ctx(ctx, 0.0, 0.0, WIDTH, HEIGHT, 0.02, 5, 0.5, 2.0,
+                                 out + (2 * SAMPLES)) != 0 ||
+        simplex_fbm_array_3d_ctx(ctx, 0.0, 0.0, 0.0, WIDTH, HEIGHT, DEPTH, 0.03, 3, 0.5, 2.0,
+                                 out + (3 * SAMPLES)) != 0) {
+        return -1;
+    }
+    return 0;
+}
+
+int main(void) {
+    printf("Simplex Noise Thread Pool Test\n");
+    printf("==============================\n\n");
+
+    double* reference = calloc(4 * SAMPLES, sizeof(double));
+    double* output = calloc(4 * SAMPLES, sizeof(double));
+    if (!reference || !output) {
+        return 1;
+    }
+
+    static const int thread_counts[] = {2, 3, 8, 64};
+    static const int chunk_sizes[] = {1, 200, 1024, 1000000};
+
+    for (int simd = 0; simd <= 1; simd++) {
+        printf("Test %d: thread counts vs single thread (SIMD %s)...\n", simd + 1,
+               simd ? "on" : "off");
+
+        simplex_context_t* serial = make_context(1, 1024, simd);
+        if (!serial || generate(serial, reference) != 0) {
+            printf("✗ Single-threaded generation failed\n\n");
+            return 1;
+        }
+
+        // fBm arrays must agree with the per-point functions
+        if (reference[2 * SAMPLES + 5] != simplex_fbm_2d_ctx(serial, 5 * 0.02, 0.0, 5, 0.5, 2.0)) {
+            printf("✗ fBm array differs from simplex_fbm_2d\n\n");
+            return 1;
+        }
+        simplex_context_destroy(serial);
+
+        for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]); t++) {
+            for (size_t c = 0; c < sizeof(chunk_sizes) / sizeof(chunk_sizes[0]); c++) {
+                simplex_context_t* ctx = make_context(thread_counts[t], chunk_sizes[c], simd);
+                memset(output, 0, 4 * SAMPLES * sizeof(double));
+                if (!ctx || generate(ctx, output) != 0 ||
+                    memcmp(output, reference, 4 * SAMPLES * sizeof(double)) != 0) {
+                    printf("✗ %d threads, chunk %d differs from single thread\n\n",
+                           thread_counts[t], chunk_sizes[c]);
+                    return 1;
+                }
+                simplex_context_destroy(ctx);
+            }
+        }
+        printf("✓ Output identical for every thread count and chunk size\n\n");
+    }
+
+    // Test 3: The pool restarts after cleanup
+    printf("Test 3: Pool restart after cleanup...\n");
+    simplex_cleanup();
+    simplex_context_t* ctx = make_context(4, 256, 0);
+    if (!ctx || generate(ctx, output) != 0 ||
+        memcmp(output, reference, 4 * SAMPLES * sizeof(double)) != 0) {
+        printf("✗ Generation after cleanup differs\n\n");
+        return 1;
+    }
+    simplex_context_destroy(ctx);
+    printf("✓ Pool restarted\n\n");
+
+    free(reference);
+    free(output);
+    simplex_cleanup();
+
+    printf("All thread pool tests passed! ✓\n");
+    return 0;
+}
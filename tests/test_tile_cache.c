@@ -0,0 +1,188 @@
+/**
+ * @file test_tile_cache.c
+ * @brief LRU tile cache test
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @author Adrian Paredez
+ * @version 1.0
+ * @date 9/5/2025
+ */
+
+#include <simplex_noise.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RESOLUTION 32
+#define TILE_SAMPLES ((size_t)RESOLUTION * RESOLUTION)
+#define TILE_SIZE 2.5
+// Room for two 32x32 tiles but not three
+#define TWO_TILE_BUDGET_MB 0.02
+
+static simplex_context_t* make_context(int enable_caching, unsigned int seed) {
+    simplex_config_t config = simplex_get_default_config();
+    config.seed = seed;
+    config.enable_caching = enable_caching;
+    config.cache_size_mb = TWO_TILE_BUDGET_MB;
+    return simplex_context_create(&config);
+}
+
+static simplex_tile_request_t tile(int tile_x, int tile_y) {
+    simplex_tile_request_t request = {.tile_x = tile_x,
+                                      .tile_y = tile_y,
+                                      .resolution = RESOLUTION,
+                                      .tile_size = TILE_SIZE,
+                                      .octaves = 4,
+                                      .persistence = 0.5,
+                                      .lacunarity = 2.0};
+    return request;
+}
+
+// Acquire and immediately release a tile
+static int touch(const simplex_context_t* ctx, int tile_x, int tile_y) {
+    simplex_tile_request_t request = tile(tile_x, tile_y);
+    const double* data = simplex_tile_acquire_ctx(ctx, &request);
+    simplex_tile_release(data);
+    return data ? 0 : -1;
+}
+
+static int expect_stats(const simplex_context_t* ctx, size_t hits, size_t misses,
+                        size_t evictions) {
+    simplex_perf_stats_t stats;
+    simplex_get_performance_stats_ctx(ctx, &stats);
+    if (stats.cache_hits != hits || stats.cache_misses != misses ||
+        stats.cache_evictions != evictions) {
+        printf("✗ Expected %zu/%zu/%zu hits/misses/evictions, got %zu/%zu/%zu\n\n", hits, misses,
+               evictions, stats.cache_hits, stats.cache_misses, stats.cache_evictions);
+        return 1;
+    }
+    return 0;
+}
+
+int main(void) {
+    printf("Simplex Noise Tile Cache Test\n");
+    printf("=============================\n\n");
+
+    double* reference = malloc(TILE_SAMPLES * sizeof(double));
+    if (!reference) {
+        return 1;
+    }
+    simplex_context_t* ctx = make_context(1, 777);  // NOLINT(readability-magic-numbers)
+    if (!ctx) {
+        return 1;
+    }
+
+    // Test 1: Tiles match the fractal array and repeat requests hit
+    printf("Test 1: Hits return the same samples...\n");
+    simplex_tile_request_t request = tile(-1, 2);
+    const double* first = simplex_tile_acquire_ctx(ctx, &request);
+    const double* second = simplex_tile_acquire_ctx(ctx, &request);
+    simplex_fractal_array_2d_ctx(ctx, -TILE_SIZE, 2 * TILE_SIZE, RESOLUTION, RESOLUTION,
+                                 TILE_SIZE / RESOLUTION, 4, 0.5, 2.0, reference);
+    if (!first || first != second ||
+        memcmp(first, reference, TILE_SAMPLES * sizeof(double)) != 0) {
+        printf("✗ Cached tile differs from simplex_fractal_array_2d\n\n");
+        return 1;
+    }
+    simplex_tile_release(first);
+    simplex_tile_release(second);
+    if (expect_stats(ctx, 1, 1, 0) != 0) {
+        return 1;
+    }
+    printf("✓ Second request was a hit on the same buffer\n\n");
+
+    // Test 2: Adjacent tiles continue each other's samples
+    printf("Test 2: Tile seams...\n");
+    simplex_tile_request_t right_request = tile(0, 2);
+    const double* right = simplex_tile_acquire_ctx(ctx, &right_request);
+    if (!right) {
+        printf("✗ Tile acquisition failed\n\n");
+        return 1;
+    }
+    for (int j = 0; j < RESOLUTION; j++) {
+        double y = (2 * TILE_SIZE) + (j * (TILE_SIZE / RESOLUTION));
+        if (right[(size_t)j * RESOLUTION] != simplex_fbm_2d_ctx(ctx, 0.0, y, 4, 0.5, 2.0)) {
+            printf("✗ Row %d of the neighbouring tile does not start at x = 0\n\n", j);
+            return 1;
+        }
+    }
+    simplex_tile_release(right);
+    printf("✓ Neighbouring tiles line up\n\n");
+
+    // Test 3: Least recently used tiles are evicted past the budget
+    printf("Test 3: LRU eviction...\n");
+    simplex_reset_performance_stats_ctx(ctx);
+    if (touch(ctx, 5, 5) != 0 || touch(ctx, 6, 5) != 0 || touch(ctx, 7, 5) != 0 ||
+        touch(ctx, 7, 5) != 0 || touch(ctx, 5, 5) != 0) {
+        printf("✗ Tile acquisition failed\n\n");
+        return 1;
+    }
+    // The cache held (-1, 2) and (0, 2); hits: (7, 5); evicted: (-1, 2), (0, 2), (5, 5), (6, 5)
+    if (expect_stats(ctx, 1, 4, 4) != 0) {
+        return 1;
+    }
+    printf("✓ Oldest tiles evicted, recently used tile kept\n\n");
+
+    // Test 4: A held tile survives its eviction
+    printf("Test 4: Held tiles outlive eviction...\n");
+    request = tile(9, -9);
+    const double* held = simplex_tile_acquire_ctx(ctx, &request);
+    simplex_fractal_array_2d_ctx(ctx, 9 * TILE_SIZE, -9 * TILE_SIZE, RESOLUTION, RESOLUTION,
+                                 TILE_SIZE / RESOLUTION, 4, 0.5, 2.0, reference);
+    if (!held || touch(ctx, 10, 0) != 0 || touch(ctx, 11, 0) != 0 || touch(ctx, 12, 0) != 0 ||
+        memcmp(held, reference, TILE_SAMPLES * sizeof(double)) != 0) {
+        printf("✗ Held tile changed after eviction\n\n");
+        return 1;
+    }
+    simplex_tile_release(held);
+    const double* again = simplex_tile_acquire_ctx(ctx, &request);
+    simplex_tile_release(again);
+    if (expect_stats(ctx, 1, 9, 9) != 0) {
+        return 1;
+    }
+    printf("✓ Held tile stayed valid and was regenerated afterwards\n\n");
+
+    // Test 5: Disabled caches keep nothing and reseeding flushes the cache
+    printf("Test 5: Disabled caching and reseeding...\n");
+    simplex_context_destroy(ctx);
+    ctx = make_context(0, 777);  // NOLINT(readability-magic-numbers)
+    if (!ctx || touch(ctx, 0, 0) != 0 || touch(ctx, 0, 0) != 0 ||
+        expect_stats(ctx, 0, 2, 0) != 0) {
+        printf("✗ Disabled cache kept tiles\n\n");
+        return 1;
+    }
+    simplex_noise_init(1);
+    if (touch(NULL, 0, 0) != 0 || touch(NULL, 0, 0) != 0 || simplex_get_cache_hits() != 1) {
+        printf("✗ Default context cache missed a repeated tile\n\n");
+        return 1;
+    }
+    simplex_noise_init(2);
+    if (touch(NULL, 0, 0) != 0 || simplex_get_cache_hits() != 0 ||
+        simplex_get_cache_misses() != 1) {
+        printf("✗ Tile from the previous seed was reused\n\n");
+        return 1;
+    }
+    printf("✓ Disabled caches regenerate and reseeding drops stale tiles\n\n");
+
+    // Test 6: Invalid requests
+    printf("Test 6: Invalid requests...\n");
+    request = tile(0, 0);
+    request.resolution = 0;
+    const double* invalid = simplex_tile_acquire_ctx(ctx, &request);
+    request = tile(0, 0);
+    request.tile_size = 0.0;
+    if (invalid || simplex_tile_acquire_ctx(ctx, &request) || simplex_tile_acquire(NULL)) {
+        printf("✗ Invalid request accepted\n\n");
+        return 1;
+    }
+    printf("✓ Invalid requests rejected\n\n");
+
+    simplex_context_destroy(ctx);
+    free(reference);
+    simplex_cleanup();
+
+    printf("All tile cache tests passed! ✓\n");
+    return 0;
+}
@@ -0,0 +1,44 @@
+/**
+ * @file test_util.h
+ * @brief Helpers shared by the image, volume and job tests
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @author Adrian Paredez
+ * @version 1.0
+ * @date 9/5/2025
+ */
+
+#ifndef SIMPLEX_TEST_UTIL_H
+#define SIMPLEX_TEST_UTIL_H
+
+#include <simplex_noise.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Re-initialize the default context with a memory limit and thread count
+static inline void set_limits(double memory_limit_mb, int max_threads) {
+    simplex_config_t config = simplex_get_default_config();
+    config.memory_limit_mb = memory_limit_mb;
+    config.max_threads = max_threads;
+    config.chunk_size = 1;
+    simplex_noise_init_advanced(&config);
+}
+
+// Read a whole file; returns its size or 0 on failure
+static inline size_t read_file(const char* filename, unsigned char** contents) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        return 0;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    *contents = malloc(size > 0 ? (size_t)size : 1);
+    size_t read = *contents ? fread(*contents, 1, (size_t)size, file) : 0;
+    fclose(file);
+    return read;
+}
+
+#endif /* SIMPLEX_TEST_UTIL_H */
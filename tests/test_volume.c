@@ -0,0 +1,239 @@
+/**
+ * @file test_volume.c
+ * @brief Memory-mapped 3D volume file test
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @author Adrian Paredez
+ * @version 1.0
+ * @date 9/5/2025
+ */
+
+#include <math.h>
+#include <simplex_image.h>
+#include <simplex_noise.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test_util.h"
+
+#define WIDTH 37
+#define HEIGHT 23
+#define DEPTH 19
+#define OCTAVES 4
+#define SCALE 0.07
+#define ROOMY_MEMORY_MB 256.0
+// Less than one float32 slice, so every slab is a single slice
+#define SLICE_MEMORY_MB 0.001
+// A few slices per slab, with a short last slab
+#define SLAB_MEMORY_MB 0.015
+#define VOLUME_FILE "test_volume.raw"
+#define REFERENCE_FILE "test_volume_reference.raw"
+
+// Write size bytes of contents to filename
+static int write_file(const char* filename, const unsigned char* contents, size_t size) {
+    FILE* file = fopen(filename, "wb");
+    if (!file) {
+        return -1;
+    }
+    size_t written = fwrite(contents, 1, size, file);
+    fclose(file);
+    return written == size ? 0 : -1;
+}
+
+// Generate config under a memory limit and thread count, then compare with the reference
+static int same_as_reference(const simplex_volume_config_t* config, double memory_limit_mb,
+                             int max_threads) {
+    set_limits(memory_limit_mb, max_threads);
+    if (simplex_generate_volume(config) != 0) {
+        return 0;
+    }
+    unsigned char* a = NULL;
+    unsigned char* b = NULL;
+    size_t a_size = read_file(config->filename, &a);
+    size_t b_size = read_file(REFERENCE_FILE, &b);
+    int same = a_size > 0 && a_size == b_size && memcmp(a, b, a_size) == 0;
+    free(a);
+    free(b);
+    remove(config->filename);
+    return same;
+}
+
+int main(void) {
+    printf("Simplex Noise Volume Test\n");
+    printf("=========================\n\n");
+
+    simplex_volume_config_t config = simplex_get_default_volume_config();
+    config.width = WIDTH;
+    config.height = HEIGHT;
+    config.depth = DEPTH;
+    config.scale = SCALE;
+    config.offset_x = 3.0;
+    config.offset_y = -2.0;
+    config.offset_z = 5.0;
+    config.octaves = OCTAVES;
+    config.seed = 777;  // NOLINT(readability-magic-numbers)
+    strncpy(config.filename, REFERENCE_FILE, sizeof(config.filename) - 1);
+
+    // Test 1: Float samples match the point functions, header describes the volume
+    printf("Test 1: Float32 volume...\n");
+    set_limits(ROOMY_MEMORY_MB, 4);
+    double before = simplex_noise_3d(0.3, 0.7, 0.1);
+    simplex_volume_t volume;
+    if (simplex_generate_volume(&config) != 0 ||
+        simplex_volume_open(REFERENCE_FILE, &volume) != 0) {
+        printf("✗ Volume generation or mapping failed\n\n");
+        return 1;
+    }
+    const simplex_volume_header_t* header = &volume.header;
+    if (memcmp(header->magic, "SXVOLUME", 8) != 0 || header->version != SIMPLEX_VOLUME_VERSION ||
+        header->header_size != SIMPLEX_VOLUME_HEADER_SIZE || header->width != WIDTH ||
+        header->height != HEIGHT || header->depth != DEPTH ||
+        header->format != SIMPLEX_VOLUME_FLOAT32 || header->sample_size != 4 ||
+        header->seed != config.seed || header->scale != SCALE ||
+        volume.size != (size_t)WIDTH * HEIGHT * DEPTH * 4 ||
+        simplex_volume_file_size(&config) != SIMPLEX_VOLUME_HEADER_SIZE + volume.size) {
+        printf("✗ Header does not describe the volume\n\n");
+        return 1;
+    }
+    simplex_config_t noise_config = simplex_get_default_config();
+    noise_config.seed = config.seed;
+    simplex_context_t* ctx = simplex_context_create(&noise_config);
+    if (!ctx) {
+        return 1;
+    }
+    // The mapped samples are native floats on little-endian hosts
+    const float* samples = volume.data;
+    int native = 1;
+    int little_endian = *(const unsigned char*)&native == 1;
+    for (int z = 0; z < DEPTH; z++) {
+        for (int y = 0; y < HEIGHT; y++) {
+            for (int x = 0; x < WIDTH; x++) {
+                double expected = simplex_fractal_3d_ctx(
+                    ctx, (config.offset_x * SCALE) + (x * SCALE),
+                    (config.offset_y * SCALE) + (y * SCALE),
+                    (config.offset_z * SCALE) + (z * SCALE), OCTAVES, config.persistence,
+                    config.lacunarity);
+                size_t index = ((((size_t)z * HEIGHT) + y) * WIDTH) + x;
+                if (simplex_volume_sample(&volume, x, y, z) != (double)(float)expected ||
+                    (little_endian && samples[index] != (float)expected)) {
+                    printf("✗ Sample (%d, %d, %d) differs from simplex_fractal_3d\n\n", x, y, z);
+                    return 1;
+                }
+            }
+        }
+    }
+    if (simplex_volume_sample(&volume, -5, HEIGHT + 3, DEPTH) !=
+            simplex_volume_sample(&volume, 0, HEIGHT - 1, DEPTH - 1) ||
+        simplex_noise_3d(0.3, 0.7, 0.1) != before) {
+        printf("✗ Edge clamping wrong or default context reseeded\n\n");
+        return 1;
+    }
+    simplex_volume_close(&volume);
+    simplex_volume_close(&volume);
+    printf("✓ Samples match simplex_fractal_3d\n\n");
+
+    // Test 2: Slabs and thread counts do not change the file
+    printf("Test 2: Slabbed generation...\n");
+    simplex_volume_config_t slabbed = config;
+    strncpy(slabbed.filename, VOLUME_FILE, sizeof(slabbed.filename) - 1);
+    if (!same_as_reference(&slabbed, SLICE_MEMORY_MB, 4) ||
+        !same_as_reference(&slabbed, SLAB_MEMORY_MB, 4) ||
+        !same_as_reference(&slabbed, ROOMY_MEMORY_MB, 1)) {
+        printf("✗ Slabbed or single-threaded volume differs\n\n");
+        return 1;
+    }
+    remove(REFERENCE_FILE);
+    printf("✓ Files identical for every slab size and thread count\n\n");
+
+    // Test 3: Integer formats quantize [min_value, max_value], clamping outside it
+    printf("Test 3: Integer formats...\n");
+    set_limits(SLAB_MEMORY_MB, 4);
+    static const simplex_volume_format_t formats[] = {SIMPLEX_VOLUME_UINT8, SIMPLEX_VOLUME_UINT16};
+    static const double maxima[] = {255.0, 65535.0};
+    simplex_volume_config_t quantized = slabbed;
+    quantized.octaves = 1;
+    quantized.min_value = -0.5;
+    quantized.max_value = 0.5;
+    for (size_t f = 0; f < sizeof(formats) / sizeof(formats[0]); f++) {
+        quantized.format = formats[f];
+        if (simplex_generate_volume(&quantized) != 0 ||
+            simplex_volume_open(VOLUME_FILE, &volume) != 0 ||
+            volume.header.sample_size != f + 1) {
+            printf("✗ Format %d generation failed\n\n", formats[f]);
+            return 1;
+        }
+        int clamped = 0;
+        double step = (quantized.max_value - quantized.min_value) / maxima[f];
+        for (int z = 0; z < DEPTH; z++) {
+            for (int y = 0; y < HEIGHT; y++) {
+                for (int x = 0; x < WIDTH; x++) {
+                    double noise =
+                        simplex_noise_3d_ctx(ctx, (config.offset_x * SCALE) + (x * SCALE),
+                                             (config.offset_y * SCALE) + (y * SCALE),
+                                             (config.offset_z * SCALE) + (z * SCALE));
+                    double expected = noise < quantized.min_value   ? quantized.min_value
+                                      : noise > quantized.max_value ? quantized.max_value
+                                                                    : noise;
+                    clamped += expected != noise;
+                    if (fabs(simplex_volume_sample(&volume, x, y, z) - expected) >
+                        (0.5 * step) + 1e-9) {
+                        printf("✗ Format %d sample (%d, %d, %d) off by more than half a step\n\n",
+                               formats[f], x, y, z);
+                        return 1;
+                    }
+                }
+            }
+        }
+        simplex_volume_close(&volume);
+        remove(VOLUME_FILE);
+        if (clamped == 0) {
+            printf("✗ Test range never clamped\n\n");
+            return 1;
+        }
+    }
+    simplex_context_destroy(ctx);
+    printf("✓ Quantized within half a step\n\n");
+
+    // Test 4: Invalid configurations and damaged files are rejected
+    printf("Test 4: Validation...\n");
+    simplex_volume_config_t invalid = slabbed;
+    invalid.depth = 0;
+    simplex_volume_config_t bad_format = slabbed;
+    bad_format.format = SIMPLEX_VOLUME_COUNT;
+    simplex_volume_config_t bad_range = slabbed;
+    bad_range.max_value = bad_range.min_value;
+    if (simplex_generate_volume(&invalid) != -1 || simplex_generate_volume(&bad_format) != -1 ||
+        simplex_generate_volume(&bad_range) != -1 || simplex_generate_volume(NULL) != -1 ||
+        simplex_volume_file_size(&invalid) != 0 || simplex_volume_open(NULL, &volume) != -1 ||
+        simplex_volume_open("missing_volume.raw", &volume) != -1 ||
+        simplex_volume_sample(&volume, 0, 0, 0) != 0.0) {
+        printf("✗ Invalid request accepted\n\n");
+        return 1;
+    }
+    unsigned char* contents = NULL;
+    size_t size = 0;
+    if (simplex_generate_volume(&slabbed) != 0 ||
+        (size = read_file(VOLUME_FILE, &contents)) == 0 ||
+        write_file(VOLUME_FILE, contents, size - 1) != 0 ||
+        simplex_volume_open(VOLUME_FILE, &volume) != -1) {
+        printf("✗ Truncated volume accepted\n\n");
+        return 1;
+    }
+    contents[0] = 'X';
+    if (write_file(VOLUME_FILE, contents, size) != 0 ||
+        simplex_volume_open(VOLUME_FILE, &volume) != -1) {
+        printf("✗ Volume with a bad magic accepted\n\n");
+        return 1;
+    }
+    free(contents);
+    remove(VOLUME_FILE);
+    printf("✓ Invalid requests and damaged files rejected\n\n");
+
+    simplex_cleanup();
+
+    printf("All volume tests passed! ✓\n");
+    return 0;
+}
@@ -0,0 +1,238 @@
+/**
+ * @file test_warp.c
+ * @brief Multi-level fBm domain warp array and image test
+ *
+ * @copyright Copyright (c) 2025. All rights reserved.
+ * @license This code is provided under the MIT License.
+ *
+ * @author Adrian Paredez
+ * @version 1.0
+ * @date 9/5/2025
+ */
+
+#include <math.h>
+#include <simplex_image.h>
+#include <simplex_noise.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// More samples than one 512-sample tile, so tiles start part way through a row
+#define WIDTH 67
+#define HEIGHT 13
+#define STEP 0.093
+#define X0 -4.25
+#define Y0 1.5
+#define OCTAVES 5
+#define PERSISTENCE 0.55
+#define LACUNARITY 2.1
+// Vector rounding in the warp fields is scaled by the strength and the base gradient
+#define WARP_TOLERANCE 1e-9
+#define IMAGE_FILE "test_warp_reference.img"
+
+// Growing byte buffer filled by the stream callback
+typedef struct {
+    unsigned char* data;
+    size_t size;
+} collected_t;
+
+static int collect(void* user_data, const void* data, size_t size) {
+    collected_t* out = user_data;
+    unsigned char* grown = realloc(out->data, out->size + size);
+    if (!grown) {
+        return -1;
+    }
+    memcpy(grown + out->size, data, size);
+    out->data = grown;
+    out->size += size;
+    return 0;
+}
+
+// Two levels of three-octave fields with strong displacement
+static simplex_warp_config_t strong_warp(void) {
+    simplex_warp_config_t warp = simplex_get_default_warp_config();
+    warp.levels = 2;
+    warp.strength = 2.5;
+    warp.octaves = 3;
+    warp.persistence = 0.6;
+    warp.lacunarity = 1.9;
+    return warp;
+}
+
+// Every array sample equals the point function, within tolerance
+static int matches_points(const double* output, int octaves, const simplex_warp_config_t* warp,
+                          double tolerance) {
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < WIDTH; x++) {
+            double expected = simplex_domain_warp_fbm_2d(X0 + (x * STEP), Y0 + (y * STEP), octaves,
+                                                         PERSISTENCE, LACUNARITY, warp);
+            double actual = output[((size_t)y * WIDTH) + x];
+            if (fabs(actual - expected) > tolerance) {
+                printf("✗ Sample (%d, %d): %.17g vs %.17g\n", x, y, actual, expected);
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+int main(void) {
+    printf("Simplex Noise Domain Warp Test\n");
+    printf("==============================\n\n");
+
+    double* output = malloc((size_t)WIDTH * HEIGHT * sizeof(double));
+    if (!output) {
+        return 1;
+    }
+    simplex_warp_config_t strong = strong_warp();
+
+    // Test 1: The default warp is simplex_domain_warp_2d()
+    printf("Test 1: Default warp...\n");
+    simplex_warp_config_t scaled = simplex_get_default_warp_config();
+    scaled.strength = 0.7;
+    for (int i = 0; i < 64; i++) {
+        double x = -7.3 + (i * 0.61);
+        double y = 2.9 - (i * 0.37);
+        if (simplex_domain_warp_fbm_2d(x, y, 1, PERSISTENCE, LACUNARITY, NULL) !=
+                simplex_domain_warp_2d(x, y, 1.0) ||
+            simplex_domain_warp_fbm_2d(x, y, 1, PERSISTENCE, LACUNARITY, &scaled) !=
+                simplex_domain_warp_2d(x, y, 0.7)) {
+            printf("✗ Default warp differs from simplex_domain_warp_2d at (%f, %f)\n\n", x, y);
+            return 1;
+        }
+    }
+    printf("✓ Default warp identical to simplex_domain_warp_2d\n\n");
+
+    // Test 2: Arrays match the point function on every SIMD level
+    printf("Test 2: Arrays vs point function...\n");
+    for (int level = SIMPLEX_SIMD_SCALAR; level < SIMPLEX_SIMD_COUNT; level++) {
+        if (level != SIMPLEX_SIMD_SCALAR &&
+            simplex_set_simd_level((simplex_simd_level_t)level) != 0) {
+            continue;
+        }
+        double tolerance = level == SIMPLEX_SIMD_SCALAR ? 0.0 : WARP_TOLERANCE;
+        if (simplex_domain_warp_array_2d(X0, Y0, WIDTH, HEIGHT, STEP, 1, PERSISTENCE, LACUNARITY,
+                                         NULL, output) != 0 ||
+            !matches_points(output, 1, NULL, tolerance) ||
+            simplex_domain_warp_array_2d(X0, Y0, WIDTH, HEIGHT, STEP, OCTAVES, PERSISTENCE,
+                                         LACUNARITY, &strong, output) != 0 ||
+            !matches_points(output, OCTAVES, &strong, tolerance)) {
+            printf("✗ Arrays differ on %s\n\n",
+                   simplex_get_simd_level_name((simplex_simd_level_t)level));
+            return 1;
+        }
+    }
+    simplex_config_t defaults = simplex_get_default_config();
+    simplex_noise_init_advanced(&defaults);
+    printf("✓ Arrays match the point function\n\n");
+
+    // Test 3: Thread counts and chunk sizes do not change the array
+    printf("Test 3: Threaded arrays...\n");
+    simplex_config_t config = simplex_get_default_config();
+    config.max_threads = 4;
+    config.chunk_size = 1;
+    simplex_context_t* ctx = simplex_context_create(&config);
+    double* threaded = malloc((size_t)WIDTH * HEIGHT * sizeof(double));
+    if (!ctx || !threaded ||
+        simplex_domain_warp_array_2d(X0, Y0, WIDTH, HEIGHT, STEP, OCTAVES, PERSISTENCE,
+                                     LACUNARITY, &strong, output) != 0 ||
+        simplex_domain_warp_array_2d_ctx(ctx, X0, Y0, WIDTH, HEIGHT, STEP, OCTAVES, PERSISTENCE,
+                                         LACUNARITY, &strong, threaded) != 0 ||
+        memcmp(output, threaded, (size_t)WIDTH * HEIGHT * sizeof(double)) != 0) {
+        printf("✗ Threaded array differs\n\n");
+        return 1;
+    }
+    free(threaded);
+    simplex_context_destroy(ctx);
+    printf("✓ Same array for every thread count\n\n");
+
+    // Test 4: Warped images are the colorized warped noise, by every route
+    printf("Test 4: Warped images...\n");
+    simplex_image_config_t image = simplex_get_default_image_config();
+    image.width = WIDTH;
+    image.height = HEIGHT;
+    image.format = SIMPLEX_IMAGE_RAW;
+    image.color_mode = SIMPLEX_COLOR_GRAYSCALE;
+    image.auto_normalize = SIMPLEX_NORMALIZE_NONE;
+    image.scale = STEP;
+    image.offset_x = X0 / STEP;
+    image.offset_y = Y0 / STEP;
+    image.octaves = OCTAVES;
+    image.persistence = PERSISTENCE;
+    image.lacunarity = LACUNARITY;
+    strncpy(image.filename, IMAGE_FILE, sizeof(image.filename) - 1);
+    size_t size = simplex_image_encoded_size(&image);
+    unsigned char* buffer = malloc(size);
+    collected_t streamed = {NULL, 0};
+    unsigned char* file_bytes = malloc(size + 1);
+    FILE* file = NULL;
+    size_t written = 0;
+    if (!buffer || !file_bytes ||
+        simplex_render_warped_to_buffer(&image, &strong, buffer, size, &written) != 0 ||
+        written != size ||
+        simplex_render_warped_to_stream(&image, &strong, collect, &streamed) != 0 ||
+        simplex_generate_warped_image(&image, &strong) != 0 || !(file = fopen(IMAGE_FILE, "rb"))) {
+        printf("✗ Warped image rendering failed\n\n");
+        return 1;
+    }
+    size_t file_size = fread(file_bytes, 1, size + 1, file);
+    fclose(file);
+    remove(IMAGE_FILE);
+    if (streamed.size != size || memcmp(streamed.data, buffer, size) != 0 || file_size != size ||
+        memcmp(file_bytes, buffer, size) != 0) {
+        printf("✗ Buffer, stream and file differ\n\n");
+        return 1;
+    }
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < WIDTH; x++) {
+            double noise = simplex_domain_warp_fbm_2d(
+                (image.offset_x * STEP) + (x * STEP), (image.offset_y * STEP) + (y * STEP),
+                OCTAVES, PERSISTENCE, LACUNARITY, &strong);
+            unsigned char expected = (unsigned char)((noise + 1.0) * 127.5);
+            if (buffer[((size_t)y * WIDTH) + x] != expected) {
+                printf("✗ Pixel (%d, %d) is not the warped noise\n\n", x, y);
+                return 1;
+            }
+        }
+    }
+    free(buffer);
+    free(streamed.data);
+    free(file_bytes);
+    printf("✓ Warped image matches the point function\n\n");
+
+    // Test 5: Invalid warps and requests are rejected
+    printf("Test 5: Validation...\n");
+    simplex_warp_config_t no_levels = strong;
+    no_levels.levels = 0;
+    simplex_warp_config_t too_many = strong;
+    too_many.levels = SIMPLEX_WARP_MAX_LEVELS + 1;
+    simplex_warp_config_t no_octaves = strong;
+    no_octaves.octaves = 0;
+    simplex_image_config_t flat = image;
+    flat.octaves = 0;
+    if (simplex_domain_warp_array_2d(X0, Y0, WIDTH, HEIGHT, STEP, 1, PERSISTENCE, LACUNARITY,
+                                     &no_levels, output) != -1 ||
+        simplex_domain_warp_array_2d(X0, Y0, WIDTH, HEIGHT, STEP, 1, PERSISTENCE, LACUNARITY,
+                                     &too_many, output) != -1 ||
+        simplex_domain_warp_array_2d(X0, Y0, WIDTH, HEIGHT, STEP, 1, PERSISTENCE, LACUNARITY,
+                                     &no_octaves, output) != -1 ||
+        simplex_domain_warp_array_2d(X0, Y0, WIDTH, HEIGHT, STEP, 0, PERSISTENCE, LACUNARITY,
+                                     NULL, output) != -1 ||
+        simplex_domain_warp_array_2d(X0, Y0, 0, HEIGHT, STEP, 1, PERSISTENCE, LACUNARITY, NULL,
+                                     output) != -1 ||
+        simplex_domain_warp_array_2d(X0, Y0, WIDTH, HEIGHT, STEP, 1, PERSISTENCE, LACUNARITY,
+                                     NULL, NULL) != -1 ||
+        simplex_domain_warp_fbm_2d(0.3, 0.7, 1, PERSISTENCE, LACUNARITY, &too_many) != 0.0 ||
+        simplex_generate_warped_image(&flat, NULL) != -1 ||
+        simplex_render_warped_to_stream(&image, NULL, NULL, NULL) != -1) {
+        printf("✗ Invalid request accepted\n\n");
+        return 1;
+    }
+    printf("✓ Invalid requests rejected\n\n");
+
+    free(output);
+    simplex_cleanup();
+
+    printf("All domain warp tests passed! ✓\n");
+    return 0;
+}